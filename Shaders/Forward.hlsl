@@ -11,9 +11,16 @@ F_PROGRAM(FPT_VERTEX)
 struct VSInput
 {
     float3 vPosition : POSITION;
+#ifdef USE_COMPACT_VERTICES
+    // Octahedral encoded, see `DecodeOctahedral()`
+    float2 vNormal : NORMAL;
+    float2 vUV : TEXCOORD0;
+    float2 vTangent : TANGENT;
+#else
     float3 vNormal : NORMAL;
     float2 vUV : TEXCOORD0;
     float3 vTangent : TANGENT;
+#endif
     uint uiInstanceId : SV_InstanceID;
 #ifdef USE_SKINNING
     uint4 vJointIndices : ATTR0;
@@ -63,6 +70,14 @@ VSOutput main(VSInput input)
 {
     VSOutput output;
 
+#ifdef USE_COMPACT_VERTICES
+    const float3 normal = DecodeOctahedral(input.vNormal);
+    const float3 tangent = DecodeOctahedral(input.vTangent);
+#else
+    const float3 normal = input.vNormal;
+    const float3 tangent = input.vTangent;
+#endif
+
     float4x4 world_matrix = bObjectBuffer[VSConst.uiObjectIndex + input.uiInstanceId].mModel;
 
     float4x4 MVP = mul(VSConst.mViewProjection, world_matrix);
@@ -74,20 +89,21 @@ VSOutput main(VSInput input)
         + input.vJointWeights.w * bBones[input.vJointIndices.w];
 
     output.vPosition = mul(MVP, mul(skin_xform, float4(input.vPosition, 1.0)));
-    output.vNormalWS = normalize(mul((float3x3)world_matrix, mul((float3x3)skin_xform, input.vNormal)));
+    output.vNormalWS = normalize(mul((float3x3)world_matrix, mul((float3x3)skin_xform, normal)));
     // output.vDebugColor = input.vJointWeights;
 #else
     output.vPosition = mul(MVP, float4(input.vPosition, 1.0));
-    output.vNormalWS = normalize(mul((float3x3)world_matrix, input.vNormal));
+    output.vNormalWS = normalize(mul((float3x3)world_matrix, normal));
     // output.vDebugColor = float4(1.0, 1.0, 1.0, 1.0);
 #endif
 
 #ifdef USE_NORMAL_MAPS
-    output.vTangentWS = normalize(mul((float3x3)world_matrix, input.vTangent));
+    output.vTangentWS = normalize(mul((float3x3)world_matrix, tangent));
     output.vBitangentWS = cross(output.vNormalWS, output.vTangentWS);
 #endif
 
     output.vUV = input.vUV;
+    output.uiMaterialIndex = VSConst.uiMaterialIndex;
 
     float4 position_ws = mul(world_matrix, float4(input.vPosition, 1.0));
 	output.vPositionWS = position_ws.xyz;
@@ -134,12 +150,27 @@ F_CBuffer(FSLightBuffer, 4, 0)
 
 F_StructBuffer(bMaterialBuffer, Material, 1, 1);
 
+// Bindless materials index the texture table that is bound once per pipeline (see `BindlessTextureTable`)
+#ifdef USE_BINDLESS
+F_TextureTable(tTextures, 0, 2)
+#else
+// Packed materials sample their layer of texture arrays that are shared with other materials (see `TexturePacker`)
+#ifdef USE_TEXTURE_ARRAYS
+F_Texture2DArray(tAlbedo, 0)
+
+#ifdef USE_NORMAL_MAPS
+F_Texture2DArray(tNormalMap, 1)
+F_Texture2DArray(tMetallicRoughness, 2)
+#endif
+#else
 F_Texture2D(tAlbedo, 0)
 
 #ifdef USE_NORMAL_MAPS
 F_Texture2D(tNormalMap, 1)
 F_Texture2D(tMetallicRoughness, 2)
 #endif
+#endif
+#endif
 
 #define ROUGHNESS roughness_metallic.x
 #define METALLIC  roughness_metallic.y
@@ -149,17 +180,39 @@ FSOutput main(FSInput input)
 {
     FSOutput output;
 
-    // Material material_info = bMaterialBuffer[input.uiMaterialIndex];
-    // float4 material_color = F_UnpackUIntToFloat4(material_info.uiBaseColor);
+    const Material material = bMaterialBuffer[input.uiMaterialIndex];
+    // float4 material_color = F_UnpackUIntToFloat4(material.uiBaseColor);
     float4 material_color = float4(0.0, 0.0, 0.0, 1.0);
 
+#ifdef USE_BINDLESS
+    float3 albedo = F_SampleTable(tTextures, material.uiDiffuseIndex, input.vUV).rgb + material_color.rgb;
+#else
+#ifdef USE_TEXTURE_ARRAYS
+    float3 albedo = F_SampleLayer(tAlbedo, input.vUV, material.uiDiffuseLayer).rgb + material_color.rgb;
+#else
     float3 albedo = F_Sample(tAlbedo, input.vUV).rgb + material_color.rgb;
+#endif
+#endif
 
-    output.vAlbedo = float4(F_Sample(tAlbedo, input.vUV).rgb + material_color.rgb, 1.0);
+    output.vAlbedo = float4(albedo, 1.0);
 
 #ifdef USE_NORMAL_MAPS
+#ifdef USE_BINDLESS
+    float2 roughness_metallic = F_SampleTable(tTextures, material.uiMetallicRoughnessIndex, input.vUV).gb;
+    float2 normal_xy = F_SampleTable(tTextures, material.uiNormalMapIndex, input.vUV).rg;
+#else
+#ifdef USE_TEXTURE_ARRAYS
+    float2 roughness_metallic = F_SampleLayer(tMetallicRoughness, input.vUV, material.uiMetallicRoughnessLayer).gb;
+    float2 normal_xy = F_SampleLayer(tNormalMap, input.vUV, material.uiNormalMapLayer).rg;
+#else
     float2 roughness_metallic = F_Sample(tMetallicRoughness, input.vUV).gb;
-    float3 normal_ts = F_Sample(tNormalMap, input.vUV).rgb * 2.0 - 1.0;
+    float2 normal_xy = F_Sample(tNormalMap, input.vUV).rg;
+#endif
+#endif
+
+    // Normal maps may be stored as BC5 with only XY, so Z is rebuilt from the unit length
+    normal_xy = normal_xy * 2.0 - 1.0;
+    float3 normal_ts = float3(normal_xy, sqrt(saturate(1.0 - dot(normal_xy, normal_xy))));
 
     float3x3 TBN = float3x3(input.vTangentWS, input.vBitangentWS, input.vNormalWS);
 
@@ -4,6 +4,7 @@
 #define FPT_PIXEL 1
 /// Global, copy to all shader types
 #define FPT_ALL 2
+#define FPT_COMPUTE 3
 
 #define F_REFLECT(_type, _binding, _set) ;
 #define FR_STRUCTBUFFER 0
@@ -23,15 +24,39 @@ struct Object
 [[vk::ext_instruction(64, "GLSL.std.450")]]
 float4 F_UnpackUIntToFloat4(uint x);
 
+/// Decodes a direction from the octahedral encoding used in compact vertices (see `VertexConvert::WriteOctahedral()`).
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 direction = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+    // Unfold the lower hemisphere
+    const float fold = saturate(-direction.z);
+    direction.x += (direction.x >= 0.0) ? -fold : fold;
+    direction.y += (direction.y >= 0.0) ? -fold : fold;
+
+    return normalize(direction);
+}
+
 #define F_TextureName(_name) _name##Texture
 
 #define F_Sample(_name, _coord) F_TextureName(_name).Sample(_name, _coord)
+#define F_SampleLayer(_name, _coord, _layer) F_TextureName(_name).Sample(_name, float3(_coord, _layer))
 #define F_SampleCmpLevelZero(_name, _texcoord, _zcoord) F_TextureName(_name).SampleCmpLevelZero(_name, _texcoord, _zcoord)
+#define F_SampleTable(_name, _index, _coord) F_TextureName(_name)[_index].Sample(_name[_index], _coord)
 
 #define F_Texture2D(_name, reg_n) \
     Texture2D F_TextureName(_name) : register(t##reg_n, space0); \
     SamplerState _name : register(s##reg_n, space0);
 
+#define F_Texture2DArray(_name, reg_n) \
+    Texture2DArray F_TextureName(_name) : register(t##reg_n, space0); \
+    SamplerState _name : register(s##reg_n, space0);
+
+// Unbounded array of textures, used for the bindless texture table
+#define F_TextureTable(_name, binding_, set_) \
+    Texture2D F_TextureName(_name)[] : register(t##binding_, space##set_); \
+    SamplerState _name[] : register(s##binding_, space##set_);
+
 #define F_ShadowTexture2D(_name, _reg_n) \
     Texture2D F_TextureName(_name) : register(t##_reg_n, space0); \
     SamplerComparisonState _name : register(s##_reg_n, space0);
@@ -39,6 +64,9 @@ float4 F_UnpackUIntToFloat4(uint x);
 #define F_StructBuffer(name_, obj_type_, binding_, set_) \
     [[vk::binding(binding_, set_)]] StructuredBuffer<obj_type_> name_
 
+#define F_RWStructBuffer(name_, obj_type_, binding_, set_) \
+    [[vk::binding(binding_, set_)]] RWStructuredBuffer<obj_type_> name_
+
 #define F_CBuffer(name_, binding_, set_) \
     [[vk::binding(binding_, set_)]] cbuffer name_
 
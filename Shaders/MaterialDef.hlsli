@@ -4,4 +4,14 @@
 struct Material
 {
 	uint Flags;
+
+	// Texture array layers, used with USE_TEXTURE_ARRAYS
+	uint uiDiffuseLayer;
+	uint uiNormalMapLayer;
+	uint uiMetallicRoughnessLayer;
+
+	// Bindless texture table indices, used with USE_BINDLESS
+	uint uiDiffuseIndex;
+	uint uiNormalMapIndex;
+	uint uiMetallicRoughnessIndex;
 };
@@ -12,9 +12,15 @@ F_PROGRAM(FPT_VERTEX)
 struct VSInput
 {
     float3 vPosition : POSITION;
+#ifdef USE_COMPACT_VERTICES
+    float2 vNormal : NORMAL;
+    float2 vUV : TEXCOORD0;
+    float2 vTangent : TANGENT;
+#else
     float3 vNormal : NORMAL;
     float2 vUV : TEXCOORD0;
     float3 vTangent : TANGENT;
+#endif
     uint uiInstanceId : SV_InstanceID;
 #ifdef USE_SKINNING
     uint4 vJointIndices : ATTR0;
@@ -0,0 +1,155 @@
+F_PROGRAM(FPT_COMPUTE)
+
+// Note: the program definition above must be the first line, as anything before it is copied to the vertex and pixel
+// programs.
+
+#include "./Helper.hlsl"
+
+///////////////////////////////////
+// Compute Shader
+///////////////////////////////////
+
+// Skins each vertex of a skinned mesh once per frame. The output vertices are in the layout of `Vertex<Default>`, or
+// `Vertex<Compact>` when USE_COMPACT_VERTICES is defined, so the geometry and shadow passes draw them as static
+// geometry.
+
+// Vertices are read and written as 32 bit words, as the vertex structs are packed. The output is written as words
+// rather than floats so that the packed attributes of compact vertices are stored bit for bit.
+#ifdef USE_COMPACT_VERTICES
+
+#define SKINNED_VERTEX_STRIDE 8
+#define OUTPUT_VERTEX_STRIDE 6
+
+#define VERTEX_POSITION 0
+#define VERTEX_NORMAL 3
+#define VERTEX_UV 4
+#define VERTEX_TANGENT 5
+#define VERTEX_BONE_IDS 6
+#define VERTEX_BONE_WEIGHTS 7
+
+#else
+
+#define SKINNED_VERTEX_STRIDE 19
+#define OUTPUT_VERTEX_STRIDE 11
+
+#define VERTEX_POSITION 0
+#define VERTEX_NORMAL 3
+#define VERTEX_UV 6
+#define VERTEX_TANGENT 8
+#define VERTEX_BONE_IDS 11
+#define VERTEX_BONE_WEIGHTS 15
+
+#endif
+
+#define THREAD_GROUP_SIZE 64
+
+struct CSPushConsts
+{
+    uint uiVertexCount;
+
+    /// Index of the first vertex for this mesh in the output buffer.
+    uint uiOutputVertexStart;
+};
+
+[[vk::push_constant]] CSPushConsts CSConst;
+
+F_StructBuffer(bSourceVertices, uint, 0, 0);
+
+F_CBuffer(CSUniforms, 1, 0)
+{
+    BoneMtx bBones[BONE_COUNT];
+};
+
+F_RWStructBuffer(bSkinnedVertices, uint, 2, 0);
+
+float3 LoadFloat3(uint index)
+{
+    return asfloat(uint3(bSourceVertices[index], bSourceVertices[index + 1], bSourceVertices[index + 2]));
+}
+
+void StoreFloat3(uint index, float3 value)
+{
+    bSkinnedVertices[index] = asuint(value.x);
+    bSkinnedVertices[index + 1] = asuint(value.y);
+    bSkinnedVertices[index + 2] = asuint(value.z);
+}
+
+#ifdef USE_COMPACT_VERTICES
+
+float3 LoadOctahedral(uint index)
+{
+    // Sign extend each snorm16 value
+    const uint packed = bSourceVertices[index];
+    const float2 encoded = float2(asint(packed << 16) >> 16, asint(packed) >> 16) / 32767.0;
+
+    return DecodeOctahedral(max(encoded, -1.0));
+}
+
+/// Matches `VertexConvert::WriteOctahedral()`
+void StoreOctahedral(uint index, float3 direction)
+{
+    float2 encoded = direction.xy / max(abs(direction.x) + abs(direction.y) + abs(direction.z), 1e-20);
+
+    if (direction.z < 0.0) {
+        const float2 signs = float2(encoded.x < 0.0 ? -1.0 : 1.0, encoded.y < 0.0 ? -1.0 : 1.0);
+        encoded = (1.0 - abs(encoded.yx)) * signs;
+    }
+
+    const int2 quantized = int2(round(clamp(encoded, -1.0, 1.0) * 32767.0));
+
+    bSkinnedVertices[index] = (uint(quantized.x) & 0xFFFF) | (uint(quantized.y) << 16);
+}
+
+#endif
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 thread_id : SV_DispatchThreadID)
+{
+    const uint vertex_index = thread_id.x;
+
+    if (vertex_index >= CSConst.uiVertexCount) {
+        return;
+    }
+
+    const uint src = vertex_index * SKINNED_VERTEX_STRIDE;
+    const uint dst = (CSConst.uiOutputVertexStart + vertex_index) * OUTPUT_VERTEX_STRIDE;
+
+#ifdef USE_COMPACT_VERTICES
+    const uint packed_ids = bSourceVertices[src + VERTEX_BONE_IDS];
+
+    uint4 joint_indices = uint4(packed_ids & 0xFF, (packed_ids >> 8) & 0xFF, (packed_ids >> 16) & 0xFF,
+                                packed_ids >> 24);
+
+    float4 joint_weights = F_UnpackUIntToFloat4(bSourceVertices[src + VERTEX_BONE_WEIGHTS]);
+#else
+    uint4 joint_indices = uint4(bSourceVertices[src + VERTEX_BONE_IDS], bSourceVertices[src + VERTEX_BONE_IDS + 1],
+                                bSourceVertices[src + VERTEX_BONE_IDS + 2], bSourceVertices[src + VERTEX_BONE_IDS + 3]);
+
+    float4 joint_weights = asfloat(uint4(bSourceVertices[src + VERTEX_BONE_WEIGHTS],
+                                         bSourceVertices[src + VERTEX_BONE_WEIGHTS + 1],
+                                         bSourceVertices[src + VERTEX_BONE_WEIGHTS + 2],
+                                         bSourceVertices[src + VERTEX_BONE_WEIGHTS + 3]));
+#endif
+
+    float4x4 skin_xform = joint_weights.x * bBones[joint_indices.x]
+        + joint_weights.y * bBones[joint_indices.y]
+        + joint_weights.z * bBones[joint_indices.z]
+        + joint_weights.w * bBones[joint_indices.w];
+
+    StoreFloat3(dst + VERTEX_POSITION, mul(skin_xform, float4(LoadFloat3(src + VERTEX_POSITION), 1.0)).xyz);
+
+#ifdef USE_COMPACT_VERTICES
+    StoreOctahedral(dst + VERTEX_NORMAL, mul((float3x3)skin_xform, LoadOctahedral(src + VERTEX_NORMAL)));
+    StoreOctahedral(dst + VERTEX_TANGENT, mul((float3x3)skin_xform, LoadOctahedral(src + VERTEX_TANGENT)));
+
+    // Half float UVs are copied as they are
+    bSkinnedVertices[dst + VERTEX_UV] = bSourceVertices[src + VERTEX_UV];
+#else
+    // Normals and tangents are normalized by the vertex shaders after the world transform
+    StoreFloat3(dst + VERTEX_NORMAL, mul((float3x3)skin_xform, LoadFloat3(src + VERTEX_NORMAL)));
+    StoreFloat3(dst + VERTEX_TANGENT, mul((float3x3)skin_xform, LoadFloat3(src + VERTEX_TANGENT)));
+
+    bSkinnedVertices[dst + VERTEX_UV] = bSourceVertices[src + VERTEX_UV];
+    bSkinnedVertices[dst + VERTEX_UV + 1] = bSourceVertices[src + VERTEX_UV + 1];
+#endif
+}
@@ -1 +1,400 @@
 #include "AnimationManager.hpp"
+
+#include <Core/Assert.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/Log.hpp>
+#include <Engine.hpp>
+#include <Renderer/Globals.hpp>
+#include <Renderer/Limits.hpp>
+#include <Renderer/RenderBackend.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace fx {
+
+using renderer::gRenderer;
+
+static constexpr uint32 scPaletteSize = Limits::MaxBones * sizeof(Mat4f);
+
+// Palettes are bound with a dynamic offset, which must be a multiple of `minUniformBufferOffsetAlignment` (at most 256
+// bytes).
+static_assert((scPaletteSize % 256) == 0);
+
+/// Number of instances evaluated per job.
+static constexpr uint32 scInstancesPerJob = 2;
+
+AnimationManager::AnimationManager()
+{
+    mInstances.Init(Limits::MaxAnimationInstances);
+    mActiveInstances.InitCapacity(Limits::MaxAnimationInstances);
+}
+
+AnimInstanceId AnimationManager::CreateInstance(const Ref<Skeleton>& skeleton)
+{
+    Assert(skeleton.IsValid());
+
+    if (skeleton->JointCount > Limits::MaxBones) {
+        LogError(LC_CORE, "Skeleton has {} bones, but the limit is {}", skeleton->JointCount, Limits::MaxBones);
+        return AnimInstanceNull;
+    }
+
+    uint32 index = 0;
+
+    while ((index = mInstances.SlotsInUse.FindNextSetBit(index)) != Bitset::scNoFreeBits) {
+        if (&(*mInstances.GetItem(index)->pSkeleton) == &(*skeleton)) {
+            LogError(LC_CORE, "Skeleton is already used by animation instance {}", index);
+            return AnimInstanceNull;
+        }
+
+        ++index;
+    }
+
+    AnimationInstance* instance = mInstances.NewItem(&index);
+
+    if (instance == nullptr) {
+        LogError(LC_CORE, "Could not create animation instance, all {} palette slots are in use",
+                 Limits::MaxAnimationInstances);
+        return AnimInstanceNull;
+    }
+
+    // Start from an empty instance, so no clips or layers carry over from an instance that used the slot before
+    *instance = AnimationInstance {};
+    instance->pSkeleton = skeleton;
+
+    // Slot zero is the bind pose
+    instance->PaletteSlot = index + 1;
+
+    // Start at the bind pose in every frame in flight until the first update
+    for (uint32 frame_index = 0; frame_index < renderer::FramesInFlight; frame_index++) {
+        uint8* palette = gRenderer->BoneBuffer.GetBasePtr() + gRenderer->BoneBuffer.GetBaseOffset(frame_index) +
+                         (instance->PaletteSlot * scPaletteSize);
+
+        for (uint32 bone = 0; bone < Limits::MaxBones; bone++) {
+            memcpy(palette + (bone * sizeof(Mat4f)), Mat4f::sIdentity.RawData, sizeof(Mat4f));
+        }
+    }
+
+    return index;
+}
+
+void AnimationManager::DestroyInstance(AnimInstanceId& id)
+{
+    if (id == AnimInstanceNull) {
+        return;
+    }
+
+    mInstances.FreeItem(id);
+    id = AnimInstanceNull;
+}
+
+AnimationInstance* AnimationManager::GetInstance(AnimInstanceId id)
+{
+    if (id == AnimInstanceNull) {
+        return nullptr;
+    }
+
+    return mInstances.GetItem(id);
+}
+
+AnimationPlayback* AnimationManager::FindPlayback(AnimationPlayback* playbacks, uint32 count, const Animation* clip)
+{
+    for (uint32 i = 0; i < count; i++) {
+        if (playbacks[i].pClip == clip) {
+            return &playbacks[i];
+        }
+    }
+
+    return nullptr;
+}
+
+AnimationPlayback* AnimationManager::FindFreePlayback(AnimationPlayback* playbacks, uint32 count)
+{
+    AnimationPlayback* playback = FindPlayback(playbacks, count, nullptr);
+
+    if (playback != nullptr) {
+        return playback;
+    }
+
+    // Replace the clip with the lowest weight
+    playback = &playbacks[0];
+
+    for (uint32 i = 1; i < count; i++) {
+        if (playbacks[i].Weight < playback->Weight) {
+            playback = &playbacks[i];
+        }
+    }
+
+    return playback;
+}
+
+void AnimationManager::Play(AnimInstanceId id, Animation* clip, float32 fade_time, bool loop)
+{
+    AnimationInstance* instance = GetInstance(id);
+
+    if (instance == nullptr || clip == nullptr) {
+        return;
+    }
+
+    const bool cross_fade = (fade_time > 0.0f);
+
+    for (AnimationPlayback& playback : instance->Clips) {
+        if (!playback.IsActive() || playback.pClip == clip) {
+            continue;
+        }
+
+        if (cross_fade) {
+            playback.WeightDelta = -playback.Weight / fade_time;
+        }
+        else {
+            playback.pClip = nullptr;
+        }
+    }
+
+    AnimationPlayback* playback = FindPlayback(instance->Clips, AnimationInstance::scMaxClips, clip);
+
+    if (playback == nullptr) {
+        playback = FindFreePlayback(instance->Clips, AnimationInstance::scMaxClips);
+        playback->Weight = 0.0f;
+    }
+
+    playback->pClip = clip;
+    playback->Time = 0.0f;
+    playback->bLoop = loop;
+
+    if (cross_fade) {
+        playback->WeightDelta = (1.0f - playback->Weight) / fade_time;
+    }
+    else {
+        playback->Weight = 1.0f;
+        playback->WeightDelta = 0.0f;
+    }
+}
+
+void AnimationManager::SetBlendWeight(AnimInstanceId id, Animation* clip, float32 weight, bool loop)
+{
+    AnimationInstance* instance = GetInstance(id);
+
+    if (instance == nullptr || clip == nullptr) {
+        return;
+    }
+
+    AnimationPlayback* playback = FindPlayback(instance->Clips, AnimationInstance::scMaxClips, clip);
+
+    if (weight <= 0.0f) {
+        if (playback != nullptr) {
+            playback->pClip = nullptr;
+        }
+        return;
+    }
+
+    if (playback == nullptr) {
+        playback = FindFreePlayback(instance->Clips, AnimationInstance::scMaxClips);
+        playback->pClip = clip;
+        playback->Time = 0.0f;
+    }
+
+    playback->Weight = weight;
+    playback->WeightDelta = 0.0f;
+    playback->bLoop = loop;
+}
+
+void AnimationManager::PlayAdditive(AnimInstanceId id, Animation* clip, float32 weight, bool loop)
+{
+    AnimationInstance* instance = GetInstance(id);
+
+    if (instance == nullptr || clip == nullptr) {
+        return;
+    }
+
+    for (AnimationLayer& layer : instance->Layers) {
+        if (layer.Playback.pClip == clip) {
+            layer.Playback.Weight = weight;
+            layer.Playback.bLoop = loop;
+            return;
+        }
+    }
+
+    for (AnimationLayer& layer : instance->Layers) {
+        if (layer.Playback.IsActive()) {
+            continue;
+        }
+
+        layer.Playback.pClip = clip;
+        layer.Playback.Time = 0.0f;
+        layer.Playback.Weight = weight;
+        layer.Playback.WeightDelta = 0.0f;
+        layer.Playback.bLoop = loop;
+
+        SizedArray<BoneTrackCursor> cursors;
+        instance->pSkeleton->SamplePose(*clip, 0.0f, layer.ReferencePose, cursors);
+
+        return;
+    }
+
+    LogWarning(LC_CORE, "Could not play additive clip, all {} layers are in use", AnimationInstance::scMaxLayers);
+}
+
+void AnimationManager::StopAdditive(AnimInstanceId id, Animation* clip)
+{
+    AnimationInstance* instance = GetInstance(id);
+
+    if (instance == nullptr) {
+        return;
+    }
+
+    for (AnimationLayer& layer : instance->Layers) {
+        if (layer.Playback.pClip == clip) {
+            layer.Playback.pClip = nullptr;
+        }
+    }
+}
+
+uint32 AnimationManager::GetPaletteOffset(AnimInstanceId id) const
+{
+    if (id == AnimInstanceNull) {
+        return 0;
+    }
+
+    return (id + 1) * scPaletteSize;
+}
+
+void AnimationManager::AdvancePlayback(AnimationPlayback& playback, float32 delta_time)
+{
+    if (!playback.IsActive()) {
+        return;
+    }
+
+    const float32 duration = playback.pClip->Duration;
+
+    playback.Time += delta_time * playback.Speed;
+
+    if (playback.bLoop && duration > 0.0f) {
+        playback.Time = fmodf(playback.Time, duration);
+
+        if (playback.Time < 0.0f) {
+            playback.Time += duration;
+        }
+    }
+    else {
+        playback.Time = std::clamp(playback.Time, 0.0f, duration);
+    }
+
+    if (playback.WeightDelta == 0.0f) {
+        return;
+    }
+
+    playback.Weight += playback.WeightDelta * delta_time;
+
+    if (playback.WeightDelta < 0.0f && playback.Weight <= 0.0f) {
+        // Faded out
+        playback.pClip = nullptr;
+        playback.Weight = 0.0f;
+        playback.WeightDelta = 0.0f;
+    }
+    else if (playback.WeightDelta > 0.0f && playback.Weight >= 1.0f) {
+        playback.Weight = 1.0f;
+        playback.WeightDelta = 0.0f;
+    }
+}
+
+void AnimationManager::EvaluateInstance(AnimationInstance& instance, uint8* palettes)
+{
+    Skeleton& skeleton = *instance.pSkeleton;
+
+    // Blend the clips by weight. Each clip is blended in with its share of the total weight so far, so the result is
+    // the weighted average of every clip.
+    float32 total_weight = 0.0f;
+
+    for (AnimationPlayback& playback : instance.Clips) {
+        if (!playback.IsActive() || playback.Weight <= 0.0f) {
+            continue;
+        }
+
+        // The first clip is sampled directly into the local pose
+        if (total_weight == 0.0f) {
+            skeleton.SamplePose(*playback.pClip, playback.Time, skeleton.LocalPose, playback.Cursors);
+            total_weight = playback.Weight;
+            continue;
+        }
+
+        total_weight += playback.Weight;
+
+        skeleton.SamplePose(*playback.pClip, playback.Time, playback.Pose, playback.Cursors);
+        BlendPose(skeleton.LocalPose, playback.Pose, playback.Weight / total_weight);
+    }
+
+    uint8* palette = palettes + (instance.PaletteSlot * scPaletteSize);
+
+    // Nothing is playing, hold the last pose. Palettes are written to the bone buffer slot of the current frame in
+    // flight, so the last pose is written again each frame rather than left in the slot it was evaluated into.
+    if (total_weight == 0.0f) {
+        if (instance.bHasPose) {
+            memcpy(palette, skeleton.SkinningMatrices.pData, skeleton.JointCount * sizeof(Mat4f));
+        }
+        return;
+    }
+
+    for (AnimationLayer& layer : instance.Layers) {
+        AnimationPlayback& playback = layer.Playback;
+
+        if (!playback.IsActive() || playback.Weight <= 0.0f) {
+            continue;
+        }
+
+        skeleton.SamplePose(*playback.pClip, playback.Time, playback.Pose, playback.Cursors);
+        AddPose(skeleton.LocalPose, playback.Pose, layer.ReferencePose, playback.Weight);
+    }
+
+    skeleton.UpdateSkinningMatrices();
+    instance.bHasPose = true;
+
+    memcpy(palette, skeleton.SkinningMatrices.pData, skeleton.JointCount * sizeof(Mat4f));
+}
+
+void AnimationManager::Update(float32 delta_time)
+{
+    mActiveInstances.Clear();
+
+    uint32 index = 0;
+
+    while ((index = mInstances.SlotsInUse.FindNextSetBit(index)) != Bitset::scNoFreeBits) {
+        AnimationInstance* instance = mInstances.GetItem(index);
+
+        for (AnimationPlayback& playback : instance->Clips) {
+            AdvancePlayback(playback, delta_time);
+        }
+
+        for (AnimationLayer& layer : instance->Layers) {
+            AdvancePlayback(layer.Playback, delta_time);
+        }
+
+        mActiveInstances.Insert(instance);
+
+        ++index;
+    }
+
+    const uint32 instance_count = static_cast<uint32>(mActiveInstances.Size);
+
+    if (instance_count == 0) {
+        return;
+    }
+
+    uint8* palettes = gRenderer->BoneBuffer.GetBasePtr() + gRenderer->BoneBuffer.GetBaseOffset();
+
+    auto evaluate_instances = [&](uint32 start, uint32 end)
+    {
+        for (uint32 i = start; i < end; i++) {
+            EvaluateInstance(*mActiveInstances.pData[i], palettes);
+        }
+    };
+
+    if (gJobSystem) {
+        gJobSystem->ParallelFor(instance_count, scInstancesPerJob, evaluate_instances);
+    }
+    else {
+        evaluate_instances(0, instance_count);
+    }
+}
+
+} // namespace fx
@@ -1,20 +1,141 @@
 #pragma once
 
-
+#include <Asset/Animation.hpp>
+#include <Core/FreeArray.hpp>
+#include <Core/Ref.hpp>
+#include <Core/SizedArray.hpp>
 #include <Core/Types.hpp>
-#include <Renderer/Backend/GpuBuffer.hpp>
 
 namespace fx {
 
+using AnimInstanceId = uint32;
+static constexpr AnimInstanceId AnimInstanceNull = UINT32_MAX;
+
+/**
+ * A clip playing on an animation instance.
+ */
+struct AnimationPlayback
+{
+    FX_FORCE_INLINE bool IsActive() const { return pClip != nullptr; }
+
+    Animation* pClip = nullptr;
+
+    float32 Time = 0.0f;
+    float32 Speed = 1.0f;
+
+    float32 Weight = 1.0f;
+
+    /// Change in weight per second while cross-fading. The clip is stopped once it fades out.
+    float32 WeightDelta = 0.0f;
+
+    bool bLoop = true;
+
+    /// The sampled pose and the playback position in each track, kept between frames.
+    SkeletonPose Pose;
+    SizedArray<BoneTrackCursor> Cursors;
+};
+
+/**
+ * A clip that is added on top of the blended pose, such as a breathing or aiming clip.
+ */
+struct AnimationLayer
+{
+    AnimationPlayback Playback;
+
+    /// The first frame of the clip. The layer adds the difference between the current frame and this pose.
+    SkeletonPose ReferencePose;
+};
+
+/**
+ * The playback state of one skeleton.
+ */
+struct AnimationInstance
+{
+    static constexpr uint32 scMaxClips = 4;
+    static constexpr uint32 scMaxLayers = 2;
+
+    Ref<Skeleton> pSkeleton { nullptr };
+
+    /// Clips blended by their weights. The first clip's pose is sampled into the skeleton's local pose.
+    AnimationPlayback Clips[scMaxClips];
+    AnimationLayer Layers[scMaxLayers];
+
+    /// Index of the skinning palette for this instance in the bone buffer.
+    uint32 PaletteSlot = 0;
+
+    /// True once a pose has been evaluated into the skeleton's skinning matrices. Until then, the palette is the bind
+    /// pose written by `AnimationManager::CreateInstance()`.
+    bool bHasPose = false;
+};
+
+/**
+ * @brief Owns the playback state of each animated skeleton and evaluates every pose each frame.
+ *
+ * Each instance blends up to `AnimationInstance::scMaxClips` clips by weight (see `Play()` for cross-fades and
+ * `SetBlendWeight()` for blend spaces), then applies any additive layers. Poses are evaluated in parallel on the job
+ * system, and each instance's skinning palette is written to its own slot of `RenderBackend::BoneBuffer`. The first slot
+ * is never assigned and holds the bind pose.
+ *
+ * @note This is not thread safe; instances should be created and played from the main thread.
+ */
 class AnimationManager
 {
 public:
-    AnimationManager() = default;
+    AnimationManager();
+
+    /**
+     * @brief Creates an instance that plays animations on `skeleton`. Each skeleton can only be used by one instance.
+     * @returns The instance ID, or `AnimInstanceNull` if there are no palette slots remaining.
+     */
+    AnimInstanceId CreateInstance(const Ref<Skeleton>& skeleton);
+    void DestroyInstance(AnimInstanceId& id);
+
+    AnimationInstance* GetInstance(AnimInstanceId id);
+
+    /**
+     * @brief Plays `clip` from the start, fading out every other clip over `fade_time` seconds. If `fade_time` is zero,
+     * the other clips are stopped immediately.
+     */
+    void Play(AnimInstanceId id, Animation* clip, float32 fade_time = 0.0f, bool loop = true);
+
+    /**
+     * @brief Sets the weight of `clip` in the blend, starting it if it is not already playing. A weight of zero stops
+     * the clip. Weights are relative to the other clips that are playing.
+     */
+    void SetBlendWeight(AnimInstanceId id, Animation* clip, float32 weight, bool loop = true);
+
+    /**
+     * @brief Plays `clip` as an additive layer, or sets its weight if it is already playing.
+     */
+    void PlayAdditive(AnimInstanceId id, Animation* clip, float32 weight = 1.0f, bool loop = true);
+    void StopAdditive(AnimInstanceId id, Animation* clip);
+
+    /**
+     * @brief Returns the offset of the instance's skinning palette from the start of the bone buffer for a frame. This
+     * is zero (the bind pose) for `AnimInstanceNull`.
+     */
+    uint32 GetPaletteOffset(AnimInstanceId id) const;
+
+    /**
+     * @brief Advances every instance by `delta_time` seconds, evaluates their poses in parallel and writes the skinning
+     * palettes for the current frame.
+     */
+    void Update(float32 delta_time);
 
     ~AnimationManager() = default;
 
 private:
-    //renderer::RawGpuBuffer PoseBuffer;
+    void AdvancePlayback(AnimationPlayback& playback, float32 delta_time);
+    void EvaluateInstance(AnimationInstance& instance, uint8* palettes);
+
+    AnimationPlayback* FindPlayback(AnimationPlayback* playbacks, uint32 count, const Animation* clip);
+    AnimationPlayback* FindFreePlayback(AnimationPlayback* playbacks, uint32 count);
+
+private:
+    FreeArray<AnimationInstance> mInstances;
+
+    /// The instances that are updated this frame, gathered for the parallel evaluation.
+    SizedArray<AnimationInstance*> mActiveInstances;
 };
 
 } // namespace fx
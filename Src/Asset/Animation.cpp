@@ -1,7 +1,13 @@
 #include "Animation.hpp"
 
+#include "AnimationCompression.hpp"
+
+#include <Core/Assert.hpp>
 #include <Core/String.hpp>
+#include <Math/MathBatch.hpp>
 #include <Math/Quat.hpp>
+#include <algorithm>
+#include <cmath>
 
 
 namespace fx {
@@ -24,73 +30,354 @@ Quat Interpolate(const Quat& a, const Quat& b, float32 t)
 }
 
 template <typename T>
-static T GetComponentAtTime(float32 time, const BoneTransformTrack<T>& track)
+static T GetDefaultValue()
 {
-    const uint32 count = static_cast<uint32>(track.Times.Size);
+    if constexpr (std::is_same_v<T, Quat>) {
+        return Quat::sIdentity;
+    }
+    else if constexpr (std::is_same_v<T, Vec3f>) {
+        return Vec3f::sZero;
+    }
+    return T {};
+}
+
+/**
+ * Returns the index of the key at or before `time`, where `time` is between the first and last keys of the track.
+ */
+template <typename T>
+static uint32 FindKey(const BoneTransformTrack<T>& track, float32 time, uint32 cursor)
+{
+    const float32* times = track.Times.pData;
+    const uint32 last_pair = static_cast<uint32>(track.Times.Size) - 2;
 
-    if (count == 0) {
-        if constexpr (std::is_same_v<T, Quat>) {
-            return Quat::sIdentity;
+    if (cursor <= last_pair && times[cursor] <= time) {
+        // Still between the same keys as the last sample
+        if (time < times[cursor + 1]) {
+            return cursor;
         }
 
-        else if constexpr (std::is_same_v<T, Vec3f>) {
-            return Vec3f::sZero;
+        // Moved on to the next pair of keys
+        if (cursor < last_pair && time < times[cursor + 2]) {
+            return cursor + 1;
         }
-        return T {};
     }
 
+    // Seeked (or skipped over keys), search for the first key after the time
+    const float32* next_key = std::upper_bound(times + 1, times + last_pair + 2, time);
+    return static_cast<uint32>(next_key - times) - 1;
+}
+
+/**
+ * The keys on either side of a time in a track, and how far the time is between them.
+ */
+struct TrackKeys
+{
+    uint32 From;
+    uint32 To;
+    float32 Alpha;
+};
+
+/**
+ * Returns the keys around `time` in a track with at least one key, and updates `cursor` to the first key. Times
+ * outside of the track use the first or last key for both keys.
+ */
+template <typename T>
+FX_FORCE_INLINE static TrackKeys FindKeys(const BoneTransformTrack<T>& track, float32 time, uint32& cursor)
+{
+    const uint32 count = static_cast<uint32>(track.Times.Size);
+
     // Clamp to ends
     if (time <= track.Times.pData[0]) {
-        return track.Values.pData[0];
+        cursor = 0;
+        return TrackKeys { 0, 0, 0.0f };
     }
 
     if (time >= track.Times.pData[count - 1]) {
-        return track.Values.pData[count - 1];
+        cursor = count - 1;
+        return TrackKeys { count - 1, count - 1, 0.0f };
     }
 
-    // Find bracketing keyframes
-    for (uint32 i = 0; i < count - 1; i++) {
-        const float32 t0 = track.Times[i];
-        const float32 t1 = track.Times[i + 1];
+    uint32 key;
+    float32 alpha;
 
-        if (time >= t0 && time < t1) {
-            const float32 duration = t1 - t0;
-            const float32 alpha = (duration > 1e-6f) ? (time - t0) / duration : 0.0f;
+    if (track.SampleRate > 0.0f) {
+        // Evenly spaced keys, the key is at the whole part of the position
+        const float32 position = (time - track.Times.pData[0]) * track.SampleRate;
 
-            return Interpolate(track.Values[i], track.Values[i + 1], alpha);
-        }
+        key = std::min(static_cast<uint32>(position), count - 2);
+        alpha = std::min(position - static_cast<float32>(key), 1.0f);
+    }
+    else {
+        key = FindKey(track, time, cursor);
+
+        const float32 t0 = track.Times.pData[key];
+        const float32 duration = track.Times.pData[key + 1] - t0;
+
+        alpha = (duration > 1e-6f) ? (time - t0) / duration : 0.0f;
+    }
+
+    cursor = key;
+
+    return TrackKeys { key, key + 1, alpha };
+}
+
+template <typename T>
+static T SampleTrackImpl(const BoneTransformTrack<T>& track, float32 time, uint32& cursor)
+{
+    if (track.Times.Size == 0) {
+        return GetDefaultValue<T>();
+    }
+
+    const TrackKeys keys = FindKeys(track, time, cursor);
+
+    if (keys.From == keys.To) {
+        return track.Values.pData[keys.From];
+    }
+
+    return Interpolate(track.Values.pData[keys.From], track.Values.pData[keys.To], keys.Alpha);
+}
+
+Vec3f SampleTrack(const BoneTransformTrack<Vec3f>& track, float32 time, uint32& cursor)
+{
+    return SampleTrackImpl(track, time, cursor);
+}
+
+Quat SampleTrack(const BoneTransformTrack<Quat>& track, float32 time, uint32& cursor)
+{
+    return SampleTrackImpl(track, time, cursor);
+}
+
+template <typename T>
+static void ResampleTrack(BoneTransformTrack<T>& track, float32 sample_rate)
+{
+    const uint32 count = static_cast<uint32>(track.Times.Size);
+
+    if (count < 2) {
+        return;
+    }
+
+    const float32 start_time = track.Times.pData[0];
+    const float32 end_time = track.Times.pData[count - 1];
+    const float32 span = end_time - start_time;
+
+    if (span <= 0.0f) {
+        return;
+    }
+
+    // Round the rate up so that the last key lands on the end of the track
+    const uint32 key_count = static_cast<uint32>(std::ceil(span * sample_rate)) + 1;
+    const float32 rate = static_cast<float32>(key_count - 1) / span;
+
+    SizedArray<float32> times;
+    times.InitSize(key_count);
+
+    SizedArray<T> values;
+    values.InitSize(key_count);
+
+    uint32 cursor = 0;
+
+    for (uint32 i = 0; i < key_count; i++) {
+        const float32 time = (i == key_count - 1) ? end_time : start_time + static_cast<float32>(i) / rate;
+
+        times.pData[i] = time;
+        values.pData[i] = SampleTrackImpl(track, time, cursor);
     }
 
-    return track.Values.pData[count - 1];
+    track.Times = std::move(times);
+    track.Values = std::move(values);
+    track.SampleRate = rate;
+}
+
+void Animation::Resample(float32 sample_rate)
+{
+    Assert(sample_rate > 0.0f);
+
+    for (BoneTrack& track : BoneTracks) {
+        ResampleTrack(track.Translation, sample_rate);
+        ResampleTrack(track.Rotation, sample_rate);
+    }
+}
+
+void SkeletonPose::InitSize(uint32 bone_count)
+{
+    Translations.InitCapacity(bone_count);
+    Translations.InitSize(bone_count);
+
+    Rotations.InitCapacity(bone_count);
+    Rotations.InitSize(bone_count);
+
+    Scales.InitCapacity(bone_count);
+    Scales.InitSize(bone_count);
+
+    for (uint32 i = 0; i < bone_count; i++) {
+        Translations.pData[i] = Vec3f::sZero;
+        Rotations.pData[i] = Quat::sIdentity;
+        Scales.pData[i] = Vec3f::sOne;
+    }
+}
+
+void BlendPose(SkeletonPose& pose, const SkeletonPose& target, float32 weight)
+{
+    const uint32 bone_count = static_cast<uint32>(pose.Translations.Size);
+    Assert(target.Translations.Size == bone_count);
+
+    for (uint32 i = 0; i < bone_count; i++) {
+        pose.Translations.pData[i] = Vec3f::Lerp(pose.Translations.pData[i], target.Translations.pData[i], weight);
+        pose.Scales.pData[i] = Vec3f::Lerp(pose.Scales.pData[i], target.Scales.pData[i], weight);
+    }
+
+    MathBatch::SLerpArray(pose.Rotations.pData, pose.Rotations.pData, target.Rotations.pData, weight, bone_count);
+}
+
+void AddPose(SkeletonPose& pose, const SkeletonPose& additive, const SkeletonPose& reference, float32 weight)
+{
+    const uint32 bone_count = static_cast<uint32>(pose.Translations.Size);
+    Assert(additive.Translations.Size == bone_count && reference.Translations.Size == bone_count);
+
+    for (uint32 i = 0; i < bone_count; i++) {
+        const Vec3f translation_delta = additive.Translations.pData[i] - reference.Translations.pData[i];
+        pose.Translations.pData[i] += translation_delta * weight;
+
+        // The rotation from the reference to the additive pose, applied in the bone's own space
+        const Quat rotation_delta = reference.Rotations.pData[i].Conjugate() * additive.Rotations.pData[i];
+        pose.Rotations.pData[i] = pose.Rotations.pData[i] * Quat::sIdentity.SLerp(rotation_delta, weight);
+    }
+}
+
+void Skeleton::InitPoseBuffers(uint32 joint_count)
+{
+    LocalPose.InitSize(joint_count);
+    WorldPose.InitSize(joint_count);
+
+    mRotationsFrom.InitCapacity(joint_count);
+    mRotationsFrom.InitSize(joint_count);
+
+    mRotationsTo.InitCapacity(joint_count);
+    mRotationsTo.InitSize(joint_count);
+
+    mRotationSteps.InitCapacity(joint_count);
+    mRotationSteps.InitSize(joint_count);
 }
 
 void Skeleton::EvaluatePose(Animation& anim, float32 time)
+{
+    SamplePose(anim, time, LocalPose, TrackCursors);
+    UpdateSkinningMatrices();
+}
+
+void Skeleton::SamplePose(const Animation& anim, float32 time, SkeletonPose& out_pose,
+                          SizedArray<BoneTrackCursor>& cursors)
 {
     const uint32 joint_count = JointCount;
 
-    for (uint32 i = 0; i < joint_count; i++) {
-        const BoneTrack& track = anim.BoneTracks[i];
+    if (mRotationSteps.Size != joint_count) {
+        InitPoseBuffers(joint_count);
+    }
 
-        Vec3f translation = GetComponentAtTime(time, track.Translation);
-        Quat rotation = GetComponentAtTime(time, track.Rotation);
+    if (out_pose.Translations.Size != joint_count) {
+        out_pose.InitSize(joint_count);
+    }
 
-        LocalTransforms.pData[i] = Mat4f::AsRotation(rotation) * Mat4f::AsTranslation(translation);
+    if (cursors.Size != joint_count) {
+        cursors.InitCapacity(joint_count);
+        cursors.InitSize(joint_count);
     }
 
+    // Bones without a track in this animation stay at the identity
+    const uint32 track_count = std::min(joint_count, static_cast<uint32>(anim.BoneTracks.Size));
+
+    // The rotation keys are gathered here and interpolated for every bone at once below
+    for (uint32 i = 0; i < track_count; i++) {
+        const BoneTrack& track = anim.BoneTracks.pData[i];
+        BoneTrackCursor& cursor = cursors.pData[i];
+
+        out_pose.Translations.pData[i] = SampleTrack(track.Translation, time, cursor.TranslationKey);
+
+        if (track.Rotation.Times.Size == 0) {
+            mRotationsFrom.pData[i] = Quat::sIdentity;
+            mRotationsTo.pData[i] = Quat::sIdentity;
+            mRotationSteps.pData[i] = 0.0f;
+            continue;
+        }
+
+        const TrackKeys keys = FindKeys(track.Rotation, time, cursor.RotationKey);
+
+        mRotationsFrom.pData[i] = track.Rotation.Values.pData[keys.From];
+        mRotationsTo.pData[i] = track.Rotation.Values.pData[keys.To];
+        mRotationSteps.pData[i] = keys.Alpha;
+    }
+
+    MathBatch::SLerpArray(out_pose.Rotations.pData, mRotationsFrom.pData, mRotationsTo.pData, mRotationSteps.pData,
+                          track_count);
+}
+
+void Skeleton::EvaluatePose(const CompressedAnimation& clip, float32 time)
+{
+    SamplePose(clip, time, LocalPose);
+    UpdateSkinningMatrices();
+}
+
+void Skeleton::SamplePose(const CompressedAnimation& clip, float32 time, SkeletonPose& out_pose)
+{
+    const uint32 joint_count = JointCount;
+
+    if (mRotationSteps.Size != joint_count) {
+        InitPoseBuffers(joint_count);
+    }
+
+    if (out_pose.Translations.Size != joint_count) {
+        out_pose.InitSize(joint_count);
+    }
+
+    const uint32 bone_count = std::min(joint_count, clip.GetBoneCount());
+    const CompressedAnimation::FramePair frames = clip.FindFrames(time);
+
+    clip.DecodeTranslations(frames.From, frames.To, frames.Alpha, out_pose.Translations.pData, bone_count);
+
+    // Both frames are decoded in full and interpolated for every bone at once
+    clip.DecodeRotations(frames.From, mRotationsFrom.pData, bone_count);
+    clip.DecodeRotations(frames.To, mRotationsTo.pData, bone_count);
+
+    MathBatch::SLerpArray(out_pose.Rotations.pData, mRotationsFrom.pData, mRotationsTo.pData, frames.Alpha,
+                          bone_count);
+}
+
+void Skeleton::UpdateSkinningMatrices()
+{
+    const uint32 joint_count = JointCount;
+
+    if (WorldPose.Translations.Size != joint_count) {
+        InitPoseBuffers(joint_count);
+    }
+
+    // Propagate down the hierarchy. Parents always come before their children, so each parent is already in world
+    // space. Scales are multiplied component-wise, which is exact for uniform scales.
     for (uint32 i = 0; i < joint_count; i++) {
         const int32 parent = ParentIndices.pData[i];
 
         if (parent < 0) {
-            WorldTransforms[i] = LocalTransforms[i];
-        }
-        else {
-            WorldTransforms[i] = LocalTransforms[i] * WorldTransforms[parent];
+            WorldPose.Translations.pData[i] = LocalPose.Translations.pData[i];
+            WorldPose.Rotations.pData[i] = LocalPose.Rotations.pData[i];
+            WorldPose.Scales.pData[i] = LocalPose.Scales.pData[i];
+            continue;
         }
-    }
 
-    for (uint32 i = 0; i < joint_count; i++) {
-        SkinningMatrices[i] = InvBindTransforms[i] * WorldTransforms[i];
+        const Quat& parent_rotation = WorldPose.Rotations.pData[parent];
+        const Vec3f& parent_scale = WorldPose.Scales.pData[parent];
+
+        // `Vec3f::Rotate()` applies the inverse of the rotation that `Mat4f::AsRotation()` builds
+        const Vec3f offset = (LocalPose.Translations.pData[i] * parent_scale).Rotate(parent_rotation.Conjugate());
+
+        WorldPose.Translations.pData[i] = WorldPose.Translations.pData[parent] + offset;
+        WorldPose.Rotations.pData[i] = parent_rotation * LocalPose.Rotations.pData[i];
+        WorldPose.Scales.pData[i] = parent_scale * LocalPose.Scales.pData[i];
     }
+
+    // Only the final palette is built as matrices
+    MathBatch::ComposeTRSArray(WorldTransforms.pData, WorldPose.Translations.pData, WorldPose.Rotations.pData,
+                               WorldPose.Scales.pData, joint_count);
+
+    MathBatch::MulMat4Array(SkinningMatrices.pData, InvBindTransforms.pData, WorldTransforms.pData, joint_count);
 }
 
 BoneTransform Skeleton::GetBoneTransform(const Ref<Animation>& anim, float32 time, BoneId bone_id) const
@@ -113,8 +400,11 @@ BoneTransform Skeleton::GetBoneTransform(const Ref<Animation>& anim, float32 tim
     // Another strange oddity (likely due to converting from GLTF's horrid coordinates) is that Z is
     // negated. But also negating that component in the matrix causes spaghetti limbs.
 
+    // Start from the key that the last pose used, without moving the cursor
+    uint32 cursor = (bone_id < TrackCursors.Size) ? TrackCursors[bone_id].RotationKey : 0;
+
     return BoneTransform(Vec3f::FlipSigns<1, 1, -1, 1>(SkinningMatrices[bone_id].GetTranslation()),
-                         GetComponentAtTime(time, track.Rotation));
+                         SampleTrack(track.Rotation, time, cursor));
 }
 
 Mat4f Skeleton::GetBoneTransformMatrix(const Ref<Animation>& anim, float32 time, BoneId bone_id) const
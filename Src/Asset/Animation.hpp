@@ -10,6 +10,8 @@
 
 namespace fx {
 
+class CompressedAnimation;
+
 using BoneId = uint32;
 static constexpr BoneId BoneNull = UINT32_MAX;
 
@@ -18,6 +20,10 @@ struct BoneTransformTrack
 {
     SizedArray<float32> Times;
     SizedArray<T> Values;
+
+    /// Keys per second if the keys are evenly spaced from the first key time (see `Animation::Resample()`), in which
+    /// case the key for a time is calculated rather than searched for. Zero if the keys can be at any time.
+    float32 SampleRate = 0.0f;
 };
 
 struct BoneTrack
@@ -26,13 +32,42 @@ struct BoneTrack
     BoneTransformTrack<Quat> Rotation;
 };
 
+/**
+ * The last key used in each track of a bone, so that the next sample can start from there. While an animation is
+ * playing the time usually stays between the same two keys or moves on to the next pair, so sampling is constant time
+ * instead of a search through every key.
+ */
+struct BoneTrackCursor
+{
+    uint32 TranslationKey = 0;
+    uint32 RotationKey = 0;
+};
+
 struct Animation
 {
+    /**
+     * @brief Replaces the keys of each track with keys evenly spaced at `sample_rate` keys per second, sampled from the
+     * original keys. Sampling the resampled tracks does not need to search for a key.
+     *
+     * This uses more memory when the original keys are further apart than `1 / sample_rate`.
+     */
+    void Resample(float32 sample_rate);
+
     String Name;
     float32 Duration = 0.0f;
     SizedArray<BoneTrack> BoneTracks;
 };
 
+/**
+ * @brief Returns the value of a track at `time`, interpolated between the keys around it and clamped to the first and
+ * last keys.
+ *
+ * @param cursor The key that the last sample of this track used. This is checked first, then the next key, and the key
+ * is searched for (in log time) if neither of them contain `time`, such as after a seek. Updated to the key used.
+ */
+Vec3f SampleTrack(const BoneTransformTrack<Vec3f>& track, float32 time, uint32& cursor);
+Quat SampleTrack(const BoneTransformTrack<Quat>& track, float32 time, uint32& cursor);
+
 struct BoneTransform
 {
     BoneTransform() = default;
@@ -42,24 +77,92 @@ struct BoneTransform
     Quat Rotation = Quat::sIdentity;
 };
 
+/**
+ * The transform of each bone as separate translation, rotation and scale arrays, so that each part can be processed for
+ * every bone at once (see `MathBatch`).
+ */
+struct SkeletonPose
+{
+    /// Resizes each array to `bone_count`, with every bone set to the identity transform.
+    void InitSize(uint32 bone_count);
+
+    SizedArray<Vec3f> Translations;
+    SizedArray<Quat> Rotations;
+    SizedArray<Vec3f> Scales;
+};
+
+/**
+ * @brief Moves each bone of `pose` towards `target` by `weight`, where a weight of one replaces `pose` with `target`.
+ *
+ * To blend several poses by their weights, blend each one in with its weight divided by the sum of the weights so far.
+ */
+void BlendPose(SkeletonPose& pose, const SkeletonPose& target, float32 weight);
+
+/**
+ * @brief Applies the difference between `additive` and `reference` to each bone of `pose`, scaled by `weight`. This is
+ * used for additive layers, where `reference` is usually the first frame of the additive clip.
+ */
+void AddPose(SkeletonPose& pose, const SkeletonPose& additive, const SkeletonPose& reference, float32 weight);
+
 struct Skeleton
 {
 public:
+    /**
+     * @brief Samples `anim` at `time` into `LocalPose` and updates the skinning matrices from it.
+     */
     void EvaluatePose(Animation& anim, float32 time);
+    void EvaluatePose(const CompressedAnimation& clip, float32 time);
+
+    /**
+     * @brief Samples `anim` at `time` into `out_pose`, relative to each bone's parent.
+     *
+     * @param cursors The playback position in each track of `anim` (see `BoneTrackCursor`). This is resized to the
+     * number of bones if needed.
+     */
+    void SamplePose(const Animation& anim, float32 time, SkeletonPose& out_pose,
+                    SizedArray<BoneTrackCursor>& cursors);
+
+    /**
+     * @brief Decodes the frames of `clip` around `time` into `out_pose`, relative to each bone's parent. Frames are
+     * found from the time, so no cursors are needed.
+     */
+    void SamplePose(const CompressedAnimation& clip, float32 time, SkeletonPose& out_pose);
+
+    /**
+     * @brief Builds `WorldPose`, `WorldTransforms` and `SkinningMatrices` from `LocalPose`.
+     */
+    void UpdateSkinningMatrices();
+
     BoneTransform GetBoneTransform(const Ref<Animation>& anim, float32 time, BoneId bone_id) const;
     Mat4f GetBoneTransformMatrix(const Ref<Animation>& anim, float32 time, BoneId bone_id) const;
 
     BoneId FindBone(const Ref<Animation>& anim, const String& name) const;
 
+private:
+    void InitPoseBuffers(uint32 joint_count);
+
 public:
     SizedArray<Mat4f> InvBindTransforms;
     SizedArray<uint32> ParentIndices;
     SizedArray<String> BoneNames;
     uint32 JointCount = 0;
 
-    SizedArray<Mat4f> LocalTransforms;
+    /// The pose of each bone relative to its parent, and relative to the skeleton root. Bones are kept as translation,
+    /// rotation and scale until the end of `EvaluatePose()`, where each is converted to a matrix once.
+    SkeletonPose LocalPose;
+    SkeletonPose WorldPose;
+
     SizedArray<Mat4f> WorldTransforms;
     SizedArray<Mat4f> SkinningMatrices;
+
+    /// The playback position in each bone track for `EvaluatePose()`.
+    SizedArray<BoneTrackCursor> TrackCursors;
+
+private:
+    /// The keys on either side of the current time for each rotation track, which are interpolated together.
+    SizedArray<Quat> mRotationsFrom;
+    SizedArray<Quat> mRotationsTo;
+    SizedArray<float32> mRotationSteps;
 };
 
 } // namespace fx
@@ -0,0 +1,533 @@
+#include "AnimationBenchmark.hpp"
+
+#include "Animation.hpp"
+#include "AnimationCompression.hpp"
+
+#include <Core/Log.hpp>
+#include <Math/Mat4.hpp>
+#include <Math/MathConsts.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace fx {
+
+static constexpr uint32 scBoneCount = 100;
+static constexpr uint32 scKeyCount = 1000;
+static constexpr float32 scKeyRate = 30.0f;
+static constexpr float32 scFrameRate = 60.0f;
+static constexpr uint32 scCrowdSize = 64;
+
+/// Largest difference allowed between a sampled value and the linear scan result.
+static constexpr float32 scSampleTolerance = 1e-4f;
+
+/// Largest difference allowed between a skinning matrix and the matrix product result. The hierarchy is composed with
+/// quaternions instead of rotation matrices, so the rounding differs slightly at each level.
+static constexpr float32 scPoseTolerance = 1e-3f;
+
+/// The resampled clip finds the key from `time * rate`, which near the end of the clip is only accurate to a few
+/// hundredths of a percent of the key spacing in single precision. The random keys here make that show up in full.
+static constexpr float32 scResampledTolerance = 1e-3f;
+
+/// Motion capture is usually recorded at a higher rate than hand keyed animation.
+static constexpr float32 scMocapKeyRate = 60.0f;
+
+/// Largest difference allowed between a pose decoded from the compressed clip and the uncompressed pose. Rotations are
+/// quantized to steps of about 4e-5, but decode to unit length, while `Quat::FromAxisAngle()` uses an approximate sine
+/// and is only unit length to a few 1e-4.
+static constexpr float32 scCompressedTolerance = 1e-3f;
+
+struct SampleResults
+{
+    std::vector<Vec3f> Translations;
+    std::vector<Quat> Rotations;
+};
+
+static void GenerateClip(Animation& anim)
+{
+    std::mt19937 rng(0xF0C5);
+    std::uniform_real_distribution<float32> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float32> angle(-FX_PI, FX_PI);
+
+    anim.Duration = static_cast<float32>(scKeyCount - 1) / scKeyRate;
+    anim.BoneTracks.InitSize(scBoneCount);
+
+    for (BoneTrack& track : anim.BoneTracks) {
+        track.Translation.Times.InitSize(scKeyCount);
+        track.Translation.Values.InitSize(scKeyCount);
+        track.Rotation.Times.InitSize(scKeyCount);
+        track.Rotation.Values.InitSize(scKeyCount);
+
+        for (uint32 i = 0; i < scKeyCount; i++) {
+            const float32 time = static_cast<float32>(i) / scKeyRate;
+
+            track.Translation.Times.pData[i] = time;
+            track.Translation.Values.pData[i] = Vec3f(unit(rng), unit(rng), unit(rng));
+
+            const Vec3f axis(unit(rng), unit(rng), unit(rng) + 2.0f);
+
+            track.Rotation.Times.pData[i] = time;
+            track.Rotation.Values.pData[i] = Quat::FromAxisAngle(axis, angle(rng));
+        }
+    }
+}
+
+/**
+ * The sampling that `SampleTrack()` replaced, which scans from the first key on every call.
+ */
+template <typename T>
+static T SampleTrackLinear(const BoneTransformTrack<T>& track, float32 time)
+{
+    const uint32 count = static_cast<uint32>(track.Times.Size);
+
+    if (time <= track.Times.pData[0]) {
+        return track.Values.pData[0];
+    }
+
+    for (uint32 i = 0; i < count - 1; i++) {
+        const float32 t0 = track.Times.pData[i];
+        const float32 t1 = track.Times.pData[i + 1];
+
+        if (time >= t0 && time < t1) {
+            const float32 duration = t1 - t0;
+            const float32 alpha = (duration > 1e-6f) ? (time - t0) / duration : 0.0f;
+
+            if constexpr (std::is_same_v<T, Quat>) {
+                return track.Values.pData[i].SLerp(track.Values.pData[i + 1], alpha);
+            }
+            else {
+                return Vec3f::Lerp(track.Values.pData[i], track.Values.pData[i + 1], alpha);
+            }
+        }
+    }
+
+    return track.Values.pData[count - 1];
+}
+
+/**
+ * Returns the best time in nanoseconds per frame of `iterations` runs of `func`.
+ */
+template <typename TFunc>
+static double TimeBest(uint32 iterations, uint32 frame_count, TFunc&& func)
+{
+    using Clock = std::chrono::steady_clock;
+
+    double best_ns = 0.0;
+
+    for (uint32 iteration = 0; iteration < iterations; iteration++) {
+        const auto start_time = Clock::now();
+
+        func();
+
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start_time).count() / frame_count;
+
+        if (iteration == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+    }
+
+    return best_ns;
+}
+
+static float32 GetMaxError(const SampleResults& expected, const SampleResults& result)
+{
+    float32 max_error = 0.0f;
+
+    for (uint32 i = 0; i < expected.Translations.size(); i++) {
+        const Vec3f& a = expected.Translations[i];
+        const Vec3f& b = result.Translations[i];
+
+        max_error = std::max(max_error, fabsf(a.GetX() - b.GetX()));
+        max_error = std::max(max_error, fabsf(a.GetY() - b.GetY()));
+        max_error = std::max(max_error, fabsf(a.GetZ() - b.GetZ()));
+    }
+
+    for (uint32 i = 0; i < expected.Rotations.size(); i++) {
+        const Quat& a = expected.Rotations[i];
+        const Quat& b = result.Rotations[i];
+
+        max_error = std::max(max_error, fabsf(a.GetX() - b.GetX()));
+        max_error = std::max(max_error, fabsf(a.GetY() - b.GetY()));
+        max_error = std::max(max_error, fabsf(a.GetZ() - b.GetZ()));
+        max_error = std::max(max_error, fabsf(a.GetW() - b.GetW()));
+    }
+
+    return max_error;
+}
+
+static bool ReportSamplingResult(const char* name, double baseline_ns, double ns, float32 max_error,
+                                 float32 tolerance = scSampleTolerance)
+{
+    const bool passed = (max_error <= tolerance);
+
+    if (!passed) {
+        LogError(LC_CORE, "Animation benchmark: {} differs from the linear scan by {}", name, max_error);
+    }
+
+    LogInfo(LC_CORE, "    {:<14} {:10.1f} ns/frame ({:.2f}x)", name, ns, baseline_ns / ns);
+
+    return passed;
+}
+
+bool AnimationBenchmarkSampling(uint32 iterations)
+{
+    Animation clip;
+    GenerateClip(clip);
+
+    Animation resampled_clip;
+    GenerateClip(resampled_clip);
+    resampled_clip.Resample(scKeyRate);
+
+    const uint32 frame_count = static_cast<uint32>(clip.Duration * scFrameRate) + 1;
+    const uint32 sample_count = frame_count * scBoneCount;
+
+    LogInfo(LC_CORE, "Animation benchmark: {} bones, {} keys, {} frames, {} runs", scBoneCount, scKeyCount,
+            frame_count, iterations);
+
+    auto make_results = [&]()
+    {
+        SampleResults results;
+        results.Translations.resize(sample_count);
+        results.Rotations.resize(sample_count);
+        return results;
+    };
+
+    SampleResults linear_results = make_results();
+    SampleResults search_results = make_results();
+    SampleResults cursor_results = make_results();
+    SampleResults resampled_results = make_results();
+
+    std::vector<BoneTrackCursor> cursors(scBoneCount);
+
+    const double linear_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+
+            for (uint32 bone = 0; bone < scBoneCount; bone++) {
+                const BoneTrack& track = clip.BoneTracks.pData[bone];
+                const uint32 index = frame * scBoneCount + bone;
+
+                linear_results.Translations[index] = SampleTrackLinear(track.Translation, time);
+                linear_results.Rotations[index] = SampleTrackLinear(track.Rotation, time);
+            }
+        }
+    });
+
+    const double search_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+
+            for (uint32 bone = 0; bone < scBoneCount; bone++) {
+                const BoneTrack& track = clip.BoneTracks.pData[bone];
+                const uint32 index = frame * scBoneCount + bone;
+
+                // Start from the first key each time so that every sample is a seek
+                uint32 translation_key = 0;
+                uint32 rotation_key = 0;
+
+                search_results.Translations[index] = SampleTrack(track.Translation, time, translation_key);
+                search_results.Rotations[index] = SampleTrack(track.Rotation, time, rotation_key);
+            }
+        }
+    });
+
+    const double cursor_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+
+            for (uint32 bone = 0; bone < scBoneCount; bone++) {
+                const BoneTrack& track = clip.BoneTracks.pData[bone];
+                const uint32 index = frame * scBoneCount + bone;
+
+                BoneTrackCursor& cursor = cursors[bone];
+
+                cursor_results.Translations[index] = SampleTrack(track.Translation, time, cursor.TranslationKey);
+                cursor_results.Rotations[index] = SampleTrack(track.Rotation, time, cursor.RotationKey);
+            }
+        }
+    });
+
+    const double resampled_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+
+            for (uint32 bone = 0; bone < scBoneCount; bone++) {
+                const BoneTrack& track = resampled_clip.BoneTracks.pData[bone];
+                const uint32 index = frame * scBoneCount + bone;
+
+                uint32 key = 0;
+
+                resampled_results.Translations[index] = SampleTrack(track.Translation, time, key);
+                resampled_results.Rotations[index] = SampleTrack(track.Rotation, time, key);
+            }
+        }
+    });
+
+    bool passed = true;
+
+    passed &= ReportSamplingResult("Linear scan", linear_ns, linear_ns, 0.0f);
+    passed &= ReportSamplingResult("Binary search", linear_ns, search_ns, GetMaxError(linear_results, search_results));
+    passed &= ReportSamplingResult("Cursor", linear_ns, cursor_ns, GetMaxError(linear_results, cursor_results));
+    passed &= ReportSamplingResult("Resampled", linear_ns, resampled_ns,
+                                   GetMaxError(linear_results, resampled_results), scResampledTolerance);
+
+    return passed;
+}
+
+static void GenerateSkeleton(Skeleton& skeleton)
+{
+    std::mt19937 rng(0xF0C5);
+    std::uniform_real_distribution<float32> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float32> angle(-FX_PI, FX_PI);
+
+    skeleton.JointCount = scBoneCount;
+    skeleton.ParentIndices.InitSize(scBoneCount);
+    skeleton.InvBindTransforms.InitSize(scBoneCount);
+    skeleton.WorldTransforms.InitSize(scBoneCount);
+    skeleton.SkinningMatrices.InitSize(scBoneCount);
+
+    for (uint32 i = 0; i < scBoneCount; i++) {
+        // Each bone's parent is one of the bones before it
+        skeleton.ParentIndices.pData[i] = (i == 0) ? UINT32_MAX : static_cast<uint32>(rng() % i);
+
+        const Vec3f axis(unit(rng), unit(rng), unit(rng) + 2.0f);
+        const Vec3f translation(unit(rng), unit(rng), unit(rng));
+
+        skeleton.InvBindTransforms.pData[i] = Mat4f::AsRotation(Quat::FromAxisAngle(axis, angle(rng))) *
+                                              Mat4f::AsTranslation(translation);
+    }
+}
+
+/**
+ * The pose evaluation that `Skeleton::EvaluatePose()` replaced, which builds a matrix for each bone and multiplies down
+ * the hierarchy.
+ */
+static void EvaluatePoseMatrices(const Skeleton& skeleton, const Animation& anim, float32 time,
+                                 std::vector<BoneTrackCursor>& cursors, std::vector<Mat4f>& world_transforms,
+                                 Mat4f* skinning_matrices)
+{
+    for (uint32 i = 0; i < scBoneCount; i++) {
+        const BoneTrack& track = anim.BoneTracks.pData[i];
+
+        const Vec3f translation = SampleTrack(track.Translation, time, cursors[i].TranslationKey);
+        const Quat rotation = SampleTrack(track.Rotation, time, cursors[i].RotationKey);
+
+        const Mat4f local = Mat4f::AsRotation(rotation) * Mat4f::AsTranslation(translation);
+        const int32 parent = skeleton.ParentIndices.pData[i];
+
+        world_transforms[i] = (parent < 0) ? local : local * world_transforms[parent];
+    }
+
+    for (uint32 i = 0; i < scBoneCount; i++) {
+        skinning_matrices[i] = skeleton.InvBindTransforms.pData[i] * world_transforms[i];
+    }
+}
+
+bool AnimationBenchmarkPose(uint32 iterations)
+{
+    Animation clip;
+    GenerateClip(clip);
+
+    std::vector<Skeleton> crowd(scCrowdSize);
+
+    for (Skeleton& skeleton : crowd) {
+        GenerateSkeleton(skeleton);
+    }
+
+    // Each skeleton plays the clip from a different point
+    auto get_time = [&](uint32 frame, uint32 skeleton_index)
+    {
+        const float32 time = static_cast<float32>(frame) / scFrameRate +
+                             static_cast<float32>(skeleton_index) * clip.Duration / scCrowdSize;
+        return fmodf(time, clip.Duration);
+    };
+
+    const uint32 frame_count = 60;
+
+    LogInfo(LC_CORE, "Pose benchmark: {} skeletons, {} bones, {} frames, {} runs", scCrowdSize, scBoneCount,
+            frame_count, iterations);
+
+    std::vector<std::vector<BoneTrackCursor>> matrix_cursors(scCrowdSize, std::vector<BoneTrackCursor>(scBoneCount));
+    std::vector<Mat4f> matrix_world_transforms(scBoneCount);
+    std::vector<Mat4f> matrix_results(scCrowdSize * scBoneCount);
+
+    const double matrix_ns = TimeBest(iterations, frame_count * scCrowdSize, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            for (uint32 i = 0; i < scCrowdSize; i++) {
+                EvaluatePoseMatrices(crowd[i], clip, get_time(frame, i), matrix_cursors[i], matrix_world_transforms,
+                                     &matrix_results[i * scBoneCount]);
+            }
+        }
+    });
+
+    const double pose_ns = TimeBest(iterations, frame_count * scCrowdSize, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            for (uint32 i = 0; i < scCrowdSize; i++) {
+                crowd[i].EvaluatePose(clip, get_time(frame, i));
+            }
+        }
+    });
+
+    float32 max_error = 0.0f;
+
+    for (uint32 i = 0; i < scCrowdSize; i++) {
+        for (uint32 bone = 0; bone < scBoneCount; bone++) {
+            const Mat4f& expected = matrix_results[i * scBoneCount + bone];
+            const Mat4f& result = crowd[i].SkinningMatrices.pData[bone];
+
+            for (uint32 component = 0; component < 16; component++) {
+                max_error = std::max(max_error, fabsf(expected.RawData[component] - result.RawData[component]));
+            }
+        }
+    }
+
+    const bool passed = (max_error <= scPoseTolerance);
+
+    if (!passed) {
+        LogError(LC_CORE, "Pose benchmark: skinning matrices differ from the matrix product result by {}", max_error);
+    }
+
+    LogInfo(LC_CORE, "    {:<14} {:10.1f} ns/skeleton", "Matrices", matrix_ns);
+    LogInfo(LC_CORE, "    {:<14} {:10.1f} ns/skeleton ({:.2f}x)", "TRS", pose_ns, matrix_ns / pose_ns);
+
+    return passed;
+}
+
+/**
+ * Builds a clip shaped like motion capture data, where only the root moves and each joint rotates smoothly. Bones are
+ * a fixed distance from their parent, and every fourth bone (such as a twist or finger bone) does not rotate.
+ */
+static void GenerateMocapClip(Animation& anim)
+{
+    std::mt19937 rng(0xF0C5);
+    std::uniform_real_distribution<float32> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float32> frequency(0.5f, 2.0f);
+
+    anim.Duration = static_cast<float32>(scKeyCount - 1) / scMocapKeyRate;
+    anim.BoneTracks.InitSize(scBoneCount);
+
+    for (uint32 bone = 0; bone < scBoneCount; bone++) {
+        BoneTrack& track = anim.BoneTracks.pData[bone];
+
+        track.Translation.Times.InitSize(scKeyCount);
+        track.Translation.Values.InitSize(scKeyCount);
+        track.Rotation.Times.InitSize(scKeyCount);
+        track.Rotation.Values.InitSize(scKeyCount);
+
+        const Vec3f offset(unit(rng), unit(rng), unit(rng));
+        const Vec3f axis(unit(rng), unit(rng), unit(rng) + 2.0f);
+        const float32 rotation_frequency = frequency(rng);
+        const bool is_rotating = (bone % 4) != 3;
+
+        for (uint32 i = 0; i < scKeyCount; i++) {
+            const float32 time = static_cast<float32>(i) / scMocapKeyRate;
+
+            // The root walks forward and bobs up and down
+            const Vec3f translation = (bone == 0) ? Vec3f(0.0f, 0.05f * sinf(time * 8.0f), time * 1.4f) : offset;
+            const float32 angle = is_rotating ? 0.8f * sinf(time * rotation_frequency * FX_PI) : 0.3f;
+
+            track.Translation.Times.pData[i] = time;
+            track.Translation.Values.pData[i] = translation;
+
+            track.Rotation.Times.pData[i] = time;
+            track.Rotation.Values.pData[i] = Quat::FromAxisAngle(axis, angle);
+        }
+    }
+}
+
+/**
+ * Returns the memory used by the keys of an uncompressed clip, in bytes.
+ */
+static uint64 GetClipMemorySize(const Animation& anim)
+{
+    uint64 size = anim.BoneTracks.Size * sizeof(BoneTrack);
+
+    for (const BoneTrack& track : anim.BoneTracks) {
+        size += track.Translation.Times.Size * sizeof(float32) + track.Translation.Values.Size * sizeof(Vec3f);
+        size += track.Rotation.Times.Size * sizeof(float32) + track.Rotation.Values.Size * sizeof(Quat);
+    }
+
+    return size;
+}
+
+bool AnimationBenchmarkCompression(uint32 iterations)
+{
+    Animation clip;
+    GenerateMocapClip(clip);
+
+    CompressedAnimation compressed_clip;
+
+    if (!compressed_clip.Load(CompressedAnimation::Compress(clip, scMocapKeyRate))) {
+        LogError(LC_CORE, "Compression benchmark: could not load the compressed clip");
+        return false;
+    }
+
+    Skeleton skeleton;
+    GenerateSkeleton(skeleton);
+
+    const uint32 frame_count = static_cast<uint32>(clip.Duration * scFrameRate) + 1;
+
+    LogInfo(LC_CORE, "Compression benchmark: {} bones, {} keys at {} Hz, {} frames, {} runs", scBoneCount, scKeyCount,
+            scMocapKeyRate, frame_count, iterations);
+
+    std::vector<SkeletonPose> expected_poses(frame_count);
+    std::vector<SkeletonPose> compressed_poses(frame_count);
+
+    SizedArray<BoneTrackCursor> cursors;
+
+    const double uncompressed_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+            skeleton.SamplePose(clip, time, expected_poses[frame], cursors);
+        }
+    });
+
+    const double compressed_ns = TimeBest(iterations, frame_count, [&]()
+    {
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = static_cast<float32>(frame) / scFrameRate;
+            skeleton.SamplePose(compressed_clip, time, compressed_poses[frame]);
+        }
+    });
+
+    SampleResults expected_results;
+    SampleResults compressed_results;
+
+    for (uint32 frame = 0; frame < frame_count; frame++) {
+        for (uint32 bone = 0; bone < scBoneCount; bone++) {
+            expected_results.Translations.push_back(expected_poses[frame].Translations.pData[bone]);
+            expected_results.Rotations.push_back(expected_poses[frame].Rotations.pData[bone]);
+
+            compressed_results.Translations.push_back(compressed_poses[frame].Translations.pData[bone]);
+            compressed_results.Rotations.push_back(compressed_poses[frame].Rotations.pData[bone]);
+        }
+    }
+
+    const float32 max_error = GetMaxError(expected_results, compressed_results);
+    const bool passed = (max_error <= scCompressedTolerance);
+
+    if (!passed) {
+        LogError(LC_CORE, "Compression benchmark: decoded poses differ from the uncompressed clip by {}", max_error);
+    }
+
+    const uint64 uncompressed_size = GetClipMemorySize(clip);
+    const uint64 compressed_size = compressed_clip.GetMemorySize();
+
+    LogInfo(LC_CORE, "    {:<14} {:10} bytes {:10.1f} ns/pose", "Uncompressed", uncompressed_size, uncompressed_ns);
+    LogInfo(LC_CORE, "    {:<14} {:10} bytes {:10.1f} ns/pose ({:.2f}x smaller, {:.2f}x faster, max error {})",
+            "Compressed", compressed_size, compressed_ns,
+            static_cast<double>(uncompressed_size) / static_cast<double>(compressed_size),
+            uncompressed_ns / compressed_ns, max_error);
+
+    return passed;
+}
+
+} // namespace fx
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx {
+
+/**
+ * @brief Times sampling every track of a 100 bone, 1000 key clip while playing it through at 60 frames per second, and
+ * logs the time per frame for each way of finding the keys.
+ *
+ * This compares a linear scan through the keys, a binary search on every sample, the playback cursors used by
+ * `Skeleton::EvaluatePose()`, and the clip after `Animation::Resample()`. Each timing is the best of `iterations` runs.
+ *
+ * @returns False if any sampled value differs from the linear scan by more than a small tolerance.
+ */
+bool AnimationBenchmarkSampling(uint32 iterations = 16);
+
+/**
+ * @brief Times `Skeleton::EvaluatePose()` for a crowd of 64 skeletons with 100 bones each, against building each bone
+ * as a matrix and multiplying matrices down the hierarchy, and logs the time per skeleton.
+ *
+ * @returns False if any skinning matrix differs from the matrix product result by more than a small tolerance.
+ */
+bool AnimationBenchmarkPose(uint32 iterations = 16);
+
+/**
+ * @brief Compresses a 100 bone motion capture style clip with `CompressedAnimation`, and logs the memory used and the
+ * time to sample a pose from it against the uncompressed clip.
+ *
+ * @returns False if any bone of a decoded pose differs from the uncompressed pose by more than a small tolerance.
+ */
+bool AnimationBenchmarkCompression(uint32 iterations = 16);
+
+} // namespace fx
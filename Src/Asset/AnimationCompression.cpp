@@ -0,0 +1,860 @@
+#include "AnimationCompression.hpp"
+
+#include "Animation.hpp"
+#include "DataPack.hpp"
+
+#include <Core/Assert.hpp>
+#include <Core/CpuFeatures.hpp>
+#include <Core/Defines.hpp>
+#include <Core/Log.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace fx {
+
+static_assert(sizeof(Quat) == 4 * sizeof(float32) && sizeof(Vec3f) == 4 * sizeof(float32));
+
+static constexpr uint32 scClipMagic = 0x43415846; // "FXAC"
+static constexpr uint16 scClipVersion = 1;
+
+/// The number of tracks that the widest kernel decodes at once. Each component plane is padded to a multiple of this,
+/// so that kernels never read past the end of a plane.
+static constexpr uint32 scLaneCount = 8;
+
+/// Tracks where every frame is within this distance of the first frame are stored as a single value.
+static constexpr float32 scConstantTolerance = 1e-5f;
+
+/// How far past a whole number of frames the clip length can be from rounding before another frame is added.
+static constexpr float32 scFrameCountTolerance = 1e-3f;
+
+/// The three smallest components of a unit quaternion are within this range.
+static constexpr float32 scSmallestThreeRange = 0.70710678f;
+static constexpr uint32 scSmallestThreeMax = 0x7FFF;
+static constexpr float32 scSmallestThreeStep = (2.0f * scSmallestThreeRange) / scSmallestThreeMax;
+
+static constexpr uint32 scTranslationMax = 0xFFFF;
+
+#pragma pack(push, 1)
+
+struct CompressedClipHeader
+{
+    uint32 Magic;
+    uint16 Version;
+    uint16 BoneCount;
+    uint32 FrameCount;
+    float32 SampleRate;
+    float32 Duration;
+    uint16 AnimatedRotationCount;
+    uint16 AnimatedTranslationCount;
+    uint16 ConstantRotationCount;
+    uint16 ConstantTranslationCount;
+};
+
+#pragma pack(pop)
+
+/**
+ * The offset of each section of a compressed clip from the start of the clip, in bytes.
+ */
+struct ClipLayout
+{
+    uint64 AnimatedRotationBones;
+    uint64 AnimatedTranslationBones;
+    uint64 ConstantRotationBones;
+    uint64 ConstantTranslationBones;
+    uint64 ConstantRotations;
+    uint64 ConstantTranslations;
+    uint64 TranslationMins;
+    uint64 TranslationSteps;
+    uint64 Frames;
+    uint64 Size;
+
+    uint32 RotationStride;
+    uint32 TranslationStride;
+
+    /// The number of values in each frame.
+    uint32 FrameStride;
+};
+
+static FX_FORCE_INLINE uint64 AlignOffset(uint64 value, uint64 alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static ClipLayout GetClipLayout(const CompressedClipHeader& header)
+{
+    ClipLayout layout;
+
+    layout.RotationStride = static_cast<uint32>(AlignOffset(header.AnimatedRotationCount, scLaneCount));
+    layout.TranslationStride = static_cast<uint32>(AlignOffset(header.AnimatedTranslationCount, scLaneCount));
+    layout.FrameStride = 3 * (layout.RotationStride + layout.TranslationStride);
+
+    uint64 offset = AlignOffset(sizeof(CompressedClipHeader), 16);
+
+    layout.AnimatedRotationBones = offset;
+    offset += header.AnimatedRotationCount * sizeof(uint16);
+
+    layout.AnimatedTranslationBones = offset;
+    offset += header.AnimatedTranslationCount * sizeof(uint16);
+
+    layout.ConstantRotationBones = offset;
+    offset += header.ConstantRotationCount * sizeof(uint16);
+
+    layout.ConstantTranslationBones = offset;
+    offset += header.ConstantTranslationCount * sizeof(uint16);
+
+    // Values are stored as four floats so that they can be copied straight into a `Quat` or `Vec3f`
+    offset = AlignOffset(offset, 16);
+
+    layout.ConstantRotations = offset;
+    offset += header.ConstantRotationCount * 4 * sizeof(float32);
+
+    layout.ConstantTranslations = offset;
+    offset += header.ConstantTranslationCount * 4 * sizeof(float32);
+
+    layout.TranslationMins = offset;
+    offset += 3 * layout.TranslationStride * sizeof(float32);
+
+    layout.TranslationSteps = offset;
+    offset += 3 * layout.TranslationStride * sizeof(float32);
+
+    layout.Frames = offset;
+    offset += static_cast<uint64>(header.FrameCount) * layout.FrameStride * sizeof(uint16);
+
+    layout.Size = offset;
+
+    return layout;
+}
+
+///////////////////////////////
+// Encoding
+///////////////////////////////
+
+/**
+ * Packs a quaternion into three 16 bit values. The low 15 bits of each value are the three smallest components. The
+ * high bits of the first two values are the index of the largest component, and the high bit of the last value is its
+ * sign.
+ */
+static void EncodeSmallestThree(const Quat& rotation, uint16* out)
+{
+    float32 q[4] = { rotation.GetX(), rotation.GetY(), rotation.GetZ(), rotation.GetW() };
+
+    const float32 length = sqrtf((q[0] * q[0]) + (q[1] * q[1]) + (q[2] * q[2]) + (q[3] * q[3]));
+    const float32 inv_length = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+    uint32 largest = 0;
+
+    for (uint32 i = 0; i < 4; i++) {
+        q[i] *= inv_length;
+
+        if (fabsf(q[i]) > fabsf(q[largest])) {
+            largest = i;
+        }
+    }
+
+    uint32 component = 0;
+
+    for (uint32 i = 0; i < 4; i++) {
+        if (i == largest) {
+            continue;
+        }
+
+        const float32 normalized = (q[i] + scSmallestThreeRange) / (2.0f * scSmallestThreeRange);
+        const float32 quantized = std::clamp(roundf(normalized * scSmallestThreeMax), 0.0f,
+                                             static_cast<float32>(scSmallestThreeMax));
+
+        out[component++] = static_cast<uint16>(quantized);
+    }
+
+    out[0] |= static_cast<uint16>((largest >> 1) << 15);
+    out[1] |= static_cast<uint16>((largest & 1) << 15);
+    out[2] |= static_cast<uint16>((q[largest] < 0.0f) ? 0x8000 : 0);
+}
+
+/**
+ * Returns true if every frame of a sampled track is within `scConstantTolerance` of the first frame.
+ */
+template <typename T>
+static bool IsConstantTrack(const SizedArray<T>& frames)
+{
+    const T& first = frames.pData[0];
+
+    for (const T& value : frames) {
+        const bool is_close = fabsf(value.GetX() - first.GetX()) <= scConstantTolerance &&
+                              fabsf(value.GetY() - first.GetY()) <= scConstantTolerance &&
+                              fabsf(value.GetZ() - first.GetZ()) <= scConstantTolerance;
+
+        if (!is_close) {
+            return false;
+        }
+
+        if constexpr (std::is_same_v<T, Quat>) {
+            if (fabsf(value.GetW() - first.GetW()) > scConstantTolerance) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+static void WriteValue(uint8* dst, const T& value)
+{
+    memcpy(dst, &value, sizeof(T));
+}
+
+SizedArray<uint8> CompressedAnimation::Compress(const Animation& anim, float32 sample_rate)
+{
+    Assert(sample_rate > 0.0f);
+
+    const uint32 bone_count = static_cast<uint32>(anim.BoneTracks.Size);
+
+    if (bone_count > UINT16_MAX) {
+        LogError(LC_ASSET, "Cannot compress animation '{}' with {} bones", anim.Name.CStr(), bone_count);
+        return SizedArray<uint8> {};
+    }
+
+    // Round the rate up so that the last frame lands on the end of the clip. Clips that are a whole number of frames
+    // long in single precision keep their rate, so the frames line up with the original keys.
+    uint32 frame_count = 1;
+    float32 rate = 0.0f;
+
+    if (anim.Duration > 0.0f) {
+        frame_count = static_cast<uint32>(std::ceil((anim.Duration * sample_rate) - scFrameCountTolerance)) + 1;
+        rate = static_cast<float32>(frame_count - 1) / anim.Duration;
+    }
+
+    // Sample every track at each frame
+    SizedArray<SizedArray<Vec3f>> translations;
+    translations.InitSize(bone_count);
+
+    SizedArray<SizedArray<Quat>> rotations;
+    rotations.InitSize(bone_count);
+
+    SizedArray<uint16> animated_rotation_bones;
+    animated_rotation_bones.InitCapacity(bone_count);
+
+    SizedArray<uint16> animated_translation_bones;
+    animated_translation_bones.InitCapacity(bone_count);
+
+    SizedArray<uint16> constant_rotation_bones;
+    constant_rotation_bones.InitCapacity(bone_count);
+
+    SizedArray<uint16> constant_translation_bones;
+    constant_translation_bones.InitCapacity(bone_count);
+
+    for (uint32 bone = 0; bone < bone_count; bone++) {
+        const BoneTrack& track = anim.BoneTracks.pData[bone];
+
+        translations.pData[bone].InitSize(frame_count);
+        rotations.pData[bone].InitSize(frame_count);
+
+        BoneTrackCursor cursor {};
+
+        for (uint32 frame = 0; frame < frame_count; frame++) {
+            const float32 time = (frame == frame_count - 1) ? anim.Duration : static_cast<float32>(frame) / rate;
+
+            translations.pData[bone].pData[frame] = SampleTrack(track.Translation, time, cursor.TranslationKey);
+            rotations.pData[bone].pData[frame] = SampleTrack(track.Rotation, time, cursor.RotationKey);
+        }
+
+        const uint16 bone_index = static_cast<uint16>(bone);
+
+        if (IsConstantTrack(rotations.pData[bone])) {
+            constant_rotation_bones.Insert(bone_index);
+        }
+        else {
+            animated_rotation_bones.Insert(bone_index);
+        }
+
+        if (IsConstantTrack(translations.pData[bone])) {
+            constant_translation_bones.Insert(bone_index);
+        }
+        else {
+            animated_translation_bones.Insert(bone_index);
+        }
+    }
+
+    CompressedClipHeader header {
+        .Magic = scClipMagic,
+        .Version = scClipVersion,
+        .BoneCount = static_cast<uint16>(bone_count),
+        .FrameCount = frame_count,
+        .SampleRate = rate,
+        .Duration = anim.Duration,
+        .AnimatedRotationCount = static_cast<uint16>(animated_rotation_bones.Size),
+        .AnimatedTranslationCount = static_cast<uint16>(animated_translation_bones.Size),
+        .ConstantRotationCount = static_cast<uint16>(constant_rotation_bones.Size),
+        .ConstantTranslationCount = static_cast<uint16>(constant_translation_bones.Size),
+    };
+
+    const ClipLayout layout = GetClipLayout(header);
+
+    SizedArray<uint8> data;
+    data.InitSize(layout.Size);
+
+    // Padding and the unused lanes of each plane are left as zero
+    memset(data.pData, 0, layout.Size);
+    memcpy(data.pData, &header, sizeof(header));
+
+    auto write_bones = [&](uint64 offset, const SizedArray<uint16>& bones)
+    {
+        if (bones.Size > 0) {
+            memcpy(data.pData + offset, bones.pData, bones.Size * sizeof(uint16));
+        }
+    };
+
+    write_bones(layout.AnimatedRotationBones, animated_rotation_bones);
+    write_bones(layout.AnimatedTranslationBones, animated_translation_bones);
+    write_bones(layout.ConstantRotationBones, constant_rotation_bones);
+    write_bones(layout.ConstantTranslationBones, constant_translation_bones);
+
+    for (uint32 i = 0; i < constant_rotation_bones.Size; i++) {
+        const Quat& value = rotations.pData[constant_rotation_bones.pData[i]].pData[0];
+        WriteValue(data.pData + layout.ConstantRotations + (i * sizeof(Quat)), value);
+    }
+
+    for (uint32 i = 0; i < constant_translation_bones.Size; i++) {
+        const Vec3f& value = translations.pData[constant_translation_bones.pData[i]].pData[0];
+        WriteValue(data.pData + layout.ConstantTranslations + (i * sizeof(Vec3f)), value);
+    }
+
+    // Find the range of each animated translation track
+    float32* translation_mins = reinterpret_cast<float32*>(data.pData + layout.TranslationMins);
+    float32* translation_steps = reinterpret_cast<float32*>(data.pData + layout.TranslationSteps);
+
+    for (uint32 i = 0; i < animated_translation_bones.Size; i++) {
+        const SizedArray<Vec3f>& frames = translations.pData[animated_translation_bones.pData[i]];
+
+        Vec3f min_value = frames.pData[0];
+        Vec3f max_value = frames.pData[0];
+
+        for (const Vec3f& value : frames) {
+            min_value = Vec3f::Min(min_value, value);
+            max_value = Vec3f::Max(max_value, value);
+        }
+
+        const float32 mins[3] = { min_value.GetX(), min_value.GetY(), min_value.GetZ() };
+        const float32 maxs[3] = { max_value.GetX(), max_value.GetY(), max_value.GetZ() };
+
+        for (uint32 component = 0; component < 3; component++) {
+            translation_mins[(component * layout.TranslationStride) + i] = mins[component];
+            translation_steps[(component * layout.TranslationStride) + i] = (maxs[component] - mins[component]) /
+                                                                            scTranslationMax;
+        }
+    }
+
+    // Quantize each frame
+    uint16* frames = reinterpret_cast<uint16*>(data.pData + layout.Frames);
+
+    for (uint32 frame = 0; frame < frame_count; frame++) {
+        uint16* rotation_planes = frames + (static_cast<uint64>(frame) * layout.FrameStride);
+        uint16* translation_planes = rotation_planes + (3 * layout.RotationStride);
+
+        for (uint32 i = 0; i < animated_rotation_bones.Size; i++) {
+            uint16 packed[3];
+            EncodeSmallestThree(rotations.pData[animated_rotation_bones.pData[i]].pData[frame], packed);
+
+            for (uint32 component = 0; component < 3; component++) {
+                rotation_planes[(component * layout.RotationStride) + i] = packed[component];
+            }
+        }
+
+        for (uint32 i = 0; i < animated_translation_bones.Size; i++) {
+            const Vec3f& value = translations.pData[animated_translation_bones.pData[i]].pData[frame];
+            const float32 values[3] = { value.GetX(), value.GetY(), value.GetZ() };
+
+            for (uint32 component = 0; component < 3; component++) {
+                const uint32 index = (component * layout.TranslationStride) + i;
+                const float32 step = translation_steps[index];
+
+                const float32 quantized = (step > 0.0f) ? roundf((values[component] - translation_mins[index]) / step)
+                                                        : 0.0f;
+
+                translation_planes[index] = static_cast<uint16>(
+                    std::clamp(quantized, 0.0f, static_cast<float32>(scTranslationMax)));
+            }
+        }
+    }
+
+    return data;
+}
+
+void CompressedAnimation::AddToDataPack(DataPack& pack, Hash64 id, const Animation& anim, float32 sample_rate)
+{
+    SizedArray<uint8> data = Compress(anim, sample_rate);
+
+    if (data.IsEmpty()) {
+        return;
+    }
+
+    pack.AddEntry(id, Slice<uint8>(data));
+}
+
+///////////////////////////////
+// Loading
+///////////////////////////////
+
+bool CompressedAnimation::Load(SizedArray<uint8>&& data)
+{
+    if (data.Size < sizeof(CompressedClipHeader)) {
+        LogError(LC_ASSET, "Compressed animation is too small ({} bytes)", data.Size);
+        return false;
+    }
+
+    CompressedClipHeader header;
+    memcpy(&header, data.pData, sizeof(header));
+
+    if (header.Magic != scClipMagic || header.Version != scClipVersion) {
+        LogError(LC_ASSET, "Data is not a compressed animation (or is an unsupported version)");
+        return false;
+    }
+
+    const ClipLayout layout = GetClipLayout(header);
+
+    if (header.FrameCount == 0 || data.Size < layout.Size) {
+        LogError(LC_ASSET, "Compressed animation is truncated ({} of {} bytes)", data.Size, layout.Size);
+        return false;
+    }
+
+    mData = std::move(data);
+
+    mBoneCount = header.BoneCount;
+    mFrameCount = header.FrameCount;
+    mSampleRate = header.SampleRate;
+    mDuration = header.Duration;
+
+    mAnimatedRotationCount = header.AnimatedRotationCount;
+    mAnimatedTranslationCount = header.AnimatedTranslationCount;
+    mConstantRotationCount = header.ConstantRotationCount;
+    mConstantTranslationCount = header.ConstantTranslationCount;
+
+    mRotationStride = layout.RotationStride;
+    mTranslationStride = layout.TranslationStride;
+
+    const uint8* base = mData.pData;
+
+    mpAnimatedRotationBones = reinterpret_cast<const uint16*>(base + layout.AnimatedRotationBones);
+    mpAnimatedTranslationBones = reinterpret_cast<const uint16*>(base + layout.AnimatedTranslationBones);
+    mpConstantRotationBones = reinterpret_cast<const uint16*>(base + layout.ConstantRotationBones);
+    mpConstantTranslationBones = reinterpret_cast<const uint16*>(base + layout.ConstantTranslationBones);
+
+    mpConstantRotations = reinterpret_cast<const float32*>(base + layout.ConstantRotations);
+    mpConstantTranslations = reinterpret_cast<const float32*>(base + layout.ConstantTranslations);
+
+    mpTranslationMins = reinterpret_cast<const float32*>(base + layout.TranslationMins);
+    mpTranslationSteps = reinterpret_cast<const float32*>(base + layout.TranslationSteps);
+
+    mpFrames = reinterpret_cast<const uint16*>(base + layout.Frames);
+
+    return true;
+}
+
+bool CompressedAnimation::LoadFromDataPack(DataPack& pack, Hash64 id)
+{
+    DataPackEntry* entry = pack.GetEntry(id, true);
+
+    if (entry == nullptr) {
+        LogError(LC_ASSET, "Could not find compressed animation {} in datapack", id);
+        return false;
+    }
+
+    // The entry keeps its copy, so that the pack can be read from again
+    SizedArray<uint8> data;
+    data.InitAsCopyOf(entry->Data);
+
+    return Load(std::move(data));
+}
+
+///////////////////////////////
+// Decoding
+///////////////////////////////
+
+/**
+ * Decodes `count` smallest three rotations from the planes at `planes`, each `stride` values long, and writes each one
+ * to `out[bones[i]]` if the bone is below `bone_count`.
+ */
+using DecodeRotationsFn = void (*)(const uint16* planes, uint32 stride, const uint16* bones, uint32 count,
+                                   uint32 bone_count, float32* out);
+
+/**
+ * Decodes `count` quantized translations from two frames, interpolates them by `alpha` and writes each one to
+ * `out[bones[i]]` if the bone is below `bone_count`.
+ */
+using DecodeTranslationsFn = void (*)(const uint16* from_planes, const uint16* to_planes, uint32 stride,
+                                      const float32* mins, const float32* steps, float32 alpha, const uint16* bones,
+                                      uint32 count, uint32 bone_count, float32* out);
+
+static void DecodeRotations_Scalar(const uint16* planes, uint32 stride, const uint16* bones, uint32 count,
+                                   uint32 bone_count, float32* out)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const uint32 bone = bones[i];
+
+        if (bone >= bone_count) {
+            continue;
+        }
+
+        const uint16 w0 = planes[i];
+        const uint16 w1 = planes[stride + i];
+        const uint16 w2 = planes[(2 * stride) + i];
+
+        const float32 a = static_cast<float32>(w0 & scSmallestThreeMax) * scSmallestThreeStep - scSmallestThreeRange;
+        const float32 b = static_cast<float32>(w1 & scSmallestThreeMax) * scSmallestThreeStep - scSmallestThreeRange;
+        const float32 c = static_cast<float32>(w2 & scSmallestThreeMax) * scSmallestThreeStep - scSmallestThreeRange;
+
+        const uint32 largest_index = ((w0 >> 15) << 1) | (w1 >> 15);
+
+        float32 largest = sqrtf(std::max(0.0f, 1.0f - (a * a) - (b * b) - (c * c)));
+
+        if (w2 & 0x8000) {
+            largest = -largest;
+        }
+
+        float32* q = out + (bone * 4);
+
+        switch (largest_index) {
+        case 0:
+            q[0] = largest, q[1] = a, q[2] = b, q[3] = c;
+            break;
+        case 1:
+            q[0] = a, q[1] = largest, q[2] = b, q[3] = c;
+            break;
+        case 2:
+            q[0] = a, q[1] = b, q[2] = largest, q[3] = c;
+            break;
+        default:
+            q[0] = a, q[1] = b, q[2] = c, q[3] = largest;
+            break;
+        }
+    }
+}
+
+static void DecodeTranslations_Scalar(const uint16* from_planes, const uint16* to_planes, uint32 stride,
+                                      const float32* mins, const float32* steps, float32 alpha, const uint16* bones,
+                                      uint32 count, uint32 bone_count, float32* out)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const uint32 bone = bones[i];
+
+        if (bone >= bone_count) {
+            continue;
+        }
+
+        float32* t = out + (bone * 4);
+
+        for (uint32 component = 0; component < 3; component++) {
+            const uint32 index = (component * stride) + i;
+
+            const float32 from = static_cast<float32>(from_planes[index]);
+            const float32 to = static_cast<float32>(to_planes[index]);
+
+            t[component] = mins[index] + (from + (to - from) * alpha) * steps[index];
+        }
+
+        t[3] = 0.0f;
+    }
+}
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+/**
+ * Writes the first `count` of four transposed values to `out[bones[i]]`.
+ */
+static FX_FORCE_INLINE void ScatterValues(const __m128* values, const uint16* bones, uint32 count, uint32 bone_count,
+                                          float32* out)
+{
+    for (uint32 lane = 0; lane < count; lane++) {
+        const uint32 bone = bones[lane];
+
+        if (bone < bone_count) {
+            _mm_storeu_ps(out + (bone * 4), values[lane]);
+        }
+    }
+}
+
+FX_TARGET_SSE4 static void DecodeRotations_SSE4(const uint16* planes, uint32 stride, const uint16* bones,
+                                                uint32 count, uint32 bone_count, float32* out)
+{
+    const __m128i value_mask = _mm_set1_epi32(scSmallestThreeMax);
+    const __m128 step = _mm_set1_ps(scSmallestThreeStep);
+    const __m128 range = _mm_set1_ps(scSmallestThreeRange);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    // The planes are padded to a multiple of the lane count, so every load is in bounds
+    for (uint32 i = 0; i < count; i += 4) {
+        const __m128i w0 = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(planes + i)));
+        const __m128i w1 = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(planes + stride + i)));
+        const __m128i w2 = _mm_cvtepu16_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(planes + (2 * stride) + i)));
+
+        const __m128 a = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(w0, value_mask)), step), range);
+        const __m128 b = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(w1, value_mask)), step), range);
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(w2, value_mask)), step), range);
+
+        const __m128i largest_index = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(w0, 15), 1), _mm_srli_epi32(w1, 15));
+
+        // Rebuild the largest component, then move its sign from bit 15 to the float sign bit
+        const __m128 sum_squares = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c));
+        const __m128 sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(w2, 15), 31));
+        const __m128 largest = _mm_or_ps(_mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, sum_squares), _mm_setzero_ps())),
+                                         sign);
+
+        const __m128 is_x = _mm_castsi128_ps(_mm_cmpeq_epi32(largest_index, _mm_set1_epi32(0)));
+        const __m128 is_y = _mm_castsi128_ps(_mm_cmpeq_epi32(largest_index, _mm_set1_epi32(1)));
+        const __m128 is_z = _mm_castsi128_ps(_mm_cmpeq_epi32(largest_index, _mm_set1_epi32(2)));
+        const __m128 is_w = _mm_castsi128_ps(_mm_cmpeq_epi32(largest_index, _mm_set1_epi32(3)));
+
+        // The stored components are the other three in order
+        __m128 x = _mm_blendv_ps(a, largest, is_x);
+        __m128 y = _mm_blendv_ps(_mm_blendv_ps(b, a, is_x), largest, is_y);
+        __m128 z = _mm_blendv_ps(_mm_blendv_ps(c, b, _mm_or_ps(is_x, is_y)), largest, is_z);
+        __m128 w = _mm_blendv_ps(c, largest, is_w);
+
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const __m128 values[4] = { x, y, z, w };
+        ScatterValues(values, bones + i, std::min(count - i, 4u), bone_count, out);
+    }
+}
+
+FX_TARGET_SSE4 static void DecodeTranslations_SSE4(const uint16* from_planes, const uint16* to_planes, uint32 stride,
+                                                   const float32* mins, const float32* steps, float32 alpha,
+                                                   const uint16* bones, uint32 count, uint32 bone_count, float32* out)
+{
+    const __m128 alpha4 = _mm_set1_ps(alpha);
+
+    for (uint32 i = 0; i < count; i += 4) {
+        __m128 components[4];
+
+        for (uint32 component = 0; component < 3; component++) {
+            const uint32 index = (component * stride) + i;
+
+            const __m128 from = _mm_cvtepi32_ps(
+                _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from_planes + index))));
+            const __m128 to = _mm_cvtepi32_ps(
+                _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(to_planes + index))));
+
+            const __m128 quantized = _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), alpha4));
+
+            components[component] = _mm_add_ps(_mm_loadu_ps(mins + index),
+                                               _mm_mul_ps(quantized, _mm_loadu_ps(steps + index)));
+        }
+
+        components[3] = _mm_setzero_ps();
+
+        _MM_TRANSPOSE4_PS(components[0], components[1], components[2], components[3]);
+
+        ScatterValues(components, bones + i, std::min(count - i, 4u), bone_count, out);
+    }
+}
+
+/**
+ * Transposes eight values of four components into eight `__m128`s.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE void Transpose4x8(__m256 x, __m256 y, __m256 z, __m256 w, __m128* out)
+{
+    const __m256 xy_low = _mm256_unpacklo_ps(x, y);
+    const __m256 xy_high = _mm256_unpackhi_ps(x, y);
+    const __m256 zw_low = _mm256_unpacklo_ps(z, w);
+    const __m256 zw_high = _mm256_unpackhi_ps(z, w);
+
+    // Each register holds lane n in the low half and lane n + 4 in the high half
+    const __m256 v0 = _mm256_shuffle_ps(xy_low, zw_low, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 v1 = _mm256_shuffle_ps(xy_low, zw_low, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 v2 = _mm256_shuffle_ps(xy_high, zw_high, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 v3 = _mm256_shuffle_ps(xy_high, zw_high, _MM_SHUFFLE(3, 2, 3, 2));
+
+    out[0] = _mm256_castps256_ps128(v0);
+    out[1] = _mm256_castps256_ps128(v1);
+    out[2] = _mm256_castps256_ps128(v2);
+    out[3] = _mm256_castps256_ps128(v3);
+    out[4] = _mm256_extractf128_ps(v0, 1);
+    out[5] = _mm256_extractf128_ps(v1, 1);
+    out[6] = _mm256_extractf128_ps(v2, 1);
+    out[7] = _mm256_extractf128_ps(v3, 1);
+}
+
+FX_TARGET_AVX2 static FX_FORCE_INLINE __m256 LoadPlane8(const uint16* plane)
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(plane))));
+}
+
+FX_TARGET_AVX2 static void DecodeRotations_AVX2(const uint16* planes, uint32 stride, const uint16* bones,
+                                                uint32 count, uint32 bone_count, float32* out)
+{
+    const __m256i value_mask = _mm256_set1_epi32(scSmallestThreeMax);
+    const __m256 step = _mm256_set1_ps(scSmallestThreeStep);
+    const __m256 range = _mm256_set1_ps(scSmallestThreeRange);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    for (uint32 i = 0; i < count; i += 8) {
+        const __m256i w0 = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + i)));
+        const __m256i w1 = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + stride + i)));
+        const __m256i w2 = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + (2 * stride) + i)));
+
+        const __m256 a = _mm256_fmsub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(w0, value_mask)), step, range);
+        const __m256 b = _mm256_fmsub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(w1, value_mask)), step, range);
+        const __m256 c = _mm256_fmsub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(w2, value_mask)), step, range);
+
+        const __m256i largest_index = _mm256_or_si256(_mm256_slli_epi32(_mm256_srli_epi32(w0, 15), 1),
+                                                      _mm256_srli_epi32(w1, 15));
+
+        const __m256 sum_squares = _mm256_fmadd_ps(c, c, _mm256_fmadd_ps(b, b, _mm256_mul_ps(a, a)));
+        const __m256 sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_srli_epi32(w2, 15), 31));
+        const __m256 largest = _mm256_or_ps(
+            _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(one, sum_squares), _mm256_setzero_ps())), sign);
+
+        const __m256 is_x = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest_index, _mm256_set1_epi32(0)));
+        const __m256 is_y = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest_index, _mm256_set1_epi32(1)));
+        const __m256 is_z = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest_index, _mm256_set1_epi32(2)));
+        const __m256 is_w = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest_index, _mm256_set1_epi32(3)));
+
+        const __m256 x = _mm256_blendv_ps(a, largest, is_x);
+        const __m256 y = _mm256_blendv_ps(_mm256_blendv_ps(b, a, is_x), largest, is_y);
+        const __m256 z = _mm256_blendv_ps(_mm256_blendv_ps(c, b, _mm256_or_ps(is_x, is_y)), largest, is_z);
+        const __m256 w = _mm256_blendv_ps(c, largest, is_w);
+
+        __m128 values[8];
+        Transpose4x8(x, y, z, w, values);
+
+        ScatterValues(values, bones + i, std::min(count - i, 8u), bone_count, out);
+    }
+}
+
+FX_TARGET_AVX2 static void DecodeTranslations_AVX2(const uint16* from_planes, const uint16* to_planes, uint32 stride,
+                                                   const float32* mins, const float32* steps, float32 alpha,
+                                                   const uint16* bones, uint32 count, uint32 bone_count, float32* out)
+{
+    const __m256 alpha8 = _mm256_set1_ps(alpha);
+
+    for (uint32 i = 0; i < count; i += 8) {
+        __m256 components[3];
+
+        for (uint32 component = 0; component < 3; component++) {
+            const uint32 index = (component * stride) + i;
+
+            const __m256 from = LoadPlane8(from_planes + index);
+            const __m256 to = LoadPlane8(to_planes + index);
+
+            const __m256 quantized = _mm256_fmadd_ps(_mm256_sub_ps(to, from), alpha8, from);
+
+            components[component] = _mm256_fmadd_ps(quantized, _mm256_loadu_ps(steps + index),
+                                                     _mm256_loadu_ps(mins + index));
+        }
+
+        __m128 values[8];
+        Transpose4x8(components[0], components[1], components[2], _mm256_setzero_ps(), values);
+
+        ScatterValues(values, bones + i, std::min(count - i, 8u), bone_count, out);
+    }
+}
+
+#endif
+
+struct ClipDecodeKernels
+{
+    DecodeRotationsFn DecodeRotations;
+    DecodeTranslationsFn DecodeTranslations;
+};
+
+static const ClipDecodeKernels& GetDecodeKernels()
+{
+    static const ClipDecodeKernels sKernels = []() -> ClipDecodeKernels
+    {
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+        const eCpuTier tier = CpuFeatures::GetInstance().GetTier();
+
+        if (tier >= eCpuTier::AVX2) {
+            return ClipDecodeKernels { DecodeRotations_AVX2, DecodeTranslations_AVX2 };
+        }
+        if (tier >= eCpuTier::SSE4) {
+            return ClipDecodeKernels { DecodeRotations_SSE4, DecodeTranslations_SSE4 };
+        }
+#endif
+        return ClipDecodeKernels { DecodeRotations_Scalar, DecodeTranslations_Scalar };
+    }();
+
+    return sKernels;
+}
+
+CompressedAnimation::FramePair CompressedAnimation::FindFrames(float32 time) const
+{
+    const uint32 last_frame = mFrameCount - 1;
+
+    if (time <= 0.0f || last_frame == 0) {
+        return FramePair { 0, 0, 0.0f };
+    }
+
+    if (time >= mDuration) {
+        return FramePair { last_frame, last_frame, 0.0f };
+    }
+
+    const float32 position = time * mSampleRate;
+    const uint32 frame = std::min(static_cast<uint32>(position), last_frame - 1);
+
+    return FramePair { frame, frame + 1, std::min(position - static_cast<float32>(frame), 1.0f) };
+}
+
+void CompressedAnimation::DecodeRotations(uint32 frame, Quat* out, uint32 bone_count) const
+{
+    Assert(frame < mFrameCount);
+
+    float32* values = reinterpret_cast<float32*>(out);
+
+    for (uint32 i = 0; i < mConstantRotationCount; i++) {
+        const uint32 bone = mpConstantRotationBones[i];
+
+        if (bone < bone_count) {
+            memcpy(values + (bone * 4), mpConstantRotations + (i * 4), sizeof(Quat));
+        }
+    }
+
+    if (mAnimatedRotationCount == 0) {
+        return;
+    }
+
+    const uint16* planes = mpFrames + (static_cast<uint64>(frame) * 3 * (mRotationStride + mTranslationStride));
+
+    GetDecodeKernels().DecodeRotations(planes, mRotationStride, mpAnimatedRotationBones, mAnimatedRotationCount,
+                                       bone_count, values);
+}
+
+void CompressedAnimation::DecodeTranslations(uint32 from, uint32 to, float32 alpha, Vec3f* out,
+                                             uint32 bone_count) const
+{
+    Assert(from < mFrameCount && to < mFrameCount);
+
+    float32* values = reinterpret_cast<float32*>(out);
+
+    for (uint32 i = 0; i < mConstantTranslationCount; i++) {
+        const uint32 bone = mpConstantTranslationBones[i];
+
+        if (bone < bone_count) {
+            memcpy(values + (bone * 4), mpConstantTranslations + (i * 4), sizeof(Vec3f));
+        }
+    }
+
+    if (mAnimatedTranslationCount == 0) {
+        return;
+    }
+
+    const uint64 frame_stride = 3 * (mRotationStride + mTranslationStride);
+    const uint64 rotation_size = 3 * mRotationStride;
+
+    const uint16* from_planes = mpFrames + (from * frame_stride) + rotation_size;
+    const uint16* to_planes = mpFrames + (to * frame_stride) + rotation_size;
+
+    GetDecodeKernels().DecodeTranslations(from_planes, to_planes, mTranslationStride, mpTranslationMins,
+                                          mpTranslationSteps, alpha, mpAnimatedTranslationBones,
+                                          mAnimatedTranslationCount, bone_count, values);
+}
+
+} // namespace fx
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Core/Hash.hpp>
+#include <Core/SizedArray.hpp>
+#include <Core/Types.hpp>
+#include <Math/Quat.hpp>
+#include <Math/Vec3.hpp>
+
+namespace fx {
+
+struct Animation;
+class DataPack;
+
+/**
+ * @brief An animation clip stored in a compressed format that is built offline and loaded from a `DataPack`.
+ *
+ * The clip is sampled at a fixed rate, so frames are found from the time instead of storing a time for each key. Each
+ * track is either constant, in which case a single value is stored, or animated:
+ *
+ * - Rotations are stored in 48 bits with the "smallest three" encoding. The largest component is dropped and rebuilt
+ *   from the other three, which are each quantized to 15 bits. The remaining bits hold the index and sign of the dropped
+ *   component, so the quaternion is decoded with its original sign.
+ * - Translations are stored as three 16 bit values, quantized to the range of the track.
+ *
+ * The values for each frame are stored as planes of each component for every animated track, so that a kernel can
+ * decode several bones at once (see `DecodeRotations()`). The loaded clip is the entry data as is, there is nothing to
+ * unpack after reading it from the pack.
+ */
+class CompressedAnimation
+{
+public:
+    static constexpr float32 scDefaultSampleRate = 30.0f;
+
+    /**
+     * The frames on either side of a time, and how far the time is between them.
+     */
+    struct FramePair
+    {
+        uint32 From;
+        uint32 To;
+        float32 Alpha;
+    };
+
+public:
+    CompressedAnimation() = default;
+
+    /**
+     * @brief Compresses `anim` by sampling each track at `sample_rate` frames per second.
+     * @returns The compressed clip, which can be passed to `Load()` or stored in a `DataPack`.
+     */
+    static SizedArray<uint8> Compress(const Animation& anim, float32 sample_rate = scDefaultSampleRate);
+
+    /**
+     * @brief Compresses `anim` and adds it to `pack` as the entry `id`.
+     */
+    static void AddToDataPack(DataPack& pack, Hash64 id, const Animation& anim,
+                              float32 sample_rate = scDefaultSampleRate);
+
+    /**
+     * @brief Takes ownership of a compressed clip (see `Compress()`).
+     * @returns False if the data is not a valid compressed clip.
+     */
+    bool Load(SizedArray<uint8>&& data);
+
+    /**
+     * @brief Loads the clip in the entry `id` of `pack`.
+     */
+    bool LoadFromDataPack(DataPack& pack, Hash64 id);
+
+    /**
+     * @brief Returns the frames around `time`, which is clamped to the length of the clip.
+     */
+    FramePair FindFrames(float32 time) const;
+
+    /**
+     * @brief Decodes the rotation of each bone in `frame` into `out`, for bones below `bone_count`.
+     */
+    void DecodeRotations(uint32 frame, Quat* out, uint32 bone_count) const;
+
+    /**
+     * @brief Decodes the translation of each bone in frames `from` and `to` and interpolates between them by `alpha`
+     * into `out`, for bones below `bone_count`.
+     */
+    void DecodeTranslations(uint32 from, uint32 to, float32 alpha, Vec3f* out, uint32 bone_count) const;
+
+    FX_FORCE_INLINE bool IsLoaded() const { return mData.IsNotEmpty(); }
+
+    FX_FORCE_INLINE uint32 GetBoneCount() const { return mBoneCount; }
+    FX_FORCE_INLINE uint32 GetFrameCount() const { return mFrameCount; }
+    FX_FORCE_INLINE float32 GetDuration() const { return mDuration; }
+
+    /// The size of the compressed clip in bytes.
+    FX_FORCE_INLINE uint64 GetMemorySize() const { return mData.Size; }
+
+private:
+    SizedArray<uint8> mData;
+
+    uint32 mBoneCount = 0;
+    uint32 mFrameCount = 0;
+    float32 mSampleRate = 0.0f;
+    float32 mDuration = 0.0f;
+
+    uint32 mAnimatedRotationCount = 0;
+    uint32 mAnimatedTranslationCount = 0;
+    uint32 mConstantRotationCount = 0;
+    uint32 mConstantTranslationCount = 0;
+
+    /// The number of values in each component plane of a frame, which are padded to a multiple of the widest kernel.
+    uint32 mRotationStride = 0;
+    uint32 mTranslationStride = 0;
+
+    // Views into `mData`
+    const uint16* mpAnimatedRotationBones = nullptr;
+    const uint16* mpAnimatedTranslationBones = nullptr;
+    const uint16* mpConstantRotationBones = nullptr;
+    const uint16* mpConstantTranslationBones = nullptr;
+
+    const float32* mpConstantRotations = nullptr;
+    const float32* mpConstantTranslations = nullptr;
+
+    /// The minimum and quantization step of each animated translation track, as planes of each component.
+    const float32* mpTranslationMins = nullptr;
+    const float32* mpTranslationSteps = nullptr;
+
+    const uint16* mpFrames = nullptr;
+};
+
+} // namespace fx
@@ -4,8 +4,10 @@
 #include "Core/SizedArray.hpp"
 #include "Loader/Image/LoaderJpeg.hpp"
 #include "Loader/Image/LoaderStb.hpp"
+#include "Loader/Object/LoaderCookedMesh.hpp"
 #include "Loader/Object/LoaderGltf.hpp"
 
+#include <Asset/CookedMesh.hpp>
 #include <Core/Defines.hpp>
 #include <Core/Types.hpp>
 #include <Engine.hpp>
@@ -278,7 +280,13 @@ AssetTicket AssetManager::LoadObject(const std::string& name, const std::string&
 	Object* object = gObjectManager->NewObject(name);
 	AssetTicket ticket { object };
 
-	LoadFromPath<loader::LoaderGltf>(ticket, eAssetType::Object, path);
+	// Models that have been cooked since they were last modified are loaded without parsing the model file
+	if (CookedMesh::IsUpToDate(String(path.c_str()))) {
+		LoadFromPath<loader::LoaderCookedMesh>(ticket, eAssetType::Object, path);
+	}
+	else {
+		LoadFromPath<loader::LoaderGltf>(ticket, eAssetType::Object, path);
+	}
 
 	return ticket;
 }
@@ -0,0 +1,508 @@
+#include "BlockCompress.hpp"
+
+#include <Core/Assert.hpp>
+#include <Core/JobSystem.hpp>
+#include <Engine.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace fx::BlockCompress {
+
+static constexpr uint32 scPixelSize = 4;
+static constexpr uint32 scBlockPixels = 16;
+
+/// Roughly the number of blocks in each job when an image is split by rows of blocks.
+static constexpr uint32 scBlocksPerJob = 1024;
+
+/**
+ * Copies a 4x4 block of pixels, repeating the last column and row for blocks that are past the edges of the image.
+ */
+static void LoadBlock(const uint8* src, const Vec2u& size, uint32 block_x, uint32 block_y,
+					  uint8 (&out_pixels)[scBlockPixels][scPixelSize])
+{
+	for (uint32 y = 0; y < 4; y++) {
+		const uint32 src_y = std::min((block_y * 4) + y, size.Y - 1);
+
+		for (uint32 x = 0; x < 4; x++) {
+			const uint32 src_x = std::min((block_x * 4) + x, size.X - 1);
+
+			memcpy(out_pixels[(y * 4) + x], src + ((static_cast<uint64>(src_y) * size.X) + src_x) * scPixelSize,
+				   scPixelSize);
+		}
+	}
+}
+
+///////////////////////////////
+// BC4 / BC5
+///////////////////////////////
+
+/**
+ * Encodes one channel of a block to 8 bytes, using the mode with two endpoints and six interpolated values.
+ */
+static void EncodeBlockBC4(const uint8 (&pixels)[scBlockPixels][scPixelSize], uint32 channel, uint8* dst)
+{
+	uint8 min_value = 255;
+	uint8 max_value = 0;
+
+	for (uint32 i = 0; i < scBlockPixels; i++) {
+		min_value = std::min(min_value, pixels[i][channel]);
+		max_value = std::max(max_value, pixels[i][channel]);
+	}
+
+	// The first endpoint must be the larger to select the eight value mode
+	dst[0] = max_value;
+	dst[1] = min_value;
+
+	uint64 index_bits = 0;
+
+	if (max_value != min_value) {
+		int32 palette[8];
+
+		palette[0] = max_value;
+		palette[1] = min_value;
+
+		for (int32 i = 2; i < 8; i++) {
+			palette[i] = (((8 - i) * max_value) + ((i - 1) * min_value) + 3) / 7;
+		}
+
+		for (uint32 i = 0; i < scBlockPixels; i++) {
+			const int32 value = pixels[i][channel];
+
+			uint32 best_index = 0;
+			int32 best_error = INT32_MAX;
+
+			for (uint32 index = 0; index < 8; index++) {
+				const int32 error = std::abs(palette[index] - value);
+
+				if (error < best_error) {
+					best_error = error;
+					best_index = index;
+				}
+			}
+
+			index_bits |= static_cast<uint64>(best_index) << (i * 3);
+		}
+	}
+
+	// 48 bits of 3-bit indices, first pixel in the lowest bits
+	for (uint32 i = 0; i < 6; i++) {
+		dst[2 + i] = static_cast<uint8>(index_bits >> (i * 8));
+	}
+}
+
+///////////////////////////////
+// BC7
+///////////////////////////////
+
+/// Interpolation weights (out of 64) for the 4-bit indices of mode 6.
+static constexpr int32 scWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+/// Mode 6 stores two RGBA endpoints as 7 bits per channel, with a shared lowest bit (the p-bit) for each endpoint.
+struct Bc7Endpoints
+{
+	uint8 Color[2][scPixelSize];
+	uint8 PBit[2];
+};
+
+static FX_FORCE_INLINE uint8 GetEndpointValue(const Bc7Endpoints& endpoints, uint32 endpoint, uint32 channel)
+{
+	return static_cast<uint8>((endpoints.Color[endpoint][channel] << 1) | endpoints.PBit[endpoint]);
+}
+
+/**
+ * Quantizes a floating point endpoint, choosing the p-bit that represents it most closely.
+ */
+static void QuantizeEndpoint(const float32 (&value)[scPixelSize], Bc7Endpoints& endpoints, uint32 endpoint)
+{
+	float32 best_error = FLT_MAX;
+
+	for (uint8 pbit = 0; pbit < 2; pbit++) {
+		uint8 quantized[scPixelSize];
+		float32 error = 0.0f;
+
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			const float32 clamped = std::clamp(value[c], 0.0f, 255.0f);
+			const int32 q = std::clamp(static_cast<int32>(std::lround((clamped - pbit) * 0.5f)), 0, 127);
+
+			const float32 difference = static_cast<float32>((q << 1) | pbit) - clamped;
+			error += difference * difference;
+
+			quantized[c] = static_cast<uint8>(q);
+		}
+
+		if (error < best_error) {
+			best_error = error;
+
+			memcpy(endpoints.Color[endpoint], quantized, sizeof(quantized));
+			endpoints.PBit[endpoint] = pbit;
+		}
+	}
+}
+
+/**
+ * Picks the closest interpolated colour for each pixel.
+ * @returns The total squared error of the block.
+ */
+static uint32 FindIndicesBC7(const uint8 (&pixels)[scBlockPixels][scPixelSize], const Bc7Endpoints& endpoints,
+							 uint8 (&out_indices)[scBlockPixels])
+{
+	int32 palette[16][scPixelSize];
+
+	int32 e0[scPixelSize];
+	int32 e1[scPixelSize];
+
+	for (uint32 c = 0; c < scPixelSize; c++) {
+		e0[c] = GetEndpointValue(endpoints, 0, c);
+		e1[c] = GetEndpointValue(endpoints, 1, c);
+	}
+
+	for (uint32 i = 0; i < 16; i++) {
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			palette[i][c] = (((64 - scWeights4[i]) * e0[c]) + (scWeights4[i] * e1[c]) + 32) >> 6;
+		}
+	}
+
+	int32 direction[scPixelSize];
+	int32 length_sq = 0;
+
+	for (uint32 c = 0; c < scPixelSize; c++) {
+		direction[c] = e1[c] - e0[c];
+		length_sq += direction[c] * direction[c];
+	}
+
+	uint32 total_error = 0;
+
+	for (uint32 i = 0; i < scBlockPixels; i++) {
+		// Project onto the endpoint line to find the nearest weight, then check the indices either side of it as the
+		// weights are not evenly spaced and the palette is rounded.
+		int32 nearest = 0;
+
+		if (length_sq > 0) {
+			int32 dot = 0;
+
+			for (uint32 c = 0; c < scPixelSize; c++) {
+				dot += (pixels[i][c] - e0[c]) * direction[c];
+			}
+
+			// Compared at twice the weight to stay in integers
+			const float32 weight_x2 = (static_cast<float32>(dot) * 128.0f) / static_cast<float32>(length_sq);
+
+			while (nearest < 15 && static_cast<float32>(scWeights4[nearest] + scWeights4[nearest + 1]) < weight_x2) {
+				nearest++;
+			}
+		}
+
+		uint32 best_index = 0;
+		uint32 best_error = UINT32_MAX;
+
+		for (int32 index = std::max(0, nearest - 1); index <= std::min(15, nearest + 1); index++) {
+			uint32 error = 0;
+
+			for (uint32 c = 0; c < scPixelSize; c++) {
+				const int32 difference = palette[index][c] - pixels[i][c];
+				error += static_cast<uint32>(difference * difference);
+			}
+
+			if (error < best_error) {
+				best_error = error;
+				best_index = static_cast<uint32>(index);
+			}
+		}
+
+		out_indices[i] = static_cast<uint8>(best_index);
+		total_error += best_error;
+	}
+
+	return total_error;
+}
+
+/**
+ * Fits the endpoints to the chosen indices with least squares.
+ * @returns False if the indices do not constrain the endpoints (every pixel uses the same weight).
+ */
+static bool RefineEndpointsBC7(const uint8 (&pixels)[scBlockPixels][scPixelSize],
+							   const uint8 (&indices)[scBlockPixels], float32 (&out_e0)[scPixelSize],
+							   float32 (&out_e1)[scPixelSize])
+{
+	float32 aa = 0.0f;
+	float32 ab = 0.0f;
+	float32 bb = 0.0f;
+
+	float32 rhs0[scPixelSize] = {};
+	float32 rhs1[scPixelSize] = {};
+
+	for (uint32 i = 0; i < scBlockPixels; i++) {
+		const float32 b = static_cast<float32>(scWeights4[indices[i]]) / 64.0f;
+		const float32 a = 1.0f - b;
+
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			rhs0[c] += a * pixels[i][c];
+			rhs1[c] += b * pixels[i][c];
+		}
+	}
+
+	const float32 determinant = (aa * bb) - (ab * ab);
+
+	if (std::abs(determinant) < 1e-6f) {
+		return false;
+	}
+
+	const float32 inv_determinant = 1.0f / determinant;
+
+	for (uint32 c = 0; c < scPixelSize; c++) {
+		out_e0[c] = ((bb * rhs0[c]) - (ab * rhs1[c])) * inv_determinant;
+		out_e1[c] = ((aa * rhs1[c]) - (ab * rhs0[c])) * inv_determinant;
+	}
+
+	return true;
+}
+
+/**
+ * Writes bits to a 128-bit block, starting from the lowest bit.
+ */
+struct BlockWriter
+{
+	void Write(uint32 value, uint32 bit_count)
+	{
+		for (uint32 i = 0; i < bit_count; i++, Position++) {
+			if ((value >> i) & 1) {
+				Bits[Position / 64] |= (1ULL << (Position % 64));
+			}
+		}
+	}
+
+	uint64 Bits[2] = { 0, 0 };
+	uint32 Position = 0;
+};
+
+static void EncodeBlockBC7(const uint8 (&pixels)[scBlockPixels][scPixelSize], uint8* dst)
+{
+	// Find the principal axis of the block's colours with power iteration on the covariance matrix
+	float32 mean[scPixelSize] = {};
+
+	for (uint32 i = 0; i < scBlockPixels; i++) {
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			mean[c] += pixels[i][c];
+		}
+	}
+
+	for (float32& value : mean) {
+		value /= static_cast<float32>(scBlockPixels);
+	}
+
+	float32 covariance[scPixelSize][scPixelSize] = {};
+	float32 axis[scPixelSize] = {};
+
+	{
+		float32 min_value[scPixelSize] = { 255.0f, 255.0f, 255.0f, 255.0f };
+		float32 max_value[scPixelSize] = {};
+
+		for (uint32 i = 0; i < scBlockPixels; i++) {
+			float32 offset[scPixelSize];
+
+			for (uint32 c = 0; c < scPixelSize; c++) {
+				offset[c] = pixels[i][c] - mean[c];
+
+				min_value[c] = std::min(min_value[c], static_cast<float32>(pixels[i][c]));
+				max_value[c] = std::max(max_value[c], static_cast<float32>(pixels[i][c]));
+			}
+
+			for (uint32 row = 0; row < scPixelSize; row++) {
+				for (uint32 col = 0; col < scPixelSize; col++) {
+					covariance[row][col] += offset[row] * offset[col];
+				}
+			}
+		}
+
+		// Start from the diagonal of the bounding box, which is usually close to the principal axis
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			axis[c] = max_value[c] - min_value[c];
+		}
+	}
+
+	for (uint32 iteration = 0; iteration < 8; iteration++) {
+		float32 next[scPixelSize] = {};
+
+		for (uint32 row = 0; row < scPixelSize; row++) {
+			for (uint32 col = 0; col < scPixelSize; col++) {
+				next[row] += covariance[row][col] * axis[col];
+			}
+		}
+
+		const float32 length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]), std::abs(next[3]) });
+
+		if (length < 1e-6f) {
+			break;
+		}
+
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			axis[c] = next[c] / length;
+		}
+	}
+
+	// The endpoints are the extents of the block along the axis
+	float32 min_t = 0.0f;
+	float32 max_t = 0.0f;
+
+	const float32 axis_length_sq = (axis[0] * axis[0]) + (axis[1] * axis[1]) + (axis[2] * axis[2]) +
+								   (axis[3] * axis[3]);
+
+	if (axis_length_sq > 1e-12f) {
+		min_t = FLT_MAX;
+		max_t = -FLT_MAX;
+
+		for (uint32 i = 0; i < scBlockPixels; i++) {
+			float32 t = 0.0f;
+
+			for (uint32 c = 0; c < scPixelSize; c++) {
+				t += (pixels[i][c] - mean[c]) * axis[c];
+			}
+
+			min_t = std::min(min_t, t);
+			max_t = std::max(max_t, t);
+		}
+
+		min_t /= axis_length_sq;
+		max_t /= axis_length_sq;
+	}
+
+	float32 e0[scPixelSize];
+	float32 e1[scPixelSize];
+
+	for (uint32 c = 0; c < scPixelSize; c++) {
+		e0[c] = mean[c] + (axis[c] * min_t);
+		e1[c] = mean[c] + (axis[c] * max_t);
+	}
+
+	Bc7Endpoints endpoints;
+	QuantizeEndpoint(e0, endpoints, 0);
+	QuantizeEndpoint(e1, endpoints, 1);
+
+	uint8 indices[scBlockPixels];
+	uint32 error = FindIndicesBC7(pixels, endpoints, indices);
+
+	// Refit the endpoints to the indices a couple of times, keeping the result while it improves
+	for (uint32 iteration = 0; iteration < 2 && error > 0; iteration++) {
+		if (!RefineEndpointsBC7(pixels, indices, e0, e1)) {
+			break;
+		}
+
+		Bc7Endpoints refined_endpoints;
+		QuantizeEndpoint(e0, refined_endpoints, 0);
+		QuantizeEndpoint(e1, refined_endpoints, 1);
+
+		uint8 refined_indices[scBlockPixels];
+		const uint32 refined_error = FindIndicesBC7(pixels, refined_endpoints, refined_indices);
+
+		if (refined_error >= error) {
+			break;
+		}
+
+		error = refined_error;
+		endpoints = refined_endpoints;
+		memcpy(indices, refined_indices, sizeof(indices));
+	}
+
+	// The highest bit of the first index is not stored, so swap the endpoints if it is set
+	if (indices[0] & 0x8) {
+		std::swap(endpoints.Color[0], endpoints.Color[1]);
+		std::swap(endpoints.PBit[0], endpoints.PBit[1]);
+
+		for (uint8& index : indices) {
+			index = 15 - index;
+		}
+	}
+
+	BlockWriter writer;
+
+	// Mode 6 is selected by six zero bits followed by a one
+	writer.Write(1U << 6, 7);
+
+	for (uint32 c = 0; c < scPixelSize; c++) {
+		writer.Write(endpoints.Color[0][c], 7);
+		writer.Write(endpoints.Color[1][c], 7);
+	}
+
+	writer.Write(endpoints.PBit[0], 1);
+	writer.Write(endpoints.PBit[1], 1);
+
+	writer.Write(indices[0], 3);
+
+	for (uint32 i = 1; i < scBlockPixels; i++) {
+		writer.Write(indices[i], 4);
+	}
+
+	Assert(writer.Position == 128);
+
+	memcpy(dst, writer.Bits, sizeof(writer.Bits));
+}
+
+///////////////////////////////
+// Images
+///////////////////////////////
+
+void Compress(eImageFormat format, const uint8* src, const Vec2u& size, uint8* dst)
+{
+	Assert(ImageFormatUtil::IsBlockCompressed(format));
+
+	const uint32 block_size = ImageFormatUtil::GetBlockSize(format);
+
+	const uint32 blocks_x = (size.X + 3) / 4;
+	const uint32 blocks_y = (size.Y + 3) / 4;
+
+	auto compress_rows = [&](uint32 start_y, uint32 end_y)
+	{
+		uint8 pixels[scBlockPixels][scPixelSize];
+
+		for (uint32 block_y = start_y; block_y < end_y; block_y++) {
+			uint8* dst_row = dst + (static_cast<uint64>(block_y) * blocks_x * block_size);
+
+			for (uint32 block_x = 0; block_x < blocks_x; block_x++) {
+				LoadBlock(src, size, block_x, block_y, pixels);
+
+				uint8* dst_block = dst_row + (block_x * block_size);
+
+				switch (format) {
+				case eImageFormat::BC4_UNorm:
+					EncodeBlockBC4(pixels, 0, dst_block);
+					break;
+				case eImageFormat::BC5_UNorm:
+					EncodeBlockBC4(pixels, 0, dst_block);
+					EncodeBlockBC4(pixels, 1, dst_block + 8);
+					break;
+				default:
+					EncodeBlockBC7(pixels, dst_block);
+					break;
+				}
+			}
+		}
+	};
+
+	if (gJobSystem) {
+		gJobSystem->ParallelFor(blocks_y, std::max(1U, scBlocksPerJob / blocks_x), compress_rows);
+	}
+	else {
+		compress_rows(0, blocks_y);
+	}
+}
+
+bool IsGrayscale(const Slice<const uint8>& pixels)
+{
+	for (uint64 i = 0; i + scPixelSize <= pixels.Size; i += scPixelSize) {
+		const uint8* pixel = pixels.pData + i;
+
+		if (pixel[0] != pixel[1] || pixel[0] != pixel[2] || pixel[3] != 255) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace fx::BlockCompress
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Core/Slice.hpp>
+#include <Core/Types.hpp>
+#include <Math/Vec2.hpp>
+#include <Renderer/Backend/Image.hpp>
+
+namespace fx::BlockCompress {
+
+/**
+ * @brief Compresses an image of four 8-bit channels to a block compressed format. Each 4x4 block of pixels is encoded
+ * independently, and blocks on the right and bottom edges of images that are not a multiple of four repeat the last
+ * column and row. The destination must have room for `ImageFormatUtil::GetDataSize(format, size)` bytes.
+ *
+ * - `BC4_UNorm` stores the red channel.
+ * - `BC5_UNorm` stores the red and green channels, such as the XY of a tangent space normal map.
+ * - `BC7_UNorm` and `BC7_SRGB` store all four channels. Blocks are encoded as BC7 mode 6 (one subset with RGBA
+ *   endpoints), which handles colour and alpha well and is fast to search.
+ *
+ * Large images are split across the job system by rows of blocks.
+ */
+void Compress(eImageFormat format, const uint8* src, const Vec2u& size, uint8* dst);
+
+/**
+ * @brief Returns true if the RGB channels of each pixel are equal and every pixel is opaque, in which case the image
+ * can be stored as `BC4_UNorm`.
+ */
+bool IsGrayscale(const Slice<const uint8>& pixels);
+
+} // namespace fx::BlockCompress
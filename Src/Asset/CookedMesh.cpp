@@ -0,0 +1,708 @@
+#include "CookedMesh.hpp"
+
+#include <Core/FilesystemIO.hpp>
+#include <Core/Log.hpp>
+#include <Core/Path.hpp>
+#include <Engine.hpp>
+#include <Material/Material.hpp>
+#include <Material/MaterialManager.hpp>
+#include <Object/Object.hpp>
+#include <Object/ObjectManager.hpp>
+#include <Renderer/PrimitiveMesh.hpp>
+#include <cstring>
+#include <mutex>
+
+namespace fx {
+
+struct CookedMeshHeader
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+
+	/// The modification time of the model file that was cooked (see `FilesystemIO::FileGetLastModified()`).
+	uint64 SourceModifiedTime = 0;
+};
+
+static constexpr Hash64 scHeaderEntry = 1;
+
+/// The objects, materials, mesh infos and skeletons of the model.
+static constexpr Hash64 scModelEntry = 2;
+
+/// The path and modification time of each external file that the model references.
+static constexpr Hash64 scDependencyEntry = 3;
+
+/// The data of mesh N is stored in entry `scFirstMeshEntry + N`.
+static constexpr Hash64 scFirstMeshEntry = 0x100;
+
+/// Cooked models are written by the loader threads, which can load the same model at once.
+static std::mutex sWriteMutex;
+
+/**
+ * Appends values to a buffer for an entry of the cooked model.
+ */
+class CookWriter
+{
+public:
+	template <typename T>
+	void Write(const T& value)
+	{
+		WriteBytes(&value, sizeof(T));
+	}
+
+	template <typename T>
+	void WriteArray(const SizedArray<T>& values)
+	{
+		Write(static_cast<uint32>(values.Size));
+		WriteBytes(values.pData, values.Size * sizeof(T));
+	}
+
+	void WriteString(const char* str, uint32 length)
+	{
+		Write(length);
+		WriteBytes(str, length);
+	}
+
+	void WriteBytes(const void* data, uint64 size)
+	{
+		if (size == 0) {
+			return;
+		}
+
+		const uint8* bytes = static_cast<const uint8*>(data);
+		Data.insert(Data.end(), bytes, bytes + size);
+	}
+
+	Slice<uint8> GetData() { return Slice<uint8>(Data.data(), static_cast<uint32>(Data.size())); }
+
+public:
+	std::vector<uint8> Data;
+};
+
+/**
+ * Reads values from an entry of the cooked model. Reading past the end of the entry zeroes the values and marks the
+ * reader as invalid, so the entry is only checked once it has been read.
+ */
+class CookReader
+{
+public:
+	CookReader(const SizedArray<uint8>& data) : mpData(data.pData), mSize(data.Size) {}
+
+	template <typename T>
+	T Read()
+	{
+		T value {};
+		ReadBytes(&value, sizeof(T));
+
+		return value;
+	}
+
+	/**
+	 * Reads the number of elements in a table or array. Each element is at least one byte, so counts larger than the
+	 * rest of the entry are invalid, and are read as zero.
+	 */
+	uint32 ReadCount()
+	{
+		const uint32 count = Read<uint32>();
+
+		if (!CanRead(count)) {
+			return 0;
+		}
+
+		return count;
+	}
+
+	template <typename T>
+	void ReadArray(SizedArray<T>& values)
+	{
+		const uint32 count = ReadCount();
+
+		if (count == 0 || !CanRead(static_cast<uint64>(count) * sizeof(T))) {
+			return;
+		}
+
+		values.InitSize(count);
+		ReadBytes(values.pData, static_cast<uint64>(count) * sizeof(T));
+	}
+
+	std::string ReadString()
+	{
+		const uint32 length = Read<uint32>();
+
+		if (!CanRead(length)) {
+			return std::string();
+		}
+
+		std::string str(reinterpret_cast<const char*>(mpData + mOffset), length);
+		mOffset += length;
+
+		return str;
+	}
+
+	void ReadBytes(void* dst, uint64 size)
+	{
+		if (!CanRead(size)) {
+			memset(dst, 0, size);
+			return;
+		}
+
+		memcpy(dst, mpData + mOffset, size);
+		mOffset += size;
+	}
+
+	FX_FORCE_INLINE bool IsValid() const { return !mbOverflow; }
+
+private:
+	bool CanRead(uint64 size)
+	{
+		if (mbOverflow || mOffset + size > mSize) {
+			mbOverflow = true;
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	const uint8* mpData = nullptr;
+	uint64 mSize = 0;
+	uint64 mOffset = 0;
+
+	bool mbOverflow = false;
+};
+
+///////////////////////////////
+// Mesh info
+///////////////////////////////
+
+uint64 CookedMeshInfo::GetVerticesSize() const
+{
+	return static_cast<uint64>(VertexCount) * renderer::VertexUtil::GetSize(VertexType);
+}
+
+uint64 CookedMeshInfo::GetDataSize() const
+{
+	return PrimitiveMesh::GetStagedSize(GetVerticesSize(), IndexCount, IndexType);
+}
+
+///////////////////////////////
+// Paths
+///////////////////////////////
+
+String CookedMesh::GetCookedPath(const String& model_path)
+{
+	Path cooked_path(model_path);
+
+	cooked_path.RemoveExtension();
+	const String model_name = *cooked_path.BaseName();
+
+	cooked_path.RemoveLast();
+	cooked_path.DirDown("TGen");
+
+	return cooked_path.Add(model_name).AddExtension(".fxc").Str();
+}
+
+/**
+ * Returns the path of an external file of the model, from its path relative to the model's directory.
+ */
+static String GetDependencyPath(const String& model_path, const String& relative_path)
+{
+	Path path(model_path);
+	path.RemoveLast();
+
+	return path.Add(relative_path).Str();
+}
+
+/**
+ * Returns the modification time of the file at `path`, or zero if the file does not exist.
+ */
+static uint64 GetModifiedTime(const String& path)
+{
+	if (!FilesystemIO::FileExists(path)) {
+		return 0;
+	}
+
+	return FilesystemIO::FileGetLastModified(path.CStr());
+}
+
+static bool AreDependenciesUpToDate(DataPack& pack, const String& model_path)
+{
+	DataPackEntry* entry = pack.GetEntry(scDependencyEntry, true);
+
+	if (entry == nullptr) {
+		return false;
+	}
+
+	CookReader reader(entry->Data);
+
+	const uint32 dependency_count = reader.ReadCount();
+
+	for (uint32 i = 0; i < dependency_count && reader.IsValid(); i++) {
+		const std::string relative_path = reader.ReadString();
+		const uint64 modified_time = reader.Read<uint64>();
+
+		if (!reader.IsValid()) {
+			return false;
+		}
+
+		const String dependency(relative_path.c_str(), static_cast<uint32>(relative_path.size()));
+
+		if (modified_time != GetModifiedTime(GetDependencyPath(model_path, dependency))) {
+			return false;
+		}
+	}
+
+	return reader.IsValid();
+}
+
+static bool ReadHeader(DataPack& pack, const String& model_path)
+{
+	DataPackEntry* entry = pack.GetEntry(scHeaderEntry, true);
+
+	if (entry == nullptr || entry->Data.Size != sizeof(CookedMeshHeader)) {
+		return false;
+	}
+
+	CookedMeshHeader header;
+	memcpy(&header, entry->Data.pData, sizeof(header));
+
+	if (header.Magic != CookedMesh::scMagic || header.Version != CookedMesh::scVersion) {
+		return false;
+	}
+
+	if (header.SourceModifiedTime != FilesystemIO::FileGetLastModified(model_path.CStr())) {
+		return false;
+	}
+
+	return AreDependenciesUpToDate(pack, model_path);
+}
+
+bool CookedMesh::IsUpToDate(const String& model_path)
+{
+	const String cooked_path = GetCookedPath(model_path);
+
+	if (!FilesystemIO::FileExists(model_path) || !FilesystemIO::FileExists(cooked_path)) {
+		return false;
+	}
+
+	DataPack pack;
+
+	if (!pack.ReadFromFile(cooked_path.CStr())) {
+		return false;
+	}
+
+	return ReadHeader(pack, model_path);
+}
+
+///////////////////////////////
+// Writing
+///////////////////////////////
+
+static uint32 AddMaterial(std::vector<Material*>& materials, CookWriter& writer, Material* material)
+{
+	for (uint32 i = 0; i < materials.size(); i++) {
+		if (materials[i] == material) {
+			return i;
+		}
+	}
+
+	const std::string& name = material->Name.Get();
+
+	writer.WriteString(name.c_str(), static_cast<uint32>(name.size()));
+	writer.Write(material->Diffuse.TextureCacheID);
+	writer.Write(material->NormalMap.TextureCacheID);
+	writer.Write(material->MetallicRoughness.TextureCacheID);
+	writer.Write<uint8>(material->bSupportsSkinning);
+
+	materials.push_back(material);
+
+	return static_cast<uint32>(materials.size() - 1);
+}
+
+template <typename T>
+static void WriteTrack(CookWriter& writer, const BoneTransformTrack<T>& track)
+{
+	writer.WriteArray(track.Times);
+	writer.WriteArray(track.Values);
+	writer.Write(track.SampleRate);
+}
+
+static void WriteSkeleton(CookWriter& writer, const Skeleton& skeleton, const SizedArray<Animation>& animations)
+{
+	writer.Write(skeleton.JointCount);
+	writer.WriteArray(skeleton.InvBindTransforms);
+	writer.WriteArray(skeleton.ParentIndices);
+
+	writer.Write(static_cast<uint32>(skeleton.BoneNames.Size));
+
+	for (const String& bone_name : skeleton.BoneNames) {
+		writer.WriteString(bone_name.CStr(), bone_name.GetLength());
+	}
+
+	writer.Write(static_cast<uint32>(animations.Size));
+
+	for (const Animation& animation : animations) {
+		writer.WriteString(animation.Name.CStr(), animation.Name.GetLength());
+		writer.Write(animation.Duration);
+		writer.Write(static_cast<uint32>(animation.BoneTracks.Size));
+
+		for (const BoneTrack& track : animation.BoneTracks) {
+			WriteTrack(writer, track.Translation);
+			WriteTrack(writer, track.Rotation);
+		}
+	}
+}
+
+bool CookedMesh::Write(const String& model_path, Object* root, const std::vector<String>& dependencies)
+{
+	// Collect the objects parents first, so each object can be attached to its parent as it is created
+	std::vector<Object*> objects { root };
+	std::vector<uint32> parent_indices { scCookedNoIndex };
+
+	for (uint32 i = 0; i < objects.size(); i++) {
+		Object* object = objects[i];
+
+		if (object->AttachedNodes.IsEmpty()) {
+			continue;
+		}
+
+		for (const ObjectID& attached_id : object->AttachedNodes) {
+			objects.push_back(gObjectManager->GetObject(attached_id));
+			parent_indices.push_back(i);
+		}
+	}
+
+	DataPack pack;
+
+	CookWriter object_writer;
+	CookWriter material_writer;
+	CookWriter mesh_writer;
+	CookWriter skeleton_writer;
+
+	std::vector<Material*> materials;
+	uint32 mesh_count = 0;
+	uint32 skeleton_count = 0;
+
+	for (uint32 i = 0; i < objects.size(); i++) {
+		Object* object = objects[i];
+
+		uint32 mesh_index = scCookedNoIndex;
+		uint32 material_index = scCookedNoIndex;
+		uint32 skeleton_index = scCookedNoIndex;
+
+		if (object->pMesh != nullptr && object->pMesh->VertexList.GetLocalBuffer().IsNotEmpty()) {
+			PrimitiveMesh& mesh = *object->pMesh;
+
+			// This picks the same index type as when the mesh was staged
+			SizedArray<uint8> mesh_data;
+			mesh_data.InitSize(mesh.PrepareStaging());
+			mesh.WriteToStaging(mesh_data.pData);
+
+			mesh_index = mesh_count++;
+			pack.AddEntry(scFirstMeshEntry + mesh_index, Slice<uint8>(mesh_data));
+
+			mesh_writer.Write(static_cast<uint32>(mesh.VertexList.VertexType));
+			mesh_writer.Write(mesh.VertexList.GetLocalBuffer().Size);
+			mesh_writer.Write(static_cast<uint32>(mesh.IndexType));
+			mesh_writer.Write(mesh.IndexCount);
+			mesh_writer.Write<uint8>(mesh.VertexList.bContainsNormals);
+			mesh_writer.Write<uint8>(mesh.VertexList.bContainsUVs);
+			mesh_writer.Write<uint8>(mesh.VertexList.bContainsTangents);
+		}
+
+		if (!object->GetMaterialID().IsNull()) {
+			Material* material = gMaterialManager->GetMaterial(object->GetMaterialID());
+			material_index = AddMaterial(materials, material_writer, material);
+		}
+
+		if (object->pSkeleton != nullptr) {
+			skeleton_index = skeleton_count++;
+			WriteSkeleton(skeleton_writer, *object->pSkeleton, object->Animations);
+		}
+
+		const std::string& name = object->Name.Get();
+
+		object_writer.WriteString(name.c_str(), static_cast<uint32>(name.size()));
+		object_writer.Write(parent_indices[i]);
+		object_writer.Write(mesh_index);
+		object_writer.Write(material_index);
+		object_writer.Write(skeleton_index);
+		object_writer.Write(object->Bounds.Min);
+		object_writer.Write(object->Bounds.Max);
+	}
+
+	CookWriter model_writer;
+
+	model_writer.Write(static_cast<uint32>(objects.size()));
+	model_writer.WriteBytes(object_writer.Data.data(), object_writer.Data.size());
+
+	model_writer.Write(static_cast<uint32>(materials.size()));
+	model_writer.WriteBytes(material_writer.Data.data(), material_writer.Data.size());
+
+	model_writer.Write(mesh_count);
+	model_writer.WriteBytes(mesh_writer.Data.data(), mesh_writer.Data.size());
+
+	model_writer.Write(skeleton_count);
+	model_writer.WriteBytes(skeleton_writer.Data.data(), skeleton_writer.Data.size());
+
+	pack.AddEntry(scModelEntry, model_writer.GetData());
+
+	CookWriter dependency_writer;
+
+	dependency_writer.Write(static_cast<uint32>(dependencies.size()));
+
+	for (const String& dependency : dependencies) {
+		dependency_writer.WriteString(dependency.CStr(), dependency.GetLength());
+		dependency_writer.Write(GetModifiedTime(GetDependencyPath(model_path, dependency)));
+	}
+
+	pack.AddEntry(scDependencyEntry, dependency_writer.GetData());
+
+	CookedMeshHeader header {
+		.Magic = scMagic,
+		.Version = scVersion,
+		.SourceModifiedTime = FilesystemIO::FileGetLastModified(model_path.CStr()),
+	};
+
+	pack.AddEntry(scHeaderEntry, Slice<uint8>(reinterpret_cast<uint8*>(&header), sizeof(header)));
+
+	const String cooked_path = GetCookedPath(model_path);
+
+	Path cooked_dir(cooked_path);
+	cooked_dir.RemoveLast();
+	cooked_dir.CreateDirs();
+
+	{
+		std::lock_guard lock(sWriteMutex);
+
+		pack.WriteToFile(cooked_path.CStr());
+
+		if (!pack.IsOpen()) {
+			LogWarning(LC_ASSET, "Could not write cooked model to '{}'", cooked_path);
+			return false;
+		}
+
+		pack.Close();
+	}
+
+	LogInfo(LC_ASSET, "Cooked model '{}' ({} objects, {} meshes, {} materials)", model_path, objects.size(),
+			mesh_count, materials.size());
+
+	return true;
+}
+
+///////////////////////////////
+// Reading
+///////////////////////////////
+
+template <typename T>
+static void ReadTrack(CookReader& reader, BoneTransformTrack<T>& track)
+{
+	reader.ReadArray(track.Times);
+	reader.ReadArray(track.Values);
+	track.SampleRate = reader.Read<float32>();
+}
+
+static void ReadSkeleton(CookReader& reader, CookedSkeleton& cooked)
+{
+	cooked.pSkeleton = Ref<Skeleton>::New();
+	Skeleton& skeleton = *cooked.pSkeleton;
+
+	skeleton.JointCount = reader.Read<uint32>();
+	reader.ReadArray(skeleton.InvBindTransforms);
+	reader.ReadArray(skeleton.ParentIndices);
+
+	const uint32 bone_name_count = reader.ReadCount();
+
+	if (bone_name_count > 0) {
+		skeleton.BoneNames.InitSize(bone_name_count);
+
+		for (String& bone_name : skeleton.BoneNames) {
+			const std::string name = reader.ReadString();
+			bone_name = String(name.c_str(), static_cast<uint32>(name.size()));
+		}
+	}
+
+	if (skeleton.JointCount > 0) {
+		skeleton.WorldTransforms.InitSize(skeleton.JointCount);
+		skeleton.SkinningMatrices.InitSize(skeleton.JointCount);
+	}
+
+	const uint32 animation_count = reader.ReadCount();
+
+	if (animation_count == 0) {
+		return;
+	}
+
+	cooked.Animations.InitCapacity(animation_count);
+
+	for (uint32 i = 0; i < animation_count && reader.IsValid(); i++) {
+		Animation animation;
+
+		const std::string name = reader.ReadString();
+		animation.Name = String(name.c_str(), static_cast<uint32>(name.size()));
+		animation.Duration = reader.Read<float32>();
+
+		const uint32 track_count = reader.ReadCount();
+
+		if (track_count > 0) {
+			animation.BoneTracks.InitSize(track_count);
+
+			for (BoneTrack& track : animation.BoneTracks) {
+				ReadTrack(reader, track.Translation);
+				ReadTrack(reader, track.Rotation);
+			}
+		}
+
+		cooked.Animations.Insert(std::move(animation));
+	}
+}
+
+bool CookedMesh::Open(const String& model_path)
+{
+	Close();
+
+	const String cooked_path = GetCookedPath(model_path);
+
+	if (!FilesystemIO::FileExists(model_path) || !FilesystemIO::FileExists(cooked_path) ||
+		!mPack.ReadFromFile(cooked_path.CStr())) {
+		return false;
+	}
+
+	if (!ReadHeader(mPack, model_path)) {
+		LogInfo(LC_ASSET, "Cooked model '{}' is out of date", cooked_path);
+		return false;
+	}
+
+	DataPackEntry* model_entry = mPack.GetEntry(scModelEntry, true);
+
+	if (model_entry == nullptr) {
+		LogWarning(LC_ASSET, "Cooked model '{}' has no model entry", cooked_path);
+		return false;
+	}
+
+	CookReader reader(model_entry->Data);
+
+	Objects.resize(reader.ReadCount());
+
+	for (CookedObjectInfo& object : Objects) {
+		object.Name = reader.ReadString();
+		object.ParentIndex = reader.Read<uint32>();
+		object.MeshIndex = reader.Read<uint32>();
+		object.MaterialIndex = reader.Read<uint32>();
+		object.SkeletonIndex = reader.Read<uint32>();
+		object.BoundsMin = reader.Read<Vec3f>();
+		object.BoundsMax = reader.Read<Vec3f>();
+
+		if (!reader.IsValid()) {
+			break;
+		}
+	}
+
+	Materials.resize(reader.ReadCount());
+
+	for (CookedMaterialInfo& material : Materials) {
+		material.Name = reader.ReadString();
+		material.DiffuseID = reader.Read<Hash32>();
+		material.NormalMapID = reader.Read<Hash32>();
+		material.MetallicRoughnessID = reader.Read<Hash32>();
+		material.bSupportsSkinning = (reader.Read<uint8>() != 0);
+
+		if (!reader.IsValid()) {
+			break;
+		}
+	}
+
+	Meshes.resize(reader.ReadCount());
+
+	for (CookedMeshInfo& mesh : Meshes) {
+		mesh.VertexType = static_cast<renderer::eVertexType>(reader.Read<uint32>());
+		mesh.VertexCount = reader.Read<uint32>();
+		mesh.IndexType = static_cast<VkIndexType>(reader.Read<uint32>());
+		mesh.IndexCount = reader.Read<uint32>();
+		mesh.bContainsNormals = (reader.Read<uint8>() != 0);
+		mesh.bContainsUVs = (reader.Read<uint8>() != 0);
+		mesh.bContainsTangents = (reader.Read<uint8>() != 0);
+
+		if (!reader.IsValid()) {
+			break;
+		}
+	}
+
+	Skeletons.resize(reader.ReadCount());
+
+	for (CookedSkeleton& skeleton : Skeletons) {
+		ReadSkeleton(reader, skeleton);
+
+		if (!reader.IsValid()) {
+			break;
+		}
+	}
+
+	// The tables are only needed while they are read
+	model_entry->Data.Free();
+
+	if (!reader.IsValid() || Objects.empty()) {
+		LogWarning(LC_ASSET, "Cooked model '{}' is truncated", cooked_path);
+		Close();
+		return false;
+	}
+
+	for (uint32 i = 0; i < Meshes.size(); i++) {
+		const DataPackEntry* mesh_entry = mPack.GetEntryFast(scFirstMeshEntry + i);
+
+		// Mesh data that does not match the size of its vertices was written with different vertex formats
+		if (mesh_entry == nullptr || mesh_entry->DataSize != Meshes[i].GetDataSize()) {
+			LogWarning(LC_ASSET, "Cooked model '{}' does not match the current vertex formats", cooked_path);
+			Close();
+			return false;
+		}
+	}
+
+	for (uint32 i = 0; i < Objects.size(); i++) {
+		const CookedObjectInfo& object = Objects[i];
+
+		// Parents are stored before their children, and only the root has no parent
+		const bool has_valid_parent = (i == 0) ? (object.ParentIndex == scCookedNoIndex) : (object.ParentIndex < i);
+
+		const bool has_valid_indices = (object.MeshIndex == scCookedNoIndex || object.MeshIndex < Meshes.size()) &&
+									   (object.MaterialIndex == scCookedNoIndex ||
+										object.MaterialIndex < Materials.size()) &&
+									   (object.SkeletonIndex == scCookedNoIndex ||
+										object.SkeletonIndex < Skeletons.size());
+
+		if (!has_valid_parent || !has_valid_indices) {
+			LogWarning(LC_ASSET, "Cooked model '{}' is invalid", cooked_path);
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool CookedMesh::ReadMesh(uint32 mesh_index, const Slice<uint8>& dst)
+{
+	const DataPackEntry* entry = mPack.GetEntryFast(scFirstMeshEntry + mesh_index);
+
+	if (entry == nullptr) {
+		return false;
+	}
+
+	return mPack.ReadInto(*entry, dst);
+}
+
+void CookedMesh::Close()
+{
+	mPack.Close();
+
+	if (mPack.Entries.IsInited()) {
+		mPack.Entries.Clear();
+	}
+
+	Objects.clear();
+	Materials.clear();
+	Meshes.clear();
+	Skeletons.clear();
+}
+
+} // namespace fx
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <Asset/Animation.hpp>
+#include <Asset/DataPack.hpp>
+#include <Core/Hash.hpp>
+#include <Core/Ref.hpp>
+#include <Core/SizedArray.hpp>
+#include <Core/Slice.hpp>
+#include <Core/String.hpp>
+#include <Core/Types.hpp>
+#include <Math/Vec3.hpp>
+#include <Renderer/Vertex.hpp>
+#include <string>
+#include <vector>
+
+namespace fx {
+
+class Object;
+
+/// Marks an object without a parent, mesh, material or skeleton in a cooked model.
+static constexpr uint32 scCookedNoIndex = UINT32_MAX;
+
+/**
+ * An object of a cooked model. Objects are stored parents first, so the first object is the root of the model.
+ */
+struct CookedObjectInfo
+{
+	std::string Name;
+
+	uint32 ParentIndex = scCookedNoIndex;
+	uint32 MeshIndex = scCookedNoIndex;
+	uint32 MaterialIndex = scCookedNoIndex;
+	uint32 SkeletonIndex = scCookedNoIndex;
+
+	Vec3f BoundsMin = Vec3f::sZero;
+	Vec3f BoundsMax = Vec3f::sZero;
+};
+
+/**
+ * A material of a cooked model. The textures are referenced by their texture cache IDs, and are loaded from the texture
+ * caches of the model.
+ */
+struct CookedMaterialInfo
+{
+	std::string Name;
+
+	/// The texture cache ID of each component, or `HashNull32` if the component has no texture. A diffuse component
+	/// without a texture uses the null image.
+	Hash32 DiffuseID = HashNull32;
+	Hash32 NormalMapID = HashNull32;
+	Hash32 MetallicRoughnessID = HashNull32;
+
+	bool bSupportsSkinning = false;
+};
+
+/**
+ * A mesh of a cooked model. The data of the mesh is stored in the layout of `PrimitiveMesh::WriteToStaging()`.
+ */
+struct CookedMeshInfo
+{
+	/** @brief Returns the size of the vertices at the start of the mesh data. */
+	uint64 GetVerticesSize() const;
+
+	/** @brief Returns the size of the mesh data, which is the size of the mesh in a staging buffer. */
+	uint64 GetDataSize() const;
+
+	renderer::eVertexType VertexType = renderer::eVertexType::Default;
+	uint32 VertexCount = 0;
+
+	VkIndexType IndexType = VK_INDEX_TYPE_UINT32;
+	uint32 IndexCount = 0;
+
+	bool bContainsNormals = false;
+	bool bContainsUVs = false;
+	bool bContainsTangents = false;
+};
+
+struct CookedSkeleton
+{
+	Ref<Skeleton> pSkeleton { nullptr };
+	SizedArray<Animation> Animations;
+};
+
+/**
+ * @brief A model stored in the form that it is drawn in, so that later loads of the model skip parsing, unpacking and
+ * optimizing it.
+ *
+ * The cooked model is a `DataPack` next to the model's texture caches (`TGen/<ModelName>.fxc`). It holds the object
+ * tree with the bounds of each object, the materials as texture cache IDs, the skeletons and animations, and an entry
+ * per mesh with the final vertices and GPU indices. Mesh entries are read straight into a staging buffer and copied to
+ * the GPU without being changed (see `ReadMesh()`).
+ *
+ * The cooked model is out of date once the model file or any external buffer or image that it references is modified,
+ * or if it was written by a different version of the format (see `IsUpToDate()`).
+ */
+class CookedMesh
+{
+public:
+	static constexpr uint32 scMagic = 0x43435846; // "FXCC"
+
+	/// Increase this when the format, the vertex formats or the `MeshOptimizer` change.
+	static constexpr uint32 scVersion = 2;
+
+public:
+	CookedMesh() = default;
+
+	/**
+	 * @brief Returns the path of the cooked model for the model at `model_path`.
+	 * Example: Some/Path/ModelName.glb  becomes  Some/Path/TGen/ModelName.fxc
+	 */
+	static String GetCookedPath(const String& model_path);
+
+	/**
+	 * @brief Returns true if there is a cooked model for `model_path` that was written from the current model file and
+	 * external files with the current version of the format.
+	 */
+	static bool IsUpToDate(const String& model_path);
+
+	/**
+	 * @brief Writes the object tree under `root` as the cooked model for `model_path`. The meshes must still have their
+	 * local buffers, and the materials must reference their textures by texture cache ID.
+	 *
+	 * @param dependencies The external files that the model references, relative to the directory of the model. The
+	 * cooked model is out of date once any of them is modified.
+	 */
+	static bool Write(const String& model_path, Object* root, const std::vector<String>& dependencies);
+
+	/**
+	 * @brief Opens the cooked model for `model_path` and reads the objects, materials, meshes and skeletons. The mesh
+	 * data is read separately with `ReadMesh()`.
+	 *
+	 * @returns False if the cooked model is missing or invalid.
+	 */
+	bool Open(const String& model_path);
+
+	/**
+	 * @brief Reads the data of the mesh at `mesh_index` into `dst`, which must be at least
+	 * `CookedMeshInfo::GetDataSize()` bytes.
+	 */
+	bool ReadMesh(uint32 mesh_index, const Slice<uint8>& dst);
+
+	void Close();
+
+public:
+	std::vector<CookedObjectInfo> Objects;
+	std::vector<CookedMaterialInfo> Materials;
+	std::vector<CookedMeshInfo> Meshes;
+	std::vector<CookedSkeleton> Skeletons;
+
+private:
+	DataPack mPack;
+};
+
+} // namespace fx
@@ -282,6 +282,19 @@ void DataPack::ReadInto(DataPackEntry* entry)
 	File.Read(Slice<uint8>(entry->Data));
 }
 
+bool DataPack::ReadInto(const DataPackEntry& entry, const Slice<uint8>& dst)
+{
+	if (dst.Size < entry.DataSize) {
+		LogWarning(LC_ASSET, "Buffer is too small for entry 0x{:x} ({} < {} bytes)", entry.Id, dst.Size,
+				   entry.DataSize);
+		return false;
+	}
+
+	File.SeekTo(entry.DataOffset);
+
+	return (File.Read(Slice<uint8>(dst.pData, entry.DataSize)).Size == entry.DataSize);
+}
+
 // DataPackEntry* DataPack::GetEntry(Hash64 id)
 // {
 //     DataPackEntry* entry = QuerySection(id);
@@ -87,6 +87,13 @@ public:
 
     void ReadInto(DataPackEntry* entry);
 
+    /**
+     * @brief Reads the data of `entry` straight into `dst`, such as a mapped staging buffer, without storing it in the
+     * entry. `dst` must be at least `entry.DataSize` bytes.
+     * @returns False if the data could not be read.
+     */
+    bool ReadInto(const DataPackEntry& entry, const Slice<uint8>& dst);
+
     /**
      * @brief Reads data into the provided entry from the datapack using the offset and size from `entry`.
      * @param entry The entry with the data offset and size
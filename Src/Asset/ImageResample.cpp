@@ -0,0 +1,608 @@
+#include "ImageResample.hpp"
+
+#include <Core/CpuFeatures.hpp>
+#include <Core/Defines.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/SizedArray.hpp>
+#include <Engine.hpp>
+#include <cmath>
+#include <cstring>
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace fx::ImageResample {
+
+static constexpr uint32 scPixelSize = 4;
+
+/// Roughly the number of destination pixels in each job when an image is split by rows.
+static constexpr uint32 scPixelsPerJob = 128 * 128;
+
+///////////////////////////////
+// 8-bit box filter
+///////////////////////////////
+
+/**
+ * Averages pixels `[start_x, end_x)` of a destination row from two source rows. `src_next` may be `src_row` when the
+ * source image is one pixel tall.
+ */
+using DownsampleRowFn = void (*)(const uint8* src_row, const uint8* src_next, uint8* dst_row, uint32 start_x,
+								 uint32 end_x);
+
+/**
+ * Scalar version of `DownsampleRowFn`, where `src_x_step` is the offset to the second pixel of each pair (zero when the
+ * source image is one pixel wide).
+ */
+static FX_FORCE_INLINE void DownsamplePixels(const uint8* src_row, const uint8* src_next, uint8* dst_row,
+											 uint32 start_x, uint32 end_x, uint32 src_x_step)
+{
+	for (uint32 x = start_x; x < end_x; x++) {
+		const uint8* top = src_row + (x * 2 * scPixelSize);
+		const uint8* bottom = src_next + (x * 2 * scPixelSize);
+
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			const uint32 sum = top[c] + top[c + src_x_step] + bottom[c] + bottom[c + src_x_step];
+			dst_row[(x * scPixelSize) + c] = static_cast<uint8>((sum + 2) >> 2);
+		}
+	}
+}
+
+static void DownsampleRow_Scalar(const uint8* src_row, const uint8* src_next, uint8* dst_row, uint32 start_x,
+								 uint32 end_x)
+{
+	DownsamplePixels(src_row, src_next, dst_row, start_x, end_x, scPixelSize);
+}
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+FX_TARGET_SSE4 static void DownsampleRow_SSE4(const uint8* src_row, const uint8* src_next, uint8* dst_row,
+											  uint32 start_x, uint32 end_x)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rounding = _mm_set1_epi16(2);
+
+	// Four destination pixels (eight source pixels per row) per iteration
+	uint32 x = start_x;
+
+	for (; x + 4 <= end_x; x += 4) {
+		const uint8* top = src_row + (x * 2 * scPixelSize);
+		const uint8* bottom = src_next + (x * 2 * scPixelSize);
+
+		const __m128 top_a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top)));
+		const __m128 top_b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 16)));
+		const __m128 bottom_a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom)));
+		const __m128 bottom_b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 16)));
+
+		// Split each row into its even and odd pixels
+		const __m128i even0 = _mm_castps_si128(_mm_shuffle_ps(top_a, top_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m128i odd0 = _mm_castps_si128(_mm_shuffle_ps(top_a, top_b, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m128i even1 = _mm_castps_si128(_mm_shuffle_ps(bottom_a, bottom_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m128i odd1 = _mm_castps_si128(_mm_shuffle_ps(bottom_a, bottom_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		__m128i low = _mm_add_epi16(_mm_unpacklo_epi8(even0, zero), _mm_unpacklo_epi8(odd0, zero));
+		low = _mm_add_epi16(low, _mm_add_epi16(_mm_unpacklo_epi8(even1, zero), _mm_unpacklo_epi8(odd1, zero)));
+		low = _mm_srli_epi16(_mm_add_epi16(low, rounding), 2);
+
+		__m128i high = _mm_add_epi16(_mm_unpackhi_epi8(even0, zero), _mm_unpackhi_epi8(odd0, zero));
+		high = _mm_add_epi16(high, _mm_add_epi16(_mm_unpackhi_epi8(even1, zero), _mm_unpackhi_epi8(odd1, zero)));
+		high = _mm_srli_epi16(_mm_add_epi16(high, rounding), 2);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst_row + (x * scPixelSize)), _mm_packus_epi16(low, high));
+	}
+
+	DownsamplePixels(src_row, src_next, dst_row, x, end_x, scPixelSize);
+}
+
+FX_TARGET_AVX2 static void DownsampleRow_AVX2(const uint8* src_row, const uint8* src_next, uint8* dst_row,
+											  uint32 start_x, uint32 end_x)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i rounding = _mm256_set1_epi16(2);
+
+	// Eight destination pixels (sixteen source pixels per row) per iteration
+	uint32 x = start_x;
+
+	for (; x + 8 <= end_x; x += 8) {
+		const uint8* top = src_row + (x * 2 * scPixelSize);
+		const uint8* bottom = src_next + (x * 2 * scPixelSize);
+
+		const __m256 top_a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top)));
+		const __m256 top_b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + 32)));
+		const __m256 bottom_a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom)));
+		const __m256 bottom_b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + 32)));
+
+		// Shuffles stay within each 128-bit lane, so the low lane holds source pixels 0-3 and 8-11, and the high lane
+		// holds 4-7 and 12-15.
+		const __m256i even0 = _mm256_castps_si256(_mm256_shuffle_ps(top_a, top_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m256i odd0 = _mm256_castps_si256(_mm256_shuffle_ps(top_a, top_b, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m256i even1 = _mm256_castps_si256(_mm256_shuffle_ps(bottom_a, bottom_b, _MM_SHUFFLE(2, 0, 2, 0)));
+		const __m256i odd1 = _mm256_castps_si256(_mm256_shuffle_ps(bottom_a, bottom_b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		__m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(even0, zero), _mm256_unpacklo_epi8(odd0, zero));
+		low = _mm256_add_epi16(low,
+							   _mm256_add_epi16(_mm256_unpacklo_epi8(even1, zero), _mm256_unpacklo_epi8(odd1, zero)));
+		low = _mm256_srli_epi16(_mm256_add_epi16(low, rounding), 2);
+
+		__m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(even0, zero), _mm256_unpackhi_epi8(odd0, zero));
+		high = _mm256_add_epi16(high,
+								_mm256_add_epi16(_mm256_unpackhi_epi8(even1, zero), _mm256_unpackhi_epi8(odd1, zero)));
+		high = _mm256_srli_epi16(_mm256_add_epi16(high, rounding), 2);
+
+		// The packed pixels are in the order 0-1, 4-5, 2-3, 6-7
+		const __m256i packed = _mm256_packus_epi16(low, high);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst_row + (x * scPixelSize)),
+							_mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	DownsamplePixels(src_row, src_next, dst_row, x, end_x, scPixelSize);
+}
+
+#endif
+
+static DownsampleRowFn GetDownsampleRow()
+{
+	static const DownsampleRowFn sDownsampleRow = []() -> DownsampleRowFn
+	{
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+		const eCpuTier tier = CpuFeatures::GetInstance().GetTier();
+
+		if (tier >= eCpuTier::AVX2) {
+			return DownsampleRow_AVX2;
+		}
+		if (tier >= eCpuTier::SSE4) {
+			return DownsampleRow_SSE4;
+		}
+#endif
+		return DownsampleRow_Scalar;
+	}();
+
+	return sDownsampleRow;
+}
+
+///////////////////////////////
+// Floating point filter
+///////////////////////////////
+
+/**
+ * The source pixels (along one side) that make up a destination pixel, and the weight of each.
+ */
+struct FilterTaps
+{
+	uint32 Index[3];
+	float32 Weight[3];
+	uint32 Count;
+};
+
+static FX_FORCE_INLINE FilterTaps GetFilterTaps(uint32 dst_index, uint32 src_size)
+{
+	if (src_size == 1) {
+		return FilterTaps { .Index = { 0, 0, 0 }, .Weight = { 1.0f, 0.0f, 0.0f }, .Count = 1 };
+	}
+
+	const uint32 first = dst_index * 2;
+
+	if ((src_size & 1) == 0) {
+		return FilterTaps { .Index = { first, first + 1, 0 }, .Weight = { 0.5f, 0.5f, 0.0f }, .Count = 2 };
+	}
+
+	// A side of 2n + 1 pixels is halved to n pixels, so each destination pixel covers (2n + 1) / n source pixels. The
+	// overlap with the first pixel shrinks and the overlap with the third grows along the side.
+	const float32 half_size = static_cast<float32>(src_size / 2);
+	const float32 inv_size = 1.0f / static_cast<float32>(src_size);
+
+	return FilterTaps {
+		.Index = { first, first + 1, first + 2 },
+		.Weight = { (half_size - static_cast<float32>(dst_index)) * inv_size, half_size * inv_size,
+					static_cast<float32>(dst_index + 1) * inv_size },
+		.Count = 3,
+	};
+}
+
+/**
+ * Tables to convert each channel of a pixel to linear floating point, indexed by `(channel * 256) + value`.
+ */
+struct DecodeTables
+{
+	DecodeTables()
+	{
+		for (uint32 value = 0; value < 256; value++) {
+			const float32 unorm = static_cast<float32>(value) / 255.0f;
+
+			const float32 linear = (unorm <= 0.04045f) ? unorm / 12.92f : powf((unorm + 0.055f) / 1.055f, 2.4f);
+
+			for (uint32 channel = 0; channel < scPixelSize; channel++) {
+				Linear[(channel * 256) + value] = unorm;
+				Srgb[(channel * 256) + value] = (channel < 3) ? linear : unorm;
+			}
+		}
+	}
+
+	float32 Linear[scPixelSize * 256];
+	float32 Srgb[scPixelSize * 256];
+};
+
+static const float32* GetDecodeTable(eColorSpace color_space)
+{
+	static const DecodeTables sTables;
+
+	return (color_space == eColorSpace::Srgb) ? sTables.Srgb : sTables.Linear;
+}
+
+/**
+ * Bias and scale for linear to sRGB conversion, for every 8 steps of the mantissa from 2^-13 to one. Values are
+ * converted by linear interpolation within each step, which rounds to the correct 8-bit value.
+ *
+ * From https://gist.github.com/rygorous/2203834 (public domain), as used by stb_image_resize2.
+ */
+alignas(64) static const uint32 scLinearToSrgbTable[104] = {
+	0x0073000d, 0x007a000d, 0x0080000d, 0x0087000d, 0x008d000d, 0x0094000d, 0x009a000d, 0x00a1000d, 0x00a7001a,
+	0x00b4001a, 0x00c1001a, 0x00ce001a, 0x00da001a, 0x00e7001a, 0x00f4001a, 0x0101001a, 0x010e0033, 0x01280033,
+	0x01410033, 0x015b0033, 0x01750033, 0x018f0033, 0x01a80033, 0x01c20033, 0x01dc0067, 0x020f0067, 0x02430067,
+	0x02760067, 0x02aa0067, 0x02dd0067, 0x03110067, 0x03440067, 0x037800ce, 0x03df00ce, 0x044600ce, 0x04ad00ce,
+	0x051400ce, 0x057b00c5, 0x05dd00bc, 0x063b00b5, 0x06970158, 0x07420142, 0x07e30130, 0x087b0120, 0x090b0112,
+	0x09940106, 0x0a1700fc, 0x0a9500f2, 0x0b0f01cb, 0x0bf401ae, 0x0ccb0195, 0x0d950180, 0x0e56016e, 0x0f0d015e,
+	0x0fbc0150, 0x10630143, 0x11070264, 0x1238023e, 0x1357021d, 0x14660201, 0x156601e9, 0x165a01d3, 0x174401c0,
+	0x182401af, 0x18fe0331, 0x1a9602fe, 0x1c1502d2, 0x1d7e02ad, 0x1ed4028d, 0x201a0270, 0x21520256, 0x227d0240,
+	0x239f0443, 0x25c003fe, 0x27bf03c4, 0x29a10392, 0x2b6a0367, 0x2d1d0341, 0x2ebe031f, 0x304d0300, 0x31d105b0,
+	0x34a80555, 0x37520507, 0x39d504c5, 0x3c37048b, 0x3e7c0458, 0x40a8042a, 0x42bd0401, 0x44c20798, 0x488e071e,
+	0x4c1c06b6, 0x4f76065d, 0x52a50610, 0x55ac05cc, 0x5892058f, 0x5b590559, 0x5e0c0a23, 0x631c0980, 0x67db08f6,
+	0x6c55087f, 0x70940818, 0x74a007bd, 0x787d076c, 0x7c330723,
+};
+
+/// Values at or below 2^-13 encode to zero, and values above this encode to 255.
+static constexpr uint32 scSrgbMinBits = (127 - 13) << 23;
+static constexpr uint32 scSrgbAlmostOneBits = 0x3F7FFFFF;
+
+static FX_FORCE_INLINE uint8 LinearToSrgb8(float32 value)
+{
+	uint32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	// Written so that NaN encodes to zero
+	if (!(bits > scSrgbMinBits && value > 0.0f)) {
+		return 0;
+	}
+	if (bits > scSrgbAlmostOneBits) {
+		return 255;
+	}
+
+	const uint32 entry = scLinearToSrgbTable[(bits - scSrgbMinBits) >> 20];
+
+	const uint32 bias = (entry >> 16) << 9;
+	const uint32 scale = entry & 0xFFFF;
+	const uint32 step = (bits >> 12) & 0xFF;
+
+	return static_cast<uint8>((bias + (scale * step)) >> 16);
+}
+
+static FX_FORCE_INLINE uint8 LinearToUnorm8(float32 value)
+{
+	value = std::clamp(value, 0.0f, 1.0f);
+
+	return static_cast<uint8>((value * 255.0f) + 0.5f);
+}
+
+/**
+ * Adds each channel of `pixel_count` pixels from `src`, converted to linear with `table` (see `DecodeTables`) and
+ * multiplied by `weight`, to `accum`.
+ */
+using AccumulateRowFn = void (*)(const uint8* src, float32 weight, const float32* table, float32* accum,
+								 uint32 pixel_count);
+
+/**
+ * Filters a row of linear pixels from `AccumulateRowFn` horizontally into `dst_width` pixels and encodes them to
+ * 8-bit. The RGB channels are encoded to sRGB when `srgb` is true.
+ */
+using EncodeRowFn = void (*)(const float32* accum, uint32 src_width, uint8* dst, uint32 dst_width, bool srgb);
+
+static void AccumulateRow_Scalar(const uint8* src, float32 weight, const float32* table, float32* accum,
+								 uint32 pixel_count)
+{
+	for (uint32 i = 0; i < pixel_count * scPixelSize; i++) {
+		accum[i] += table[((i % scPixelSize) * 256) + src[i]] * weight;
+	}
+}
+
+static void EncodeRow_Scalar(const float32* accum, uint32 src_width, uint8* dst, uint32 dst_width, bool srgb)
+{
+	for (uint32 x = 0; x < dst_width; x++) {
+		const FilterTaps taps = GetFilterTaps(x, src_width);
+
+		for (uint32 c = 0; c < scPixelSize; c++) {
+			const float32 a = accum[(taps.Index[0] * scPixelSize) + c];
+			const float32 b = accum[(taps.Index[1] * scPixelSize) + c];
+
+			float32 value = a;
+
+			if (taps.Count == 2) {
+				value = (a + b) * 0.5f;
+			}
+			else if (taps.Count == 3) {
+				const float32 d = accum[(taps.Index[2] * scPixelSize) + c];
+				value = ((a * taps.Weight[0]) + (b * taps.Weight[1])) + (d * taps.Weight[2]);
+			}
+
+			dst[(x * scPixelSize) + c] = (srgb && c < 3) ? LinearToSrgb8(value) : LinearToUnorm8(value);
+		}
+	}
+}
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+/// Converts four channels to 8-bit values in 32-bit lanes, encoding lanes 0-2 to sRGB when `srgb` is true.
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128i EncodePixel_SSE4(__m128 value, bool srgb)
+{
+	const __m128 clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+	const __m128i unorm = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+
+	if (!srgb) {
+		return unorm;
+	}
+
+	// Out of range values (and NaN, as max returns the second operand) are clamped to the ends of the table
+	const __m128 min_value = _mm_castsi128_ps(_mm_set1_epi32(scSrgbMinBits));
+	const __m128 almost_one = _mm_castsi128_ps(_mm_set1_epi32(scSrgbAlmostOneBits));
+
+	const __m128i bits = _mm_castps_si128(_mm_min_ps(_mm_max_ps(value, min_value), almost_one));
+	const __m128i index = _mm_srli_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(scSrgbMinBits)), 20);
+
+	const __m128i entry = _mm_setr_epi32(
+		scLinearToSrgbTable[_mm_extract_epi32(index, 0)], scLinearToSrgbTable[_mm_extract_epi32(index, 1)],
+		scLinearToSrgbTable[_mm_extract_epi32(index, 2)], scLinearToSrgbTable[_mm_extract_epi32(index, 3)]);
+
+	const __m128i bias = _mm_slli_epi32(_mm_srli_epi32(entry, 16), 9);
+	const __m128i scale = _mm_and_si128(entry, _mm_set1_epi32(0xFFFF));
+	const __m128i step = _mm_and_si128(_mm_srli_epi32(bits, 12), _mm_set1_epi32(0xFF));
+
+	const __m128i encoded = _mm_srli_epi32(_mm_add_epi32(bias, _mm_mullo_epi32(scale, step)), 16);
+
+	// Alpha stays linear
+	return _mm_blend_epi16(encoded, unorm, 0xC0);
+}
+
+FX_TARGET_SSE4 static FX_FORCE_INLINE void StorePixel_SSE4(uint8* dst, __m128i channels)
+{
+	const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(channels, channels), _mm_setzero_si128());
+	const int32 pixel = _mm_cvtsi128_si32(packed);
+
+	memcpy(dst, &pixel, sizeof(pixel));
+}
+
+/// Filters the destination pixel at `x` from the accumulated row.
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128 FilterPixel_SSE4(const float32* accum, uint32 src_width, uint32 x)
+{
+	const FilterTaps taps = GetFilterTaps(x, src_width);
+
+	const __m128 a = _mm_loadu_ps(accum + (taps.Index[0] * scPixelSize));
+
+	if (taps.Count == 1) {
+		return a;
+	}
+
+	const __m128 b = _mm_loadu_ps(accum + (taps.Index[1] * scPixelSize));
+
+	if (taps.Count == 2) {
+		return _mm_mul_ps(_mm_add_ps(a, b), _mm_set1_ps(0.5f));
+	}
+
+	const __m128 d = _mm_loadu_ps(accum + (taps.Index[2] * scPixelSize));
+
+	const __m128 ab = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(taps.Weight[0])), _mm_mul_ps(b, _mm_set1_ps(taps.Weight[1])));
+
+	return _mm_add_ps(ab, _mm_mul_ps(d, _mm_set1_ps(taps.Weight[2])));
+}
+
+FX_TARGET_SSE4 static void AccumulateRow_SSE4(const uint8* src, float32 weight, const float32* table, float32* accum,
+											  uint32 pixel_count)
+{
+	const __m128 weights = _mm_set1_ps(weight);
+
+	for (uint32 x = 0; x < pixel_count; x++) {
+		const uint8* pixel = src + (x * scPixelSize);
+		float32* out = accum + (x * scPixelSize);
+
+		const __m128 decoded = _mm_setr_ps(table[pixel[0]], table[256 + pixel[1]], table[512 + pixel[2]],
+										   table[768 + pixel[3]]);
+
+		_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(decoded, weights)));
+	}
+}
+
+FX_TARGET_SSE4 static void EncodeRow_SSE4(const float32* accum, uint32 src_width, uint8* dst, uint32 dst_width,
+										  bool srgb)
+{
+	for (uint32 x = 0; x < dst_width; x++) {
+		StorePixel_SSE4(dst + (x * scPixelSize), EncodePixel_SSE4(FilterPixel_SSE4(accum, src_width, x), srgb));
+	}
+}
+
+FX_TARGET_AVX2 static void AccumulateRow_AVX2(const uint8* src, float32 weight, const float32* table, float32* accum,
+											  uint32 pixel_count)
+{
+	const __m256 weights = _mm256_set1_ps(weight);
+	const __m256i channel_offsets = _mm256_setr_epi32(0, 256, 512, 768, 0, 256, 512, 768);
+
+	// Two pixels per iteration
+	uint32 x = 0;
+
+	for (; x + 2 <= pixel_count; x += 2) {
+		const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (x * scPixelSize)));
+		const __m256i indices = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), channel_offsets);
+
+		const __m256 decoded = _mm256_i32gather_ps(table, indices, sizeof(float32));
+
+		float32* out = accum + (x * scPixelSize);
+
+		// Not fused, so that each tier gives the same result
+		_mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), _mm256_mul_ps(decoded, weights)));
+	}
+
+	AccumulateRow_SSE4(src + (x * scPixelSize), weight, table, accum + (x * scPixelSize), pixel_count - x);
+}
+
+FX_TARGET_AVX2 static void EncodeRow_AVX2(const float32* accum, uint32 src_width, uint8* dst, uint32 dst_width,
+										  bool srgb)
+{
+	uint32 x = 0;
+
+	// Two destination pixels per iteration when each is the average of two source pixels
+	if ((src_width & 1) == 0) {
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 unorm_scale = _mm256_set1_ps(255.0f);
+		const __m256 min_value = _mm256_castsi256_ps(_mm256_set1_epi32(scSrgbMinBits));
+		const __m256 almost_one = _mm256_castsi256_ps(_mm256_set1_epi32(scSrgbAlmostOneBits));
+
+		for (; x + 2 <= dst_width; x += 2) {
+			const __m256 pixels01 = _mm256_loadu_ps(accum + (x * 2 * scPixelSize));
+			const __m256 pixels23 = _mm256_loadu_ps(accum + (x * 2 * scPixelSize) + 8);
+
+			// (p0, p2) + (p1, p3)
+			const __m256 even = _mm256_permute2f128_ps(pixels01, pixels23, 0x20);
+			const __m256 odd = _mm256_permute2f128_ps(pixels01, pixels23, 0x31);
+
+			const __m256 value = _mm256_mul_ps(_mm256_add_ps(even, odd), half);
+
+			const __m256 clamped = _mm256_min_ps(_mm256_max_ps(value, zero), one);
+			__m256i channels = _mm256_cvttps_epi32(
+				_mm256_add_ps(_mm256_mul_ps(clamped, unorm_scale), _mm256_set1_ps(0.5f)));
+
+			if (srgb) {
+				const __m256i bits = _mm256_castps_si256(_mm256_min_ps(_mm256_max_ps(value, min_value), almost_one));
+				const __m256i index = _mm256_srli_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(scSrgbMinBits)), 20);
+
+				const __m256i entry = _mm256_i32gather_epi32(reinterpret_cast<const int32*>(scLinearToSrgbTable),
+															 index, sizeof(uint32));
+
+				const __m256i bias = _mm256_slli_epi32(_mm256_srli_epi32(entry, 16), 9);
+				const __m256i scale = _mm256_and_si256(entry, _mm256_set1_epi32(0xFFFF));
+				const __m256i step = _mm256_and_si256(_mm256_srli_epi32(bits, 12), _mm256_set1_epi32(0xFF));
+
+				const __m256i encoded = _mm256_srli_epi32(_mm256_add_epi32(bias, _mm256_mullo_epi32(scale, step)), 16);
+
+				// Alpha stays linear
+				channels = _mm256_blend_epi32(encoded, channels, 0x88);
+			}
+
+			// Each 128-bit lane packs down to one pixel in its lowest four bytes
+			const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(channels, channels), _mm256_setzero_si256());
+
+			const int32 pixels[2] = {
+				_mm_cvtsi128_si32(_mm256_castsi256_si128(packed)),
+				_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)),
+			};
+
+			memcpy(dst + (x * scPixelSize), pixels, sizeof(pixels));
+		}
+	}
+
+	for (; x < dst_width; x++) {
+		StorePixel_SSE4(dst + (x * scPixelSize), EncodePixel_SSE4(FilterPixel_SSE4(accum, src_width, x), srgb));
+	}
+}
+
+#endif
+
+struct FloatRowKernels
+{
+	AccumulateRowFn Accumulate;
+	EncodeRowFn Encode;
+};
+
+static const FloatRowKernels& GetFloatRowKernels()
+{
+	static const FloatRowKernels sKernels = []() -> FloatRowKernels
+	{
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+		const eCpuTier tier = CpuFeatures::GetInstance().GetTier();
+
+		if (tier >= eCpuTier::AVX2) {
+			return FloatRowKernels { AccumulateRow_AVX2, EncodeRow_AVX2 };
+		}
+		if (tier >= eCpuTier::SSE4) {
+			return FloatRowKernels { AccumulateRow_SSE4, EncodeRow_SSE4 };
+		}
+#endif
+		return FloatRowKernels { AccumulateRow_Scalar, EncodeRow_Scalar };
+	}();
+
+	return sKernels;
+}
+
+///////////////////////////////
+// Downsampling
+///////////////////////////////
+
+void DownsampleBox4x8(const uint8* src, const Vec2u& src_size, uint8* dst, eColorSpace color_space)
+{
+	const Vec2u dst_size = GetHalfSize(src_size);
+
+	const uint32 src_stride = src_size.X * scPixelSize;
+	const uint32 dst_stride = dst_size.X * scPixelSize;
+
+	const bool is_odd_x = (src_size.X > 1) && (src_size.X & 1);
+	const bool is_odd_y = (src_size.Y > 1) && (src_size.Y & 1);
+
+	const bool use_float_filter = (color_space == eColorSpace::Srgb) || is_odd_x || is_odd_y;
+
+	auto downsample_rows_8bit = [&](uint32 start_y, uint32 end_y)
+	{
+		const DownsampleRowFn downsample_row = GetDownsampleRow();
+
+		for (uint32 y = start_y; y < end_y; y++) {
+			const uint8* src_row = src + (static_cast<uint64>(y) * 2 * src_stride);
+
+			// Clamp to the last row (and column below) when the source is only one pixel tall or wide
+			const uint8* src_next = (src_size.Y > 1) ? src_row + src_stride : src_row;
+
+			uint8* dst_row = dst + (static_cast<uint64>(y) * dst_stride);
+
+			if (src_size.X > 1) {
+				downsample_row(src_row, src_next, dst_row, 0, dst_size.X);
+			}
+			else {
+				DownsamplePixels(src_row, src_next, dst_row, 0, dst_size.X, 0);
+			}
+		}
+	};
+
+	auto downsample_rows_float = [&](uint32 start_y, uint32 end_y)
+	{
+		const FloatRowKernels& kernels = GetFloatRowKernels();
+		const float32* table = GetDecodeTable(color_space);
+
+		// The source rows for each destination row are filtered vertically into `accum`, which is then filtered
+		// horizontally and encoded.
+		SizedArray<float32> accum;
+		accum.InitSize(src_stride);
+
+		for (uint32 y = start_y; y < end_y; y++) {
+			const FilterTaps taps = GetFilterTaps(y, src_size.Y);
+
+			memset(accum.pData, 0, accum.GetSizeInBytes());
+
+			for (uint32 i = 0; i < taps.Count; i++) {
+				const uint8* src_row = src + (static_cast<uint64>(taps.Index[i]) * src_stride);
+				kernels.Accumulate(src_row, taps.Weight[i], table, accum.pData, src_size.X);
+			}
+
+			kernels.Encode(accum.pData, src_size.X, dst + (static_cast<uint64>(y) * dst_stride), dst_size.X,
+						   color_space == eColorSpace::Srgb);
+		}
+	};
+
+	const JobRangeFunction downsample_rows = use_float_filter ? JobRangeFunction(downsample_rows_float)
+															  : JobRangeFunction(downsample_rows_8bit);
+
+	if (gJobSystem) {
+		gJobSystem->ParallelFor(dst_size.Y, std::max(1U, scPixelsPerJob / dst_size.X), downsample_rows);
+	}
+	else {
+		downsample_rows(0, dst_size.Y);
+	}
+}
+
+} // namespace fx::ImageResample
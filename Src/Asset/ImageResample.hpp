@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <Math/Vec2.hpp>
+#include <algorithm>
+
+namespace fx::ImageResample {
+
+/**
+ * @brief Returns the size of the next mip level below `size`, halving each side (rounded down) to a minimum of one.
+ */
+FX_FORCE_INLINE Vec2u GetHalfSize(const Vec2u& size)
+{
+	return Vec2u(std::max(1U, size.X / 2), std::max(1U, size.Y / 2));
+}
+
+/**
+ * @brief How the colour channels of an image are encoded. Alpha is always stored linearly.
+ */
+enum class eColorSpace
+{
+	Linear,
+
+	/// The RGB channels are sRGB encoded. They are converted to linear before filtering and back to sRGB after, so
+	/// that mips do not darken.
+	Srgb,
+};
+
+/**
+ * @brief Halves an image of four 8-bit channels by averaging each 2x2 block of pixels into one. The destination must
+ * have room for `GetHalfSize(src_size)` pixels.
+ *
+ * Sides with an odd number of pixels are filtered with three taps, where each destination pixel covers `(2n + 1) / n`
+ * source pixels weighted by how much of each it overlaps, so that no row or column of the source is dropped.
+ *
+ * Channels are filtered independently, so this works for any four channel 8-bit format. Linear images with even sides
+ * are averaged in 8-bit, everything else is filtered in floating point. Large images are split across the job system
+ * by rows. On x86-64 the implementation is chosen for the host CPU on first use (see `CpuFeatures`).
+ */
+void DownsampleBox4x8(const uint8* src, const Vec2u& src_size, uint8* dst,
+					  eColorSpace color_space = eColorSpace::Linear);
+
+} // namespace fx::ImageResample
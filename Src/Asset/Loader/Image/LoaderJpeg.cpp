@@ -7,6 +7,7 @@
 #include <Core/Memory.hpp>
 #include <Core/Ref.hpp>
 #include <Renderer/Backend/RenderBackendFwd.hpp>
+#include <algorithm>
 
 namespace fx {
 
@@ -27,10 +28,72 @@ static constexpr J_COLOR_SPACE GetJpegColorspaceForFormat(eImageFormat format)
 }
 
 
-eLoaderStatus LoaderJpeg::Load(AssetTicket& ticket, const std::string& path)
+static uint32 GetScaleDenom(uint32 mip_level)
+{
+	return 1U << std::min(mip_level, LoaderJpeg::scMaxScaledMipLevel);
+}
+
+
+bool LoaderJpeg::StartDecompress(jpeg_decompress_struct& jpeg_info, eImageFormat format, uint32 mip_level)
+{
+	if (jpeg_read_header(&jpeg_info, true) != JPEG_HEADER_OK) {
+		return false;
+	}
+
+	jpeg_info.out_color_space = GetJpegColorspaceForFormat(format);
+
+	// Scale in the DCT domain, which is much faster than decoding the full image and downsampling it
+	jpeg_info.scale_num = 1;
+	jpeg_info.scale_denom = GetScaleDenom(mip_level);
+
+	jpeg_start_decompress(&jpeg_info);
+
+	return true;
+}
+
+void LoaderJpeg::ReadScanlines(jpeg_decompress_struct& jpeg_info, uint8* dst, uint32 dst_row_stride)
+{
+	JSAMPROW rows[scMaxRowsPerRead];
+
+	// libjpeg can output `rec_outbuf_height` rows at once when upsampling, so read that many rows per call
+	const uint32 rows_per_read = std::clamp(static_cast<uint32>(jpeg_info.rec_outbuf_height), 1U, scMaxRowsPerRead);
+
+	while (jpeg_info.output_scanline < jpeg_info.output_height) {
+		const uint32 row_count = std::min(rows_per_read, jpeg_info.output_height - jpeg_info.output_scanline);
+
+		for (uint32 i = 0; i < row_count; i++) {
+			rows[i] = dst + (static_cast<uint64>(dst_row_stride) * (jpeg_info.output_scanline + i));
+		}
+
+		jpeg_read_scanlines(&jpeg_info, rows, row_count);
+	}
+}
+
+eLoaderStatus LoaderJpeg::DecodeToStaging(AssetTicket& ticket)
 {
 	Image* image = static_cast<Image*>(ticket.Get());
 
+	if (!StartDecompress(mJpegInfo, ImageFormat, MipLevel)) {
+		LogError(LC_ASSET, "Could not read JPEG header");
+		return eLoaderStatus::Error;
+	}
+
+	image->Info.Size = Vec2u { mJpegInfo.output_width, mJpegInfo.output_height };
+
+	const uint32 row_stride = mJpegInfo.output_width * mJpegInfo.output_components;
+	Slice<uint8> staging_span = RequestStagingSpan(static_cast<uint64>(row_stride) * mJpegInfo.output_height);
+
+	ReadScanlines(mJpegInfo, staging_span.pData, row_stride);
+	mStagingBuffer.FlushToGpu(0, staging_span.Size);
+
+	jpeg_finish_decompress(&mJpegInfo);
+
+	return eLoaderStatus::Success;
+}
+
+
+eLoaderStatus LoaderJpeg::Load(AssetTicket& ticket, const std::string& path)
+{
 	const char* c_path = path.c_str();
 
 	FILE* fp = fopen(c_path, "rb");
@@ -46,40 +109,16 @@ eLoaderStatus LoaderJpeg::Load(AssetTicket& ticket, const std::string& path)
 	jpeg_create_decompress(&mJpegInfo);
 
 	jpeg_stdio_src(&mJpegInfo, fp);
-	jpeg_read_header(&mJpegInfo, true);
-
-	mJpegInfo.out_color_space = GetJpegColorspaceForFormat(ImageFormat);
 
-	jpeg_start_decompress(&mJpegInfo);
-
-	int32 num_jpeg_components = mJpegInfo.output_components;
-
-	printf("Read jpeg, [width=%u, height=%u]\n", mJpegInfo.output_width, mJpegInfo.output_height);
-	image->Info.Size = Vec2u { mJpegInfo.output_width, mJpegInfo.output_height };
-
-	uint32 data_size = mJpegInfo.output_width * mJpegInfo.output_height * num_jpeg_components;
-	mImageData.InitSize(data_size);
-
-	const uint32 row_stride = num_jpeg_components * mJpegInfo.output_width;
-
-	uint8* ptr_list[1] = { nullptr };
-
-	while (mJpegInfo.output_scanline < mJpegInfo.output_height) {
-		ptr_list[0] = (mImageData.pData + (row_stride * mJpegInfo.output_scanline));
-		jpeg_read_scanlines(&mJpegInfo, ptr_list, 1);
-	}
-
-	jpeg_finish_decompress(&mJpegInfo);
+	const eLoaderStatus status = DecodeToStaging(ticket);
 
 	fclose(fp);
 
-	return eLoaderStatus::Success;
+	return status;
 }
 
 eLoaderStatus LoaderJpeg::Load(AssetTicket& ticket, const uint8* data, uint32 size)
 {
-	Image* image = static_cast<Image*>(ticket.Get());
-
 	struct jpeg_error_mgr error_mgr;
 
 	mJpegInfo.err = jpeg_std_error(&error_mgr);
@@ -88,42 +127,73 @@ eLoaderStatus LoaderJpeg::Load(AssetTicket& ticket, const uint8* data, uint32 si
 	Assert(data != nullptr);
 
 	jpeg_mem_src(&mJpegInfo, data, size);
-	jpeg_read_header(&mJpegInfo, true);
 
-	const uint32 num_components = ImageFormatUtil::GetPixelStride(ImageFormat);
+	return DecodeToStaging(ticket);
+}
 
-	J_COLOR_SPACE color_space = GetJpegColorspaceForFormat(ImageFormat);
-	mJpegInfo.out_color_space = color_space;
+Vec2u LoaderJpeg::GetDecodedSize(const uint8* data, uint32 size, uint32 mip_level)
+{
+	Assert(data != nullptr);
 
-	jpeg_start_decompress(&mJpegInfo);
-	image->Info.Size = Vec2u { mJpegInfo.output_width, mJpegInfo.output_height };
+	struct jpeg_decompress_struct jpeg_info;
+	struct jpeg_error_mgr error_mgr;
 
-	uint32 data_size = mJpegInfo.output_width * mJpegInfo.output_height * num_components;
-	mImageData.InitSize(data_size);
+	jpeg_info.err = jpeg_std_error(&error_mgr);
+	jpeg_create_decompress(&jpeg_info);
 
-	const uint32 row_stride = num_components * mJpegInfo.output_width;
+	jpeg_mem_src(&jpeg_info, data, size);
 
-	uint8* ptr_list[1] = { nullptr };
+	Vec2u decoded_size = Vec2u::sZero;
 
-	while (mJpegInfo.output_scanline < mJpegInfo.output_height) {
-		ptr_list[0] = (mImageData.pData + (row_stride * mJpegInfo.output_scanline));
-		jpeg_read_scanlines(&mJpegInfo, ptr_list, 1);
+	if (jpeg_read_header(&jpeg_info, true) == JPEG_HEADER_OK) {
+		jpeg_info.scale_num = 1;
+		jpeg_info.scale_denom = GetScaleDenom(mip_level);
+
+		// Computes the output size without decoding anything
+		jpeg_calc_output_dimensions(&jpeg_info);
+
+		decoded_size = Vec2u { jpeg_info.output_width, jpeg_info.output_height };
 	}
 
-	jpeg_finish_decompress(&mJpegInfo);
+	jpeg_destroy_decompress(&jpeg_info);
 
-	return eLoaderStatus::Success;
+	return decoded_size;
+}
+
+bool LoaderJpeg::DecodeInto(const uint8* data, uint32 size, eImageFormat format, uint32 mip_level, uint8* dst,
+							uint32 dst_row_stride)
+{
+	Assert(data != nullptr && dst != nullptr);
+
+	struct jpeg_decompress_struct jpeg_info;
+	struct jpeg_error_mgr error_mgr;
+
+	jpeg_info.err = jpeg_std_error(&error_mgr);
+	jpeg_create_decompress(&jpeg_info);
+
+	jpeg_mem_src(&jpeg_info, data, size);
+
+	const bool is_started = StartDecompress(jpeg_info, format, mip_level);
+
+	if (is_started) {
+		Assert(dst_row_stride >= jpeg_info.output_width * jpeg_info.output_components);
+
+		ReadScanlines(jpeg_info, dst, dst_row_stride);
+		jpeg_finish_decompress(&jpeg_info);
+	}
+
+	jpeg_destroy_decompress(&jpeg_info);
+
+	return is_started;
 }
 
 void LoaderJpeg::CreateGpuResource(AssetTicket& ticket)
 {
 	Image* image = static_cast<Image*>(ticket.Get());
 
-	ImageInfo image_info { image->Info.Size, ImageFormat, 0, 1,
-						   MakeSlice<const uint8>(mImageData.pData, mImageData.Size) };
-
-	// Pass all flags that are not KeepInMemory. We will instead move the data over to avoid the copy.
-	image->CreateFromData(renderer::RenderBackendFwd::GetUploadCmd(), image_info, (CreationFlags));
+	// The pixels were decoded straight into the staging buffer
+	ImageInfo image_info { image->Info.Size, ImageFormat, 0, 1, Slice<const uint8>(nullptr) };
+	image->CreateFromBuffer(renderer::RenderBackendFwd::GetUploadCmd(), image_info, mStagingBuffer);
 
 	ticket.SignalUploadedToGpu();
 }
@@ -4,7 +4,6 @@
 
 #include <TurboJPEG/jpeglib.h>
 
-#include <Core/SizedArray.hpp>
 #include <Core/Types.hpp>
 
 namespace fx {
@@ -13,6 +12,14 @@ namespace loader {
 
 class LoaderJpeg : public ImageLoaderBase
 {
+public:
+	/// The finest mip level that libjpeg can decode to directly. Images are scaled by 1/2, 1/4 or 1/8 in the DCT
+	/// domain, which skips most of the work of decoding the full image.
+	static constexpr uint32 scMaxScaledMipLevel = 3;
+
+	/// The most rows that are read with each call to `jpeg_read_scanlines()`.
+	static constexpr uint32 scMaxRowsPerRead = 16;
+
 public:
 	LoaderJpeg() = default;
 
@@ -21,13 +28,49 @@ public:
 
 	void CreateGpuResource(AssetTicket& ticket) override;
 
+	/**
+	 * @brief Returns the size that a JPEG in memory decodes to at `mip_level`, or a zero size if the header cannot be
+	 * read. Scaled sizes are rounded up, so they can be a pixel larger than the same level of a mip chain.
+	 */
+	static Vec2u GetDecodedSize(const uint8* data, uint32 size, uint32 mip_level);
+
+	/**
+	 * @brief Decodes a JPEG in memory at the scale for `mip_level` straight into `dst`, such as a mapped staging
+	 * buffer.
+	 *
+	 * @param dst The destination, with room for `dst_row_stride` bytes for each row of `GetDecodedSize()`.
+	 * @param dst_row_stride The number of bytes between the start of each row in `dst`.
+	 * @returns False if the header cannot be read.
+	 */
+	static bool DecodeInto(const uint8* data, uint32 size, eImageFormat format, uint32 mip_level, uint8* dst,
+						   uint32 dst_row_stride);
+
 	void Destroy() override;
 
 	~LoaderJpeg() override = default;
 
+private:
+	/**
+	 * @brief Reads the header and starts decompressing at the scale for `mip_level`. The source must already be set.
+	 */
+	static bool StartDecompress(jpeg_decompress_struct& jpeg_info, eImageFormat format, uint32 mip_level);
+
+	/**
+	 * @brief Reads every remaining row into `dst`, `jpeg_info.rec_outbuf_height` rows at a time.
+	 */
+	static void ReadScanlines(jpeg_decompress_struct& jpeg_info, uint8* dst, uint32 dst_row_stride);
+
+	/**
+	 * @brief Decodes the image straight into a staging buffer from `RequestStagingSpan()`.
+	 */
+	eLoaderStatus DecodeToStaging(AssetTicket& ticket);
+
+public:
+	/// The mip level to decode the image at. Levels past `scMaxScaledMipLevel` are decoded at that level.
+	uint32 MipLevel = 0;
+
 private:
 	struct jpeg_decompress_struct mJpegInfo;
-	SizedArray<uint8> mImageData;
 };
 
 } // namespace loader
@@ -23,12 +23,14 @@ eLoaderStatus LoaderStb::Load(AssetTicket& ticket, const std::string& path)
 	uint32 data_size = mWidth * mHeight * pixel_size;
 	mDataSize = data_size;
 
-	mImageData = stbi_load(c_path, &mWidth, &mHeight, &mChannels, pixel_size);
-	if (mImageData == nullptr) {
+	uint8* pixels = stbi_load(c_path, &mWidth, &mHeight, &mChannels, pixel_size);
+	if (pixels == nullptr) {
 		LogError(LC_ASSET, "Could not load image file at '{}'", path);
 		return eLoaderStatus::Error;
 	}
 
+	MoveToStaging(pixels);
+
 	return eLoaderStatus::Success;
 }
 
@@ -54,16 +56,30 @@ eLoaderStatus LoaderStb::Load(AssetTicket& ticket, const uint8* data, uint32 siz
 
 	image->Info.Size = Vec2u { uint32(mWidth), uint32(mHeight) };
 
-	mImageData = stbi_load_from_memory(data, size, &mWidth, &mHeight, &mChannels, pixel_size);
+	uint8* pixels = stbi_load_from_memory(data, size, &mWidth, &mHeight, &mChannels, pixel_size);
 
-	if (mImageData == nullptr) {
+	if (pixels == nullptr) {
 		LogError(LC_ASSET, "Could not load image file from memory!");
 		return eLoaderStatus::Error;
 	}
 
+	MoveToStaging(pixels);
+
 	return eLoaderStatus::Success;
 }
 
+void LoaderStb::MoveToStaging(uint8* pixels)
+{
+	// stb can only decode into memory that it allocates, so this is copied once here on the loading thread. This
+	// keeps the copy off the upload, which only has to record the transfer.
+	Slice<uint8> staging_span = RequestStagingSpan(mDataSize);
+
+	memcpy(staging_span.pData, pixels, mDataSize);
+	mStagingBuffer.FlushToGpu(0, mDataSize);
+
+	stbi_image_free(pixels);
+}
+
 
 eLoaderStatus LoaderStb::SaveToFile(eImageSaveFormat file_format, const Slice<uint8>& data, const Vec2u& size,
 									const String& path, eImageSaveFlags flags)
@@ -87,23 +103,8 @@ void LoaderStb::CreateGpuResource(AssetTicket& ticket)
 {
 	Image* image = static_cast<Image*>(ticket.Get());
 
-	SizedArray<uint8> data_arr;
-
-	// Since the image data in mImageData is not ours(it is stb's),
-	// we need to set this flag to prevent it from attemping to be freed.
-
-	data_arr.pData = mImageData;
-	data_arr.Size = mDataSize;
-	data_arr.Capacity = mDataSize;
-
-	// const bool should_save_data = (CreationFlags & eImageCreateFlags::KeepInMemory) != 0;
-
-	// Pass all flags that are not KeepInMemory. We will instead move the data over to avoid the copy.
-	ImageInfo image_info { image->Info.Size, ImageFormat, 0, 1, Slice<const uint8>(data_arr.pData, data_arr.Size) };
-	image->CreateFromData(renderer::RenderBackendFwd::GetUploadCmd(), image_info, (CreationFlags));
-
-	// Set to nullptr so that the data is not freed by the SizedArray
-	data_arr.pData = nullptr;
+	ImageInfo image_info { image->Info.Size, ImageFormat, 0, 1, Slice<const uint8>(nullptr) };
+	image->CreateFromBuffer(renderer::RenderBackendFwd::GetUploadCmd(), image_info, mStagingBuffer);
 
 	ticket.SignalUploadedToGpu();
 }
@@ -143,9 +144,7 @@ void LoaderStb::Destroy()
 	//     asset->bIsUploadedToGpu.wait(true);
 	// }
 
-	if (mImageData != nullptr) {
-		stbi_image_free(mImageData);
-	}
+	// The staging buffer is destroyed with the loader, once the upload has been submitted
 }
 
 } // namespace loader
@@ -24,24 +24,27 @@ public:
 	static eLoaderStatus SaveToFile(eImageSaveFormat format, const Slice<uint8>& data, const Vec2u& size,
 									const String& path, eImageSaveFlags flags);
 
-	Slice<uint8> GetImageData() const { return Slice(mImageData, mDataSize); }
+	Slice<uint8> GetImageData() const { return Slice(static_cast<uint8*>(mStagingBuffer.pMappedBuffer), mDataSize); }
 	Vec2u GetImageSize() const { return Vec2u(mWidth, mHeight); };
 
 	void Destroy() override;
-	void InvalidateImageData() { mImageData = nullptr; };
 
 	~LoaderStb() override = default;
 
 private:
 	void LoadCubemapToLayeredImage();
 
+	/**
+	 * @brief Moves the pixels that stb decoded into a staging buffer and frees them.
+	 */
+	void MoveToStaging(uint8* pixels);
+
 private:
 	int mWidth = 0;
 	int mHeight = 0;
 	int mChannels = 0;
 
 	uint32 mDataSize = 0;
-	uint8* mImageData = nullptr;
 };
 
 } // namespace loader
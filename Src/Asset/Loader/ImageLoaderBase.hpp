@@ -26,10 +26,27 @@ public:
 
 	~ImageLoaderBase() override = default;
 
+protected:
+	/**
+	 * @brief Creates a mapped staging buffer with room for `size` bytes of pixels, for the loader to decode into. The
+	 * image is created from the staging buffer in `CreateGpuResource()`, so the pixels are only copied by the GPU.
+	 */
+	Slice<uint8> RequestStagingSpan(uint64 size)
+	{
+		mStagingBuffer.Create(renderer::eGpuBufferType::Transfer, size, VMA_MEMORY_USAGE_CPU_TO_GPU,
+							  eGpuBufferFlags::PersistentMapped);
+
+		return Slice<uint8>(static_cast<uint8*>(mStagingBuffer.pMappedBuffer), size);
+	}
+
 public:
 	eImageType ImageType = eImageType::Flat;
 	eImageFormat ImageFormat = eImageFormat::None;
 	eImageCreateFlags CreationFlags = eImageCreateFlags::None;
+
+protected:
+	/// Destroyed with the loader, through the asset manager's deletion queue so the upload can finish first.
+	renderer::RawGpuBuffer mStagingBuffer;
 };
 
 template <typename TLoader>
@@ -0,0 +1,272 @@
+#include "LoaderCookedMesh.hpp"
+
+#include <Asset/AssetManager.hpp>
+#include <Engine.hpp>
+#include <Material/Material.hpp>
+#include <Material/MaterialManager.hpp>
+#include <Math/MathUtil.hpp>
+#include <Object/Object.hpp>
+#include <Object/ObjectManager.hpp>
+#include <Renderer/Backend/RenderBackendFwd.hpp>
+#include <Renderer/PipelineCache.hpp>
+
+namespace fx {
+
+using namespace renderer;
+
+namespace loader {
+
+eLoaderStatus LoaderCookedMesh::LoadFromGltf(AssetTicket& ticket, const String& path)
+{
+	mCookedMesh.Close();
+	mMeshes.clear();
+
+	mbUseGltfLoader = true;
+	mGltfLoader.bKeepInMemory = bKeepInMemory;
+
+	return mGltfLoader.Load(ticket, path);
+}
+
+bool LoaderCookedMesh::AreTextureCachesAvailable(const String& cache_dir) const
+{
+	for (const CookedMaterialInfo& material : mCookedMesh.Materials) {
+		for (Hash32 texture_cache_id : { material.DiffuseID, material.NormalMapID, material.MetallicRoughnessID }) {
+			if (texture_cache_id != HashNull32 && !LoaderGltf::IsTextureCacheAvailable(texture_cache_id, cache_dir)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool LoaderCookedMesh::StageMeshes()
+{
+	const std::vector<CookedMeshInfo>& meshes = mCookedMesh.Meshes;
+
+	uint64 staging_size = 0;
+	mMeshes.resize(meshes.size());
+
+	for (uint32 i = 0; i < meshes.size(); i++) {
+		mMeshes[i].StagingOffset = staging_size;
+		mMeshes[i].VerticesSize = meshes[i].GetVerticesSize();
+
+		staging_size += MathUtil::AlignValue<16>(meshes[i].GetDataSize());
+	}
+
+	if (staging_size == 0) {
+		return true;
+	}
+
+	mStagingBuffer.Create(eGpuBufferType::Transfer, staging_size, VMA_MEMORY_USAGE_CPU_TO_GPU,
+						  eGpuBufferFlags::PersistentMapped);
+
+	uint8* staging_data = static_cast<uint8*>(mStagingBuffer.pMappedBuffer);
+
+	for (uint32 i = 0; i < meshes.size(); i++) {
+		// The data is already in the layout that the meshes are uploaded from, so it is read straight into the
+		// staging buffer
+		const Slice<uint8> dst(staging_data + mMeshes[i].StagingOffset, meshes[i].GetDataSize());
+
+		if (!mCookedMesh.ReadMesh(i, dst)) {
+			mStagingBuffer.Destroy();
+			return false;
+		}
+	}
+
+	mStagingBuffer.FlushToGpu(0, static_cast<uint32>(staging_size));
+
+	return true;
+}
+
+void LoaderCookedMesh::MakeMaterials(const String& cache_dir)
+{
+	mMaterials.reserve(mCookedMesh.Materials.size());
+
+	for (const CookedMaterialInfo& info : mCookedMesh.Materials) {
+		const MaterialID material_id = gMaterialManager->NewMaterial(info.Name, ePipelineName::Geometry,
+																	 info.bSupportsSkinning);
+		Material* material = gMaterialManager->GetMaterial(material_id);
+
+		const std::pair<Hash32, MaterialComponent*> components[] = {
+			{ info.DiffuseID, &material->Diffuse },
+			{ info.NormalMapID, &material->NormalMap },
+			{ info.MetallicRoughnessID, &material->MetallicRoughness },
+		};
+
+		for (const auto& [texture_cache_id, component] : components) {
+			if (texture_cache_id == HashNull32) {
+				continue;
+			}
+
+			if (!LoaderGltf::LoadTextureFromCache(material, *component, texture_cache_id, cache_dir)) {
+				LogWarning(LC_ASSET, "Could not load texture cache {} for material '{}'", texture_cache_id, info.Name);
+				component->SetTicket(gAssetManager->GetNullImageTicket(component->ImageFormat));
+			}
+		}
+
+		// Diffuse components without a texture use the null image, in the same way as `LoaderGltf`
+		if (info.DiffuseID == HashNull32) {
+			material->Diffuse.SetTicket(gAssetManager->GetNullImageTicket(eImageFormat::RGBA8_UNorm));
+		}
+
+		material->Finalize();
+
+		mMaterials.push_back(material_id);
+	}
+}
+
+void LoaderCookedMesh::MakeObjects(AssetTicket& ticket)
+{
+	std::vector<CookedObjectInfo>& cooked_objects = mCookedMesh.Objects;
+
+	Object* root = static_cast<Object*>(ticket.Get());
+
+	// Objects of a glTF model are named after the root object, which is named by the caller. The cooked names are
+	// renamed to the name the model is loaded with.
+	const std::string& cooked_root_name = cooked_objects[0].Name;
+	const std::string& root_name = root->Name.Get();
+
+	for (uint32 i = 0; i < mCookedMesh.Meshes.size(); i++) {
+		const CookedMeshInfo& info = mCookedMesh.Meshes[i];
+
+		Ref<PrimitiveMesh> mesh = Ref<PrimitiveMesh>::New();
+		mesh->bKeepInMemory = bKeepInMemory;
+
+		mesh->VertexList.VertexType = info.VertexType;
+		mesh->VertexList.bContainsNormals = info.bContainsNormals;
+		mesh->VertexList.bContainsUVs = info.bContainsUVs;
+		mesh->VertexList.bContainsTangents = info.bContainsTangents;
+
+		mesh->IndexType = info.IndexType;
+		mesh->IndexCount = info.IndexCount;
+
+		if (bKeepInMemory) {
+			SizedArray<uint8> data;
+			data.InitSize(info.GetDataSize());
+
+			if (mCookedMesh.ReadMesh(i, Slice<uint8>(data))) {
+				mesh->ReadFromStaging(data.pData, info.VertexCount);
+			}
+		}
+
+		mMeshes[i].pMesh = mesh;
+	}
+
+	std::vector<Object*> objects(cooked_objects.size(), nullptr);
+
+	for (uint32 i = 0; i < cooked_objects.size(); i++) {
+		CookedObjectInfo& info = cooked_objects[i];
+
+		if (i == 0) {
+			objects[i] = root;
+		}
+		else {
+			if (info.Name.starts_with(cooked_root_name)) {
+				info.Name.replace(0, cooked_root_name.size(), root_name);
+			}
+
+			objects[i] = gObjectManager->NewObject(info.Name);
+		}
+
+		Object* object = objects[i];
+
+		object->Bounds = BoundingBox(info.BoundsMin, info.BoundsMax);
+
+		if (info.MeshIndex != scCookedNoIndex) {
+			object->pMesh = mMeshes[info.MeshIndex].pMesh;
+		}
+
+		if (info.MaterialIndex != scCookedNoIndex) {
+			object->SetMaterialID(mMaterials[info.MaterialIndex]);
+		}
+
+		if (info.SkeletonIndex != scCookedNoIndex) {
+			CookedSkeleton& skeleton = mCookedMesh.Skeletons[info.SkeletonIndex];
+
+			object->pSkeleton = skeleton.pSkeleton;
+			object->Animations = std::move(skeleton.Animations);
+		}
+	}
+
+	// Objects are attached once they are set up, in the same order as `LoaderGltf`
+	for (uint32 i = 1; i < cooked_objects.size(); i++) {
+		objects[cooked_objects[i].ParentIndex]->AttachObject(objects[i]->ID);
+	}
+}
+
+eLoaderStatus LoaderCookedMesh::Load(AssetTicket& ticket, const String& path)
+{
+	if (!mCookedMesh.Open(path)) {
+		LogInfo(LC_ASSET, "Cooked model for '{}' cannot be used, loading from the model file", path);
+		return LoadFromGltf(ticket, path);
+	}
+
+	const String cache_dir = LoaderGltf::GetTextureCacheDir(path);
+
+	// Nothing has been created yet, so the model can still be loaded from the model file
+	if (!AreTextureCachesAvailable(cache_dir)) {
+		LogInfo(LC_ASSET, "Texture caches for '{}' are missing, loading from the model file", path);
+		return LoadFromGltf(ticket, path);
+	}
+
+	if (!StageMeshes()) {
+		LogWarning(LC_ASSET, "Could not read the meshes of the cooked model for '{}', loading from the model file",
+				   path);
+		return LoadFromGltf(ticket, path);
+	}
+
+	MakeMaterials(cache_dir);
+	MakeObjects(ticket);
+
+	LogInfo(LC_ASSET, "Loaded cooked model '{}' ({} objects, {} meshes)", path, mCookedMesh.Objects.size(),
+			mMeshes.size());
+
+	mCookedMesh.Close();
+
+	return eLoaderStatus::Success;
+}
+
+eLoaderStatus LoaderCookedMesh::Load(AssetTicket& ticket, const uint8* data, uint32 size)
+{
+	mbUseGltfLoader = true;
+	mGltfLoader.bKeepInMemory = bKeepInMemory;
+
+	return mGltfLoader.Load(ticket, data, size);
+}
+
+void LoaderCookedMesh::CreateGpuResource(AssetTicket& ticket)
+{
+	if (mbUseGltfLoader) {
+		mGltfLoader.CreateGpuResource(ticket);
+		return;
+	}
+
+	CommandBuffer& cmd = RenderBackendFwd::GetUploadCmd();
+
+	// Every mesh of the model is copied from the same staging buffer, see `StageMeshes()`
+	for (AxCookedMeshUpload& upload : mMeshes) {
+		PrimitiveMesh& mesh = *upload.pMesh;
+
+		mesh.UploadFromBuffer(cmd, mStagingBuffer, upload.StagingOffset, upload.VerticesSize);
+		mesh.bIsReady = true;
+	}
+
+	LogInfo(LC_ASSET, "Uploaded {} cooked meshes to the GPU ({} bytes staged)", mMeshes.size(), mStagingBuffer.Size);
+
+	ticket.SignalUploadedToGpu();
+}
+
+void LoaderCookedMesh::Destroy()
+{
+	if (mbUseGltfLoader) {
+		mGltfLoader.Destroy();
+	}
+
+	mMeshes.clear();
+	mCookedMesh.Close();
+}
+
+} // namespace loader
+
+} // namespace fx
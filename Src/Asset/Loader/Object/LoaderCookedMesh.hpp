@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../ObjectLoaderBase.hpp"
+#include "LoaderGltf.hpp"
+
+#include <Asset/CookedMesh.hpp>
+#include <Core/Ref.hpp>
+#include <Material/MaterialID.hpp>
+#include <Renderer/Backend/GpuBuffer.hpp>
+#include <Renderer/PrimitiveMesh.hpp>
+#include <vector>
+
+namespace fx {
+
+namespace loader {
+
+/**
+ * @brief A mesh of a cooked model, and where its data is in the staging buffer.
+ */
+struct AxCookedMeshUpload
+{
+	Ref<PrimitiveMesh> pMesh { nullptr };
+
+	uint64 StagingOffset = 0;
+	uint64 VerticesSize = 0;
+};
+
+/**
+ * @brief Loads a model from its cooked model (see `CookedMesh`), which is written by `LoaderGltf` the first time the
+ * model loads with all of its texture caches.
+ *
+ * The meshes are read from the cooked model straight into one mapped staging buffer, and copied to the GPU without
+ * being unpacked or optimized. If the cooked model cannot be used, such as when a texture cache it references has been
+ * removed, the model is loaded from the glTF file instead.
+ */
+class LoaderCookedMesh final : public ObjectLoaderBase
+{
+public:
+	LoaderCookedMesh() = default;
+
+	eLoaderStatus Load(AssetTicket& ticket, const String& path) override;
+
+	/**
+	 * @brief Cooked models are only stored next to model files, so models in memory are loaded by `LoaderGltf`.
+	 */
+	eLoaderStatus Load(AssetTicket& ticket, const uint8* data, uint32 size) override;
+
+	void CreateGpuResource(AssetTicket& ticket) override;
+
+	void Destroy() override;
+
+	~LoaderCookedMesh() override = default;
+
+private:
+	/**
+	 * @brief Returns true if every texture cache that the materials of the cooked model reference can be loaded.
+	 */
+	bool AreTextureCachesAvailable(const String& cache_dir) const;
+
+	/**
+	 * @brief Reads the data of every mesh into one mapped staging buffer.
+	 * @returns False if a mesh could not be read, in which case the staging buffer is destroyed.
+	 */
+	bool StageMeshes();
+
+	void MakeMaterials(const String& cache_dir);
+	void MakeObjects(AssetTicket& ticket);
+
+	/**
+	 * @brief Loads the model from the glTF file, used when the cooked model cannot be used.
+	 */
+	eLoaderStatus LoadFromGltf(AssetTicket& ticket, const String& path);
+
+public:
+	bool bKeepInMemory : 1 = false;
+
+private:
+	CookedMesh mCookedMesh;
+
+	std::vector<MaterialID> mMaterials;
+
+	/// The mesh of each `CookedMeshInfo`, in the same order.
+	std::vector<AxCookedMeshUpload> mMeshes;
+
+	/// The data of every mesh in the model, uploaded in `CreateGpuResource()`. Destroyed with the loader, through the
+	/// asset manager's deletion queue so the upload can finish first.
+	renderer::RawGpuBuffer mStagingBuffer;
+
+	LoaderGltf mGltfLoader;
+	bool mbUseGltfLoader = false;
+};
+
+} // namespace loader
+
+} // namespace fx
@@ -15,12 +15,23 @@
 #include <Renderer/PrimitiveMesh.hpp>
 
 // Renderer includes
+#include <Asset/BlockCompress.hpp>
+#include <Asset/CookedMesh.hpp>
 #include <Asset/MipmapGen.hpp>
 #include <Core/FilesystemIO.hpp>
+#include <Core/JobSystem.hpp>
 #include <Core/Path.hpp>
+#include <Engine.hpp>
+#include <Math/MathUtil.hpp>
+#include <Renderer/Backend/Device.hpp>
 #include <Renderer/Backend/RenderBackendFwd.hpp>
 #include <Renderer/Globals.hpp>
 #include <Renderer/MeshUtil.hpp>
+#include <Texture/TextureStreamer.hpp>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 
 namespace fx {
 
@@ -28,58 +39,213 @@ using namespace renderer;
 
 namespace loader {
 
-void LoaderGltf::UnpackMeshAttributes(Object* object, Ref<PrimitiveMesh>& mesh, cgltf_primitive* primitive)
+/**
+ * @brief Returns the values of `accessor` as floats. Tightly stored float accessors are read in place from the glTF
+ * buffer, while quantized or sparse accessors are unpacked into `unpacked`.
+ *
+ * @param out_stride The number of values between elements in the returned data.
+ */
+static const float32* GetAccessorFloats(const cgltf_accessor* accessor, SizedArray<float32>& unpacked,
+										uint32* out_stride)
 {
-	SizedArray<float32> positions;
-	SizedArray<float32> normals;
-	SizedArray<float32> uvs;
-	SizedArray<float32> tangents;
-	SizedArray<float32> weights;
+	const bool can_read_in_place = (accessor->component_type == cgltf_component_type_r_32f && !accessor->normalized &&
+									!accessor->is_sparse && accessor->buffer_view != nullptr &&
+									(accessor->stride % sizeof(float32)) == 0);
+
+	if (can_read_in_place) {
+		const uint8* buffer_data = cgltf_buffer_view_data(accessor->buffer_view);
+
+		if (buffer_data != nullptr) {
+			*out_stride = static_cast<uint32>(accessor->stride / sizeof(float32));
+			return reinterpret_cast<const float32*>(buffer_data + accessor->offset);
+		}
+	}
+
+	const cgltf_size data_size = cgltf_accessor_unpack_floats(accessor, nullptr, 0);
+	unpacked.InitSize(data_size);
+	cgltf_accessor_unpack_floats(accessor, unpacked.pData, data_size);
+
+	*out_stride = static_cast<uint32>(cgltf_num_components(accessor->type));
+	return unpacked.pData;
+}
+
+void LoaderGltf::UnpackMeshAttributes(PrimitiveMesh& mesh, cgltf_primitive* primitive)
+{
+	VertexSources sources {};
+	uint32 vertex_count = 0;
+
+	// Only attributes that are not stored as floats are unpacked into these
+	SizedArray<float32> unpacked_positions;
+	SizedArray<float32> unpacked_normals;
+	SizedArray<float32> unpacked_uvs;
+	SizedArray<float32> unpacked_tangents;
+	SizedArray<float32> unpacked_weights;
+
+	// Joints are always stored as integers, and are widened to 32 bits
 	SizedArray<uint32> boneids;
 
 	for (int i = 0; i < primitive->attributes_count; i++) {
 		auto* attribute = &primitive->attributes[i];
 
+		// Only the first set of UVs, weights and joints are used
+		if (attribute->index != 0) {
+			continue;
+		}
+
+		const cgltf_accessor* accessor = attribute->data;
+
 		if (attribute->type == cgltf_attribute_type_position) {
-			cgltf_size data_size = cgltf_accessor_unpack_floats(attribute->data, nullptr, 0);
-			positions.InitSize(data_size);
-			cgltf_accessor_unpack_floats(attribute->data, positions.pData, data_size);
+			sources.pPositions = GetAccessorFloats(accessor, unpacked_positions, &sources.PositionStride);
+			vertex_count = static_cast<uint32>(accessor->count);
 		}
 		else if (attribute->type == cgltf_attribute_type_normal) {
-			cgltf_size data_size = cgltf_accessor_unpack_floats(attribute->data, nullptr, 0);
-			normals.InitSize(data_size);
-			cgltf_accessor_unpack_floats(attribute->data, normals.pData, data_size);
+			sources.pNormals = GetAccessorFloats(accessor, unpacked_normals, &sources.NormalStride);
 		}
 		else if (attribute->type == cgltf_attribute_type_texcoord) {
-			cgltf_size data_size = cgltf_accessor_unpack_floats(attribute->data, nullptr, 0);
-			uvs.InitSize(data_size);
-			cgltf_accessor_unpack_floats(attribute->data, uvs.pData, data_size);
+			sources.pUVs = GetAccessorFloats(accessor, unpacked_uvs, &sources.UVStride);
 		}
 		else if (attribute->type == cgltf_attribute_type_tangent) {
-			cgltf_size data_size = cgltf_accessor_unpack_floats(attribute->data, nullptr, 0);
-			tangents.InitSize(data_size);
-			cgltf_accessor_unpack_floats(attribute->data, tangents.pData, data_size);
+			// Tangents are stored with the handedness in W, which is not used
+			sources.pTangents = GetAccessorFloats(accessor, unpacked_tangents, &sources.TangentStride);
 		}
 		else if (attribute->type == cgltf_attribute_type_weights) {
-			cgltf_size data_size = cgltf_accessor_unpack_floats(attribute->data, nullptr, 0);
-			weights.InitSize(data_size);
-			cgltf_accessor_unpack_floats(attribute->data, weights.pData, data_size);
+			sources.pBoneWeights = GetAccessorFloats(accessor, unpacked_weights, &sources.BoneWeightStride);
 		}
 		else if (attribute->type == cgltf_attribute_type_joints) {
-			boneids.InitSize(attribute->data->count * 4);
-			for (cgltf_size j = 0; j < attribute->data->count; j++) {
-				cgltf_accessor_read_uint(attribute->data, j, reinterpret_cast<cgltf_uint*>(&boneids.pData[j * 4]), 4);
+			boneids.InitSize(accessor->count * 4);
+			for (cgltf_size j = 0; j < accessor->count; j++) {
+				cgltf_accessor_read_uint(accessor, j, reinterpret_cast<cgltf_uint*>(&boneids.pData[j * 4]), 4);
 			}
+
+			sources.pBoneIds = boneids.pData;
+			sources.BoneIdStride = 4;
 		}
 	}
 
+	if (sources.pPositions == nullptr || vertex_count == 0) {
+		LogWarning(LC_ASSET, "Primitive has no positions, skipping");
+		return;
+	}
+
 	// Since GLTF is stored with right handed coordinates (-x, y, z), we need to flip X when creating the vertex
-	// buffers.
-	constexpr eVertexCreateFlags create_flags = eVertexCreateFlags::NegativeX;
-	mesh->VertexList.CreateFrom(positions, normals, uvs, tangents, weights, boneids, create_flags);
+	// buffers. Loaded meshes use the compact vertex formats to reduce the bandwidth of the geometry and shadow passes.
+	constexpr eVertexCreateFlags create_flags = eVertexCreateFlags::NegativeX | eVertexCreateFlags::Compact;
+	mesh.VertexList.CreateFrom(sources, vertex_count, create_flags);
+}
+
+void LoaderGltf::OptimizeMesh(PrimitiveMesh& mesh)
+{
+	AnonArray& vertices = mesh.VertexList.GetLocalBuffer();
+	SizedArray<uint32>& indices = mesh.LocalIndexBuffer;
+
+	if (vertices.IsEmpty()) {
+		return;
+	}
+
+	const Hash64 cache_id = MeshOptimizer::GetCacheId(vertices, indices);
+
+	MeshOptimizerStats stats {};
+
+	bool is_cached = false;
+
+	if (mbUseMeshCache) {
+		// Entries are read from the cache file on first use, so the cache is locked while the mesh is copied out
+		std::lock_guard lock(mMeshCacheMutex);
+		is_cached = MeshOptimizer::LoadFromDataPack(mMeshCache, cache_id, vertices, indices, &stats);
+	}
+
+	if (!is_cached) {
+		// Meshes are optimized outside of the lock, so each job optimizes its own mesh at the same time
+		stats = MeshOptimizer::Optimize(vertices, indices);
+
+		if (mbUseMeshCache) {
+			std::lock_guard lock(mMeshCacheMutex);
+
+			MeshOptimizer::AddToDataPack(mMeshCache, cache_id, vertices, indices, stats);
+			mbMeshCacheChanged = true;
+		}
+	}
+
+	LogDebug(LC_ASSET, "Optimized mesh: {} -> {} vertices, ACMR {:.3f} -> {:.3f}", stats.VertexCountBefore,
+			 stats.VertexCountAfter, stats.AcmrBefore, stats.AcmrAfter);
+
+	std::lock_guard lock(mMeshCacheMutex);
+
+	mMeshTotals.VertexCountBefore += stats.VertexCountBefore;
+	mMeshTotals.VertexCountAfter += stats.VertexCountAfter;
+	mMeshTotals.TriangleCount += stats.TriangleCount;
+
+	mCacheMissesBefore += static_cast<float64>(stats.AcmrBefore) * stats.TriangleCount;
+	mCacheMissesAfter += static_cast<float64>(stats.AcmrAfter) * stats.TriangleCount;
+
+	++mMeshCount;
+
+	// Every vertex is referenced after optimization, so the highest index is the vertex count minus one
+	if (stats.VertexCountAfter <= UINT16_MAX + 1) {
+		++mMeshCount16BitIndices;
+	}
+}
+
+void LoaderGltf::OpenMeshCache()
+{
+	Path cache_path(mModelPath);
+
+	// Hello/Test/ModelName.xyz -> Hello/Test/TGen/ModelName.fxm, next to the texture cache
+	cache_path.RemoveExtension();
+	const String model_name = *cache_path.BaseName();
+
+	cache_path.RemoveLast();
+	cache_path.DirDown("TGen");
+	cache_path.CreateDirs();
+
+	mMeshCachePath = cache_path.Add(model_name).AddExtension(".fxm").Str();
+
+	// A missing or invalid cache is rebuilt as the meshes are optimized
+	mMeshCache.ReadFromFile(mMeshCachePath.CStr());
+
+	mbUseMeshCache = true;
+	mbMeshCacheChanged = false;
+}
+
+void LoaderGltf::CloseMeshCache()
+{
+	if (mbUseMeshCache && mbMeshCacheChanged) {
+		// Only the entries used by this load have data, so entries for meshes that have since changed are dropped
+		DataPack pack;
+
+		for (DataPackEntry& entry : mMeshCache.Entries) {
+			if (entry.HasData()) {
+				pack.AddEntry(entry.Id, Slice<uint8>(entry.Data));
+			}
+		}
+
+		mMeshCache.Close();
+
+		pack.WriteToFile(mMeshCachePath.CStr());
+		pack.Close();
+	}
+
+	mMeshCache.Close();
+	mMeshCache.Entries.Clear();
+
+	mbUseMeshCache = false;
+	mbMeshCacheChanged = false;
+
+	if (mMeshTotals.TriangleCount == 0) {
+		return;
+	}
+
+	const float64 triangle_count = static_cast<float64>(mMeshTotals.TriangleCount);
 
+	LogInfo(LC_ASSET, "Optimized {} meshes ({} with 16 bit indices): {} -> {} vertices, ACMR {:.3f} -> {:.3f}",
+			mMeshCount, mMeshCount16BitIndices, mMeshTotals.VertexCountBefore, mMeshTotals.VertexCountAfter,
+			mCacheMissesBefore / triangle_count, mCacheMissesAfter / triangle_count);
 
-	// mesh->UploadVertices();
+	mMeshTotals = MeshOptimizerStats {};
+	mCacheMissesBefore = 0.0;
+	mCacheMissesAfter = 0.0;
+	mMeshCount = 0;
+	mMeshCount16BitIndices = 0;
 }
 
 // static void GenerateMipsForTexture(const String& asset_path, const Slice<uint8>& pixels)
@@ -153,71 +319,254 @@ static String GetTextureCachePath(const Hash32 texture_cache_id, const String& b
 }
 
 
-static void GenerateMipmapImage(const String& output_path, eImageFormat format, const uint8* data, uint32 size)
+/// Texture cache files that are being built by background jobs. This is shared between loaders, as the file is not
+/// complete until the job finishes even if it already exists.
+static std::mutex sTextureCacheMutex;
+static std::unordered_set<Hash32> sTextureCachesBuilding;
+
+static void FreeDecodedPixels(void* pixels) { stbi_image_free(pixels); }
+
+/**
+ * @brief Decodes an image of the model. The pixels are owned by `out_pixels`, and freed once every reference to it is
+ * dropped.
+ */
+static ImageInfo DecodeTextureImage(eImageFormat format, const Slice<const uint8>& data,
+									TSRef<OwnedImageData>& out_pixels)
 {
-	loader::LoaderStb loader {};
-	loader.ImageType = eImageType::Flat;
-	loader.ImageFormat = format;
-	loader.CreationFlags = eImageCreateFlags::None;
+	const int32 pixel_size = ImageFormatUtil::GetPixelStride(format);
 
-	AssetTicket ticket(new fx::Image);
-	loader::eLoaderStatus status = loader.Load(ticket, data, size);
+	int32 width = 0;
+	int32 height = 0;
+	int32 channels = 0;
 
-	if (status != loader::eLoaderStatus::Success) {
-		LogError("Error loading material texture!");
-		return;
+	uint8* pixels = stbi_load_from_memory(data.pData, static_cast<int32>(data.Size), &width, &height, &channels,
+										  pixel_size);
+
+	if (pixels == nullptr) {
+		LogError(LC_ASSET, "Could not decode material texture! ({})", stbi_failure_reason());
+		return ImageInfo {};
+	}
+
+	const uint32 data_size = static_cast<uint32>(width * height * pixel_size);
+
+	out_pixels = TSRef<OwnedImageData>::New(pixels, &FreeDecodedPixels);
+
+	return ImageInfo(Vec2u(width, height), format, 0, 1, Slice<const uint8>(pixels, data_size));
+}
+
+/**
+ * @brief Returns the block compressed format to store a texture cache in, or `None` to store the decoded pixels as is.
+ */
+static eImageFormat GetTextureCacheFormat(const ImageInfo& image, bool is_normal_map)
+{
+	if (!RenderBackendFwd::GetDevice()->bSupportsTextureCompressionBC) {
+		return eImageFormat::None;
+	}
+
+	// Normal maps only keep XY, which BC5 stores at the full quality of two BC4 channels
+	if (is_normal_map) {
+		return eImageFormat::BC5_UNorm;
 	}
 
+	if (BlockCompress::IsGrayscale(image.ImageData)) {
+		return eImageFormat::BC4_UNorm;
+	}
+
+	return (image.Format == eImageFormat::RGBA8_SRGB) ? eImageFormat::BC7_SRGB : eImageFormat::BC7_UNorm;
+}
+
+static void BuildTextureCache(const AxGltfTextureCacheBuild& cache, const ImageInfo& image)
+{
+	const eImageFormat storage_format = GetTextureCacheFormat(image, cache.bIsNormalMap);
+
 	MipmapGen mm {};
-	mm.GenerateMipmaps(output_path.CStr(), format, loader.GetImageData(), loader.GetImageSize());
+	mm.GenerateMipmaps(cache.Path.CStr(), image.Format,
+					   Slice<uint8>(const_cast<uint8*>(image.ImageData.pData), image.ImageData.Size), image.Size,
+					   storage_format);
 
-	loader.InvalidateImageData();
+	std::lock_guard lock(sTextureCacheMutex);
+	sTextureCachesBuilding.erase(cache.ID);
+}
+
+
+static bool IsTextureCacheBuilding(Hash32 texture_cache_id)
+{
+	std::lock_guard lock(sTextureCacheMutex);
+	return sTextureCachesBuilding.contains(texture_cache_id);
+}
+
+bool LoaderGltf::IsTextureCacheAvailable(Hash32 texture_cache_id, const String& cache_dir)
+{
+	return !IsTextureCacheBuilding(texture_cache_id) &&
+		   FilesystemIO::FileExists(GetTextureCachePath(texture_cache_id, cache_dir));
 }
 
+String LoaderGltf::GetTextureCacheDir(const String& model_path)
+{
+	Path cache_dir(model_path);
+
+	// Hello/Test/ModelName.xyz -> Hello/Test/TGen
+	cache_dir.RemoveLast();
+	cache_dir.DirDown("TGen");
+	cache_dir.CreateDirs();
+
+	return cache_dir.Str();
+}
 
-static void MakeMaterialTextureForPrimitive(const String& model_name, const String& base_path, Material* material,
-											const char* component_name, MaterialComponent& component,
-											cgltf_texture_view& texture_view)
+bool LoaderGltf::LoadTextureFromCache(Material* material, MaterialComponent& component, Hash32 texture_cache_id,
+									  const String& cache_dir)
+{
+	if (!IsTextureCacheAvailable(texture_cache_id, cache_dir)) {
+		return false;
+	}
+
+	const String texture_cache_path = GetTextureCachePath(texture_cache_id, cache_dir);
+
+	component.TextureCacheID = texture_cache_id;
+
+	MipmapLoader ml {};
+
+	ml.Open(texture_cache_path.CStr());
+
+	// Only the tail of the mip chain is loaded with the model, the larger levels are streamed in when they are
+	// visible
+	const uint32 tail_mip = TextureStreamer::GetTailMip(ml.GetMipCount());
+
+	component.UploadSrc = eMaterialComponentUploadSrc::DirectUpload;
+	component.ImageToUpload = ml.GetMipChain(tail_mip);
+
+	if (gTextureStreamer) {
+		gTextureStreamer->Register(material, component, texture_cache_path, ml.GetMipCount(), tail_mip);
+	}
+
+	return true;
+}
+
+void LoaderGltf::MakeMaterialTextureForPrimitive(const String& model_name, const String& base_path, Material* material,
+												 const char* component_name, MaterialComponent& component,
+												 cgltf_texture_view& texture_view)
 {
 	Assert(texture_view.texture != nullptr);
 
 	Hash32 texture_cache_id = GetTextureCacheID(model_name, material, component_name);
 	String texture_cache_path = GetTextureCachePath(texture_cache_id, base_path);
 
-	const bool texture_cache_exists = FilesystemIO::FileExists(texture_cache_path);
+	// Set the ID to be able to load higher resolution textures later
+	component.TextureCacheID = texture_cache_id;
+
+	if (LoadTextureFromCache(material, component, texture_cache_id, base_path)) {
+		return;
+	}
+
+	// The texture is decoded from the model, so the model is not cooked until a later load finds the texture cache
+	mbTexturesFromCache = false;
+
+	const bool texture_cache_building = IsTextureCacheBuilding(texture_cache_id);
+
+	const cgltf_image* source_image = texture_view.texture->image;
 
-	if (texture_cache_exists) {
-		MipmapLoader ml {};
+	// Materials that share an image (or primitives that share a material) use the same decode
+	auto decode_it = std::find_if(mTextureDecodes.begin(), mTextureDecodes.end(),
+								  [&](const AxGltfTextureDecode& decode)
+								  {
+									  return (decode.pSourceImage == source_image) &&
+											 (decode.Format == component.ImageFormat);
+								  });
 
-		ml.Open(texture_cache_path.CStr());
+	if (decode_it == mTextureDecodes.end()) {
+		AxGltfTextureDecode& decode = mTextureDecodes.emplace_back();
 
-		component.UploadSrc = eMaterialComponentUploadSrc::DirectUpload;
-		// component.ImageToUpload = ml.GetMip(3);
-		component.ImageToUpload = ml.GetQuality(eQualityLevel::HighQuality);
-		component.TextureCacheID = texture_cache_id;
+		decode.pSourceImage = source_image;
+		decode.Format = component.ImageFormat;
+
+		const uint8* image_buffer = cgltf_buffer_view_data(source_image->buffer_view);
+		const uint32 image_buffer_size = static_cast<uint32>(source_image->buffer_view->size);
+
+		Assert(image_buffer != nullptr);
+		Assert(image_buffer_size > 0);
+
+		// The glTF buffers are kept until `FinishMaterialTextures()` has waited on the decodes, so the encoded image is
+		// read in place.
+		const Slice<const uint8> encoded_data(image_buffer, image_buffer_size);
+
+		// Each texture is decoded in a job while the rest of the model is unpacked
+		if (gJobSystem) {
+			gJobSystem->Submit([&decode, encoded_data]()
+							   { decode.Decoded = DecodeTextureImage(decode.Format, encoded_data, decode.pPixels); },
+							   &mTextureJobs);
+		}
+		else {
+			decode.Decoded = DecodeTextureImage(decode.Format, encoded_data, decode.pPixels);
+		}
+
+		decode_it = std::prev(mTextureDecodes.end());
+	}
+
+	decode_it->Components.push_back(&component);
+
+	if (texture_cache_building) {
 		return;
 	}
 
-	const uint8* image_buffer = cgltf_buffer_view_data(texture_view.texture->image->buffer_view);
-	uint32 image_buffer_size = static_cast<uint32>(texture_view.texture->image->buffer_view->size);
+	// Claim the cache file so that no other material or loader builds it at the same time
+	std::lock_guard lock(sTextureCacheMutex);
+
+	if (sTextureCachesBuilding.insert(texture_cache_id).second) {
+		decode_it->CachesToBuild.push_back(AxGltfTextureCacheBuild {
+			.ID = texture_cache_id,
+			.Path = texture_cache_path,
+			.bIsNormalMap = (&component == &material->NormalMap),
+		});
+	}
+}
+
+void LoaderGltf::FinishMaterialTextures()
+{
+	if (gJobSystem) {
+		gJobSystem->Wait(mTextureJobs);
+	}
 
-	// Stage that shit so we can nuke mGltfData as soon as we can
-	uint8* goober_buffer = static_cast<uint8*>(std::malloc(image_buffer_size));
-	memcpy(goober_buffer, image_buffer, image_buffer_size);
+	for (AxGltfTextureDecode& decode : mTextureDecodes) {
+		const ImageInfo& image = decode.Decoded;
+		const bool is_decoded = (image.ImageData.pData != nullptr);
 
-	Assert(goober_buffer != nullptr);
-	Assert(image_buffer_size > 0);
+		for (MaterialComponent* component : decode.Components) {
+			if (is_decoded) {
+				component->UploadSrc = eMaterialComponentUploadSrc::DirectUpload;
+				component->ImageToUpload = image;
+				component->pImageOwner = decode.pPixels;
+			}
+			else {
+				component->SetTicket(gAssetManager->GetNullImageTicket(decode.Format));
+			}
+		}
 
-	// Submit as data to be loaded later by the asset manager
-	component.UploadSrc = eMaterialComponentUploadSrc::ProcessAndUpload;
-	component.pDataToLoad = MakeSlice(const_cast<const uint8*>(goober_buffer), image_buffer_size);
+		// The texture cache is built from the same pixels that are uploaded, and the model does not wait for it. Later
+		// loads of the model read the mips from the cache. Each job holds a reference to the pixels until it is done.
+		for (const AxGltfTextureCacheBuild& cache : decode.CachesToBuild) {
+			if (!is_decoded) {
+				std::lock_guard lock(sTextureCacheMutex);
+				sTextureCachesBuilding.erase(cache.ID);
+				continue;
+			}
 
-	// Set the ID to be able to load higher resolution textures later
-	component.TextureCacheID = texture_cache_id;
+			if (gJobSystem) {
+				gJobSystem->Submit([cache, image, pixels = decode.pPixels]() { BuildTextureCache(cache, image); });
+			}
+			else {
+				BuildTextureCache(cache, image);
+			}
+		}
+	}
+
+	mTextureDecodes.clear();
 
-	if (!texture_cache_exists) {
-		GenerateMipmapImage(texture_cache_path, component.ImageFormat, goober_buffer, image_buffer_size);
+	// The materials can now be built, as each component has its image
+	for (Material* material : mMaterialsToFinalize) {
+		material->Finalize();
 	}
+
+	mMaterialsToFinalize.clear();
 }
 
 void LoaderGltf::MakeMaterialForPrimitive(Object* object, cgltf_primitive* primitive, int32 primitive_index)
@@ -242,14 +591,7 @@ void LoaderGltf::MakeMaterialForPrimitive(Object* object, cgltf_primitive* primi
 	model_path.RemoveExtension();
 	const String model_name = *model_path.BaseName();
 
-	// Remove the basename
-	// Hello/Test/ModelName -> Hello/Test
-	model_path.RemoveLast();
-	model_path.DirDown("TGen");
-	// Create the base dir if it doesn't exist
-	model_path.CreateDirs();
-
-	const String tcache_base_path = model_path.Str();
+	const String tcache_base_path = GetTextureCacheDir(mModelPath);
 
 	object->mMaterialID = gMaterialManager->NewMaterial(material_name, ePipelineName::Geometry, object->IsSkinned());
 
@@ -289,7 +631,8 @@ void LoaderGltf::MakeMaterialForPrimitive(Object* object, cgltf_primitive* primi
 										gltf_material->pbr_metallic_roughness.metallic_roughness_texture);
 	}
 
-	material->Finalize();
+	// Finalized once the textures have been decoded, see `FinishMaterialTextures()`
+	mMaterialsToFinalize.push_back(material);
 }
 
 void LoaderGltf::BuildObjectsFromPrimitives(Object* container_object, cgltf_mesh* gltf_mesh)
@@ -318,22 +661,17 @@ void LoaderGltf::BuildObjectsFromPrimitives(Object* container_object, cgltf_mesh
 		cgltf_primitive* gltf_primitive = &gltf_mesh->primitives[i];
 		Ref<PrimitiveMesh> primitive_mesh = Ref<PrimitiveMesh>::New();
 
-		SizedArray<uint32> indices;
-
 		// Keep the primitive mesh's vertices and indices in memory if `KeepInMemory` is set
 		primitive_mesh->bKeepInMemory = bKeepInMemory;
 
-		// Load the indices in from the mesh
-		if (gltf_primitive->indices != nullptr) {
-			indices.InitSize(gltf_primitive->indices->count);
-			cgltf_accessor_unpack_indices(gltf_primitive->indices, indices.pData, sizeof(uint32),
-										  gltf_primitive->indices->count);
-			primitive_mesh->SetIndices(std::move(indices));
-		}
-
-		UnpackMeshAttributes(current_object, primitive_mesh, gltf_primitive);
 		current_object->pMesh = primitive_mesh;
-		current_object->Bounds = MeshUtil::CalculateBounds(primitive_mesh->GetVertices());
+
+		// The mesh is unpacked in a job once every object has been created, see `UnpackPrimitives()`
+		mPrimitives.push_back(AxGltfPrimitiveUnpack {
+			.pPrimitive = gltf_primitive,
+			.pObject = current_object,
+			.pMesh = primitive_mesh,
+		});
 
 		MakeMaterialForPrimitive(current_object, gltf_primitive, i);
 
@@ -346,32 +684,92 @@ void LoaderGltf::BuildObjectsFromPrimitives(Object* container_object, cgltf_mesh
 }
 
 
-void LoaderGltf::UploadMeshToGpu(Object* object)
+void LoaderGltf::UnpackPrimitive(AxGltfPrimitiveUnpack& unpack)
 {
-	// uint32 attached_count = object->AttachedNodes.Size();
+	cgltf_primitive* gltf_primitive = unpack.pPrimitive;
+	PrimitiveMesh& primitive_mesh = *unpack.pMesh;
 
-	// for (int32 i = 0; i < attached_count; i++) {
-	//     Ref<PrimitiveMesh> primitive_mesh = object->AttachedNodes[i]->pMesh;
+	// Load the indices in from the mesh
+	if (gltf_primitive->indices != nullptr) {
+		SizedArray<uint32> indices;
+		indices.InitSize(gltf_primitive->indices->count);
+		cgltf_accessor_unpack_indices(gltf_primitive->indices, indices.pData, sizeof(uint32),
+									  gltf_primitive->indices->count);
+		primitive_mesh.SetIndices(std::move(indices));
+	}
 
-	//     // Set the mesh indices
-	//     primitive_mesh->UploadIndices();
-	//     primitive_mesh->UploadVertices();
+	UnpackMeshAttributes(primitive_mesh, gltf_primitive);
 
-	//     primitive_mesh->bIsReady = true;
-	// }
+	if (gltf_primitive->type == cgltf_primitive_type_triangles) {
+		OptimizeMesh(primitive_mesh);
+	}
 
+	unpack.pObject->Bounds = MeshUtil::CalculateBounds(primitive_mesh.VertexList);
+}
+
+void LoaderGltf::UnpackPrimitives()
+{
+	// Each primitive is unpacked into its own mesh and object, so the primitives can be unpacked in any order
+	auto unpack_primitives = [this](uint32 start, uint32 end)
+	{
+		for (uint32 i = start; i < end; i++) {
+			UnpackPrimitive(mPrimitives[i]);
+		}
+	};
+
+	const uint32 primitive_count = static_cast<uint32>(mPrimitives.size());
+
+	if (gJobSystem) {
+		gJobSystem->ParallelFor(primitive_count, 1, unpack_primitives);
+	}
+	else {
+		unpack_primitives(0, primitive_count);
+	}
+}
+
+void LoaderGltf::StageMeshes()
+{
+	uint64 staging_size = 0;
+
+	for (AxGltfPrimitiveUnpack& unpack : mPrimitives) {
+		if (unpack.pMesh->VertexList.GetLocalBuffer().IsEmpty()) {
+			continue;
+		}
+
+		unpack.StagingOffset = staging_size;
+		staging_size += MathUtil::AlignValue<16>(unpack.pMesh->PrepareStaging());
+	}
+
+	if (staging_size == 0) {
+		return;
+	}
 
-	if (object->pMesh.IsValid()) {
-		Ref<PrimitiveMesh> primitive_mesh = object->pMesh;
+	mStagingBuffer.Create(eGpuBufferType::Transfer, staging_size, VMA_MEMORY_USAGE_CPU_TO_GPU,
+						  eGpuBufferFlags::PersistentMapped);
 
-		LogInfo(LC_ASSET, "Upload mesh to GPU");
+	uint8* staging_data = static_cast<uint8*>(mStagingBuffer.pMappedBuffer);
 
-		// Set the mesh indices
-		primitive_mesh->UploadIndices(RenderBackendFwd::GetUploadCmd());
-		primitive_mesh->UploadVertices(RenderBackendFwd::GetUploadCmd());
+	auto stage_meshes = [this, staging_data](uint32 start, uint32 end)
+	{
+		for (uint32 i = start; i < end; i++) {
+			const AxGltfPrimitiveUnpack& unpack = mPrimitives[i];
 
-		primitive_mesh->bIsReady = true;
+			if (!unpack.pMesh->VertexList.GetLocalBuffer().IsEmpty()) {
+				unpack.pMesh->WriteToStaging(staging_data + unpack.StagingOffset);
+			}
+		}
+	};
+
+	const uint32 primitive_count = static_cast<uint32>(mPrimitives.size());
+
+	if (gJobSystem) {
+		gJobSystem->ParallelFor(primitive_count, 1, stage_meshes);
+	}
+	else {
+		stage_meshes(0, primitive_count);
 	}
+
+	mStagingBuffer.FlushToGpu(0, static_cast<uint32>(staging_size));
 }
 
 
@@ -420,7 +818,6 @@ void LoaderGltf::LoadSkeleton(Skeleton& skel, cgltf_skin* skin)
 	// Parent indices and names
 	skel.ParentIndices.InitSize(joint_count);
 	skel.BoneNames.InitSize(joint_count);
-	skel.LocalTransforms.InitSize(joint_count);
 	skel.WorldTransforms.InitSize(joint_count);
 	skel.SkinningMatrices.InitSize(joint_count);
 
@@ -582,6 +979,38 @@ void LoaderGltf::ProcessData(AssetTicket& ticket)
 	}
 }
 
+/**
+ * Returns the paths of the buffers and images that are stored in separate files from the model, relative to the
+ * directory of the model. Data URIs are embedded in the model and are skipped.
+ */
+static std::vector<String> GetExternalFiles(const cgltf_data* data)
+{
+	std::vector<String> files;
+
+	auto add_uri = [&files](const char* uri)
+	{
+		if (uri == nullptr || strncmp(uri, "data:", 5) == 0) {
+			return;
+		}
+
+		// URIs may be percent encoded, decode them in the same way that cgltf does when loading the file
+		std::string decoded(uri);
+		decoded.resize(cgltf_decode_uri(decoded.data()));
+
+		files.push_back(String(decoded.c_str(), static_cast<uint32>(decoded.size())));
+	};
+
+	for (cgltf_size i = 0; i < data->buffers_count; i++) {
+		add_uri(data->buffers[i].uri);
+	}
+
+	for (cgltf_size i = 0; i < data->images_count; i++) {
+		add_uri(data->images[i].uri);
+	}
+
+	return files;
+}
+
 eLoaderStatus LoaderGltf::Load(AssetTicket& ticket, const String& path)
 {
 	cgltf_options options {};
@@ -600,7 +1029,20 @@ eLoaderStatus LoaderGltf::Load(AssetTicket& ticket, const String& path)
 		return eLoaderStatus::Error;
 	}
 
+	mbTexturesFromCache = true;
+
+	OpenMeshCache();
 	ProcessData(ticket);
+	UnpackPrimitives();
+	CloseMeshCache();
+	StageMeshes();
+	FinishMaterialTextures();
+
+	// Once every texture has a texture cache, the model is cooked so that later loads skip the steps above (see
+	// `LoaderCookedMesh`)
+	if (mbTexturesFromCache && !CookedMesh::IsUpToDate(path)) {
+		CookedMesh::Write(path, static_cast<Object*>(ticket.Get()), GetExternalFiles(mpGltfData));
+	}
 
 	return eLoaderStatus::Success;
 }
@@ -616,38 +1058,42 @@ eLoaderStatus LoaderGltf::Load(AssetTicket& ticket, const uint8* data, uint32 si
 		return eLoaderStatus::Error;
 	}
 
+	// There is no path to store a mesh cache at, the meshes are optimized on every load
 	ProcessData(ticket);
+	UnpackPrimitives();
+	CloseMeshCache();
+	StageMeshes();
+	FinishMaterialTextures();
 
 	return eLoaderStatus::Success;
 }
 
 void LoaderGltf::CreateGpuResource(AssetTicket& ticket)
 {
-	// If there is only one mesh to load, store the mesh directly in the output object
-	// TSRef<Object> current_object = container_object;
-
-	// If there are multiple gltf meshes, we will need to use the output object as a
-	// container for multiple other meshes
-	// const bool has_multiple_meshes = mpGltfData->meshes_count > 1;
+	CommandBuffer& cmd = RenderBackendFwd::GetUploadCmd();
 
-	// UploadMeshToGpu(container_object);
+	// Every mesh of the model is copied from the same staging buffer, see `StageMeshes()`
+	for (AxGltfPrimitiveUnpack& unpack : mPrimitives) {
+		PrimitiveMesh& primitive_mesh = *unpack.pMesh;
 
-	Object* object = static_cast<Object*>(ticket.Get());
-
-	uint32 attached_count = object->AttachedNodes.Size();
-
-	// container_object->PrintDebug();
+		if (primitive_mesh.VertexList.GetLocalBuffer().IsEmpty()) {
+			continue;
+		}
 
-	for (uint32 i = 0; i < attached_count; i++) {
-		UploadMeshToGpu(gObjectManager->GetObject(object->AttachedNodes[i]));
+		primitive_mesh.UploadFromBuffer(cmd, mStagingBuffer, unpack.StagingOffset);
+		primitive_mesh.bIsReady = true;
 	}
 
-	UploadMeshToGpu(object);
+	LogInfo(LC_ASSET, "Uploaded {} meshes to the GPU ({} bytes staged)", mPrimitives.size(), mStagingBuffer.Size);
+
 	ticket.SignalUploadedToGpu();
 }
 
 void LoaderGltf::Destroy()
 {
+	// The primitives point into the glTF data
+	mPrimitives.clear();
+
 	if (mpGltfData) {
 		cgltf_free(mpGltfData);
 		mpGltfData = nullptr;
@@ -3,12 +3,20 @@
 #include "../ObjectLoaderBase.hpp"
 
 #include <Asset/Animation.hpp>
+#include <Asset/DataPack.hpp>
+#include <Asset/MeshOptimizer.hpp>
+#include <Core/JobSystem.hpp>
 #include <Core/Path.hpp>
 #include <Material/Material.hpp>
 #include <Object/Object.hpp>
+#include <Renderer/Backend/GpuBuffer.hpp>
+#include <Renderer/PrimitiveMesh.hpp>
+#include <deque>
+#include <mutex>
 #include <vector>
 
 struct cgltf_data;
+struct cgltf_image;
 struct cgltf_material;
 struct cgltf_mesh;
 struct cgltf_texture_view;
@@ -28,6 +36,54 @@ struct AxGltfMaterialToLoad
 	int MeshIndex = 0;
 };
 
+/**
+ * @brief A texture cache file to build from a decoded image.
+ */
+struct AxGltfTextureCacheBuild
+{
+	Hash32 ID = 0;
+	String Path;
+
+	/// Normal maps are stored with two channels, and the shaders rebuild Z.
+	bool bIsNormalMap = false;
+};
+
+/**
+ * @brief An image of the model that is decoded once while the model loads, and shared by every material component that
+ * uses it.
+ */
+struct AxGltfTextureDecode
+{
+	const cgltf_image* pSourceImage = nullptr;
+	eImageFormat Format = eImageFormat::RGBA8_UNorm;
+
+	/// The decoded pixels, written by the decode job.
+	ImageInfo Decoded {};
+
+	/// Owns the pixels of `Decoded`. Shared with the material components that upload them and the jobs that build
+	/// texture caches from them, and freed once all of them are done.
+	TSRef<OwnedImageData> pPixels { nullptr };
+
+	/// Components that the decoded image is uploaded to.
+	std::vector<MaterialComponent*> Components;
+
+	/// Texture cache files to build from the decoded image once it is uploaded.
+	std::vector<AxGltfTextureCacheBuild> CachesToBuild;
+};
+
+/**
+ * @brief A primitive of the model whose mesh is unpacked in a job (see `LoaderGltf::UnpackPrimitives()`).
+ */
+struct AxGltfPrimitiveUnpack
+{
+	cgltf_primitive* pPrimitive = nullptr;
+	Object* pObject = nullptr;
+	Ref<PrimitiveMesh> pMesh { nullptr };
+
+	/// The offset of the mesh in the model's staging buffer, see `LoaderGltf::StageMeshes()`.
+	uint64 StagingOffset = 0;
+};
+
 
 class LoaderGltf final : public ObjectLoaderBase
 {
@@ -38,17 +94,85 @@ public:
 	eLoaderStatus Load(AssetTicket& ticket, const uint8* data, uint32 size) override;
 
 	void CreateGpuResource(AssetTicket& object_id) override;
-	void UploadMeshToGpu(Object* object);
 
 	void Destroy() override;
 
 	~LoaderGltf() override = default;
 
+	/**
+	 * @brief Returns the directory that the texture caches, mesh cache and cooked model of the model at `model_path`
+	 * are stored in, and creates it if it does not exist.
+	 * Example: Some/Path/ModelName.glb  becomes  Some/Path/TGen
+	 */
+	static String GetTextureCacheDir(const String& model_path);
+
+	/**
+	 * @brief Returns true if the texture cache `texture_cache_id` in `cache_dir` exists and is not being built.
+	 */
+	static bool IsTextureCacheAvailable(Hash32 texture_cache_id, const String& cache_dir);
+
+	/**
+	 * @brief Loads `component` from the texture cache `texture_cache_id` in `cache_dir`. Only the tail of the mip chain
+	 * is loaded, and the larger levels are streamed in by the `TextureStreamer`.
+	 *
+	 * @returns False if the texture cache does not exist or is still being built.
+	 */
+	static bool LoadTextureFromCache(Material* material, MaterialComponent& component, Hash32 texture_cache_id,
+									 const String& cache_dir);
+
+	/**
+	 * @brief Interleaves the attributes of `primitive` into the vertex list of `mesh`. Float attributes are read in
+	 * place from the glTF buffers, other formats are converted to floats first.
+	 */
+	static void UnpackMeshAttributes(PrimitiveMesh& mesh, cgltf_primitive* primitive);
+
 private:
 	// void MakeEmptyMaterialTexture(Ref<Material>& material, MaterialComponent& component);
 	void MakeMaterialForPrimitive(Object* object, cgltf_primitive* primitive, int32 primitive_index);
 
-	void UnpackMeshAttributes(Object* object, Ref<PrimitiveMesh>& mesh, cgltf_primitive* primitive);
+	/**
+	 * @brief Loads a texture of a material from the texture cache. If the texture has not been cached yet, the image
+	 * is decoded in a job and the cache is built from the decoded pixels later (see `FinishMaterialTextures()`).
+	 */
+	void MakeMaterialTextureForPrimitive(const String& model_name, const String& base_path, Material* material,
+										 const char* component_name, MaterialComponent& component,
+										 cgltf_texture_view& texture_view);
+
+	/**
+	 * @brief Waits for the model's textures to decode, then passes the pixels to their material components and
+	 * finalizes the materials. The texture caches are built in background jobs that the model does not wait on.
+	 */
+	void FinishMaterialTextures();
+
+	/**
+	 * @brief Unpacks the indices and vertices of each primitive found by `BuildObjectsFromPrimitives()`, spread across
+	 * jobs. Each job optimizes its mesh and sets the bounds of its object.
+	 */
+	void UnpackPrimitives();
+	void UnpackPrimitive(AxGltfPrimitiveUnpack& unpack);
+
+	/**
+	 * @brief Writes the meshes of every primitive into one mapped staging buffer, so the upload only records the copies
+	 * to the GPU buffers (see `CreateGpuResource()`).
+	 */
+	void StageMeshes();
+
+	/**
+	 * @brief Runs the `MeshOptimizer` on the unpacked vertices and indices of `mesh`, or loads the optimized mesh from
+	 * the model's mesh cache if it has been optimized before.
+	 */
+	void OptimizeMesh(PrimitiveMesh& mesh);
+
+	/**
+	 * @brief Opens the mesh cache for the model, which is stored alongside the generated textures.
+	 */
+	void OpenMeshCache();
+
+	/**
+	 * @brief Writes any newly optimized meshes to the mesh cache, and logs the ACMR of the model's meshes before and
+	 * after optimization.
+	 */
+	void CloseMeshCache();
 
 	int32 FindJointIndex(cgltf_skin* skin, const cgltf_node* node) const;
 
@@ -74,6 +198,39 @@ private:
 	String mModelPath;
 
 	SizedArray<Mat4f> mBones;
+
+	/// Primitives that are unpacked in jobs, in the order they were found.
+	std::vector<AxGltfPrimitiveUnpack> mPrimitives;
+
+	/// The vertices and indices of every mesh in the model, uploaded in `CreateGpuResource()`. Destroyed with the
+	/// loader, through the asset manager's deletion queue so the upload can finish first.
+	renderer::RawGpuBuffer mStagingBuffer;
+
+	/// Optimized meshes keyed by `MeshOptimizer::GetCacheId()`. Not used when loading a model from memory.
+	DataPack mMeshCache;
+	String mMeshCachePath;
+	bool mbUseMeshCache = false;
+	bool mbMeshCacheChanged = false;
+
+	/// Totals for the meshes optimized (or loaded from the cache) while loading the model, see `CloseMeshCache()`.
+	MeshOptimizerStats mMeshTotals;
+	float64 mCacheMissesBefore = 0.0;
+	float64 mCacheMissesAfter = 0.0;
+	uint32 mMeshCount = 0;
+	uint32 mMeshCount16BitIndices = 0;
+
+	/// Locks the mesh cache and the totals, as meshes are optimized by several jobs at once.
+	std::mutex mMeshCacheMutex;
+
+	/// Images being decoded by jobs while the model loads. Elements must not move while the jobs run.
+	std::deque<AxGltfTextureDecode> mTextureDecodes;
+	JobCounter mTextureJobs;
+
+	std::vector<Material*> mMaterialsToFinalize;
+
+	/// True while every texture of the model has been loaded from a texture cache. The model is only cooked once its
+	/// texture caches exist, as the cooked model references them (see `CookedMesh`).
+	bool mbTexturesFromCache = true;
 };
 
 } // namespace loader
@@ -0,0 +1,144 @@
+#include "MeshLoadTest.hpp"
+
+#include <ThirdParty/cgltf.h>
+
+#include <Asset/Loader/Object/LoaderGltf.hpp>
+#include <Core/Log.hpp>
+#include <Renderer/PrimitiveMesh.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace fx {
+
+using namespace renderer;
+
+/// Smallest dot product allowed between a calculated normal and the expected normal. Octahedral snorm16 normals are
+/// accurate to well within this.
+static constexpr float32 scMinNormalDot = 0.999f;
+
+/**
+ * Decodes a normal written by `VertexConvert::WriteOctahedral()`, in the same way as `DecodeOctahedral()` in
+ * Helper.hlsl.
+ */
+static Vec3f DecodeOctahedral(const int16 encoded[2])
+{
+	const float32 x = static_cast<float32>(encoded[0]) / 32767.0f;
+	const float32 y = static_cast<float32>(encoded[1]) / 32767.0f;
+
+	Vec3f direction(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+
+	// Unfold the lower hemisphere
+	const float32 fold = std::clamp(-direction.Z, 0.0f, 1.0f);
+	direction.X += (direction.X >= 0.0f) ? -fold : fold;
+	direction.Y += (direction.Y >= 0.0f) ? -fold : fold;
+
+	return direction.NormalizeIP();
+}
+
+static Vec3f GetVertexNormal(const VertexList& vertex_list, uint32 index)
+{
+	const AnonArray& vertices = vertex_list.GetLocalBuffer();
+	const uint8* vertex = static_cast<const uint8*>(vertices.pData) + (static_cast<uint64>(index) * vertices.ObjectSize);
+
+	if (vertex_list.IsCompact()) {
+		return DecodeOctahedral(reinterpret_cast<const Vertex<eVertexType::Compact>*>(vertex)->Normal);
+	}
+
+	return Vec3f(reinterpret_cast<const Vertex<eVertexType::Default>*>(vertex)->Normal);
+}
+
+static bool TestPrimitive(cgltf_primitive* primitive, uint32 primitive_index)
+{
+	PrimitiveMesh mesh;
+	mesh.bKeepInMemory = true;
+
+	if (primitive->indices == nullptr) {
+		LogError(LC_ASSET, "Mesh load test: primitive {} has no indices", primitive_index);
+		return false;
+	}
+
+	SizedArray<uint32> indices;
+	indices.InitSize(primitive->indices->count);
+	cgltf_accessor_unpack_indices(primitive->indices, indices.pData, sizeof(uint32), primitive->indices->count);
+	mesh.SetIndices(std::move(indices));
+
+	loader::LoaderGltf::UnpackMeshAttributes(mesh, primitive);
+
+	VertexList& vertex_list = mesh.VertexList;
+
+	if (vertex_list.HasNormals() || vertex_list.VertexType != eVertexType::Compact) {
+		LogError(LC_ASSET, "Mesh load test: primitive {} should be a compact mesh without normals", primitive_index);
+		return false;
+	}
+
+	// Normals are calculated when the mesh is staged, as they are when the model is loaded
+	mesh.PrepareStaging();
+
+	if (!vertex_list.HasNormals()) {
+		LogError(LC_ASSET, "Mesh load test: normals were not calculated for primitive {}", primitive_index);
+		return false;
+	}
+
+	const AnonArray& vertices = vertex_list.GetLocalBuffer();
+	const uint32* triangle = mesh.LocalIndexBuffer.pData;
+
+	auto get_position = [&](uint32 index)
+	{
+		return reinterpret_cast<const float32*>(static_cast<const uint8*>(vertices.pData) +
+												(static_cast<uint64>(index) * vertices.ObjectSize));
+	};
+
+	// Calculated in the same way as `PrimitiveMesh::RecalculateNormals()`
+	const Vec3f edge_a = Vec3f::FromDifference(get_position(triangle[0]), get_position(triangle[1]));
+	const Vec3f edge_b = Vec3f::FromDifference(get_position(triangle[2]), get_position(triangle[1]));
+	const Vec3f expected = edge_a.Cross(edge_b).NormalizeIP();
+
+	float32 min_dot = 1.0f;
+
+	for (uint32 index = 0; index < vertices.Size; index++) {
+		min_dot = std::min(min_dot, GetVertexNormal(vertex_list, index).Dot(expected));
+	}
+
+	if (min_dot < scMinNormalDot) {
+		LogError(LC_ASSET, "Mesh load test: normals of primitive {} differ from the face normal (dot {})",
+				 primitive_index, min_dot);
+		return false;
+	}
+
+	LogInfo(LC_ASSET, "    Primitive {}: {} vertices, normal ({:.3f}, {:.3f}, {:.3f})", primitive_index, vertices.Size,
+			expected.X, expected.Y, expected.Z);
+
+	return true;
+}
+
+bool MeshLoadTestWithoutNormals(const char* path)
+{
+	cgltf_options options {};
+	cgltf_data* data = nullptr;
+
+	if (cgltf_parse_file(&options, path, &data) != cgltf_result_success ||
+		cgltf_load_buffers(&options, data, path) != cgltf_result_success) {
+		LogError(LC_ASSET, "Mesh load test: could not load '{}'", path);
+		cgltf_free(data);
+		return false;
+	}
+
+	LogInfo(LC_ASSET, "Mesh load test: '{}'", path);
+
+	bool passed = true;
+	uint32 primitive_index = 0;
+
+	for (cgltf_size i = 0; i < data->meshes_count; i++) {
+		const cgltf_mesh& gltf_mesh = data->meshes[i];
+
+		for (cgltf_size j = 0; j < gltf_mesh.primitives_count; j++) {
+			passed &= TestPrimitive(&gltf_mesh.primitives[j], primitive_index++);
+		}
+	}
+
+	cgltf_free(data);
+
+	return passed;
+}
+
+} // namespace fx
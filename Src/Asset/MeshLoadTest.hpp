@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx {
+
+/**
+ * @brief Unpacks each primitive of the glTF model at `path` the same way as `LoaderGltf`, for a model whose
+ * primitives have UVs but no normals, and checks the normals that are calculated when the mesh is staged.
+ *
+ * The meshes use the compact vertex formats, so this covers calculating normals into octahedral encoded vertices. Each
+ * primitive must be flat, so that every vertex normal should match the normal of the first triangle.
+ *
+ * @returns False if the model could not be loaded, or if any normal is missing or does not match.
+ */
+bool MeshLoadTestWithoutNormals(const char* path = "Models/NoNormalsQuad.gltf");
+
+} // namespace fx
@@ -0,0 +1,697 @@
+#include "MeshOptimizer.hpp"
+
+#include "DataPack.hpp"
+
+#include <Core/Assert.hpp>
+#include <Core/Log.hpp>
+#include <Math/Vec3.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace fx {
+
+static constexpr uint32 scMeshCacheMagic = 0x4D4F5846; // "FXOM"
+static constexpr uint16 scMeshCacheVersion = 1;
+
+static constexpr uint32 scEmptySlot = UINT32_MAX;
+
+/// The size of the LRU cache that the Forsyth scores are tuned for. This is larger than `scAcmrCacheSize` so that the
+/// order also works well on hardware with larger (or less FIFO-like) caches.
+static constexpr uint32 scForsythCacheSize = 32;
+
+/// Vertices with more live triangles than this all receive the same valence score.
+static constexpr uint32 scForsythMaxValence = 64;
+
+struct MeshCacheHeader
+{
+    uint32 Magic = scMeshCacheMagic;
+    uint16 Version = scMeshCacheVersion;
+    uint16 VertexSize = 0;
+    uint32 VertexCount = 0;
+    uint32 IndexCount = 0;
+
+    MeshOptimizerStats Stats;
+};
+
+FX_FORCE_INLINE static const uint8* GetVertex(const AnonArray& vertices, uint32 index)
+{
+    return static_cast<const uint8*>(vertices.pData) + (static_cast<uint64>(index) * vertices.ObjectSize);
+}
+
+FX_FORCE_INLINE static Vec3f GetPosition(const AnonArray& vertices, uint32 index)
+{
+    // The position is at offset zero for every vertex type (see `VertexUtil::GetPosition()`)
+    float32 position[3];
+    memcpy(position, GetVertex(vertices, index), sizeof(position));
+
+    return Vec3f(position[0], position[1], position[2]);
+}
+
+///////////////////////////////
+// Optimization
+///////////////////////////////
+
+MeshOptimizerStats MeshOptimizer::Optimize(AnonArray& vertices, SizedArray<uint32>& indices)
+{
+    MeshOptimizerStats stats {};
+
+    if (vertices.IsEmpty()) {
+        return stats;
+    }
+
+    // Treat meshes without indices as a list of triangles
+    if (indices.IsEmpty()) {
+        indices.InitSize(vertices.Size);
+
+        for (uint32 i = 0; i < vertices.Size; i++) {
+            indices[i] = i;
+        }
+    }
+
+    Assert((indices.Size % 3) == 0);
+
+    stats.VertexCountBefore = vertices.Size;
+    stats.TriangleCount = static_cast<uint32>(indices.Size / 3);
+    stats.AcmrBefore = CalculateAcmr(indices, vertices.Size);
+
+    DeduplicateVertices(vertices, indices);
+    OptimizeVertexCache(indices, vertices.Size);
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+
+    stats.VertexCountAfter = vertices.Size;
+    stats.AcmrAfter = CalculateAcmr(indices, vertices.Size);
+
+    return stats;
+}
+
+uint32 MeshOptimizer::DeduplicateVertices(AnonArray& vertices, SizedArray<uint32>& indices)
+{
+    const uint32 vertex_count = vertices.Size;
+    const uint32 vertex_size = vertices.ObjectSize;
+
+    // Open addressed table of unique vertices, kept at most half full
+    uint32 table_size = 16;
+
+    while (table_size < vertex_count * 2) {
+        table_size <<= 1;
+    }
+
+    const uint32 table_mask = table_size - 1;
+
+    SizedArray<uint32> table;
+    table.InitSize(table_size);
+    std::fill(table.begin(), table.end(), scEmptySlot);
+
+    SizedArray<uint32> remap;
+    remap.InitSize(vertex_count);
+
+    uint8* base = static_cast<uint8*>(vertices.pData);
+    uint32 unique_count = 0;
+
+    for (uint32 index = 0; index < vertex_count; index++) {
+        const uint8* vertex = base + (static_cast<uint64>(index) * vertex_size);
+
+        uint32 slot = HashData32(Slice<uint8>(const_cast<uint8*>(vertex), vertex_size)) & table_mask;
+
+        // The table holds the merged index of each unique vertex. Unique vertices are compacted to the front of the
+        // buffer as they are found, which only overwrites vertices that have already been visited.
+        while (table[slot] != scEmptySlot) {
+            if (memcmp(base + (static_cast<uint64>(table[slot]) * vertex_size), vertex, vertex_size) == 0) {
+                break;
+            }
+
+            slot = (slot + 1) & table_mask;
+        }
+
+        if (table[slot] != scEmptySlot) {
+            remap[index] = table[slot];
+            continue;
+        }
+
+        if (unique_count != index) {
+            memmove(base + (static_cast<uint64>(unique_count) * vertex_size), vertex, vertex_size);
+        }
+
+        table[slot] = unique_count;
+        remap[index] = unique_count;
+
+        ++unique_count;
+    }
+
+    for (uint32& index : indices) {
+        index = remap[index];
+    }
+
+    vertices.Size = unique_count;
+
+    return unique_count;
+}
+
+/**
+ * The scoring from "Linear-Speed Vertex Cache Optimisation" (Tom Forsyth, 2006). Vertices score higher the more
+ * recently they were used, with the three vertices of the last triangle sharing a fixed score so that the next triangle
+ * does not have to reuse a particular edge. Vertices with few remaining triangles are boosted so that they are finished
+ * off, rather than leaving single triangles to be drawn with a cold cache later.
+ */
+struct ForsythScores
+{
+    ForsythScores()
+    {
+        constexpr float32 cache_decay_power = 1.5f;
+        constexpr float32 last_triangle_score = 0.75f;
+        constexpr float32 valence_boost_scale = 2.0f;
+        constexpr float32 valence_boost_power = 0.5f;
+
+        for (uint32 i = 0; i < scForsythCacheSize; i++) {
+            if (i < 3) {
+                Cache[i] = last_triangle_score;
+                continue;
+            }
+
+            const float32 scale = 1.0f / static_cast<float32>(scForsythCacheSize - 3);
+            Cache[i] = powf(1.0f - (static_cast<float32>(i - 3) * scale), cache_decay_power);
+        }
+
+        Valence[0] = 0.0f;
+
+        for (uint32 i = 1; i < scForsythMaxValence; i++) {
+            Valence[i] = valence_boost_scale * powf(static_cast<float32>(i), -valence_boost_power);
+        }
+    }
+
+    FX_FORCE_INLINE float32 Get(int32 cache_position, uint32 live_triangles) const
+    {
+        // No triangles left to draw with the vertex
+        if (live_triangles == 0) {
+            return -1.0f;
+        }
+
+        const float32 cache_score = (cache_position >= 0) ? Cache[cache_position] : 0.0f;
+
+        return cache_score + Valence[std::min(live_triangles, scForsythMaxValence - 1)];
+    }
+
+public:
+    float32 Cache[scForsythCacheSize];
+    float32 Valence[scForsythMaxValence];
+};
+
+void MeshOptimizer::OptimizeVertexCache(SizedArray<uint32>& indices, uint32 vertex_count)
+{
+    static const ForsythScores sScores;
+
+    const uint32 index_count = static_cast<uint32>(indices.Size);
+    const uint32 triangle_count = index_count / 3;
+
+    if (triangle_count == 0) {
+        return;
+    }
+
+    // Build the list of triangles that use each vertex. The first `live_counts[v]` triangles in each list are the
+    // triangles that have not been drawn yet.
+    SizedArray<uint32> live_counts;
+    live_counts.InitSize(vertex_count);
+    std::fill(live_counts.begin(), live_counts.end(), 0);
+
+    for (uint32 index : indices) {
+        ++live_counts[index];
+    }
+
+    SizedArray<uint32> adjacency_offsets;
+    adjacency_offsets.InitSize(vertex_count + 1);
+
+    adjacency_offsets[0] = 0;
+
+    for (uint32 vertex = 0; vertex < vertex_count; vertex++) {
+        adjacency_offsets[vertex + 1] = adjacency_offsets[vertex] + live_counts[vertex];
+    }
+
+    SizedArray<uint32> adjacency;
+    adjacency.InitSize(index_count);
+
+    {
+        SizedArray<uint32> write_offsets;
+        write_offsets.InitAsCopyOf(adjacency_offsets.pData, vertex_count);
+
+        for (uint32 index = 0; index < index_count; index++) {
+            adjacency[write_offsets[indices[index]]++] = index / 3;
+        }
+    }
+
+    SizedArray<int32> cache_positions;
+    cache_positions.InitSize(vertex_count);
+    std::fill(cache_positions.begin(), cache_positions.end(), -1);
+
+    SizedArray<float32> vertex_scores;
+    vertex_scores.InitSize(vertex_count);
+
+    for (uint32 vertex = 0; vertex < vertex_count; vertex++) {
+        vertex_scores[vertex] = sScores.Get(-1, live_counts[vertex]);
+    }
+
+    SizedArray<float32> triangle_scores;
+    triangle_scores.InitSize(triangle_count);
+
+    SizedArray<uint8> triangles_drawn;
+    triangles_drawn.InitSize(triangle_count);
+    std::fill(triangles_drawn.begin(), triangles_drawn.end(), 0);
+
+    uint32 best_triangle = 0;
+    float32 best_score = -1.0f;
+
+    for (uint32 triangle = 0; triangle < triangle_count; triangle++) {
+        const uint32* tri = &indices[triangle * 3];
+        const float32 score = vertex_scores[tri[0]] + vertex_scores[tri[1]] + vertex_scores[tri[2]];
+
+        triangle_scores[triangle] = score;
+
+        if (score > best_score) {
+            best_score = score;
+            best_triangle = triangle;
+        }
+    }
+
+    SizedArray<uint32> output;
+    output.InitSize(index_count);
+
+    // The cache holds three extra vertices while the vertices of the next triangle are pushed in
+    uint32 cache[scForsythCacheSize + 3];
+    uint32 cache_count = 0;
+
+    // The next triangle to check when there are no triangles connected to the cache
+    uint32 search_cursor = 0;
+
+    for (uint32 output_triangle = 0; output_triangle < triangle_count; output_triangle++) {
+        if (best_triangle == scEmptySlot) {
+            while (triangles_drawn[search_cursor]) {
+                ++search_cursor;
+            }
+
+            best_triangle = search_cursor;
+        }
+
+        const uint32* tri = &indices[best_triangle * 3];
+
+        memcpy(&output[output_triangle * 3], tri, sizeof(uint32) * 3);
+        triangles_drawn[best_triangle] = 1;
+
+        // Remove the triangle from the live triangles of each of its vertices
+        for (uint32 i = 0; i < 3; i++) {
+            const uint32 vertex = tri[i];
+
+            uint32* live_triangles = &adjacency[adjacency_offsets[vertex]];
+            const uint32 live_count = live_counts[vertex];
+
+            for (uint32 j = 0; j < live_count; j++) {
+                if (live_triangles[j] == best_triangle) {
+                    live_triangles[j] = live_triangles[live_count - 1];
+                    break;
+                }
+            }
+
+            --live_counts[vertex];
+        }
+
+        // Push the vertices of the triangle to the front of the cache
+        uint32 new_cache[scForsythCacheSize + 3];
+        uint32 new_cache_count = 0;
+
+        for (uint32 i = 0; i < 3; i++) {
+            if (std::find(new_cache, new_cache + new_cache_count, tri[i]) == new_cache + new_cache_count) {
+                new_cache[new_cache_count++] = tri[i];
+            }
+        }
+
+        for (uint32 i = 0; i < cache_count; i++) {
+            const uint32 vertex = cache[i];
+
+            if (vertex != tri[0] && vertex != tri[1] && vertex != tri[2]) {
+                new_cache[new_cache_count++] = vertex;
+            }
+        }
+
+        // Update the vertices in the cache, including any that were just pushed out of it
+        for (uint32 i = 0; i < new_cache_count; i++) {
+            const uint32 vertex = new_cache[i];
+            const int32 position = (i < scForsythCacheSize) ? static_cast<int32>(i) : -1;
+
+            cache_positions[vertex] = position;
+            vertex_scores[vertex] = sScores.Get(position, live_counts[vertex]);
+        }
+
+        // Only triangles that use a vertex in the cache change score, so the next triangle is picked from those
+        best_triangle = scEmptySlot;
+        best_score = -1.0f;
+
+        for (uint32 i = 0; i < new_cache_count; i++) {
+            const uint32 vertex = new_cache[i];
+
+            const uint32* live_triangles = &adjacency[adjacency_offsets[vertex]];
+            const uint32 live_count = live_counts[vertex];
+
+            for (uint32 j = 0; j < live_count; j++) {
+                const uint32 triangle = live_triangles[j];
+                const uint32* triangle_indices = &indices[triangle * 3];
+
+                const float32 score = vertex_scores[triangle_indices[0]] + vertex_scores[triangle_indices[1]] +
+                                      vertex_scores[triangle_indices[2]];
+
+                triangle_scores[triangle] = score;
+
+                if (score > best_score) {
+                    best_score = score;
+                    best_triangle = triangle;
+                }
+            }
+        }
+
+        cache_count = std::min(new_cache_count, scForsythCacheSize);
+        memcpy(cache, new_cache, sizeof(uint32) * cache_count);
+    }
+
+    indices = std::move(output);
+}
+
+/**
+ * Simulates a FIFO cache of `cache_size` vertices. A vertex is in the cache if it was added less than `cache_size`
+ * misses ago, so the cache is reset by moving `timestamp` past the size of the cache.
+ */
+struct FifoCacheSim
+{
+    FifoCacheSim(uint32 vertex_count, uint32 cache_size) : CacheSize(cache_size), Timestamp(cache_size + 1)
+    {
+        Timestamps.InitSize(vertex_count);
+        std::fill(Timestamps.begin(), Timestamps.end(), 0);
+    }
+
+    FX_FORCE_INLINE uint32 AddTriangle(const uint32* tri)
+    {
+        uint32 misses = 0;
+
+        for (uint32 i = 0; i < 3; i++) {
+            if (Timestamp - Timestamps[tri[i]] > CacheSize) {
+                Timestamps[tri[i]] = Timestamp++;
+                ++misses;
+            }
+        }
+
+        return misses;
+    }
+
+    FX_FORCE_INLINE void Reset() { Timestamp += CacheSize + 1; }
+
+public:
+    SizedArray<uint32> Timestamps;
+    uint32 CacheSize;
+    uint32 Timestamp;
+};
+
+void MeshOptimizer::OptimizeOverdraw(SizedArray<uint32>& indices, const AnonArray& vertices, float32 threshold)
+{
+    const uint32 triangle_count = static_cast<uint32>(indices.Size / 3);
+
+    if (triangle_count < 2) {
+        return;
+    }
+
+    FifoCacheSim cache(vertices.Size, scAcmrCacheSize);
+
+    // Hard boundaries are the triangles where the cache order starts over with all three vertices missing the cache.
+    // Moving the triangles between two hard boundaries as a group costs nothing in vertex cache efficiency.
+    SizedArray<uint32> hard_clusters;
+    hard_clusters.InitCapacity(triangle_count + 1);
+
+    SizedArray<uint32> triangle_misses;
+    triangle_misses.InitSize(triangle_count);
+
+    for (uint32 triangle = 0; triangle < triangle_count; triangle++) {
+        triangle_misses[triangle] = cache.AddTriangle(&indices[triangle * 3]);
+
+        if (triangle == 0 || triangle_misses[triangle] == 3) {
+            hard_clusters.Insert(triangle);
+        }
+    }
+
+    hard_clusters.Insert(triangle_count);
+
+    // Split each hard cluster into smaller clusters wherever the ACMR of the current run has come down to near the
+    // ACMR of the whole hard cluster, so that there are more clusters to sort without losing much cache efficiency.
+    SizedArray<uint32> clusters;
+    clusters.InitCapacity(triangle_count + 1);
+
+    for (uint32 i = 0; i + 1 < hard_clusters.Size; i++) {
+        const uint32 start = hard_clusters[i];
+        const uint32 end = hard_clusters[i + 1];
+
+        uint32 cluster_misses = 0;
+
+        for (uint32 triangle = start; triangle < end; triangle++) {
+            cluster_misses += triangle_misses[triangle];
+        }
+
+        const float32 cluster_threshold = threshold * static_cast<float32>(cluster_misses) /
+                                          static_cast<float32>(end - start);
+
+        uint32 run_start = start;
+        uint32 run_misses = 0;
+
+        clusters.Insert(start);
+        cache.Reset();
+
+        for (uint32 triangle = start; triangle < end - 1; triangle++) {
+            run_misses += cache.AddTriangle(&indices[triangle * 3]);
+
+            const float32 run_acmr = static_cast<float32>(run_misses) / static_cast<float32>(triangle - run_start + 1);
+
+            if (run_acmr <= cluster_threshold) {
+                run_start = triangle + 1;
+                run_misses = 0;
+
+                clusters.Insert(run_start);
+                cache.Reset();
+            }
+        }
+    }
+
+    const uint32 cluster_count = clusters.Size;
+    clusters.Insert(triangle_count);
+
+    // Find the centroid and average normal of each cluster, weighted by the area of each triangle
+    SizedArray<Vec3f> cluster_centroids;
+    cluster_centroids.InitSize(cluster_count);
+
+    SizedArray<Vec3f> cluster_normals;
+    cluster_normals.InitSize(cluster_count);
+
+    Vec3f mesh_centroid = Vec3f::sZero;
+    float32 mesh_area = 0.0f;
+
+    for (uint32 cluster = 0; cluster < cluster_count; cluster++) {
+        Vec3f centroid = Vec3f::sZero;
+        Vec3f normal = Vec3f::sZero;
+        float32 area = 0.0f;
+
+        for (uint32 triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++) {
+            const uint32* tri = &indices[triangle * 3];
+
+            const Vec3f a = GetPosition(vertices, tri[0]);
+            const Vec3f b = GetPosition(vertices, tri[1]);
+            const Vec3f c = GetPosition(vertices, tri[2]);
+
+            // The length of the cross product is twice the area of the triangle
+            const Vec3f triangle_normal = (b - a).Cross(c - a);
+            const float32 triangle_area = triangle_normal.Length();
+
+            centroid += (a + b + c) * (triangle_area / 3.0f);
+            normal += triangle_normal;
+            area += triangle_area;
+        }
+
+        mesh_centroid += centroid;
+        mesh_area += area;
+
+        cluster_centroids[cluster] = (area > 0.0f) ? centroid * (1.0f / area) : centroid;
+        cluster_normals[cluster] = normal;
+    }
+
+    if (mesh_area > 0.0f) {
+        mesh_centroid = mesh_centroid * (1.0f / mesh_area);
+    }
+
+    // Clusters that face away from the centre of the mesh are likely to occlude the rest of it, so they are drawn first
+    SizedArray<float32> cluster_sort_keys;
+    cluster_sort_keys.InitSize(cluster_count);
+
+    SizedArray<uint32> cluster_order;
+    cluster_order.InitSize(cluster_count);
+
+    for (uint32 cluster = 0; cluster < cluster_count; cluster++) {
+        const Vec3f& normal = cluster_normals[cluster];
+        const float32 normal_length = normal.Length();
+
+        const float32 facing = (cluster_centroids[cluster] - mesh_centroid).Dot(normal);
+
+        cluster_sort_keys[cluster] = (normal_length > 0.0f) ? facing / normal_length : 0.0f;
+        cluster_order[cluster] = cluster;
+    }
+
+    std::stable_sort(cluster_order.begin(), cluster_order.end(), [&cluster_sort_keys](uint32 a, uint32 b) {
+        return cluster_sort_keys[a] > cluster_sort_keys[b];
+    });
+
+    SizedArray<uint32> output;
+    output.InitSize(indices.Size);
+
+    uint32 output_index = 0;
+
+    for (uint32 cluster : cluster_order) {
+        const uint32 start = clusters[cluster] * 3;
+        const uint32 count = (clusters[cluster + 1] * 3) - start;
+
+        memcpy(&output[output_index], &indices[start], sizeof(uint32) * count);
+        output_index += count;
+    }
+
+    indices = std::move(output);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(AnonArray& vertices, SizedArray<uint32>& indices)
+{
+    const uint32 vertex_count = vertices.Size;
+    const uint32 vertex_size = vertices.ObjectSize;
+
+    SizedArray<uint32> remap;
+    remap.InitSize(vertex_count);
+    std::fill(remap.begin(), remap.end(), scEmptySlot);
+
+    AnonArray output;
+    output.Create(vertex_size, vertex_count);
+
+    uint8* output_base = static_cast<uint8*>(output.pData);
+
+    for (uint32& index : indices) {
+        if (remap[index] == scEmptySlot) {
+            remap[index] = output.Size;
+
+            memcpy(output_base + (static_cast<uint64>(output.Size) * vertex_size), GetVertex(vertices, index),
+                   vertex_size);
+            ++output.Size;
+        }
+
+        index = remap[index];
+    }
+
+    vertices.Free();
+    vertices = std::move(output);
+}
+
+float32 MeshOptimizer::CalculateAcmr(const SizedArray<uint32>& indices, uint32 vertex_count, uint32 cache_size)
+{
+    const uint32 triangle_count = static_cast<uint32>(indices.Size / 3);
+
+    if (triangle_count == 0) {
+        return 0.0f;
+    }
+
+    FifoCacheSim cache(vertex_count, cache_size);
+
+    uint32 misses = 0;
+
+    for (uint32 triangle = 0; triangle < triangle_count; triangle++) {
+        misses += cache.AddTriangle(&indices[triangle * 3]);
+    }
+
+    return static_cast<float32>(misses) / static_cast<float32>(triangle_count);
+}
+
+///////////////////////////////
+// Caching
+///////////////////////////////
+
+Hash64 MeshOptimizer::GetCacheId(const AnonArray& vertices, const SizedArray<uint32>& indices)
+{
+    Hash64 hash = HashObj64(scMeshCacheVersion);
+    hash = HashObj64(vertices.ObjectSize, hash);
+
+    const uint64 vertices_size = static_cast<uint64>(vertices.Size) * vertices.ObjectSize;
+
+    hash = HashData64(Slice<uint8>(static_cast<uint8*>(vertices.pData), vertices_size), hash);
+    hash = HashData64(Slice<uint8>(reinterpret_cast<uint8*>(indices.pData), indices.GetSizeInBytes()), hash);
+
+    return hash;
+}
+
+void MeshOptimizer::AddToDataPack(DataPack& pack, Hash64 id, const AnonArray& vertices,
+                                  const SizedArray<uint32>& indices, const MeshOptimizerStats& stats)
+{
+    MeshCacheHeader header {};
+    header.VertexSize = static_cast<uint16>(vertices.ObjectSize);
+    header.VertexCount = vertices.Size;
+    header.IndexCount = static_cast<uint32>(indices.Size);
+    header.Stats = stats;
+
+    const uint64 vertices_size = static_cast<uint64>(vertices.Size) * vertices.ObjectSize;
+
+    SizedArray<uint8> data;
+    data.InitSize(sizeof(MeshCacheHeader) + vertices_size + indices.GetSizeInBytes());
+
+    uint8* write_ptr = data.pData;
+
+    memcpy(write_ptr, &header, sizeof(header));
+    write_ptr += sizeof(header);
+
+    memcpy(write_ptr, vertices.pData, vertices_size);
+    write_ptr += vertices_size;
+
+    memcpy(write_ptr, indices.pData, indices.GetSizeInBytes());
+
+    pack.AddEntry(id, Slice<uint8>(data));
+}
+
+bool MeshOptimizer::LoadFromDataPack(DataPack& pack, Hash64 id, AnonArray& vertices, SizedArray<uint32>& indices,
+                                     MeshOptimizerStats* out_stats)
+{
+    DataPackEntry* entry = pack.GetEntry(id, true);
+
+    if (entry == nullptr || entry->Data.Size < sizeof(MeshCacheHeader)) {
+        return false;
+    }
+
+    MeshCacheHeader header;
+    memcpy(&header, entry->Data.pData, sizeof(header));
+
+    if (header.Magic != scMeshCacheMagic || header.Version != scMeshCacheVersion ||
+        header.VertexSize != vertices.ObjectSize) {
+        return false;
+    }
+
+    const uint64 vertices_size = static_cast<uint64>(header.VertexCount) * header.VertexSize;
+    const uint64 indices_size = static_cast<uint64>(header.IndexCount) * sizeof(uint32);
+
+    if (entry->Data.Size < sizeof(MeshCacheHeader) + vertices_size + indices_size) {
+        LogWarning(LC_ASSET, "Optimized mesh {} in cache is truncated", id);
+        return false;
+    }
+
+    const uint8* read_ptr = entry->Data.pData + sizeof(MeshCacheHeader);
+
+    vertices.Free();
+    vertices.Create(header.VertexSize, header.VertexCount);
+    vertices.Size = header.VertexCount;
+
+    memcpy(vertices.pData, read_ptr, vertices_size);
+    read_ptr += vertices_size;
+
+    indices.Free();
+    indices.InitAsCopyOf(reinterpret_cast<const uint32*>(read_ptr), header.IndexCount);
+
+    if (out_stats != nullptr) {
+        *out_stats = header.Stats;
+    }
+
+    return true;
+}
+
+} // namespace fx
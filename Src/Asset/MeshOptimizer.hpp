@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Core/AnonArray.hpp>
+#include <Core/Hash.hpp>
+#include <Core/SizedArray.hpp>
+#include <Core/Types.hpp>
+
+namespace fx {
+
+class DataPack;
+
+/**
+ * Vertex and index counts of a mesh before and after `MeshOptimizer::Optimize()`, along with the average cache miss
+ * ratio (ACMR, the number of vertex shader invocations per triangle) of each.
+ */
+struct MeshOptimizerStats
+{
+    uint32 VertexCountBefore = 0;
+    uint32 VertexCountAfter = 0;
+    uint32 TriangleCount = 0;
+
+    float32 AcmrBefore = 0.0f;
+    float32 AcmrAfter = 0.0f;
+};
+
+/**
+ * @brief Reorders the vertices and indices of triangle meshes at import time so that they are cheaper to draw.
+ *
+ * Meshes are optimized in the following steps:
+ *
+ * 1. Vertices with identical attributes are merged, and meshes without indices are given them.
+ * 2. Triangles are reordered for the post-transform vertex cache with Tom Forsyth's "Linear-Speed Vertex Cache
+ *    Optimisation", so each vertex is shaded as few times as possible.
+ * 3. The triangles are split into clusters where the cache order allows it, and the clusters are sorted to draw the
+ *    outward facing parts of the mesh first (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced
+ *    Overdraw"). This reduces overdraw without undoing most of step 2.
+ * 4. Vertices are renumbered in the order that the triangles first use them, so vertex fetches walk through the vertex
+ *    buffer instead of jumping around it.
+ *
+ * The result can be stored in a `DataPack` (see `AddToDataPack()`), so each mesh is only optimized once.
+ */
+class MeshOptimizer
+{
+public:
+    /// The number of vertices in the FIFO cache that ACMR is measured with.
+    static constexpr uint32 scAcmrCacheSize = 16;
+
+    /// Clusters are split from a run of triangles once the run's ACMR is within this ratio of the whole run's ACMR.
+    static constexpr float32 scOverdrawThreshold = 1.05f;
+
+public:
+    /**
+     * @brief Runs each optimization step on a triangle list.
+     *
+     * @param vertices The vertices of the mesh, which can be any vertex type with the position at offset zero.
+     * @param indices The triangle list. If this is empty, the vertices are treated as a triangle list and indices are
+     * created for them.
+     */
+    static MeshOptimizerStats Optimize(AnonArray& vertices, SizedArray<uint32>& indices);
+
+    /**
+     * @brief Merges vertices that are identical byte for byte and remaps `indices` to the merged vertices.
+     * @returns The number of vertices after merging.
+     */
+    static uint32 DeduplicateVertices(AnonArray& vertices, SizedArray<uint32>& indices);
+
+    /**
+     * @brief Reorders the triangles in `indices` to reuse vertices in the post-transform cache.
+     */
+    static void OptimizeVertexCache(SizedArray<uint32>& indices, uint32 vertex_count);
+
+    /**
+     * @brief Reorders clusters of triangles to reduce overdraw. `indices` should already be in vertex cache order.
+     */
+    static void OptimizeOverdraw(SizedArray<uint32>& indices, const AnonArray& vertices,
+                                 float32 threshold = scOverdrawThreshold);
+
+    /**
+     * @brief Renumbers the vertices in the order that they are first used by `indices`. Vertices that are not used by
+     * any triangle are removed.
+     */
+    static void OptimizeVertexFetch(AnonArray& vertices, SizedArray<uint32>& indices);
+
+    /**
+     * @brief Returns the average number of cache misses per triangle for a FIFO cache of `cache_size` vertices. This
+     * is 3.0 for a mesh that shares no vertices, and approaches 0.5 for a large regular grid.
+     */
+    static float32 CalculateAcmr(const SizedArray<uint32>& indices, uint32 vertex_count,
+                                 uint32 cache_size = scAcmrCacheSize);
+
+    /**
+     * @brief Returns the ID to store an optimized mesh under, from the vertices and indices before optimization.
+     * Changing the source mesh or the optimizer version changes the ID.
+     */
+    static Hash64 GetCacheId(const AnonArray& vertices, const SizedArray<uint32>& indices);
+
+    /**
+     * @brief Adds an optimized mesh to `pack` as the entry `id`.
+     */
+    static void AddToDataPack(DataPack& pack, Hash64 id, const AnonArray& vertices, const SizedArray<uint32>& indices,
+                              const MeshOptimizerStats& stats);
+
+    /**
+     * @brief Replaces `vertices` and `indices` with the optimized mesh in the entry `id` of `pack`.
+     * @returns False if there is no entry for the mesh, or the entry is not for vertices of the same size.
+     */
+    static bool LoadFromDataPack(DataPack& pack, Hash64 id, AnonArray& vertices, SizedArray<uint32>& indices,
+                                 MeshOptimizerStats* out_stats);
+};
+
+} // namespace fx
@@ -4,6 +4,8 @@
 
 #include <ThirdParty/stb_image_resize2.h>
 
+#include <Asset/BlockCompress.hpp>
+#include <Asset/ImageResample.hpp>
 #include <Asset/Loader/Image/LoaderStb.hpp>
 #include <Core/ArrayUtil.hpp>
 #include <Core/FilesystemIO.hpp>
@@ -25,19 +27,123 @@ struct MipHeader
 
 #pragma pack(pop)
 
-void MipmapGen::GenerateMipmaps(const char* path, eImageFormat format, const Slice<uint8>& pixels, const Vec2u& size)
+/**
+ * Returns true if mips of `format` can be built from the previous level with `ImageResample::DownsampleBox4x8`.
+ */
+static bool CanDownsampleBox(eImageFormat format)
+{
+	switch (format) {
+	case eImageFormat::BGRA8_UNorm:
+	case eImageFormat::RGBA8_SRGB:
+	case eImageFormat::RGBA8_UNorm:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Returns true if images of `format` can be stored as a block compressed format.
+ */
+static bool CanBlockCompress(eImageFormat format)
+{
+	return (format == eImageFormat::RGBA8_UNorm || format == eImageFormat::RGBA8_SRGB);
+}
+
+void MipmapGen::GenerateMipmaps(const char* path, eImageFormat format, const Slice<uint8>& pixels, const Vec2u& size,
+								eImageFormat storage_format)
 {
 	uint32 expected_mip_count = GetExpectedMipCount(size);
 
 	DataPack dp;
 
-	for (uint32 i = 0; i < expected_mip_count; i++) {
-		GenerateMip(dp, format, pixels, size, i);
+	if (ImageFormatUtil::IsBlockCompressed(storage_format) && !CanBlockCompress(format)) {
+		LogWarning(LC_ASSET, "Cannot block compress mips of this image format, storing uncompressed (Path={})", path);
+		storage_format = eImageFormat::None;
+	}
+
+	if (!CanDownsampleBox(format)) {
+		for (uint32 i = 0; i < expected_mip_count; i++) {
+			GenerateMip(dp, format, pixels, size, i);
+		}
+
+		dp.WriteToFile(path);
+		return;
+	}
+
+	const ImageResample::eColorSpace color_space = (format == eImageFormat::RGBA8_SRGB)
+													   ? ImageResample::eColorSpace::Srgb
+													   : ImageResample::eColorSpace::Linear;
+
+	if (ImageFormatUtil::IsBlockCompressed(storage_format)) {
+		GenerateCompressedMipmaps(dp, storage_format, pixels, size, color_space);
+
+		dp.WriteToFile(path);
+		return;
+	}
+
+	// Each level is built from the one before it, so the chain costs about a third of the base image instead of a
+	// full size resize per level.
+	Slice<uint8> previous_mip = GenerateMip(dp, format, pixels, size, 0);
+	Vec2u previous_size = size;
+
+	for (uint32 i = 1; i < expected_mip_count; i++) {
+		const Vec2u mip_size = ImageResample::GetHalfSize(previous_size);
+
+		SizedArray<uint8> output_data;
+		output_data.InitSize(sizeof(MipHeader) + (mip_size.X * mip_size.Y * ImageFormatUtil::GetPixelStride(format)));
+
+		ImageResample::DownsampleBox4x8(previous_mip.pData + sizeof(MipHeader), previous_size,
+										output_data.pData + sizeof(MipHeader), color_space);
+
+		previous_mip = AddMip(dp, format, output_data, mip_size, i);
+		previous_size = mip_size;
 	}
 
 	dp.WriteToFile(path);
 }
 
+void MipmapGen::GenerateCompressedMipmaps(DataPack& dp, eImageFormat storage_format, const Slice<uint8>& pixels,
+										  const Vec2u& size, ImageResample::eColorSpace color_space)
+{
+	const uint32 expected_mip_count = GetExpectedMipCount(size);
+
+	// The levels are built from one another uncompressed, and each is compressed as it is added. Only the previous
+	// level is kept.
+	SizedArray<uint8> previous_pixels;
+
+	const uint8* previous = pixels.pData;
+	Vec2u previous_size = size;
+
+	AddCompressedMip(dp, storage_format, previous, size, 0);
+
+	for (uint32 i = 1; i < expected_mip_count; i++) {
+		const Vec2u mip_size = ImageResample::GetHalfSize(previous_size);
+
+		SizedArray<uint8> mip_pixels;
+		mip_pixels.InitSize(mip_size.X * mip_size.Y * 4);
+
+		ImageResample::DownsampleBox4x8(previous, previous_size, mip_pixels.pData, color_space);
+
+		AddCompressedMip(dp, storage_format, mip_pixels.pData, mip_size, i);
+
+		previous_pixels = std::move(mip_pixels);
+		previous = previous_pixels.pData;
+		previous_size = mip_size;
+	}
+}
+
+void MipmapGen::AddCompressedMip(DataPack& dp, eImageFormat storage_format, const uint8* pixels, const Vec2u& size,
+								 uint8 mip_level)
+{
+	SizedArray<uint8> output_data;
+	output_data.InitSize(sizeof(MipHeader) + ImageFormatUtil::GetDataSize(storage_format, size));
+
+	BlockCompress::Compress(storage_format, pixels, size, output_data.pData + sizeof(MipHeader));
+
+	AddMip(dp, storage_format, output_data, size, mip_level);
+}
+
 FX_FORCE_INLINE constexpr float32 GetMipDivisor(uint32 mip_level)
 {
 	return 1.0f / (1U << static_cast<uint32>(mip_level));
@@ -85,11 +191,17 @@ Slice<uint8> MipmapGen::GenerateMip(DataPack& dp, eImageFormat format, const Sli
 		}
 	}
 
+	return AddMip(dp, format, output_data, output_dimensions, mip_level);
+}
+
+Slice<uint8> MipmapGen::AddMip(DataPack& dp, eImageFormat format, SizedArray<uint8>& output_data, const Vec2u& size,
+							   uint8 mip_level)
+{
 	// Write header
 	{
 		MipHeader header {
-			.SizeX = static_cast<uint16>(output_dimensions.X),
-			.SizeY = static_cast<uint16>(output_dimensions.Y),
+			.SizeX = static_cast<uint16>(size.X),
+			.SizeY = static_cast<uint16>(size.Y),
 			.MipLevel = static_cast<uint8>(mip_level),
 			.Unused0 = 0,
 			.Format = format,
@@ -99,8 +211,8 @@ Slice<uint8> MipmapGen::GenerateMip(DataPack& dp, eImageFormat format, const Sli
 	}
 
 #ifdef FX_DEBUG_MIPS_SAVE_AS_IMAGES
-	loader::LoaderStb::SaveToFile(eImageSaveFormat::Jpeg, output_data, output_dimensions,
-								  String::Fmt("Mip_{}.jpeg", mip_level), eImageSaveFlags::None);
+	loader::LoaderStb::SaveToFile(eImageSaveFormat::Jpeg, output_data, size, String::Fmt("Mip_{}.jpeg", mip_level),
+								  eImageSaveFlags::None);
 #endif
 
 	dp.AddEntry(mip_level, output_data);
@@ -181,6 +293,11 @@ void MipmapGen::ExportMipmaps(const char* dp_path, const char* output_path)
 
 		MipHeader* header = reinterpret_cast<MipHeader*>(entry.Data.pData);
 
+		if (ImageFormatUtil::IsBlockCompressed(header->Format)) {
+			LogWarning(LC_ASSET, "Cannot export block compressed mip {} of {}", header->MipLevel, dp_path);
+			continue;
+		}
+
 		Slice<uint8> image_data = Slice(entry.Data.pData + sizeof(MipHeader), entry.Data.Size - sizeof(MipHeader));
 
 		loader::LoaderStb::SaveToFile(eImageSaveFormat::Jpeg, image_data, Vec2u(header->SizeX, header->SizeY),
@@ -220,7 +337,7 @@ Image MipmapGen::LoadMipmaps(renderer::CommandBuffer& cmd, const char* path)
 
 	ImageInfo image_info {
 		image_size,						  // Dimensions
-		eImageFormat::RGBA8_UNorm,		  // Format
+		base_header->Format,			  // Format
 		static_cast<int32>(base_mip->Id), // Mip level
 		num_mips,						  // Mips count
 		image_data,						  // Data
@@ -291,16 +408,24 @@ ImageInfo MipmapLoader::GetMip(uint32 mip_level)
 
 ImageInfo MipmapLoader::GetQuality(eQualityLevel quality)
 {
-	ImageInfo image_info {};
-
 	uint32 zero_level = 0;
 	if (quality == eQualityLevel::LowQuality) {
 		zero_level = Pack.Entries.Size() / 2;
 	}
 
+	return GetMipChain(zero_level);
+}
+
+ImageInfo MipmapLoader::GetMipChain(uint32 first_mip)
+{
+	ImageInfo image_info {};
+
+	const uint32 mip_count = GetMipCount();
+	first_mip = std::min(first_mip, mip_count - 1);
+
 	uint64 total_buffer_size = 0;
 
-	for (uint32 i = zero_level; i < Pack.Entries.Size(); i++) {
+	for (uint32 i = first_mip; i < mip_count; i++) {
 		DataPackEntry* mip_entry = Pack.GetEntry(i, true);
 		uint32 image_size = M_DATA_SIZE(mip_entry->Data);
 		total_buffer_size += image_size;
@@ -311,13 +436,11 @@ ImageInfo MipmapLoader::GetQuality(eQualityLevel quality)
 
 	uint64 offset = 0;
 
-	Vec2u zero_level_dimensions;
-
-	for (uint32 i = zero_level; i < Pack.Entries.Size(); i++) {
+	for (uint32 i = first_mip; i < mip_count; i++) {
 		DataPackEntry* mip_entry = Pack.GetEntry(i, true);
 
 		MipHeader* header = M_HEADER_PTR(mip_entry->Data.pData);
-		if (i == zero_level) {
+		if (i == first_mip) {
 			image_info.Size = Vec2u(header->SizeX, header->SizeY);
 			image_info.Format = header->Format;
 		}
@@ -330,14 +453,9 @@ ImageInfo MipmapLoader::GetQuality(eQualityLevel quality)
 		offset += image_size;
 	}
 
-
-	// When we upload the image, we want the image to be created to be the size of Mip 0.
-	// float32 bmm = GetBaseMipMultiplier(mip_level);
-
-	float32 bmm = 1.0f;
-
+	// The image is created with the first mip as level 0
 	image_info.MipLevel = 0;
-	image_info.MipCount = Pack.Entries.Size() - zero_level;
+	image_info.MipCount = mip_count - first_mip;
 
 	image_info.ImageData = Slice<const uint8>(data_to_load, total_buffer_size);
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <Asset/DataPack.hpp>
+#include <Asset/ImageResample.hpp>
 #include <Core/Slice.hpp>
 #include <Math/Vec2.hpp>
 #include <Renderer/Backend/Image.hpp>
@@ -33,7 +34,16 @@ public:
 
 	uint32 GetExpectedMipCount(Vec2u base_size);
 
-	void GenerateMipmaps(const char* path, eImageFormat format, const Slice<uint8>& pixels, const Vec2u& size);
+	/**
+	 * @brief Generates the mip chain of an image and writes it to a datapack at `path`.
+	 *
+	 * @param format The format of `pixels`.
+	 * @param storage_format The format to store the mips as. This can be a block compressed format (see
+	 * `BlockCompress::Compress()`) when `format` is `RGBA8_UNorm` or `RGBA8_SRGB`. If this is `None`, the mips are
+	 * stored as `format`.
+	 */
+	void GenerateMipmaps(const char* path, eImageFormat format, const Slice<uint8>& pixels, const Vec2u& size,
+						 eImageFormat storage_format = eImageFormat::None);
 
 	Slice<uint8> GenerateMip(DataPack& dp, eImageFormat format, const Slice<uint8>& pixels, const Vec2u& size,
 							 uint8 mip_level);
@@ -50,6 +60,23 @@ public:
 
 	~MipmapGen() = default;
 
+private:
+	/**
+	 * @brief Writes the mip header to the start of `output_data` and adds it to the datapack.
+	 * @return The datapack entry's data, including the header.
+	 */
+	Slice<uint8> AddMip(DataPack& dp, eImageFormat format, SizedArray<uint8>& output_data, const Vec2u& size,
+						uint8 mip_level);
+
+	void GenerateCompressedMipmaps(DataPack& dp, eImageFormat storage_format, const Slice<uint8>& pixels,
+								   const Vec2u& size, ImageResample::eColorSpace color_space);
+
+	/**
+	 * @brief Compresses a level of four 8-bit channels to `storage_format` and adds it to the datapack.
+	 */
+	void AddCompressedMip(DataPack& dp, eImageFormat storage_format, const uint8* pixels, const Vec2u& size,
+						  uint8 mip_level);
+
 public:
 };
 
@@ -64,6 +91,14 @@ public:
 
 	ImageInfo GetQuality(eQualityLevel quality);
 
+	/**
+	 * @brief Reads the mip levels from `first_mip` to the end of the chain into one image, with `first_mip` as level 0.
+	 * The pixel data is allocated with `std::malloc()`.
+	 */
+	ImageInfo GetMipChain(uint32 first_mip);
+
+	FX_FORCE_INLINE uint32 GetMipCount() const { return Pack.Entries.Size(); }
+
 private:
 	uint32 FindClosestMipLevel(uint32 mip_level);
 
@@ -27,9 +27,12 @@ enum eStringId
 	FR_SAMPLER2D,
 
 	F_Texture2D,
+	F_Texture2DArray,
 	F_ShadowTexture2D,
+	F_TextureTable,
 
 	F_StructBuffer,
+	F_RWStructBuffer,
 	F_CBuffer,
 
 	// Test definitions
@@ -51,9 +54,12 @@ static constexpr const char* scStrings[] = {
 	"FR_SAMPLER2D",
 
 	"F_Texture2D",
+	"F_Texture2DArray",
 	"F_ShadowTexture2D",
+	"F_TextureTable",
 
 	"F_StructBuffer",
+	"F_RWStructBuffer",
 	"F_CBuffer",
 
 	// Test definitions
@@ -270,6 +276,17 @@ static void ParseTexture2DDefinition(const std::vector<Slice<char>>& params, Sta
 	result.GetReflection().emplace_back(eShaderReflectionType::Texture, 0, slot_n);
 }
 
+static void ParseTextureTableDefinition(const std::vector<Slice<char>>& params, State& state, Result& result)
+{
+	// F_TextureTable(textures, binding, set)
+	REQUIRE_PARAMS(params, 3);
+
+	const int32 binding = ParamGetInt(params[1]);
+	const int32 set = ParamGetInt(params[2]);
+
+	result.GetReflection().emplace_back(eShaderReflectionType::Texture, set, binding);
+}
+
 static void ParseStructBufferDefinition(const std::vector<Slice<char>>& params, State& state, Result& result)
 {
 	// F_StructBuffer(name, objtype, binding, set)
@@ -306,12 +323,15 @@ static const PPFuncEntry PPFunctions[] = {
 	PPFuncEntry(FStr(F_REFLECT), true, false, ParseReflectionDefinition),
 	PPFuncEntry(FStr(F_PARAMTEST), true, false, ParseParamTestDefinition),
 
-	// Texture definition macros
+	// Texture definition macros. Names are matched by prefix, so `F_Texture2DArray` is checked before `F_Texture2D`.
+	PPFuncEntry(FStr(F_Texture2DArray), true, true, ParseTexture2DDefinition),
 	PPFuncEntry(FStr(F_Texture2D), true, true, ParseTexture2DDefinition),
 	PPFuncEntry(FStr(F_ShadowTexture2D), true, true, ParseTexture2DDefinition),
+	PPFuncEntry(FStr(F_TextureTable), true, true, ParseTextureTableDefinition),
 
 	// Buffer definition macros
 	PPFuncEntry(FStr(F_StructBuffer), true, true, ParseStructBufferDefinition),
+	PPFuncEntry(FStr(F_RWStructBuffer), true, true, ParseStructBufferDefinition),
 	PPFuncEntry(FStr(F_CBuffer), true, true, ParseCBufferDefinition),
 
 };
@@ -0,0 +1,100 @@
+#include "Arena.hpp"
+
+#include <Core/MemPool/MemPool.hpp>
+
+namespace fx {
+
+static constexpr uint64 AlignUp(uint64 value, uint64 alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+Arena::Chunk* Arena::NewChunk(uint64 min_size)
+{
+	const uint64 capacity = (min_size > mChunkSize) ? min_size : mChunkSize;
+
+	void* memory = mpPool->AllocRaw(sizeof(Chunk) + capacity);
+	if (memory == nullptr) {
+		Panic("Arena", "Could not allocate arena chunk", 0);
+		return nullptr;
+	}
+
+	Chunk* chunk = ::new (memory) Chunk;
+	chunk->Capacity = capacity;
+	chunk->pNext = mpCurrentChunk;
+
+	mpCurrentChunk = chunk;
+	mCapacity += capacity;
+
+	return chunk;
+}
+
+/**
+ * Returns the offset of the first byte at or after `used` in the chunk data at `data` whose address is aligned to
+ * `alignment`. The address is aligned rather than the offset, as the data starts after the chunk header.
+ */
+static uint64 GetAlignedOffset(uint8* data, uint64 used, uint64 alignment)
+{
+	const uintptr_t start = reinterpret_cast<uintptr_t>(data);
+
+	return AlignUp(start + used, alignment) - start;
+}
+
+void* Arena::AllocRaw(uint64 size, uint64 alignment)
+{
+	Chunk* chunk = mpCurrentChunk;
+
+	if (chunk) {
+		const uint64 offset = GetAlignedOffset(chunk->GetData(), chunk->Used, alignment);
+
+		if (offset + size <= chunk->Capacity) {
+			chunk->Used = offset + size;
+			mBytesUsed += size;
+
+			return chunk->GetData() + offset;
+		}
+	}
+
+	// Reserve enough space to align the allocation within the new chunk
+	chunk = NewChunk(size + alignment);
+
+	const uint64 offset = GetAlignedOffset(chunk->GetData(), chunk->Used, alignment);
+
+	chunk->Used = offset + size;
+	mBytesUsed += size;
+
+	return chunk->GetData() + offset;
+}
+
+void Arena::AddDestructor(void* object, void (*destruct)(void*))
+{
+	DestructorEntry* entry = static_cast<DestructorEntry*>(AllocRaw(sizeof(DestructorEntry), alignof(DestructorEntry)));
+
+	entry->Destruct = destruct;
+	entry->pObject = object;
+	entry->pNext = mpDestructors;
+
+	mpDestructors = entry;
+}
+
+void Arena::Reset()
+{
+	// Entries are pushed to the front of the list, so this runs in reverse order of allocation
+	for (DestructorEntry* entry = mpDestructors; entry != nullptr; entry = entry->pNext) {
+		entry->Destruct(entry->pObject);
+	}
+
+	mpDestructors = nullptr;
+
+	Chunk* chunk = mpCurrentChunk;
+
+	while (chunk) {
+		Chunk* next = chunk->pNext;
+		mpPool->FreeRaw(chunk);
+		chunk = next;
+	}
+
+	mpCurrentChunk = nullptr;
+
+	mBytesUsed = 0;
+	mCapacity = 0;
+}
+
+} // namespace fx
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <Core/Assert.hpp>
+#include <Core/Types.hpp>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fx {
+
+class MemPool;
+
+/**
+ * @brief A linear allocator that hands out memory from large chunks. Individual allocations are never freed, all of
+ * the memory is released at once with `Reset()` or when the arena is destroyed.
+ *
+ * Objects that are not trivially destructible have their destructors run on reset, in reverse order of allocation.
+ */
+class Arena
+{
+	struct Chunk
+	{
+		Chunk* pNext = nullptr;
+		uint64 Capacity = 0;
+		uint64 Used = 0;
+
+		uint8* GetData() { return reinterpret_cast<uint8*>(this + 1); }
+	};
+
+	struct DestructorEntry
+	{
+		void (*Destruct)(void* object) = nullptr;
+		void* pObject = nullptr;
+		DestructorEntry* pNext = nullptr;
+	};
+
+public:
+	static constexpr uint64 scDefaultChunkSize = 64 * 1024;
+
+public:
+	/**
+	 * @param pool The pool that chunks are allocated from.
+	 * @param chunk_size The minimum size of each chunk. Allocations larger than this get their own chunk.
+	 */
+	explicit Arena(MemPool* pool, uint64 chunk_size = scDefaultChunkSize) : mpPool(pool), mChunkSize(chunk_size) {}
+
+	Arena(const Arena& other) = delete;
+	Arena& operator=(const Arena& other) = delete;
+
+	void* AllocRaw(uint64 size, uint64 alignment = alignof(std::max_align_t));
+
+	/**
+	 * @brief Allocates and constructs an object in the arena.
+	 */
+	template <typename T, typename... TArgs>
+	T* Alloc(TArgs&&... args)
+	{
+		void* memory = AllocRaw(sizeof(T), alignof(T));
+		T* object = ::new (memory) T(std::forward<TArgs>(args)...);
+
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			AddDestructor(object, [](void* ptr) { static_cast<T*>(ptr)->~T(); });
+		}
+
+		return object;
+	}
+
+	/**
+	 * @brief Allocates an uninitialized array of `count` elements. The elements are not destroyed on reset.
+	 */
+	template <typename T>
+	T* AllocArray(uint64 count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Arena arrays must be trivially destructible");
+		return static_cast<T*>(AllocRaw(sizeof(T) * count, alignof(T)));
+	}
+
+	/**
+	 * @brief Copies a string into the arena and null terminates it.
+	 */
+	char* CopyString(const char* str, uint64 length)
+	{
+		char* buffer = AllocArray<char>(length + 1);
+
+		std::memcpy(buffer, str, length);
+		buffer[length] = 0;
+
+		return buffer;
+	}
+
+	/**
+	 * @brief Runs the destructors of all objects in the arena and releases every chunk.
+	 */
+	void Reset();
+
+	/// The total number of bytes handed out since the last reset.
+	uint64 GetBytesUsed() const { return mBytesUsed; }
+
+	/// The number of bytes allocated from the pool for chunks.
+	uint64 GetCapacity() const { return mCapacity; }
+
+	~Arena() { Reset(); }
+
+private:
+	void AddDestructor(void* object, void (*destruct)(void*));
+
+	Chunk* NewChunk(uint64 min_size);
+
+private:
+	MemPool* mpPool = nullptr;
+	uint64 mChunkSize = scDefaultChunkSize;
+
+	Chunk* mpCurrentChunk = nullptr;
+	DestructorEntry* mpDestructors = nullptr;
+
+	uint64 mBytesUsed = 0;
+	uint64 mCapacity = 0;
+};
+
+/**
+ * @brief A growable array that stores its elements in an arena. The storage moves when the array grows, so pointers
+ * to elements are only stable once the array is no longer being appended to.
+ */
+template <typename TElementType>
+class ArenaArray
+{
+	static_assert(std::is_trivially_copyable_v<TElementType> && std::is_trivially_destructible_v<TElementType>,
+				  "ArenaArray elements are copied with memcpy and never destroyed");
+
+	static constexpr uint32 scMinCapacity = 8;
+
+public:
+	ArenaArray() = default;
+	explicit ArenaArray(Arena* arena) : mpArena(arena) {}
+
+	void Init(Arena* arena) { mpArena = arena; }
+
+	void Reserve(uint32 capacity)
+	{
+		if (capacity <= mCapacity) {
+			return;
+		}
+
+		AssertMsg(mpArena != nullptr, "ArenaArray has not been initialized with an arena");
+
+		TElementType* new_data = mpArena->AllocArray<TElementType>(capacity);
+
+		if (mpData) {
+			std::memcpy(static_cast<void*>(new_data), mpData, sizeof(TElementType) * mSize);
+		}
+
+		// The old storage is left in the arena and released with everything else
+		mpData = new_data;
+		mCapacity = capacity;
+	}
+
+	TElementType* Insert(const TElementType& value)
+	{
+		if (mSize >= mCapacity) {
+			Reserve(mCapacity ? mCapacity * 2 : scMinCapacity);
+		}
+
+		TElementType* element = &mpData[mSize++];
+		*element = value;
+
+		return element;
+	}
+
+	void RemoveLast()
+	{
+		if (mSize > 0) {
+			--mSize;
+		}
+	}
+
+	FX_FORCE_INLINE TElementType& operator[](uint32 index)
+	{
+		DebugAssert(index < mSize);
+		return mpData[index];
+	}
+
+	FX_FORCE_INLINE const TElementType& operator[](uint32 index) const
+	{
+		DebugAssert(index < mSize);
+		return mpData[index];
+	}
+
+	FX_FORCE_INLINE TElementType& GetLast() { return (*this)[mSize - 1]; }
+
+	FX_FORCE_INLINE uint32 Size() const { return mSize; }
+	FX_FORCE_INLINE bool IsEmpty() const { return mSize == 0; }
+
+	TElementType* begin() { return mpData; }
+	TElementType* end() { return mpData + mSize; }
+	const TElementType* begin() const { return mpData; }
+	const TElementType* end() const { return mpData + mSize; }
+
+private:
+	Arena* mpArena = nullptr;
+
+	TElementType* mpData = nullptr;
+	uint32 mSize = 0;
+	uint32 mCapacity = 0;
+};
+
+} // namespace fx
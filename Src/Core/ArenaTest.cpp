@@ -0,0 +1,57 @@
+#include "ArenaTest.hpp"
+
+#include <Core/Arena.hpp>
+#include <Core/Log.hpp>
+
+namespace fx {
+
+/// Small enough that every allocation in the test fits in the first chunk.
+static constexpr uint64 scTestChunkSize = 1024;
+
+static bool CheckAllocation(Arena& arena, uint64 size, uint64 alignment, uint32 index)
+{
+	const uintptr_t address = reinterpret_cast<uintptr_t>(arena.AllocRaw(size, alignment));
+
+	if ((address % alignment) != 0) {
+		LogError(LC_CORE, "Arena test: allocation {} ({} bytes) is not aligned to {} bytes (address {:#x})", index, size,
+				 alignment, address);
+		return false;
+	}
+
+	return true;
+}
+
+bool ArenaTestAlignment(MemPool* pool)
+{
+	Arena arena(pool, scTestChunkSize);
+
+	bool passed = true;
+	uint32 index = 0;
+
+	// The first allocation creates the chunk, and leaves the next free byte unaligned
+	passed &= CheckAllocation(arena, 1, 1, index++);
+
+	const uint64 capacity = arena.GetCapacity();
+
+	for (uint32 i = 0; i < 8; i++) {
+		passed &= CheckAllocation(arena, 16, 16, index++);
+
+		// Unaligned allocations in between, so each aligned allocation starts from a different offset
+		passed &= CheckAllocation(arena, (i % 3) + 1, 1, index++);
+	}
+
+	passed &= CheckAllocation(arena, 32, 32, index++);
+	passed &= CheckAllocation(arena, 64, 64, index++);
+
+	if (arena.GetCapacity() != capacity) {
+		LogError(LC_CORE, "Arena test: allocations did not fit in the first chunk");
+		passed = false;
+	}
+
+	LogInfo(LC_CORE, "Arena alignment test {} ({} allocations, {} bytes used)", passed ? "passed" : "failed", index,
+			arena.GetBytesUsed());
+
+	return passed;
+}
+
+} // namespace fx
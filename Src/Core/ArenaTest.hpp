@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx {
+
+class MemPool;
+
+/**
+ * @brief Makes several aligned allocations from one chunk of an arena, after an allocation that leaves the chunk
+ * unaligned, and checks the address of each allocation.
+ *
+ * @returns False if any allocation is misaligned or did not fit in the first chunk.
+ */
+bool ArenaTestAlignment(MemPool* pool);
+
+} // namespace fx
@@ -0,0 +1,109 @@
+#include "CpuFeatures.hpp"
+
+#include <Core/Log.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#ifdef FX_USE_CPU_DISPATCH
+#include <cpuid.h>
+#endif
+
+namespace fx {
+
+static constexpr const char* scTierNames[] = { "scalar", "sse4", "avx2", "avx512" };
+
+const CpuFeatures& CpuFeatures::GetInstance()
+{
+	static CpuFeatures sInstance;
+	return sInstance;
+}
+
+CpuFeatures::CpuFeatures() { Detect(); }
+
+const char* CpuFeatures::GetTierName(eCpuTier tier) { return scTierNames[static_cast<uint32>(tier)]; }
+
+bool CpuFeatures::SupportsTier(eCpuTier tier) const { return static_cast<uint32>(tier) <= static_cast<uint32>(mTier); }
+
+#ifdef FX_USE_CPU_DISPATCH
+
+/**
+ * Reads XCR0, which has the register states that the OS saves on context switches.
+ */
+static uint64 ReadXCR0()
+{
+	uint32 eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+
+	return (static_cast<uint64>(edx) << 32) | eax;
+}
+
+#endif
+
+void CpuFeatures::Detect()
+{
+#if defined FX_USE_CPU_DISPATCH
+	uint32 eax, ebx, ecx, edx;
+
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		const bool has_avx = (ecx & bit_AVX) != 0;
+		const uint64 xcr0 = ((ecx & bit_OSXSAVE) != 0) ? ReadXCR0() : 0;
+
+		// AVX needs the OS to save the XMM and YMM registers, and AVX-512 also needs the opmask and ZMM registers
+		const bool os_saves_ymm = (xcr0 & 0x06) == 0x06;
+		const bool os_saves_zmm = (xcr0 & 0xE6) == 0xE6;
+
+		bHasSSE41 = (ecx & bit_SSE4_1) != 0;
+		bHasFMA = has_avx && os_saves_ymm && (ecx & bit_FMA) != 0;
+
+		if (__get_cpuid_max(0, nullptr) >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+			bHasAVX2 = has_avx && os_saves_ymm && (ebx & bit_AVX2) != 0;
+			bHasAVX512F = os_saves_zmm && (ebx & bit_AVX512F) != 0;
+		}
+	}
+
+	if (bHasAVX2 && bHasFMA && bHasAVX512F) {
+		mTier = eCpuTier::AVX512;
+	}
+	else if (bHasAVX2 && bHasFMA) {
+		mTier = eCpuTier::AVX2;
+	}
+	else if (bHasSSE41) {
+		mTier = eCpuTier::SSE4;
+	}
+#elif defined FX_USE_AVX
+	// AVX builds without dispatch require AVX2 and FMA at compile time (see Core/Defines.hpp)
+	bHasSSE41 = true;
+	bHasAVX2 = true;
+	bHasFMA = true;
+
+	mTier = eCpuTier::AVX2;
+#endif
+
+	const char* tier_override = getenv("FX_CPU_TIER");
+
+	if (tier_override == nullptr) {
+		return;
+	}
+
+	for (uint32 index = 0; index < std::size(scTierNames); index++) {
+		if (strcmp(tier_override, scTierNames[index]) != 0) {
+			continue;
+		}
+
+		const eCpuTier requested_tier = static_cast<eCpuTier>(index);
+
+		if (!SupportsTier(requested_tier)) {
+			LogWarning(LC_CORE, "CPU tier {} requested by FX_CPU_TIER is not supported, using {}", tier_override,
+					   GetTierName(mTier));
+			return;
+		}
+
+		mTier = requested_tier;
+		return;
+	}
+
+	LogWarning(LC_CORE, "Unknown CPU tier '{}' in FX_CPU_TIER", tier_override);
+}
+
+} // namespace fx
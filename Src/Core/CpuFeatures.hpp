@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx {
+
+/**
+ * @brief Instruction set levels that dispatched kernels are compiled for, from lowest to highest.
+ */
+enum class eCpuTier : uint8
+{
+	Scalar,
+	SSE4,
+	AVX2,
+	AVX512,
+};
+
+/**
+ * @brief Instruction set extensions supported by the host CPU, detected once with `cpuid` on first use.
+ *
+ * Hot path kernels (batch math, bounds, mip downsampling and vertex conversion) are compiled for each tier and pick
+ * the implementation for `GetTier()` the first time that they are called. On builds without runtime dispatch (see
+ * `FX_USE_CPU_DISPATCH`), the tier is the one selected at compile time.
+ *
+ * The tier can be lowered for testing by setting the `FX_CPU_TIER` environment variable to `scalar`, `sse4`, `avx2`
+ * or `avx512`. It is never raised above what the CPU supports.
+ */
+class CpuFeatures
+{
+public:
+	static const CpuFeatures& GetInstance();
+
+	FX_FORCE_INLINE eCpuTier GetTier() const { return mTier; }
+
+	/**
+	 * @brief Returns true if kernels for `tier` can run on this CPU.
+	 */
+	bool SupportsTier(eCpuTier tier) const;
+
+	static const char* GetTierName(eCpuTier tier);
+
+private:
+	CpuFeatures();
+
+	void Detect();
+
+public:
+	bool bHasSSE41 = false;
+	bool bHasAVX2 = false;
+	bool bHasFMA = false;
+	bool bHasAVX512F = false;
+
+private:
+	eCpuTier mTier = eCpuTier::Scalar;
+};
+
+} // namespace fx
@@ -1,6 +1,7 @@
 #pragma once
 
 #define FX_MEMORY_ENGINE_POOL_SIZE (1024ULL * 20)
+#define FX_MEMORY_SCRIPT_POOL_SIZE (1024ULL * 1024)
 
 ////////////////////////////
 // Settings
@@ -39,6 +40,12 @@
 
 // #define FX_NO_DEBUG_ASSERTS
 
+/// Disables the FoxScript JIT, all procs are run in the interpreter.
+// #define FX_NO_FOX_JIT
+
+/// Disables runtime CPU dispatch, hot path kernels only use the instruction set selected at compile time.
+// #define FX_NO_CPU_DISPATCH
+
 
 ////////////////////////////////
 // Platform/Compiler macros
@@ -75,13 +82,42 @@
 #define FX_USE_NEON 1
 #define FX_USE_SIMD 1
 
-#elif defined __AVX2__ || defined FX_PLATFORM_WINDOWS || defined FX_USE_SIMDE
+// The x86 type layer needs SSE4.1, and uses AVX2 and FMA when they are enabled (see Math/SSE.hpp)
+#elif defined __AVX2__ || defined __SSE4_1__ || defined FX_PLATFORM_WINDOWS || defined FX_USE_SIMDE
 #define FX_USE_AVX	1
 #define FX_USE_SIMD 1
 #else
 #define FX_NO_SIMD 1
 #endif
 
+// On x86-64 with GCC and Clang, hot path kernels are compiled for several instruction sets using the target attribute,
+// and the best one for the host CPU is chosen at startup (see Core/CpuFeatures.hpp). The rest of the build only needs
+// the instruction set that it is compiled for, so a build for SSE4.1 runs the AVX2 and AVX-512 kernels on CPUs that
+// have them. Other builds, including SIMDe builds for other architectures, use the kernels for the compile time SIMD
+// selection above.
+#if !defined FX_NO_CPU_DISPATCH && !defined FX_USE_SIMDE && (defined __x86_64__) &&                                   \
+	(defined FX_COMPILER_GCC || defined FX_COMPILER_CLANG)
+#define FX_USE_CPU_DISPATCH 1
+
+#define FX_TARGET_SSE4	 __attribute__((target("sse4.1")))
+#define FX_TARGET_AVX2	 __attribute__((target("avx2,fma")))
+#define FX_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define FX_TARGET_SSE4
+#define FX_TARGET_AVX2
+#define FX_TARGET_AVX512
+
+// Without dispatch, the AVX kernels are compiled for the build's instruction set
+#if defined FX_USE_AVX && !defined __AVX2__ && !defined FX_PLATFORM_WINDOWS && !defined FX_USE_SIMDE
+#error "Builds without runtime CPU dispatch need AVX2 and FMA (-mavx2 -mfma)"
+#endif
+#endif
+
+// The FoxScript JIT emits code for the System V x86-64 ABI
+#if !defined FX_NO_FOX_JIT && (defined __x86_64__ || defined _M_X64) && !defined FX_PLATFORM_WINDOWS
+#define FX_USE_FOX_JIT 1
+#endif
+
 #ifdef NDEBUG
 #define FX_BUILD_RELEASE
 #else
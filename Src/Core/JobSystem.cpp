@@ -0,0 +1,164 @@
+#include "JobSystem.hpp"
+
+#include <Core/Log.hpp>
+
+namespace fx {
+
+void JobSystem::Start(uint32 num_workers)
+{
+	if (mbRunning.load()) {
+		return;
+	}
+
+	if (num_workers == 0) {
+		const uint32 hardware_threads = std::thread::hardware_concurrency();
+		num_workers = (hardware_threads > 1) ? hardware_threads - 1 : 0;
+	}
+
+	mbRunning.store(true);
+
+	mWorkers.reserve(num_workers);
+	for (uint32 i = 0; i < num_workers; i++) {
+		mWorkers.emplace_back([this]() { WorkerUpdate(); });
+	}
+
+	LogInfo(LC_CORE, "Started job system with {} workers", num_workers);
+}
+
+void JobSystem::Shutdown()
+{
+	if (!mbRunning.load()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mbRunning.store(false);
+	}
+
+	mJobReady.notify_all();
+
+	for (std::thread& worker : mWorkers) {
+		worker.join();
+	}
+
+	mWorkers.clear();
+
+	// Run anything that was left in the queue so no counters are left waiting
+	while (TryRunJob()) {
+	}
+}
+
+void JobSystem::Submit(JobFunction&& func, JobCounter* counter)
+{
+	if (counter) {
+		counter->Pending.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// No workers to run the job, run it now
+	if (mWorkers.empty()) {
+		Job job { std::move(func), counter };
+		RunJob(job);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back(Job { std::move(func), counter });
+	}
+
+	mJobReady.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	while (!counter.IsDone()) {
+		// Help out with the queue instead of blocking. If there is nothing to take then the remaining jobs are being
+		// run by other threads.
+		if (!TryRunJob()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(uint32 count, uint32 batch_size, const JobRangeFunction& func)
+{
+	if (count == 0) {
+		return;
+	}
+
+	if (batch_size == 0) {
+		batch_size = 1;
+	}
+
+	// Not worth the dispatch, run on this thread
+	if (mWorkers.empty() || count <= batch_size) {
+		func(0, count);
+		return;
+	}
+
+	JobCounter counter;
+
+	for (uint32 start = batch_size; start < count; start += batch_size) {
+		const uint32 end = std::min(start + batch_size, count);
+		Submit([&func, start, end]() { func(start, end); }, &counter);
+	}
+
+	// Run the first batch on the calling thread
+	func(0, batch_size);
+
+	Wait(counter);
+}
+
+bool JobSystem::TryRunJob()
+{
+	Job job;
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (mJobs.empty()) {
+			return false;
+		}
+
+		job = std::move(mJobs.front());
+		mJobs.pop_front();
+	}
+
+	RunJob(job);
+
+	return true;
+}
+
+void JobSystem::RunJob(Job& job)
+{
+	job.Func();
+
+	if (job.pCounter) {
+		job.pCounter->Pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void JobSystem::WorkerUpdate()
+{
+	while (true) {
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mJobReady.wait(lock, [this]() { return !mJobs.empty() || !mbRunning.load(); });
+
+			if (mJobs.empty()) {
+				// Woken with no jobs, we are shutting down
+				return;
+			}
+
+			job = std::move(mJobs.front());
+			mJobs.pop_front();
+		}
+
+		RunJob(job);
+	}
+}
+
+} // namespace fx
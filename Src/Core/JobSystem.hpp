@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fx {
+
+/**
+ * @brief Tracks a group of submitted jobs. Waiting on a counter blocks until every job that was submitted with it has
+ * completed.
+ */
+struct JobCounter
+{
+	std::atomic<int32> Pending = { 0 };
+
+	bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+};
+
+using JobFunction = std::function<void()>;
+using JobRangeFunction = std::function<void(uint32 start, uint32 end)>;
+
+/**
+ * @brief A small fixed-size worker pool for short CPU jobs.
+ *
+ * Threads that wait on a counter help to execute queued jobs, so it is safe to submit and wait on jobs from within
+ * another job. If the job system has no workers, all jobs are run on the calling thread.
+ */
+class JobSystem
+{
+	struct Job
+	{
+		JobFunction Func;
+		JobCounter* pCounter = nullptr;
+	};
+
+public:
+	JobSystem() = default;
+
+	/**
+	 * @brief Starts the worker threads. If `num_workers` is zero, the worker count is based on the number of hardware
+	 * threads, leaving one for the main thread.
+	 */
+	void Start(uint32 num_workers = 0);
+	void Shutdown();
+
+	/**
+	 * @brief Queues a job to be run on a worker thread.
+	 * @param counter An optional counter that can be used to wait on the job.
+	 */
+	void Submit(JobFunction&& func, JobCounter* counter = nullptr);
+
+	/**
+	 * @brief Waits for all jobs submitted with `counter` to complete. The calling thread runs queued jobs while waiting.
+	 */
+	void Wait(JobCounter& counter);
+
+	/**
+	 * @brief Runs `func` over the range [0, count) in batches of `batch_size`, and waits for all batches to complete.
+	 */
+	void ParallelFor(uint32 count, uint32 batch_size, const JobRangeFunction& func);
+
+	FX_FORCE_INLINE uint32 GetWorkerCount() const { return static_cast<uint32>(mWorkers.size()); }
+
+	~JobSystem() { Shutdown(); }
+
+private:
+	void WorkerUpdate();
+
+	bool TryRunJob();
+	void RunJob(Job& job);
+
+private:
+	std::vector<std::thread> mWorkers;
+	std::deque<Job> mJobs;
+
+	std::mutex mMutex;
+	std::condition_variable mJobReady;
+
+	std::atomic_bool mbRunning = { false };
+};
+
+} // namespace fx
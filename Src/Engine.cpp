@@ -1,12 +1,18 @@
 #include "Engine.hpp"
 
+#include <AnimationManager.hpp>
 #include <Asset/AssetManager.hpp>
 #include <Asset/ShaderCompiler.hpp>
+#include <Core/CpuFeatures.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/Log.hpp>
 #include <Core/MemPool/MemPool.hpp>
 #include <Material/MaterialManager.hpp>
 #include <Object/ObjectManager.hpp>
 #include <Physics/PhJolt.hpp>
+#include <Script/FoxBytecodeCache.hpp>
 #include <Texture/TextureManager.hpp>
+#include <Texture/TextureStreamer.hpp>
 #include <WorldGrid.hpp>
 
 namespace fx {
@@ -18,7 +24,11 @@ ShaderCompiler* gShaderCompiler = nullptr;
 AssetManager* gAssetManager = nullptr;
 ObjectManager* gObjectManager = nullptr;
 TextureManager* gTextureManager = nullptr;
+TextureStreamer* gTextureStreamer = nullptr;
 MaterialManager* gMaterialManager = nullptr;
+AnimationManager* gAnimationManager = nullptr;
+
+JobSystem* gJobSystem = nullptr;
 
 MemPool* gEnginePool = nullptr;
 MemPool* gScriptMemPool = nullptr;
@@ -33,6 +43,13 @@ namespace Globals {
 
 void Init()
 {
+	// Detect the CPU before any dispatched kernels run, so the selected tier is logged at startup
+	const CpuFeatures& cpu_features = CpuFeatures::GetInstance();
+	LogInfo(LC_CORE, "Using {} kernels", CpuFeatures::GetTierName(cpu_features.GetTier()));
+
+	gJobSystem = new JobSystem;
+	gJobSystem->Start();
+
 	gPhysics = new PhJolt;
 	gAssetManager = new AssetManager;
 	gShaderCompiler = new ShaderCompiler;
@@ -40,6 +57,8 @@ void Init()
 	gMaterialManager = new MaterialManager;
 	gWorldGrid = new WorldGrid;
 	gTextureManager = new TextureManager;
+	gTextureStreamer = new TextureStreamer;
+	gAnimationManager = new AnimationManager;
 }
 
 
@@ -48,7 +67,17 @@ void Destroy()
 	DESTROY_GLOBAL(gPhysics);
 	DESTROY_GLOBAL(gShaderCompiler);
 	DESTROY_GLOBAL(gMaterialManager);
+
+	// Destroyed materials unregister from the streamer, and its loads run on the job system
+	DESTROY_GLOBAL(gTextureStreamer);
 	DESTROY_GLOBAL(gWorldGrid);
+	DESTROY_GLOBAL(gAnimationManager);
+
+	// Release any shared script modules and VM contexts while the memory pools are still alive
+	script::FoxBytecodeCache::GetInstance().ReleaseModules();
+	script::FoxVMContextPool::GetInstance().Destroy();
+
+	DESTROY_GLOBAL(gJobSystem);
 }
 
 } // namespace Globals
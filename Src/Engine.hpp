@@ -27,6 +27,15 @@ extern WorldGrid* gWorldGrid;
 class TextureManager;
 extern TextureManager* gTextureManager;
 
+class TextureStreamer;
+extern TextureStreamer* gTextureStreamer;
+
+class JobSystem;
+extern JobSystem* gJobSystem;
+
+class AnimationManager;
+extern AnimationManager* gAnimationManager;
+
 
 namespace Globals {
 void Init();
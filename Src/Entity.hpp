@@ -53,6 +53,9 @@ public:
 
 	virtual void OnAttached(Scene* scene) {}
 
+	/**
+	 * @brief Rotate the entity by `rad` radians about its local X, Y or Z axis.
+	 */
 	void RotateX(float32 rad);
 	void RotateY(float32 rad);
 	void RotateZ(float32 rad);
@@ -63,6 +66,7 @@ public:
 	// const Mat4f& GetNormalMatrix();
 
 	const Vec3f& GetPosition() const { return mPosition; }
+	FX_FORCE_INLINE float32 GetScale() const { return mScale; }
 
 	FX_FORCE_INLINE void MarkTransformOutOfDate()
 	{
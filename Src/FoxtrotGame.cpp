@@ -5,6 +5,7 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_revision.h>
 
+#include <AnimationManager.hpp>
 #include <Asset/AssetManager.hpp>
 #include <Asset/ConfigFile.hpp>
 #include <Asset/Font/Font.hpp>
@@ -24,7 +25,9 @@
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/RenderBackend.hpp>
 #include <Renderer/ShadowDirectional.hpp>
+#include <Script/FoxScriptScheduler.hpp>
 #include <Texture/TextureManager.hpp>
+#include <Texture/TextureStreamer.hpp>
 #include <csignal>
 
 FX_SET_MODULE_NAME("FoxtrotGame");
@@ -91,6 +94,16 @@ void FoxtrotGame::InitEngine()
 	Player.HeadBobStrength.X = bob_entry->GetMemberValue(HashStr32("ScaleX"), 0.011);
 	Player.HeadBobStrength.Y = bob_entry->GetMemberValue(HashStr32("ScaleY"), 0.018);
 
+	ConfigEntry* textures_entry = Config.GetEntry(HashStr32("Textures"));
+
+	if (textures_entry != nullptr) {
+		const bool pack_textures = static_cast<bool>(textures_entry->GetMemberValue(HashStr32("PackSmallTextures"), 0));
+		gMaterialManager->bPackTextures = pack_textures;
+
+		const bool bindless_textures = static_cast<bool>(textures_entry->GetMemberValue(HashStr32("Bindless"), 1));
+		gMaterialManager->bBindlessTextures = bindless_textures;
+	}
+
 	gRenderer->SelectWindow(window);
 	gRenderer->Init(Vec2u(window_width, window_height));
 
@@ -533,6 +546,9 @@ void FoxtrotGame::Tick()
 	Player.Move(DeltaTime, GetMovementVector());
 	Player.Update(DeltaTime);
 
+	// Resume any scripts whose pause has elapsed
+	script::FoxScriptScheduler::GetInstance().Update();
+
 
 	if (EditorModeType != eEditorMode::Default) {
 		SelectedEditorMode->Update(mMainScene, GetEditorMovementVector());
@@ -583,11 +599,23 @@ void FoxtrotGame::Tick()
 
 	gPhysics->Update();
 
+	// Evaluate skeletal animation and write the skinning palettes for this frame
+	gAnimationManager->Update(static_cast<float32>(DeltaTime));
+
 	FrameData* frame = gRenderer->GetFrame();
 
 	frame->CmdBuffer.Reset();
 	frame->CmdBuffer.Record();
 
+	// Add and evict streamed mip levels before any pass samples the textures
+	gTextureStreamer->Update(frame->CmdBuffer);
+
+	// Pack the textures of materials that have finished loading, before the render lists are drawn
+	gMaterialManager->Update(frame->CmdBuffer);
+
+	// Skin the animated meshes once for both the shadow and geometry passes
+	mMainScene.RenderSkinning();
+
 	mMainScene.RenderShadows(&gShadowRenderer->ShadowCamera);
 	mMainScene.Render(&gShadowRenderer->ShadowCamera);
 
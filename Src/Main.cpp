@@ -3,13 +3,16 @@
 
 #include "FoxtrotGame.hpp"
 
+#include <Asset/AnimationBenchmark.hpp>
 #include <Asset/AssetManager.hpp>
 #include <Asset/ConfigFile.hpp>
 #include <Asset/DataPack.hpp>
 #include <Asset/Font/Font.hpp>
+#include <Asset/MeshLoadTest.hpp>
 #include <Asset/MipmapGen.hpp>
 #include <Asset/ShaderCompiler.hpp>
 #include <Asset/ShaderPreproc.hpp>
+#include <Core/ArenaTest.hpp>
 #include <Core/Defer.hpp>
 #include <Core/FilesystemIO.hpp>
 #include <Core/FreeArray.hpp>
@@ -18,13 +21,23 @@
 #include <Core/Queue.hpp>
 #include <Core/String.hpp>
 #include <Engine.hpp>
+#include <Math/MathBenchmark.hpp>
 #include <Math/MathConsts.hpp>
 #include <Math/MathUtil.hpp>
 #include <Renderer/Globals.hpp>
+#include <Script/FoxBenchmark.hpp>
 #include <Script/FoxScript.hpp>
 
 // #define FX_RUN_TEST
 // #define FX_TEST_SCRIPT
+// #define FX_BENCH_SCRIPT_COMPILE
+// #define FX_BENCH_SCRIPT_JIT
+// #define FX_TEST_SCRIPT_JIT
+// #define FX_TEST_SCRIPT_QUAT_ROTATE
+// #define FX_BENCH_MATH_BATCH
+// #define FX_BENCH_ANIMATION
+// #define FX_TEST_MESH_LOAD
+// #define FX_TEST_ARENA
 
 FX_SET_MODULE_NAME("Main")
 
@@ -38,7 +51,7 @@ int main()
 	fx::gEnginePool->Create(FX_MEMORY_ENGINE_POOL_SIZE);
 
 	fx::gScriptMemPool = new fx::MemPool;
-	fx::gScriptMemPool->Create(1024 * 64);
+	fx::gScriptMemPool->Create(FX_MEMORY_SCRIPT_POOL_SIZE);
 
 
 #ifdef FX_TEST_SCRIPT
@@ -55,6 +68,40 @@ int main()
 	LogInfo("Value: {}", value);
 #endif
 
+#ifdef FX_BENCH_SCRIPT_COMPILE
+	script::FoxBenchmarkCompile();
+#endif
+
+#ifdef FX_BENCH_SCRIPT_JIT
+	script::FoxBenchmarkJit();
+#endif
+
+#ifdef FX_TEST_SCRIPT_JIT
+	script::FoxTestJitScripts();
+#endif
+
+#ifdef FX_TEST_SCRIPT_QUAT_ROTATE
+	script::FoxTestQuatRotate();
+#endif
+
+#ifdef FX_BENCH_MATH_BATCH
+	MathBenchmarkBatch();
+#endif
+
+#ifdef FX_BENCH_ANIMATION
+	AnimationBenchmarkSampling();
+	AnimationBenchmarkPose();
+	AnimationBenchmarkCompression();
+#endif
+
+#ifdef FX_TEST_MESH_LOAD
+	MeshLoadTestWithoutNormals();
+#endif
+
+#ifdef FX_TEST_ARENA
+	ArenaTestAlignment(gScriptMemPool);
+#endif
+
 #ifndef FX_RUN_TEST
 	fx::renderer::Globals::Init();
 
@@ -15,6 +15,7 @@
 #include <Asset/MipmapGen.hpp>
 #include <Core/Defines.hpp>
 #include <Core/StackArray.hpp>
+#include <Engine.hpp>
 #include <Object/ObjectManager.hpp>
 #include <Renderer/Backend/Commands.hpp>
 #include <Renderer/Backend/DescriptorCache.hpp>
@@ -27,6 +28,7 @@
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/RenderBackend.hpp>
 #include <Texture/TextureManager.hpp>
+#include <Texture/TextureStreamer.hpp>
 
 FX_SET_MODULE_NAME("Material")
 
@@ -46,6 +48,7 @@ MaterialComponent& MaterialComponent::operator=(const MaterialComponent& other)
 	UploadSrc = other.UploadSrc;
 	pDataToLoad = other.pDataToLoad;
 	ImageToUpload = other.ImageToUpload;
+	pImageOwner = other.pImageOwner;
 
 	TextureCacheID = other.TextureCacheID;
 
@@ -117,6 +120,12 @@ bool MaterialComponent::CheckIfReady()
 		return false;
 	}
 
+	// The pixels have been copied for the upload, so any that the component owns can be freed
+	if (pImageOwner) {
+		ImageToUpload.ImageData = Slice<const uint8>(nullptr, 0);
+		pImageOwner = nullptr;
+	}
+
 	return true;
 }
 
@@ -174,7 +183,7 @@ void Material::RequestQuality(uint32 quality)
 }
 
 
-bool Material::BindWithPipeline(const CommandBuffer& cmd, const Pipeline& pipeline)
+bool Material::BindWithPipeline(const CommandBuffer& cmd, const Pipeline& pipeline, uint32 bone_offset)
 {
 	if (!bIsBuilt.load()) {
 		Build();
@@ -184,9 +193,15 @@ bool Material::BindWithPipeline(const CommandBuffer& cmd, const Pipeline& pipeli
 		return false;
 	}
 
-	renderer::DescriptorSet* descriptor_set = mpDescriptorSet;
 	const renderer::PipelineNameInfo& pl_info = GetPipelineNameInfo(pipeline.Name);
 
+	// Bindless pipelines read the textures from the texture table, which is bound once with the pipeline
+	if (HasFlag(pl_info.Flags, ePipelineNameFlags::Bindless)) {
+		return true;
+	}
+
+	renderer::DescriptorSet* descriptor_set = mpDescriptorSet;
+
 	// This is only for materials that were defined as a 'full' material originally, but will be replaced into a
 	// different material later. Since this function is only really called from the segmented RenderList, this is likely
 	// only called for the NullMaterial.
@@ -197,7 +212,7 @@ bool Material::BindWithPipeline(const CommandBuffer& cmd, const Pipeline& pipeli
 	// Buffer offsets
 	StackArray<uint32, 2> offsets;
 	if (bSupportsSkinning) {
-		offsets.Insert(gRenderer->BoneBuffer.GetBaseOffset());
+		offsets.Insert(gRenderer->BoneBuffer.GetBaseOffset() + bone_offset);
 	}
 	offsets.Insert(gRenderer->LightBuffer.GetBaseOffset());
 
@@ -223,6 +238,8 @@ Material& Material::operator=(const Material& other)
 
 	bSupportsSkinning = other.bSupportsSkinning;
 	bNearestFiltering = other.bNearestFiltering;
+	bPackedTextures = other.bPackedTextures;
+	bBindlessTextures = other.bBindlessTextures;
 
 	mbIsReady = false;
 	mbIsBeingBuilt = false;
@@ -230,12 +247,39 @@ Material& Material::operator=(const Material& other)
 	return *this;
 }
 
+void Material::RebuildDescriptors()
+{
+	for (renderer::DescriptorSet* descriptor_set : { mpDescriptorSet, mpAlbedoOnlyDescriptorSet }) {
+		if (descriptor_set == nullptr) {
+			continue;
+		}
+
+		// The descriptor set may still be bound in the frames in flight
+		const DescriptorID descriptor_id = descriptor_set->ID;
+		gRenderer->AddToDeletionQueue([descriptor_id](DeletionObject* object)
+									  { gDescriptorCache->Free(descriptor_id); });
+	}
+
+	mpDescriptorSet = nullptr;
+	mpAlbedoOnlyDescriptorSet = nullptr;
+
+	RemoveFromTextureTable();
+
+	bIsBuilt.store(false);
+}
+
 void Material::Destroy()
 {
 	if (bIsBuilt) {
 		bIsBuilt.store(false);
 	}
 
+	if (gTextureStreamer) {
+		gTextureStreamer->Unregister(this);
+	}
+
+	RemoveFromTextureTable();
+
 	MaterialManagerFwd::DestroyMaterial(ID);
 }
 
@@ -258,14 +302,18 @@ void Material::Destroy()
 renderer::ePipelineName Material::GetRequiredPipeline() const
 {
 	if (NormalMap.Exists()) {
-		return ePipelineName::GeometryNormalMaps;
-
-		if (bSupportsSkinning) {
-			return ePipelineName::GeometrySkinned;
+		if (bBindlessTextures) {
+			return ePipelineName::GeometryBindlessNormalMaps;
 		}
+
+		return bPackedTextures ? ePipelineName::GeometryPackedNormalMaps : ePipelineName::GeometryNormalMaps;
 	}
 	else {
-		return ePipelineName::Geometry;
+		if (bBindlessTextures) {
+			return ePipelineName::GeometryBindless;
+		}
+
+		return bPackedTextures ? ePipelineName::GeometryPacked : ePipelineName::Geometry;
 	}
 }
 
@@ -299,6 +347,83 @@ static float32 GetComponentMinLOD(const MaterialComponent& component)
 	return static_cast<float32>(info.MipLevel);
 }
 
+static SamplerProps GetComponentSamplerProps(const Material& material)
+{
+	SamplerProps sampler_props { .MinLOD = GetComponentMinLOD(material.Diffuse),
+								 .MaxLOD = GetComponentMaxLOD(material.Diffuse) };
+
+	if (material.bNearestFiltering) {
+		sampler_props.SetNearest();
+	}
+
+	return sampler_props;
+}
+
+/**
+ * @brief Returns `table_index`, or `null_index` if the component could not be added to the texture table.
+ */
+static uint32 GetTableIndexOr(uint32 table_index, uint32 null_index)
+{
+	return (table_index != BindlessTextureTable::scInvalidIndex) ? table_index : null_index;
+}
+
+void Material::AddToTextureTable()
+{
+	BindlessTextureTable& table = MaterialManagerFwd::GetTextureTable();
+
+	if (!table.IsInited() || mTextureTableIndices[0] != BindlessTextureTable::scInvalidIndex) {
+		return;
+	}
+
+	Sampler* sampler = gSamplerCache->Request(GetComponentSamplerProps(*this));
+
+	// Components that could not be added keep sampling the textures of the null material
+	const MaterialProperties null_properties {};
+
+	mTextureTableIndices[0] = table.Add(Diffuse.pImage, sampler);
+	Properties.DiffuseIndex = GetTableIndexOr(mTextureTableIndices[0], null_properties.DiffuseIndex);
+
+	if (NormalMap.Exists()) {
+		mTextureTableIndices[1] = table.Add(NormalMap.pImage, sampler);
+		mTextureTableIndices[2] = table.Add(MetallicRoughness.pImage, sampler);
+
+		Properties.NormalMapIndex = GetTableIndexOr(mTextureTableIndices[1], null_properties.NormalMapIndex);
+		Properties.MetallicRoughnessIndex = GetTableIndexOr(mTextureTableIndices[2],
+															null_properties.MetallicRoughnessIndex);
+	}
+}
+
+void Material::RemoveFromTextureTable()
+{
+	BindlessTextureTable& table = MaterialManagerFwd::GetTextureTable();
+
+	bool was_removed = false;
+
+	for (uint32& index : mTextureTableIndices) {
+		if (index == BindlessTextureTable::scInvalidIndex) {
+			continue;
+		}
+
+		table.Remove(index);
+		index = BindlessTextureTable::scInvalidIndex;
+
+		was_removed = true;
+	}
+
+	if (!was_removed) {
+		return;
+	}
+
+	// Sample the null material until the components are added again, as the removed entries may be reused
+	const MaterialProperties null_properties {};
+
+	Properties.DiffuseIndex = null_properties.DiffuseIndex;
+	Properties.NormalMapIndex = null_properties.NormalMapIndex;
+	Properties.MetallicRoughnessIndex = null_properties.MetallicRoughnessIndex;
+
+	SubmitProperties(Properties);
+}
+
 renderer::DescriptorSet* Material::RequestAlbedoOnlyDescriptors()
 {
 	if (mpAlbedoOnlyDescriptorSet != nullptr) {
@@ -331,18 +456,17 @@ void Material::Build()
 
 	AssertMsg(Diffuse.Ticket.IsValid(), "Diffuse texture must be valid");
 
-	SamplerProps diffuse_sampler_props { .MinLOD = GetComponentMinLOD(Diffuse), .MaxLOD = GetComponentMaxLOD(Diffuse) };
-
-	if (bNearestFiltering) {
-		diffuse_sampler_props.SetNearest();
-	}
+	const SamplerProps diffuse_sampler_props = GetComponentSamplerProps(*this);
 
 	if (NormalMap.Exists() && !MetallicRoughness.Exists()) {
 		MetallicRoughness.SetTicket(gAssetManager->GetNullImageTicket(eImageFormat::RGBA8_UNorm));
 	}
 
 
-	if (mpDescriptorSet == nullptr) {
+	if (bBindlessTextures) {
+		AddToTextureTable();
+	}
+	else if (mpDescriptorSet == nullptr) {
 		SizedArray<DescriptorEntry> ds_entries(6);
 
 		LogInfo(LC_RENDER, "** Building Material ({}) descriptor set", ID);
@@ -365,8 +489,9 @@ void Material::Build()
 		if (bSupportsSkinning) {
 			LogInfo(LC_RENDER, "\tHas Skinning");
 
+			// Bound to one palette, which is selected with the dynamic offset
 			ds_entries.Emplace(DescriptorEntry::AsBuffer(3, eShaderType::Vertex, &gRenderer->BoneBuffer.GetGpuBuffer(),
-														 0, gRenderer->BoneBuffer.PageSize));
+														 0, gRenderer->BoneBuffer.GetSlotSize()));
 		}
 
 		ds_entries.Emplace(DescriptorEntry::AsBuffer(4, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
@@ -15,6 +15,8 @@
 #include <Core/FreeArray.hpp>
 #include <Core/Name.hpp>
 #include <Core/PagedArray.hpp>
+#include <Core/TSRef.hpp>
+#include <Renderer/Backend/BindlessTextureTable.hpp>
 #include <Renderer/Backend/Descriptors.hpp>
 #include <Renderer/Backend/GpuBuffer.hpp>
 #include <Renderer/PipelineNames.hpp>
@@ -51,6 +53,30 @@ enum class eMaterialComponentUploadSrc
 	DirectUpload,
 };
 
+/**
+ * @brief Pixels that are freed with `pFree` once the last reference to them is dropped. Used for decoded images whose
+ * pixels are read by both the upload and background jobs, so that no single one of them can free the pixels.
+ */
+struct OwnedImageData
+{
+	using FreeFunc = void (*)(void* data);
+
+	OwnedImageData(uint8* data, FreeFunc free_func) : pData(data), pFree(free_func) {}
+
+	OwnedImageData(const OwnedImageData& other) = delete;
+	OwnedImageData& operator=(const OwnedImageData& other) = delete;
+
+	~OwnedImageData()
+	{
+		if (pData) {
+			pFree(pData);
+		}
+	}
+
+	uint8* pData = nullptr;
+	FreeFunc pFree = nullptr;
+};
+
 struct MaterialComponent
 {
 public:
@@ -94,6 +120,10 @@ public:
 	/// pregenerated texture cache files.
 	ImageInfo ImageToUpload {};
 
+	/// Keeps the pixels of `ImageToUpload` alive until they have been uploaded, if nothing else owns them. Released
+	/// once the image has loaded.
+	TSRef<OwnedImageData> pImageOwner { nullptr };
+
 	eImageFormat ImageFormat = eImageFormat::RGBA8_UNorm;
 
 	bool bUpdateAndReupload = false;
@@ -106,9 +136,24 @@ private:
 // Material
 /////////////////////////////////////
 
+/**
+ * @brief Per material values in `MaterialManager::MaterialPropertiesBuffer`. Mirrored by `Material` in
+ * `Shaders/MaterialDef.hlsli`.
+ */
 struct MaterialProperties
 {
 	eMaterialFlags Flags = eMaterialFlags::None;
+
+	/// The layers of the texture arrays that the components of a packed material are in (see `TexturePacker`).
+	uint32 DiffuseLayer = 0;
+	uint32 NormalMapLayer = 0;
+	uint32 MetallicRoughnessLayer = 0;
+
+	/// The entries of the bindless texture table that the components are in (see `BindlessTextureTable`). These
+	/// default to the textures of the null material, which are the first in the table.
+	uint32 DiffuseIndex = 0;
+	uint32 NormalMapIndex = 1;
+	uint32 MetallicRoughnessIndex = 2;
 };
 
 /**
@@ -173,15 +218,24 @@ public:
 
 	/**
 	 * Binds the material to be used in the given command buffer.
+	 * @param bone_offset The offset of the skinning palette in the bone buffer (see `AnimationManager`).
 	 * @returns True if the material was bound successfully.
 	 */
-	bool BindWithPipeline(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline);
+	bool BindWithPipeline(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline,
+						  uint32 bone_offset = 0);
 
 
 	void RequestQuality(uint32 quality);
 
 	void Build();
 
+	/**
+	 * @brief Frees the descriptor sets of the material so that they are rebuilt on the next bind. This must be called
+	 * before an image of the material is replaced, as the descriptor sets are freed through the deletion queue before
+	 * the old image is.
+	 */
+	void RebuildDescriptors();
+
 	FX_FORCE_INLINE renderer::DescriptorSet* GetDescriptorSet() { return mpDescriptorSet; }
 
 	/**
@@ -206,6 +260,12 @@ private:
 	 */
 	renderer::DescriptorSet* RequestAlbedoOnlyDescriptors();
 
+	/**
+	 * @brief Adds the images of the components to the bindless texture table and writes their indices to `Properties`.
+	 */
+	void AddToTextureTable();
+	void RemoveFromTextureTable();
+
 public:
 	MaterialID ID = MaterialID::Null;
 
@@ -223,12 +283,27 @@ public:
 	bool bSupportsSkinning : 1 = false;
 	bool bNearestFiltering : 1 = false;
 
+	/// True if the components of the material are layers of texture arrays that are shared with other materials. The
+	/// layers are stored in `Properties`, see `TexturePacker`.
+	bool bPackedTextures : 1 = false;
+
+	/// True if the textures of the material are read from the bindless texture table, so the material is not bound
+	/// per draw (see `BindlessTextureTable`). This is set when the material is created.
+	bool bBindlessTextures : 1 = false;
+
 	int32 QualityLevel = 3;
 
 private:
 	renderer::DescriptorSet* mpDescriptorSet = nullptr;
 	renderer::DescriptorSet* mpAlbedoOnlyDescriptorSet = nullptr;
 
+	/// The entries of the bindless texture table that were added for each `eResourceType`.
+	uint32 mTextureTableIndices[static_cast<uint32>(eResourceType::MaxImages)] = {
+		renderer::BindlessTextureTable::scInvalidIndex,
+		renderer::BindlessTextureTable::scInvalidIndex,
+		renderer::BindlessTextureTable::scInvalidIndex,
+	};
+
 	bool mbIsReady : 1 = false;
 	bool mbIsBeingBuilt : 1 = false;
 };
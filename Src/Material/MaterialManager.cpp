@@ -10,6 +10,8 @@
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/RenderBackend.hpp>
 #include <Texture/TextureManager.hpp>
+#include <Texture/TexturePacker.hpp>
+#include <vector>
 
 namespace fx {
 
@@ -25,6 +27,11 @@ void MaterialManager::Create()
 
 	mMaterialList.Init(FX_MAX_BOUND_MATERIALS);
 
+	// Falls back to binding the textures of each material if the device does not support bindless textures
+	if (bBindlessTextures) {
+		mTextureTable.Create(renderer::gRenderer->GetDevice());
+	}
+
 	// The null material should always be set
 
 	renderer::DescriptorPool& dp = mDescriptorPool;
@@ -60,7 +67,7 @@ void MaterialManager::Create()
 
 
 bool MaterialManager::BindWithPipeline(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline,
-									   const MaterialID& id)
+									   const MaterialID& id, uint32 bone_offset)
 {
 	Material* material = mMaterialList.GetItem(id.GetID());
 	if (material == nullptr) {
@@ -68,7 +75,57 @@ bool MaterialManager::BindWithPipeline(const renderer::CommandBuffer& cmd, const
 		return false;
 	}
 
-	return material->BindWithPipeline(cmd, pipeline);
+	return material->BindWithPipeline(cmd, pipeline, bone_offset);
+}
+
+void MaterialManager::BindTextureTable(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline)
+{
+	Assert(mTextureTable.IsInited());
+
+	// Set 0 only holds the light buffer in the bindless pipelines, which is the same for every material
+	for (const renderer::Pipeline::DescriptorRef& ds_ref : pipeline.DescriptorIDs) {
+		if (ds_ref.SetIndex == 0) {
+			const uint32 light_offset = renderer::gRenderer->LightBuffer.GetBaseOffset();
+			ds_ref.pSet->Bind(0, cmd, pipeline, Slice<const uint32>(&light_offset, 1));
+		}
+	}
+
+	mTextureTable.Bind(scTextureTableSetIndex, cmd, pipeline);
+}
+
+void MaterialManager::Update(renderer::CommandBuffer& cmd)
+{
+	if (!bPackTextures || !mbInitialized) {
+		return;
+	}
+
+	std::lock_guard guard(mInUse);
+
+	std::vector<Material*> candidates;
+
+	// Skip the null material at index 0
+	for (uint32 index = 1; index < mMaterialList.Capacity; index++) {
+		Material* material = mMaterialList.GetItem(index);
+
+		if (material != nullptr && TexturePacker::CanPack(*material)) {
+			candidates.push_back(material);
+		}
+	}
+
+	if (candidates.size() != mPackCandidateCount) {
+		mPackCandidateCount = static_cast<uint32>(candidates.size());
+		mFramesSinceCandidatesChanged = 0;
+		return;
+	}
+
+	// Only try to pack the same materials once
+	if (++mFramesSinceCandidatesChanged != scPackSettleFrames) {
+		return;
+	}
+
+	if (TexturePacker::Pack(cmd, Slice<Material*>(candidates.data(), candidates.size())) > 0) {
+		++mPackGeneration;
+	}
 }
 
 #define NM_PINK	 255, 80, 203, 255
@@ -120,6 +177,10 @@ void MaterialManager::MakeNullMaterial()
 	material->Finalize();
 	material->Build();
 
+	// The null material keeps its descriptor set for the pipelines that bind materials. Its textures are also the first
+	// entries of the texture table, which the texture indices in `MaterialProperties` default to.
+	material->AddToTextureTable();
+
 	LogInfo("Created null material (Id={})", material->GetID());
 }
 
@@ -155,6 +216,12 @@ MaterialID MaterialManager::NewMaterial(const String& name, renderer::ePipelineN
 	material->Name = name.Str();
 	material->SetSupportsSkinning(supports_skinning);
 
+	// Skinned materials bind the bone buffer with their textures, so they are not bindless
+	material->bBindlessTextures = (UsesTextureTable() && !supports_skinning);
+
+	// The default texture indices sample the null material until the material is built
+	material->SubmitProperties(material->Properties);
+
 	return material->ID;
 }
 
@@ -178,6 +245,9 @@ void MaterialManager::Destroy()
 		return;
 	}
 
+	// Destroyed first so that the materials do not return their entries to it
+	mTextureTable.Destroy();
+
 	mMaterialList.Free();
 
 	MaterialPropertiesBuffer.Destroy();
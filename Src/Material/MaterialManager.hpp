@@ -7,9 +7,10 @@
 #include <Core/FreeArray.hpp>
 #include <Core/String.hpp>
 #include <Core/Types.hpp>
+#include <Renderer/Backend/BindlessTextureTable.hpp>
 #include <Renderer/Backend/Descriptors.hpp>
 
-#define FX_MAX_BOUND_MATERIALS 64
+#define FX_MAX_BOUND_MATERIALS 4096
 
 namespace fx {
 
@@ -23,6 +24,12 @@ class Material;
 
 class MaterialManager
 {
+public:
+	static constexpr uint32 scPackSettleFrames = 60;
+
+	/// The descriptor set index that the bindless texture table is bound to in the bindless pipelines.
+	static constexpr uint32 scTextureTableSetIndex = 2;
+
 public:
 	void Create();
 
@@ -30,10 +37,39 @@ public:
 	Material* GetMaterial(const MaterialID& id);
 	void DestroyMaterial(const MaterialID& id);
 
-	bool BindWithPipeline(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline, const MaterialID& id);
+	bool BindWithPipeline(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline, const MaterialID& id,
+						  uint32 bone_offset = 0);
+
+	/**
+	 * @brief Binds the descriptor sets that are shared by all materials in a bindless pipeline (see
+	 * `ePipelineNameFlags::Bindless`). This is called once after the pipeline is bound, and materials are not bound
+	 * for each draw.
+	 */
+	void BindTextureTable(const renderer::CommandBuffer& cmd, const renderer::Pipeline& pipeline);
 
 	renderer::DescriptorPool& GetDescriptorPool() { return mDescriptorPool; }
 
+	FX_FORCE_INLINE renderer::BindlessTextureTable& GetTextureTable() { return mTextureTable; }
+
+	/**
+	 * @brief Returns true if new materials read their textures from the bindless texture table.
+	 */
+	FX_FORCE_INLINE bool UsesTextureTable() const { return mTextureTable.IsInited(); }
+
+	/**
+	 * @brief Packs the textures of the materials that have finished loading into texture arrays if `bPackTextures` is
+	 * set (see `TexturePacker`). Materials are packed once no more materials have become ready for
+	 * `scPackSettleFrames` frames, so that the materials of a scene are packed together. This must be called once per
+	 * frame, outside of a render pass.
+	 */
+	void Update(renderer::CommandBuffer& cmd);
+
+	/**
+	 * @brief Returns a value that changes each time materials are packed. The pipelines required by packed materials
+	 * change, so objects that use them are moved to other render list sections.
+	 */
+	FX_FORCE_INLINE uint32 GetPackGeneration() const { return mPackGeneration; }
+
 	void Destroy();
 
 	~MaterialManager();
@@ -56,6 +92,13 @@ public:
 	 */
 	renderer::DescriptorSet mMaterialPropertiesDS {};
 
+	/// Pack small material textures into texture arrays, see `Update()`.
+	bool bPackTextures = false;
+
+	/// Read the textures of materials from a bindless texture table if the device supports it. This must be set
+	/// before the manager is created.
+	bool bBindlessTextures = true;
+
 
 private:
 	// SizedArray<Material> mMaterials;
@@ -63,10 +106,16 @@ private:
 
 	renderer::DescriptorPool mDescriptorPool;
 
+	renderer::BindlessTextureTable mTextureTable;
+
 	// VkDescriptorSetLayout DsLayoutMaterialBasic;
 	// VkDescriptorSetLayout DsLayoutMaterialPBR;
 	// VkDescriptorSetLayout DsLayoutMaterialPBRSkinned;
 
+	uint32 mPackCandidateCount = 0;
+	uint32 mFramesSinceCandidatesChanged = 0;
+	uint32 mPackGeneration = 0;
+
 	bool mbInitialized : 1 = false;
 
 	std::mutex mInUse;
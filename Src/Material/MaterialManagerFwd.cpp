@@ -11,6 +11,7 @@ namespace MaterialManagerFwd {
 renderer::DescriptorPool& GetDescriptorPool() { return gMaterialManager->GetDescriptorPool(); }
 // renderer::DescriptorSet& GetDescriptorSet() { return gMaterialManager->mMaterialPropertiesDS; }
 renderer::RawGpuBuffer& GetMaterialPropertiesBuffer() { return gMaterialManager->MaterialPropertiesBuffer; }
+renderer::BindlessTextureTable& GetTextureTable() { return gMaterialManager->GetTextureTable(); }
 void DestroyMaterial(const MaterialID& id) { gMaterialManager->DestroyMaterial(id); }
 Material* GetMaterial(const MaterialID& id) { return gMaterialManager->GetMaterial(id); }
 
@@ -10,6 +10,7 @@
 namespace fx {
 
 namespace renderer {
+class BindlessTextureTable;
 class DescriptorPool;
 class DescriptorSet;
 class RawGpuBuffer;
@@ -22,6 +23,7 @@ namespace MaterialManagerFwd {
 renderer::DescriptorPool& GetDescriptorPool();
 // renderer::DescriptorSet& GetDescriptorSet();
 renderer::RawGpuBuffer& GetMaterialPropertiesBuffer();
+renderer::BindlessTextureTable& GetTextureTable();
 void DestroyMaterial(const MaterialID& id);
 Material* GetMaterial(const MaterialID& id);
 
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Core/CpuFeatures.hpp>
+#include <Core/Defines.hpp>
+#include <Core/Types.hpp>
+
+namespace fx::MathBatch {
+
+/**
+ * The batch kernels for one instruction set. Arrays are passed as floats; matrices are 16 floats, and quaternions and
+ * vectors are 4 floats.
+ */
+struct KernelTable
+{
+    void (*MulMat4Array)(float32* out, const float32* a, const float32* b, uint32 count);
+
+    void (*ComposeTRSArray)(float32* out, const float32* translations, const float32* rotations, const float32* scales,
+                            uint32 count);
+
+    /// Steps are read from `steps` if it is not null, otherwise `step` is used for every element.
+    void (*SLerpArray)(float32* out, const float32* a, const float32* b, float32 step, const float32* steps,
+                       uint32 count);
+
+    /// `count` must be at least one.
+    void (*CalculateBounds)(const uint8* positions, uint32 stride, uint32 count, float32* out_min, float32* out_max);
+};
+
+extern const KernelTable gScalarKernels;
+
+#if defined FX_USE_CPU_DISPATCH
+extern const KernelTable gSSE4Kernels;
+extern const KernelTable gAVX2Kernels;
+extern const KernelTable gAVX512Kernels;
+
+// The AVX-512 table reuses these from the AVX2 table
+void ComposeTRSArray_AVX2(float32* out, const float32* translations, const float32* rotations, const float32* scales,
+                          uint32 count);
+void SLerpArray_AVX2(float32* out, const float32* a, const float32* b, float32 step, const float32* steps,
+                     uint32 count);
+void CalculateBounds_AVX2(const uint8* positions, uint32 stride, uint32 count, float32* out_min, float32* out_max);
+
+#elif defined FX_USE_AVX
+extern const KernelTable gAVX2Kernels;
+#elif defined FX_USE_NEON
+extern const KernelTable gNeonKernels;
+#endif
+
+/**
+ * @brief Returns the kernels for `tier`. On builds without runtime dispatch this is the table for the compile time
+ * instruction set.
+ */
+const KernelTable& GetKernelTable(eCpuTier tier);
+
+} // namespace fx::MathBatch
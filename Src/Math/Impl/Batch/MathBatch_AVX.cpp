@@ -0,0 +1,392 @@
+#include <Core/Defines.hpp>
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+#include "MathBatchKernels.hpp"
+
+#include <Math/MathConsts.hpp>
+#include <cstring>
+
+#ifdef FX_USE_AVX
+#include <Math/SSE.hpp>
+#else
+#include <immintrin.h>
+#endif
+
+// AVX2 and FMA kernels. With runtime dispatch these are compiled for AVX2 regardless of the build flags, and are only
+// called on CPUs that support it.
+
+namespace fx::MathBatch {
+
+static constexpr uint32 scSignMask32 = 0x80000000;
+
+/// The number of elements processed in one block by the SoA kernels.
+static constexpr uint32 scBlockSize = 8;
+
+/**
+ * Transposes between four-component vectors and four registers of eight lanes (one register per component).
+ *
+ * Going in, each register holds the vectors of two elements, `r[i] = [ element i | element i + 4 ]`. Coming out,
+ * `r[c]` holds component c of elements 0-7. The transpose is its own inverse, so it is used for both loads and stores.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE void Transpose4x8(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+    r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/**
+ * Loads eight four-component vectors, `stride` floats apart, as one register per component.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE void LoadSoA(const float32* data, uint32 stride, __m256 out[4])
+{
+    for (uint32 i = 0; i < 4; i++) {
+        const __m128 lo = _mm_loadu_ps(data + (stride * i));
+        const __m128 hi = _mm_loadu_ps(data + (stride * (i + 4)));
+        out[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    Transpose4x8(out[0], out[1], out[2], out[3]);
+}
+
+/**
+ * Stores four registers of eight lanes as eight four-component vectors, `stride` floats apart.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE void StoreSoA(float32* data, uint32 stride, __m256 r0, __m256 r1, __m256 r2,
+                                                    __m256 r3)
+{
+    Transpose4x8(r0, r1, r2, r3);
+
+    const __m256 values[4] = { r0, r1, r2, r3 };
+
+    for (uint32 i = 0; i < 4; i++) {
+        _mm_storeu_ps(data + (stride * i), _mm256_castps256_ps128(values[i]));
+        _mm_storeu_ps(data + (stride * (i + 4)), _mm256_extractf128_ps(values[i], 1));
+    }
+}
+
+/**
+ * Sine of eight values, using the same minimax approximation as `SSE::SinCos4()`. Values are first reduced to [-pi, pi].
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE __m256 Sin8(__m256 values)
+{
+    const __m256 cvOne = _mm256_set1_ps(1.0f);
+    const __m256 cvSignMask = _mm256_castsi256_ps(_mm256_set1_epi32(scSignMask32));
+
+    const __m256 cvPi = _mm256_set1_ps(FX_PI);
+    const __m256 cvHalfPi = _mm256_set1_ps(FX_HALF_PI);
+
+    // Reduce to [-pi, pi]
+    const __m256 quotient = _mm256_round_ps(_mm256_mul_ps(values, _mm256_set1_ps(FX_1_OVER_2PI)),
+                                            _MM_FROUND_TO_NEAREST_INT);
+    values = _mm256_fnmadd_ps(quotient, _mm256_set1_ps(FX_2PI), values);
+
+    // Fold into [-pi/2, pi/2], as sin(x) = sin(pi - x)
+    const __m256 sign = _mm256_and_ps(values, cvSignMask);
+    const __m256 pi_or_neg_pi = _mm256_or_ps(cvPi, sign);
+    const __m256 le_result = _mm256_cmp_ps(_mm256_andnot_ps(sign, values), cvHalfPi, _CMP_LE_OQ);
+
+    values = _mm256_blendv_ps(_mm256_sub_ps(pi_or_neg_pi, values), values, le_result);
+
+    const __m256 values_sq = _mm256_mul_ps(values, values);
+
+    __m256 result = _mm256_fmadd_ps(_mm256_set1_ps(-2.3889859e-08f), values_sq, _mm256_set1_ps(+2.7525562e-06f));
+    result = _mm256_fmadd_ps(result, values_sq, _mm256_set1_ps(-0.00019840874f));
+    result = _mm256_fmadd_ps(result, values_sq, _mm256_set1_ps(+0.0083333310f));
+    result = _mm256_fmadd_ps(result, values_sq, _mm256_set1_ps(-0.16666667f));
+    result = _mm256_fmadd_ps(result, values_sq, cvOne);
+
+    return _mm256_mul_ps(result, values);
+}
+
+/**
+ * Arc cosine of eight values in [-1, 1]. Polynomial approximation from Abramowitz and Stegun 4.4.46, with an absolute
+ * error of about 2e-8.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE __m256 ACos8(__m256 values)
+{
+    const __m256 cvSignMask = _mm256_castsi256_ps(_mm256_set1_epi32(scSignMask32));
+
+    const __m256 sign = _mm256_and_ps(values, cvSignMask);
+    const __m256 abs_values = _mm256_andnot_ps(cvSignMask, values);
+
+    __m256 result = _mm256_fmadd_ps(_mm256_set1_ps(-0.0012624911f), abs_values, _mm256_set1_ps(0.0066700901f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(-0.0170881256f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(0.0308918810f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(-0.0501743046f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(0.0889789874f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(-0.2145988016f));
+    result = _mm256_fmadd_ps(result, abs_values, _mm256_set1_ps(1.5707963050f));
+
+    result = _mm256_mul_ps(result, _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), abs_values)));
+
+    // acos(-x) = pi - acos(x)
+    const __m256 reflected = _mm256_sub_ps(_mm256_set1_ps(FX_PI), result);
+    return _mm256_blendv_ps(result, reflected, sign);
+}
+
+FX_TARGET_AVX2 static void MulMat4Array_AVX2(float32* out, const float32* a, const float32* b, uint32 count)
+{
+    // Each product already fills every lane when two columns are packed into one register, so the matrices are not
+    // transposed here; this is a streaming version of `Mat4f::operator*` that broadcasts the columns of B from memory
+    // instead of shuffling them, leaving the shuffle port for splatting the components of A.
+    for (uint32 i = 0; i < count; i++) {
+        const float32* a_data = a + (i * 16);
+        const float32* b_data = b + (i * 16);
+
+        // Columns 0 and 1, and columns 2 and 3 of A
+        const __m256 a01 = _mm256_loadu_ps(a_data);
+        const __m256 a23 = _mm256_loadu_ps(a_data + 8);
+
+        // Each column of B in both halves
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_data));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_data + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_data + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b_data + 12));
+
+        __m256 r01 = _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        __m256 r23 = _mm256_mul_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(1, 1, 1, 1)), b1, r01);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(1, 1, 1, 1)), b1, r23);
+
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(2, 2, 2, 2)), b2, r01);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(2, 2, 2, 2)), b2, r23);
+
+        r01 = _mm256_fmadd_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(3, 3, 3, 3)), b3, r01);
+        r23 = _mm256_fmadd_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(3, 3, 3, 3)), b3, r23);
+
+        _mm256_storeu_ps(out + (i * 16), r01);
+        _mm256_storeu_ps(out + (i * 16) + 8, r23);
+    }
+}
+
+FX_TARGET_AVX2 static void ComposeTRSBlock(float32* out, const float32* translations, const float32* rotations,
+                            const float32* scales)
+{
+    __m256 t[4], q[4], s[4];
+
+    LoadSoA(translations, 4, t);
+    LoadSoA(rotations, 4, q);
+    LoadSoA(scales, 4, s);
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    // Same as `Mat4f::AsRotation()`
+    const __m256 tx = _mm256_add_ps(q[0], q[0]);
+    const __m256 ty = _mm256_add_ps(q[1], q[1]);
+    const __m256 tz = _mm256_add_ps(q[2], q[2]);
+
+    const __m256 xx = _mm256_mul_ps(tx, q[0]);
+    const __m256 yy = _mm256_mul_ps(ty, q[1]);
+    const __m256 zz = _mm256_mul_ps(tz, q[2]);
+
+    const __m256 xy = _mm256_mul_ps(tx, q[1]);
+    const __m256 xz = _mm256_mul_ps(tx, q[2]);
+    const __m256 xw = _mm256_mul_ps(tx, q[3]);
+
+    const __m256 yz = _mm256_mul_ps(ty, q[2]);
+    const __m256 yw = _mm256_mul_ps(ty, q[3]);
+    const __m256 zw = _mm256_mul_ps(tz, q[3]);
+
+    // Rotation columns scaled by each axis of the scale
+    const __m256 c0x = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(one, yy), zz), s[0]);
+    const __m256 c0y = _mm256_mul_ps(_mm256_add_ps(xy, zw), s[0]);
+    const __m256 c0z = _mm256_mul_ps(_mm256_sub_ps(xz, yw), s[0]);
+
+    const __m256 c1x = _mm256_mul_ps(_mm256_sub_ps(xy, zw), s[1]);
+    const __m256 c1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(one, zz), xx), s[1]);
+    const __m256 c1z = _mm256_mul_ps(_mm256_add_ps(yz, xw), s[1]);
+
+    const __m256 c2x = _mm256_mul_ps(_mm256_add_ps(xz, yw), s[2]);
+    const __m256 c2y = _mm256_mul_ps(_mm256_sub_ps(yz, xw), s[2]);
+    const __m256 c2z = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(one, xx), yy), s[2]);
+
+    constexpr uint32 cMatrixStride = 16;
+
+    StoreSoA(out, cMatrixStride, c0x, c0y, c0z, zero);
+    StoreSoA(out + 4, cMatrixStride, c1x, c1y, c1z, zero);
+    StoreSoA(out + 8, cMatrixStride, c2x, c2y, c2z, zero);
+    StoreSoA(out + 12, cMatrixStride, t[0], t[1], t[2], one);
+}
+
+FX_TARGET_AVX2 void ComposeTRSArray_AVX2(float32* out, const float32* translations, const float32* rotations,
+                                         const float32* scales, uint32 count)
+{
+    uint32 index = 0;
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        ComposeTRSBlock(out + (index * 16), translations + (index * 4), rotations + (index * 4), scales + (index * 4));
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    // Pad the last block out to the full size so that the results match the rest of the array
+    float32 tail_out[scBlockSize * 16];
+    float32 tail_translations[scBlockSize * 4] = {};
+    float32 tail_rotations[scBlockSize * 4] = {};
+    float32 tail_scales[scBlockSize * 4] = {};
+
+    memcpy(tail_translations, translations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_rotations, rotations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_scales, scales + (index * 4), sizeof(float32) * 4 * remaining);
+
+    ComposeTRSBlock(tail_out, tail_translations, tail_rotations, tail_scales);
+
+    memcpy(out + (index * 16), tail_out, sizeof(float32) * 16 * remaining);
+}
+
+FX_TARGET_AVX2 static void SLerpBlock(float32* out, const float32* a, const float32* b, __m256 step)
+{
+    __m256 qa[4], qb[4];
+
+    LoadSoA(a, 4, qa);
+    LoadSoA(b, 4, qb);
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    __m256 cos_half_theta = _mm256_mul_ps(qa[0], qb[0]);
+    cos_half_theta = _mm256_fmadd_ps(qa[1], qb[1], cos_half_theta);
+    cos_half_theta = _mm256_fmadd_ps(qa[2], qb[2], cos_half_theta);
+    cos_half_theta = _mm256_fmadd_ps(qa[3], qb[3], cos_half_theta);
+
+    // Lanes where qa = qb or qa = -qb keep qa, as in `Quat::SLerp()`
+    const __m256 abs_cos = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_set1_epi32(scSignMask32)), cos_half_theta);
+    const __m256 same_mask = _mm256_cmp_ps(abs_cos, one, _CMP_GE_OQ);
+
+    const __m256 half_theta = ACos8(cos_half_theta);
+    const __m256 sin_half_theta = _mm256_sqrt_ps(_mm256_fnmadd_ps(cos_half_theta, cos_half_theta, one));
+
+    // Lanes where theta is 180 degrees take the midpoint
+    const __m256 opposite_mask = _mm256_cmp_ps(sin_half_theta, _mm256_set1_ps(0.001f), _CMP_LT_OQ);
+
+    const __m256 sht_recip = _mm256_div_ps(one, sin_half_theta);
+    const __m256 ratio_a = _mm256_mul_ps(Sin8(_mm256_mul_ps(_mm256_sub_ps(one, step), half_theta)), sht_recip);
+    const __m256 ratio_b = _mm256_mul_ps(Sin8(_mm256_mul_ps(step, half_theta)), sht_recip);
+
+    __m256 result[4];
+
+    for (uint32 c = 0; c < 4; c++) {
+        const __m256 slerped = _mm256_fmadd_ps(qb[c], ratio_b, _mm256_mul_ps(qa[c], ratio_a));
+        const __m256 midpoint = _mm256_fmadd_ps(qb[c], half, _mm256_mul_ps(qa[c], half));
+
+        result[c] = _mm256_blendv_ps(slerped, midpoint, opposite_mask);
+        result[c] = _mm256_blendv_ps(result[c], qa[c], same_mask);
+    }
+
+    StoreSoA(out, 4, result[0], result[1], result[2], result[3]);
+}
+
+FX_TARGET_AVX2 void SLerpArray_AVX2(float32* out, const float32* a, const float32* b, float32 step,
+                                    const float32* steps, uint32 count)
+{
+    uint32 index = 0;
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        const __m256 step_v = (steps != nullptr) ? _mm256_loadu_ps(steps + index) : _mm256_set1_ps(step);
+        SLerpBlock(out + (index * 4), a + (index * 4), b + (index * 4), step_v);
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    float32 tail_out[scBlockSize * 4];
+    float32 tail_a[scBlockSize * 4] = {};
+    float32 tail_b[scBlockSize * 4] = {};
+    float32 tail_steps[scBlockSize] = {};
+
+    memcpy(tail_a, a + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_b, b + (index * 4), sizeof(float32) * 4 * remaining);
+
+    if (steps != nullptr) {
+        memcpy(tail_steps, steps + index, sizeof(float32) * remaining);
+    }
+
+    const __m256 step_v = (steps != nullptr) ? _mm256_loadu_ps(tail_steps) : _mm256_set1_ps(step);
+    SLerpBlock(tail_out, tail_a, tail_b, step_v);
+
+    memcpy(out + (index * 4), tail_out, sizeof(float32) * 4 * remaining);
+}
+
+/**
+ * Loads the three floats of a position, without reading past the end of it.
+ */
+FX_TARGET_AVX2 static FX_FORCE_INLINE __m128 LoadPosition(const uint8* position)
+{
+    float32 values[4];
+    memcpy(values, position, sizeof(float32) * 3);
+    values[3] = 0.0f;
+
+    return _mm_loadu_ps(values);
+}
+
+FX_TARGET_AVX2 void CalculateBounds_AVX2(const uint8* positions, uint32 stride, uint32 count, float32* out_min,
+                                         float32* out_max)
+{
+    // Two positions per register. The fourth component of each is whatever follows the position in the element, and
+    // is discarded at the end.
+    const __m128 first = LoadPosition(positions);
+
+    __m256 min_values = _mm256_set_m128(first, first);
+    __m256 max_values = min_values;
+
+    uint32 index = 1;
+
+    // Positions are loaded 16 bytes at a time, so the last position is loaded separately
+    for (; index + 2 < count; index += 2) {
+        const uint8* position = positions + (static_cast<uint64>(index) * stride);
+
+        const __m128 lo = _mm_loadu_ps(reinterpret_cast<const float32*>(position));
+        const __m128 hi = _mm_loadu_ps(reinterpret_cast<const float32*>(position + stride));
+        const __m256 values = _mm256_set_m128(hi, lo);
+
+        min_values = _mm256_min_ps(min_values, values);
+        max_values = _mm256_max_ps(max_values, values);
+    }
+
+    __m128 min_result = _mm_min_ps(_mm256_castps256_ps128(min_values), _mm256_extractf128_ps(min_values, 1));
+    __m128 max_result = _mm_max_ps(_mm256_castps256_ps128(max_values), _mm256_extractf128_ps(max_values, 1));
+
+    for (; index < count; index++) {
+        const __m128 values = LoadPosition(positions + (static_cast<uint64>(index) * stride));
+
+        min_result = _mm_min_ps(min_result, values);
+        max_result = _mm_max_ps(max_result, values);
+    }
+
+    float32 min_floats[4];
+    float32 max_floats[4];
+
+    _mm_storeu_ps(min_floats, min_result);
+    _mm_storeu_ps(max_floats, max_result);
+
+    memcpy(out_min, min_floats, sizeof(float32) * 3);
+    memcpy(out_max, max_floats, sizeof(float32) * 3);
+}
+
+const KernelTable gAVX2Kernels = {
+    .MulMat4Array = MulMat4Array_AVX2,
+    .ComposeTRSArray = ComposeTRSArray_AVX2,
+    .SLerpArray = SLerpArray_AVX2,
+    .CalculateBounds = CalculateBounds_AVX2,
+};
+
+} // namespace fx::MathBatch
+
+#endif // FX_USE_CPU_DISPATCH || FX_USE_AVX
@@ -0,0 +1,48 @@
+#include <Core/Defines.hpp>
+
+#ifdef FX_USE_CPU_DISPATCH
+
+#include "MathBatchKernels.hpp"
+
+#include <immintrin.h>
+
+// AVX-512 kernels. Only the matrix multiply benefits from the wider registers (a whole matrix fits in one), so the
+// other kernels are shared with the AVX2 table.
+
+namespace fx::MathBatch {
+
+FX_TARGET_AVX512 static void MulMat4Array_AVX512(float32* out, const float32* a, const float32* b, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const float32* a_data = a + (i * 16);
+        const float32* b_data = b + (i * 16);
+
+        // All four columns of A, one per 128-bit lane
+        const __m512 a_columns = _mm512_loadu_ps(a_data);
+
+        // Each column of B, repeated in every lane
+        const __m512 b0 = _mm512_broadcast_f32x4(_mm_loadu_ps(b_data));
+        const __m512 b1 = _mm512_broadcast_f32x4(_mm_loadu_ps(b_data + 4));
+        const __m512 b2 = _mm512_broadcast_f32x4(_mm_loadu_ps(b_data + 8));
+        const __m512 b3 = _mm512_broadcast_f32x4(_mm_loadu_ps(b_data + 12));
+
+        // Lane c of the result is column c of the output, B's columns weighted by column c of A
+        __m512 result = _mm512_mul_ps(_mm512_permute_ps(a_columns, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        result = _mm512_fmadd_ps(_mm512_permute_ps(a_columns, _MM_SHUFFLE(1, 1, 1, 1)), b1, result);
+        result = _mm512_fmadd_ps(_mm512_permute_ps(a_columns, _MM_SHUFFLE(2, 2, 2, 2)), b2, result);
+        result = _mm512_fmadd_ps(_mm512_permute_ps(a_columns, _MM_SHUFFLE(3, 3, 3, 3)), b3, result);
+
+        _mm512_storeu_ps(out + (i * 16), result);
+    }
+}
+
+const KernelTable gAVX512Kernels = {
+    .MulMat4Array = MulMat4Array_AVX512,
+    .ComposeTRSArray = ComposeTRSArray_AVX2,
+    .SLerpArray = SLerpArray_AVX2,
+    .CalculateBounds = CalculateBounds_AVX2,
+};
+
+} // namespace fx::MathBatch
+
+#endif // FX_USE_CPU_DISPATCH
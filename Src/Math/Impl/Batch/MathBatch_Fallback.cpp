@@ -0,0 +1,137 @@
+#include "MathBatchKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Plain C++ kernels, used on CPUs without SSE4.1 and on builds without SIMD. These are always compiled so that the
+// scalar tier can be selected with `FX_CPU_TIER`.
+
+namespace fx::MathBatch {
+
+static void MulMat4Array_Scalar(float32* out, const float32* a, const float32* b, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const float32* a_data = a + (i * 16);
+        const float32* b_data = b + (i * 16);
+
+        float32 result[16];
+
+        // Column c of the result is B's columns weighted by column c of A, as in `Mat4f::operator*`
+        for (uint32 c = 0; c < 4; c++) {
+            for (uint32 r = 0; r < 4; r++) {
+                result[c * 4 + r] = (a_data[c * 4 + 0] * b_data[0 + r]) + (a_data[c * 4 + 1] * b_data[4 + r]) +
+                                    (a_data[c * 4 + 2] * b_data[8 + r]) + (a_data[c * 4 + 3] * b_data[12 + r]);
+            }
+        }
+
+        memcpy(out + (i * 16), result, sizeof(result));
+    }
+}
+
+static void ComposeTRSArray_Scalar(float32* out, const float32* translations, const float32* rotations,
+                                   const float32* scales, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const float32* t = translations + (i * 4);
+        const float32* q = rotations + (i * 4);
+        const float32* s = scales + (i * 4);
+
+        // Same as `Mat4f::AsRotation()`
+        const float32 tx = q[0] * 2.0f;
+        const float32 ty = q[1] * 2.0f;
+        const float32 tz = q[2] * 2.0f;
+
+        const float32 xx = tx * q[0];
+        const float32 yy = ty * q[1];
+        const float32 zz = tz * q[2];
+
+        const float32 xy = tx * q[1];
+        const float32 xz = tx * q[2];
+        const float32 xw = tx * q[3];
+
+        const float32 yz = ty * q[2];
+        const float32 yw = ty * q[3];
+        const float32 zw = tz * q[3];
+
+        const float32 result[16] = {
+            ((1.0f - yy) - zz) * s[0], (xy + zw) * s[0], (xz - yw) * s[0], 0.0f, /* */
+            (xy - zw) * s[1], ((1.0f - zz) - xx) * s[1], (yz + xw) * s[1], 0.0f, /* */
+            (xz + yw) * s[2], (yz - xw) * s[2], ((1.0f - xx) - yy) * s[2], 0.0f, /* */
+            t[0], t[1], t[2], 1.0f,
+        };
+
+        memcpy(out + (i * 16), result, sizeof(result));
+    }
+}
+
+static void SLerpArray_Scalar(float32* out, const float32* a, const float32* b, float32 step, const float32* steps,
+                              uint32 count)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const float32* qa = a + (i * 4);
+        const float32* qb = b + (i * 4);
+
+        const float32 t = (steps != nullptr) ? steps[i] : step;
+
+        float32 ratio_a = 0.5f;
+        float32 ratio_b = 0.5f;
+
+        // Same as `Quat::SLerp()`
+        const float32 cos_half_theta = (qa[0] * qb[0]) + (qa[1] * qb[1]) + (qa[2] * qb[2]) + (qa[3] * qb[3]);
+
+        if (fabsf(cos_half_theta) >= 1.0f) {
+            ratio_a = 1.0f;
+            ratio_b = 0.0f;
+        }
+        else {
+            const float32 half_theta = acosf(cos_half_theta);
+            const float32 sin_half_theta = sqrtf(1.0f - cos_half_theta * cos_half_theta);
+
+            if (sin_half_theta >= 0.001f) {
+                const float32 sht_recip = 1.0f / sin_half_theta;
+
+                ratio_a = sinf((1.0f - t) * half_theta) * sht_recip;
+                ratio_b = sinf(t * half_theta) * sht_recip;
+            }
+        }
+
+        float32* result = out + (i * 4);
+
+        for (uint32 c = 0; c < 4; c++) {
+            result[c] = (qa[c] * ratio_a) + (qb[c] * ratio_b);
+        }
+    }
+}
+
+static void CalculateBounds_Scalar(const uint8* positions, uint32 stride, uint32 count, float32* out_min,
+                                   float32* out_max)
+{
+    float32 first[3];
+    memcpy(first, positions, sizeof(first));
+
+    float32 min_values[3] = { first[0], first[1], first[2] };
+    float32 max_values[3] = { first[0], first[1], first[2] };
+
+    for (uint32 i = 1; i < count; i++) {
+        float32 position[3];
+        memcpy(position, positions + (static_cast<uint64>(i) * stride), sizeof(position));
+
+        for (uint32 c = 0; c < 3; c++) {
+            min_values[c] = std::min(min_values[c], position[c]);
+            max_values[c] = std::max(max_values[c], position[c]);
+        }
+    }
+
+    memcpy(out_min, min_values, sizeof(min_values));
+    memcpy(out_max, max_values, sizeof(max_values));
+}
+
+const KernelTable gScalarKernels = {
+    .MulMat4Array = MulMat4Array_Scalar,
+    .ComposeTRSArray = ComposeTRSArray_Scalar,
+    .SLerpArray = SLerpArray_Scalar,
+    .CalculateBounds = CalculateBounds_Scalar,
+};
+
+} // namespace fx::MathBatch
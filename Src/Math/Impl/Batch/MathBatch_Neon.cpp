@@ -0,0 +1,305 @@
+#include <Core/Defines.hpp>
+
+#ifdef FX_USE_NEON
+
+#include <arm_neon.h>
+
+#include "MathBatchKernels.hpp"
+
+#include <Math/MathConsts.hpp>
+#include <Math/NeonUtil.hpp>
+#include <cstring>
+
+namespace fx::MathBatch {
+
+/// The number of elements processed in one block by the SoA kernels. Two blocks are processed per iteration.
+static constexpr uint32 scBlockSize = 4;
+
+/**
+ * Stores four registers of four lanes (one register per component) as four four-component vectors, `stride` floats
+ * apart.
+ */
+static FX_FORCE_INLINE void StoreSoA(float32* data, uint32 stride, float32x4_t r0, float32x4_t r1, float32x4_t r2,
+                                     float32x4_t r3)
+{
+    const float32x4x2_t t0 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t1 = vtrnq_f32(r2, r3);
+
+    vst1q_f32(data, vcombine_f32(vget_low_f32(t0.val[0]), vget_low_f32(t1.val[0])));
+    vst1q_f32(data + stride, vcombine_f32(vget_low_f32(t0.val[1]), vget_low_f32(t1.val[1])));
+    vst1q_f32(data + (stride * 2), vcombine_f32(vget_high_f32(t0.val[0]), vget_high_f32(t1.val[0])));
+    vst1q_f32(data + (stride * 3), vcombine_f32(vget_high_f32(t0.val[1]), vget_high_f32(t1.val[1])));
+}
+
+/**
+ * Arc cosine of four values in [-1, 1]. Polynomial approximation from Abramowitz and Stegun 4.4.46, with an absolute
+ * error of about 2e-8.
+ */
+static FX_FORCE_INLINE float32x4_t ACos4(float32x4_t values)
+{
+    const float32x4_t abs_values = vabsq_f32(values);
+
+    float32x4_t result = vfmaq_f32(vdupq_n_f32(0.0066700901f), vdupq_n_f32(-0.0012624911f), abs_values);
+    result = vfmaq_f32(vdupq_n_f32(-0.0170881256f), result, abs_values);
+    result = vfmaq_f32(vdupq_n_f32(0.0308918810f), result, abs_values);
+    result = vfmaq_f32(vdupq_n_f32(-0.0501743046f), result, abs_values);
+    result = vfmaq_f32(vdupq_n_f32(0.0889789874f), result, abs_values);
+    result = vfmaq_f32(vdupq_n_f32(-0.2145988016f), result, abs_values);
+    result = vfmaq_f32(vdupq_n_f32(1.5707963050f), result, abs_values);
+
+    result = vmulq_f32(result, vsqrtq_f32(vsubq_f32(vdupq_n_f32(1.0f), abs_values)));
+
+    // acos(-x) = pi - acos(x)
+    const uint32x4_t negative = vcltzq_f32(values);
+    return vbslq_f32(negative, vsubq_f32(vdupq_n_f32(FX_PI), result), result);
+}
+
+static void MulMat4Array_Neon(float32* out, const float32* a, const float32* b, uint32 count)
+{
+    // Each product already fills every lane, so the matrices are not transposed here; this is a streaming version of
+    // `Mat4f::operator*`.
+    for (uint32 i = 0; i < count; i++) {
+        const float32* a_data = a + (i * 16);
+        const float32* b_data = b + (i * 16);
+
+        const float32x4_t b0 = vld1q_f32(b_data);
+        const float32x4_t b1 = vld1q_f32(b_data + 4);
+        const float32x4_t b2 = vld1q_f32(b_data + 8);
+        const float32x4_t b3 = vld1q_f32(b_data + 12);
+
+        float32x4_t columns[4];
+
+        for (uint32 c = 0; c < 4; c++) {
+            const float32x4_t a_column = vld1q_f32(a_data + (c * 4));
+
+            float32x4_t result = vmulq_laneq_f32(b0, a_column, 0);
+            result = vfmaq_laneq_f32(result, b1, a_column, 1);
+            result = vfmaq_laneq_f32(result, b2, a_column, 2);
+            result = vfmaq_laneq_f32(result, b3, a_column, 3);
+
+            columns[c] = result;
+        }
+
+        float32* out_data = out + (i * 16);
+
+        vst1q_f32(out_data, columns[0]);
+        vst1q_f32(out_data + 4, columns[1]);
+        vst1q_f32(out_data + 8, columns[2]);
+        vst1q_f32(out_data + 12, columns[3]);
+    }
+}
+
+static FX_FORCE_INLINE void ComposeTRSBlock(float32* out, const float32* translations, const float32* rotations,
+                                            const float32* scales)
+{
+    // De-interleave into one register per component
+    const float32x4x4_t t = vld4q_f32(translations);
+    const float32x4x4_t q = vld4q_f32(rotations);
+    const float32x4x4_t s = vld4q_f32(scales);
+
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    // Same as `Mat4f::AsRotation()`
+    const float32x4_t tx = vaddq_f32(q.val[0], q.val[0]);
+    const float32x4_t ty = vaddq_f32(q.val[1], q.val[1]);
+    const float32x4_t tz = vaddq_f32(q.val[2], q.val[2]);
+
+    const float32x4_t xx = vmulq_f32(tx, q.val[0]);
+    const float32x4_t yy = vmulq_f32(ty, q.val[1]);
+    const float32x4_t zz = vmulq_f32(tz, q.val[2]);
+
+    const float32x4_t xy = vmulq_f32(tx, q.val[1]);
+    const float32x4_t xz = vmulq_f32(tx, q.val[2]);
+    const float32x4_t xw = vmulq_f32(tx, q.val[3]);
+
+    const float32x4_t yz = vmulq_f32(ty, q.val[2]);
+    const float32x4_t yw = vmulq_f32(ty, q.val[3]);
+    const float32x4_t zw = vmulq_f32(tz, q.val[3]);
+
+    // Rotation columns scaled by each axis of the scale
+    const float32x4_t c0x = vmulq_f32(vsubq_f32(vsubq_f32(one, yy), zz), s.val[0]);
+    const float32x4_t c0y = vmulq_f32(vaddq_f32(xy, zw), s.val[0]);
+    const float32x4_t c0z = vmulq_f32(vsubq_f32(xz, yw), s.val[0]);
+
+    const float32x4_t c1x = vmulq_f32(vsubq_f32(xy, zw), s.val[1]);
+    const float32x4_t c1y = vmulq_f32(vsubq_f32(vsubq_f32(one, zz), xx), s.val[1]);
+    const float32x4_t c1z = vmulq_f32(vaddq_f32(yz, xw), s.val[1]);
+
+    const float32x4_t c2x = vmulq_f32(vaddq_f32(xz, yw), s.val[2]);
+    const float32x4_t c2y = vmulq_f32(vsubq_f32(yz, xw), s.val[2]);
+    const float32x4_t c2z = vmulq_f32(vsubq_f32(vsubq_f32(one, xx), yy), s.val[2]);
+
+    constexpr uint32 cMatrixStride = 16;
+
+    StoreSoA(out, cMatrixStride, c0x, c0y, c0z, zero);
+    StoreSoA(out + 4, cMatrixStride, c1x, c1y, c1z, zero);
+    StoreSoA(out + 8, cMatrixStride, c2x, c2y, c2z, zero);
+    StoreSoA(out + 12, cMatrixStride, t.val[0], t.val[1], t.val[2], one);
+}
+
+static void ComposeTRSArray_Neon(float32* out, const float32* translations, const float32* rotations,
+                                 const float32* scales, uint32 count)
+{
+    uint32 index = 0;
+
+    for (; index + (scBlockSize * 2) <= count; index += (scBlockSize * 2)) {
+        ComposeTRSBlock(out + (index * 16), translations + (index * 4), rotations + (index * 4), scales + (index * 4));
+
+        const uint32 next = index + scBlockSize;
+        ComposeTRSBlock(out + (next * 16), translations + (next * 4), rotations + (next * 4), scales + (next * 4));
+    }
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        ComposeTRSBlock(out + (index * 16), translations + (index * 4), rotations + (index * 4), scales + (index * 4));
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    // Pad the last block out to the full size so that the results match the rest of the array
+    float32 tail_out[scBlockSize * 16];
+    float32 tail_translations[scBlockSize * 4] = {};
+    float32 tail_rotations[scBlockSize * 4] = {};
+    float32 tail_scales[scBlockSize * 4] = {};
+
+    memcpy(tail_translations, translations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_rotations, rotations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_scales, scales + (index * 4), sizeof(float32) * 4 * remaining);
+
+    ComposeTRSBlock(tail_out, tail_translations, tail_rotations, tail_scales);
+
+    memcpy(out + (index * 16), tail_out, sizeof(float32) * 16 * remaining);
+}
+
+static FX_FORCE_INLINE void SLerpBlock(float32* out, const float32* a, const float32* b, float32x4_t step)
+{
+    const float32x4x4_t qa = vld4q_f32(a);
+    const float32x4x4_t qb = vld4q_f32(b);
+
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+
+    float32x4_t cos_half_theta = vmulq_f32(qa.val[0], qb.val[0]);
+    cos_half_theta = vfmaq_f32(cos_half_theta, qa.val[1], qb.val[1]);
+    cos_half_theta = vfmaq_f32(cos_half_theta, qa.val[2], qb.val[2]);
+    cos_half_theta = vfmaq_f32(cos_half_theta, qa.val[3], qb.val[3]);
+
+    // Lanes where qa = qb or qa = -qb keep qa, as in `Quat::SLerp()`
+    const uint32x4_t same_mask = vcageq_f32(cos_half_theta, one);
+
+    const float32x4_t half_theta = ACos4(cos_half_theta);
+    const float32x4_t sin_half_theta = vsqrtq_f32(vfmsq_f32(one, cos_half_theta, cos_half_theta));
+
+    // Lanes where theta is 180 degrees take the midpoint
+    const uint32x4_t opposite_mask = vcltq_f32(sin_half_theta, vdupq_n_f32(0.001f));
+
+    const float32x4_t sht_recip = vdivq_f32(one, sin_half_theta);
+
+    float32x4_t sin_a, sin_b, unused_cos;
+    Neon::SinCos4(vmulq_f32(vsubq_f32(one, step), half_theta), &sin_a, &unused_cos);
+    Neon::SinCos4(vmulq_f32(step, half_theta), &sin_b, &unused_cos);
+
+    const float32x4_t ratio_a = vmulq_f32(sin_a, sht_recip);
+    const float32x4_t ratio_b = vmulq_f32(sin_b, sht_recip);
+
+    float32x4x4_t result;
+
+    for (uint32 c = 0; c < 4; c++) {
+        const float32x4_t slerped = vfmaq_f32(vmulq_f32(qa.val[c], ratio_a), qb.val[c], ratio_b);
+        const float32x4_t midpoint = vfmaq_f32(vmulq_f32(qa.val[c], half), qb.val[c], half);
+
+        result.val[c] = vbslq_f32(opposite_mask, midpoint, slerped);
+        result.val[c] = vbslq_f32(same_mask, qa.val[c], result.val[c]);
+    }
+
+    // Interleave back into quaternions
+    vst4q_f32(out, result);
+}
+
+static void SLerpArray_Neon(float32* out, const float32* a, const float32* b, float32 step, const float32* steps,
+                            uint32 count)
+{
+    const float32x4_t step_v = vdupq_n_f32(step);
+
+    auto get_steps = [&](uint32 index) { return (steps != nullptr) ? vld1q_f32(steps + index) : step_v; };
+
+    uint32 index = 0;
+
+    for (; index + (scBlockSize * 2) <= count; index += (scBlockSize * 2)) {
+        SLerpBlock(out + (index * 4), a + (index * 4), b + (index * 4), get_steps(index));
+
+        const uint32 next = index + scBlockSize;
+        SLerpBlock(out + (next * 4), a + (next * 4), b + (next * 4), get_steps(next));
+    }
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        SLerpBlock(out + (index * 4), a + (index * 4), b + (index * 4), get_steps(index));
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    float32 tail_out[scBlockSize * 4];
+    float32 tail_a[scBlockSize * 4] = {};
+    float32 tail_b[scBlockSize * 4] = {};
+    float32 tail_steps[scBlockSize] = {};
+
+    memcpy(tail_a, a + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_b, b + (index * 4), sizeof(float32) * 4 * remaining);
+
+    if (steps != nullptr) {
+        memcpy(tail_steps, steps + index, sizeof(float32) * remaining);
+    }
+
+    SLerpBlock(tail_out, tail_a, tail_b, (steps != nullptr) ? vld1q_f32(tail_steps) : step_v);
+
+    memcpy(out + (index * 4), tail_out, sizeof(float32) * 4 * remaining);
+}
+
+static void CalculateBounds_Neon(const uint8* positions, uint32 stride, uint32 count, float32* out_min,
+                                 float32* out_max)
+{
+    // Load the three floats of a position without reading past the end of it
+    auto load_position = [](const uint8* position)
+    {
+        const float32* values = reinterpret_cast<const float32*>(position);
+        return vcombine_f32(vld1_f32(values), vld1_dup_f32(values + 2));
+    };
+
+    float32x4_t min_values = load_position(positions);
+    float32x4_t max_values = min_values;
+
+    for (uint32 index = 1; index < count; index++) {
+        const float32x4_t values = load_position(positions + (uint64(index) * stride));
+
+        min_values = vminq_f32(min_values, values);
+        max_values = vmaxq_f32(max_values, values);
+    }
+
+    float32 min_floats[4];
+    float32 max_floats[4];
+
+    vst1q_f32(min_floats, min_values);
+    vst1q_f32(max_floats, max_values);
+
+    memcpy(out_min, min_floats, sizeof(float32) * 3);
+    memcpy(out_max, max_floats, sizeof(float32) * 3);
+}
+
+const KernelTable gNeonKernels = {
+    .MulMat4Array = MulMat4Array_Neon,
+    .ComposeTRSArray = ComposeTRSArray_Neon,
+    .SLerpArray = SLerpArray_Neon,
+    .CalculateBounds = CalculateBounds_Neon,
+};
+
+} // namespace fx::MathBatch
+
+#endif // FX_USE_NEON
@@ -0,0 +1,328 @@
+#include <Core/Defines.hpp>
+
+#ifdef FX_USE_CPU_DISPATCH
+
+#include "MathBatchKernels.hpp"
+
+#include <Math/MathConsts.hpp>
+#include <cstring>
+#include <immintrin.h>
+
+// SSE4.1 kernels for CPUs without AVX2. These process blocks of four elements, and do not use FMA.
+
+namespace fx::MathBatch {
+
+/// The number of elements processed in one block by the SoA kernels.
+static constexpr uint32 scBlockSize = 4;
+
+static constexpr uint32 scSignMask32 = 0x80000000;
+
+/**
+ * Loads four four-component vectors, `stride` floats apart, as one register per component.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE void LoadSoA(const float32* data, uint32 stride, __m128 out[4])
+{
+    out[0] = _mm_loadu_ps(data);
+    out[1] = _mm_loadu_ps(data + stride);
+    out[2] = _mm_loadu_ps(data + (stride * 2));
+    out[3] = _mm_loadu_ps(data + (stride * 3));
+
+    _MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+}
+
+/**
+ * Stores four registers of four lanes as four four-component vectors, `stride` floats apart.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE void StoreSoA(float32* data, uint32 stride, __m128 r0, __m128 r1, __m128 r2,
+                                                    __m128 r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(data, r0);
+    _mm_storeu_ps(data + stride, r1);
+    _mm_storeu_ps(data + (stride * 2), r2);
+    _mm_storeu_ps(data + (stride * 3), r3);
+}
+
+/**
+ * Sine of four values, using the same minimax approximation as `SSE::SinCos4()`. Values are first reduced to [-pi, pi].
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128 Sin4(__m128 values)
+{
+    const __m128 cvSignMask = _mm_castsi128_ps(_mm_set1_epi32(scSignMask32));
+
+    // Reduce to [-pi, pi]
+    const __m128 quotient = _mm_round_ps(_mm_mul_ps(values, _mm_set1_ps(FX_1_OVER_2PI)),
+                                         _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    values = _mm_sub_ps(values, _mm_mul_ps(quotient, _mm_set1_ps(FX_2PI)));
+
+    // Fold into [-pi/2, pi/2], as sin(x) = sin(pi - x)
+    const __m128 sign = _mm_and_ps(values, cvSignMask);
+    const __m128 pi_or_neg_pi = _mm_or_ps(_mm_set1_ps(FX_PI), sign);
+    const __m128 le_result = _mm_cmple_ps(_mm_andnot_ps(sign, values), _mm_set1_ps(FX_HALF_PI));
+
+    values = _mm_blendv_ps(_mm_sub_ps(pi_or_neg_pi, values), values, le_result);
+
+    const __m128 values_sq = _mm_mul_ps(values, values);
+
+    __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-2.3889859e-08f), values_sq), _mm_set1_ps(+2.7525562e-06f));
+    result = _mm_add_ps(_mm_mul_ps(result, values_sq), _mm_set1_ps(-0.00019840874f));
+    result = _mm_add_ps(_mm_mul_ps(result, values_sq), _mm_set1_ps(+0.0083333310f));
+    result = _mm_add_ps(_mm_mul_ps(result, values_sq), _mm_set1_ps(-0.16666667f));
+    result = _mm_add_ps(_mm_mul_ps(result, values_sq), _mm_set1_ps(1.0f));
+
+    return _mm_mul_ps(result, values);
+}
+
+/**
+ * Arc cosine of four values in [-1, 1], using the same approximation as the AVX2 kernels.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128 ACos4(__m128 values)
+{
+    const __m128 cvSignMask = _mm_castsi128_ps(_mm_set1_epi32(scSignMask32));
+
+    const __m128 sign = _mm_and_ps(values, cvSignMask);
+    const __m128 abs_values = _mm_andnot_ps(cvSignMask, values);
+
+    __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.0012624911f), abs_values), _mm_set1_ps(0.0066700901f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(-0.0170881256f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(0.0308918810f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(-0.0501743046f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(0.0889789874f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(-0.2145988016f));
+    result = _mm_add_ps(_mm_mul_ps(result, abs_values), _mm_set1_ps(1.5707963050f));
+
+    result = _mm_mul_ps(result, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), abs_values)));
+
+    // acos(-x) = pi - acos(x)
+    const __m128 reflected = _mm_sub_ps(_mm_set1_ps(FX_PI), result);
+    return _mm_blendv_ps(result, reflected, sign);
+}
+
+FX_TARGET_SSE4 static void MulMat4Array_SSE4(float32* out, const float32* a, const float32* b, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++) {
+        const float32* a_data = a + (i * 16);
+        const float32* b_data = b + (i * 16);
+
+        const __m128 b0 = _mm_loadu_ps(b_data);
+        const __m128 b1 = _mm_loadu_ps(b_data + 4);
+        const __m128 b2 = _mm_loadu_ps(b_data + 8);
+        const __m128 b3 = _mm_loadu_ps(b_data + 12);
+
+        for (uint32 c = 0; c < 4; c++) {
+            const __m128 a_column = _mm_loadu_ps(a_data + (c * 4));
+
+            __m128 result = _mm_mul_ps(_mm_shuffle_ps(a_column, a_column, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_column, a_column, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_column, a_column, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_column, a_column, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+            _mm_storeu_ps(out + (i * 16) + (c * 4), result);
+        }
+    }
+}
+
+FX_TARGET_SSE4 static void ComposeTRSBlock(float32* out, const float32* translations, const float32* rotations,
+                                           const float32* scales)
+{
+    __m128 t[4], q[4], s[4];
+
+    LoadSoA(translations, 4, t);
+    LoadSoA(rotations, 4, q);
+    LoadSoA(scales, 4, s);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    // Same as `Mat4f::AsRotation()`
+    const __m128 tx = _mm_add_ps(q[0], q[0]);
+    const __m128 ty = _mm_add_ps(q[1], q[1]);
+    const __m128 tz = _mm_add_ps(q[2], q[2]);
+
+    const __m128 xx = _mm_mul_ps(tx, q[0]);
+    const __m128 yy = _mm_mul_ps(ty, q[1]);
+    const __m128 zz = _mm_mul_ps(tz, q[2]);
+
+    const __m128 xy = _mm_mul_ps(tx, q[1]);
+    const __m128 xz = _mm_mul_ps(tx, q[2]);
+    const __m128 xw = _mm_mul_ps(tx, q[3]);
+
+    const __m128 yz = _mm_mul_ps(ty, q[2]);
+    const __m128 yw = _mm_mul_ps(ty, q[3]);
+    const __m128 zw = _mm_mul_ps(tz, q[3]);
+
+    constexpr uint32 cMatrixStride = 16;
+
+    StoreSoA(out, cMatrixStride, _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), s[0]),
+             _mm_mul_ps(_mm_add_ps(xy, zw), s[0]), _mm_mul_ps(_mm_sub_ps(xz, yw), s[0]), zero);
+
+    StoreSoA(out + 4, cMatrixStride, _mm_mul_ps(_mm_sub_ps(xy, zw), s[1]),
+             _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, zz), xx), s[1]), _mm_mul_ps(_mm_add_ps(yz, xw), s[1]), zero);
+
+    StoreSoA(out + 8, cMatrixStride, _mm_mul_ps(_mm_add_ps(xz, yw), s[2]), _mm_mul_ps(_mm_sub_ps(yz, xw), s[2]),
+             _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), s[2]), zero);
+
+    StoreSoA(out + 12, cMatrixStride, t[0], t[1], t[2], one);
+}
+
+FX_TARGET_SSE4 static void ComposeTRSArray_SSE4(float32* out, const float32* translations, const float32* rotations,
+                                                const float32* scales, uint32 count)
+{
+    uint32 index = 0;
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        ComposeTRSBlock(out + (index * 16), translations + (index * 4), rotations + (index * 4), scales + (index * 4));
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    // Pad the last block out to the full size so that the results match the rest of the array
+    float32 tail_out[scBlockSize * 16];
+    float32 tail_translations[scBlockSize * 4] = {};
+    float32 tail_rotations[scBlockSize * 4] = {};
+    float32 tail_scales[scBlockSize * 4] = {};
+
+    memcpy(tail_translations, translations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_rotations, rotations + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_scales, scales + (index * 4), sizeof(float32) * 4 * remaining);
+
+    ComposeTRSBlock(tail_out, tail_translations, tail_rotations, tail_scales);
+
+    memcpy(out + (index * 16), tail_out, sizeof(float32) * 16 * remaining);
+}
+
+FX_TARGET_SSE4 static void SLerpBlock(float32* out, const float32* a, const float32* b, __m128 step)
+{
+    __m128 qa[4], qb[4];
+
+    LoadSoA(a, 4, qa);
+    LoadSoA(b, 4, qb);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    __m128 cos_half_theta = _mm_mul_ps(qa[0], qb[0]);
+    cos_half_theta = _mm_add_ps(cos_half_theta, _mm_mul_ps(qa[1], qb[1]));
+    cos_half_theta = _mm_add_ps(cos_half_theta, _mm_mul_ps(qa[2], qb[2]));
+    cos_half_theta = _mm_add_ps(cos_half_theta, _mm_mul_ps(qa[3], qb[3]));
+
+    // Lanes where qa = qb or qa = -qb keep qa, as in `Quat::SLerp()`
+    const __m128 abs_cos = _mm_andnot_ps(_mm_castsi128_ps(_mm_set1_epi32(scSignMask32)), cos_half_theta);
+    const __m128 same_mask = _mm_cmpge_ps(abs_cos, one);
+
+    const __m128 half_theta = ACos4(cos_half_theta);
+    const __m128 sin_half_theta = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cos_half_theta, cos_half_theta)));
+
+    // Lanes where theta is 180 degrees take the midpoint
+    const __m128 opposite_mask = _mm_cmplt_ps(sin_half_theta, _mm_set1_ps(0.001f));
+
+    const __m128 sht_recip = _mm_div_ps(one, sin_half_theta);
+    const __m128 ratio_a = _mm_mul_ps(Sin4(_mm_mul_ps(_mm_sub_ps(one, step), half_theta)), sht_recip);
+    const __m128 ratio_b = _mm_mul_ps(Sin4(_mm_mul_ps(step, half_theta)), sht_recip);
+
+    __m128 result[4];
+
+    for (uint32 c = 0; c < 4; c++) {
+        const __m128 slerped = _mm_add_ps(_mm_mul_ps(qa[c], ratio_a), _mm_mul_ps(qb[c], ratio_b));
+        const __m128 midpoint = _mm_add_ps(_mm_mul_ps(qa[c], half), _mm_mul_ps(qb[c], half));
+
+        result[c] = _mm_blendv_ps(slerped, midpoint, opposite_mask);
+        result[c] = _mm_blendv_ps(result[c], qa[c], same_mask);
+    }
+
+    StoreSoA(out, 4, result[0], result[1], result[2], result[3]);
+}
+
+FX_TARGET_SSE4 static void SLerpArray_SSE4(float32* out, const float32* a, const float32* b, float32 step,
+                                           const float32* steps, uint32 count)
+{
+    uint32 index = 0;
+
+    for (; index + scBlockSize <= count; index += scBlockSize) {
+        const __m128 step_v = (steps != nullptr) ? _mm_loadu_ps(steps + index) : _mm_set1_ps(step);
+        SLerpBlock(out + (index * 4), a + (index * 4), b + (index * 4), step_v);
+    }
+
+    const uint32 remaining = count - index;
+
+    if (remaining == 0) {
+        return;
+    }
+
+    float32 tail_out[scBlockSize * 4];
+    float32 tail_a[scBlockSize * 4] = {};
+    float32 tail_b[scBlockSize * 4] = {};
+    float32 tail_steps[scBlockSize] = {};
+
+    memcpy(tail_a, a + (index * 4), sizeof(float32) * 4 * remaining);
+    memcpy(tail_b, b + (index * 4), sizeof(float32) * 4 * remaining);
+
+    if (steps != nullptr) {
+        memcpy(tail_steps, steps + index, sizeof(float32) * remaining);
+    }
+
+    const __m128 step_v = (steps != nullptr) ? _mm_loadu_ps(tail_steps) : _mm_set1_ps(step);
+    SLerpBlock(tail_out, tail_a, tail_b, step_v);
+
+    memcpy(out + (index * 4), tail_out, sizeof(float32) * 4 * remaining);
+}
+
+/**
+ * Loads the three floats of a position, without reading past the end of it.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128 LoadPosition(const uint8* position)
+{
+    float32 values[4];
+    memcpy(values, position, sizeof(float32) * 3);
+    values[3] = 0.0f;
+
+    return _mm_loadu_ps(values);
+}
+
+FX_TARGET_SSE4 static void CalculateBounds_SSE4(const uint8* positions, uint32 stride, uint32 count, float32* out_min,
+                                                float32* out_max)
+{
+    __m128 min_values = LoadPosition(positions);
+    __m128 max_values = min_values;
+
+    // Positions are loaded 16 bytes at a time (the fourth component is discarded), so the last position is loaded
+    // separately to not read past the end of the array.
+    for (uint32 index = 1; index + 1 < count; index++) {
+        const __m128 values = _mm_loadu_ps(reinterpret_cast<const float32*>(positions + (uint64(index) * stride)));
+
+        min_values = _mm_min_ps(min_values, values);
+        max_values = _mm_max_ps(max_values, values);
+    }
+
+    if (count > 1) {
+        const __m128 values = LoadPosition(positions + (uint64(count - 1) * stride));
+
+        min_values = _mm_min_ps(min_values, values);
+        max_values = _mm_max_ps(max_values, values);
+    }
+
+    float32 min_floats[4];
+    float32 max_floats[4];
+
+    _mm_storeu_ps(min_floats, min_values);
+    _mm_storeu_ps(max_floats, max_values);
+
+    memcpy(out_min, min_floats, sizeof(float32) * 3);
+    memcpy(out_max, max_floats, sizeof(float32) * 3);
+}
+
+const KernelTable gSSE4Kernels = {
+    .MulMat4Array = MulMat4Array_SSE4,
+    .ComposeTRSArray = ComposeTRSArray_SSE4,
+    .SLerpArray = SLerpArray_SSE4,
+    .CalculateBounds = CalculateBounds_SSE4,
+};
+
+} // namespace fx::MathBatch
+
+#endif // FX_USE_CPU_DISPATCH
@@ -27,9 +27,9 @@ __m128 Mat4f::MultiplyVec4f_SSE(const Vec4f& vec)
     __m128 v3 = SSE::Permute4<SSE::Shuffle_AW>(v);
 
     __m128 result = _mm_mul_ps(Columns[0].mIntrin, v0);
-    result = _mm_fmadd_ps(Columns[1].mIntrin, v1, result);
-    result = _mm_fmadd_ps(Columns[2].mIntrin, v2, result);
-    result = _mm_fmadd_ps(Columns[3].mIntrin, v3, result);
+    result = SSE::MulAdd(Columns[1].mIntrin, v1, result);
+    result = SSE::MulAdd(Columns[2].mIntrin, v2, result);
+    result = SSE::MulAdd(Columns[3].mIntrin, v3, result);
 
     return result;
 }
@@ -209,24 +209,24 @@ Mat4f Mat4f::AsRotationZ(float rad)
     const float cr = cos(rad);
     const float sr = sin(rad);
 
-    // float32x4_t zero = vdupq_n_f32(0);
+    const __m128 one_zzz = _mm_set_ss(1.0f);
 
     // {cos(x), sin(x), 0, 0}
-    // float c0_low_v[2] = { cr, sr };
-    // float32x4_t c0 = vcombine_f32(vld1_f32(c0_low_v), vget_low_f32(zero));
-    // result.Columns[0].mIntrin = c0;
-
-    //// {-1, 1}
-    // float32x2_t nmask = vset_lane_f32(-1, vdup_n_f32(1), 0);
+    const float32 c0_v alignas(16)[4] = { cr, sr, 0, 0 };
+    const __m128 c0 = _mm_load_ps(c0_v);
+    result.Columns[0].mIntrin = c0;
 
-    //// {-sin(x), cos(x), 0, 0}
-    // result.Columns[1].mIntrin = vcombine_f32(vmul_f32(vrev64_f32(vget_low_f32(c0)), nmask), vget_high_f32(c0));
+    // {-sin(x), cos(x), 0, 0}
+    const __m128 c1 = SSE::Permute4<SSE::Shuffle_AY, SSE::Shuffle_AX, SSE::Shuffle_AZ, SSE::Shuffle_AW>(c0);
+    result.Columns[1].mIntrin = SSE::FlipSigns<-1, 1, 1, 1>(c1);
 
-    //// {0, 0, 1, 0}
-    // result.Columns[2].mIntrin = vsetq_lane_f32(1, zero, 2);
+    // {0, 0, 1, 0}
+    result.Columns[2].mIntrin = SSE::Permute4<SSE::Shuffle_AY, SSE::Shuffle_AZ, SSE::Shuffle_AX, SSE::Shuffle_AW>(
+        one_zzz);
 
-    //// {0, 0, 0, 1}
-    // result.Columns[3].mIntrin = vsetq_lane_f32(1, zero, 3);
+    // {0, 0, 0, 1}
+    result.Columns[3].mIntrin = SSE::Permute4<SSE::Shuffle_AW, SSE::Shuffle_AY, SSE::Shuffle_AZ, SSE::Shuffle_AX>(
+        one_zzz);
 
     /*
      CX = cos(x), SX = sin(x)
@@ -266,6 +266,7 @@ Mat4f Mat4f::operator*(const Mat4f& other) const
         ahalf0    ahalf1
     */
 
+#ifdef FX_SSE_HAS_AVX
     // Load the columns of this matrix into two vectors.
 
     // Pack both columns into one (256bit) vector.
@@ -330,6 +331,23 @@ Mat4f Mat4f::operator*(const Mat4f& other) const
     result.Columns[3].mIntrin = _mm256_extractf128_ps(temp0_r, 1);
 
     return result;
+#else
+    // Without AVX, each column is computed on its own from the splatted components of this matrix's column
+    Mat4f result;
+
+    for (int i = 0; i < 4; i++) {
+        const __m128 column = Columns[i].mIntrin;
+
+        __m128 value = _mm_mul_ps(SSE::Permute4<SSE::Shuffle_AX>(column), other.Columns[0].mIntrin);
+        value = SSE::MulAdd(SSE::Permute4<SSE::Shuffle_AY>(column), other.Columns[1].mIntrin, value);
+        value = SSE::MulAdd(SSE::Permute4<SSE::Shuffle_AZ>(column), other.Columns[2].mIntrin, value);
+        value = SSE::MulAdd(SSE::Permute4<SSE::Shuffle_AW>(column), other.Columns[3].mIntrin, value);
+
+        result.Columns[i].mIntrin = value;
+    }
+
+    return result;
+#endif
 }
 
 
@@ -424,6 +442,7 @@ Mat4f Mat4f::Transposed() const
         [ M N O P ]
     */
 
+#ifdef FX_SSE_HAS_AVX
     // Build a AVX vector for each half of the matrix
     __m256 ahalf0 = _mm256_castps128_ps256(Columns[0].mIntrin);
     ahalf0 = _mm256_insertf128_ps(ahalf0, Columns[1].mIntrin, 1);
@@ -455,6 +474,13 @@ Mat4f Mat4f::Transposed() const
     result.Columns[3].mIntrin = _mm256_extractf128_ps(ahalf1, 1);
 
     return result;
+#else
+    Mat4f result = *this;
+    _MM_TRANSPOSE4_PS(result.Columns[0].mIntrin, result.Columns[1].mIntrin, result.Columns[2].mIntrin,
+                      result.Columns[3].mIntrin);
+
+    return result;
+#endif
 }
 
 Mat4f Mat4f::TransposeMat3() { return Transposed(); }
@@ -18,8 +18,7 @@ const Quat Quat::sIdentity = Quat(0, 0, 0, 1);
 
 Quat::Quat(float32 x, float32 y, float32 z, float32 w)
 {
-    float32 values alignas(16)[4] = { x, y, z, w };
-    mIntrin = _mm_load_ps(values);
+    mIntrin = _mm_setr_ps(x, y, z, w);
 }
 
 Quat::Quat(const JPH::Quat& other) { mIntrin = other.mValue.mValue; }
@@ -27,7 +26,7 @@ Quat::Quat(const JPH::Quat& other) { mIntrin = other.mValue.mValue; }
 Quat Quat::FromAxisAngle(Vec3f axis, float32 angle)
 {
     float32 sv, cv;
-    MathUtil::SinCos(angle, &sv, &cv);
+    MathUtil::SinCos(angle * 0.5f, &sv, &cv);
 
     const __m128 vec = _mm_mul_ps(SSE::Normalize(axis.mIntrin), _mm_set1_ps(sv));
 
@@ -213,7 +212,7 @@ Vec3f Quat::GetEulerAngles() const
     float t3 = 2.0f * (W * Z + X * Y);
     float t4 = 1.0f - 2.0f * (y_sq + Z * Z);
 
-    return Vec3f(atan2(t0, t1), sin(t2), atan2(t3, t4));
+    return Vec3f(atan2(t0, t1), asin(t2), atan2(t3, t4));
 }
 
 } // namespace fx
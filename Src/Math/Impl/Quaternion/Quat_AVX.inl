@@ -52,7 +52,7 @@ FX_FORCE_INLINE void Quat::NLerpIP(const Quat& dest, float32 time)
     __m128 dest_v = dest.mIntrin;
 
     if (SSE::Dot(mIntrin, dest.mIntrin) < 0.0f) {
-        dest_v = SSE::SetSigns<-1>(dest_v);
+        dest_v = SSE::FlipSigns<-1, -1, -1, -1>(dest_v);
     }
 
     const __m128 inv_time_v = _mm_set1_ps(1.0 - time);
@@ -62,7 +62,7 @@ FX_FORCE_INLINE void Quat::NLerpIP(const Quat& dest, float32 time)
     mIntrin = _mm_mul_ps(inv_time_v, mIntrin);
 
     //  ... + time * B  ->  time * dest + mIntrin
-    mIntrin = _mm_fmadd_ps(time_v, dest_v, mIntrin);
+    mIntrin = SSE::MulAdd(time_v, dest_v, mIntrin);
 
     mIntrin = SSE::Normalize(mIntrin);
 }
@@ -95,7 +95,7 @@ Quat Quat::SLerp(const Quat& dest, const float32 step) const
         __m128 half = _mm_set1_ps(0.5f);
 
         result = _mm_mul_ps(a_v, half);
-        result = _mm_fmadd_ps(b_v, half, result);
+        result = SSE::MulAdd(b_v, half, result);
 
         return Quat(result);
     }
@@ -105,7 +105,7 @@ Quat Quat::SLerp(const Quat& dest, const float32 step) const
     float32 ratioB = sinf(step * half_theta) * sht_recip;
 
     result = _mm_mul_ps(a_v, _mm_set1_ps(ratioA));
-    result = _mm_fmadd_ps(b_v, _mm_set1_ps(ratioB), result);
+    result = SSE::MulAdd(b_v, _mm_set1_ps(ratioB), result);
 
     return Quat(result);
 }
@@ -214,7 +214,7 @@ Vec3f Quat::GetEulerAngles() const
     float t3 = 2.0f * (W * Z + X * Y);
     float t4 = 1.0f - 2.0f * (y_sq + Z * Z);
 
-    return Vec3f(atan2(t0, t1), sin(t2), atan2(t3, t4));
+    return Vec3f(atan2(t0, t1), asin(t2), atan2(t3, t4));
 }
 
 } // namespace fx
@@ -42,7 +42,7 @@ FX_FORCE_INLINE void Quat::NLerpIP(const Quat& dest, float32 time)
     float32x4_t dest_v = dest.mIntrin;
 
     if (Neon::Dot(mIntrin, dest.mIntrin) < 0.0f) {
-        dest_v = Neon::SetSigns<-1>(dest_v);
+        dest_v = Neon::FlipSigns<-1, -1, -1, -1>(dest_v);
     }
 
     const float32x4_t inv_time_v = vdupq_n_f32(1.0f - time);
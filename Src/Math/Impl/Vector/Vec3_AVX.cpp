@@ -43,10 +43,8 @@ Vec3f Vec3f::CrossSlow(const Vec3f& other) const
 
 Vec3f Vec3f::Rotate(const Quat& rotation) const
 {
-    const __m128 zero_v = _mm_setzero_ps();
-
-    Quat vec = Quat(_mm_shuffle_ps(mIntrin, zero_v, _MM_SHUFFLE(0, 1, 2, 4)));
-    LogInfo("Vec: {}", vec);
+    // { X, Y, Z, 0 }
+    Quat vec = Quat(_mm_blend_ps(mIntrin, _mm_setzero_ps(), 0x8));
     Quat conj_v = rotation.Conjugate();
 
     Quat result = conj_v * vec;
@@ -11,8 +11,7 @@ namespace fx {
 
 FX_FORCE_INLINE Vec3f::Vec3f(float32 x, float32 y, float32 z, float32 w)
 {
-    const float32 values alignas(16)[4] = { x, y, z, w };
-    mIntrin = _mm_load_ps(values);
+    mIntrin = _mm_setr_ps(x, y, z, w);
 }
 
 FX_FORCE_INLINE Vec3f::Vec3f(const float32* unaligned)
@@ -31,7 +30,7 @@ FX_FORCE_INLINE bool Vec3f::IsCloseTo(const Vec3f& other, const float32 toleranc
 
 FX_FORCE_INLINE Vec3f Vec3f::MulAdd(const Vec3f& a, const Vec3f& b, const Vec3f& accum)
 {
-    return Vec3f(_mm_fmadd_ps(a.mIntrin, b.mIntrin, accum.mIntrin));
+    return Vec3f(SSE::MulAdd(a.mIntrin, b.mIntrin, accum.mIntrin));
 }
 
 FX_FORCE_INLINE bool Vec3f::IsCloseTo(const Vec3f::SimdType other, const float32 tolerance) const
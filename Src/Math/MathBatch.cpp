@@ -0,0 +1,98 @@
+#include "MathBatch.hpp"
+
+#include "Impl/Batch/MathBatchKernels.hpp"
+#include "Mat4.hpp"
+#include "Quat.hpp"
+#include "Vec3.hpp"
+
+namespace fx::MathBatch {
+
+static_assert(sizeof(Quat) == sizeof(float32) * 4);
+static_assert(sizeof(Vec3f) == sizeof(float32) * 4);
+static_assert(sizeof(Mat4f) == sizeof(float32) * 16);
+
+const KernelTable& GetKernelTable(eCpuTier tier)
+{
+#if defined FX_USE_CPU_DISPATCH
+    switch (tier) {
+    case eCpuTier::AVX512:
+        return gAVX512Kernels;
+    case eCpuTier::AVX2:
+        return gAVX2Kernels;
+    case eCpuTier::SSE4:
+        return gSSE4Kernels;
+    case eCpuTier::Scalar:
+        break;
+    }
+
+    return gScalarKernels;
+#elif defined FX_USE_AVX
+    return (tier >= eCpuTier::AVX2) ? gAVX2Kernels : gScalarKernels;
+#elif defined FX_USE_NEON
+    (void)tier;
+    return gNeonKernels;
+#else
+    (void)tier;
+    return gScalarKernels;
+#endif
+}
+
+/**
+ * Returns the kernels for the host CPU, selected on the first call.
+ */
+static const KernelTable& GetKernels()
+{
+    static const KernelTable& sKernels = GetKernelTable(CpuFeatures::GetInstance().GetTier());
+    return sKernels;
+}
+
+template <typename T>
+FX_FORCE_INLINE static float32* AsFloats(T* values)
+{
+    return reinterpret_cast<float32*>(values);
+}
+
+template <typename T>
+FX_FORCE_INLINE static const float32* AsFloats(const T* values)
+{
+    return reinterpret_cast<const float32*>(values);
+}
+
+void MulMat4Array(Mat4f* out, const Mat4f* a, const Mat4f* b, uint32 count)
+{
+    GetKernels().MulMat4Array(AsFloats(out), AsFloats(a), AsFloats(b), count);
+}
+
+void ComposeTRSArray(Mat4f* out, const Vec3f* translations, const Quat* rotations, const Vec3f* scales, uint32 count)
+{
+    GetKernels().ComposeTRSArray(AsFloats(out), AsFloats(translations), AsFloats(rotations), AsFloats(scales), count);
+}
+
+void SLerpArray(Quat* out, const Quat* a, const Quat* b, float32 step, uint32 count)
+{
+    GetKernels().SLerpArray(AsFloats(out), AsFloats(a), AsFloats(b), step, nullptr, count);
+}
+
+void SLerpArray(Quat* out, const Quat* a, const Quat* b, const float32* steps, uint32 count)
+{
+    GetKernels().SLerpArray(AsFloats(out), AsFloats(a), AsFloats(b), 0.0f, steps, count);
+}
+
+void CalculateBounds(const void* positions, uint32 stride, uint32 count, Vec3f* out_min, Vec3f* out_max)
+{
+    if (count == 0) {
+        (*out_min) = Vec3f::sZero;
+        (*out_max) = Vec3f::sZero;
+        return;
+    }
+
+    float32 min_values[3];
+    float32 max_values[3];
+
+    GetKernels().CalculateBounds(static_cast<const uint8*>(positions), stride, count, min_values, max_values);
+
+    (*out_min) = Vec3f(min_values[0], min_values[1], min_values[2]);
+    (*out_max) = Vec3f(max_values[0], max_values[1], max_values[2]);
+}
+
+} // namespace fx::MathBatch
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Core/Defines.hpp>
+#include <Core/Types.hpp>
+
+namespace fx {
+
+class Mat4f;
+class Quat;
+class Vec3f;
+
+} // namespace fx
+
+/**
+ * Kernels that apply a transform operation over whole arrays at once.
+ *
+ * On AVX2 the elements are processed eight at a time; they are transposed into structure-of-arrays registers (one
+ * register per component) so that each instruction works on eight elements, and transposed back when stored. SSE4 and
+ * NEON process blocks of four. Each kernel gives the same result as calling the per-element function in a loop, within
+ * floating point error.
+ *
+ * On x86-64 the implementation is chosen for the host CPU the first time that a kernel is called (see `CpuFeatures`).
+ *
+ * Arrays do not need to be a multiple of the block size. The output array may be the same as an input array, but they
+ * may not partially overlap.
+ */
+namespace fx::MathBatch {
+
+/**
+ * @brief Multiplies each pair of matrices, `out[i] = a[i] * b[i]`.
+ */
+void MulMat4Array(Mat4f* out, const Mat4f* a, const Mat4f* b, uint32 count);
+
+/**
+ * @brief Builds a model matrix from each translation, rotation and scale. This is the same as
+ * `Mat4f::AsScale(scales[i]) * Mat4f::AsRotation(rotations[i]) * Mat4f::AsTranslation(translations[i])`.
+ */
+void ComposeTRSArray(Mat4f* out, const Vec3f* translations, const Quat* rotations, const Vec3f* scales, uint32 count);
+
+/**
+ * @brief Spherical linear interpolation between each pair of quaternions, `out[i] = a[i].SLerp(b[i], step)`.
+ */
+void SLerpArray(Quat* out, const Quat* a, const Quat* b, float32 step, uint32 count);
+
+/**
+ * @brief Spherical linear interpolation between each pair of quaternions with a step per element,
+ * `out[i] = a[i].SLerp(b[i], steps[i])`.
+ */
+void SLerpArray(Quat* out, const Quat* a, const Quat* b, const float32* steps, uint32 count);
+
+/**
+ * @brief Calculates the bounds of an array of positions, where each position is three floats at the start of an
+ * element `stride` bytes long (such as a vertex).
+ *
+ * If `count` is zero, the bounds are set to zero.
+ */
+void CalculateBounds(const void* positions, uint32 stride, uint32 count, Vec3f* out_min, Vec3f* out_max);
+
+} // namespace fx::MathBatch
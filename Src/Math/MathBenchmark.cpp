@@ -0,0 +1,219 @@
+#include "MathBenchmark.hpp"
+
+#include "Mat4.hpp"
+#include "MathBatch.hpp"
+#include "MathConsts.hpp"
+#include "Quat.hpp"
+#include "Vec3.hpp"
+
+#include <Core/Log.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace fx {
+
+/// Largest difference allowed between a batch result and the per-element result.
+static constexpr float32 scBatchTolerance = 1e-4f;
+
+static constexpr uint32 scBatchSizes[] = { 1000, 10000, 100000 };
+
+struct BatchBenchmarkData
+{
+    std::vector<Mat4f> MatricesA;
+    std::vector<Mat4f> MatricesB;
+
+    std::vector<Vec3f> Translations;
+    std::vector<Vec3f> Scales;
+
+    std::vector<Quat> RotationsA;
+    std::vector<Quat> RotationsB;
+    std::vector<float32> Steps;
+
+    std::vector<Mat4f> ScalarMatrices;
+    std::vector<Mat4f> BatchMatrices;
+
+    std::vector<Quat> ScalarRotations;
+    std::vector<Quat> BatchRotations;
+};
+
+static void GenerateBatchData(BatchBenchmarkData& data, uint32 count)
+{
+    std::mt19937 rng(0xF0C5);
+    std::uniform_real_distribution<float32> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float32> angle(-FX_PI, FX_PI);
+
+    auto random_quat = [&]()
+    {
+        const Vec3f axis(unit(rng), unit(rng), unit(rng) + 2.0f);
+        return Quat::FromAxisAngle(axis, angle(rng));
+    };
+
+    data.MatricesA.resize(count);
+    data.MatricesB.resize(count);
+    data.Translations.resize(count);
+    data.Scales.resize(count);
+    data.RotationsA.resize(count);
+    data.RotationsB.resize(count);
+    data.Steps.resize(count);
+
+    for (uint32 i = 0; i < count; i++) {
+        for (uint32 component = 0; component < 16; component++) {
+            data.MatricesA[i].RawData[component] = unit(rng);
+            data.MatricesB[i].RawData[component] = unit(rng);
+        }
+
+        data.Translations[i] = Vec3f(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f);
+        data.Scales[i] = Vec3f(unit(rng) + 1.5f, unit(rng) + 1.5f, unit(rng) + 1.5f);
+
+        data.RotationsA[i] = random_quat();
+        data.RotationsB[i] = random_quat();
+        data.Steps[i] = (unit(rng) + 1.0f) * 0.5f;
+    }
+
+    data.ScalarMatrices.resize(count);
+    data.BatchMatrices.resize(count);
+    data.ScalarRotations.resize(count);
+    data.BatchRotations.resize(count);
+}
+
+static float32 GetMaxError(const std::vector<Mat4f>& expected, const std::vector<Mat4f>& result)
+{
+    float32 max_error = 0.0f;
+
+    for (uint32 i = 0; i < expected.size(); i++) {
+        for (uint32 component = 0; component < 16; component++) {
+            const float32 error = fabsf(expected[i].RawData[component] - result[i].RawData[component]);
+            max_error = std::max(max_error, error);
+        }
+    }
+
+    return max_error;
+}
+
+static float32 GetMaxError(const std::vector<Quat>& expected, const std::vector<Quat>& result)
+{
+    float32 max_error = 0.0f;
+
+    for (uint32 i = 0; i < expected.size(); i++) {
+        max_error = std::max(max_error, fabsf(expected[i].GetX() - result[i].GetX()));
+        max_error = std::max(max_error, fabsf(expected[i].GetY() - result[i].GetY()));
+        max_error = std::max(max_error, fabsf(expected[i].GetZ() - result[i].GetZ()));
+        max_error = std::max(max_error, fabsf(expected[i].GetW() - result[i].GetW()));
+    }
+
+    return max_error;
+}
+
+/**
+ * Returns the best time in nanoseconds per element of `iterations` runs of `func`.
+ */
+template <typename TFunc>
+static double TimeBest(uint32 iterations, uint32 count, TFunc&& func)
+{
+    using Clock = std::chrono::steady_clock;
+
+    double best_ns = 0.0;
+
+    for (uint32 iteration = 0; iteration < iterations; iteration++) {
+        const auto start_time = Clock::now();
+
+        func();
+
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start_time).count() / count;
+
+        if (iteration == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+    }
+
+    return best_ns;
+}
+
+static bool ReportBatchResult(const char* name, uint32 count, double scalar_ns, double batch_ns, float32 max_error)
+{
+    const bool passed = (max_error <= scBatchTolerance);
+
+    if (!passed) {
+        LogError(LC_CORE, "Batch benchmark: {} x{} differs from the per-element result by {}", name, count, max_error);
+    }
+
+    LogInfo(LC_CORE, "    {:<16} x{:<7} Scalar: {:6.2f} ns/elem   Batch: {:6.2f} ns/elem ({:.2f}x)", name, count,
+            scalar_ns, batch_ns, scalar_ns / batch_ns);
+
+    return passed;
+}
+
+bool MathBenchmarkBatch(uint32 iterations)
+{
+    LogInfo(LC_CORE, "Batch benchmark: {} runs per size", iterations);
+
+    bool passed = true;
+
+    for (const uint32 count : scBatchSizes) {
+        BatchBenchmarkData data;
+        GenerateBatchData(data, count);
+
+        // MulMat4Array
+        {
+            const double scalar_ns = TimeBest(iterations, count, [&]()
+            {
+                for (uint32 i = 0; i < count; i++) {
+                    data.ScalarMatrices[i] = data.MatricesA[i] * data.MatricesB[i];
+                }
+            });
+
+            const double batch_ns = TimeBest(iterations, count, [&]()
+            {
+                MathBatch::MulMat4Array(data.BatchMatrices.data(), data.MatricesA.data(), data.MatricesB.data(), count);
+            });
+
+            passed &= ReportBatchResult("MulMat4Array", count, scalar_ns, batch_ns,
+                                        GetMaxError(data.ScalarMatrices, data.BatchMatrices));
+        }
+
+        // ComposeTRSArray
+        {
+            const double scalar_ns = TimeBest(iterations, count, [&]()
+            {
+                for (uint32 i = 0; i < count; i++) {
+                    data.ScalarMatrices[i] = Mat4f::AsScale(data.Scales[i]) * Mat4f::AsRotation(data.RotationsA[i]) *
+                                             Mat4f::AsTranslation(data.Translations[i]);
+                }
+            });
+
+            const double batch_ns = TimeBest(iterations, count, [&]()
+            {
+                MathBatch::ComposeTRSArray(data.BatchMatrices.data(), data.Translations.data(), data.RotationsA.data(),
+                                           data.Scales.data(), count);
+            });
+
+            passed &= ReportBatchResult("ComposeTRSArray", count, scalar_ns, batch_ns,
+                                        GetMaxError(data.ScalarMatrices, data.BatchMatrices));
+        }
+
+        // SLerpArray
+        {
+            const double scalar_ns = TimeBest(iterations, count, [&]()
+            {
+                for (uint32 i = 0; i < count; i++) {
+                    data.ScalarRotations[i] = data.RotationsA[i].SLerp(data.RotationsB[i], data.Steps[i]);
+                }
+            });
+
+            const double batch_ns = TimeBest(iterations, count, [&]()
+            {
+                MathBatch::SLerpArray(data.BatchRotations.data(), data.RotationsA.data(), data.RotationsB.data(),
+                                      data.Steps.data(), count);
+            });
+
+            passed &= ReportBatchResult("SLerpArray", count, scalar_ns, batch_ns,
+                                        GetMaxError(data.ScalarRotations, data.BatchRotations));
+        }
+    }
+
+    return passed;
+}
+
+} // namespace fx
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx {
+
+/**
+ * @brief Times the `MathBatch` kernels against calling the per-element function in a loop, for arrays of 1K, 10K and
+ * 100K elements, and logs the time per element for each.
+ *
+ * The inputs are random matrices, unit quaternions, translations and scales from a fixed seed. Each timing is the
+ * best of `iterations` runs.
+ *
+ * @returns False if any batch result differs from the per-element result by more than a small tolerance.
+ */
+bool MathBenchmarkBatch(uint32 iterations = 16);
+
+} // namespace fx
@@ -40,19 +40,15 @@ void SinCos(float32 in_angle, float32* out_sine, float32* out_cosine)
     static constexpr float32 scPi = FX_PI;
     static constexpr float32 scHalfPi = FX_HALF_PI;
 
-    if (in_angle > FX_2PI) {
-        in_angle = -FX_2PI;
-    }
-    else if (in_angle < -FX_2PI) {
-        in_angle = FX_2PI;
-    }
+    // Wrap the angle to [-Pi, Pi], x mod 2Pi = x - (round(x / 2Pi) * 2Pi)
+    in_angle -= std::round(in_angle * static_cast<float32>(FX_1_OVER_2PI)) * static_cast<float32>(FX_2PI);
 
     uint32 angle_sign = AsUInt(in_angle) & scSignMask;
 
     // Pi if the sign is positive, -Pi if the sign is negative.
     float32 pi_or_neg_pi = AsFloat(AsUInt(scPi) | angle_sign);
 
-    uint32 cmp_result = (float32((~angle_sign) & AsUInt(in_angle)) <= float32(scHalfPi)) ? 0xFFFFFFFF : 0x00000000;
+    uint32 cmp_result = (AsFloat((~angle_sign) & AsUInt(in_angle)) <= scHalfPi) ? 0xFFFFFFFF : 0x00000000;
 
     uint32 sel0 = (cmp_result & AsUInt(in_angle));
     uint32 sel1 = ((~cmp_result) & AsUInt((pi_or_neg_pi - in_angle)));
@@ -15,3 +15,13 @@
 #warning "SSE.hpp should not be included when producing a non-SSE build!"
 #endif
 #endif
+
+// The SSE type layer only needs SSE4.1, so that x86-64 builds without -mavx2 can still use it. AVX and FMA
+// instructions are used where the build enables them (see `SSE::MulAdd()`).
+#if defined __AVX__ || defined FX_USE_SIMDE
+#define FX_SSE_HAS_AVX 1
+#endif
+
+#if defined __FMA__ || defined __AVX2__ || defined FX_USE_SIMDE
+#define FX_SSE_HAS_FMA 1
+#endif
@@ -13,10 +13,10 @@ namespace fx {
 static constexpr uint32 sConstSignMask = 0x80000000;
 
 static constexpr float32 sConstHalfPi = FX_PI_2;
-static constexpr float32 sConstPi = M_PI;
+static constexpr float32 sConstPi = FX_PI;
 static constexpr float32 sConst3HalfPi = sConstHalfPi * 3.0f;
 
-static constexpr float32 sConst2Pi = M_PI * 2.0;
+static constexpr float32 sConst2Pi = FX_2PI;
 static constexpr float32 sConstInv2Pi = 1.0f / sConst2Pi;
 
 namespace SSE {
@@ -26,7 +26,7 @@ namespace SSE {
 void SinCos4(__m128 in_values, __m128* ysin, __m128* ycos)
 {
     const __m128 cvOne = _mm_set1_ps(1.0);
-    const __m128 cvSignMask = _mm_set1_ps(SSE::scSignMask32);
+    const __m128 cvSignMask = _mm_castsi128_ps(_mm_set1_epi32(SSE::scSignMask32));
 
     const __m128 cvSineCoeff1 = _mm_set1_ps(-2.3889859e-08f);
     const __m128 cvSineCoeff0 = _mm_setr_ps(-0.16666667f, +0.0083333310f, -0.00019840874f, +2.7525562e-06f);
@@ -37,6 +37,12 @@ void SinCos4(__m128 in_values, __m128* ysin, __m128* ycos)
     const __m128 cvPi = _mm_set1_ps(FX_PI);
     const __m128 cvHalfPi = _mm_set1_ps(FX_HALF_PI);
 
+    // Wrap the values to [-pi, pi], x mod 2pi = x - (round(x / 2pi) * 2pi)
+    {
+        const __m128 r0 = _mm_round_ps(_mm_mul_ps(in_values, _mm_set1_ps(sConstInv2Pi)), _MM_FROUND_TO_NEAREST_INT);
+        in_values = SSE::NegMulAdd(r0, _mm_set1_ps(sConst2Pi), in_values);
+    }
+
     __m128 sign = _mm_and_ps(in_values, cvSignMask);
     __m128 pi_or_neg_pi = _mm_or_ps(cvPi, sign);
     __m128 le_result = _mm_cmple_ps(_mm_andnot_ps(sign, in_values), cvHalfPi);
@@ -53,38 +59,38 @@ void SinCos4(__m128 in_values, __m128* ysin, __m128* ycos)
     __m128 values_sq = _mm_mul_ps(in_values, in_values);
 
     // Sine approximation
-    __m128 scoeff0 = _mm_permute_ps(cvSineCoeff0, _MM_SHUFFLE(3, 3, 3, 3));
-    __m128 result = _mm_fmadd_ps(cvSineCoeff1, values_sq, scoeff0);
+    __m128 scoeff0 = SSE::Permute4<SSE::Shuffle_AW>(cvSineCoeff0);
+    __m128 result = SSE::MulAdd(cvSineCoeff1, values_sq, scoeff0);
 
-    scoeff0 = _mm_permute_ps(cvSineCoeff0, _MM_SHUFFLE(2, 2, 2, 2));
-    result = _mm_fmadd_ps(result, values_sq, scoeff0);
+    scoeff0 = SSE::Permute4<SSE::Shuffle_AZ>(cvSineCoeff0);
+    result = SSE::MulAdd(result, values_sq, scoeff0);
 
-    scoeff0 = _mm_permute_ps(cvSineCoeff0, _MM_SHUFFLE(1, 1, 1, 1));
-    result = _mm_fmadd_ps(result, values_sq, scoeff0);
+    scoeff0 = SSE::Permute4<SSE::Shuffle_AY>(cvSineCoeff0);
+    result = SSE::MulAdd(result, values_sq, scoeff0);
 
-    scoeff0 = _mm_permute_ps(cvSineCoeff0, _MM_SHUFFLE(0, 0, 0, 0));
-    result = _mm_fmadd_ps(result, values_sq, scoeff0);
+    scoeff0 = SSE::Permute4<SSE::Shuffle_AX>(cvSineCoeff0);
+    result = SSE::MulAdd(result, values_sq, scoeff0);
 
-    result = _mm_fmadd_ps(result, values_sq, cvOne);
+    result = SSE::MulAdd(result, values_sq, cvOne);
     result = _mm_mul_ps(result, in_values);
 
     (*ysin) = result;
 
     // Cosine approximation
 
-    __m128 ccoeff0 = _mm_permute_ps(cvCosineCoeff0, _MM_SHUFFLE(3, 3, 3, 3));
-    result = _mm_fmadd_ps(cvCosineCoeff1, values_sq, ccoeff0);
+    __m128 ccoeff0 = SSE::Permute4<SSE::Shuffle_AW>(cvCosineCoeff0);
+    result = SSE::MulAdd(cvCosineCoeff1, values_sq, ccoeff0);
 
-    ccoeff0 = _mm_permute_ps(cvCosineCoeff0, _MM_SHUFFLE(2, 2, 2, 2));
-    result = _mm_fmadd_ps(result, values_sq, ccoeff0);
+    ccoeff0 = SSE::Permute4<SSE::Shuffle_AZ>(cvCosineCoeff0);
+    result = SSE::MulAdd(result, values_sq, ccoeff0);
 
-    ccoeff0 = _mm_permute_ps(cvCosineCoeff0, _MM_SHUFFLE(1, 1, 1, 1));
-    result = _mm_fmadd_ps(result, values_sq, ccoeff0);
+    ccoeff0 = SSE::Permute4<SSE::Shuffle_AY>(cvCosineCoeff0);
+    result = SSE::MulAdd(result, values_sq, ccoeff0);
 
-    ccoeff0 = _mm_permute_ps(cvCosineCoeff0, _MM_SHUFFLE(0, 0, 0, 0));
-    result = _mm_fmadd_ps(result, values_sq, ccoeff0);
+    ccoeff0 = SSE::Permute4<SSE::Shuffle_AX>(cvCosineCoeff0);
+    result = SSE::MulAdd(result, values_sq, ccoeff0);
 
-    result = _mm_fmadd_ps(result, values_sq, cvOne);
+    result = SSE::MulAdd(result, values_sq, cvOne);
     result = _mm_mul_ps(result, sign);
 
     (*ycos) = result;
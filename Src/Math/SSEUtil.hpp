@@ -8,6 +8,7 @@
 
 #include <Core/Types.hpp>
 #include <bit>
+#include <cmath>
 
 namespace fx::SSE {
 
@@ -48,7 +49,12 @@ FX_FORCE_INLINE __m128 Permute4(__m128 a)
     static_assert(TComp4 < Shuffle_BX);
 
     constexpr uint8 permute = _MM_SHUFFLE(TComp4, TComp3, TComp2, TComp1);
+
+#ifdef FX_SSE_HAS_AVX
     return _mm_permute_ps(a, permute);
+#else
+    return _mm_shuffle_ps(a, a, permute);
+#endif
 }
 
 template <eShuffleComponent TComp>
@@ -57,7 +63,36 @@ FX_FORCE_INLINE __m128 Permute4(__m128 a)
     static_assert(TComp < Shuffle_BX);
 
     constexpr uint8 permute = _MM_SHUFFLE(TComp, TComp, TComp, TComp);
+
+#ifdef FX_SSE_HAS_AVX
     return _mm_permute_ps(a, permute);
+#else
+    return _mm_shuffle_ps(a, a, permute);
+#endif
+}
+
+/**
+ * @brief Returns `(a * b) + c`. This is a single fused multiply-add on builds with FMA.
+ */
+FX_FORCE_INLINE __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+{
+#ifdef FX_SSE_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+/**
+ * @brief Returns `c - (a * b)`. This is a single fused multiply-add on builds with FMA.
+ */
+FX_FORCE_INLINE __m128 NegMulAdd(__m128 a, __m128 b, __m128 c)
+{
+#ifdef FX_SSE_HAS_FMA
+    return _mm_fnmadd_ps(a, b, c);
+#else
+    return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
 }
 
 
@@ -6,6 +6,7 @@
 #include <ThirdParty/Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <ThirdParty/Jolt/Physics/EActivation.h>
 
+#include <AnimationManager.hpp>
 #include <Core/RefUtil.hpp>
 #include <Engine.hpp>
 #include <Material/Material.hpp>
@@ -17,6 +18,7 @@
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/PrimitiveMesh.hpp>
 #include <Renderer/RenderBackend.hpp>
+#include <Renderer/SkinningPass.hpp>
 #include <Scene.hpp>
 
 namespace fx {
@@ -167,24 +169,21 @@ void Object::UpdateAnimation()
 		pCurrentAnimation = &Animations[0];
 	}
 
-	if (!pCurrentAnimation || !pSkeleton) {
+	if (!pCurrentAnimation || !pSkeleton || AnimInstance != AnimInstanceNull || mbAnimInstanceFailed) {
 		return;
 	}
 
+	// Poses are evaluated and written to this object's palette by `AnimationManager::Update()`
+	AnimInstance = gAnimationManager->CreateInstance(pSkeleton);
 
-	if (AnimationTime >= pCurrentAnimation->Duration) {
-		AnimationTime = 0.0f;
-	}
-	else if (AnimationTime < 0.0001f) {
-		AnimationTime = pCurrentAnimation->Duration;
+	// The error has been logged by the animation manager. The object is drawn in the bind pose, and the instance is not
+	// created again each frame.
+	if (AnimInstance == AnimInstanceNull) {
+		mbAnimInstanceFailed = true;
+		return;
 	}
 
-	pSkeleton->EvaluatePose(*pCurrentAnimation, AnimationTime);
-
-	AnimationTime += 0.01f;
-
-	gRenderer->BoneBuffer.Rewind();
-	gRenderer->BoneBuffer.CopyFrom(pSkeleton->SkinningMatrices.pData, pSkeleton->SkinningMatrices.Size * sizeof(Mat4f));
+	gAnimationManager->Play(AnimInstance, pCurrentAnimation);
 }
 
 void Object::MakeInstanceOf(const ObjectID& source_id)
@@ -248,10 +247,56 @@ void Object::RenderShallow(const Camera& camera, renderer::Pipeline* pipeline)
 }
 
 
+void Object::SkinVertices()
+{
+	SkinnedVertexOffset = SkinningPass::scNotSkinned;
+
+	if (!IsSkinned() || !CheckIfReady(false)) {
+		return;
+	}
+
+	SkinnedVertexOffset = gSkinningPass->Skin(*pMesh, gAnimationManager->GetPaletteOffset(AnimInstance));
+}
+
+void Object::DrawMesh(const CommandBuffer& cmd)
+{
+	const uint32 num_instances = (mInstanceSlotsInUse + 1); // + 1 for source object
+
+	if (SkinnedVertexOffset != SkinningPass::scNotSkinned) {
+		pMesh->Render(cmd, num_instances, gSkinningPass->GetOutputBuffer(), SkinnedVertexOffset);
+		return;
+	}
+
+	// The geometry and shadow pipelines read `Default` or `Compact` vertices, so a skinned mesh that was not skinned
+	// this frame (the skinning pass is disabled or its output is full) is not drawn.
+	if (IsSkinned()) {
+		if (!mbWarnedNotSkinned) {
+			LogWarning(LC_RENDER, "Skipping draw of object '{}', its mesh was not skinned this frame", Name.Get());
+			mbWarnedNotSkinned = true;
+		}
+
+		return;
+	}
+
+	pMesh->Render(cmd, num_instances);
+}
+
+ePipelineName Object::GetRequiredPipeline() const
+{
+	Material* material = gMaterialManager->GetMaterial(mMaterialID);
+	const ePipelineName pipeline_name = (material != nullptr) ? material->GetRequiredPipeline() : ePipelineName::Geometry;
+
+	if (pMesh && pMesh->VertexList.IsCompact()) {
+		return PipelineNameUtil::GetCompactVariant(pipeline_name);
+	}
+
+	return pipeline_name;
+}
+
 void Object::RenderPrimitive(const CommandBuffer& cmd)
 {
 	if (pMesh && CheckIfReady(false)) {
-		pMesh->Render(cmd, (mInstanceSlotsInUse + 1));
+		DrawMesh(cmd);
 	}
 
 	// if (AttachedNodes.IsEmpty()) {
@@ -270,14 +315,13 @@ void Object::RenderMesh(renderer::Pipeline* pipeline)
 	FrameData* frame = gRenderer->GetFrame();
 	CommandBuffer& cmd = frame->CmdBuffer;
 
-	Material* mat = gMaterialManager->GetMaterial(mMaterialID);
-	if (mat) {
-		Assert(mat->GetRequiredPipeline() == pipeline->Name);
-	}
+	Assert(GetRequiredPipeline() == pipeline->Name);
 
 	// If there was an error binding the object material, bind the null material.
-	if (!gMaterialManager->BindWithPipeline(cmd, *pipeline, mMaterialID)) {
-		gMaterialManager->BindWithPipeline(cmd, *pipeline, MaterialID::Null);
+	const uint32 bone_offset = gAnimationManager->GetPaletteOffset(AnimInstance);
+
+	if (!gMaterialManager->BindWithPipeline(cmd, *pipeline, mMaterialID, bone_offset)) {
+		gMaterialManager->BindWithPipeline(cmd, *pipeline, MaterialID::Null, bone_offset);
 	}
 
 	const uint32 buffer_offsets[] = { gObjectManager->GetBaseOffset(), 0 };
@@ -286,7 +330,7 @@ void Object::RenderMesh(renderer::Pipeline* pipeline)
 										 Slice<const uint32>(buffer_offsets, std::size(buffer_offsets)));
 
 	if (pMesh) {
-		pMesh->Render(cmd, (mInstanceSlotsInUse + 1)); // + 1 for source object
+		DrawMesh(cmd);
 	}
 }
 
@@ -445,6 +489,10 @@ void Object::Destroy()
 
 	pScene = nullptr;
 
+	if (gAnimationManager != nullptr) {
+		gAnimationManager->DestroyInstance(AnimInstance);
+	}
+
 	if (!AttachedNodes.IsEmpty()) {
 		for (ObjectID& obj_id : AttachedNodes) {
 			Object* obj = gObjectManager->GetObject(obj_id);
@@ -6,6 +6,7 @@
 // #include <ThirdParty/Jolt/Physics/Body/Body.h>
 // #include <ThirdParty/Jolt/Physics/Body/BodyID.h>
 
+#include <AnimationManager.hpp>
 #include <Asset/Animation.hpp>
 #include <Core/Name.hpp>
 #include <Core/PagedArray.hpp>
@@ -14,6 +15,8 @@
 #include <Entity.hpp>
 #include <Material/MaterialID.hpp>
 #include <Math/BoundingBox.hpp>
+#include <Renderer/PipelineNames.hpp>
+#include <Renderer/SkinningPass.hpp>
 #include <Script/FoxScript.hpp>
 #include <WorldGrid.hpp>
 
@@ -60,6 +63,12 @@ public:
 	void RenderPrimitive(const renderer::CommandBuffer& cmd);
 	void RenderShallow(const Camera& camera, renderer::Pipeline* alt_pipeline = nullptr);
 
+	/**
+	 * @brief Skins the vertices of the mesh for this frame with the skinning pass, if the mesh is skinned. The skinned
+	 * vertices are then drawn in place of the mesh's vertices until the next call.
+	 */
+	void SkinVertices();
+
 	bool CheckIfReady(bool require_material);
 	void AttachObject(const ObjectID& object);
 
@@ -75,7 +84,10 @@ public:
 
 	void PrintDebug() const;
 
-	// XXX: TEMP
+	/**
+	 * @brief Starts playing the first animation on the object's skeleton through the animation manager, if the object
+	 * has not been registered yet.
+	 */
 	void UpdateAnimation();
 
 	/**
@@ -105,6 +117,12 @@ public:
 	 */
 	FX_FORCE_INLINE void SetMaterialID(const MaterialID& id) { mMaterialID = id; };
 
+	/**
+	 * @brief Returns the pipeline that the object is drawn with. This is the pipeline of the material, or its compact
+	 * variant if the mesh has compact vertices.
+	 */
+	renderer::ePipelineName GetRequiredPipeline() const;
+
 	/////////////////////////////////////
 	// Physics
 	/////////////////////////////////////
@@ -153,6 +171,11 @@ private:
 	 * done by RenderShallow et. al!
 	 */
 	void RenderMesh(renderer::Pipeline* pipeline);
+
+	/**
+	 * @brief Binds the vertices and draws the mesh, from the skinning pass output if the mesh was skinned this frame.
+	 */
+	void DrawMesh(const renderer::CommandBuffer& cmd);
 	void SetScriptVars();
 
 	void SyncObjectWithPhysics(PhObject* phys);
@@ -164,7 +187,10 @@ public:
 	Ref<Skeleton> pSkeleton { nullptr };
 	SizedArray<Animation> Animations;
 	Animation* pCurrentAnimation = nullptr;
-	float32 AnimationTime = 0.0f;
+	AnimInstanceId AnimInstance = AnimInstanceNull;
+
+	/// Offset of the skinned vertices for this frame in the skinning pass output (see `SkinVertices()`).
+	uint64 SkinnedVertexOffset = renderer::SkinningPass::scNotSkinned;
 
 	Scene* pScene = nullptr;
 	ObjectID ParentID = ObjectID::Null;
@@ -186,6 +212,12 @@ private:
 	eObjectFlags Flags = eObjectFlags::None;
 	eObjectLayer mObjectLayer = eObjectLayer::WorldLayer;
 
+	/// Set when an animation instance could not be created for the skeleton, so it is not created again each frame.
+	bool mbAnimInstanceFailed = false;
+
+	/// Set once a draw has been skipped because the mesh was not skinned, so the warning is only logged once.
+	bool mbWarnedNotSkinned = false;
+
 	friend class WorldGrid;
 };
 
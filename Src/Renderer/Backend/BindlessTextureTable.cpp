@@ -0,0 +1,172 @@
+#include "BindlessTextureTable.hpp"
+
+#include "DescriptorCache.hpp"
+#include "DsLayoutBuilder.hpp"
+#include "Image.hpp"
+#include "Pipeline.hpp"
+#include "Sampler/Sampler.hpp"
+#include "Util.hpp"
+
+#include <Core/Log.hpp>
+#include <Renderer/Globals.hpp>
+#include <Renderer/RenderBackend.hpp>
+#include <algorithm>
+
+FX_SET_MODULE_NAME("BindlessTextureTable")
+
+namespace fx::renderer {
+
+bool BindlessTextureTable::Create(GpuDevice* device)
+{
+	if (IsInited()) {
+		return true;
+	}
+
+	if (!device->bSupportsBindlessTextures) {
+		LogInfo(LC_RENDER, "Bindless textures are not supported by the device, materials will bind their textures");
+		return false;
+	}
+
+	mCapacity = std::min(scMaxTextures, device->MaxBindlessTextures);
+
+	// Entries that are not written are never read, as the shaders only index textures that are in the table
+	constexpr VkDescriptorBindingFlags cBindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+													   VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+													   VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+	DsLayoutBuilder layout_builder;
+	layout_builder.AddBinding(scBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, eShaderType::Pixel, mCapacity,
+							  cBindingFlags);
+
+	VkDescriptorSetLayout layout = layout_builder.Build();
+
+	if (layout == nullptr) {
+		LogError(LC_RENDER, "Could not create the bindless texture table layout");
+		return false;
+	}
+
+	// The layout is owned by the layout cache, so that pipelines can be built with it (see `PSOBuild::AddExistingDS()`)
+	mLayoutID = DsLayoutID(HashStr32("BindlessTextureTable"));
+	gDsLayoutCache->Cache[mLayoutID.ID] = layout;
+
+	mPool.AddPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, mCapacity);
+	mPool.Create(device, 1, false, true);
+
+	VkDescriptorSetAllocateInfo alloc_info {};
+	alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	alloc_info.descriptorPool = mPool.Get();
+	alloc_info.descriptorSetCount = 1;
+	alloc_info.pSetLayouts = &layout;
+
+	VkResult status = vkAllocateDescriptorSets(device->Device, &alloc_info, &mDescriptorSet);
+
+	if (status != VK_SUCCESS) {
+		ModulePanicVulkan("Failed to allocate the bindless texture table!", status);
+	}
+
+	renderer::Util::SetDebugLabel("BindlessTextureTable", VK_OBJECT_TYPE_DESCRIPTOR_SET, mDescriptorSet);
+
+	LogInfo(LC_RENDER, "Created bindless texture table with {} entries", mCapacity);
+
+	return true;
+}
+
+uint32 BindlessTextureTable::Add(Image* image, Sampler* sampler)
+{
+	AssertMsg(IsInited(), "Bindless texture table is not initialized!");
+	Assert(image != nullptr && sampler != nullptr);
+
+	uint32 index = scInvalidIndex;
+
+	{
+		std::lock_guard guard(mMutex);
+		index = TakeFreeIndex();
+	}
+
+	if (index == scInvalidIndex) {
+		LogWarning(LC_RENDER, "Bindless texture table is full ({} entries)", mCapacity);
+		return scInvalidIndex;
+	}
+
+	const VkDescriptorImageInfo image_info {
+		.sampler = sampler->Get(),
+		.imageView = image->View,
+		.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	};
+
+	const VkWriteDescriptorSet image_write {
+		.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		.dstSet = mDescriptorSet,
+		.dstBinding = scBinding,
+		.dstArrayElement = index,
+		.descriptorCount = 1,
+		.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		.pImageInfo = &image_info,
+	};
+
+	vkUpdateDescriptorSets(gRenderer->GetDevice()->Device, 1, &image_write, 0, nullptr);
+
+	return index;
+}
+
+void BindlessTextureTable::Remove(uint32 index)
+{
+	if (!IsInited() || index == scInvalidIndex) {
+		return;
+	}
+
+	std::lock_guard guard(mMutex);
+
+	mRemovedEntries.push_back(
+		RemovedEntry { .Index = index, .ReuseFrame = gRenderer->GetElapsedFrameCount() + scReuseFrameSpacing });
+}
+
+uint32 BindlessTextureTable::TakeFreeIndex()
+{
+	const uint32 frame = gRenderer->GetElapsedFrameCount();
+
+	// Entries are removed in frame order, so the entries that can be reused are at the front
+	uint32 reusable_count = 0;
+	while (reusable_count < mRemovedEntries.size() && mRemovedEntries[reusable_count].ReuseFrame <= frame) {
+		mFreeIndices.push_back(mRemovedEntries[reusable_count].Index);
+		++reusable_count;
+	}
+
+	mRemovedEntries.erase(mRemovedEntries.begin(), mRemovedEntries.begin() + reusable_count);
+
+	if (!mFreeIndices.empty()) {
+		const uint32 index = mFreeIndices.back();
+		mFreeIndices.pop_back();
+
+		return index;
+	}
+
+	if (mNextIndex < mCapacity) {
+		return mNextIndex++;
+	}
+
+	return scInvalidIndex;
+}
+
+void BindlessTextureTable::Bind(uint32 set_index, const CommandBuffer& cmd, const Pipeline& pipeline) const
+{
+	vkCmdBindDescriptorSets(cmd, pipeline.BindPoint, pipeline.Layout.Get(), set_index, 1, &mDescriptorSet, 0,
+							nullptr);
+}
+
+void BindlessTextureTable::Destroy()
+{
+	if (!IsInited()) {
+		return;
+	}
+
+	// The set is freed with the pool
+	mPool.Destroy();
+	mDescriptorSet = nullptr;
+
+	mFreeIndices.clear();
+	mRemovedEntries.clear();
+	mNextIndex = 0;
+}
+
+} // namespace fx::renderer
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "DescriptorID.hpp"
+#include "Descriptors.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <Core/Types.hpp>
+#include <Renderer/Constants.hpp>
+#include <mutex>
+#include <vector>
+
+namespace fx {
+
+class Image;
+
+namespace renderer {
+
+class CommandBuffer;
+class GpuDevice;
+class Pipeline;
+class Sampler;
+
+/**
+ * @brief A large array of combined image samplers in one descriptor set, which shaders index by the texture indices
+ * in `MaterialProperties`.
+ *
+ * The set is bound once per pipeline, so drawing objects with different materials does not bind any descriptor sets.
+ * The array is partially bound and updated after bind, so textures can be added while the set is in use by the frames
+ * in flight. Removed entries are only reused once those frames have finished (see `scReuseFrameSpacing`).
+ *
+ * This requires descriptor indexing (see `GpuDevice::bSupportsBindlessTextures`).
+ */
+class BindlessTextureTable
+{
+public:
+	/// The most textures in the table. This is lowered to the device limit if it is smaller.
+	static constexpr uint32 scMaxTextures = 16384;
+
+	static constexpr uint32 scBinding = 0;
+
+	/// Returned by `Add()` when the table is full.
+	static constexpr uint32 scInvalidIndex = UINT32_MAX;
+
+	/// The number of frames after an entry is removed before it can be reused, as the frames in flight may read it.
+	static constexpr uint32 scReuseFrameSpacing = FramesInFlight + 1;
+
+private:
+	struct RemovedEntry
+	{
+		uint32 Index = 0;
+
+		/// The first frame in which the entry can be reused (see `RenderBackend::GetElapsedFrameCount()`).
+		uint32 ReuseFrame = 0;
+	};
+
+public:
+	BindlessTextureTable() = default;
+
+	/**
+	 * @brief Creates the descriptor set layout, pool and set of the table.
+	 * @returns False if the device does not support bindless textures.
+	 */
+	bool Create(GpuDevice* device);
+
+	FX_FORCE_INLINE bool IsInited() const { return mDescriptorSet != nullptr; }
+
+	/**
+	 * @brief Writes `image` to a free entry of the table.
+	 * @returns The index of the entry, or `scInvalidIndex` if the table is full.
+	 */
+	uint32 Add(Image* image, Sampler* sampler);
+
+	/**
+	 * @brief Frees the entry at `index`. The entry may still be read by the frames in flight, so it is only reused
+	 * after `scReuseFrameSpacing` frames.
+	 */
+	void Remove(uint32 index);
+
+	/**
+	 * @brief Binds the table to `set_index` of `pipeline`, which must have been built with the table's layout (see
+	 * `PSOBuild::AddExistingDS()`).
+	 */
+	void Bind(uint32 set_index, const CommandBuffer& cmd, const Pipeline& pipeline) const;
+
+	FX_FORCE_INLINE DsLayoutID GetLayoutID() const { return mLayoutID; }
+	FX_FORCE_INLINE uint32 GetCapacity() const { return mCapacity; }
+
+	void Destroy();
+	~BindlessTextureTable() { Destroy(); }
+
+private:
+	/**
+	 * @brief Returns a free entry, or `scInvalidIndex` if the table is full. `mMutex` must be locked.
+	 */
+	uint32 TakeFreeIndex();
+
+private:
+	DescriptorPool mPool;
+	VkDescriptorSet mDescriptorSet = nullptr;
+
+	DsLayoutID mLayoutID { HashNull32 };
+
+	uint32 mCapacity = 0;
+	uint32 mNextIndex = 0;
+
+	std::vector<uint32> mFreeIndices;
+	std::vector<RemovedEntry> mRemovedEntries;
+	std::mutex mMutex;
+};
+
+} // namespace renderer
+
+} // namespace fx
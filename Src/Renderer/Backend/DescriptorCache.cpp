@@ -139,6 +139,14 @@ void DescriptorCache::Free(DescriptorID id)
 		return;
 	}
 
+	// The descriptor set is still used by other requests
+	auto count_it = UseCounts.find(id.ID);
+	if (count_it != UseCounts.end() && --count_it->second > 0) {
+		return;
+	}
+
+	UseCounts.erase(id.ID);
+
 	// Note we aren't going to destroy the attached DsLayout here. This is mainly because its likely that multiple other
 	// descriptor sets are using the same layout, but also the size is pretty small. There also aren't really _that_
 	// many combinations for descriptor set layouts, so destroying it here wouldn't really matter.
@@ -195,6 +203,8 @@ std::pair<DescriptorID, DescriptorSet*> DescriptorCache::Request(const SizedArra
 
 	auto it = Cache.find(descriptor_id.ID);
 
+	++UseCounts[descriptor_id.ID];
+
 	// If the descriptor set is already created, return it
 	if (it != Cache.end()) {
 		return std::make_pair(descriptor_id, &it->second);
@@ -238,6 +248,7 @@ void DescriptorCache::Destroy()
 {
 	Pools.Destroy();
 	Cache.clear();
+	UseCounts.clear();
 }
 
 
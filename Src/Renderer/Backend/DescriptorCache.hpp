@@ -49,7 +49,8 @@ public:
 	DescriptorSet* RequestExisting(DescriptorID descriptor_id);
 
 	/**
-	 * @brief Frees a descriptor set and its linked layout from the cache.
+	 * @brief Releases a request for a descriptor set. Requests with the same entries share a descriptor set, so the set
+	 * is only freed from the cache once every request for it has been released.
 	 */
 	void Free(DescriptorID descriptor_id);
 
@@ -63,6 +64,9 @@ public:
 public:
 	PagedArray<DescriptorPool> Pools;
 	std::unordered_map<Hash32, DescriptorSet, Hash32Stl> Cache;
+
+	/// The number of requests for each descriptor set in the cache that have not been freed.
+	std::unordered_map<Hash32, uint32, Hash32Stl> UseCounts;
 };
 
 } // namespace renderer
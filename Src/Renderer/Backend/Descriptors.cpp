@@ -82,7 +82,7 @@ VkDescriptorType DescriptorEntry::GetDescriptorType() const
 // Descriptor Pool Functions
 /////////////////////////////////////
 
-void DescriptorPool::Create(GpuDevice* device, uint32 max_sets, bool enable_descriptor_free)
+void DescriptorPool::Create(GpuDevice* device, uint32 max_sets, bool enable_descriptor_free, bool update_after_bind)
 {
 	const uint32 pool_sizes_count = RemainingDescriptorCounts.size();
 	SizedArray<VkDescriptorPoolSize> pool_sizes(pool_sizes_count);
@@ -102,6 +102,10 @@ void DescriptorPool::Create(GpuDevice* device, uint32 max_sets, bool enable_desc
 		pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 	}
 
+	if (update_after_bind) {
+		pool_info.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+	}
+
 	SetCapacity = max_sets;
 
 	VkResult status = vkCreateDescriptorPool(device->Device, &pool_info, nullptr, &Pool);
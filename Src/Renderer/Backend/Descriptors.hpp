@@ -26,7 +26,13 @@ struct Target;
 class DescriptorPool
 {
 public:
-	void Create(GpuDevice* device, uint32 max_sets = 10, bool enable_descriptor_free = false);
+	/**
+	 * @brief Creates the pool with the sizes added by `AddPoolSize()`.
+	 * @param update_after_bind Allow sets with update after bind layouts (see `DsLayoutBuilder::AddBinding()`) to be
+	 * allocated from the pool.
+	 */
+	void Create(GpuDevice* device, uint32 max_sets = 10, bool enable_descriptor_free = false,
+				bool update_after_bind = false);
 
 	bool IsInited() const { return (Pool != nullptr); }
 	FX_FORCE_INLINE VkDescriptorPool Get() const { return Pool; }
@@ -98,7 +104,7 @@ public:
 class DescriptorSet
 {
 private:
-	static constexpr uint32 scMaxBuffers = 2;
+	static constexpr uint32 scMaxBuffers = 3;
 	static constexpr uint32 scMaxImages = 6;
 
 	static constexpr uint32 scMaxDescriptorEntries = scMaxBuffers + scMaxImages;
@@ -6,6 +6,7 @@
 #include <vulkan/vulkan.h>
 
 #include <Core/Assert.hpp>
+#include <algorithm>
 
 FX_SET_MODULE_NAME("Device")
 
@@ -226,7 +227,35 @@ void GpuDevice::CreateLogicalDevice()
         });
     }
 
-    const VkPhysicalDeviceFeatures device_features {};
+    VkPhysicalDeviceVulkan12Features supported_vk12_features {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+    };
+
+    VkPhysicalDeviceFeatures2 supported_features2 {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &supported_vk12_features,
+    };
+
+    vkGetPhysicalDeviceFeatures2(Physical, &supported_features2);
+
+    const VkPhysicalDeviceFeatures& supported_features = supported_features2.features;
+
+    // Used for textures from the texture cache. When BC formats are not supported the cache is stored uncompressed.
+    bSupportsTextureCompressionBC = (supported_features.textureCompressionBC == VK_TRUE);
+
+    // Used for the bindless texture table. When these are not supported each material binds its own textures.
+    bSupportsBindlessTextures = (supported_features.shaderSampledImageArrayDynamicIndexing == VK_TRUE &&
+                                 supported_vk12_features.runtimeDescriptorArray == VK_TRUE &&
+                                 supported_vk12_features.descriptorBindingPartiallyBound == VK_TRUE &&
+                                 supported_vk12_features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+                                 supported_vk12_features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE);
+
+    const VkBool32 enable_bindless = bSupportsBindlessTextures ? VK_TRUE : VK_FALSE;
+
+    const VkPhysicalDeviceFeatures device_features {
+        .textureCompressionBC = supported_features.textureCompressionBC,
+        .shaderSampledImageArrayDynamicIndexing = enable_bindless,
+    };
 
     std::vector<const char*> device_extensions = {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -253,13 +282,29 @@ void GpuDevice::CreateLogicalDevice()
 
     };
 
+    VkPhysicalDeviceVulkan12Features vk12_features {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = nullptr,
+        .descriptorBindingSampledImageUpdateAfterBind = enable_bindless,
+        .descriptorBindingUpdateUnusedWhilePending = enable_bindless,
+        .descriptorBindingPartiallyBound = enable_bindless,
+        .runtimeDescriptorArray = enable_bindless,
+    };
+
+    vk11_features.pNext = &vk12_features;
+
     if (requires_portability_extension) {
-        vk11_features.pNext = &portability_features;
+        vk12_features.pNext = &portability_features;
     }
 
     {
+        VkPhysicalDeviceDescriptorIndexingProperties indexing_properties {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+        };
+
         VkPhysicalDeviceDriverProperties driver_properties {
             .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES,
+            .pNext = &indexing_properties,
         };
 
         VkPhysicalDeviceProperties2 physical_properties {
@@ -272,6 +317,14 @@ void GpuDevice::CreateLogicalDevice()
         LogInfo(LC_RENDER, "Creating device for physical device (Id={}) {} -- driver {}",
                 physical_properties.properties.deviceID, physical_properties.properties.deviceName,
                 driver_properties.driverName);
+
+        // Combined image samplers count against both the sampler and the sampled image limits
+        MaxBindlessTextures = std::min({
+            indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+            indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+            indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+            indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+        });
     }
 
 
@@ -123,6 +123,15 @@ public:
 
     QueueFamilies mQueueFamilies;
 
+    /// True if the BC4, BC5 and BC7 image formats can be sampled.
+    bool bSupportsTextureCompressionBC = false;
+
+    /// True if sampled images can be read from a partially bound, update after bind descriptor array (see
+    /// `BindlessTextureTable`).
+    bool bSupportsBindlessTextures = false;
+
+    /// The most combined image samplers that can be in an update after bind descriptor set.
+    uint32 MaxBindlessTextures = 0;
 
 private:
     VkInstance mInstance;
@@ -5,11 +5,13 @@
 
 namespace fx::renderer {
 
-DsLayoutBuilder& DsLayoutBuilder::AddBinding(int binding, VkDescriptorType type, eShaderType stage, int count)
+DsLayoutBuilder& DsLayoutBuilder::AddBinding(int binding, VkDescriptorType type, eShaderType stage, int count,
+                                              VkDescriptorBindingFlags flags)
 {
     const VkSampler* pcImmutableSamplers = nullptr;
 
     mLayoutBindings.emplace_back(binding, type, count, ShaderUtil::ToUnderlyingType(stage), pcImmutableSamplers);
+    mBindingFlags.emplace_back(flags);
 
     return *this;
 }
@@ -17,12 +19,31 @@ DsLayoutBuilder& DsLayoutBuilder::AddBinding(int binding, VkDescriptorType type,
 
 VkDescriptorSetLayout DsLayoutBuilder::Build()
 {
+    const VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = static_cast<uint32>(mBindingFlags.size()),
+        .pBindingFlags = mBindingFlags.data(),
+    };
+
     VkDescriptorSetLayoutCreateInfo create_info {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
         .bindingCount = static_cast<uint32>(mLayoutBindings.size()),
         .pBindings = mLayoutBindings.data(),
     };
 
+    // Only pass the binding flags when they are used, as they require Vulkan 1.2 (or VK_EXT_descriptor_indexing)
+    for (const VkDescriptorBindingFlags flags : mBindingFlags) {
+        if (flags == 0) {
+            continue;
+        }
+
+        create_info.pNext = &binding_flags_info;
+
+        if (flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT) {
+            create_info.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        }
+    }
+
     VkResult status = vkCreateDescriptorSetLayout(gRenderer->GetDevice()->Device, &create_info, nullptr, &mpDsLayout);
 
     if (status != VK_SUCCESS) {
@@ -12,7 +12,12 @@ class DsLayoutBuilder
 public:
 	DsLayoutBuilder() = default;
 
-	DsLayoutBuilder& AddBinding(int binding, VkDescriptorType type, eShaderType stage, int count = 1);
+	/**
+	 * @brief Adds a binding to the layout. If any binding has `VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT` set, the
+	 * layout must be allocated from a pool that was created with `update_after_bind` (see `DescriptorPool::Create()`).
+	 */
+	DsLayoutBuilder& AddBinding(int binding, VkDescriptorType type, eShaderType stage, int count = 1,
+								VkDescriptorBindingFlags flags = 0);
 
 	VkDescriptorSetLayout Build();
 
@@ -22,6 +27,7 @@ private:
 	// TODO: Replace usage of std::vector with custom dynamic array. PagedArray does not resize into a contiguous
 	// buffer, so that does not work here.
 	std::vector<VkDescriptorSetLayoutBinding> mLayoutBindings {};
+	std::vector<VkDescriptorBindingFlags> mBindingFlags {};
 	VkDescriptorSetLayout mpDsLayout = nullptr;
 };
 
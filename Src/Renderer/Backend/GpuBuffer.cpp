@@ -207,4 +207,16 @@ void GpuBuffer::Create(CommandBuffer& cmd, eGpuBufferType buffer_type, const Ano
 	Create(cmd, buffer_type, data.pData, data.Size * data.ObjectSize);
 }
 
+void GpuBuffer::CreateFromBuffer(CommandBuffer& cmd, eGpuBufferType buffer_type, const RawGpuBuffer& staging_buffer,
+								 uint64 offset, uint64 size)
+{
+	AssertMsg(offset + size <= staging_buffer.Size, "Staging buffer is smaller than the copied range!");
+
+	// Create the GPU-only buffer as a transfer destination
+	this->Create(buffer_type, size, VMA_MEMORY_USAGE_GPU_ONLY, eGpuBufferFlags::TransferReceiver);
+
+	VkBufferCopy copy = { .srcOffset = offset, .dstOffset = 0, .size = Size };
+	vkCmdCopyBuffer(cmd.Get(), staging_buffer.Buffer, this->Buffer, 1, &copy);
+}
+
 } // namespace fx::renderer
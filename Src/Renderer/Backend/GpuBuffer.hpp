@@ -45,6 +45,8 @@ enum class eGpuBufferType
 	UniformWithOffset,
 	Transfer,
 	VertexBuffer,
+	/// A vertex buffer that can also be read or written by a compute shader as a storage buffer.
+	VertexStorage,
 	IndexBuffer,
 };
 
@@ -69,6 +71,8 @@ static constexpr VkBufferUsageFlags BufferTypeToUnderlying(eGpuBufferType type)
 		return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 	case eGpuBufferType::VertexBuffer:
 		return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+	case eGpuBufferType::VertexStorage:
+		return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 	case eGpuBufferType::IndexBuffer:
 		return VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 	}
@@ -88,6 +92,7 @@ static constexpr const char* BufferTypeToName(const eGpuBufferType type)
 		FX_ENUM_CASE_NAME(UniformWithOffset);
 		FX_ENUM_CASE_NAME(Transfer);
 		FX_ENUM_CASE_NAME(VertexBuffer);
+		FX_ENUM_CASE_NAME(VertexStorage);
 		FX_ENUM_CASE_NAME(IndexBuffer);
 	}
 
@@ -105,6 +110,8 @@ static constexpr VkDescriptorType BufferTypeToDescriptorType(eGpuBufferType type
 	case eGpuBufferType::Storage:
 		[[fallthrough]];
 	case eGpuBufferType::StorageWithOffset:
+		[[fallthrough]];
+	case eGpuBufferType::VertexStorage:
 		return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 
 	case eGpuBufferType::Uniform:
@@ -231,6 +238,13 @@ public:
 	void Create(CommandBuffer& cmd, eGpuBufferType buffer_type, void* data, uint64 size);
 	void Create(CommandBuffer& cmd, eGpuBufferType buffer_type, const AnonArray& data);
 
+	/**
+	 * @brief Creates the GPU-only buffer and copies `size` bytes into it from `offset` in `staging_buffer`, which can
+	 * hold the data of several buffers so that they are staged with one allocation.
+	 */
+	void CreateFromBuffer(CommandBuffer& cmd, eGpuBufferType buffer_type, const RawGpuBuffer& staging_buffer,
+						  uint64 offset, uint64 size);
+
 	template <typename TElementType>
 	void Create(CommandBuffer& cmd, eGpuBufferType buffer_type, const Slice<TElementType>& data)
 	{
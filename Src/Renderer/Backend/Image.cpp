@@ -28,6 +28,11 @@ const ImageTypeProperties ImageTypeGetProperties(eImageType image_type)
 		props.ViewType = VK_IMAGE_VIEW_TYPE_CUBE;
 		props.LayerCount = 6;
 	}
+	else if (image_type == eImageType::Array) {
+		// The number of layers is passed to `Image::Create()`
+		props.ViewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+		props.LayerCount = 1;
+	}
 	else {
 		LogError("Unknown image type!");
 	}
@@ -37,10 +42,23 @@ const ImageTypeProperties ImageTypeGetProperties(eImageType image_type)
 
 static Vec2u GetMipDimensions(const Vec2u& ml_zero_size, uint32 mip_level)
 {
-	float32 mip_divisor = (1.0f / static_cast<float32>(1U << mip_level));
+	// Each side stops halving at one pixel, so the smallest levels of non-square images are not empty
+	return Vec2u(std::max(1U, ml_zero_size.X >> mip_level), std::max(1U, ml_zero_size.Y >> mip_level));
+}
+
+/**
+ * Usage flags for images that are created from pixel data. Block compressed formats cannot be rendered to.
+ */
+static VkImageUsageFlags GetUploadUsageFlags(eImageFormat format)
+{
+	VkImageUsageFlags usage_flags = (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+									 VK_IMAGE_USAGE_SAMPLED_BIT);
+
+	if (!ImageFormatUtil::IsBlockCompressed(format)) {
+		usage_flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	}
 
-	return Vec2u(static_cast<uint32>(static_cast<float32>(ml_zero_size.X) * mip_divisor),
-				 static_cast<uint32>(static_cast<float32>(ml_zero_size.Y) * mip_divisor));
+	return usage_flags;
 }
 
 Image::Image() { mpRefCnt = gEnginePool->Alloc<RefCount>(sizeof(RefCount)); }
@@ -94,7 +112,7 @@ Image& Image::operator=(const Image& other)
 }
 
 void Image::Create(eImageType image_type, const Vec2u& size, uint16 mips_count, eImageFormat format,
-				   VkImageTiling tiling, VkImageUsageFlags usage, eImageAspectFlag aspect)
+				   VkImageTiling tiling, VkImageUsageFlags usage, eImageAspectFlag aspect, uint32 layer_count)
 {
 	Assert(size.X > 0 && size.Y > 0);
 
@@ -121,6 +139,14 @@ void Image::Create(eImageType image_type, const Vec2u& size, uint16 mips_count,
 	// Get the vulkan values for the image type
 	ImageTypeProperties image_type_props = ImageTypeGetProperties(image_type);
 
+	if (image_type == eImageType::Array) {
+		Assert(layer_count > 0);
+		image_type_props.LayerCount = layer_count;
+	}
+
+	Info.ImageType = image_type;
+	Info.LayerCount = image_type_props.LayerCount;
+
 	VkImageCreateFlags image_create_flags = 0;
 
 	if (image_type == eImageType::Cubemap) {
@@ -185,6 +211,13 @@ void Image::Create(eImageType image_type, const Vec2u& size, uint16 mips_count,
 	}
 #endif
 
+	// Single channel images are sampled as grayscale, so they can replace an RGBA image without changes to shaders
+	const bool is_single_channel = (format == eImageFormat::BC4_UNorm);
+
+	const VkComponentSwizzle swizzle_g = is_single_channel ? VK_COMPONENT_SWIZZLE_R : VK_COMPONENT_SWIZZLE_IDENTITY;
+	const VkComponentSwizzle swizzle_b = is_single_channel ? VK_COMPONENT_SWIZZLE_R : VK_COMPONENT_SWIZZLE_IDENTITY;
+	const VkComponentSwizzle swizzle_a = is_single_channel ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY;
+
 	const VkImageViewCreateInfo view_create_info = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .image = InternalImage,
@@ -193,9 +226,9 @@ void Image::Create(eImageType image_type, const Vec2u& size, uint16 mips_count,
         .components =
             {
                 .r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .a = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .g = swizzle_g,
+                .b = swizzle_b,
+                .a = swizzle_a,
             },
         .subresourceRange =
             {
@@ -242,14 +275,18 @@ void Image::CreateFromData(renderer::CommandBuffer& cmd, const ImageInfo& info,
 						  eGpuBufferFlags::TransferReceiver);
 	staging_buffer.Upload(info.ImageData);
 
-	const VkImageUsageFlags usage_flags = (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-										   VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+	CreateFromBuffer(cmd, info, staging_buffer);
+}
+
+void Image::CreateFromBuffer(renderer::CommandBuffer& cmd, const ImageInfo& info, const renderer::RawGpuBuffer& buffer)
+{
+	const VkImageUsageFlags usage_flags = GetUploadUsageFlags(info.Format);
 
 	Create(info.ImageType, info.Size, info.MipCount, info.Format, VK_IMAGE_TILING_OPTIMAL, usage_flags,
 		   eImageAspectFlag::Color);
 
-	CopyFromBuffer(cmd, staging_buffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-				   GetMipDimensions(info.Size, info.MipLevel), 0, info.MipLevel);
+	CopyFromBuffer(cmd, buffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, GetMipDimensions(info.Size, info.MipLevel), 0,
+				   info.MipLevel);
 
 	Info.MipLevel = info.MipLevel;
 }
@@ -281,16 +318,13 @@ void Image::Upload(renderer::CommandBuffer& cmd, const ImageInfo& info)
 						  eGpuBufferFlags::TransferReceiver);
 	staging_buffer.Upload(image_data);
 
-	const VkImageUsageFlags usage_flags = (VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-										   VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+	const VkImageUsageFlags usage_flags = GetUploadUsageFlags(info.Format);
 
 	Create(info.ImageType, info.Size, info.MipCount, info.Format, VK_IMAGE_TILING_OPTIMAL, usage_flags,
 		   eImageAspectFlag::Color);
 
 	SizedArray<VkBufferImageCopy> buffer_copy_infos(info.MipCount);
 
-	uint32 pixel_stride = ImageFormatUtil::GetPixelStride(info.Format);
-
 	uint64 offset = 0;
 
 	for (uint32 info_index = 0; info_index < info.MipCount; info_index++) {
@@ -314,7 +348,7 @@ void Image::Upload(renderer::CommandBuffer& cmd, const ImageInfo& info)
 				},
 		});
 
-		offset += mip_dimensions.X * mip_dimensions.Y * pixel_stride;
+		offset += ImageFormatUtil::GetDataSize(info.Format, mip_dimensions);
 	}
 
 
@@ -333,6 +367,206 @@ void Image::Upload(renderer::CommandBuffer& cmd, const ImageInfo& info)
 }
 
 
+void Image::ResizeMipChain(renderer::CommandBuffer& cmd, const Vec2u& size, uint32 mip_count)
+{
+	Assert(InternalImage != nullptr);
+	Assert(mip_count > 0);
+
+	Image resized;
+	resized.Create(eImageType::Flat, size, mip_count, Info.Format, VK_IMAGE_TILING_OPTIMAL,
+				   GetUploadUsageFlags(Info.Format), Aspect);
+
+	// Both images have the same dimensions for the levels at the end of the chain
+	const uint32 kept_count = std::min(Info.MipCount, mip_count);
+	const uint32 src_base_mip = Info.MipCount - kept_count;
+	const uint32 dst_base_mip = mip_count - kept_count;
+
+	SizedArray<VkImageCopy> image_copies(kept_count);
+
+	for (uint32 i = 0; i < kept_count; i++) {
+		const Vec2u mip_dimensions = GetMipDimensions(Info.Size, src_base_mip + i);
+
+		image_copies.Insert(VkImageCopy {
+			.srcSubresource {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.mipLevel = src_base_mip + i,
+				.baseArrayLayer = 0,
+				.layerCount = 1,
+			},
+			.srcOffset = { 0, 0, 0 },
+			.dstSubresource {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.mipLevel = dst_base_mip + i,
+				.baseArrayLayer = 0,
+				.layerCount = 1,
+			},
+			.dstOffset = { 0, 0, 0 },
+			.extent =
+				VkExtent3D {
+					.width = mip_dimensions.X,
+					.height = mip_dimensions.Y,
+					.depth = 1,
+				},
+		});
+	}
+
+	VkImageMemoryBarrier src_barrier {
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+
+		.srcAccessMask = static_cast<VkAccessFlags>(VK_ACCESS_SHADER_READ_BIT),
+		.dstAccessMask = static_cast<VkAccessFlags>(VK_ACCESS_TRANSFER_READ_BIT),
+
+		.oldLayout = ImageLayout,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+
+		.image = InternalImage,
+
+		.subresourceRange =
+			{
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel = src_base_mip,
+				.levelCount = kept_count,
+				.baseArrayLayer = 0,
+				.layerCount = 1,
+			},
+	};
+
+	vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+						 nullptr, 1, &src_barrier);
+
+	resized.TransitionMip(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd, 0, mip_count, std::nullopt);
+
+	vkCmdCopyImage(cmd, InternalImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, resized.InternalImage,
+				   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_copies.Size, image_copies.pData);
+
+	resized.TransitionMip(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cmd, 0, mip_count, std::nullopt);
+
+	// Move the new image into this one. The old image may still be sampled by the frames in flight, so it is destroyed
+	// through the deletion queue.
+	const VkImage old_image = InternalImage;
+	const VkImageView old_view = View;
+	const VmaAllocation old_allocation = Allocation;
+
+	InternalImage = resized.InternalImage;
+	View = resized.View;
+	Allocation = resized.Allocation;
+	ImageLayout = resized.ImageLayout;
+	Info = resized.Info;
+
+	resized.InternalImage = nullptr;
+	resized.View = nullptr;
+	resized.Allocation = nullptr;
+
+	renderer::gRenderer->AddToDeletionQueue(
+		[old_image, old_view, old_allocation](DeletionObject* object)
+		{
+			vkDestroyImageView(renderer::gRenderer->GetDevice()->Device, old_view, nullptr);
+			vmaDestroyImage(renderer::gRenderer->GpuAllocator, old_image, old_allocation);
+		});
+}
+
+
+void Image::CreateArrayFromImages(renderer::CommandBuffer& cmd, const Slice<Image*>& layers)
+{
+	Assert(layers.Size > 0);
+
+	const ImageInfo& layer_info = layers.pData[0]->GetInfo();
+	const uint32 layer_count = static_cast<uint32>(layers.Size);
+
+	Create(eImageType::Array, layer_info.Size, layer_info.MipCount, layer_info.Format, VK_IMAGE_TILING_OPTIMAL,
+		   GetUploadUsageFlags(layer_info.Format), eImageAspectFlag::Color, layer_count);
+
+	Info.MipLevel = layer_info.MipLevel;
+
+	TransitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd, layer_count);
+
+	SizedArray<VkImageCopy> image_copies(layer_info.MipCount);
+
+	for (uint32 layer_index = 0; layer_index < layer_count; layer_index++) {
+		Image* layer = layers.pData[layer_index];
+
+		Assert(layer->Info.Size == Info.Size && layer->Info.Format == Info.Format &&
+			   layer->Info.MipLevel == Info.MipLevel && layer->Info.MipCount == Info.MipCount);
+		Assert(layer->ImageLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+		image_copies.Clear();
+
+		// Levels before the first loaded level (see `ImageInfo::MipLevel`) are left undefined
+		for (uint32 mip_level = Info.MipLevel; mip_level < Info.MipCount; mip_level++) {
+			const Vec2u mip_dimensions = GetMipDimensions(Info.Size, mip_level);
+
+			image_copies.Insert(VkImageCopy {
+				.srcSubresource {
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.mipLevel = mip_level,
+					.baseArrayLayer = 0,
+					.layerCount = 1,
+				},
+				.srcOffset = { 0, 0, 0 },
+				.dstSubresource {
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.mipLevel = mip_level,
+					.baseArrayLayer = layer_index,
+					.layerCount = 1,
+				},
+				.dstOffset = { 0, 0, 0 },
+				.extent =
+					VkExtent3D {
+						.width = mip_dimensions.X,
+						.height = mip_dimensions.Y,
+						.depth = 1,
+					},
+			});
+		}
+
+		VkImageMemoryBarrier src_barrier {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+
+			.srcAccessMask = static_cast<VkAccessFlags>(VK_ACCESS_SHADER_READ_BIT),
+			.dstAccessMask = static_cast<VkAccessFlags>(VK_ACCESS_TRANSFER_READ_BIT),
+
+			.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+
+			.image = layer->InternalImage,
+
+			.subresourceRange =
+				{
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.baseMipLevel = Info.MipLevel,
+					.levelCount = Info.MipCount - Info.MipLevel,
+					.baseArrayLayer = 0,
+					.layerCount = 1,
+				},
+		};
+
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr,
+							 0, nullptr, 1, &src_barrier);
+
+		vkCmdCopyImage(cmd, layer->InternalImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, InternalImage,
+					   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_copies.Size, image_copies.pData);
+
+		// The image may still be sampled by other materials, so it is returned to its previous layout
+		VkImageMemoryBarrier restore_barrier = src_barrier;
+		restore_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		restore_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		restore_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		restore_barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
+							 0, nullptr, 1, &restore_barrier);
+	}
+
+	TransitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cmd, layer_count);
+}
+
+
 void Image::MarkUploaded() { renderer::gRenderer->GetFrameNumber(); }
 
 void Image::TransitionDepthToShaderRO(renderer::CommandBuffer& cmd)
@@ -808,6 +1042,11 @@ void Image::DecRef()
 
 void Image::SaveToFile(const String& path, eImageSaveFormat file_format)
 {
+	if (ImageFormatUtil::IsBlockCompressed(Info.Format)) {
+		LogError("Cannot save block compressed image to file (Path={})", path);
+		return;
+	}
+
 	const uint32 data_size = Info.Size.X * Info.Size.Y * ImageFormatUtil::GetPixelStride(Info.Format);
 
 	SizedArray<uint8> image_data;
@@ -58,6 +58,15 @@ enum class eImageFormat : uint16
 
 	RGB32_Float,
 
+	// Block compressed formats. These are stored as 4x4 blocks of pixels, see `ImageFormatUtil::GetBlockSize()`.
+
+	/// One channel. Sampled as (R, R, R, 1) so that it can stand in for a grayscale RGBA image.
+	BC4_UNorm,
+	/// Two channels (RG).
+	BC5_UNorm,
+	BC7_UNorm,
+	BC7_SRGB,
+
 	/// DO NOT USE FORMAT: Marker for depth formats
 	_eDepthFormatsBegin,
 
@@ -73,6 +82,8 @@ enum class eImageType
 {
 	Flat,
 	Cubemap,
+	/// A stack of flat layers of the same size and format, sampled as a `Texture2DArray`.
+	Array,
 };
 
 struct ImageInfo
@@ -92,6 +103,7 @@ public:
 	eImageFormat Format = eImageFormat::RGBA8_UNorm;
 	uint32 MipLevel = 0;
 	uint32 MipCount = 1;
+	uint32 LayerCount = 1;
 	Slice<const uint8> ImageData { nullptr, 0 };
 };
 
@@ -107,8 +119,59 @@ struct ImageFormatUtil
 		return false;
 	}
 
+	static constexpr bool IsBlockCompressed(eImageFormat format)
+	{
+		switch (format) {
+		case eImageFormat::BC4_UNorm:
+		case eImageFormat::BC5_UNorm:
+		case eImageFormat::BC7_UNorm:
+		case eImageFormat::BC7_SRGB:
+			return true;
+		default:
+			break;
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Get the size of a 4x4 block of a block compressed format in bytes, or zero if the format is not block
+	 * compressed.
+	 */
+	static constexpr uint32 GetBlockSize(eImageFormat format)
+	{
+		switch (format) {
+		case eImageFormat::BC4_UNorm:
+			return 8;
+		case eImageFormat::BC5_UNorm:
+		case eImageFormat::BC7_UNorm:
+		case eImageFormat::BC7_SRGB:
+			return 16;
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
 	/**
-	 * @brief Get the size of the format in bytes. For example, RGBA8 would return 4.
+	 * @brief Get the size of an image (or a single mip level) of `size` pixels in bytes.
+	 */
+	static constexpr uint64 GetDataSize(eImageFormat format, const Vec2u& size)
+	{
+		if (IsBlockCompressed(format)) {
+			const uint64 blocks_x = (size.X + 3) / 4;
+			const uint64 blocks_y = (size.Y + 3) / 4;
+
+			return blocks_x * blocks_y * GetBlockSize(format);
+		}
+
+		return static_cast<uint64>(size.X) * size.Y * GetPixelStride(format);
+	}
+
+	/**
+	 * @brief Get the size of the format in bytes. For example, RGBA8 would return 4. Block compressed formats return
+	 * zero, use `GetDataSize()` for those.
 	 */
 	static constexpr uint32 GetPixelStride(eImageFormat format)
 	{
@@ -132,6 +195,12 @@ struct ImageFormatUtil
 		case eImageFormat::RGB32_Float:
 			return 12;
 
+		case eImageFormat::BC4_UNorm:
+		case eImageFormat::BC5_UNorm:
+		case eImageFormat::BC7_UNorm:
+		case eImageFormat::BC7_SRGB:
+			break;
+
 			// Depth formats
 
 		case eImageFormat::eD16_UNorm_S8_UInt:
@@ -172,6 +241,15 @@ struct ImageFormatUtil
 		case eImageFormat::RGB32_Float:
 			return VK_FORMAT_R32G32B32_SFLOAT;
 
+		case eImageFormat::BC4_UNorm:
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case eImageFormat::BC5_UNorm:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case eImageFormat::BC7_UNorm:
+			return VK_FORMAT_BC7_UNORM_BLOCK;
+		case eImageFormat::BC7_SRGB:
+			return VK_FORMAT_BC7_SRGB_BLOCK;
+
 			// Depth Formats
 
 		case eImageFormat::eD16_UNorm_S8_UInt:
@@ -228,14 +306,30 @@ public:
 
 	FX_FORCE_INLINE const ImageInfo& GetInfo() const { return Info; }
 
+	/**
+	 * @param layer_count The number of layers of an `eImageType::Array` image. Other image types use the layer count of
+	 * the type.
+	 */
 	void Create(eImageType image_type, const Vec2u& size, uint16 mips_count, eImageFormat format, VkImageTiling tiling,
-				VkImageUsageFlags usage, eImageAspectFlag aspect);
+				VkImageUsageFlags usage, eImageAspectFlag aspect, uint32 layer_count = 1);
 
 	void Create(eImageType image_type, const Vec2u& size, uint16 mips_count, eImageFormat format,
 				VkImageUsageFlags usage, eImageAspectFlag aspect);
 
 	void CreateFromData(renderer::CommandBuffer& cmd, const ImageInfo& info, eImageCreateFlags flags);
 
+	/**
+	 * @brief Creates the image and copies its pixels from a staging buffer that already holds them, such as one that
+	 * a loader decoded into. The pixel data in `info` is not used.
+	 */
+	void CreateFromBuffer(renderer::CommandBuffer& cmd, const ImageInfo& info, const renderer::RawGpuBuffer& buffer);
+
+	/**
+	 * @brief Creates an `eImageType::Array` image with one layer for each image in `layers`, and copies the loaded mip
+	 * levels of each image into its layer on the GPU. The images must have the same size, format and mip chain, and be
+	 * uploaded (in `VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL`). They are left unchanged.
+	 */
+	void CreateArrayFromImages(renderer::CommandBuffer& cmd, const Slice<Image*>& layers);
 
 	void UploadMip(renderer::CommandBuffer& cmd, uint32 mip_index, const Vec2u& size,
 				   const Slice<const uint8>& image_data);
@@ -245,6 +339,16 @@ public:
 	 */
 	void Upload(renderer::CommandBuffer& cmd, const ImageInfo& info);
 
+	/**
+	 * @brief Reallocates the image with `mip_count` levels and level 0 of `size`, keeping the contents of the levels
+	 * that both the old and new images have. Levels are matched from the end of the chain, so this adds or drops levels
+	 * at the top of the chain. Added levels are undefined until they are written with `UploadMip()`.
+	 *
+	 * The old image is destroyed once the frames in flight are finished with it, and descriptor sets that use the image
+	 * need to be rebuilt.
+	 */
+	void ResizeMipChain(renderer::CommandBuffer& cmd, const Vec2u& size, uint32 mip_count);
+
 	void TransitionLayout(VkImageLayout new_layout, renderer::CommandBuffer& cmd, uint32 layer_count,
 						  std::optional<TransitionLayoutOverrides> overrides = std::nullopt);
 
@@ -299,8 +299,49 @@ void Pipeline::Create(ePipelineName name, const Slice<Ref<ShaderProgram>>& shade
 			reinterpret_cast<void*>(Layout.Get()));
 }
 
+void Pipeline::CreateCompute(ePipelineName name, const Ref<ShaderProgram>& compute_shader)
+{
+	mDevice = gRenderer->GetDevice();
+
+	Name = name;
+	ComputeShader = compute_shader;
+	BindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+
+	bHasDynamicViewport = false;
+
+	const VkComputePipelineCreateInfo pipeline_info = {
+		.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+		.stage = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+			.module = compute_shader->Get(),
+			.pName = "main",
+		},
+		.layout = Layout.Get(),
+	};
+
+	const VkResult status = vkCreateComputePipelines(mDevice->Device, nullptr, 1, &pipeline_info, nullptr,
+													 &InternalPipeline);
+
+	if (status != VK_SUCCESS) {
+		ModulePanicVulkan("Could not create compute pipeline", status);
+	}
+
+	Util::SetDebugLabel(PipelineNameUtil::GetName(name), VK_OBJECT_TYPE_PIPELINE, InternalPipeline);
+
+	LogInfo(LC_RENDER, "Creating compute pipeline for shader '{}' -> LayoutHandle={:p}",
+			compute_shader->pShader->GetName(), reinterpret_cast<void*>(Layout.Get()));
+}
+
 void Pipeline::Bind(const CommandBuffer& cmd) const
 {
+	// Compute pipelines have their own bind point, so they do not replace the bound graphics pipeline or its dynamic
+	// states.
+	if (IsCompute()) {
+		vkCmdBindPipeline(cmd.Get(), VK_PIPELINE_BIND_POINT_COMPUTE, InternalPipeline);
+		return;
+	}
+
 	if (InternalPipeline == spBoundPipeline) {
 		return;
 	}
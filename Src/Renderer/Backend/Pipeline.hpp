@@ -174,6 +174,13 @@ public:
 				const Slice<VkPipelineColorBlendAttachmentState>& color_blend_attachments,
 				VertexDescription* vertex_info, const RenderPass& render_pass, const PipelineProperties& properties);
 
+	/**
+	 * @brief Creates a compute pipeline from `compute_shader`. The layout must be set beforehand.
+	 */
+	void CreateCompute(ePipelineName name, const Ref<ShaderProgram>& compute_shader);
+
+	FX_FORCE_INLINE bool IsCompute() const { return BindPoint == VK_PIPELINE_BIND_POINT_COMPUTE; }
+
 
 	FX_FORCE_INLINE void SetLayout(PipelineLayout layout)
 	{
@@ -206,6 +213,9 @@ public:
 
 	Ref<ShaderProgram> VertexShader { nullptr };
 	Ref<ShaderProgram> PixelShader { nullptr };
+	Ref<ShaderProgram> ComputeShader { nullptr };
+
+	VkPipelineBindPoint BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
 	bool bIsViewportFullscreen = false;
 
@@ -120,6 +120,86 @@ VertexDescription BuildDescription()
             },
         };
     }
+    else if constexpr (TVertexType == eVertexType::Compact) {
+        using VertexType = Vertex<eVertexType::Compact>;
+        attribs = {
+            // Position
+            {
+                .location = 0,
+                .binding = 0,
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = 0,
+            },
+            // Normal (octahedral)
+            {
+                .location = 1,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = offsetof(VertexType, Normal),
+            },
+            // UV
+            {
+                .location = 2,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SFLOAT,
+                .offset = offsetof(VertexType, UV),
+            },
+            // Tangent (octahedral)
+            {
+                .location = 3,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = offsetof(VertexType, Tangent),
+            },
+        };
+    }
+    else if constexpr (TVertexType == eVertexType::CompactSkinned) {
+        using VertexType = Vertex<eVertexType::CompactSkinned>;
+        attribs = {
+            // Position
+            {
+                .location = 0,
+                .binding = 0,
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = 0,
+            },
+            // Normal (octahedral)
+            {
+                .location = 1,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = offsetof(VertexType, Normal),
+            },
+            // UV
+            {
+                .location = 2,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SFLOAT,
+                .offset = offsetof(VertexType, UV),
+            },
+            // Tangent (octahedral)
+            {
+                .location = 3,
+                .binding = 0,
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = offsetof(VertexType, Tangent),
+            },
+            // Bone IDs
+            {
+                .location = 4,
+                .binding = 0,
+                .format = VK_FORMAT_R8G8B8A8_UINT,
+                .offset = offsetof(VertexType, BoneIds),
+            },
+            // Bone Weights
+            {
+                .location = 5,
+                .binding = 0,
+                .format = VK_FORMAT_R8G8B8A8_UNORM,
+                .offset = offsetof(VertexType, BoneWeights),
+            },
+        };
+    }
     else {
         LogError(LC_RENDER, "Unsupported vertex type!");
     }
@@ -136,6 +216,10 @@ FX_FORCE_INLINE VertexDescription BuildDescription(eVertexType vertex_type)
         return VertexUtil::BuildDescription<eVertexType::Default>();
     case eVertexType::Skinned:
         return VertexUtil::BuildDescription<eVertexType::Skinned>();
+    case eVertexType::Compact:
+        return VertexUtil::BuildDescription<eVertexType::Compact>();
+    case eVertexType::CompactSkinned:
+        return VertexUtil::BuildDescription<eVertexType::CompactSkinned>();
     default:;
     }
 
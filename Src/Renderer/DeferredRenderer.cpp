@@ -239,6 +239,153 @@ void DeferredRenderer::CreateGPassPipeline()
 		gPSOBuild->EndPipeline();
 	}
 
+	{
+		// Compact vertex pipeline, see `eVertexCreateFlags::Compact`
+		gPSOBuild->BeginPipeline(ePipelineName::GeometryCompact);
+		gPSOBuild->SetPushConstants(eShaderType::Vertex, sizeof(DrawPushConstants));
+
+		gPSOBuild->UseRenderStage(ForwardPass);
+		gPSOBuild->SetShader(eShaderName::Forward, { ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" } });
+		gPSOBuild->SetVertexType(eVertexType::Compact);
+		gPSOBuild->SetCullMode(eCullMode::Back);
+
+		gPSOBuild->AddImage(0, 0, eShaderType::Pixel, gAssetManager->GetNullImage(eImageFormat::RGBA8_UNorm),
+							gSamplerCache->Request({}));
+
+		gPSOBuild->AddBuffer(4, 0, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
+							 gRenderer->LightBuffer.PageSize);
+		// bObjectBuffer
+		gPSOBuild->AddBuffer(0, 1, eShaderType::Vertex, &gObjectManager->mObjectGpuBuffer, 0,
+							 gObjectManager->GetPageSize());
+		// bMaterialBuffer
+		gPSOBuild->AddBuffer(1, 1, eShaderType::Pixel, &gMaterialManager->MaterialPropertiesBuffer, 0,
+							 gMaterialManager->MaterialPropertiesBuffer.Size);
+
+		gPSOBuild->EndPipeline();
+	}
+
+	{
+		// Compact vertex + Normal mapped pipeline
+		gPSOBuild->BeginPipeline(ePipelineName::GeometryCompactNormalMaps);
+		gPSOBuild->SetPushConstants(eShaderType::Vertex, sizeof(DrawPushConstants));
+
+		gPSOBuild->UseRenderStage(ForwardPass);
+		gPSOBuild->SetShader(eShaderName::Forward, { ShaderMacro { .pcName = "USE_NORMAL_MAPS", .pcValue = "1" },
+													 ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" } });
+		gPSOBuild->SetVertexType(eVertexType::Compact);
+		gPSOBuild->SetCullMode(eCullMode::Back);
+
+		gPSOBuild->AddImage(0, 0, eShaderType::Pixel, gAssetManager->GetNullImage(eImageFormat::RGBA8_UNorm),
+							gSamplerCache->Request({}));
+		gPSOBuild->AddImage(1, 0, eShaderType::Pixel, gAssetManager->GetNullImage(eImageFormat::RGBA8_UNorm),
+							gSamplerCache->Request({}));
+		gPSOBuild->AddImage(2, 0, eShaderType::Pixel, gAssetManager->GetNullImage(eImageFormat::RGBA8_UNorm),
+							gSamplerCache->Request({}));
+
+		gPSOBuild->AddBuffer(4, 0, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
+							 gRenderer->LightBuffer.PageSize);
+
+		// bObjectBuffer
+		gPSOBuild->AddBuffer(0, 1, eShaderType::Vertex, &gObjectManager->mObjectGpuBuffer, 0,
+							 gObjectManager->GetPageSize());
+		// bMaterialBuffer
+		gPSOBuild->AddBuffer(1, 1, eShaderType::Pixel, &gMaterialManager->MaterialPropertiesBuffer, 0,
+							 gMaterialManager->MaterialPropertiesBuffer.Size);
+
+		gPSOBuild->EndPipeline();
+	}
+
+	// Packed material pipelines, which sample texture arrays that are shared between materials (see `TexturePacker`)
+	for (const ePipelineName pipeline_name : { ePipelineName::GeometryPacked, ePipelineName::GeometryPackedNormalMaps,
+											   ePipelineName::GeometryCompactPacked,
+											   ePipelineName::GeometryCompactPackedNormalMaps }) {
+		const bool use_normal_maps = !HasFlag(GetPipelineNameInfo(pipeline_name).Flags, ePipelineNameFlags::AlbedoOnly);
+		const bool use_compact_vertices = (PipelineNameUtil::GetCompactVariant(pipeline_name) == pipeline_name);
+
+		SizedArray<ShaderMacro> macros(3);
+		macros.Insert(ShaderMacro { .pcName = "USE_TEXTURE_ARRAYS", .pcValue = "1" });
+
+		if (use_normal_maps) {
+			macros.Insert(ShaderMacro { .pcName = "USE_NORMAL_MAPS", .pcValue = "1" });
+		}
+		if (use_compact_vertices) {
+			macros.Insert(ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" });
+		}
+
+		gPSOBuild->BeginPipeline(pipeline_name);
+		gPSOBuild->SetPushConstants(eShaderType::Vertex, sizeof(DrawPushConstants));
+
+		gPSOBuild->UseRenderStage(ForwardPass);
+		gPSOBuild->SetShader(eShaderName::Forward, macros);
+		gPSOBuild->SetVertexType(use_compact_vertices ? eVertexType::Compact : eVertexType::Default);
+		gPSOBuild->SetCullMode(eCullMode::Back);
+
+		const uint32 image_count = use_normal_maps ? 3 : 1;
+
+		for (uint32 binding = 0; binding < image_count; binding++) {
+			gPSOBuild->AddImage(binding, 0, eShaderType::Pixel, gAssetManager->GetNullImage(eImageFormat::RGBA8_UNorm),
+								gSamplerCache->Request({}));
+		}
+
+		gPSOBuild->AddBuffer(4, 0, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
+							 gRenderer->LightBuffer.PageSize);
+
+		// bObjectBuffer
+		gPSOBuild->AddBuffer(0, 1, eShaderType::Vertex, &gObjectManager->mObjectGpuBuffer, 0,
+							 gObjectManager->GetPageSize());
+		// bMaterialBuffer
+		gPSOBuild->AddBuffer(1, 1, eShaderType::Pixel, &gMaterialManager->MaterialPropertiesBuffer, 0,
+							 gMaterialManager->MaterialPropertiesBuffer.Size);
+
+		gPSOBuild->EndPipeline();
+	}
+
+	// Bindless material pipelines, which read textures from the texture table that is bound once per pipeline (see
+	// `BindlessTextureTable`). These are only used when the device supports bindless textures.
+	if (gMaterialManager->UsesTextureTable()) {
+		for (const ePipelineName pipeline_name :
+			 { ePipelineName::GeometryBindless, ePipelineName::GeometryBindlessNormalMaps,
+			   ePipelineName::GeometryCompactBindless, ePipelineName::GeometryCompactBindlessNormalMaps }) {
+			const bool use_normal_maps = !HasFlag(GetPipelineNameInfo(pipeline_name).Flags,
+												  ePipelineNameFlags::AlbedoOnly);
+			const bool use_compact_vertices = (PipelineNameUtil::GetCompactVariant(pipeline_name) == pipeline_name);
+
+			SizedArray<ShaderMacro> macros(3);
+			macros.Insert(ShaderMacro { .pcName = "USE_BINDLESS", .pcValue = "1" });
+
+			if (use_normal_maps) {
+				macros.Insert(ShaderMacro { .pcName = "USE_NORMAL_MAPS", .pcValue = "1" });
+			}
+			if (use_compact_vertices) {
+				macros.Insert(ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" });
+			}
+
+			gPSOBuild->BeginPipeline(pipeline_name);
+			gPSOBuild->SetPushConstants(eShaderType::Vertex, sizeof(DrawPushConstants));
+
+			gPSOBuild->UseRenderStage(ForwardPass);
+			gPSOBuild->SetShader(eShaderName::Forward, macros);
+			gPSOBuild->SetVertexType(use_compact_vertices ? eVertexType::Compact : eVertexType::Default);
+			gPSOBuild->SetCullMode(eCullMode::Back);
+
+			gPSOBuild->AddBuffer(4, 0, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
+								 gRenderer->LightBuffer.PageSize);
+
+			// bObjectBuffer
+			gPSOBuild->AddBuffer(0, 1, eShaderType::Vertex, &gObjectManager->mObjectGpuBuffer, 0,
+								 gObjectManager->GetPageSize());
+			// bMaterialBuffer
+			gPSOBuild->AddBuffer(1, 1, eShaderType::Pixel, &gMaterialManager->MaterialPropertiesBuffer, 0,
+								 gMaterialManager->MaterialPropertiesBuffer.Size);
+
+			// tTextures
+			gPSOBuild->AddExistingDS(MaterialManager::scTextureTableSetIndex,
+									 gMaterialManager->GetTextureTable().GetLayoutID());
+
+			gPSOBuild->EndPipeline();
+		}
+	}
+
 	{
 		// Skinned + Normal mapped pipeline
 		gPSOBuild->BeginPipeline(ePipelineName::GeometrySkinned);
@@ -259,7 +406,7 @@ void DeferredRenderer::CreateGPassPipeline()
 
 		// bBoneBuffer
 		gPSOBuild->AddBuffer(3, 0, eShaderType::Vertex, &gRenderer->BoneBuffer.GetGpuBuffer(), 0,
-							 gRenderer->BoneBuffer.PageSize);
+							 gRenderer->BoneBuffer.GetSlotSize());
 
 		// Light buffer
 		gPSOBuild->AddBuffer(4, 0, eShaderType::Pixel, &gRenderer->LightBuffer.GetGpuBuffer(), 0,
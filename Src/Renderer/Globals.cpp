@@ -7,11 +7,13 @@
 #include "RenderBackend.hpp"
 #include "ShaderCache.hpp"
 #include "ShadowDirectional.hpp"
+#include "SkinningPass.hpp"
 
 namespace fx::renderer {
 
 RenderBackend* gRenderer = nullptr;
 ShadowDirectional* gShadowRenderer = nullptr;
+SkinningPass* gSkinningPass = nullptr;
 ShaderCache* gShaderCache = nullptr;
 DsLayoutCache* gDsLayoutCache = nullptr;
 PipelineCache* gPipelineCache = nullptr;
@@ -44,6 +46,10 @@ void Destroy()
 		DESTROY_GLOBAL(gShadowRenderer);
 	}
 
+	if (gSkinningPass) {
+		DESTROY_GLOBAL(gSkinningPass);
+	}
+
 	DESTROY_GLOBAL(gSamplerCache);
 
 	DESTROY_GLOBAL(gDescriptorCache);
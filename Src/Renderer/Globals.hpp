@@ -8,6 +8,9 @@ extern RenderBackend* gRenderer;
 class ShadowDirectional;
 extern ShadowDirectional* gShadowRenderer;
 
+class SkinningPass;
+extern SkinningPass* gSkinningPass;
+
 class ShaderCache;
 extern ShaderCache* gShaderCache;
 
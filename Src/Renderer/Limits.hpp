@@ -5,6 +5,10 @@
 namespace fx::Limits {
 static constexpr uint32 MaxActiveLights = 64;
 static constexpr uint32 MaxBones = 100;
+/// Number of skinning palettes in the bone buffer, not counting the bind pose palette (see `AnimationManager`).
+static constexpr uint32 MaxAnimationInstances = 63;
+/// Number of vertices that can be skinned by the skinning compute pass each frame (see `SkinningPass`).
+static constexpr uint32 MaxSkinnedVertices = 65536;
 static constexpr uint32 MaxDeletionQueueItems = 128;
 
 } // namespace fx::Limits
@@ -2,9 +2,9 @@
 
 #include <Core/AnonArray.hpp>
 #include <Math/BoundingBox.hpp>
+#include <Math/MathBatch.hpp>
 #include <Math/Vec3.hpp>
 #include <Renderer/VertexList.hpp>
-#include <cfloat>
 
 namespace fx {
 
@@ -20,19 +20,8 @@ public:
 			return Vec3f::sZero;
 		}
 
-		Vec3f min_vertex = Vec3f(FLT_MAX);
-		Vec3f max_vertex = Vec3f(-FLT_MAX);
-
-		for (uint32 i = 0; i < vertices.Size; i++) {
-			// Since the position resides at the same location for each vertex type (see static_assert in
-			// VertexUtil::GetPosition), the vertex type used here can be anything, and offsets are preserved as the
-			// size of the object is stored in the anonymous buffer.
-			Vec3f position = renderer::VertexUtil::GetPosition(
-				*static_cast<const renderer::Vertex<renderer::eVertexType::Default>*>(vertices.GetRaw(i)));
-
-			min_vertex = Vec3f::Min(min_vertex, position);
-			max_vertex = Vec3f::Max(max_vertex, position);
-		}
+		Vec3f min_vertex, max_vertex;
+		GetPositionBounds(vertices, &min_vertex, &max_vertex);
 
 		// Return the difference between the min and max positions
 		max_vertex -= min_vertex;
@@ -49,21 +38,22 @@ public:
 			return BoundingBox {};
 		}
 
-		Vec3f min_vertex = Vec3f(FLT_MAX);
-		Vec3f max_vertex = Vec3f(-FLT_MAX);
+		Vec3f min_vertex, max_vertex;
+		GetPositionBounds(vertices, &min_vertex, &max_vertex);
 
-		for (uint32 i = 0; i < vertices.Size; i++) {
-			// Since the position resides at the same location for each vertex type (see static_assert in
-			// VertexUtil::GetPosition), the vertex type used here can be anything, and offsets are preserved as the
-			// size of the object is stored in the anonymous buffer.
-			Vec3f position = renderer::VertexUtil::GetPosition(
-				*static_cast<const renderer::Vertex<renderer::eVertexType::Default>*>(vertices.GetRaw(i)));
+		return BoundingBox { min_vertex, max_vertex };
+	}
 
-			min_vertex = Vec3f::Min(min_vertex, position);
-			max_vertex = Vec3f::Max(max_vertex, position);
-		}
+private:
+	static void GetPositionBounds(const AnonArray& vertices, Vec3f* out_min, Vec3f* out_max)
+	{
+		// Since the position resides at the same location for each vertex type (see static_assert in
+		// VertexUtil::GetPosition), the vertex type used here can be anything, and offsets are preserved as the
+		// size of the object is stored in the anonymous buffer.
+		constexpr uint32 cPositionOffset = offsetof(renderer::Vertex<renderer::eVertexType::Default>, Position);
 
-		return BoundingBox { min_vertex, max_vertex };
+		const uint8* positions = static_cast<const uint8*>(vertices.GetRaw(0)) + cPositionOffset;
+		MathBatch::CalculateBounds(positions, vertices.ObjectSize, vertices.Size, out_min, out_max);
 	}
 };
 
@@ -34,6 +34,10 @@ void PSOBuild::BeginPipeline(const ePipelineName name)
 		for (SizedArray<DescriptorEntry>& entry_list : mDescriptorEntries) {
 			entry_list.InitCapacity(scMaxNumDescriptorBindings);
 		}
+
+		if (!mExistingDescriptors.IsInited()) {
+			mExistingDescriptors.InitCapacity(scMaxNumDescriptorSets);
+		}
 	}
 }
 
@@ -73,6 +77,17 @@ bool PSOBuild::HasDescriptorsToBuild() const
 	return false;
 }
 
+const PSOBuild::ExistingDS* PSOBuild::FindExistingDS(uint32 set_index) const
+{
+	for (const ExistingDS& existing_ds : mExistingDescriptors) {
+		if (existing_ds.SetIndex == set_index) {
+			return &existing_ds;
+		}
+	}
+
+	return nullptr;
+}
+
 
 void PSOBuild::BuildPipeline()
 {
@@ -90,7 +105,13 @@ void PSOBuild::BuildPipeline()
 
 	Ref<ShaderProgram> vertex_shader = GetShaderProgram(eShaderType::Vertex);
 	Ref<ShaderProgram> pixel_shader = GetShaderProgram(eShaderType::Pixel);
+	Ref<ShaderProgram> compute_shader = GetShaderProgram(eShaderType::Compute);
 
+	// Shaders that only contain a compute program build a compute pipeline, which has no render pass or vertices.
+	if (compute_shader.IsValid() && !vertex_shader.IsValid()) {
+		mpPipeline->CreateCompute(mPipelineName, compute_shader);
+		return;
+	}
 
 	if (!vertex_shader.IsValid() || !pixel_shader.IsValid()) {
 		LogError(LC_RENDER, "Invalid shaders provided");
@@ -159,6 +180,15 @@ std::vector<VkDescriptorSetLayout> PSOBuild::BuildDescriptorSets()
 	for (uint32 i = 0; i < mDescriptorEntries.Size; i++) {
 		SizedArray<DescriptorEntry>& desc_list = mDescriptorEntries[i];
 
+		// Sets that are created outside of the pipeline only add their layout
+		if (const ExistingDS* existing_ds = FindExistingDS(i)) {
+			VkDescriptorSetLayout* ds_layout = gDsLayoutCache->RequestExisting(existing_ds->LayoutID);
+			AssertMsg(ds_layout != nullptr, "Could not find existing descriptor layout when building pipeline");
+
+			layouts.emplace_back(*ds_layout);
+			continue;
+		}
+
 		LogInfo("Descriptor '{}' Size is {}", i, desc_list.Size);
 
 		// If there are no entries added, skip creating the DS
@@ -239,6 +269,15 @@ void PSOBuild::ReuseDS(ePipelineName other_pso)
 	mpPipeline->DescriptorIDs.CloneFrom(gPipelineCache->Request(other_pso).DescriptorIDs);
 }
 
+void PSOBuild::AddExistingDS(uint32 set_index, DsLayoutID layout_id)
+{
+	AssertMsg(HasFlag(mFlags, ePSOBuildFlags::ReuseDescriptors) == false,
+			  "Cannot build descriptors when already inheriting them from another pipeline");
+	AssertMsg(mDescriptorEntries[set_index].IsEmpty(), "Descriptor set already has entries");
+
+	mExistingDescriptors.Insert(ExistingDS { .SetIndex = set_index, .LayoutID = layout_id });
+}
+
 void PSOBuild::AddBuffer(uint32 bind_index, uint32 set_index, eShaderType shader_stages, RawGpuBuffer* buffer,
 						 uint64 offset, uint64 range)
 {
@@ -288,6 +327,11 @@ bool PSOBuild::CheckDescriptorsAgainstProgram(const Ref<ShaderProgram>& program)
 	int32 num_errors = 0;
 
 	for (const ShaderReflectionEntry& refl_entry : program->Reflection) {
+		// Existing sets are not built from entries, so there is nothing to check them against
+		if (FindExistingDS(refl_entry.Set) != nullptr) {
+			continue;
+		}
+
 		eDescriptorEntryType det = SRTToDET(refl_entry.Type);
 
 		bool is_valid = false;
@@ -359,6 +403,8 @@ void PSOBuild::Reset()
 	for (SizedArray<DescriptorEntry>& entry_list : mDescriptorEntries) {
 		entry_list.Clear();
 	}
+
+	mExistingDescriptors.Clear();
 }
 
 } // namespace fx::renderer
@@ -61,7 +61,12 @@ public:
 	void SetShader(eShaderName shader, const SizedArray<ShaderMacro>& macros);
 
 	void ReuseDS(ePipelineName other_pso);
-	void AddExistingDS(uint32 set_index, Hash32 layout_id);
+
+	/**
+	 * @brief Adds the layout of a descriptor set that is created and bound outside of the pipeline (such as the
+	 * `BindlessTextureTable`) at `set_index`. The layout must be in the layout cache.
+	 */
+	void AddExistingDS(uint32 set_index, DsLayoutID layout_id);
 
 	void AddBuffer(uint32 bind_index, uint32 set_index, eShaderType shader_stages, RawGpuBuffer* buffer, uint64 offset,
 				   uint64 range);
@@ -100,6 +105,13 @@ public:
 		mShaderPrograms[static_cast<uint32>(shader_type) - 1] = program;
 	}
 
+private:
+	struct ExistingDS
+	{
+		uint32 SetIndex = 0;
+		DsLayoutID LayoutID { HashNull32 };
+	};
+
 private:
 	void BuildPipeline();
 	void Reset();
@@ -107,6 +119,8 @@ private:
 	std::vector<VkDescriptorSetLayout> BuildDescriptorSets();
 	bool HasDescriptorsToBuild() const;
 
+	const ExistingDS* FindExistingDS(uint32 set_index) const;
+
 	bool CheckDescriptorsAgainstProgram(const Ref<ShaderProgram>& program) const;
 	void CheckDescriptorsAgainstShader() const;
 
@@ -129,6 +143,9 @@ private:
 	/// Contains the list of descriptor entries indexed based on the descriptor set's index.
 	SizedArray<SizedArray<DescriptorEntry>> mDescriptorEntries;
 
+	/// Descriptor sets added with `AddExistingDS()`, which are not built from descriptor entries.
+	SizedArray<ExistingDS> mExistingDescriptors;
+
 	PipelineProperties mProperties;
 
 	ePSOBuildFlags mFlags = ePSOBuildFlags::None;
@@ -16,6 +16,16 @@ static const PipelineNameInfo scNameInfos[] = {
 	NAME_INFO("Geometry", eFlags::AlbedoOnly),
 	NAME_INFO("GeometryNormalMaps", eFlags::None),
 	NAME_INFO("GeometrySkinned", eFlags::None),
+	NAME_INFO("GeometryCompact", eFlags::AlbedoOnly),
+	NAME_INFO("GeometryCompactNormalMaps", eFlags::None),
+	NAME_INFO("GeometryPacked", eFlags::AlbedoOnly),
+	NAME_INFO("GeometryPackedNormalMaps", eFlags::None),
+	NAME_INFO("GeometryCompactPacked", eFlags::AlbedoOnly),
+	NAME_INFO("GeometryCompactPackedNormalMaps", eFlags::None),
+	NAME_INFO("GeometryBindless", eFlags::AlbedoOnly | eFlags::Bindless),
+	NAME_INFO("GeometryBindlessNormalMaps", eFlags::Bindless),
+	NAME_INFO("GeometryCompactBindless", eFlags::AlbedoOnly | eFlags::Bindless),
+	NAME_INFO("GeometryCompactBindlessNormalMaps", eFlags::Bindless),
 
 	/* Unlit pipelines */
 	NAME_INFO("Unlit", eFlags::AlbedoOnly),
@@ -31,6 +41,11 @@ static const PipelineNameInfo scNameInfos[] = {
 	NAME_INFO("TextRendering", eFlags::None),
 	NAME_INFO("Composition", eFlags::None),
 	NAME_INFO("ShadowDirectional", eFlags::None),
+	NAME_INFO("ShadowDirectionalCompact", eFlags::None),
+
+	/* Compute */
+	NAME_INFO("Skinning", eFlags::None),
+	NAME_INFO("SkinningCompact", eFlags::None),
 };
 
 const PipelineNameInfo& GetPipelineNameInfo(const ePipelineName name)
@@ -8,6 +8,9 @@ enum class ePipelineNameFlags
 {
 	None = 0,
 	AlbedoOnly = (1 << 0),
+
+	/// Textures are read from the bindless texture table, see `BindlessTextureTable`.
+	Bindless = (1 << 1),
 };
 
 FxEnumFlags(ePipelineNameFlags);
@@ -22,6 +25,31 @@ enum class ePipelineName : uint16
 	GeometryNormalMaps,
 	GeometrySkinned,
 
+	/**
+	 * @brief Same as `Geometry` and `GeometryNormalMaps`, for meshes with compact vertices (see
+	 * `eVertexCreateFlags::Compact`).
+	 */
+	GeometryCompact,
+	GeometryCompactNormalMaps,
+
+	/**
+	 * @brief Same as the pipelines above, for materials whose textures are packed into texture arrays (see
+	 * `TexturePacker`).
+	 */
+	GeometryPacked,
+	GeometryPackedNormalMaps,
+	GeometryCompactPacked,
+	GeometryCompactPackedNormalMaps,
+
+	/**
+	 * @brief Same as the unpacked pipelines above, for materials whose textures are in the bindless texture table (see
+	 * `BindlessTextureTable`). Materials are not bound per draw.
+	 */
+	GeometryBindless,
+	GeometryBindlessNormalMaps,
+	GeometryCompactBindless,
+	GeometryCompactBindlessNormalMaps,
+
 	/**
 	 * @brief Renders objects without lighting
 	 */
@@ -41,6 +69,16 @@ enum class ePipelineName : uint16
 	Composition,
 
 	ShadowDirectional,
+	ShadowDirectionalCompact,
+
+	/**
+	 * @brief Compute pipeline that skins the vertices of skinned meshes once per frame (see `SkinningPass`).
+	 */
+	Skinning,
+	/**
+	 * @brief Same as `Skinning`, for meshes with `CompactSkinned` vertices. Outputs `Compact` vertices.
+	 */
+	SkinningCompact,
 
 	NumPipelines
 };
@@ -61,6 +99,75 @@ namespace PipelineNameUtil {
 
 FX_FORCE_INLINE const char* GetName(const ePipelineName id) { return GetPipelineNameInfo(id).pcName; }
 
+/**
+ * @brief Returns the pipeline that draws the same as `id` with compact vertices, or `id` if there is none.
+ */
+constexpr ePipelineName GetCompactVariant(const ePipelineName id)
+{
+	switch (id) {
+	case ePipelineName::Geometry:
+		return ePipelineName::GeometryCompact;
+	case ePipelineName::GeometryNormalMaps:
+		return ePipelineName::GeometryCompactNormalMaps;
+	case ePipelineName::GeometryPacked:
+		return ePipelineName::GeometryCompactPacked;
+	case ePipelineName::GeometryPackedNormalMaps:
+		return ePipelineName::GeometryCompactPackedNormalMaps;
+	case ePipelineName::GeometryBindless:
+		return ePipelineName::GeometryCompactBindless;
+	case ePipelineName::GeometryBindlessNormalMaps:
+		return ePipelineName::GeometryCompactBindlessNormalMaps;
+	case ePipelineName::ShadowDirectional:
+		return ePipelineName::ShadowDirectionalCompact;
+	case ePipelineName::Skinning:
+		return ePipelineName::SkinningCompact;
+	default:;
+	}
+
+	return id;
+}
+
+/**
+ * @brief Returns the pipeline that draws the same as `id` with textures packed into texture arrays, or `id` if there is
+ * none.
+ */
+constexpr ePipelineName GetPackedVariant(const ePipelineName id)
+{
+	switch (id) {
+	case ePipelineName::Geometry:
+		return ePipelineName::GeometryPacked;
+	case ePipelineName::GeometryNormalMaps:
+		return ePipelineName::GeometryPackedNormalMaps;
+	case ePipelineName::GeometryCompact:
+		return ePipelineName::GeometryCompactPacked;
+	case ePipelineName::GeometryCompactNormalMaps:
+		return ePipelineName::GeometryCompactPackedNormalMaps;
+	default:;
+	}
+
+	return id;
+}
+
+/**
+ * @brief Returns the pipeline that draws the same as `id` with textures from the bindless texture table, or `id` if
+ * there is none.
+ */
+constexpr ePipelineName GetBindlessVariant(const ePipelineName id)
+{
+	switch (id) {
+	case ePipelineName::Geometry:
+		return ePipelineName::GeometryBindless;
+	case ePipelineName::GeometryNormalMaps:
+		return ePipelineName::GeometryBindlessNormalMaps;
+	case ePipelineName::GeometryCompact:
+		return ePipelineName::GeometryCompactBindless;
+	case ePipelineName::GeometryCompactNormalMaps:
+		return ePipelineName::GeometryCompactBindlessNormalMaps;
+	default:;
+	}
+
+	return id;
+}
 
 } // namespace PipelineNameUtil
 
@@ -3,6 +3,7 @@
 #include "Backend/GpuBuffer.hpp"
 #include "VertexList.hpp"
 
+#include <Math/MathUtil.hpp>
 #include <Math/Quat.hpp>
 
 namespace fx {
@@ -35,11 +36,7 @@ public:
      */
     inline void UploadVertices(renderer::CommandBuffer& cmd)
     {
-        if (VertexList.SupportsNormals() && !VertexList.HasNormals()) {
-            LogDebug("Calculating normals for mesh");
-            RecalculateNormals();
-        }
-
+        CalculateMissingNormals();
         VertexList.UploadToGpu(cmd);
     }
 
@@ -65,16 +62,146 @@ public:
     void UploadIndices(renderer::CommandBuffer& cmd, const SizedArray<uint32>& indices)
     {
         LocalIndexBuffer.InitAsCopyOf(indices);
-        GpuIndexBuffer.Create(cmd, renderer::eGpuBufferType::IndexBuffer, Slice(indices));
+        CreateGpuIndexBuffer(cmd, indices);
     }
 
     /**
      * @brief Uploads mesh indices to a primtive mesh, and stores the indices without copy if the property
      * `KeepInMemory` is true.
      */
-    void UploadIndices(renderer::CommandBuffer& cmd)
+    void UploadIndices(renderer::CommandBuffer& cmd) { CreateGpuIndexBuffer(cmd, LocalIndexBuffer); }
+
+    /**
+     * @brief Creates the GPU index buffer from `indices`. The GPU copy uses 16 bit indices when every index fits, which
+     * halves the index buffer size and fetch bandwidth. `LocalIndexBuffer` always keeps 32 bit indices.
+     */
+    void CreateGpuIndexBuffer(renderer::CommandBuffer& cmd, const SizedArray<uint32>& indices)
     {
-        GpuIndexBuffer.Create<uint32>(cmd, renderer::eGpuBufferType::IndexBuffer, LocalIndexBuffer);
+        IndexCount = static_cast<uint32>(indices.Size);
+        IndexType = GetGpuIndexType(indices);
+
+        if (IndexType == VK_INDEX_TYPE_UINT32) {
+            GpuIndexBuffer.Create(cmd, renderer::eGpuBufferType::IndexBuffer, Slice(indices));
+            return;
+        }
+
+        SizedArray<uint16> indices16;
+        indices16.InitSize(indices.Size);
+
+        WriteGpuIndices(indices16.pData, indices, IndexType);
+
+        GpuIndexBuffer.Create(cmd, renderer::eGpuBufferType::IndexBuffer, Slice(indices16));
+    }
+
+    /**
+     * @brief Recalculates normals if needed and picks the GPU index type, so that the mesh can be written to a shared
+     * staging buffer with `WriteToStaging()`.
+     *
+     * @returns The number of bytes that `WriteToStaging()` writes.
+     */
+    uint64 PrepareStaging()
+    {
+        CalculateMissingNormals();
+
+        IndexCount = static_cast<uint32>(LocalIndexBuffer.Size);
+        IndexType = GetGpuIndexType(LocalIndexBuffer);
+
+        return GetStagedSize(VertexList.GetSizeInBytes(), IndexCount, IndexType);
+    }
+
+    /**
+     * @brief Writes the vertices, followed by the indices in the GPU index type, to `dst`. `PrepareStaging()` must be
+     * called first.
+     */
+    void WriteToStaging(uint8* dst) const
+    {
+        const AnonArray& vertices = VertexList.GetLocalBuffer();
+        memcpy(dst, vertices.pData, VertexList.GetSizeInBytes());
+
+        WriteGpuIndices(dst + GetStagedIndexOffset(VertexList.GetSizeInBytes()), LocalIndexBuffer, IndexType);
+    }
+
+    /**
+     * @brief Copies `vertex_count` vertices and the indices from a mesh in the layout of `WriteToStaging()` into the
+     * local buffers. `VertexList.VertexType`, `IndexType` and `IndexCount` must be set.
+     */
+    void ReadFromStaging(const uint8* src, uint32 vertex_count)
+    {
+        AnonArray& vertices = VertexList.GetLocalBuffer();
+        vertices.Free();
+        vertices.Create(renderer::VertexUtil::GetSize(VertexList.VertexType), vertex_count);
+        vertices.Size = vertex_count;
+
+        memcpy(vertices.pData, src, VertexList.GetSizeInBytes());
+
+        if (IndexCount == 0) {
+            return;
+        }
+
+        const uint8* src_indices = src + GetStagedIndexOffset(VertexList.GetSizeInBytes());
+
+        LocalIndexBuffer.InitSize(IndexCount);
+
+        if (IndexType == VK_INDEX_TYPE_UINT32) {
+            memcpy(LocalIndexBuffer.pData, src_indices, LocalIndexBuffer.GetSizeInBytes());
+            return;
+        }
+
+        const uint16* src_indices16 = reinterpret_cast<const uint16*>(src_indices);
+
+        for (uint32 i = 0; i < IndexCount; i++) {
+            LocalIndexBuffer[i] = src_indices16[i];
+        }
+    }
+
+    /**
+     * @brief Creates the GPU buffers from the mesh that `WriteToStaging()` wrote at `offset` in `staging_buffer`.
+     */
+    void UploadFromBuffer(renderer::CommandBuffer& cmd, const renderer::RawGpuBuffer& staging_buffer, uint64 offset)
+    {
+        UploadFromBuffer(cmd, staging_buffer, offset, VertexList.GetSizeInBytes());
+    }
+
+    /**
+     * @brief Creates the GPU buffers from a mesh in the layout of `WriteToStaging()` with `vertices_size` bytes of
+     * vertices. `IndexType` and `IndexCount` must be set, but the local buffers can be empty.
+     */
+    void UploadFromBuffer(renderer::CommandBuffer& cmd, const renderer::RawGpuBuffer& staging_buffer, uint64 offset,
+                          uint64 vertices_size)
+    {
+        VertexList.UploadFromBuffer(cmd, staging_buffer, offset, vertices_size);
+
+        if (IndexCount > 0) {
+            GpuIndexBuffer.CreateFromBuffer(cmd, renderer::eGpuBufferType::IndexBuffer, staging_buffer,
+                                            offset + GetStagedIndexOffset(vertices_size),
+                                            static_cast<uint64>(IndexCount) * GetIndexSize(IndexType));
+        }
+    }
+
+    /**
+     * @brief Returns the number of bytes that `WriteToStaging()` writes for a mesh with `vertices_size` bytes of
+     * vertices and `index_count` indices of `index_type`.
+     */
+    static uint64 GetStagedSize(uint64 vertices_size, uint32 index_count, VkIndexType index_type)
+    {
+        return GetStagedIndexOffset(vertices_size) + static_cast<uint64>(index_count) * GetIndexSize(index_type);
+    }
+
+    /** @brief Returns `VK_INDEX_TYPE_UINT16` if every index in `indices` fits in 16 bits. */
+    static VkIndexType GetGpuIndexType(const SizedArray<uint32>& indices)
+    {
+        uint32 max_index = 0;
+
+        for (uint32 index : indices) {
+            max_index = std::max(max_index, index);
+        }
+
+        return (max_index > UINT16_MAX) ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+    }
+
+    static constexpr uint32 GetIndexSize(VkIndexType index_type)
+    {
+        return (index_type == VK_INDEX_TYPE_UINT16) ? sizeof(uint16) : sizeof(uint32);
     }
 
     void SetIndices(SizedArray<uint32>&& indices) { LocalIndexBuffer = std::move(indices); }
@@ -106,24 +233,42 @@ public:
 
     void Render(const renderer::CommandBuffer& cmd, uint32 num_instances)
     {
-        const VkDeviceSize offset = 0;
+        Render(cmd, num_instances, VertexList.GpuBuffer, 0);
+    }
 
-        vkCmdBindVertexBuffers(cmd.Cmd, 0, 1, &VertexList.GpuBuffer.Buffer, &offset);
-        vkCmdBindIndexBuffer(cmd.Cmd, GpuIndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
+    /**
+     * @brief Draws the mesh with the vertices at `vertex_offset` in `vertex_buffer` in place of its own, such as the
+     * output of the skinning pass (see `SkinningPass`).
+     */
+    void Render(const renderer::CommandBuffer& cmd, uint32 num_instances, const renderer::RawGpuBuffer& vertex_buffer,
+                VkDeviceSize vertex_offset)
+    {
+        vkCmdBindVertexBuffers(cmd.Cmd, 0, 1, &vertex_buffer.Buffer, &vertex_offset);
+        vkCmdBindIndexBuffer(cmd.Cmd, GpuIndexBuffer.Buffer, 0, IndexType);
 
-        vkCmdDrawIndexed(cmd.Cmd, static_cast<uint32>(GpuIndexBuffer.Size / sizeof(uint32)), num_instances, 0, 0, 0);
+        vkCmdDrawIndexed(cmd.Cmd, IndexCount, num_instances, 0, 0, 0);
     }
 
-    void RecalculateNormals()
+    void CalculateMissingNormals()
     {
-        using VertexType = renderer::Vertex<renderer::eVertexType::Default>;
+        if (VertexList.SupportsNormals() && !VertexList.HasNormals()) {
+            LogDebug("Calculating normals for mesh");
+            RecalculateNormals();
+        }
+    }
 
+    /**
+     * @brief Calculates smooth normals from the triangles of the mesh, and writes them into the vertices in the format
+     * of the vertex type (see `VertexList::WriteNormals()`).
+     */
+    void RecalculateNormals()
+    {
         if (LocalIndexBuffer.IsEmpty()) {
             LogWarning(LC_ASSET, "Cannot recalculate normals as local indices are missing!");
             return;
         }
 
-        AnonArray& vertices = VertexList.GetLocalBuffer();
+        const AnonArray& vertices = VertexList.GetLocalBuffer();
 
         if (vertices.IsEmpty()) {
             LogWarning(LC_ASSET, "Cannot recalculate normals as local vertices are missing!");
@@ -131,19 +276,29 @@ public:
         }
 
         const uint32 num_vertices = vertices.Size;
-        const uint32 num_faces = num_vertices / 3;
+        const uint8* vertex_data = static_cast<const uint8*>(vertices.pData);
 
-        // Zero the mesh normals
-        for (uint32 index = 0; index < num_vertices; index++) {
-            memset(vertices.Get<VertexType>(index).Normal, 0, sizeof(VertexType::Normal));
+        // The position is the first attribute of every vertex type, so it is read the same way for each layout
+        auto get_position = [&](uint32 index)
+        { return reinterpret_cast<const float32*>(vertex_data + (static_cast<uint64>(index) * vertices.ObjectSize)); };
+
+        SizedArray<Vec3f> normals;
+        normals.InitSize(num_vertices);
+
+        for (Vec3f& normal : normals) {
+            normal = Vec3f::sZero;
         }
 
-        for (uint32 index = 0; index < num_faces; index++) {
+        for (uint32 index = 0; index + 2 < LocalIndexBuffer.Size; index += 3) {
             // Indices for each vertex of the triangle
             const uint32 index_a = LocalIndexBuffer.pData[index];
             const uint32 index_b = LocalIndexBuffer.pData[index + 1];
             const uint32 index_c = LocalIndexBuffer.pData[index + 2];
 
+            if (index_a >= num_vertices || index_b >= num_vertices || index_c >= num_vertices) {
+                continue;
+            }
+
             /*
                         A
                       / |
@@ -159,39 +314,24 @@ public:
                 Average across vertices and normalize to remove scale.
              */
 
-
-            VertexType& vertex_a = vertices.Get<VertexType>(index_a);
-            VertexType& vertex_b = vertices.Get<VertexType>(index_b);
-            VertexType& vertex_c = vertices.Get<VertexType>(index_c);
-
-            const Vec3f edge_a = Vec3f::FromDifference(vertex_a.Position, vertex_b.Position);
-            const Vec3f edge_b = Vec3f::FromDifference(vertex_c.Position, vertex_b.Position);
+            const Vec3f edge_a = Vec3f::FromDifference(get_position(index_a), get_position(index_b));
+            const Vec3f edge_b = Vec3f::FromDifference(get_position(index_c), get_position(index_b));
 
             const Vec3f normal = edge_a.Cross(edge_b);
 
-            vertex_a.Normal[0] += normal.X;
-            vertex_a.Normal[1] += normal.Y;
-            vertex_a.Normal[2] += normal.Z;
-
-            vertex_b.Normal[0] += normal.X;
-            vertex_b.Normal[1] += normal.Y;
-            vertex_b.Normal[2] += normal.Z;
-
-            vertex_c.Normal[0] += normal.X;
-            vertex_c.Normal[1] += normal.Y;
-            vertex_c.Normal[2] += normal.Z;
+            normals[index_a] += normal;
+            normals[index_b] += normal;
+            normals[index_c] += normal;
         }
 
-
-        for (uint32 index = 0; index < vertices.Size; index++) {
-            VertexType& vertex = vertices.Get<VertexType>(index);
-
-            Vec3f vec(vertex.Position);
-            vec.NormalizeIP();
-            vec.CopyTo(vertex.Normal);
+        for (Vec3f& normal : normals) {
+            // Vertices that are not part of a triangle keep a zero normal
+            if (!normal.IsNearZero()) {
+                normal.NormalizeIP();
+            }
         }
 
-        VertexList.bContainsNormals = true;
+        VertexList.WriteNormals(normals);
     }
 
     void Destroy()
@@ -206,6 +346,7 @@ public:
 
         GpuIndexBuffer.Destroy();
         LocalIndexBuffer.Free();
+        IndexCount = 0;
     }
 
     ~PrimitiveMesh() { Destroy(); }
@@ -223,6 +364,28 @@ public:
 
     renderer::GpuBuffer GpuIndexBuffer;
     SizedArray<uint32> LocalIndexBuffer;
+
+    /// The type and number of indices in `GpuIndexBuffer` (see `CreateGpuIndexBuffer()`).
+    VkIndexType IndexType = VK_INDEX_TYPE_UINT32;
+    uint32 IndexCount = 0;
+
+private:
+    /** @brief Returns the offset of the indices in the data written by `WriteToStaging()`. */
+    static uint64 GetStagedIndexOffset(uint64 vertices_size) { return MathUtil::AlignValue<16>(vertices_size); }
+
+    static void WriteGpuIndices(void* dst, const SizedArray<uint32>& indices, VkIndexType index_type)
+    {
+        if (index_type == VK_INDEX_TYPE_UINT32) {
+            memcpy(dst, indices.pData, indices.GetSizeInBytes());
+            return;
+        }
+
+        uint16* dst16 = static_cast<uint16*>(dst);
+
+        for (uint32 i = 0; i < indices.Size; i++) {
+            dst16[i] = static_cast<uint16>(indices[i]);
+        }
+    }
 };
 
 } // namespace fx
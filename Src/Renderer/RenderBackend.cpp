@@ -26,6 +26,7 @@
 #include <Renderer/PSOBuild.hpp>
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/ShadowDirectional.hpp>
+#include <Renderer/SkinningPass.hpp>
 #include <thread>
 #include <vector>
 
@@ -123,7 +124,7 @@ void RenderBackend::Init(Vec2u window_size)
 	}
 
 	LightBuffer.Create(scLightUniformSize, Limits::MaxActiveLights);
-	BoneBuffer.Create(Limits::MaxBones * sizeof(Mat4f), 1);
+	BoneBuffer.Create(Limits::MaxBones * sizeof(Mat4f), Limits::MaxAnimationInstances + 1);
 
 	gMaterialManager->Create();
 	gObjectManager->Create();
@@ -133,6 +134,7 @@ void RenderBackend::Init(Vec2u window_size)
 	BoneBuffer.SetAllValues(initial_matrix.RawData, true);
 
 	gShadowRenderer = new ShadowDirectional(Vec2u(2048, 2048));
+	gSkinningPass = new SkinningPass;
 
 	pDeferredRenderer = new DeferredRenderer;
 	pDeferredRenderer->Create(Swapchain.Extent);
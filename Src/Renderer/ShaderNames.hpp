@@ -13,6 +13,7 @@ enum class eShaderName : uint32
 	Shadows,
 	Unlit,
 	Text,
+	Skinning,
 
 	NumShaders,
 };
@@ -33,6 +34,7 @@ constexpr const char* GetName(const eShaderName id)
 		FX_ENUM_CASE_NAME(Shadows);
 		FX_ENUM_CASE_NAME(Unlit);
 		FX_ENUM_CASE_NAME(Text);
+		FX_ENUM_CASE_NAME(Skinning);
 	default:
 		return "Unknown";
 	}
@@ -70,6 +70,28 @@ ShadowDirectional::ShadowDirectional(const Vec2u& size)
 		gPSOBuild->EndPipeline();
 	}
 
+	{
+		// Only the positions are read, which are the same in compact vertices; only the vertex stride differs.
+		gPSOBuild->BeginPipeline(ePipelineName::ShadowDirectionalCompact);
+		gPSOBuild->SetPushConstants(eShaderType::Vertex, sizeof(ShadowPushConstants));
+		gPSOBuild->UseRenderStage(RenderStage);
+
+		gPSOBuild->SetVertexType(eVertexType::Compact);
+		gPSOBuild->SetShader(eShaderName::Shadows, { ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" } });
+		gPSOBuild->SetViewportSize(size);
+		gPSOBuild->SetDepthCompareOp(VK_COMPARE_OP_GREATER);
+		gPSOBuild->SetCullMode(eCullMode::Back);
+		gPSOBuild->SetFaceOrder(eFaceOrder::Reverse);
+
+		gPSOBuild->AddBuffer(0, 0, eShaderType::Vertex, &gObjectManager->mObjectGpuBuffer, 0,
+							 gObjectManager->GetPageSize());
+
+		gPSOBuild->AddBuffer(1, 0, eShaderType::Pixel, &gMaterialManager->MaterialPropertiesBuffer, 0,
+							 gMaterialManager->MaterialPropertiesBuffer.Size);
+
+		gPSOBuild->EndPipeline();
+	}
+
 
 	// PipelineBuilder builder {};
 	// builder.SetLayout(pipeline_layout)
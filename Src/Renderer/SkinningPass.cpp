@@ -0,0 +1,157 @@
+#include "SkinningPass.hpp"
+
+#include <Core/Log.hpp>
+#include <Math/Mat4.hpp>
+#include <Renderer/Backend/DescriptorCache.hpp>
+#include <Renderer/Globals.hpp>
+#include <Renderer/Limits.hpp>
+#include <Renderer/PSOBuild.hpp>
+#include <Renderer/PipelineCache.hpp>
+#include <Renderer/PrimitiveMesh.hpp>
+#include <Renderer/RenderBackend.hpp>
+
+namespace fx::renderer {
+
+FX_SET_MODULE_NAME("SkinningPass")
+
+/// Must match `THREAD_GROUP_SIZE` in Skinning.hlsl
+static constexpr uint32 scThreadGroupSize = 64;
+
+/// The output page holds `Limits::MaxSkinnedVertices` of the largest output vertex.
+static constexpr uint32 scOutputPageSize = Limits::MaxSkinnedVertices * sizeof(Vertex<eVertexType::Default>);
+
+// Each frame's output is bound with a dynamic offset, which must be a multiple of `minStorageBufferOffsetAlignment` (at
+// most 256 bytes).
+static_assert((scOutputPageSize % 256) == 0);
+
+SkinningPass::SkinningPass()
+{
+	mOutputBuffer.Create(eGpuBufferType::VertexStorage, scOutputPageSize * FramesInFlight, VMA_MEMORY_USAGE_GPU_ONLY);
+
+	// `Skinning` reads `Skinned` vertices and writes `Default` vertices, `SkinningCompact` reads `CompactSkinned`
+	// vertices and writes `Compact` vertices.
+	const bool compact_variants[] = { false, true };
+
+	for (const bool compact : compact_variants) {
+		gPSOBuild->BeginPipeline(compact ? ePipelineName::SkinningCompact : ePipelineName::Skinning);
+		gPSOBuild->SetPushConstants(eShaderType::Compute, sizeof(SkinningPushConstants));
+
+		if (compact) {
+			gPSOBuild->SetShader(eShaderName::Skinning,
+								 { ShaderMacro { .pcName = "USE_COMPACT_VERTICES", .pcValue = "1" } });
+		}
+		else {
+			gPSOBuild->SetShader(eShaderName::Skinning, {});
+		}
+
+		// bSourceVertices. Each mesh binds a descriptor set with its own vertices, the output buffer is only used here
+		// to build the layout.
+		gPSOBuild->AddBuffer(0, 0, eShaderType::Compute, &mOutputBuffer, 0, scOutputPageSize);
+
+		// bBones
+		gPSOBuild->AddBuffer(1, 0, eShaderType::Compute, &gRenderer->BoneBuffer.GetGpuBuffer(), 0,
+							 gRenderer->BoneBuffer.GetSlotSize());
+
+		// bSkinnedVertices
+		gPSOBuild->AddBuffer(2, 0, eShaderType::Compute, &mOutputBuffer, 0, scOutputPageSize);
+
+		gPSOBuild->EndPipeline();
+	}
+}
+
+void SkinningPass::Begin()
+{
+	mOutputSize = 0;
+	mpBoundPipeline = nullptr;
+}
+
+uint64 SkinningPass::Skin(PrimitiveMesh& mesh, uint32 palette_offset)
+{
+	if (!bEnabled || !mesh.VertexList.IsSkinned()) {
+		return scNotSkinned;
+	}
+
+	GpuBuffer& source_vertices = mesh.GetVertexBuffer();
+
+	if (source_vertices.Buffer == nullptr) {
+		return scNotSkinned;
+	}
+
+	const bool is_compact = mesh.VertexList.IsCompact();
+
+	const uint32 source_vertex_size = VertexUtil::GetSize(mesh.VertexList.VertexType);
+	const uint32 output_vertex_size = VertexUtil::GetSize(is_compact ? eVertexType::Compact : eVertexType::Default);
+
+	const uint32 vertex_count = static_cast<uint32>(source_vertices.Size / source_vertex_size);
+
+	// The shader indexes the output by vertex, so each mesh starts on a multiple of its output vertex size
+	const uint32 output_vertex_start = (mOutputSize + output_vertex_size - 1) / output_vertex_size;
+	const uint64 output_end = static_cast<uint64>(output_vertex_start + vertex_count) * output_vertex_size;
+
+	if (output_end > scOutputPageSize) {
+		LogWarning(LC_RENDER, "Could not skin mesh with {} vertices, the skinning output for this frame is full",
+				   vertex_count);
+		return scNotSkinned;
+	}
+
+	CommandBuffer& cmd = gRenderer->GetFrame()->CmdBuffer;
+	Pipeline& pipeline = gPipelineCache->Request(is_compact ? ePipelineName::SkinningCompact : ePipelineName::Skinning);
+
+	if (mpBoundPipeline != &pipeline) {
+		pipeline.Bind(cmd);
+		mpBoundPipeline = &pipeline;
+	}
+
+	// The descriptor set for each mesh is only created the first time it is skinned
+	SizedArray<DescriptorEntry> ds_entries(3);
+	ds_entries.Insert(DescriptorEntry::AsBuffer(0, eShaderType::Compute, &source_vertices, 0, source_vertices.Size));
+	ds_entries.Insert(DescriptorEntry::AsBuffer(1, eShaderType::Compute, &gRenderer->BoneBuffer.GetGpuBuffer(), 0,
+												gRenderer->BoneBuffer.GetSlotSize()));
+	ds_entries.Insert(DescriptorEntry::AsBuffer(2, eShaderType::Compute, &mOutputBuffer, 0, scOutputPageSize));
+
+	DescriptorSet* descriptor_set = gDescriptorCache->Request(ds_entries).second;
+
+	const uint32 output_offset = scOutputPageSize * gRenderer->GetFrameNumber();
+
+	uint32 offsets[] = {
+		0,
+		gRenderer->BoneBuffer.GetBaseOffset() + palette_offset,
+		output_offset,
+	};
+
+	VkDescriptorSet set = descriptor_set->Get();
+
+	DescriptorSet::BindMultipleOffset(0, cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline, Slice<VkDescriptorSet>(&set, 1),
+									  Slice<uint32>(offsets, std::size(offsets)));
+
+	const SkinningPushConstants push_constants {
+		.VertexCount = vertex_count,
+		.OutputVertexStart = output_vertex_start,
+	};
+
+	gRenderer->SubmitPushConstants(cmd, pipeline, eShaderType::Compute, push_constants);
+
+	vkCmdDispatch(cmd.Get(), (vertex_count + scThreadGroupSize - 1) / scThreadGroupSize, 1, 1);
+
+	mOutputSize = static_cast<uint32>(output_end);
+
+	return output_offset + (static_cast<uint64>(output_vertex_start) * output_vertex_size);
+}
+
+void SkinningPass::End()
+{
+	if (mOutputSize == 0) {
+		return;
+	}
+
+	const VkMemoryBarrier barrier {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+	};
+
+	vkCmdPipelineBarrier(gRenderer->GetFrame()->CmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+						 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+} // namespace fx::renderer
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <Renderer/Backend/GpuBuffer.hpp>
+
+namespace fx {
+
+class PrimitiveMesh;
+
+namespace renderer {
+
+class CommandBuffer;
+class Pipeline;
+
+struct alignas(16) SkinningPushConstants
+{
+	uint32 VertexCount = 0;
+	uint32 OutputVertexStart = 0;
+};
+
+/**
+ * @brief Skins the vertices of each skinned mesh once per frame in a compute shader, before any other passes.
+ *
+ * The skinned vertices are written to a transient buffer as `Vertex<Default>` (or `Vertex<Compact>` for meshes with
+ * `CompactSkinned` vertices), so the geometry and shadow passes draw skinned meshes as static geometry with the same
+ * pipelines as every other object, instead of each skinning the vertices again in their vertex shader. The output buffer
+ * holds `Limits::MaxSkinnedVertices` default vertices for each frame in flight.
+ */
+class SkinningPass
+{
+public:
+	/// Returned from `Skin()` when the mesh was not skinned. Meshes with skinned vertices are then not drawn this frame,
+	/// as no geometry or shadow pipeline reads `Skinned` vertices (see `Object::DrawMesh()`).
+	static constexpr uint64 scNotSkinned = UINT64_MAX;
+
+public:
+	SkinningPass();
+
+	/**
+	 * @brief Starts recording the skinning dispatches for the current frame.
+	 */
+	void Begin();
+
+	/**
+	 * @brief Records a dispatch that skins the vertices of `mesh` with the palette at `palette_offset` in the bone
+	 * buffer (see `AnimationManager::GetPaletteOffset()`).
+	 *
+	 * @returns The offset of the skinned vertices in `GetOutputBuffer()`, or `scNotSkinned` if the mesh is not skinned
+	 * or there is no space remaining in the output buffer this frame.
+	 */
+	uint64 Skin(PrimitiveMesh& mesh, uint32 palette_offset);
+
+	/**
+	 * @brief Makes the skinned vertices visible to the vertex input of the following passes.
+	 */
+	void End();
+
+	FX_FORCE_INLINE RawGpuBuffer& GetOutputBuffer() { return mOutputBuffer; }
+
+	~SkinningPass() = default;
+
+public:
+	/// Skinned meshes are skinned by the pass when true, otherwise they are not drawn.
+	bool bEnabled = true;
+
+private:
+	RawGpuBuffer mOutputBuffer;
+
+	/// Number of bytes written to the output buffer in the current frame.
+	uint32 mOutputSize = 0;
+
+	Pipeline* mpBoundPipeline = nullptr;
+};
+
+} // namespace renderer
+} // namespace fx
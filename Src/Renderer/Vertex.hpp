@@ -12,6 +12,11 @@ enum class eVertexType
     Slim,
     Default,
     Skinned,
+
+    /// `Default` with octahedral normals and tangents and half float UVs (see `eVertexCreateFlags::Compact`).
+    Compact,
+    /// `Skinned` with the compact attributes of `Compact`, 8 bit bone ids and 8 bit normalized bone weights.
+    CompactSkinned,
 };
 
 constexpr eVertexType VertexLargestType = eVertexType::Skinned;
@@ -54,10 +59,32 @@ struct Vertex<eVertexType::Skinned>
     float32 BoneWeights[4]; /// Skinning bone weights
 };
 
+template <>
+struct Vertex<eVertexType::Compact>
+{
+    float32 Position[3];
+    int16 Normal[2];  /// Octahedral encoded, snorm16
+    uint16 UV[2];     /// Half float
+    int16 Tangent[2]; /// Octahedral encoded, snorm16
+};
+
+template <>
+struct Vertex<eVertexType::CompactSkinned>
+{
+    float32 Position[3];
+    int16 Normal[2];
+    uint16 UV[2];
+    int16 Tangent[2];
+    uint8 BoneIds[4];     /// Skinning bone ids, `Limits::MaxBones` must fit in 8 bits
+    uint8 BoneWeights[4]; /// Skinning bone weights, unorm8
+};
+
 
 // End packing structs
 #pragma pack(pop)
 
+static_assert(sizeof(Vertex<eVertexType::Compact>) == 24 && sizeof(Vertex<eVertexType::CompactSkinned>) == 32);
+
 } // namespace fx::renderer
 
 
@@ -91,6 +118,12 @@ FX_FORCE_INLINE uint32 GetSize(fx::renderer::eVertexType type)
     else if (type == eVertexType::Skinned) {
         return sizeof(Vertex<eVertexType::Skinned>);
     }
+    else if (type == eVertexType::Compact) {
+        return sizeof(Vertex<eVertexType::Compact>);
+    }
+    else if (type == eVertexType::CompactSkinned) {
+        return sizeof(Vertex<eVertexType::CompactSkinned>);
+    }
 
     return 0;
 }
@@ -102,7 +135,10 @@ template <eVertexType TVertexType>
 Vec3f GetPosition(const Vertex<TVertexType>& vertex)
 {
     static_assert(offsetof(Vertex<eVertexType::Slim>, Position) == offsetof(Vertex<eVertexType::Default>, Position) &&
-                  offsetof(Vertex<eVertexType::Default>, Position) == offsetof(Vertex<eVertexType::Skinned>, Position));
+                  offsetof(Vertex<eVertexType::Default>, Position) == offsetof(Vertex<eVertexType::Skinned>, Position) &&
+                  offsetof(Vertex<eVertexType::Default>, Position) == offsetof(Vertex<eVertexType::Compact>, Position) &&
+                  offsetof(Vertex<eVertexType::Default>, Position) ==
+                      offsetof(Vertex<eVertexType::CompactSkinned>, Position));
 
     return Vec3f(vertex.Position);
 }
@@ -0,0 +1,568 @@
+#include "VertexConvert.hpp"
+
+#include <Core/Assert.hpp>
+#include <Core/CpuFeatures.hpp>
+#include <Core/Defines.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace fx::renderer::VertexConvert {
+
+static constexpr uint32 scSignMask32 = 0x80000000;
+
+/**
+ * Copies elements `[start, end)` of an attribute. See `WriteAttribute()`.
+ */
+using WriteAttributeFn = void (*)(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride,
+                                  uint32 components, uint64 start, uint64 end, bool negate_x);
+
+static void WriteAttribute_Scalar(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride,
+                                  uint32 components, uint64 start, uint64 end, bool negate_x)
+{
+    const uint32 sign = negate_x ? scSignMask32 : 0;
+
+    for (uint64 i = start; i < end; i++) {
+        uint32 values[4];
+        memcpy(values, src + (i * src_stride), components * sizeof(uint32));
+
+        values[0] ^= sign;
+
+        memcpy(dst + (i * dst_stride), values, components * sizeof(uint32));
+    }
+}
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+/**
+ * Returns the end of the range of elements, starting at `start`, that can be loaded 16 bytes at a time without reading
+ * past the end of the source array.
+ */
+static FX_FORCE_INLINE uint64 GetWideLoadEnd(uint32 src_stride, uint64 start, uint64 end)
+{
+    // A 16 byte load reads `4 - src_stride` values past the element, so the last few elements are copied one value at a
+    // time.
+    const uint64 tail = (src_stride < 4) ? (3 / src_stride) : 0;
+    return (end - start > tail) ? end - tail : start;
+}
+
+FX_TARGET_SSE4 static void WriteAttribute_SSE4(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride,
+                                               uint32 components, uint64 start, uint64 end, bool negate_x)
+{
+    const __m128 sign = _mm_castsi128_ps(_mm_setr_epi32(negate_x ? scSignMask32 : 0, 0, 0, 0));
+
+    const uint64 wide_end = GetWideLoadEnd(src_stride, start, end);
+    uint64 i = start;
+
+    switch (components) {
+    case 2:
+        for (; i < end; i++) {
+            const __m128 values = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(src + (i * src_stride))));
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst + (i * dst_stride)), _mm_xor_ps(values, sign));
+        }
+        return;
+    case 3:
+        for (; i < wide_end; i++) {
+            const __m128 values = _mm_loadu_ps(reinterpret_cast<const float32*>(src + (i * src_stride)));
+
+            // Store the three values without writing over the next attribute
+            float32* out = reinterpret_cast<float32*>(dst + (i * dst_stride));
+            const __m128 signed_values = _mm_xor_ps(values, sign);
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(out), signed_values);
+            _mm_store_ss(out + 2, _mm_movehl_ps(signed_values, signed_values));
+        }
+        break;
+    case 4:
+        for (; i < end; i++) {
+            const __m128 values = _mm_loadu_ps(reinterpret_cast<const float32*>(src + (i * src_stride)));
+            _mm_storeu_ps(reinterpret_cast<float32*>(dst + (i * dst_stride)), _mm_xor_ps(values, sign));
+        }
+        return;
+    default:
+        break;
+    }
+
+    WriteAttribute_Scalar(dst, dst_stride, src, src_stride, components, i, end, negate_x);
+}
+
+FX_TARGET_AVX2 static void WriteAttribute_AVX2(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride,
+                                               uint32 components, uint64 start, uint64 end, bool negate_x)
+{
+    // Only the three component case differs from SSE4, where the store is masked instead of split in two
+    if (components != 3) {
+        WriteAttribute_SSE4(dst, dst_stride, src, src_stride, components, start, end, negate_x);
+        return;
+    }
+
+    const __m128 sign = _mm_castsi128_ps(_mm_setr_epi32(negate_x ? scSignMask32 : 0, 0, 0, 0));
+    const __m128i store_mask = _mm_setr_epi32(-1, -1, -1, 0);
+
+    const uint64 wide_end = GetWideLoadEnd(src_stride, start, end);
+    uint64 i = start;
+
+    for (; i < wide_end; i++) {
+        const __m128 values = _mm_loadu_ps(reinterpret_cast<const float32*>(src + (i * src_stride)));
+        _mm_maskstore_ps(reinterpret_cast<float32*>(dst + (i * dst_stride)), store_mask, _mm_xor_ps(values, sign));
+    }
+
+    WriteAttribute_Scalar(dst, dst_stride, src, src_stride, components, i, end, negate_x);
+}
+
+#endif
+
+static WriteAttributeFn GetWriteAttribute()
+{
+    static const WriteAttributeFn sWriteAttribute = []() -> WriteAttributeFn
+    {
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+        const eCpuTier tier = CpuFeatures::GetInstance().GetTier();
+
+        if (tier >= eCpuTier::AVX2) {
+            return WriteAttribute_AVX2;
+        }
+        if (tier >= eCpuTier::SSE4) {
+            return WriteAttribute_SSE4;
+        }
+#endif
+        return WriteAttribute_Scalar;
+    }();
+
+    return sWriteAttribute;
+}
+
+void WriteAttribute(uint8* dst, uint32 dst_stride, const void* src, uint32 src_stride, uint32 components, uint64 count,
+                    bool negate_x)
+{
+    Assert(components >= 1 && components <= 4);
+
+    GetWriteAttribute()(dst, dst_stride, static_cast<const uint32*>(src), src_stride, components, 0, count, negate_x);
+}
+
+void ZeroAttribute(uint8* dst, uint32 dst_stride, uint32 components, uint64 count)
+{
+    for (uint64 i = 0; i < count; i++) {
+        memset(dst + (i * dst_stride), 0, components * sizeof(uint32));
+    }
+}
+
+///////////////////////////////////
+// Compact attributes
+///////////////////////////////////
+
+/// Directions shorter than this (such as zeroed normals) are encoded as +Z instead of dividing by zero.
+static constexpr float32 scMinOctahedralLength = 1e-20f;
+
+static constexpr float32 scSnorm16Scale = 32767.0f;
+static constexpr float32 scUnorm8Scale = 255.0f;
+
+/// Scales a float exponent bias (127) to a half float exponent bias (15)
+static constexpr uint32 scHalfMagic = 15 << 23;
+/// The largest float below the half float infinity after `scHalfMagic` is applied, less the rounding bias
+static constexpr uint32 scHalfClamp = (31 << 23) - 0x1000;
+static constexpr uint32 scFloatInfinity = 255 << 23;
+
+/**
+ * Writes elements `[start, end)` of an attribute in a compact format. See `WriteOctahedral()` and the functions below
+ * it.
+ */
+using WriteOctahedralFn = void (*)(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 start,
+                                   uint64 end, bool negate_x);
+using WriteCompactFloatFn = void (*)(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride,
+                                     uint64 start, uint64 end);
+using WriteCompactUintFn = void (*)(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride, uint64 start,
+                                    uint64 end);
+
+struct CompactKernels
+{
+    WriteOctahedralFn WriteOctahedral;
+    WriteCompactFloatFn WriteHalf2;
+    WriteCompactFloatFn WriteUnorm8x4;
+    WriteCompactUintFn WriteUint8x4;
+};
+
+static FX_FORCE_INLINE int16 ToSnorm16(float32 value)
+{
+    // Rounds to nearest even, the same as `_mm_cvtps_epi32`
+    return static_cast<int16>(std::nearbyint(std::clamp(value, -1.0f, 1.0f) * scSnorm16Scale));
+}
+
+static FX_FORCE_INLINE float32 SignNotZero(float32 value) { return (value < 0.0f) ? -1.0f : 1.0f; }
+
+/**
+ * Rounds and rebiases a float to a half float. Values too large for a half float become infinity, and any NaN becomes
+ * a quiet NaN.
+ */
+static uint16 FloatToHalf(float32 value)
+{
+    uint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint32 sign = bits & scSignMask32;
+    bits ^= sign;
+
+    uint32 half;
+
+    if (bits >= scFloatInfinity) {
+        half = (bits > scFloatInfinity) ? 0x7E00 : 0x7C00;
+    }
+    else {
+        // Drop the bits below the rounding bit so that they cannot carry into it
+        bits &= ~0xFFFu;
+
+        float32 magic, clamp;
+        memcpy(&magic, &scHalfMagic, sizeof(magic));
+        memcpy(&clamp, &scHalfClamp, sizeof(clamp));
+
+        float32 scaled;
+        memcpy(&scaled, &bits, sizeof(scaled));
+        scaled = std::min(scaled * magic, clamp);
+
+        memcpy(&bits, &scaled, sizeof(bits));
+        half = (bits + 0x1000) >> 13;
+    }
+
+    return static_cast<uint16>(half | (sign >> 16));
+}
+
+static void WriteOctahedral_Scalar(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 start,
+                                   uint64 end, bool negate_x)
+{
+    const float32 x_sign = negate_x ? -1.0f : 1.0f;
+
+    for (uint64 i = start; i < end; i++) {
+        const float32* direction = src + (i * src_stride);
+
+        const float32 x = direction[0] * x_sign;
+        const float32 y = direction[1];
+        const float32 z = direction[2];
+
+        // Project onto the octahedron |x| + |y| + |z| = 1
+        const float32 inv_length = 1.0f / std::max(fabsf(x) + fabsf(y) + fabsf(z), scMinOctahedralLength);
+
+        float32 ox = x * inv_length;
+        float32 oy = y * inv_length;
+
+        // Fold the lower hemisphere over the diagonals
+        if (z < 0.0f) {
+            const float32 folded_x = (1.0f - fabsf(oy)) * SignNotZero(ox);
+            oy = (1.0f - fabsf(ox)) * SignNotZero(oy);
+            ox = folded_x;
+        }
+
+        const int16 encoded[2] = { ToSnorm16(ox), ToSnorm16(oy) };
+        memcpy(dst + (i * dst_stride), encoded, sizeof(encoded));
+    }
+}
+
+static void WriteHalf2_Scalar(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 start,
+                              uint64 end)
+{
+    for (uint64 i = start; i < end; i++) {
+        const float32* values = src + (i * src_stride);
+
+        const uint16 encoded[2] = { FloatToHalf(values[0]), FloatToHalf(values[1]) };
+        memcpy(dst + (i * dst_stride), encoded, sizeof(encoded));
+    }
+}
+
+/**
+ * Adds the difference between the sum of `weights` and 255 to the largest weight. Vertices with no weights are left
+ * as they are.
+ */
+static FX_FORCE_INLINE void NormalizeUnorm8x4(int32 weights[4])
+{
+    const int32 sum = weights[0] + weights[1] + weights[2] + weights[3];
+
+    if (sum == 0) {
+        return;
+    }
+
+    int32* largest = std::max_element(weights, weights + 4);
+    *largest = std::clamp(*largest + (static_cast<int32>(scUnorm8Scale) - sum), 0, 255);
+}
+
+static FX_FORCE_INLINE void StoreUnorm8x4(uint8* dst, const int32 weights[4])
+{
+    for (uint32 component = 0; component < 4; component++) {
+        dst[component] = static_cast<uint8>(weights[component]);
+    }
+}
+
+static void WriteUnorm8x4_Scalar(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 start,
+                                 uint64 end)
+{
+    for (uint64 i = start; i < end; i++) {
+        const float32* values = src + (i * src_stride);
+
+        int32 weights[4];
+        for (uint32 component = 0; component < 4; component++) {
+            weights[component] = static_cast<int32>(
+                std::nearbyint(std::clamp(values[component], 0.0f, 1.0f) * scUnorm8Scale));
+        }
+
+        NormalizeUnorm8x4(weights);
+        StoreUnorm8x4(dst + (i * dst_stride), weights);
+    }
+}
+
+static void WriteUint8x4_Scalar(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride, uint64 start,
+                                uint64 end)
+{
+    for (uint64 i = start; i < end; i++) {
+        const uint32* values = src + (i * src_stride);
+        uint8* out = dst + (i * dst_stride);
+
+        for (uint32 component = 0; component < 4; component++) {
+            out[component] = static_cast<uint8>(std::min<uint32>(values[component], UINT8_MAX));
+        }
+    }
+}
+
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+
+/**
+ * Octahedral encodes four directions, returning the snorm16 pairs for each direction in order.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128i EncodeOctahedral4(__m128 x, __m128 y, __m128 z)
+{
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 abs_x = _mm_andnot_ps(sign_mask, x);
+    const __m128 abs_y = _mm_andnot_ps(sign_mask, y);
+    const __m128 abs_z = _mm_andnot_ps(sign_mask, z);
+
+    const __m128 length = _mm_max_ps(_mm_add_ps(_mm_add_ps(abs_x, abs_y), abs_z), _mm_set1_ps(scMinOctahedralLength));
+
+    __m128 ox = _mm_div_ps(x, length);
+    __m128 oy = _mm_div_ps(y, length);
+
+    // Fold the lower hemisphere over the diagonals. The sign of zero is positive, matching `SignNotZero()`.
+    const __m128 sign_x = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(ox, zero), sign_mask), one);
+    const __m128 sign_y = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(oy, zero), sign_mask), one);
+
+    const __m128 folded_x = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, oy)), sign_x);
+    const __m128 folded_y = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, ox)), sign_y);
+
+    const __m128 lower_hemisphere = _mm_cmplt_ps(z, zero);
+
+    ox = _mm_blendv_ps(ox, folded_x, lower_hemisphere);
+    oy = _mm_blendv_ps(oy, folded_y, lower_hemisphere);
+
+    const __m128 scale = _mm_set1_ps(scSnorm16Scale);
+    const __m128 neg_one = _mm_set1_ps(-1.0f);
+
+    const __m128i qx = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ox, neg_one), one), scale));
+    const __m128i qy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(oy, neg_one), one), scale));
+
+    return _mm_packs_epi32(_mm_unpacklo_epi32(qx, qy), _mm_unpackhi_epi32(qx, qy));
+}
+
+/**
+ * Stores each 32 bit lane of `values` into consecutive vertices.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE void StoreLanes4(uint8* dst, uint32 dst_stride, __m128i values)
+{
+    const uint32 lanes[4] = {
+        static_cast<uint32>(_mm_extract_epi32(values, 0)),
+        static_cast<uint32>(_mm_extract_epi32(values, 1)),
+        static_cast<uint32>(_mm_extract_epi32(values, 2)),
+        static_cast<uint32>(_mm_extract_epi32(values, 3)),
+    };
+
+    for (uint32 lane = 0; lane < 4; lane++) {
+        memcpy(dst + (lane * dst_stride), &lanes[lane], sizeof(uint32));
+    }
+}
+
+FX_TARGET_SSE4 static void WriteOctahedral_SSE4(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride,
+                                                uint64 start, uint64 end, bool negate_x)
+{
+    const __m128 x_sign = _mm_set1_ps(negate_x ? -1.0f : 1.0f);
+
+    uint64 i = start;
+
+    for (; i + 4 <= end; i += 4) {
+        const float32* d0 = src + (i * src_stride);
+        const float32* d1 = d0 + src_stride;
+        const float32* d2 = d1 + src_stride;
+        const float32* d3 = d2 + src_stride;
+
+        const __m128 x = _mm_mul_ps(_mm_setr_ps(d0[0], d1[0], d2[0], d3[0]), x_sign);
+        const __m128 y = _mm_setr_ps(d0[1], d1[1], d2[1], d3[1]);
+        const __m128 z = _mm_setr_ps(d0[2], d1[2], d2[2], d3[2]);
+
+        StoreLanes4(dst + (i * dst_stride), dst_stride, EncodeOctahedral4(x, y, z));
+    }
+
+    WriteOctahedral_Scalar(dst, dst_stride, src, src_stride, i, end, negate_x);
+}
+
+/**
+ * Converts four floats to half floats in the low 16 bits of each lane. See `FloatToHalf()`.
+ */
+FX_TARGET_SSE4 static FX_FORCE_INLINE __m128i FloatToHalf4(__m128 values)
+{
+    const __m128i sign_mask = _mm_set1_epi32(static_cast<int32>(scSignMask32));
+    const __m128i infinity = _mm_set1_epi32(scFloatInfinity);
+
+    const __m128i bits = _mm_castps_si128(values);
+    const __m128i sign = _mm_and_si128(bits, sign_mask);
+    const __m128i abs_bits = _mm_xor_si128(bits, sign);
+
+    const __m128i is_nan = _mm_cmpgt_epi32(abs_bits, infinity);
+    const __m128i is_finite = _mm_cmpgt_epi32(infinity, abs_bits);
+    const __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(is_nan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+    const __m128 truncated = _mm_castsi128_ps(_mm_and_si128(abs_bits, _mm_set1_epi32(~0xFFF)));
+    const __m128 scaled = _mm_min_ps(_mm_mul_ps(truncated, _mm_castsi128_ps(_mm_set1_epi32(scHalfMagic))),
+                                     _mm_castsi128_ps(_mm_set1_epi32(scHalfClamp)));
+
+    const __m128i rounded = _mm_srli_epi32(_mm_add_epi32(_mm_castps_si128(scaled), _mm_set1_epi32(0x1000)), 13);
+    const __m128i half = _mm_blendv_epi8(inf_or_nan, rounded, is_finite);
+
+    return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+}
+
+FX_TARGET_SSE4 static void WriteHalf2_SSE4(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride,
+                                           uint64 start, uint64 end)
+{
+    uint64 i = start;
+
+    for (; i + 4 <= end; i += 4) {
+        const float32* v0 = src + (i * src_stride);
+        const float32* v1 = v0 + src_stride;
+        const float32* v2 = v1 + src_stride;
+        const float32* v3 = v2 + src_stride;
+
+        const __m128i low = FloatToHalf4(_mm_setr_ps(v0[0], v0[1], v1[0], v1[1]));
+        const __m128i high = FloatToHalf4(_mm_setr_ps(v2[0], v2[1], v3[0], v3[1]));
+
+        StoreLanes4(dst + (i * dst_stride), dst_stride, _mm_packus_epi32(low, high));
+    }
+
+    WriteHalf2_Scalar(dst, dst_stride, src, src_stride, i, end);
+}
+
+FX_TARGET_SSE4 static void WriteUnorm8x4_SSE4(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride,
+                                              uint64 start, uint64 end)
+{
+    const __m128 scale = _mm_set1_ps(scUnorm8Scale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (uint64 i = start; i < end; i++) {
+        const __m128 values = _mm_loadu_ps(src + (i * src_stride));
+        const __m128i quantized = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(values, zero), one), scale));
+
+        int32 weights[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(weights), quantized);
+
+        NormalizeUnorm8x4(weights);
+        StoreUnorm8x4(dst + (i * dst_stride), weights);
+    }
+}
+
+FX_TARGET_SSE4 static void WriteUint8x4_SSE4(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride,
+                                             uint64 start, uint64 end)
+{
+    const __m128i max_value = _mm_set1_epi32(UINT8_MAX);
+
+    for (uint64 i = start; i < end; i++) {
+        const __m128i values = _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i * src_stride))),
+                                             max_value);
+
+        const __m128i words = _mm_packus_epi32(values, values);
+        const uint32 packed = static_cast<uint32>(_mm_cvtsi128_si32(_mm_packus_epi16(words, words)));
+
+        memcpy(dst + (i * dst_stride), &packed, sizeof(packed));
+    }
+}
+
+FX_TARGET_AVX2 static void WriteOctahedral_AVX2(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride,
+                                                uint64 start, uint64 end, bool negate_x)
+{
+    const __m256 x_sign = _mm256_set1_ps(negate_x ? -1.0f : 1.0f);
+
+    // Offsets of the first component of each of the eight directions, relative to the first direction
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32(static_cast<int32>(src_stride)));
+
+    uint64 i = start;
+
+    for (; i + 8 <= end; i += 8) {
+        const float32* base = src + (i * src_stride);
+
+        const __m256 x = _mm256_mul_ps(_mm256_i32gather_ps(base, offsets, sizeof(float32)), x_sign);
+        const __m256 y = _mm256_i32gather_ps(base + 1, offsets, sizeof(float32));
+        const __m256 z = _mm256_i32gather_ps(base + 2, offsets, sizeof(float32));
+
+        uint8* out = dst + (i * dst_stride);
+
+        StoreLanes4(out, dst_stride,
+                    EncodeOctahedral4(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y),
+                                      _mm256_castps256_ps128(z)));
+        StoreLanes4(out + (4 * dst_stride), dst_stride,
+                    EncodeOctahedral4(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1),
+                                      _mm256_extractf128_ps(z, 1)));
+    }
+
+    WriteOctahedral_SSE4(dst, dst_stride, src, src_stride, i, end, negate_x);
+}
+
+#endif
+
+static const CompactKernels& GetCompactKernels()
+{
+    static const CompactKernels sKernels = []() -> CompactKernels
+    {
+#if defined FX_USE_CPU_DISPATCH || defined FX_USE_AVX
+        const eCpuTier tier = CpuFeatures::GetInstance().GetTier();
+
+        if (tier >= eCpuTier::SSE4) {
+            return CompactKernels {
+                .WriteOctahedral = (tier >= eCpuTier::AVX2) ? WriteOctahedral_AVX2 : WriteOctahedral_SSE4,
+                .WriteHalf2 = WriteHalf2_SSE4,
+                .WriteUnorm8x4 = WriteUnorm8x4_SSE4,
+                .WriteUint8x4 = WriteUint8x4_SSE4,
+            };
+        }
+#endif
+        return CompactKernels {
+            .WriteOctahedral = WriteOctahedral_Scalar,
+            .WriteHalf2 = WriteHalf2_Scalar,
+            .WriteUnorm8x4 = WriteUnorm8x4_Scalar,
+            .WriteUint8x4 = WriteUint8x4_Scalar,
+        };
+    }();
+
+    return sKernels;
+}
+
+void WriteOctahedral(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count, bool negate_x)
+{
+    GetCompactKernels().WriteOctahedral(dst, dst_stride, src, src_stride, 0, count, negate_x);
+}
+
+void WriteHalf2(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count)
+{
+    GetCompactKernels().WriteHalf2(dst, dst_stride, src, src_stride, 0, count);
+}
+
+void WriteUnorm8x4(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count)
+{
+    GetCompactKernels().WriteUnorm8x4(dst, dst_stride, src, src_stride, 0, count);
+}
+
+void WriteUint8x4(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride, uint64 count)
+{
+    GetCompactKernels().WriteUint8x4(dst, dst_stride, src, src_stride, 0, count);
+}
+
+} // namespace fx::renderer::VertexConvert
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx::renderer::VertexConvert {
+
+/**
+ * @brief Copies one attribute from a tightly packed source array into each vertex of an interleaved vertex buffer.
+ *
+ * @param dst Pointer to the attribute in the first vertex.
+ * @param dst_stride The size of each vertex in bytes.
+ * @param src The source values. Each element is `src_stride` values apart.
+ * @param src_stride The number of values between elements in `src` (for example, 4 for an array of `Vec3f`).
+ * @param components The number of values in the attribute, from 1 to 4.
+ * @param count The number of vertices to write.
+ * @param negate_x If true, the first component of each element is negated (see `eVertexCreateFlags::NegativeX`).
+ *
+ * Values are copied bit for bit (unless negated), so this can also be used for integer attributes. On x86-64 the
+ * implementation is chosen for the host CPU on first use (see `CpuFeatures`).
+ */
+void WriteAttribute(uint8* dst, uint32 dst_stride, const void* src, uint32 src_stride, uint32 components, uint64 count,
+                    bool negate_x = false);
+
+/**
+ * @brief Zeroes one attribute of `components` values in each vertex of an interleaved vertex buffer.
+ */
+void ZeroAttribute(uint8* dst, uint32 dst_stride, uint32 components, uint64 count);
+
+/**
+ * @brief Encodes a direction attribute (normals and tangents) into each vertex as two snorm16 values, using an
+ * octahedral mapping. The directions do not need to be normalized. Decoded with `DecodeOctahedral()` in Helper.hlsl.
+ *
+ * @param src The source directions. Each element is `src_stride` values apart.
+ * @param negate_x If true, the X component of each direction is negated before encoding.
+ */
+void WriteOctahedral(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count,
+                     bool negate_x = false);
+
+/**
+ * @brief Writes a two component attribute (UVs) into each vertex as half floats.
+ */
+void WriteHalf2(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count);
+
+/**
+ * @brief Writes four weights into each vertex as unorm8 values. The rounding error is added to the largest weight, so
+ * that the weights of each vertex still add up to one.
+ */
+void WriteUnorm8x4(uint8* dst, uint32 dst_stride, const float32* src, uint32 src_stride, uint64 count);
+
+/**
+ * @brief Writes four indices into each vertex as 8 bit values. Indices above 255 are clamped.
+ */
+void WriteUint8x4(uint8* dst, uint32 dst_stride, const uint32* src, uint32 src_stride, uint64 count);
+
+} // namespace fx::renderer::VertexConvert
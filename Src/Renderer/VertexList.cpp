@@ -1,90 +1,132 @@
 #include "VertexList.hpp"
 
+#include "VertexConvert.hpp"
+
+#include <Renderer/Limits.hpp>
+
 namespace fx::renderer {
 
-template <typename TType, uint32 TNumComponents>
-FX_FORCE_INLINE void WriteOrZero(TType* dst, const SizedArray<TType>& src, uint64 index, bool write_or_zero)
-{
-    constexpr uint32 size = TNumComponents * sizeof(TType);
+using CompactVertex = Vertex<eVertexType::CompactSkinned>;
 
-    if (write_or_zero) {
-        memcpy(dst, &src[index * TNumComponents], size);
-        return;
-    }
+// The attributes are written into the buffer using the offsets of the largest vertex type, so they must be at the same
+// offsets in each vertex type.
+static_assert(offsetof(Vertex<eVertexType::Default>, Normal) == offsetof(Vertex<eVertexType::Skinned>, Normal) &&
+              offsetof(Vertex<eVertexType::Default>, UV) == offsetof(Vertex<eVertexType::Skinned>, UV) &&
+              offsetof(Vertex<eVertexType::Default>, Tangent) == offsetof(Vertex<eVertexType::Skinned>, Tangent));
 
-    memset(dst, 0, size);
-}
+static_assert(offsetof(Vertex<eVertexType::Compact>, Normal) == offsetof(CompactVertex, Normal) &&
+              offsetof(Vertex<eVertexType::Compact>, UV) == offsetof(CompactVertex, UV) &&
+              offsetof(Vertex<eVertexType::Compact>, Tangent) == offsetof(CompactVertex, Tangent));
 
-template <typename TType, typename TVecType, uint32 TNumComponents>
-FX_FORCE_INLINE void WriteOrZeroVec(TType* dst, const SizedArray<TVecType>& src, uint64 index, bool write_or_zero)
+// Bone ids are stored in 8 bits in compact vertices
+static_assert(Limits::MaxBones <= 256);
+
+/**
+ * Writes one attribute from `src` into every vertex in `buffer`, or zeroes the attribute if `write_or_zero` is false.
+ * `src_stride` is the number of values between each element in `src`.
+ */
+static void WriteOrZeroStream(AnonArray& buffer, uint64 offset, const void* src, uint32 src_stride, uint32 components,
+                              bool write_or_zero, bool negate_x = false)
 {
-    constexpr uint32 size = TNumComponents * sizeof(TType);
+    uint8* dst = static_cast<uint8*>(buffer.pData) + offset;
 
     if (write_or_zero) {
-        memcpy(dst, &src[index].mData, size);
+        VertexConvert::WriteAttribute(dst, buffer.ObjectSize, src, src_stride, components, buffer.Capacity, negate_x);
         return;
     }
 
-    memset(dst, 0, size);
+    VertexConvert::ZeroAttribute(dst, buffer.ObjectSize, components, buffer.Capacity);
 }
 
-void VertexList::CreateFrom(const SizedArray<Vec3f>& positions, const SizedArray<Vec3f>& normals,
-                            const SizedArray<Vec2f>& uvs, const SizedArray<Vec3f>& tangents,
-                            const SizedArray<Vec4f>& bone_weights, const SizedArray<Vec4u>& bone_ids,
-                            eVertexCreateFlags create_flags)
+/**
+ * Converts the streams of `sources` into the compact attributes of `Compact` and `CompactSkinned` vertices.
+ */
+static void WriteCompactStreams(AnonArray& buffer, const VertexSources& sources, bool skinned, bool negate_x)
 {
-    Assert(mLocalBuffer.IsEmpty());
+    uint8* vertices = static_cast<uint8*>(buffer.pData);
+    const uint32 stride = buffer.ObjectSize;
+    const uint64 count = buffer.Capacity;
+
+    // Each compact attribute is 32 bits wide, so missing attributes are zeroed as one value. A zeroed direction
+    // decodes to +Z.
+    auto write_direction = [&](uint64 offset, const float32* src, uint32 src_stride)
+    {
+        if (src == nullptr) {
+            VertexConvert::ZeroAttribute(vertices + offset, stride, 1, count);
+            return;
+        }
 
-    VertexType = eVertexType::Slim;
+        VertexConvert::WriteOctahedral(vertices + offset, stride, src, src_stride, count, negate_x);
+    };
 
-    // Assume default vertex is requested if there are non-null values passed in for the additional components
-    if (normals.IsInited() || uvs.IsInited() || tangents.IsInited()) {
-        VertexType = eVertexType::Default;
-    }
+    write_direction(offsetof(CompactVertex, Normal), sources.pNormals, sources.NormalStride);
+    write_direction(offsetof(CompactVertex, Tangent), sources.pTangents, sources.TangentStride);
 
-    // Only switch to the skinned vertex if there is animation data passed in. Otherwise, the caller should fallback to
-    // the default vertex pipelines.
-    if (bone_weights.IsNotEmpty() && bone_ids.IsNotEmpty()) {
-        VertexType = eVertexType::Skinned;
+    if (sources.pUVs != nullptr) {
+        VertexConvert::WriteHalf2(vertices + offsetof(CompactVertex, UV), stride, sources.pUVs, sources.UVStride,
+                                  count);
+    }
+    else {
+        VertexConvert::ZeroAttribute(vertices + offsetof(CompactVertex, UV), stride, 1, count);
     }
 
-    const uint32 vertex_size = VertexUtil::GetSize(VertexType);
-
-    mLocalBuffer.Create(vertex_size, positions.Size);
-
-    const bool supports_default = (VertexType != eVertexType::Slim);
-    const bool supports_skinning = (VertexType == eVertexType::Skinned);
-
-    bContainsNormals = normals.IsNotEmpty();
-    bContainsUVs = uvs.IsNotEmpty();
-    bContainsTangents = tangents.IsNotEmpty();
-
-    for (uint64 vertex_index = 0; vertex_index < mLocalBuffer.Capacity; vertex_index++) {
-        Vertex<VertexLargestType> vertex;
-
-        memcpy(vertex.Position, &positions[vertex_index].mData, sizeof(vertex.Position));
-
-        if ((create_flags & eVertexCreateFlags::NegativeX) != 0) {
-            vertex.Position[0] = -vertex.Position[0];
-        }
+    if (skinned) {
+        VertexConvert::WriteUint8x4(vertices + offsetof(CompactVertex, BoneIds), stride, sources.pBoneIds,
+                                    sources.BoneIdStride, count);
+        VertexConvert::WriteUnorm8x4(vertices + offsetof(CompactVertex, BoneWeights), stride, sources.pBoneWeights,
+                                     sources.BoneWeightStride, count);
+    }
+}
 
-        // Write the components for a default vertex if the type supports it
-        if (supports_default) {
-            WriteOrZeroVec<float32, Vec3f, 3>(vertex.Normal, normals, vertex_index, bContainsNormals);
-            WriteOrZeroVec<float32, Vec2f, 2>(vertex.UV, uvs, vertex_index, bContainsUVs);
-            WriteOrZeroVec<float32, Vec3f, 3>(vertex.Tangent, tangents, vertex_index, bContainsTangents);
+static eVertexType GetCompactType(eVertexType vertex_type)
+{
+    switch (vertex_type) {
+    case eVertexType::Default:
+        return eVertexType::Compact;
+    case eVertexType::Skinned:
+        return eVertexType::CompactSkinned;
+    default:;
+    }
 
-            if (supports_skinning) {
-                // To support skinned vertices, we enforce that there is data available above; this means we dont need
-                // to check in WriteOrZero.
+    return vertex_type;
+}
 
-                WriteOrZeroVec<uint32, Vec4u, 4>(vertex.BoneIds, bone_ids, vertex_index, true);
-                WriteOrZeroVec<float32, Vec4f, 4>(vertex.BoneWeights, bone_weights, vertex_index, true);
-            }
-        }
+/**
+ * Returns the values of `stream`, or null if it is empty so that the attribute is zeroed.
+ */
+template <typename TElementType>
+static const TElementType* GetStreamData(const SizedArray<TElementType>& stream)
+{
+    return stream.IsNotEmpty() ? stream.pData : nullptr;
+}
 
-        mLocalBuffer.InsertRaw(&vertex);
-    }
+void VertexList::CreateFrom(const SizedArray<Vec3f>& positions, const SizedArray<Vec3f>& normals,
+                            const SizedArray<Vec2f>& uvs, const SizedArray<Vec3f>& tangents,
+                            const SizedArray<Vec4f>& bone_weights, const SizedArray<Vec4u>& bone_ids,
+                            eVertexCreateFlags create_flags)
+{
+    constexpr uint32 cVec2Stride = sizeof(Vec2f) / sizeof(float32);
+    constexpr uint32 cVec3Stride = sizeof(Vec3f) / sizeof(float32);
+    constexpr uint32 cVec4Stride = sizeof(Vec4f) / sizeof(float32);
+
+    static_assert(sizeof(Vec4u) == sizeof(Vec4f));
+
+    const VertexSources sources {
+        .pPositions = reinterpret_cast<const float32*>(positions.pData),
+        .pNormals = reinterpret_cast<const float32*>(GetStreamData(normals)),
+        .pUVs = reinterpret_cast<const float32*>(GetStreamData(uvs)),
+        .pTangents = reinterpret_cast<const float32*>(GetStreamData(tangents)),
+        .pBoneWeights = reinterpret_cast<const float32*>(GetStreamData(bone_weights)),
+        .pBoneIds = reinterpret_cast<const uint32*>(GetStreamData(bone_ids)),
+        .PositionStride = cVec3Stride,
+        .NormalStride = cVec3Stride,
+        .UVStride = cVec2Stride,
+        .TangentStride = cVec3Stride,
+        .BoneWeightStride = cVec4Stride,
+        .BoneIdStride = cVec4Stride,
+    };
+
+    CreateFrom(sources, static_cast<uint32>(positions.Size), create_flags);
 }
 
 void VertexList::CreateFrom(const SizedArray<float32>& positions, const SizedArray<float32>& normals,
@@ -92,68 +134,112 @@ void VertexList::CreateFrom(const SizedArray<float32>& positions, const SizedArr
                             const SizedArray<float32>& bone_weights, const SizedArray<uint32>& bone_ids,
                             eVertexCreateFlags create_flags)
 {
-    Assert(mLocalBuffer.IsEmpty());
-    Assert(positions.Size > 0);
     Assert(((positions.Size) % 3) == 0);
 
+    const VertexSources sources {
+        .pPositions = positions.pData,
+        .pNormals = GetStreamData(normals),
+        .pUVs = GetStreamData(uvs),
+        .pTangents = GetStreamData(tangents),
+        .pBoneWeights = GetStreamData(bone_weights),
+        .pBoneIds = GetStreamData(bone_ids),
+    };
+
+    CreateFrom(sources, static_cast<uint32>(positions.Size / 3), create_flags);
+}
+
+void VertexList::CreateFrom(const VertexSources& sources, uint32 vertex_count, eVertexCreateFlags create_flags)
+{
+    Assert(mLocalBuffer.IsEmpty());
+    Assert(sources.pPositions != nullptr);
+    Assert(vertex_count > 0);
+
     VertexType = eVertexType::Slim;
 
-    // Assume default vertex is requested if there are non-null values passed in for the additional components
-    if (normals.IsInited() || uvs.IsInited() || tangents.IsInited()) {
+    // Assume default vertex is requested if there are values passed in for the additional components
+    if (sources.pNormals != nullptr || sources.pUVs != nullptr || sources.pTangents != nullptr) {
         VertexType = eVertexType::Default;
     }
 
     // Only switch to the skinned vertex if there is animation data passed in. Otherwise, the caller should fallback to
     // the default vertex pipelines.
-    if (bone_weights.IsNotEmpty() && bone_ids.IsNotEmpty()) {
+    if (sources.pBoneWeights != nullptr && sources.pBoneIds != nullptr) {
         VertexType = eVertexType::Skinned;
     }
 
+    if ((create_flags & eVertexCreateFlags::Compact) != 0) {
+        VertexType = GetCompactType(VertexType);
+    }
+
     const uint32 vertex_size = VertexUtil::GetSize(VertexType);
-    const uint32 amount_of_vertices = positions.Size / 3;
 
-    mLocalBuffer.Create(vertex_size, amount_of_vertices);
+    mLocalBuffer.Create(vertex_size, vertex_count);
 
     const bool supports_default = (VertexType != eVertexType::Slim);
-    const bool supports_skinning = (VertexType == eVertexType::Skinned);
+    const bool supports_skinning = IsSkinned();
 
-    bContainsNormals = normals.IsNotEmpty();
-    bContainsUVs = uvs.IsNotEmpty();
-    bContainsTangents = tangents.IsNotEmpty();
+    bContainsNormals = (sources.pNormals != nullptr);
+    bContainsUVs = (sources.pUVs != nullptr);
+    bContainsTangents = (sources.pTangents != nullptr);
 
-    for (uint64 vertex_index = 0; vertex_index < mLocalBuffer.Capacity; vertex_index++) {
-        Vertex<VertexLargestType> vertex;
+    using LargestVertex = Vertex<VertexLargestType>;
 
-        memcpy(vertex.Position, &positions[vertex_index * 3], sizeof(vertex.Position));
+    const bool negate_x = (create_flags & eVertexCreateFlags::NegativeX) != 0;
 
-        if ((create_flags & eVertexCreateFlags::NegativeX) != 0) {
-            vertex.Position[0] = -vertex.Position[0];
+    // Each attribute is written as its own stream, straight into the buffer
+    WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, Position), sources.pPositions, sources.PositionStride, 3,
+                      true, negate_x);
+
+    if (IsCompact()) {
+        WriteCompactStreams(mLocalBuffer, sources, supports_skinning, negate_x);
+
+        mLocalBuffer.Size = mLocalBuffer.Capacity;
+        return;
+    }
+
+    // Write the components for a default vertex if the type supports it
+    if (supports_default) {
+        WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, Normal), sources.pNormals, sources.NormalStride, 3,
+                          bContainsNormals, negate_x);
+        WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, UV), sources.pUVs, sources.UVStride, 2,
+                          bContainsUVs);
+        WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, Tangent), sources.pTangents, sources.TangentStride,
+                          3, bContainsTangents, negate_x);
+
+        if (supports_skinning) {
+            // To support skinned vertices, we enforce that there is data available above; this means we dont need
+            // to check in WriteOrZeroStream.
+            WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, BoneIds), sources.pBoneIds, sources.BoneIdStride,
+                              4, true);
+            WriteOrZeroStream(mLocalBuffer, offsetof(LargestVertex, BoneWeights), sources.pBoneWeights,
+                              sources.BoneWeightStride, 4, true);
         }
+    }
 
-        // Write the components for a default vertex if the type supports it
-        if (supports_default) {
-            WriteOrZero<float32, 3>(vertex.Normal, normals, vertex_index, bContainsNormals);
-            WriteOrZero<float32, 2>(vertex.UV, uvs, vertex_index, bContainsUVs);
-            WriteOrZero<float32, 3>(vertex.Tangent, tangents, vertex_index, bContainsTangents);
+    mLocalBuffer.Size = mLocalBuffer.Capacity;
+}
 
-            if ((create_flags & eVertexCreateFlags::NegativeX) != 0) {
-                vertex.Normal[0] = -vertex.Normal[0];
-                vertex.Tangent[0] = -vertex.Tangent[0];
-            }
+void VertexList::WriteNormals(const SizedArray<Vec3f>& normals)
+{
+    Assert(SupportsNormals());
+    Assert(normals.Size == mLocalBuffer.Size);
 
+    constexpr uint32 cVec3Stride = sizeof(Vec3f) / sizeof(float32);
 
-            if (supports_skinning) {
-                // To support skinned vertices, we enforce that there is data available above; this means we dont need
-                // to check in WriteOrZero.
-                WriteOrZero<uint32, 4>(vertex.BoneIds, bone_ids, vertex_index, true);
-                WriteOrZero<float32, 4>(vertex.BoneWeights, bone_weights, vertex_index, true);
-            }
-        }
+    uint8* vertices = static_cast<uint8*>(mLocalBuffer.pData);
+    const float32* src = reinterpret_cast<const float32*>(normals.pData);
 
-        mLocalBuffer.InsertRaw(&vertex);
+    if (IsCompact()) {
+        VertexConvert::WriteOctahedral(vertices + offsetof(CompactVertex, Normal), mLocalBuffer.ObjectSize, src,
+                                       cVec3Stride, mLocalBuffer.Size);
+    }
+    else {
+        VertexConvert::WriteAttribute(vertices + offsetof(Vertex<VertexLargestType>, Normal), mLocalBuffer.ObjectSize,
+                                      src, cVec3Stride, 3, mLocalBuffer.Size);
     }
-}
 
+    bContainsNormals = true;
+}
 
 void VertexList::CreateSlimFrom(const SizedArray<float32>& positions, eVertexCreateFlags create_flags)
 {
@@ -13,12 +13,36 @@ enum class eVertexCreateFlags
 {
     None = 0x00,
     NegativeX = 0x01,
+    /// Creates `Compact` or `CompactSkinned` vertices instead of `Default` or `Skinned` vertices (see `eVertexType`).
+    Compact = 0x02,
 };
 
 FxEnumFlags(eVertexCreateFlags);
 
 namespace renderer {
 
+/**
+ * @brief The attribute streams to interleave into a vertex list (see `VertexList::CreateFrom()`). A stream can point
+ * into any memory, such as the buffers of a loaded model, so the attributes are not copied before they are written.
+ * Null streams are zeroed. Each stride is the number of values between elements.
+ */
+struct VertexSources
+{
+    const float32* pPositions = nullptr;
+    const float32* pNormals = nullptr;
+    const float32* pUVs = nullptr;
+    const float32* pTangents = nullptr;
+    const float32* pBoneWeights = nullptr;
+    const uint32* pBoneIds = nullptr;
+
+    uint32 PositionStride = 3;
+    uint32 NormalStride = 3;
+    uint32 UVStride = 2;
+    uint32 TangentStride = 3;
+    uint32 BoneWeightStride = 4;
+    uint32 BoneIdStride = 4;
+};
+
 class VertexList
 {
 public:
@@ -37,6 +61,12 @@ public:
                     const SizedArray<float32>& bone_weights, const SizedArray<uint32>& bone_ids,
                     eVertexCreateFlags create_flags);
 
+    /**
+     * @brief Creates `vertex_count` vertices, writing each attribute straight from its stream in `sources`. The vertex
+     * type is picked from the streams that are set, in the same way as the other overloads.
+     */
+    void CreateFrom(const VertexSources& sources, uint32 vertex_count, eVertexCreateFlags create_flags);
+
 
     template <renderer::eVertexType TVertexType>
     void CreateFrom(SizedArray<renderer::Vertex<TVertexType>>&& vertices)
@@ -52,9 +82,40 @@ public:
         mLocalBuffer.InitAsCopyOf(vertices);
     }
 
-    void UploadToGpu(CommandBuffer& cmd)
+    /**
+     * @brief Writes `normals` into the normal attribute of each vertex, in the format that the vertex type stores
+     * normals in. Used for meshes that are created without normals (see `PrimitiveMesh::RecalculateNormals()`).
+     */
+    void WriteNormals(const SizedArray<Vec3f>& normals);
+
+    void UploadToGpu(CommandBuffer& cmd) { GpuBuffer.Create(cmd, GetGpuBufferType(), mLocalBuffer); }
+
+    /**
+     * @brief Creates the GPU buffer from vertices that were copied to `offset` in `staging_buffer`.
+     */
+    void UploadFromBuffer(CommandBuffer& cmd, const RawGpuBuffer& staging_buffer, uint64 offset)
+    {
+        UploadFromBuffer(cmd, staging_buffer, offset, GetSizeInBytes());
+    }
+
+    /**
+     * @brief Creates the GPU buffer from `size` bytes of vertices at `offset` in `staging_buffer`. The local buffer is
+     * not used, so vertices can be uploaded without a CPU copy (such as from a `CookedMesh`).
+     */
+    void UploadFromBuffer(CommandBuffer& cmd, const RawGpuBuffer& staging_buffer, uint64 offset, uint64 size)
+    {
+        GpuBuffer.CreateFromBuffer(cmd, GetGpuBufferType(), staging_buffer, offset, size);
+    }
+
+    FX_FORCE_INLINE renderer::eGpuBufferType GetGpuBufferType() const
+    {
+        // Skinned vertices are also read by the skinning compute pass (see `SkinningPass`)
+        return IsSkinned() ? renderer::eGpuBufferType::VertexStorage : renderer::eGpuBufferType::VertexBuffer;
+    }
+
+    FX_FORCE_INLINE uint64 GetSizeInBytes() const
     {
-        GpuBuffer.Create(cmd, renderer::eGpuBufferType::VertexBuffer, mLocalBuffer);
+        return static_cast<uint64>(mLocalBuffer.Size) * mLocalBuffer.ObjectSize;
     }
 
     /** @brief Returns true if the vertex type supports storing normals */
@@ -63,7 +124,16 @@ public:
     /** @brief Returns true if the vertex buffer has been supplied values for normals. */
     FX_FORCE_INLINE bool HasNormals() const { return bContainsNormals; }
 
-    FX_FORCE_INLINE bool IsSkinned() const { return VertexType == renderer::eVertexType::Skinned; }
+    FX_FORCE_INLINE bool IsSkinned() const
+    {
+        return VertexType == renderer::eVertexType::Skinned || VertexType == renderer::eVertexType::CompactSkinned;
+    }
+
+    /** @brief Returns true if the vertices use the compact attribute formats (see `eVertexCreateFlags::Compact`). */
+    FX_FORCE_INLINE bool IsCompact() const
+    {
+        return VertexType == renderer::eVertexType::Compact || VertexType == renderer::eVertexType::CompactSkinned;
+    }
 
     void DestroyLocalBuffer() { mLocalBuffer.Free(); }
     void Destroy()
@@ -2,6 +2,7 @@
 
 #include <Engine.hpp>
 #include <Material/Material.hpp>
+#include <Material/MaterialManager.hpp>
 #include <Material/MaterialManagerFwd.hpp>
 #include <Object/Object.hpp>
 #include <Object/ObjectManager.hpp>
@@ -9,6 +10,8 @@
 #include <Renderer/PipelineCache.hpp>
 #include <Renderer/RenderBackend.hpp>
 #include <Renderer/ShadowDirectional.hpp>
+#include <Renderer/SkinningPass.hpp>
+#include <Texture/TextureStreamer.hpp>
 
 namespace fx {
 
@@ -30,8 +33,7 @@ static void AddObjectToRenderList(Object* object, Scene* scene)
 	if (object->pMesh.IsValid()) {
 		// const bool is_unlit = object->IsUnlit();
 
-		Material* material = MaterialManagerFwd::GetMaterial(object->GetMaterialID());
-		ePipelineName pipeline_name = material->GetRequiredPipeline();
+		ePipelineName pipeline_name = object->GetRequiredPipeline();
 
 		LogInfo("Adding Object '{}' to renderlist pipeline {}", object->Name.Get(),
 				PipelineNameUtil::GetName(pipeline_name));
@@ -133,6 +135,21 @@ PhObject* Scene::FindPhysicsObject(const Hash32 name_hash)
 }
 
 
+/**
+ * @brief Estimates the height in pixels that an object covers on screen from the sphere around its bounding box.
+ */
+static float32 GetObjectScreenSize(const Object& object, const PerspectiveCamera& camera, float32 screen_height)
+{
+	const float32 scale = object.GetScale();
+
+	const Vec3f center = object.GetPosition() + (object.Bounds.Min + object.Bounds.Max) * (0.5f * scale);
+	const float32 radius = (object.Bounds.Max - object.Bounds.Min).Length() * 0.5f * scale;
+
+	const float32 distance = std::max(center.DistanceTo(camera.Position) - radius, 0.01f);
+
+	return (radius * screen_height) / (distance * std::tan(camera.GetFovRad() * 0.5f));
+}
+
 void Scene::ExecuteRenderList(renderer::ePipelineName pl_name)
 {
 	PerspectiveCamera& camera = *mpCurrentCamera;
@@ -154,6 +171,12 @@ void Scene::ExecuteRenderList(renderer::ePipelineName pl_name)
 
 	pipeline.Bind(gRenderer->GetFrame()->CmdBuffer);
 
+	// Bindless pipelines bind the textures of all materials here, so the objects do not bind their materials
+	if (HasFlag(GetPipelineNameInfo(pl_name).Flags, ePipelineNameFlags::Bindless)) {
+		gMaterialManager->BindTextureTable(gRenderer->GetFrame()->CmdBuffer, pipeline);
+	}
+
+	const float32 screen_height = static_cast<float32>(gRenderer->GetWindow()->GetSize().Y);
 
 	uint32 index = 0;
 	while (true) {
@@ -168,6 +191,12 @@ void Scene::ExecuteRenderList(renderer::ePipelineName pl_name)
 		object->Update();
 		object->RenderShallow(camera, &pipeline);
 
+		// Stream in the mip levels of the material's textures for the size that the object is drawn at
+		if (gTextureStreamer && !object->GetMaterialID().IsNull()) {
+			Material* material = MaterialManagerFwd::GetMaterial(object->GetMaterialID());
+			gTextureStreamer->RequestForMaterial(material, GetObjectScreenSize(*object, camera, screen_height));
+		}
+
 		++index;
 	}
 }
@@ -238,6 +267,16 @@ void Scene::RebuildRenderList(bool clear, TileIndex new_tile_index)
 		CLEAR_RL_SECTION(ePipelineName::Geometry);
 		CLEAR_RL_SECTION(ePipelineName::GeometryNormalMaps);
 		CLEAR_RL_SECTION(ePipelineName::GeometrySkinned);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompact);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompactNormalMaps);
+		CLEAR_RL_SECTION(ePipelineName::GeometryPacked);
+		CLEAR_RL_SECTION(ePipelineName::GeometryPackedNormalMaps);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompactPacked);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompactPackedNormalMaps);
+		CLEAR_RL_SECTION(ePipelineName::GeometryBindless);
+		CLEAR_RL_SECTION(ePipelineName::GeometryBindlessNormalMaps);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompactBindless);
+		CLEAR_RL_SECTION(ePipelineName::GeometryCompactBindlessNormalMaps);
 		CLEAR_RL_SECTION(ePipelineName::Unlit);
 		CLEAR_RL_SECTION(ePipelineName::UnlitNormalMaps);
 	}
@@ -256,11 +295,38 @@ void Scene::RebuildRenderList(bool clear, TileIndex new_tile_index)
 		}
 
 		Object* object = gObjectManager->GetObject(*object_id);
-		Material* material = MaterialManagerFwd::GetMaterial(object->GetMaterialID());
+		const ePipelineName pipeline_name = object->GetRequiredPipeline();
+
+		LogInfo("Adding object ID {} -> {}", *object_id, PipelineNameUtil::GetName(pipeline_name));
+
+		AddToRenderListRecursive(pipeline_name, object_id);
+
+		++index;
+	}
+}
+
+void Scene::MoveObjectsToRequiredSections(ePipelineName pl_name)
+{
+	RenderListSection& section = mRenderList.GetSection(pl_name);
+
+	if (!section.InUse.IsInited()) {
+		return;
+	}
+
+	uint32 index = 0;
+	while (true) {
+		index = section.InUse.FindNextSetBit(index);
+		if (index == Bitset::scNoFreeBits) {
+			break;
+		}
 
-		LogInfo("Adding object ID {} -> {}", *object_id, PipelineNameUtil::GetName(material->GetRequiredPipeline()));
+		const ObjectID object_id = section.Objects[index];
+		const ePipelineName required_pipeline = gObjectManager->GetObject(object_id)->GetRequiredPipeline();
 
-		AddToRenderListRecursive(material->GetRequiredPipeline(), object_id);
+		if (required_pipeline != pl_name) {
+			section.InUse.Unset(index);
+			mRenderList.Add(required_pipeline, object_id);
+		}
 
 		++index;
 	}
@@ -306,9 +372,33 @@ void Scene::Render(Camera* shadow_camera)
 		light->Render(camera, shadow_camera);
 	}
 
+	// Materials that were packed since the last frame require the packed pipelines (see `TexturePacker`)
+	if (gMaterialManager->GetPackGeneration() != mMaterialPackGeneration) {
+		mMaterialPackGeneration = gMaterialManager->GetPackGeneration();
+
+		MoveObjectsToRequiredSections(ePipelineName::Geometry);
+		MoveObjectsToRequiredSections(ePipelineName::GeometryNormalMaps);
+		MoveObjectsToRequiredSections(ePipelineName::GeometryCompact);
+		MoveObjectsToRequiredSections(ePipelineName::GeometryCompactNormalMaps);
+	}
+
 	ExecuteRenderList(ePipelineName::Geometry);
 	ExecuteRenderList(ePipelineName::GeometryNormalMaps);
 	ExecuteRenderList(ePipelineName::GeometrySkinned);
+	ExecuteRenderList(ePipelineName::GeometryCompact);
+	ExecuteRenderList(ePipelineName::GeometryCompactNormalMaps);
+
+	// Packed materials that share texture arrays also share their descriptor sets
+	ExecuteRenderList(ePipelineName::GeometryPacked);
+	ExecuteRenderList(ePipelineName::GeometryPackedNormalMaps);
+	ExecuteRenderList(ePipelineName::GeometryCompactPacked);
+	ExecuteRenderList(ePipelineName::GeometryCompactPackedNormalMaps);
+
+	// Bindless materials are drawn without binding descriptor sets per object
+	ExecuteRenderList(ePipelineName::GeometryBindless);
+	ExecuteRenderList(ePipelineName::GeometryBindlessNormalMaps);
+	ExecuteRenderList(ePipelineName::GeometryCompactBindless);
+	ExecuteRenderList(ePipelineName::GeometryCompactBindlessNormalMaps);
 
 	// Render lights
 	// gRenderer->BeginLighting();
@@ -446,19 +536,17 @@ void Scene::RenderObjectShadows(Object* object)
 	memcpy(consts.CameraMatrix, gShadowRenderer->ShadowCamera.GetCameraMatrix(eObjectLayer::WorldLayer).RawData,
 		   sizeof(float32) * 16);
 
-	bool in_skinned_shader = false;
+	// Objects with compact vertices are drawn with a pipeline that only differs in the vertex stride. The pipelines have
+	// the same layout, so the descriptor sets bound in `ShadowDirectional::Begin()` stay bound, and binding the same
+	// pipeline again is skipped.
+	const bool is_compact = object->pMesh && object->pMesh->VertexList.IsCompact();
 
-	Pipeline& pipeline = gPipelineCache->Request(ePipelineName::ShadowDirectional);
+	Pipeline& pipeline = gPipelineCache->Request(is_compact ? ePipelineName::ShadowDirectionalCompact
+														   : ePipelineName::ShadowDirectional);
 
 	CommandBuffer& cmd = gRenderer->GetFrame()->CmdBuffer;
 
-	if (in_skinned_shader && !object->IsSkinned()) {
-		in_skinned_shader = false;
-		pipeline.Bind(cmd);
-
-		gObjectManager->pDescriptorSet->BindWithOffset(0, cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline,
-													   gObjectManager->GetBaseOffset());
-	}
+	pipeline.Bind(cmd);
 
 	object->Update();
 
@@ -474,6 +562,26 @@ void Scene::RenderObjectShadows(Object* object)
 }
 
 
+static void SkinObjectVertices(Object* object)
+{
+	object->SkinVertices();
+
+	for (const ObjectID& attached : object->AttachedNodes) {
+		SkinObjectVertices(gObjectManager->GetObject(attached));
+	}
+}
+
+void Scene::RenderSkinning()
+{
+	gSkinningPass->Begin();
+
+	for (const ObjectID& object_id : mObjects) {
+		SkinObjectVertices(gObjectManager->GetObject(object_id));
+	}
+
+	gSkinningPass->End();
+}
+
 void Scene::RenderShadows(Camera* shadow_camera)
 {
 	gShadowRenderer->Begin();
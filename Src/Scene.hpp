@@ -37,6 +37,12 @@ public:
 	void Render(Camera* shadow_camera);
 	void RenderShadows(Camera* shadow_camera);
 
+	/**
+	 * @brief Skins each skinned object in the scene for this frame (see `renderer::SkinningPass`). This is recorded
+	 * before the shadow and geometry passes, which then draw the skinned vertices as static geometry.
+	 */
+	void RenderSkinning();
+
 	const PagedArray<ObjectID>& GetAllObjects() { return mObjects; }
 	const PagedArray<Ref<LightBase>>& GetAllLights() { return mLights; }
 
@@ -75,6 +81,12 @@ private:
 	void RebuildRenderList(bool clear, TileIndex new_tile);
 	void AddToRenderListRecursive(renderer::ePipelineName pl_name, ObjectID* id);
 
+	/**
+	 * @brief Moves the objects in the `pl_name` section of the render list that now require a different pipeline, such
+	 * as objects with materials that have been packed.
+	 */
+	void MoveObjectsToRequiredSections(renderer::ePipelineName pl_name);
+
 	void RebuildFromTiles(TileIndex tile_index);
 
 public:
@@ -93,6 +105,9 @@ private:
 	PhObjectId mSelectedPhysicsObjectId = PhObjectIdNull;
 
 	Ref<PrimitiveMesh> mpDebugCube { nullptr };
+
+	/// The value of `MaterialManager::GetPackGeneration()` when the render list was last updated.
+	uint32 mMaterialPackGeneration = 0;
 };
 
 } // namespace fx
@@ -96,7 +96,7 @@ void FoxAstPrinter::Print(FoxAstNode* node, int depth)
             functioncall->pFunction->Name->PrintBasic(true);
         }
 
-        printf(" (%zu params)\n", functioncall->Params.size());
+        printf(" (%u params)\n", functioncall->Params.Size());
     }
     else if (node->NodeType == FX_AST_LITERAL) {
         FoxAstLiteral* literal = static_cast<FoxAstLiteral*>(node);
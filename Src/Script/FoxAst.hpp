@@ -2,6 +2,7 @@
 
 #include "FoxValue.hpp"
 
+#include <Core/Arena.hpp>
 #include <Core/Path.hpp>
 #include <Core/Types.hpp>
 #include <Util/Tokenizer.hpp>
@@ -67,9 +68,9 @@ struct FoxAstBinop : public FoxAstNode
 
 struct FoxAstBlock : public FoxAstNode
 {
-    FoxAstBlock() { this->NodeType = FX_AST_BLOCK; }
+    FoxAstBlock(Arena* arena) : Statements(arena) { this->NodeType = FX_AST_BLOCK; }
 
-    std::vector<FoxAstNode*> Statements;
+    ArenaArray<FoxAstNode*> Statements;
 
     bool bHasExplicitReturn = false;
 };
@@ -144,14 +145,14 @@ struct FoxAstCommandMode : public FoxAstNode
 
 struct FoxAstFunctionCall : public FoxAstNode
 {
-    FoxAstFunctionCall() { this->NodeType = FX_AST_PROCCALL; }
+    FoxAstFunctionCall(Arena* arena) : Params(arena) { this->NodeType = FX_AST_PROCCALL; }
 
     eFoxType GetReturnType() const;
     bool HasReturnType() const;
 
     FoxFunction* pFunction = nullptr;
     Hash32 HashedName = HashNull32;
-    std::vector<FoxAstNode*> Params {}; // FoxAstLiteral or FoxAstVarRef
+    ArenaArray<FoxAstNode*> Params; // FoxAstLiteral or FoxAstVarRef
 };
 
 struct FoxAstModuleLoad : public FoxAstNode
@@ -209,23 +210,6 @@ public:
     // FoxAstBlock* mRootBlock = nullptr;
 };
 
-
-//////////////////////////////////
-// Script AST Destroyer
-//////////////////////////////////
-
-class FoxAstDestroyer
-{
-public:
-    FoxAstDestroyer() = default;
-    FoxAstDestroyer(FoxAstBlock* root_block) { Do(root_block); }
-
-    void Do(FoxAstNode* node);
-
-public:
-    // FoxAstBlock* mRootBlock = nullptr;
-};
-
 } // namespace script
 
 } // namespace fx
@@ -0,0 +1,714 @@
+#include "FoxBenchmark.hpp"
+
+#include "FoxAst.hpp"
+#include "FoxBytecodeCompiler.hpp"
+#include "FoxParser.hpp"
+#include "FoxVM.hpp"
+
+#include <Core/Arena.hpp>
+#include <Core/File.hpp>
+#include <Core/FilesystemIO.hpp>
+#include <Core/Log.hpp>
+#include <Core/MemPool/MemPool.hpp>
+#include <Engine.hpp>
+#include <Util/Tokenizer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace fx::script {
+
+static std::string GenerateBenchmarkSource(uint32 num_procs, uint32* out_line_count)
+{
+	std::string source;
+	source.reserve(static_cast<size_t>(num_procs) * 192);
+
+	uint32 line_count = 0;
+
+	for (uint32 i = 0; i < num_procs; i++) {
+		const std::string index = std::to_string(i);
+
+		source += "Proc" + index + "(int a, int b) int\n";
+		source += "{\n";
+		source += "    local int x = a + b * " + index + ";\n";
+		source += "    local int y = x - a;\n";
+		source += "    local float z = 1.5;\n";
+		source += "    x = y * 2 + x;\n";
+		source += "    return x + y;\n";
+		source += "}\n\n";
+
+		line_count += 8;
+	}
+
+	(*out_line_count) = line_count;
+
+	return source;
+}
+
+/// The size of the benchmark's pool for each byte of source. The tokens and AST take several times the size of the
+/// source, and the token array leaves its old storage in the arena each time it grows. The peak usage is logged.
+static constexpr uint64 scCompilePoolBytesPerSourceByte = 64;
+static constexpr uint64 scCompilePoolMinSize = 16ULL * 1024 * 1024;
+
+void FoxBenchmarkCompile(uint32 num_procs, uint32 iterations)
+{
+	using Clock = std::chrono::steady_clock;
+
+	uint32 line_count = 0;
+	const std::string source = GenerateBenchmarkSource(num_procs, &line_count);
+
+	// The generated script is much larger than any script the engine loads, so it is compiled from its own pool
+	// instead of the fixed size script pool
+	const uint64 pool_size = std::max(scCompilePoolMinSize, source.size() * scCompilePoolBytesPerSourceByte);
+
+	MemPool pool;
+	pool.Create(pool_size);
+
+	double best_front_end = 0.0;
+	double best_total = 0.0;
+
+	uint64 peak_arena_bytes = 0;
+	uint64 peak_arena_capacity = 0;
+
+	for (uint32 iteration = 0; iteration < iterations; iteration++) {
+		Arena arena(&pool);
+
+		const auto start_time = Clock::now();
+
+		// Copy the source into the arena as FoxScript::Compile() does with the file data
+		char* source_data = arena.CopyString(source.data(), source.size());
+
+		Tokenizer tokenizer(source_data, static_cast<uint32>(source.size()), &arena);
+		tokenizer.Tokenize();
+
+		FoxParser parser {};
+		parser.Init(&arena, tokenizer.ArenaTokens);
+
+		FoxAstNode* root_node = parser.Parse();
+
+		const auto parse_end_time = Clock::now();
+
+		if (parser.bHasErrors || root_node == nullptr) {
+			LogError(LC_SCRIPT, "Errors found while parsing benchmark script");
+			return;
+		}
+
+		FoxBytecodeCompiler compiler {};
+		compiler.Compile(root_node);
+
+		const auto end_time = Clock::now();
+
+		const double front_end = std::chrono::duration<double>(parse_end_time - start_time).count();
+		const double total = std::chrono::duration<double>(end_time - start_time).count();
+
+		if (iteration == 0 || front_end < best_front_end) {
+			best_front_end = front_end;
+		}
+		if (iteration == 0 || total < best_total) {
+			best_total = total;
+		}
+
+		peak_arena_bytes = std::max(peak_arena_bytes, arena.GetBytesUsed());
+		peak_arena_capacity = std::max(peak_arena_capacity, arena.GetCapacity());
+	}
+
+	LogInfo(LC_SCRIPT, "Compile benchmark: {} lines, best of {} iterations", line_count, iterations);
+	LogInfo(LC_SCRIPT, "    Tokenize + parse: {:.3f} ms ({:.0f} lines/s)", best_front_end * 1000.0,
+			line_count / best_front_end);
+	LogInfo(LC_SCRIPT, "    Full compile:     {:.3f} ms ({:.0f} lines/s)", best_total * 1000.0, line_count / best_total);
+	LogInfo(LC_SCRIPT, "    Arena peak:       {} bytes used, {} bytes in chunks, {} byte pool ({:.1f}% used)",
+			peak_arena_bytes, peak_arena_capacity, pool_size,
+			100.0 * static_cast<double>(peak_arena_capacity) / static_cast<double>(pool_size));
+}
+
+///////////////////////////////////////////
+// JIT
+///////////////////////////////////////////
+
+// Every proc takes two ints, so they can all be called the same way
+static constexpr const char* scJitCorpusSource = R"(
+AddMul(int a, int b) int
+{
+    local int x = a + b * 3;
+    local int y = x * 2 + a;
+    x = y * x + b;
+    return x + y;
+}
+
+Select(int a, int b) int
+{
+    if (a < b) {
+        return a * 2;
+    }
+    if (a == b) {
+        return 7;
+    }
+    return b + a * a;
+}
+
+SumTo(int i, int n) int
+{
+    if (i >= n) {
+        return 0;
+    }
+    return i * i + SumTo(i + 1, n);
+}
+
+Blend(int a, int b) float
+{
+    local float fa = castfloat(a);
+    local float fb = castfloat(b);
+    return fa * 0.25 + fb * 0.75;
+}
+
+Truncate(int a, int b) int
+{
+    return castint(Blend(a, b) * 3.5);
+}
+
+Spin(int a, int b) vec3
+{
+    local vec3 p = vec3(castfloat(a), 1.0, castfloat(b));
+    local quat q = quat(vec3(0.0, 1.0, 0.0), 0.5);
+    return rotate(q, p) + cross(p, vec3(0.0, 0.0, 1.0));
+}
+
+Project(int a, int b) float
+{
+    local vec3 p = Spin(a, b);
+    return dot(p, normalize(vec3(1.0, 2.0, 3.0))) + getx(p);
+}
+)";
+
+static constexpr const char* scJitCorpusProcs[] = { "AddMul", "Select", "SumTo", "Blend", "Truncate", "Spin", "Project" };
+
+/// Arguments are kept small, as `SumTo` recurses once per step.
+static constexpr int32 scJitMaxArg = 8;
+
+static FoxValue CallCorpusProc(FoxVM& vm, uint32 proc_offset, int32 a, int32 b)
+{
+	// Same as FoxScript::CallProc()
+	vm.PushReturnAddr(0);
+
+	++vm.ScopeIndex;
+	vm.PC = proc_offset;
+
+	vm.Push32(eFoxType::INT, static_cast<uint32>(a));
+	vm.Push32(eFoxType::INT, static_cast<uint32>(b));
+
+	return vm.Resume();
+}
+
+/**
+ * Compiles a test script in the same way as `FoxScript::Compile()`. Errors are logged with `test_name`.
+ */
+static bool CompileTestSource(const char* source, const char* test_name, SizedArray<uint8>& out_bytecode)
+{
+	Arena arena(gScriptMemPool);
+
+	const uint64 source_size = strlen(source);
+	char* source_data = arena.CopyString(source, source_size);
+
+	Tokenizer tokenizer(source_data, static_cast<uint32>(source_size), &arena);
+	tokenizer.Tokenize();
+
+	FoxParser parser {};
+	parser.Init(&arena, tokenizer.ArenaTokens);
+
+	FoxAstNode* root_node = parser.Parse();
+	if (parser.bHasErrors || root_node == nullptr) {
+		LogError(LC_SCRIPT, "{}: Errors found while parsing the test script", test_name);
+		return false;
+	}
+
+	FoxBytecodeCompiler compiler {};
+	out_bytecode = compiler.Compile(root_node);
+
+	if (compiler.HasErrors()) {
+		LogError(LC_SCRIPT, "{}: Errors found while compiling the test script", test_name);
+		return false;
+	}
+
+	return true;
+}
+
+static bool IsSameResult(const FoxValue& a, const FoxValue& b)
+{
+	if (a.Type != b.Type) {
+		return false;
+	}
+
+	if (a.IsVector()) {
+		return memcmp(a.ValueVec, b.ValueVec, sizeof(a.ValueVec)) == 0;
+	}
+
+	return a.AsUInt() == b.AsUInt();
+}
+
+static bool IsSameState(const FoxVM& a, const FoxVM& b)
+{
+	return a.StackPointer == b.StackPointer && a.CallStackPointer == b.CallStackPointer &&
+		   a.ScopeIndex == b.ScopeIndex && a.VariableIndex == b.VariableIndex && a.PC == b.PC;
+}
+
+bool FoxBenchmarkJit(uint32 iterations)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (!FoxJit::IsSupported()) {
+		LogWarning(LC_SCRIPT, "JIT benchmark: The JIT is not supported on this platform");
+		return true;
+	}
+
+	SizedArray<uint8> bytecode;
+
+	if (!CompileTestSource(scJitCorpusSource, "JIT benchmark", bytecode)) {
+		return false;
+	}
+
+	FoxVM interpreter_vm;
+	interpreter_vm.InitVM(SizedArray<uint8>::Clone(bytecode), nullptr);
+
+	FoxVM jit_vm;
+	jit_vm.InitVM(std::move(bytecode), nullptr);
+
+	// Compile every proc on its first call
+	jit_vm.EnableJit(0);
+
+	FoxVMContextPool& context_pool = FoxVMContextPool::GetInstance();
+
+	FoxVMContext* interpreter_context = context_pool.Acquire();
+	FoxVMContext* jit_context = context_pool.Acquire();
+
+	interpreter_vm.AttachContext(interpreter_context);
+	jit_vm.AttachContext(jit_context);
+
+	uint32 num_mismatches = 0;
+	uint32 num_calls = 0;
+
+	// Check the results for every proc and argument pair
+	for (const char* proc_name : scJitCorpusProcs) {
+		const uint32 proc_offset = interpreter_vm.GetProcAddr(HashStr32(proc_name));
+
+		for (int32 a = 0; a < scJitMaxArg; a++) {
+			for (int32 b = 0; b < scJitMaxArg; b++) {
+				const FoxValue expected = CallCorpusProc(interpreter_vm, proc_offset, a, b);
+				const FoxValue result = CallCorpusProc(jit_vm, proc_offset, a, b);
+
+				++num_calls;
+
+				if (IsSameResult(expected, result) && IsSameState(interpreter_vm, jit_vm)) {
+					continue;
+				}
+
+				LogError(LC_SCRIPT, "JIT benchmark: {}({}, {}) returned {}, expected {}", proc_name, a, b, result,
+						 expected);
+				++num_mismatches;
+			}
+		}
+	}
+
+	LogInfo(LC_SCRIPT, "JIT benchmark: {} of {} calls matched the interpreter ({} procs compiled)",
+			num_calls - num_mismatches, num_calls, jit_vm.GetJit()->GetNumCompiledProcs());
+
+	auto time_calls = [&](FoxVM& vm)
+	{
+		const auto start_time = Clock::now();
+
+		for (uint32 iteration = 0; iteration < iterations; iteration++) {
+			for (const char* proc_name : scJitCorpusProcs) {
+				const uint32 proc_offset = vm.GetProcAddr(HashStr32(proc_name));
+				CallCorpusProc(vm, proc_offset, static_cast<int32>(iteration % scJitMaxArg), 3);
+			}
+		}
+
+		const double seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+		const uint64 total_calls = static_cast<uint64>(iterations) * std::size(scJitCorpusProcs);
+
+		return (seconds * 1.0e9) / total_calls;
+	};
+
+	const double interpreter_ns = time_calls(interpreter_vm);
+	const double jit_ns = time_calls(jit_vm);
+
+	LogInfo(LC_SCRIPT, "    Interpreter: {:.1f} ns/call", interpreter_ns);
+	LogInfo(LC_SCRIPT, "    JIT:         {:.1f} ns/call ({:.2f}x)", jit_ns, interpreter_ns / jit_ns);
+
+	interpreter_vm.DetachContext();
+	jit_vm.DetachContext();
+
+	context_pool.Release(interpreter_context);
+	context_pool.Release(jit_context);
+
+	return (num_mismatches == 0);
+}
+
+///////////////////////////////////////////
+// JIT script corpus
+///////////////////////////////////////////
+
+struct FoxTestProc
+{
+	std::string Name;
+	std::vector<eFoxType> ParamTypes;
+};
+
+/// The number of times each proc is called, with a different set of arguments each time.
+static constexpr uint32 scJitScriptCalls = 5;
+
+/// Pauses are resumed straight away, up to this many times per call.
+static constexpr uint32 scJitScriptMaxResumes = 16;
+
+/**
+ * Compiles the script at `path` in the same way as `FoxScript::Compile()`, without writing the bytecode, header or
+ * cache files. The procs defined in the script are written to `out_procs`.
+ */
+static bool CompileTestScript(const std::string& path, SizedArray<uint8>& out_bytecode,
+							  std::vector<FoxTestProc>& out_procs)
+{
+	File file(String(path), File::eModType::Read, File::eDataType::Binary);
+
+	if (!file.IsFileOpen()) {
+		LogError(LC_SCRIPT, "JIT script test: Could not open '{}'", path);
+		return false;
+	}
+
+	Arena arena(gScriptMemPool);
+
+	const uint64 file_size = file.GetFileSize();
+	Slice<char> file_data = file.Read(MakeSlice(arena.AllocArray<char>(file_size), file_size));
+
+	Tokenizer tokenizer(file_data.pData, file_data.Size, &arena);
+	tokenizer.SetFileExtension(".fox");
+	tokenizer.Tokenize();
+
+	FoxParser parser {};
+	parser.Init(&arena, tokenizer.ArenaTokens);
+
+	FoxAstNode* root_node = parser.Parse();
+
+	if (parser.bHasErrors || root_node == nullptr) {
+		LogError(LC_SCRIPT, "JIT script test: Errors found while parsing '{}'", path);
+		return false;
+	}
+
+	FoxBytecodeCompiler compiler {};
+	out_bytecode = compiler.Compile(root_node);
+
+	if (compiler.HasErrors()) {
+		LogError(LC_SCRIPT, "JIT script test: Errors found while compiling '{}'", path);
+		return false;
+	}
+
+	for (FoxAstNode* stmt : static_cast<FoxAstBlock*>(root_node)->Statements) {
+		if (stmt->NodeType != FX_AST_PROCDECL) {
+			continue;
+		}
+
+		FoxAstFunctionDecl* proc_decl = static_cast<FoxAstFunctionDecl*>(stmt);
+
+		if (!proc_decl->IsDefinition() || proc_decl->bIsExternal) {
+			continue;
+		}
+
+		FoxTestProc proc { .Name = proc_decl->pNameToken->GetStr() };
+
+		for (FoxAstNode* param_node : proc_decl->pParams->Statements) {
+			const FoxAstVarDecl* param = static_cast<FoxAstVarDecl*>(param_node);
+			proc.ParamTypes.push_back(param->bIsPointer ? eFoxType::REF : param->Type);
+		}
+
+		out_procs.push_back(std::move(proc));
+	}
+
+	return true;
+}
+
+static bool CanMakeTestArg(eFoxType type)
+{
+	return type == eFoxType::INT || type == eFoxType::FLOAT || FoxIsVectorType(type);
+}
+
+/**
+ * Returns the argument of `type` for the call `index`. Quaternions are normalized.
+ */
+static FoxValue MakeTestArg(eFoxType type, uint32 index)
+{
+	static constexpr int32 scInts[] = { 0, 1, 3, -2, 7 };
+	static constexpr float32 scFloats[] = { 0.0f, 0.5f, -1.25f, 3.0f, 10.0f };
+
+	constexpr uint32 cNumInts = std::size(scInts);
+	constexpr uint32 cNumFloats = std::size(scFloats);
+
+	if (type == eFoxType::INT) {
+		return FoxValue(scInts[index % cNumInts]);
+	}
+
+	if (type == eFoxType::FLOAT) {
+		return FoxValue(scFloats[index % cNumFloats]);
+	}
+
+	FoxValue value {};
+	value.Type = type;
+
+	float32 length_sq = 0.0f;
+
+	for (uint32 component = 0; component < 4; component++) {
+		value.ValueVec[component] = scFloats[(index + component) % cNumFloats];
+		length_sq += value.ValueVec[component] * value.ValueVec[component];
+	}
+
+	if (type == eFoxType::VEC3) {
+		value.ValueVec[3] = 0.0f;
+	}
+	else if (type == eFoxType::QUAT) {
+		const float32 inv_length = 1.0f / std::sqrt(length_sq);
+
+		for (float32& component : value.ValueVec) {
+			component *= inv_length;
+		}
+	}
+
+	return value;
+}
+
+static FoxValue CallTestProc(FoxVM& vm, uint32 proc_offset, const std::vector<FoxValue>& args)
+{
+	// Same as FoxScript::CallProc()
+	vm.PushReturnAddr(0);
+
+	++vm.ScopeIndex;
+	vm.PC = proc_offset;
+
+	for (const FoxValue& arg : args) {
+		if (arg.IsVector()) {
+			vm.PushVector(arg.Type, arg.ValueVec);
+		}
+		else {
+			vm.Push32(arg.Type, arg.AsUInt());
+		}
+	}
+
+	FoxValue result = vm.Resume();
+
+	for (uint32 resume = 0; resume < scJitScriptMaxResumes && vm.bIsPaused; resume++) {
+		result = vm.Resume();
+	}
+
+	return result;
+}
+
+bool FoxTestJitScripts(const char* script_dir)
+{
+	if (!FoxJit::IsSupported()) {
+		LogWarning(LC_SCRIPT, "JIT script test: The JIT is not supported on this platform");
+		return true;
+	}
+
+	std::vector<std::string> file_names;
+
+	for (const std::string& file_name : FilesystemIO::DirList(script_dir, ".fox")) {
+		file_names.push_back(file_name);
+	}
+
+	std::sort(file_names.begin(), file_names.end());
+
+	FoxVMContextPool& context_pool = FoxVMContextPool::GetInstance();
+
+	bool passed = true;
+
+	uint32 num_calls = 0;
+	uint32 num_mismatches = 0;
+	uint32 num_skipped = 0;
+
+	for (const std::string& file_name : file_names) {
+		const std::string path = std::string(script_dir) + "/" + file_name;
+
+		SizedArray<uint8> bytecode;
+		std::vector<FoxTestProc> procs;
+
+		if (!CompileTestScript(path, bytecode, procs)) {
+			passed = false;
+			continue;
+		}
+
+		FoxVM interpreter_vm;
+		interpreter_vm.InitVM(SizedArray<uint8>::Clone(bytecode), nullptr);
+
+		// Both JIT VMs share one JIT, as scripts loaded from the same file do. They take turns making the first call,
+		// so half of the procs are compiled by one VM and run by the other.
+		Ref<FoxJit> jit = Ref<FoxJit>::New(0);
+
+		FoxVM jit_vms[2];
+		jit_vms[0].InitVM(SizedArray<uint8>::Clone(bytecode), nullptr);
+		jit_vms[1].InitVM(std::move(bytecode), nullptr);
+
+		FoxVM* vms[] = { &interpreter_vm, &jit_vms[0], &jit_vms[1] };
+		FoxVMContext* contexts[std::size(vms)];
+
+		for (uint32 index = 0; index < std::size(vms); index++) {
+			contexts[index] = context_pool.Acquire();
+			vms[index]->AttachContext(contexts[index]);
+
+			if (index > 0) {
+				vms[index]->EnableJit(jit);
+			}
+		}
+
+		for (uint32 proc_index = 0; proc_index < procs.size(); proc_index++) {
+			const FoxTestProc& proc = procs[proc_index];
+
+			if (!std::all_of(proc.ParamTypes.begin(), proc.ParamTypes.end(), CanMakeTestArg)) {
+				LogInfo(LC_SCRIPT, "JIT script test: Skipping {}:{}(), it takes a string or pointer", file_name,
+						proc.Name);
+				++num_skipped;
+				continue;
+			}
+
+			const uint32 proc_offset = interpreter_vm.GetProcAddr(HashStr32(proc.Name.c_str()));
+
+			for (uint32 call = 0; call < scJitScriptCalls; call++) {
+				std::vector<FoxValue> args;
+
+				for (uint32 param = 0; param < proc.ParamTypes.size(); param++) {
+					args.push_back(MakeTestArg(proc.ParamTypes[param], call + param));
+				}
+
+				const FoxValue expected = CallTestProc(interpreter_vm, proc_offset, args);
+
+				for (uint32 turn = 0; turn < 2; turn++) {
+					FoxVM& jit_vm = jit_vms[(proc_index + turn) % 2];
+
+					const FoxValue result = CallTestProc(jit_vm, proc_offset, args);
+
+					++num_calls;
+
+					if (IsSameResult(expected, result) && IsSameState(interpreter_vm, jit_vm)) {
+						continue;
+					}
+
+					LogError(LC_SCRIPT, "JIT script test: {}:{}() call {} returned {}, expected {}", file_name,
+							 proc.Name, call, result, expected);
+					++num_mismatches;
+				}
+			}
+		}
+
+		LogInfo(LC_SCRIPT, "JIT script test: {} ({} procs, {} compiled)", file_name, procs.size(),
+				jit->GetNumCompiledProcs());
+
+		for (uint32 index = 0; index < std::size(vms); index++) {
+			vms[index]->DetachContext();
+			context_pool.Release(contexts[index]);
+		}
+	}
+
+	LogInfo(LC_SCRIPT, "JIT script test: {} of {} calls over {} scripts matched the interpreter ({} procs skipped)",
+			num_calls - num_mismatches, num_calls, file_names.size(), num_skipped);
+
+	return passed && (num_mismatches == 0);
+}
+
+///////////////////////////////////////////
+// Vector ops
+///////////////////////////////////////////
+
+static constexpr const char* scQuatRotateSource = R"(
+RotateY(int a, int b) vec3
+{
+    local quat q = quat(vec3(0.0, 1.0, 0.0), castfloat(a) * 0.5);
+    return rotate(q, vec3(1.0, 2.0, castfloat(b)));
+}
+)";
+
+/// Largest difference allowed between a component and the double precision result.
+static constexpr float64 scQuatRotateTolerance = 1.0e-5;
+
+static bool CheckQuatRotate(FoxVM& vm, const char* mode_name)
+{
+	const uint32 proc_offset = vm.GetProcAddr(HashStr32("RotateY"));
+	bool passed = true;
+
+	for (int32 a = 0; a < scJitMaxArg; a++) {
+		for (int32 b = 0; b < 4; b++) {
+			const FoxValue result = CallCorpusProc(vm, proc_offset, a, b);
+
+			// `rotate(q, v)` computes conj(q) * v * q, which rotates `v` by the inverse of `q`
+			const float64 angle = static_cast<float64>(a) * 0.5;
+			const float64 x = 1.0;
+			const float64 z = static_cast<float64>(b);
+
+			const float64 expected[3] = {
+				x * std::cos(angle) - z * std::sin(angle),
+				2.0,
+				x * std::sin(angle) + z * std::cos(angle),
+			};
+
+			bool matches = (result.Type == eFoxType::VEC3);
+
+			for (uint32 component = 0; component < 3 && matches; component++) {
+				matches = std::fabs(result.ValueVec[component] - expected[component]) <= scQuatRotateTolerance;
+			}
+
+			if (matches) {
+				continue;
+			}
+
+			LogError(LC_SCRIPT, "QuatRotate test ({}): RotateY({}, {}) returned {}, expected ({}, {}, {})", mode_name, a,
+					 b, result, expected[0], expected[1], expected[2]);
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+bool FoxTestQuatRotate()
+{
+	SizedArray<uint8> bytecode;
+
+	if (!CompileTestSource(scQuatRotateSource, "QuatRotate test", bytecode)) {
+		return false;
+	}
+
+	FoxVMContextPool& context_pool = FoxVMContextPool::GetInstance();
+
+	FoxVM interpreter_vm;
+	FoxVM jit_vm;
+
+	const bool use_jit = FoxJit::IsSupported();
+
+	if (use_jit) {
+		jit_vm.InitVM(SizedArray<uint8>::Clone(bytecode), nullptr);
+		jit_vm.EnableJit(0);
+	}
+
+	interpreter_vm.InitVM(std::move(bytecode), nullptr);
+
+	FoxVMContext* interpreter_context = context_pool.Acquire();
+	interpreter_vm.AttachContext(interpreter_context);
+
+	bool passed = CheckQuatRotate(interpreter_vm, "interpreter");
+
+	interpreter_vm.DetachContext();
+	context_pool.Release(interpreter_context);
+
+	if (use_jit) {
+		FoxVMContext* jit_context = context_pool.Acquire();
+		jit_vm.AttachContext(jit_context);
+
+		passed &= CheckQuatRotate(jit_vm, "JIT");
+
+		jit_vm.DetachContext();
+		context_pool.Release(jit_context);
+	}
+
+	LogInfo(LC_SCRIPT, "QuatRotate test {}", passed ? "passed" : "failed");
+
+	return passed;
+}
+
+} // namespace fx::script
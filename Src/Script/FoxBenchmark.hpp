@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+namespace fx::script {
+
+/**
+ * @brief Measures compile throughput over a generated script, and logs the results in lines per second.
+ *
+ * The generated script contains `num_procs` procedures of local declarations and arithmetic. The tokenizer and parser
+ * are timed on their own, and again with bytecode generation (which includes the compiler's bytecode dump). Each
+ * iteration uses a fresh arena which is released in one go afterwards, as in `FoxScript::Compile()`.
+ *
+ * The default script does not fit in the script pool, so the arenas are allocated from a pool sized for the script.
+ * The peak arena usage is logged with the results.
+ */
+void FoxBenchmarkCompile(uint32 num_procs = 4096, uint32 iterations = 8);
+
+/**
+ * @brief Runs a corpus of test procs in the interpreter and with the JIT, comparing the result and VM state after every
+ * call, and logs the time per call in each mode.
+ *
+ * The corpus covers arithmetic, branches, recursion, casts and vector ops. Each proc is called with a range of
+ * arguments, and the JIT compiles every proc on its first call.
+ *
+ * @returns False if the JIT gave a different result than the interpreter for any call.
+ */
+bool FoxBenchmarkJit(uint32 iterations = 2000);
+
+/**
+ * @brief Compiles every script in `script_dir`, and calls each proc defined in them in the interpreter and with the JIT,
+ * comparing the result and VM state after every call.
+ *
+ * Two VMs share the JIT for each script, as instances of a script loaded from the same file do, so procs compiled by one
+ * VM are also run by the other. Each proc is called with a few sets of int, float and vector arguments, and procs that
+ * take strings or pointers are skipped.
+ *
+ * @returns False if a script could not be compiled, or the JIT gave a different result than the interpreter for any call.
+ */
+bool FoxTestJitScripts(const char* script_dir = "Scripts");
+
+/**
+ * @brief Runs a script that rotates vectors with `rotate(quat, vec3)` in the interpreter, and with the JIT if it is
+ * supported, and checks each rotated vector against a double precision reference.
+ *
+ * @returns False if any rotated vector differs from the reference.
+ */
+bool FoxTestQuatRotate();
+
+} // namespace fx::script
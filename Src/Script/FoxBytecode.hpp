@@ -4,6 +4,12 @@
 
 namespace fx::script {
 
+/**
+ * @brief Version of the bytecode format and code generation. This is part of the bytecode cache key, so any change to
+ * the instruction encoding or to what the compiler emits must bump this to invalidate previously cached scripts.
+ */
+static constexpr uint32 scFoxBytecodeVersion = 2;
+
 enum FoxBytecodeBase : uint8
 {
     BcBase_Push = 1,
@@ -19,6 +25,7 @@ enum FoxBytecodeBase : uint8
     BcBase_Compare,
 
     BcBase_Variable,
+    BcBase_Vector,
 };
 
 enum BcSpecCompare : uint8
@@ -88,6 +95,10 @@ enum BcSpecJump : uint8
     BcSpecJump_Pause,
 
     BcSpecJump_CallExternal,
+
+    BcSpecJump_ReturnToCaller_Vec3,
+    BcSpecJump_ReturnToCaller_Vec4,
+    BcSpecJump_ReturnToCaller_Quat,
 };
 
 enum BcSpecData : uint8
@@ -151,6 +162,47 @@ enum BcSpecVariable : uint8
     BcSpecVariable_SetPtr_Float32,
     BcSpecVariable_SetPtr_String,
     BcSpecVariable_SetPtr_Var,
+
+    // Vector variables are followed by the 16-bit vector type
+    BcSpecVariable_Define_Vector,
+    BcSpecVariable_DefineGlobal_Vector,
+    BcSpecVariable_DefineFetchParam_Vector,
+};
+
+/**
+ * @brief Vector ops. Vectors take up 16 bytes (four slots) on the stack, with the components stored in order. Vec3
+ * values have a zero fourth component.
+ */
+enum BcSpecVector : uint8
+{
+    BcSpecVector_PushVar = 1,   // VPUSHV [%var]
+    BcSpecVector_PopVar,        // VPOPV  [%var]
+    BcSpecVector_Discard,       // DISCARDV
+
+    BcSpecVector_Make3,         // MKVEC3      [f32 f32 f32]
+    BcSpecVector_Make4,         // MKVEC4      [f32 f32 f32 f32]
+    BcSpecVector_MakeQuat,      // MKQUAT      [f32 f32 f32 f32]
+    BcSpecVector_QuatAxisAngle, // MKQUATAXIS  [vec3 f32]
+
+    BcSpecVector_Add,           // ADDV   [vec vec]
+    BcSpecVector_Sub,           // SUBV   [vec vec]
+    BcSpecVector_Mul,           // MULV   [vec vec]
+    BcSpecVector_Scale,         // SCALEV [vec f32]
+
+    BcSpecVector_Dot3,          // DOT3   [vec3 vec3]
+    BcSpecVector_Dot4,          // DOT4   [vec4 vec4]
+    BcSpecVector_Cross,         // CROSS  [vec3 vec3]
+    BcSpecVector_Normalize3,    // NORM3  [vec3]
+    BcSpecVector_Normalize4,    // NORM4  [vec4|quat]
+
+    BcSpecVector_QuatMul,       // MULQ    [quat quat]
+    BcSpecVector_QuatRotate,    // ROTQ    [quat vec3]
+    BcSpecVector_QuatSLerp,     // SLERPQ  [quat quat f32]
+
+    BcSpecVector_GetX,          // GETX [vec]
+    BcSpecVector_GetY,          // GETY [vec]
+    BcSpecVector_GetZ,          // GETZ [vec]
+    BcSpecVector_GetW,          // GETW [vec]
 };
 
 } // namespace fx::script
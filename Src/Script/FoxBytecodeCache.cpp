@@ -0,0 +1,332 @@
+#include "FoxBytecodeCache.hpp"
+
+#include "FoxBytecode.hpp"
+
+#include <Asset/DataPack.hpp>
+#include <Core/File.hpp>
+#include <Core/MemPool/MemPool.hpp>
+#include <Core/Path.hpp>
+#include <Core/RefUtil.hpp>
+#include <Core/String.hpp>
+#include <cstring>
+
+namespace fx::script {
+
+/*
+ * CACHE ENTRY
+ *      DEPENDENCY COUNT (4 bytes)
+ *      DEPENDENCY 1
+ *      - TYPE         (1 byte)
+ *      - CONTENT HASH (8 bytes)
+ *      - PATH LENGTH  (2 bytes)
+ *      - PATH         (PATH LENGTH bytes)
+ *      DEPENDENCY N
+ *      BYTECODE SIZE  (4 bytes)
+ *      BYTECODE
+ */
+
+static String GetCachePath(const String& script_path)
+{
+	Path cache_path(script_path);
+	cache_path.DirDown("Out");
+	cache_path.SetExtension(".fxc");
+
+	return cache_path.Str();
+}
+
+static Hash64 GetCacheKey(const Slice<char>& source)
+{
+	return HashData64(source, HashObj64(scFoxBytecodeVersion));
+}
+
+/**
+ * @brief Hashes the contents of the file at `path`. Returns `HashNull64` if the file could not be read.
+ */
+static Hash64 HashFileContents(const char* path)
+{
+	File file(path, File::eModType::Read, File::eDataType::Binary);
+	if (!file.IsFileOpen()) {
+		return HashNull64;
+	}
+
+	Slice<char> data = file.Read<char>();
+	const Hash64 hash = HashData64(data);
+
+	gEnginePool->Free(data.pData);
+
+	return hash;
+}
+
+
+template <typename T>
+static void WriteValue(uint8*& write_ptr, const T& value)
+{
+	std::memcpy(write_ptr, &value, sizeof(T));
+	write_ptr += sizeof(T);
+}
+
+/**
+ * @brief Bounds checked reader for cache entries. Any read past the end of the entry marks the reader as failed
+ * rather than reading out of bounds.
+ */
+struct FoxCacheReader
+{
+	template <typename T>
+	T Read()
+	{
+		T value {};
+		if (!CanRead(sizeof(T))) {
+			return value;
+		}
+
+		std::memcpy(&value, pData + Offset, sizeof(T));
+		Offset += sizeof(T);
+
+		return value;
+	}
+
+	const uint8* ReadBytes(uint32 size)
+	{
+		if (!CanRead(size)) {
+			return nullptr;
+		}
+
+		const uint8* ptr = pData + Offset;
+		Offset += size;
+
+		return ptr;
+	}
+
+	bool CanRead(uint32 size)
+	{
+		if (Offset + size > Size) {
+			bHasError = true;
+		}
+		return !bHasError;
+	}
+
+public:
+	const uint8* pData = nullptr;
+	uint32 Size = 0;
+	uint32 Offset = 0;
+	bool bHasError = false;
+};
+
+
+FoxBytecodeCache& FoxBytecodeCache::GetInstance()
+{
+	static FoxBytecodeCache sCache;
+
+	return sCache;
+}
+
+SizedArray<uint8> FoxBytecodeCache::Fetch(const String& path)
+{
+	SizedArray<uint8> bytecode;
+
+	if (!ReadEntry(path, &bytecode)) {
+		return SizedArray<uint8>();
+	}
+
+	LogInfo(LC_SCRIPT, "Loaded cached bytecode for {}", path);
+
+	return bytecode;
+}
+
+bool FoxBytecodeCache::IsUpToDate(const String& path) { return ReadEntry(path, nullptr); }
+
+bool FoxBytecodeCache::ReadEntry(const String& path, SizedArray<uint8>* out_bytecode)
+{
+	Hash64 key = HashNull64;
+
+	{
+		File source_file(path, File::eModType::Read, File::eDataType::Binary);
+		if (!source_file.IsFileOpen()) {
+			return false;
+		}
+
+		Slice<char> source = source_file.Read<char>();
+		key = GetCacheKey(source);
+
+		gEnginePool->Free(source.pData);
+	}
+
+	const String cache_path = GetCachePath(path);
+
+	DataPack pack;
+	if (!pack.ReadFromFile(cache_path.CStr())) {
+		return false;
+	}
+
+	// The key changes if either the source or the compiler version changes, so a missing entry means the cache is stale
+	DataPackEntry* entry = pack.GetEntry(key, true);
+	if (entry == nullptr) {
+		return false;
+	}
+
+	FoxCacheReader reader { .pData = entry->Data.pData, .Size = static_cast<uint32>(entry->Data.Size) };
+
+	const uint32 dependency_count = reader.Read<uint32>();
+
+	constexpr uint32 scBufferSize = 1024;
+	char path_buffer[scBufferSize];
+
+	for (uint32 index = 0; index < dependency_count && !reader.bHasError; index++) {
+		const eFoxDependencyType type = static_cast<eFoxDependencyType>(reader.Read<uint8>());
+		const Hash64 content_hash = reader.Read<Hash64>();
+		const uint16 path_length = reader.Read<uint16>();
+
+		const uint8* path_data = reader.ReadBytes(path_length);
+		if (path_data == nullptr || path_length >= scBufferSize) {
+			return false;
+		}
+
+		std::memcpy(path_buffer, path_data, path_length);
+		path_buffer[path_length] = 0;
+
+		if (HashFileContents(path_buffer) != content_hash) {
+			LogInfo(LC_SCRIPT, "Dependency '{}' of {} has changed, recompiling", path_buffer, path);
+			return false;
+		}
+
+		// The module may be up to date itself but could have stale dependencies of its own
+		if (type == eFoxDependencyType::Module && !IsUpToDate(String(path_buffer))) {
+			return false;
+		}
+	}
+
+	const uint32 bytecode_size = reader.Read<uint32>();
+	const uint8* bytecode_data = reader.ReadBytes(bytecode_size);
+
+	if (reader.bHasError || bytecode_data == nullptr) {
+		LogWarning(LC_SCRIPT, "Bytecode cache entry for {} is malformed", path);
+		return false;
+	}
+
+	if (out_bytecode) {
+		out_bytecode->InitAsCopyOf(bytecode_data, bytecode_size);
+	}
+
+	return true;
+}
+
+void FoxBytecodeCache::Store(const String& path, const Slice<char>& source, const Slice<uint8>& bytecode,
+							 const std::vector<FoxScriptDependency>& dependencies)
+{
+	uint32 entry_size = sizeof(uint32);
+
+	for (const FoxScriptDependency& dependency : dependencies) {
+		entry_size += sizeof(uint8) + sizeof(Hash64) + sizeof(uint16) + dependency.Path.size();
+	}
+
+	entry_size += sizeof(uint32) + bytecode.Size;
+
+	SizedArray<uint8> entry_data;
+	entry_data.InitSize(entry_size);
+
+	uint8* write_ptr = entry_data.pData;
+
+	WriteValue<uint32>(write_ptr, static_cast<uint32>(dependencies.size()));
+
+	for (const FoxScriptDependency& dependency : dependencies) {
+		const uint16 path_length = static_cast<uint16>(dependency.Path.size());
+
+		WriteValue<uint8>(write_ptr, static_cast<uint8>(dependency.Type));
+		WriteValue<Hash64>(write_ptr, HashFileContents(dependency.Path.c_str()));
+		WriteValue<uint16>(write_ptr, path_length);
+
+		std::memcpy(write_ptr, dependency.Path.data(), path_length);
+		write_ptr += path_length;
+	}
+
+	WriteValue<uint32>(write_ptr, static_cast<uint32>(bytecode.Size));
+	std::memcpy(write_ptr, bytecode.pData, bytecode.Size);
+
+	const String cache_path = GetCachePath(path);
+
+	DataPack pack;
+	pack.AddEntry(GetCacheKey(source), Slice<uint8>(entry_data));
+	pack.WriteToFile(cache_path.CStr());
+	pack.Close();
+}
+
+Ref<FoxBytecodeImage> FoxBytecodeCache::FindImage(const String& path)
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	auto it = mImages.find(HashStr64(path.CStr()));
+	if (it == mImages.end()) {
+		return Ref<FoxBytecodeImage>(nullptr);
+	}
+
+	return it->second;
+}
+
+Ref<FoxBytecodeImage> FoxBytecodeCache::StoreImage(const String& path, SizedArray<uint8>&& bytecode)
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	Ref<FoxBytecodeImage> image = MakeRef<FoxBytecodeImage>();
+	image->Bytecode = std::move(bytecode);
+
+	if (FoxJit::IsSupported()) {
+		image->pJit = MakeRef<FoxJit>();
+	}
+
+	mImages[HashStr64(path.CStr())] = image;
+
+	return image;
+}
+
+void FoxBytecodeCache::ReleaseImage(const String& path)
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	mImages.erase(HashStr64(path.CStr()));
+}
+
+Ref<FoxVM> FoxBytecodeCache::AcquireModule(const char* bytecode_path, VMInitState* init_state)
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	const Hash64 path_hash = HashStr64(bytecode_path);
+
+	auto it = mModules.find(path_hash);
+	if (it != mModules.end()) {
+		return it->second;
+	}
+
+	File bytecode_file(bytecode_path, File::eModType::Read, File::eDataType::Binary);
+	if (!bytecode_file.IsFileOpen()) {
+		return Ref<FoxVM>(nullptr);
+	}
+
+	SizedArray<uint8> bytecode;
+	bytecode.InitSize(bytecode_file.GetFileSize());
+	bytecode_file.Read(Slice<uint8>(bytecode));
+	bytecode_file.Close();
+
+	Ref<FoxVM> module_vm = MakeRef<FoxVM>();
+	module_vm->InitVM(std::move(bytecode), init_state);
+
+	mModules[path_hash] = module_vm;
+
+	return module_vm;
+}
+
+void FoxBytecodeCache::ReleaseModule(const char* bytecode_path)
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	mModules.erase(HashStr64(bytecode_path));
+}
+
+void FoxBytecodeCache::ReleaseModules()
+{
+	std::lock_guard<std::recursive_mutex> lock(mModuleMutex);
+
+	mModules.clear();
+	mImages.clear();
+}
+
+} // namespace fx::script
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "FoxVM.hpp"
+
+#include <Core/Hash.hpp>
+#include <Core/Ref.hpp>
+#include <Core/Slice.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fx {
+class String;
+}
+
+namespace fx::script {
+
+enum class eFoxDependencyType : uint8
+{
+	/// A file pulled in with `#include`. Its tokens are compiled directly into the script.
+	Include,
+
+	/// A module loaded with `modload`. The module is compiled to its own bytecode file and linked at runtime.
+	Module,
+};
+
+struct FoxScriptDependency
+{
+	std::string Path;
+	eFoxDependencyType Type = eFoxDependencyType::Include;
+};
+
+/**
+ * @brief Immutable bytecode for a script, shared by every instance of the script.
+ */
+struct FoxBytecodeImage
+{
+	SizedArray<uint8> Bytecode;
+
+	/// Compiled procs for the bytecode, shared by every VM that runs the image. Null if the JIT is not supported.
+	Ref<FoxJit> pJit { nullptr };
+};
+
+/**
+ * @brief Caches compiled bytecode for FoxScript files and shares linked modules between scripts.
+ *
+ * Each script has a cache DataPack in its `Out/` directory (`<name>.fxc`). The entry is keyed by a hash of the script
+ * source and `scFoxBytecodeVersion`, and records the content hash of every included file and linked module. An entry
+ * is only used when the source, the compiler version and all of the dependencies are unchanged.
+ *
+ * Linked modules are loaded once per bytecode path and the resulting VM is shared by every script that imports it.
+ * Scripts loaded from the same path share a single bytecode image.
+ */
+class FoxBytecodeCache
+{
+public:
+	static FoxBytecodeCache& GetInstance();
+
+	/**
+	 * @brief Returns the cached bytecode for the script at `path`, or an empty array if there is no valid entry.
+	 */
+	SizedArray<uint8> Fetch(const String& path);
+
+	/**
+	 * @brief Checks if the script at `path` has a cache entry that matches its source and all of its dependencies.
+	 * Linked modules are checked recursively.
+	 */
+	bool IsUpToDate(const String& path);
+
+	/**
+	 * @brief Writes the bytecode for the script at `path` to its cache DataPack.
+	 * @param source The source that was compiled. Used to generate the cache key.
+	 * @param dependencies The files included or linked by the script.
+	 */
+	void Store(const String& path, const Slice<char>& source, const Slice<uint8>& bytecode,
+			   const std::vector<FoxScriptDependency>& dependencies);
+
+	/**
+	 * @brief Returns the resident bytecode image for the script at `path`, or null if it has not been loaded.
+	 */
+	Ref<FoxBytecodeImage> FindImage(const String& path);
+
+	/**
+	 * @brief Makes `bytecode` the resident image for the script at `path`, with a new JIT for its procs.
+	 */
+	Ref<FoxBytecodeImage> StoreImage(const String& path, SizedArray<uint8>&& bytecode);
+
+	/**
+	 * @brief Drops the resident image for the script at `path`. Scripts already using the image keep it alive.
+	 */
+	void ReleaseImage(const String& path);
+
+	/**
+	 * @brief Returns the shared VM for the module at `bytecode_path`, loading it if it is not already resident.
+	 * @param init_state The state to initialize the VM with if it is loaded by this call.
+	 */
+	Ref<FoxVM> AcquireModule(const char* bytecode_path, VMInitState* init_state);
+
+	/**
+	 * @brief Drops the shared VM for a module so the next import loads the bytecode from disk. Scripts that already
+	 * link the module keep their current VM.
+	 */
+	void ReleaseModule(const char* bytecode_path);
+
+	/**
+	 * @brief Drops all shared module VMs and bytecode images held by the cache.
+	 */
+	void ReleaseModules();
+
+private:
+	FoxBytecodeCache() = default;
+
+	bool ReadEntry(const String& path, SizedArray<uint8>* out_bytecode);
+
+private:
+	/// Recursive as loading a module will load any modules that it links in turn.
+	std::recursive_mutex mModuleMutex;
+	std::unordered_map<Hash64, Ref<FoxVM>, Hash64Stl> mModules;
+	std::unordered_map<Hash64, Ref<FoxBytecodeImage>, Hash64Stl> mImages;
+};
+
+} // namespace fx::script
@@ -7,6 +7,7 @@
 #include <Core/FilesystemIO.hpp>
 #include <Core/Log.hpp>
 #include <Core/PagedArray.hpp>
+#include <Script/FoxBytecodeCache.hpp>
 #include <Script/FoxScript.hpp>
 #include <Util/Tokenizer.hpp>
 
@@ -114,6 +115,9 @@ void FoxBytecodeCompiler::EmitReturn(FoxAstReturn* return_node)
 			else if (caller_return_type == eFoxType::STRING) {
 				EmitJumpReturnToCallerString();
 			}
+			else if (FoxIsVectorType(caller_return_type)) {
+				EmitJumpReturnToCallerVector(caller_return_type);
+			}
 			else {
 				CompileError("Unknown return type {}!", static_cast<uint32>(caller_return_type));
 			}
@@ -132,6 +136,9 @@ void FoxBytecodeCompiler::EmitReturn(FoxAstReturn* return_node)
 			else if (return_type == eFoxType::STRING) {
 				EmitJumpReturnToCallerString();
 			}
+			else if (FoxIsVectorType(return_type)) {
+				EmitJumpReturnToCallerVector(return_type);
+			}
 			else {
 				CompileError("Unknown return type {}!", static_cast<uint32>(return_type));
 			}
@@ -214,9 +221,10 @@ void FoxBytecodeCompiler::EmitNode(FoxAstNode* node)
 	}
 	else if (node->NodeType == FX_AST_PROCCALL) {
 		FoxAstFunctionCall* call = static_cast<FoxAstFunctionCall*>(node);
-		if (DoBuiltin(call, false) != eFoxType::NONETYPE) {
+		const eFoxType builtin_type = DoBuiltin(call, false);
+		if (builtin_type != eFoxType::NONETYPE) {
 			// Since this is a freestanding function call, we will want to discard the return value.
-			EmitPopDiscard();
+			EmitPopDiscard(builtin_type);
 			return;
 		}
 
@@ -328,8 +336,15 @@ void FoxBytecodeCompiler::EmitPushString(uint32 value)
 	Write32(value);
 }
 
-void FoxBytecodeCompiler::EmitPushVar(VarIndex var)
+void FoxBytecodeCompiler::EmitPushVar(VarIndex var, eFoxType type)
 {
+	if (FoxIsVectorType(type)) {
+		// VPUSHV [%var]
+		WriteOp(BcBase_Vector, BcSpecVector_PushVar);
+		Write16(var);
+		return;
+	}
+
 	// VPUSH [%var]
 	WriteOp(BcBase_Push, BcSpecPush_Var);
 	Write16(var);
@@ -352,6 +367,18 @@ void FoxBytecodeCompiler::EmitPushReadPtr(VarIndex var)
 
 void FoxBytecodeCompiler::EmitPushReturnAddr() { WriteOp(BcBase_Push, BcSpecPush_ReturnAddr); }
 
+void FoxBytecodeCompiler::EmitPushAsFloat32(FoxAstNode* node)
+{
+	eFoxType type = EmitPushUnderlyingValue(node);
+
+	if (type == eFoxType::INT) {
+		EmitVariableCastFloat32();
+	}
+	else if (type != eFoxType::FLOAT) {
+		CompileError("Expected a number but received '{}'", type);
+	}
+}
+
 eFoxType FoxBytecodeCompiler::EmitPushUnderlyingValue(FoxAstNode* node, eFoxPushMode mode)
 {
 	if (node->NodeType == FX_AST_LITERAL) {
@@ -397,7 +424,7 @@ eFoxType FoxBytecodeCompiler::EmitPushUnderlyingValue(FoxAstNode* node, eFoxPush
 
 			// Push the normal variable index to the stack.
 			else {
-				EmitPushVar(handle->VariableIndex);
+				EmitPushVar(handle->VariableIndex, handle->Type);
 			}
 
 			return handle->Type;
@@ -419,7 +446,7 @@ eFoxType FoxBytecodeCompiler::EmitPushUnderlyingValue(FoxAstNode* node, eFoxPush
 	else if (node->NodeType == FX_AST_BINOP) {
 		FoxAstBinop* binop = static_cast<FoxAstBinop*>(node);
 		EmitBinop(binop);
-		return GetUnderlyingType(binop->pLeft);
+		return GetUnderlyingType(binop);
 	}
 	else if (node->NodeType == FX_AST_PROCCALL) {
 		FoxAstFunctionCall* call = static_cast<FoxAstFunctionCall*>(node);
@@ -479,7 +506,14 @@ eFoxType FoxBytecodeCompiler::GetUnderlyingType(FoxAstNode* node)
 	}
 	else if (node->NodeType == FX_AST_BINOP) {
 		FoxAstBinop* binop = static_cast<FoxAstBinop*>(node);
-		return GetUnderlyingType(binop->pLeft);
+		const eFoxType left_type = GetUnderlyingType(binop->pLeft);
+
+		// Multiplying a quaternion by a vec3 rotates the vector
+		if (left_type == eFoxType::QUAT && GetUnderlyingType(binop->pRight) == eFoxType::VEC3) {
+			return eFoxType::VEC3;
+		}
+
+		return left_type;
 	}
 	else if (node->NodeType == FX_AST_PROCCALL) {
 		FoxAstFunctionCall* call = static_cast<FoxAstFunctionCall*>(node);
@@ -545,15 +579,28 @@ void FoxBytecodeCompiler::EmitStackAlloc(uint16 size)
 }
 
 
-void FoxBytecodeCompiler::EmitPopVar(VarIndex var)
+void FoxBytecodeCompiler::EmitPopVar(VarIndex var, eFoxType type)
 {
+	if (FoxIsVectorType(type)) {
+		// VPOPV [%var]
+		WriteOp(BcBase_Vector, BcSpecVector_PopVar);
+		Write16(var);
+		return;
+	}
+
 	// VPOP [%var]
-	WriteOp(BcBase_Pop, BcSpecPop_Variable_Int32);
+	WriteOp(BcBase_Pop, (type == eFoxType::FLOAT) ? BcSpecPop_Variable_Float32 : BcSpecPop_Variable_Int32);
 	Write16(var);
 }
 
-void FoxBytecodeCompiler::EmitPopDiscard()
+void FoxBytecodeCompiler::EmitPopDiscard(eFoxType type)
 {
+	if (FoxIsVectorType(type)) {
+		// DISCARDV
+		WriteOp(BcBase_Vector, BcSpecVector_Discard);
+		return;
+	}
+
 	// VPOP
 	WriteOp(BcBase_Pop, BcSpecPop_Discard);
 }
@@ -630,6 +677,20 @@ void FoxBytecodeCompiler::EmitJumpReturnToCallerInt32() { WriteOp(BcBase_Jump, B
 void FoxBytecodeCompiler::EmitJumpReturnToCallerFloat32() { WriteOp(BcBase_Jump, BcSpecJump_ReturnToCaller_Float32); }
 void FoxBytecodeCompiler::EmitJumpReturnToCallerString() { WriteOp(BcBase_Jump, BcSpecJump_ReturnToCaller_String); }
 
+void FoxBytecodeCompiler::EmitJumpReturnToCallerVector(eFoxType type)
+{
+	BcSpecJump spec = BcSpecJump_ReturnToCaller_Vec3;
+
+	if (type == eFoxType::VEC4) {
+		spec = BcSpecJump_ReturnToCaller_Vec4;
+	}
+	else if (type == eFoxType::QUAT) {
+		spec = BcSpecJump_ReturnToCaller_Quat;
+	}
+
+	WriteOp(BcBase_Jump, spec);
+}
+
 void FoxBytecodeCompiler::EmitJumpPause(uint16 time)
 {
 	WriteOp(BcBase_Jump, BcSpecJump_Pause);
@@ -692,6 +753,13 @@ void FoxBytecodeCompiler::EmitVariableSetVar(VarIndex dst, VarIndex src, bool is
 
 void FoxBytecodeCompiler::EmitVariableDefine(eFoxType type, uint16 var_index)
 {
+	if (FoxIsVectorType(type)) {
+		WriteOp(BcBase_Variable, BcSpecVariable_Define_Vector);
+		Write16(var_index);
+		Write16(static_cast<uint16>(type));
+		return;
+	}
+
 	BcSpecVariable spec;
 
 	switch (type) {
@@ -714,6 +782,14 @@ void FoxBytecodeCompiler::EmitVariableDefine(eFoxType type, uint16 var_index)
 
 void FoxBytecodeCompiler::EmitVariableGlobalDefine(eFoxType type, uint16 var_index, Hash32 name_hash)
 {
+	if (FoxIsVectorType(type)) {
+		WriteOp(BcBase_Variable, BcSpecVariable_DefineGlobal_Vector);
+		Write16(var_index);
+		Write32(name_hash);
+		Write16(static_cast<uint16>(type));
+		return;
+	}
+
 	BcSpecVariable spec;
 
 	switch (type) {
@@ -737,6 +813,13 @@ void FoxBytecodeCompiler::EmitVariableGlobalDefine(eFoxType type, uint16 var_ind
 
 void FoxBytecodeCompiler::EmitVariableDefineFetchParam(eFoxType type, uint16 var_index)
 {
+	if (FoxIsVectorType(type)) {
+		WriteOp(BcBase_Variable, BcSpecVariable_DefineFetchParam_Vector);
+		Write16(var_index);
+		Write16(static_cast<uint16>(type));
+		return;
+	}
+
 	BcSpecVariable spec;
 
 	switch (type) {
@@ -831,6 +914,11 @@ void FoxBytecodeCompiler::EmitBinop(FoxAstBinop* binop)
 	eFoxType left_type = EmitPushUnderlyingValue(binop->pLeft);
 	eFoxType right_type = EmitPushUnderlyingValue(binop->pRight);
 
+	if (FoxIsVectorType(left_type) || FoxIsVectorType(right_type)) {
+		EmitVectorBinop(binop, left_type, right_type);
+		return;
+	}
+
 	if (left_type != right_type) {
 		CompileError("Mismatched type: Cannot perform operation on '{}' and '{}'", left_type, right_type);
 		return;
@@ -846,6 +934,60 @@ void FoxBytecodeCompiler::EmitBinop(FoxAstBinop* binop)
 	}
 }
 
+void FoxBytecodeCompiler::EmitVectorOp(BcSpecVector spec) { WriteOp(BcBase_Vector, spec); }
+
+void FoxBytecodeCompiler::EmitVectorBinop(FoxAstBinop* binop, eFoxType left_type, eFoxType right_type)
+{
+	const TT op = binop->OpToken->Type;
+
+	// The operands are already on the stack, with the right hand side on top.
+
+	if (!FoxIsVectorType(left_type)) {
+		CompileError("Vector operations must have the vector on the left hand side ('{}' and '{}')", left_type,
+					 right_type);
+		return;
+	}
+
+	// Scale by a number
+	if (right_type == eFoxType::INT || right_type == eFoxType::FLOAT) {
+		if (op != TT::Asterisk || left_type == eFoxType::QUAT) {
+			CompileError("Cannot perform operation on '{}' and '{}'", left_type, right_type);
+			return;
+		}
+
+		if (right_type == eFoxType::INT) {
+			EmitVariableCastFloat32();
+		}
+
+		EmitVectorOp(BcSpecVector_Scale);
+		return;
+	}
+
+	// Rotate a vector by a quaternion
+	if (left_type == eFoxType::QUAT && right_type == eFoxType::VEC3 && op == TT::Asterisk) {
+		EmitVectorOp(BcSpecVector_QuatRotate);
+		return;
+	}
+
+	if (left_type != right_type) {
+		CompileError("Mismatched type: Cannot perform operation on '{}' and '{}'", left_type, right_type);
+		return;
+	}
+
+	if (op == TT::Plus) {
+		EmitVectorOp(BcSpecVector_Add);
+	}
+	else if (op == TT::Minus) {
+		EmitVectorOp(BcSpecVector_Sub);
+	}
+	else if (op == TT::Asterisk) {
+		EmitVectorOp((left_type == eFoxType::QUAT) ? BcSpecVector_QuatMul : BcSpecVector_Mul);
+	}
+	else {
+		CompileError("Unsupported operation on type '{}'", left_type);
+	}
+}
+
 
 uint16 FoxBytecodeCompiler::GetSizeOfType(Token* token)
 {
@@ -854,6 +996,9 @@ uint16 FoxBytecodeCompiler::GetSizeOfType(Token* token)
 	constexpr Hash32 type_int_hash = HashStr32("int");
 	constexpr Hash32 type_float_hash = HashStr32("float");
 	constexpr Hash32 type_str_hash = HashStr32("str");
+	constexpr Hash32 type_vec3_hash = HashStr32("vec3");
+	constexpr Hash32 type_vec4_hash = HashStr32("vec4");
+	constexpr Hash32 type_quat_hash = HashStr32("quat");
 
 	if (type_hash == type_int_hash) {
 		return sizeof(int32);
@@ -864,6 +1009,9 @@ uint16 FoxBytecodeCompiler::GetSizeOfType(Token* token)
 	else if (type_hash == type_str_hash) {
 		return sizeof(int32);
 	}
+	else if (type_hash == type_vec3_hash || type_hash == type_vec4_hash || type_hash == type_quat_hash) {
+		return sizeof(float32) * 4;
+	}
 	else {
 		CompileError("GetSizeOfType: Unknown type");
 	}
@@ -996,7 +1144,7 @@ void FoxBytecodeCompiler::EmitRhs(FoxAstNode* rhs, FoxBytecodeCompiler::RhsMode
 			// If the RHS is a pointer, we need to dereference it with VREADPTR.
 			if (rhs_handle->bIsPointer && rhs_handle->bIsPointerAssigned) {
 				EmitPushReadPtr(rhs_handle->VariableIndex);
-				EmitPopVar(handle->VariableIndex);
+				EmitPopVar(handle->VariableIndex, handle->Type);
 			}
 			else {
 				EmitVariableSetVar(handle->VariableIndex, rhs_handle->VariableIndex, modify_pointer_dst);
@@ -1016,7 +1164,15 @@ void FoxBytecodeCompiler::EmitRhs(FoxAstNode* rhs, FoxBytecodeCompiler::RhsMode
 		else if (rhs->NodeType == FX_AST_PROCCALL) {
 			FoxAstFunctionCall* call = static_cast<FoxAstFunctionCall*>(rhs);
 
-			bool is_builtin_call = DoBuiltin(call, false) != eFoxType::NONETYPE;
+			const eFoxType builtin_type = DoBuiltin(call, false);
+			bool is_builtin_call = builtin_type != eFoxType::NONETYPE;
+
+			// Vectors take up more than one slot on the stack, so the size must match the variable
+			if (is_builtin_call && builtin_type != handle->Type &&
+				(FoxIsVectorType(builtin_type) || FoxIsVectorType(handle->Type))) {
+				CompileError("Type mismatch: assigning type '{}' to variable of type '{}'", builtin_type,
+							 handle->Type);
+			}
 
 			if (!is_builtin_call) {
 				if (call->GetReturnType() != handle->Type) {
@@ -1039,7 +1195,7 @@ void FoxBytecodeCompiler::EmitRhs(FoxAstNode* rhs, FoxBytecodeCompiler::RhsMode
 		}
 
 		// Pop the newly pushed value to the variable
-		EmitPopVar(handle->VariableIndex);
+		EmitPopVar(handle->VariableIndex, handle->Type);
 	}
 }
 
@@ -1064,6 +1220,10 @@ FoxBytecodeVarHandle* FoxBytecodeCompiler::DoVarDeclare(FoxAstVarDecl* decl, Var
 	eFoxType var_type = FoxStringToType(decl->pTypeToken);
 	const uint16 size_of_type = GetSizeOfType(decl->pTypeToken);
 
+	if (decl->bIsPointer && FoxIsVectorType(var_type)) {
+		CompileError("Pointers to vector types are not supported ('{}')", decl->pNameToken->GetStr());
+	}
+
 	if (mode == VarDeclareMode::DECLARE_PARAMETER) {
 		EmitVariableDefineFetchParam(var_type, mVariableIndex);
 	}
@@ -1127,23 +1287,23 @@ bool FoxBytecodeCompiler::ValidateParameters(FoxAstFunctionCall* call)
 	}
 
 	// Get the parameter definitions for the function declaration
-	const std::vector<FoxAstNode*>& param_decl_stmts = call->pFunction->pDeclaration->pParams->Statements;
+	const ArenaArray<FoxAstNode*>& param_decl_stmts = call->pFunction->pDeclaration->pParams->Statements;
 
-	bool has_correct_param_count = call->Params.size() == param_decl_stmts.size();
+	bool has_correct_param_count = call->Params.Size() == param_decl_stmts.Size();
 
 	if (call->pFunction->pDeclaration->bIsVariadic) {
-		has_correct_param_count = (param_decl_stmts.size() <= call->Params.size());
+		has_correct_param_count = (param_decl_stmts.Size() <= call->Params.Size());
 	}
 
 	// Check to make sure there are the correct number of arguments
 	if (!has_correct_param_count) {
-		CompileError("Expected {} parameters but {} were passed in", param_decl_stmts.size(), call->Params.size());
+		CompileError("Expected {} parameters but {} were passed in", param_decl_stmts.Size(), call->Params.Size());
 		return false;
 	}
 
 	// Check the argument types match
-	for (int32 i = 0; i < call->Params.size(); i++) {
-		if (i >= param_decl_stmts.size()) {
+	for (int32 i = 0; i < call->Params.Size(); i++) {
+		if (i >= param_decl_stmts.Size()) {
 			break;
 		}
 
@@ -1165,7 +1325,7 @@ bool FoxBytecodeCompiler::ValidateParameters(FoxAstFunctionCall* call)
 }
 
 #define BUILTIN_REQUIRE_PARAM_N(num_)                                                                                  \
-	if (call->Params.size() != num_) {                                                                                 \
+	if (call->Params.Size() != num_) {                                                                                 \
 		CompileError("Not enough parameters for builtin function!");                                                   \
 		return eFoxType::NONETYPE;                                                                                     \
 	}
@@ -1249,7 +1409,7 @@ eFoxType FoxBytecodeCompiler::DoBuiltin(FoxAstFunctionCall* call, bool do_not_ca
 			return vh->Type;
 		}
 
-		EmitPopVar(vh->VariableIndex);
+		EmitPopVar(vh->VariableIndex, vh->Type);
 
 		return vh->Type;
 	}
@@ -1300,6 +1460,215 @@ eFoxType FoxBytecodeCompiler::DoBuiltin(FoxAstFunctionCall* call, bool do_not_ca
 	}
 
 
+	return DoVectorBuiltin(call, do_not_call);
+}
+
+eFoxType FoxBytecodeCompiler::DoVectorBuiltin(FoxAstFunctionCall* call, bool do_not_call)
+{
+	static constexpr Hash32 scVec3 = HashStr32("vec3");
+	static constexpr Hash32 scVec4 = HashStr32("vec4");
+	static constexpr Hash32 scQuat = HashStr32("quat");
+
+	static constexpr Hash32 scDot = HashStr32("dot");
+	static constexpr Hash32 scCross = HashStr32("cross");
+	static constexpr Hash32 scNormalize = HashStr32("normalize");
+	static constexpr Hash32 scRotate = HashStr32("rotate");
+	static constexpr Hash32 scSLerp = HashStr32("slerp");
+
+	static constexpr Hash32 scGetX = HashStr32("getx");
+	static constexpr Hash32 scGetY = HashStr32("gety");
+	static constexpr Hash32 scGetZ = HashStr32("getz");
+	static constexpr Hash32 scGetW = HashStr32("getw");
+
+	switch (call->HashedName) {
+	case scVec3: {
+		BUILTIN_REQUIRE_PARAM_N(3);
+
+		if (do_not_call) {
+			return eFoxType::VEC3;
+		}
+
+		for (FoxAstNode* param : call->Params) {
+			EmitPushAsFloat32(param);
+		}
+
+		EmitVectorOp(BcSpecVector_Make3);
+		return eFoxType::VEC3;
+	}
+
+	case scVec4: {
+		BUILTIN_REQUIRE_PARAM_N(4);
+
+		if (do_not_call) {
+			return eFoxType::VEC4;
+		}
+
+		for (FoxAstNode* param : call->Params) {
+			EmitPushAsFloat32(param);
+		}
+
+		EmitVectorOp(BcSpecVector_Make4);
+		return eFoxType::VEC4;
+	}
+
+	case scQuat: {
+		// Either quat(axis, angle) or quat(x, y, z, w)
+		if (call->Params.Size() != 2 && call->Params.Size() != 4) {
+			CompileError("quat() expects an axis and angle, or four components");
+			return eFoxType::NONETYPE;
+		}
+
+		if (do_not_call) {
+			return eFoxType::QUAT;
+		}
+
+		if (call->Params.Size() == 2) {
+			if (EmitPushUnderlyingValue(call->Params[0]) != eFoxType::VEC3) {
+				CompileError("quat(axis, angle) expects a vec3 axis");
+			}
+
+			EmitPushAsFloat32(call->Params[1]);
+			EmitVectorOp(BcSpecVector_QuatAxisAngle);
+
+			return eFoxType::QUAT;
+		}
+
+		for (FoxAstNode* param : call->Params) {
+			EmitPushAsFloat32(param);
+		}
+
+		EmitVectorOp(BcSpecVector_MakeQuat);
+		return eFoxType::QUAT;
+	}
+
+	case scDot: {
+		BUILTIN_REQUIRE_PARAM_N(2);
+
+		if (do_not_call) {
+			return eFoxType::FLOAT;
+		}
+
+		eFoxType a_type = EmitPushUnderlyingValue(call->Params[0]);
+		eFoxType b_type = EmitPushUnderlyingValue(call->Params[1]);
+
+		if (a_type != b_type || !FoxIsVectorType(a_type)) {
+			CompileError("dot() expects two vectors of the same type, received '{}' and '{}'", a_type, b_type);
+			return eFoxType::FLOAT;
+		}
+
+		EmitVectorOp((a_type == eFoxType::VEC3) ? BcSpecVector_Dot3 : BcSpecVector_Dot4);
+		return eFoxType::FLOAT;
+	}
+
+	case scCross: {
+		BUILTIN_REQUIRE_PARAM_N(2);
+
+		if (do_not_call) {
+			return eFoxType::VEC3;
+		}
+
+		eFoxType a_type = EmitPushUnderlyingValue(call->Params[0]);
+		eFoxType b_type = EmitPushUnderlyingValue(call->Params[1]);
+
+		if (a_type != eFoxType::VEC3 || b_type != eFoxType::VEC3) {
+			CompileError("cross() expects two vec3 values, received '{}' and '{}'", a_type, b_type);
+		}
+
+		EmitVectorOp(BcSpecVector_Cross);
+		return eFoxType::VEC3;
+	}
+
+	case scNormalize: {
+		BUILTIN_REQUIRE_PARAM_N(1);
+
+		if (do_not_call) {
+			return GetUnderlyingType(call->Params[0]);
+		}
+
+		eFoxType type = EmitPushUnderlyingValue(call->Params[0]);
+
+		if (!FoxIsVectorType(type)) {
+			CompileError("normalize() expects a vector, received '{}'", type);
+			return eFoxType::NONETYPE;
+		}
+
+		EmitVectorOp((type == eFoxType::VEC3) ? BcSpecVector_Normalize3 : BcSpecVector_Normalize4);
+		return type;
+	}
+
+	case scRotate: {
+		BUILTIN_REQUIRE_PARAM_N(2);
+
+		if (do_not_call) {
+			return eFoxType::VEC3;
+		}
+
+		eFoxType q_type = EmitPushUnderlyingValue(call->Params[0]);
+		eFoxType v_type = EmitPushUnderlyingValue(call->Params[1]);
+
+		if (q_type != eFoxType::QUAT || v_type != eFoxType::VEC3) {
+			CompileError("rotate() expects a quat and a vec3, received '{}' and '{}'", q_type, v_type);
+		}
+
+		EmitVectorOp(BcSpecVector_QuatRotate);
+		return eFoxType::VEC3;
+	}
+
+	case scSLerp: {
+		BUILTIN_REQUIRE_PARAM_N(3);
+
+		if (do_not_call) {
+			return eFoxType::QUAT;
+		}
+
+		eFoxType a_type = EmitPushUnderlyingValue(call->Params[0]);
+		eFoxType b_type = EmitPushUnderlyingValue(call->Params[1]);
+
+		if (a_type != eFoxType::QUAT || b_type != eFoxType::QUAT) {
+			CompileError("slerp() expects two quat values, received '{}' and '{}'", a_type, b_type);
+		}
+
+		EmitPushAsFloat32(call->Params[2]);
+
+		EmitVectorOp(BcSpecVector_QuatSLerp);
+		return eFoxType::QUAT;
+	}
+
+	case scGetX:
+	case scGetY:
+	case scGetZ:
+	case scGetW: {
+		BUILTIN_REQUIRE_PARAM_N(1);
+
+		if (do_not_call) {
+			return eFoxType::FLOAT;
+		}
+
+		eFoxType type = EmitPushUnderlyingValue(call->Params[0]);
+
+		if (!FoxIsVectorType(type) || (call->HashedName == scGetW && type == eFoxType::VEC3)) {
+			CompileError("Cannot get component of type '{}'", type);
+		}
+
+		BcSpecVector spec = BcSpecVector_GetX;
+
+		if (call->HashedName == scGetY) {
+			spec = BcSpecVector_GetY;
+		}
+		else if (call->HashedName == scGetZ) {
+			spec = BcSpecVector_GetZ;
+		}
+		else if (call->HashedName == scGetW) {
+			spec = BcSpecVector_GetW;
+		}
+
+		EmitVectorOp(spec);
+		return eFoxType::FLOAT;
+	}
+
+	default:;
+	}
+
 	return eFoxType::NONETYPE;
 }
 
@@ -1316,7 +1685,7 @@ void FoxBytecodeCompiler::EmitFunctionCall(FoxAstFunctionCall* call, eFoxFunctio
 		return;
 	}
 
-	uint32 provided_parameter_count = call->Params.size();
+	uint32 provided_parameter_count = call->Params.Size();
 
 	// Fetch all parameters into registers
 	for (uint32 parameter_index = 0; parameter_index < provided_parameter_count; parameter_index++) {
@@ -1348,7 +1717,7 @@ void FoxBytecodeCompiler::EmitFunctionCall(FoxAstFunctionCall* call, eFoxFunctio
 
 
 	if (call->pFunction && call->pFunction->pDeclaration->bIsVariadic) {
-		EmitPush32(call->Params.size());
+		EmitPush32(call->Params.Size());
 	}
 
 	if ((flags & eFoxFunctionCallFlags::NoJump) == 0) {
@@ -1363,7 +1732,7 @@ void FoxBytecodeCompiler::EmitFunctionCall(FoxAstFunctionCall* call, eFoxFunctio
 
 	// If there is no consumer for the return value, emit a discard instruction
 	if ((flags & eFoxFunctionCallFlags::IgnoreReturnValue) != 0 && call->HasReturnType()) {
-		EmitPopDiscard();
+		EmitPopDiscard(call->GetReturnType());
 	}
 }
 
@@ -1384,7 +1753,7 @@ void FoxBytecodeCompiler::EmitModuleCall(FoxAstModuleCall* call, eFoxFunctionCal
 	}
 
 	if ((flags & eFoxFunctionCallFlags::IgnoreReturnValue) != 0 && call->pFunctionCall->HasReturnType()) {
-		EmitPopDiscard();
+		EmitPopDiscard(call->pFunctionCall->GetReturnType());
 	}
 }
 
@@ -1459,7 +1828,7 @@ void FoxBytecodeCompiler::WriteHeaderFile(const String& script_path, FoxAstBlock
 
 		String param_str = "";
 
-		uint32 num_params = proc_decl->pParams->Statements.size();
+		uint32 num_params = proc_decl->pParams->Statements.Size();
 
 		for (uint32 i = 0; i < num_params; i++) {
 			FoxAstNode* param_node = proc_decl->pParams->Statements[i];
@@ -1570,16 +1939,19 @@ void FoxBytecodeCompiler::EmitLinkTable(FoxAstBlock* root)
 
 			String bin_str = bin_path.Str();
 
-			if (!FilesystemIO::FileExists(bin_str) || true) {
-				// Compile script
-				FoxScript script;
+			Path script_path(mod_path);
+			script_path.SetExtension(".fox");
 
-				Path script_path(mod_path);
-				script_path.SetExtension(".fox");
+			const String script_str = script_path.Str();
 
-				script.Compile(script_path.Str());
+			// Only recompile the module if its source, compiler version or any of its dependencies have changed
+			if (!FilesystemIO::FileExists(bin_str) || !FoxBytecodeCache::GetInstance().IsUpToDate(script_str)) {
+				FoxScript script;
+				script.Compile(script_str);
 			}
 
+			LinkedModulePaths.push_back(script_str.Str());
+
 			decl->ModuleIndex = module_index;
 			EmitDataString(bin_str.CStr(), bin_str.Length, true);
 
@@ -1645,7 +2017,7 @@ void FoxBytecodeCompiler::EmitFunctionDeclaration(FoxAstFunctionDecl* function)
 	if (function->IsDefinition()) {
 		int32 parameter_index = 0;
 
-		uint32 num_parameters = function->pParams->Statements.size();
+		uint32 num_parameters = function->pParams->Statements.Size();
 
 		for (parameter_index = 0; parameter_index < num_parameters; parameter_index++) {
 			FoxAstNode* param_decl_node = function->pParams->Statements[(num_parameters - parameter_index - 1)];
@@ -1890,6 +2262,15 @@ void FoxBytecodePrinter::DoJump(char* s, uint8 op_base, uint8 op_spec)
 	else if (op_spec == BcSpecJump_ReturnToCaller_String) {
 		BC_PRINT_OP("VRETS [str]");
 	}
+	else if (op_spec == BcSpecJump_ReturnToCaller_Vec3) {
+		BC_PRINT_OP("VRETV [vec3]");
+	}
+	else if (op_spec == BcSpecJump_ReturnToCaller_Vec4) {
+		BC_PRINT_OP("VRETV [vec4]");
+	}
+	else if (op_spec == BcSpecJump_ReturnToCaller_Quat) {
+		BC_PRINT_OP("VRETV [quat]");
+	}
 	else if (op_spec == BcSpecJump_Pause) {
 		uint16 value = Read16();
 		BC_PRINT_OP("PAUSE {}", value);
@@ -2099,6 +2480,25 @@ void FoxBytecodePrinter::DoVariable(char* s, uint8 op_base, uint8 op_spec)
 	case BcSpecVariable_Cast_Float32:
 		BC_PRINT_OP("VCASTF [float32]");
 		break;
+
+	case BcSpecVariable_Define_Vector: {
+		uint16 var_index = Read16();
+		eFoxType type = static_cast<eFoxType>(Read16());
+		BC_PRINT_OP("VDEFINEV [{}] ${}", type, var_index);
+	} break;
+
+	case BcSpecVariable_DefineGlobal_Vector: {
+		uint16 var_index = Read16();
+		Hash32 name_hash = Read32();
+		eFoxType type = static_cast<eFoxType>(Read16());
+		BC_PRINT_OP("VGLOBALV [{}] ${} AS {}", type, var_index, name_hash);
+	} break;
+
+	case BcSpecVariable_DefineFetchParam_Vector: {
+		uint16 var_index = Read16();
+		eFoxType type = static_cast<eFoxType>(Read16());
+		BC_PRINT_OP("VPARAMV [{}] ${}", type, var_index);
+	} break;
 	/////////////////////////////////////
 	// Pointer instructions
 	/////////////////////////////////////
@@ -2144,6 +2544,83 @@ void FoxBytecodePrinter::DoCompare(char* s, uint8 op_base, uint8 op_spec)
 	}
 }
 
+void FoxBytecodePrinter::DoVector(char* s, uint8 op_base, uint8 op_spec)
+{
+	switch (op_spec) {
+	case BcSpecVector_PushVar: {
+		VarIndex var = Read16();
+		BC_PRINT_OP("VPUSHV ${}", var);
+	} break;
+	case BcSpecVector_PopVar: {
+		VarIndex var = Read16();
+		BC_PRINT_OP("VPOPV ${}", var);
+	} break;
+	case BcSpecVector_Discard:
+		BC_PRINT_OP("DISCARDV");
+		break;
+	case BcSpecVector_Make3:
+		BC_PRINT_OP("MKVEC3");
+		break;
+	case BcSpecVector_Make4:
+		BC_PRINT_OP("MKVEC4");
+		break;
+	case BcSpecVector_MakeQuat:
+		BC_PRINT_OP("MKQUAT");
+		break;
+	case BcSpecVector_QuatAxisAngle:
+		BC_PRINT_OP("MKQUATAXIS");
+		break;
+	case BcSpecVector_Add:
+		BC_PRINT_OP("ADDV");
+		break;
+	case BcSpecVector_Sub:
+		BC_PRINT_OP("SUBV");
+		break;
+	case BcSpecVector_Mul:
+		BC_PRINT_OP("MULV");
+		break;
+	case BcSpecVector_Scale:
+		BC_PRINT_OP("SCALEV");
+		break;
+	case BcSpecVector_Dot3:
+		BC_PRINT_OP("DOT3");
+		break;
+	case BcSpecVector_Dot4:
+		BC_PRINT_OP("DOT4");
+		break;
+	case BcSpecVector_Cross:
+		BC_PRINT_OP("CROSS");
+		break;
+	case BcSpecVector_Normalize3:
+		BC_PRINT_OP("NORM3");
+		break;
+	case BcSpecVector_Normalize4:
+		BC_PRINT_OP("NORM4");
+		break;
+	case BcSpecVector_QuatMul:
+		BC_PRINT_OP("MULQ");
+		break;
+	case BcSpecVector_QuatRotate:
+		BC_PRINT_OP("ROTQ");
+		break;
+	case BcSpecVector_QuatSLerp:
+		BC_PRINT_OP("SLERPQ");
+		break;
+	case BcSpecVector_GetX:
+		BC_PRINT_OP("GETX");
+		break;
+	case BcSpecVector_GetY:
+		BC_PRINT_OP("GETY");
+		break;
+	case BcSpecVector_GetZ:
+		BC_PRINT_OP("GETZ");
+		break;
+	case BcSpecVector_GetW:
+		BC_PRINT_OP("GETW");
+		break;
+	}
+}
+
 
 void FoxBytecodePrinter::LoadSymbolTable()
 {
@@ -2240,6 +2717,9 @@ void FoxBytecodePrinter::PrintOp()
 	case BcBase_Compare:
 		DoCompare(s, op_base, op_spec);
 		break;
+	case BcBase_Vector:
+		DoVector(s, op_base, op_spec);
+		break;
 	}
 }
 
@@ -121,6 +121,7 @@ private:
 	void EmitFunctionDefinitionsInBlock(FoxAstBlock* block);
 
 	eFoxType DoBuiltin(FoxAstFunctionCall* call, bool do_not_call);
+	eFoxType DoVectorBuiltin(FoxAstFunctionCall* call, bool do_not_call);
 	void EmitFunctionCall(FoxAstFunctionCall* call, eFoxFunctionCallFlags flags);
 	void EmitModuleCall(FoxAstModuleCall* call, eFoxFunctionCallFlags flags);
 
@@ -148,10 +149,11 @@ private:
 	void EmitPush32(int32 value);
 	void EmitPushFloat32(float32 value);
 	void EmitPushString(uint32 value);
-	void EmitPushVar(VarIndex var);
+	void EmitPushVar(VarIndex var, eFoxType type);
 	void EmitPushVarPtr(VarIndex var);
 	void EmitPushReadPtr(VarIndex var);
 	void EmitPushReturnAddr();
+	void EmitPushAsFloat32(FoxAstNode* node);
 
 	eFoxType EmitPushUnderlyingValue(FoxAstNode* node, eFoxPushMode mode = eFoxPushMode::Default);
 	eFoxType GetUnderlyingType(FoxAstNode* node);
@@ -159,8 +161,8 @@ private:
 
 	void EmitStackAlloc(uint16 size);
 
-	void EmitPopVar(VarIndex var);
-	void EmitPopDiscard();
+	void EmitPopVar(VarIndex var, eFoxType type);
+	void EmitPopDiscard(eFoxType type = eFoxType::INT);
 	void EmitPopReturnAddr();
 
 	void EmitJumpRelative(uint16 offset);
@@ -173,6 +175,7 @@ private:
 	void EmitJumpReturnToCallerInt32();
 	void EmitJumpReturnToCallerFloat32();
 	void EmitJumpReturnToCallerString();
+	void EmitJumpReturnToCallerVector(eFoxType type);
 
 	void EmitJumpPause(uint16 time_ms);
 
@@ -211,6 +214,9 @@ private:
 	uint32 EmitDataString(const char* str, uint16 length, bool emit_length_prefix);
 
 	void EmitBinop(FoxAstBinop* binop);
+	void EmitVectorBinop(FoxAstBinop* binop, eFoxType left_type, eFoxType right_type);
+
+	void EmitVectorOp(BcSpecVector spec);
 
 	void EmitRhs(FoxAstNode* rhs, RhsMode mode, FoxBytecodeVarHandle* handle);
 
@@ -242,6 +248,9 @@ public:
 
 	PagedArray<FoxBytecodeString> Strings;
 
+	/// Source paths of the modules linked by the script, in link table order.
+	std::vector<std::string> LinkedModulePaths;
+
 private:
 	uint16 mVariableIndex = 0;
 	uint32 mErrorCount = 0;
@@ -282,6 +291,7 @@ private:
 	void DoMarker(char* s, uint8 op_base, uint8 op_spec);
 	void DoVariable(char* s, uint8 op_base, uint8 op_spec);
 	void DoCompare(char* s, uint8 op_base, uint8 op_spec);
+	void DoVector(char* s, uint8 op_base, uint8 op_spec);
 
 	char* ReadString(char* buffer, uint32 buffer_size, bool has_prefixed_length);
 
@@ -0,0 +1,745 @@
+#include "FoxJit.hpp"
+
+#include "FoxBytecode.hpp"
+#include "FoxVM.hpp"
+#include "FoxX64Emitter.hpp"
+
+#include <Core/Log.hpp>
+#include <algorithm>
+
+#ifdef FX_USE_FOX_JIT
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace fx::script {
+
+/// Code is mapped in blocks of at least this size, rather than mapping each proc on its own.
+static constexpr uint64 scCodeBlockSize = 64 * 1024;
+
+///////////////////////////////////////////
+// Helpers called from compiled code
+///////////////////////////////////////////
+
+/**
+ * @brief Functions called by compiled procs. Operands are decoded at compile time and passed as immediates, and each
+ * helper calls the same VM function that the interpreter uses for the op.
+ */
+struct FoxJitHelpers
+{
+	/// Runs a single op in the interpreter. Used for ops that are not worth specializing.
+	static void Interpret(FoxVM* vm, uint32 pc)
+	{
+		vm->PC = pc;
+		vm->ExecuteOp();
+	}
+
+	/// Hands control back to the interpreter at `pc`.
+	static void Exit(FoxVM* vm, uint32 pc) { vm->PC = pc; }
+
+	static void PushImm(FoxVM* vm, uint32 type, uint32 value) { vm->Push32(static_cast<eFoxType>(type), value); }
+	static void PushVar(FoxVM* vm, uint32 var_index) { vm->PushVar(static_cast<uint16>(var_index)); }
+
+	static void PopVarInt32(FoxVM* vm, uint32 var_index) { vm->PopVarInt32(static_cast<uint16>(var_index)); }
+	static void PopVarFloat32(FoxVM* vm, uint32 var_index) { vm->PopVarFloat32(static_cast<uint16>(var_index)); }
+
+	static void PushVectorVar(FoxVM* vm, uint32 var_index) { vm->PushVectorVar(static_cast<uint16>(var_index)); }
+	static void PopVectorVar(FoxVM* vm, uint32 var_index) { vm->PopVectorVar(static_cast<uint16>(var_index)); }
+
+	// Ops without operands go straight to the handler for their base
+
+	static void Pop(FoxVM* vm, uint32 spec) { vm->DoPop(BcBase_Pop, static_cast<uint8>(spec)); }
+	static void Arith(FoxVM* vm, uint32 spec) { vm->DoArith(BcBase_Arith, static_cast<uint8>(spec)); }
+	static void Compare(FoxVM* vm, uint32 spec) { vm->DoCompare(BcBase_Compare, static_cast<uint8>(spec)); }
+	static void Variable(FoxVM* vm, uint32 spec) { vm->DoVariable(BcBase_Variable, static_cast<uint8>(spec)); }
+	static void Vector(FoxVM* vm, uint32 spec) { vm->DoVector(BcBase_Vector, static_cast<uint8>(spec)); }
+
+	static int32 GetCompareResult(FoxVM* vm) { return vm->CompareResult; }
+
+	static void Return(FoxVM* vm, uint32 spec) { vm->DoJump(BcBase_Jump, static_cast<uint8>(spec)); }
+
+	/**
+	 * @brief Calls a script proc and runs it until it returns, compiled if it is hot.
+	 * @returns Non-zero if the callee returned to `return_pc` and the caller can continue in compiled code. Otherwise the
+	 * VM was paused partway through the callee, and the rest is left to the interpreter.
+	 */
+	static int32 Call(FoxVM* vm, uint32 proc_offset, uint32 return_pc)
+	{
+		const int32 caller_scope = vm->ScopeIndex;
+
+		// Same as `BcSpecJump_CallAbsolute`. Pushing the variable base index enters the callee's scope, and the
+		// callee's return op leaves it again (see `FoxVM::PushVarBaseIndex()` and `FoxVM::PopVarBaseIndex()`), so
+		// the callee has returned once the scope index is back to `caller_scope`.
+		vm->PushVarBaseIndex();
+		vm->PushReturnAddr(return_pc);
+		vm->PC = proc_offset;
+
+		DebugAssert(vm->ScopeIndex == caller_scope + 1);
+
+		vm->mpJit->Enter(vm);
+
+		// Interpret anything the compiled code did not finish (or all of the callee, if it is not compiled), up to the
+		// callee's return
+		while (vm->ScopeIndex > caller_scope && !vm->bIsPaused && vm->PC < vm->mBytecode.Size) {
+			vm->ExecuteOp();
+		}
+
+		return (vm->ScopeIndex == caller_scope && !vm->bIsPaused && vm->PC == return_pc);
+	}
+};
+
+
+///////////////////////////////////////////
+// Decoding
+///////////////////////////////////////////
+
+enum class eFoxJitOp : uint8
+{
+	/// Does nothing in the interpreter beyond advancing the PC.
+	Nop,
+
+	/// Calls a helper and continues with the next op.
+	Helper,
+
+	Jump,
+	JumpIf,
+	Call,
+	Return,
+	Pause,
+
+	/// Not supported, control is handed back to the interpreter.
+	Exit,
+};
+
+struct FoxJitOp
+{
+	eFoxJitOp Kind = eFoxJitOp::Exit;
+
+	uint8 Base = 0;
+	uint8 Spec = 0;
+	uint32 Size = 2;
+
+	const void* pHelper = nullptr;
+	uint32 NumArgs = 0;
+	uint32 Args[FoxX64Emitter::scMaxHelperArgs] = {};
+
+	/// The jump target, or the proc offset for calls.
+	uint32 Target = 0;
+	FoxX64Emitter::eCondition Condition = FoxX64Emitter::eCondition::Equal;
+};
+
+/// Reads operands in the same order as `FoxVM::Read16()` and `FoxVM::Read32()`. Operands past the end of the bytecode
+/// read as zero, and the op is rejected by `DecodeOp()`.
+static uint16 ReadOperand16(const SizedArray<uint8>& bytecode, uint32 pc)
+{
+	if (pc + 2 > bytecode.Size) {
+		return 0;
+	}
+
+	return static_cast<uint16>((static_cast<uint16>(bytecode[pc]) << 8) | bytecode[pc + 1]);
+}
+
+static uint32 ReadOperand32(const SizedArray<uint8>& bytecode, uint32 pc)
+{
+	return (static_cast<uint32>(ReadOperand16(bytecode, pc)) << 16) | ReadOperand16(bytecode, pc + 2);
+}
+
+template <typename TFunc>
+static void SetHelper(FoxJitOp& op, TFunc* helper, uint32 num_args = 0, uint32 arg0 = 0, uint32 arg1 = 0)
+{
+	op.Kind = eFoxJitOp::Helper;
+	op.pHelper = reinterpret_cast<const void*>(helper);
+	op.NumArgs = num_args;
+	op.Args[0] = arg0;
+	op.Args[1] = arg1;
+}
+
+static void SetInterpret(FoxJitOp& op, uint32 pc, uint32 size)
+{
+	SetHelper(op, &FoxJitHelpers::Interpret, 1, pc);
+	op.Size = size;
+}
+
+/**
+ * @brief Decodes the op at `pc`. Op sizes match the number of bytes the interpreter reads for the op, including when
+ * the interpreter skips an op it does not handle.
+ */
+static FoxJitOp DecodeOp(const FoxVM* vm, uint32 pc)
+{
+	const SizedArray<uint8>& bytecode = vm->mBytecode;
+
+	FoxJitOp op {};
+
+	if (pc + 2 > bytecode.Size) {
+		return op;
+	}
+
+	op.Base = bytecode[pc];
+	op.Spec = bytecode[pc + 1];
+
+	const uint32 operands = pc + 2;
+
+	switch (op.Base) {
+	// The interpreter skips ops with a zero base. These are hit when a conditional jump lands on the offset of the
+	// jump that follows it.
+	case 0:
+		op.Kind = eFoxJitOp::Nop;
+		break;
+
+	case BcBase_Push:
+		if (op.Spec == BcSpecPush_Int32 || op.Spec == BcSpecPush_Float32 || op.Spec == BcSpecPush_String) {
+			static constexpr eFoxType scPushTypes[] = { eFoxType::INT, eFoxType::FLOAT, eFoxType::STRING };
+			const eFoxType type = scPushTypes[op.Spec - BcSpecPush_Int32];
+
+			SetHelper(op, &FoxJitHelpers::PushImm, 2, static_cast<uint32>(type), ReadOperand32(bytecode, operands));
+			op.Size = 6;
+		}
+		else if (op.Spec == BcSpecPush_Var) {
+			SetHelper(op, &FoxJitHelpers::PushVar, 1, ReadOperand16(bytecode, operands));
+			op.Size = 4;
+		}
+		else if (op.Spec == BcSpecPush_VarPtr || op.Spec == BcSpecPush_ReadPtr) {
+			SetInterpret(op, pc, 4);
+		}
+		break;
+
+	case BcBase_Pop:
+		if (op.Spec == BcSpecPop_Variable_Int32) {
+			SetHelper(op, &FoxJitHelpers::PopVarInt32, 1, ReadOperand16(bytecode, operands));
+			op.Size = 4;
+		}
+		else if (op.Spec == BcSpecPop_Variable_Float32) {
+			SetHelper(op, &FoxJitHelpers::PopVarFloat32, 1, ReadOperand16(bytecode, operands));
+			op.Size = 4;
+		}
+		else if (op.Spec == BcSpecPop_Discard) {
+			SetHelper(op, &FoxJitHelpers::Pop, 1, op.Spec);
+		}
+		break;
+
+	case BcBase_Arith:
+		if (op.Spec >= BcSpecArith_Add_Int32 && op.Spec <= BcSpecArith_Multiply_Float32) {
+			SetHelper(op, &FoxJitHelpers::Arith, 1, op.Spec);
+		}
+		break;
+
+	case BcBase_Compare:
+		if (op.Spec == BcSpecCompare_Default || op.Spec == BcSpecCompare_NotZero) {
+			SetHelper(op, &FoxJitHelpers::Compare, 1, op.Spec);
+		}
+		break;
+
+	case BcBase_Jump:
+		switch (op.Spec) {
+		case BcSpecJump_Relative:
+			op.Kind = eFoxJitOp::Jump;
+			op.Size = 4;
+			op.Target = pc + op.Size + ReadOperand16(bytecode, operands);
+			break;
+
+		case BcSpecJump_Equal:
+		case BcSpecJump_NotEqual:
+		case BcSpecJump_Less:
+		case BcSpecJump_LessEqual:
+		case BcSpecJump_Greater:
+		case BcSpecJump_GreaterEqual: {
+			using eCondition = FoxX64Emitter::eCondition;
+
+			op.Kind = eFoxJitOp::JumpIf;
+			op.Size = 4;
+			op.Target = pc + op.Size + ReadOperand16(bytecode, operands);
+
+			switch (op.Spec) {
+			case BcSpecJump_Equal:
+				op.Condition = eCondition::Equal;
+				break;
+			case BcSpecJump_NotEqual:
+				op.Condition = eCondition::NotEqual;
+				break;
+			case BcSpecJump_Less:
+				op.Condition = eCondition::Less;
+				break;
+			case BcSpecJump_LessEqual:
+				op.Condition = eCondition::LessEqual;
+				break;
+			case BcSpecJump_Greater:
+				op.Condition = eCondition::Greater;
+				break;
+			default:
+				op.Condition = eCondition::GreaterEqual;
+				break;
+			}
+
+			break;
+		}
+
+		case BcSpecJump_Absolute:
+			op.Kind = eFoxJitOp::Jump;
+			op.Size = 6;
+			op.Target = ReadOperand32(bytecode, operands);
+			break;
+
+		case BcSpecJump_CallAbsolute:
+			// The symbol table does not change after loading, so the proc can be looked up once here
+			op.Kind = eFoxJitOp::Call;
+			op.Size = 6;
+			op.Target = vm->GetProcAddr(ReadOperand32(bytecode, operands));
+			break;
+
+		case BcSpecJump_CallModuleFunction:
+			SetInterpret(op, pc, 8);
+			break;
+
+		case BcSpecJump_CallExternal:
+			SetInterpret(op, pc, 6);
+			break;
+
+		case BcSpecJump_ReturnToCaller:
+		case BcSpecJump_ReturnToCaller_Int32:
+		case BcSpecJump_ReturnToCaller_Float32:
+		case BcSpecJump_ReturnToCaller_String:
+		case BcSpecJump_ReturnToCaller_Vec3:
+		case BcSpecJump_ReturnToCaller_Vec4:
+		case BcSpecJump_ReturnToCaller_Quat:
+			op.Kind = eFoxJitOp::Return;
+			break;
+
+		case BcSpecJump_Pause:
+			op.Kind = eFoxJitOp::Pause;
+			op.Size = 4;
+			break;
+
+		default:
+			break;
+		}
+		break;
+
+	case BcBase_Data:
+		if (op.Spec == BcSpecData_String && operands + 2 <= bytecode.Size) {
+			op.Kind = eFoxJitOp::Nop;
+			op.Size = 4 + ReadOperand16(bytecode, operands);
+		}
+		break;
+
+	case BcBase_Marker:
+		if (op.Spec == BcSpecMarker_FrameBegin || op.Spec == BcSpecMarker_FrameEnd) {
+			op.Kind = eFoxJitOp::Nop;
+		}
+		break;
+
+	case BcBase_Variable:
+		switch (op.Spec) {
+		case BcSpecVariable_Cast_Int32:
+		case BcSpecVariable_Cast_Float32:
+			SetHelper(op, &FoxJitHelpers::Variable, 1, op.Spec);
+			break;
+
+		case BcSpecVariable_Define_Int32:
+		case BcSpecVariable_Define_Float32:
+		case BcSpecVariable_Define_String:
+		case BcSpecVariable_DefineFetchParam_Int32:
+		case BcSpecVariable_DefineFetchParam_Float32:
+		case BcSpecVariable_DefineFetchParam_String:
+			SetInterpret(op, pc, 4);
+			break;
+
+		case BcSpecVariable_Set_Var:
+		case BcSpecVariable_SetPtr_Var:
+		case BcSpecVariable_Define_Vector:
+		case BcSpecVariable_DefineFetchParam_Vector:
+			SetInterpret(op, pc, 6);
+			break;
+
+		case BcSpecVariable_Set_Int32:
+		case BcSpecVariable_Set_Float32:
+		case BcSpecVariable_Set_String:
+		case BcSpecVariable_SetPtr_Int32:
+		case BcSpecVariable_SetPtr_Float32:
+		case BcSpecVariable_SetPtr_String:
+		case BcSpecVariable_DefineGlobal_Int32:
+		case BcSpecVariable_DefineGlobal_Float32:
+		case BcSpecVariable_DefineGlobal_String:
+			SetInterpret(op, pc, 8);
+			break;
+
+		case BcSpecVariable_DefineGlobal_Vector:
+			SetInterpret(op, pc, 10);
+			break;
+
+		default:
+			break;
+		}
+		break;
+
+	case BcBase_Vector:
+		if (op.Spec == BcSpecVector_PushVar) {
+			SetHelper(op, &FoxJitHelpers::PushVectorVar, 1, ReadOperand16(bytecode, operands));
+			op.Size = 4;
+		}
+		else if (op.Spec == BcSpecVector_PopVar) {
+			SetHelper(op, &FoxJitHelpers::PopVectorVar, 1, ReadOperand16(bytecode, operands));
+			op.Size = 4;
+		}
+		else if (op.Spec >= BcSpecVector_Discard && op.Spec <= BcSpecVector_GetW) {
+			SetHelper(op, &FoxJitHelpers::Vector, 1, op.Spec);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	// The operands of the op are past the end of the bytecode, leave it to the interpreter to report
+	if (pc + op.Size > bytecode.Size) {
+		op.Kind = eFoxJitOp::Exit;
+		op.Size = 2;
+	}
+
+	return op;
+}
+
+static FX_FORCE_INLINE bool IsProcMarker(const FoxJitOp& op)
+{
+	return op.Base == BcBase_Marker && (op.Spec == BcSpecMarker_Proc || op.Spec == BcSpecMarker_ProcEnd);
+}
+
+static FX_FORCE_INLINE bool FallsThrough(eFoxJitOp kind)
+{
+	return kind != eFoxJitOp::Jump && kind != eFoxJitOp::Return && kind != eFoxJitOp::Pause &&
+		   kind != eFoxJitOp::Exit;
+}
+
+
+///////////////////////////////////////////
+// JIT
+///////////////////////////////////////////
+
+bool FoxJit::IsSupported()
+{
+#ifdef FX_USE_FOX_JIT
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FoxJit::FindProcs(const FoxVM* vm)
+{
+	const SizedArray<uint8>& bytecode = vm->mBytecode;
+
+	for (const FoxSymbol& sym : vm->SymTable) {
+		// Only procs with a body are preceded by a proc marker
+		if (sym.Offset < 2 || sym.Offset >= bytecode.Size) {
+			continue;
+		}
+
+		if (bytecode[sym.Offset - 2] == BcBase_Marker && bytecode[sym.Offset - 1] == BcSpecMarker_Proc) {
+			mProcs.try_emplace(sym.Offset);
+		}
+	}
+}
+
+bool FoxJit::Enter(FoxVM* vm)
+{
+	if (!IsSupported()) {
+		return false;
+	}
+
+	// Every VM that shares the JIT runs the same bytecode, so the procs can be found from whichever VM enters first
+	std::call_once(mFindProcsFlag, [&]() { FindProcs(vm); });
+
+	auto it = mProcs.find(vm->PC);
+	if (it == mProcs.end()) {
+		return false;
+	}
+
+	ProcEntry& entry = it->second;
+
+	CompiledProc code = entry.pCode.load(std::memory_order_acquire);
+
+	if (!code) {
+		if (entry.bFailed.load(std::memory_order_relaxed) ||
+			entry.CallCount.fetch_add(1, std::memory_order_relaxed) + 1 < CallThreshold) {
+			return false;
+		}
+
+		code = CompileEntry(vm, entry);
+
+		if (!code) {
+			return false;
+		}
+	}
+
+	code(vm);
+
+	return true;
+}
+
+FoxJit::CompiledProc FoxJit::CompileEntry(FoxVM* vm, ProcEntry& entry)
+{
+	std::lock_guard<std::mutex> lock(mCompileMutex);
+
+	// Another VM may have compiled the proc (or failed to) while this one was waiting
+	CompiledProc code = entry.pCode.load(std::memory_order_relaxed);
+
+	if (code || entry.bFailed.load(std::memory_order_relaxed)) {
+		return code;
+	}
+
+	code = Compile(vm, vm->PC);
+
+	if (!code) {
+		entry.bFailed.store(true, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	entry.pCode.store(code, std::memory_order_release);
+
+	return code;
+}
+
+FoxJit::CompiledProc FoxJit::Compile(FoxVM* vm, uint32 proc_offset)
+{
+	// Find the end of the proc
+	uint32 proc_end = proc_offset;
+	uint32 num_ops = 0;
+
+	while (proc_end < vm->mBytecode.Size) {
+		const FoxJitOp op = DecodeOp(vm, proc_end);
+
+		if (IsProcMarker(op)) {
+			break;
+		}
+
+		if (++num_ops > scMaxProcOps) {
+			LogWarning(LC_SCRIPT, "JIT: Proc at {} has more than {} ops, leaving it to the interpreter", proc_offset,
+					   scMaxProcOps);
+			return nullptr;
+		}
+
+		proc_end += op.Size;
+	}
+
+	if (proc_end > vm->mBytecode.Size) {
+		proc_end = vm->mBytecode.Size;
+	}
+
+	const uint32 proc_size = proc_end - proc_offset;
+
+	if (proc_size == 0) {
+		return nullptr;
+	}
+
+	// Find every op that can be reached from the start of the proc. Jumps can land partway through another op (see
+	// `DecodeOp()`), so ops are decoded from each jump target rather than in a single pass.
+	std::vector<uint8> is_reachable(proc_size, 0);
+	std::vector<uint32> pending { proc_offset };
+
+	auto is_in_proc = [&](uint32 pc) { return pc >= proc_offset && pc < proc_end; };
+
+	while (!pending.empty()) {
+		const uint32 pc = pending.back();
+		pending.pop_back();
+
+		if (!is_in_proc(pc) || is_reachable[pc - proc_offset]) {
+			continue;
+		}
+
+		is_reachable[pc - proc_offset] = 1;
+
+		const FoxJitOp op = DecodeOp(vm, pc);
+
+		if (op.Kind == eFoxJitOp::Jump || op.Kind == eFoxJitOp::JumpIf) {
+			pending.push_back(op.Target);
+		}
+
+		if (FallsThrough(op.Kind)) {
+			pending.push_back(pc + op.Size);
+		}
+	}
+
+	// Emit code for each reachable op in bytecode order
+
+	constexpr uint32 cEpilogueTarget = UINT32_MAX;
+	constexpr int32 cNoLabel = -1;
+
+	struct JumpFixup
+	{
+		uint32 DisplacementOffset;
+		uint32 TargetPC;
+	};
+
+	std::vector<int32> labels(proc_size, cNoLabel);
+	std::vector<JumpFixup> fixups;
+
+	FoxX64Emitter emitter;
+	emitter.Code.reserve(proc_size * FoxX64Emitter::scMaxCallSize);
+
+	emitter.EmitPrologue();
+
+	auto emit_jump_to = [&](uint32 target_pc) { fixups.push_back({ emitter.EmitJump(), target_pc }); };
+
+	num_ops = 0;
+
+	for (uint32 pc = proc_offset; pc < proc_end; pc++) {
+		if (!is_reachable[pc - proc_offset]) {
+			continue;
+		}
+
+		labels[pc - proc_offset] = static_cast<int32>(emitter.GetSize());
+		++num_ops;
+
+		const FoxJitOp op = DecodeOp(vm, pc);
+		const uint32 next_pc = pc + op.Size;
+
+		switch (op.Kind) {
+		case eFoxJitOp::Nop:
+			break;
+
+		case eFoxJitOp::Helper:
+			emitter.EmitCall(op.pHelper, op.NumArgs, op.Args[0], op.Args[1], op.Args[2]);
+			break;
+
+		case eFoxJitOp::Jump:
+			emit_jump_to(op.Target);
+			break;
+
+		case eFoxJitOp::JumpIf:
+			emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::GetCompareResult));
+			emitter.EmitTestResult();
+			fixups.push_back({ emitter.EmitJumpIf(op.Condition), op.Target });
+			break;
+
+		case eFoxJitOp::Call:
+			emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::Call), 2, op.Target, next_pc);
+			emitter.EmitTestResult();
+			fixups.push_back({ emitter.EmitJumpIf(FoxX64Emitter::eCondition::Equal), cEpilogueTarget });
+			break;
+
+		case eFoxJitOp::Return:
+			emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::Return), 1, op.Spec);
+			emit_jump_to(cEpilogueTarget);
+			break;
+
+		case eFoxJitOp::Pause:
+			// The interpreter sets up the pause and moves past it, the VM is then resumed from there
+			emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::Interpret), 1, pc);
+			emit_jump_to(cEpilogueTarget);
+			break;
+
+		case eFoxJitOp::Exit:
+			emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::Exit), 1, pc);
+			emit_jump_to(cEpilogueTarget);
+			break;
+		}
+
+		if (!FallsThrough(op.Kind)) {
+			continue;
+		}
+
+		// Jump to the next op if it is not emitted directly after this one
+		uint32 next_emitted = pc + 1;
+		while (next_emitted < proc_end && !is_reachable[next_emitted - proc_offset]) {
+			++next_emitted;
+		}
+
+		if (next_emitted != next_pc) {
+			emit_jump_to(next_pc);
+		}
+	}
+
+	const uint32 epilogue_offset = emitter.GetSize();
+	emitter.EmitEpilogue();
+
+	// Jumps that leave the proc hand control back to the interpreter
+	std::vector<std::pair<uint32, uint32>> exit_labels;
+
+	for (const JumpFixup& fixup : fixups) {
+		uint32 target_offset = epilogue_offset;
+
+		if (fixup.TargetPC != cEpilogueTarget && is_in_proc(fixup.TargetPC)) {
+			target_offset = static_cast<uint32>(labels[fixup.TargetPC - proc_offset]);
+		}
+		else if (fixup.TargetPC != cEpilogueTarget) {
+			auto exit_it = std::find_if(exit_labels.begin(), exit_labels.end(),
+										[&](const auto& label) { return label.first == fixup.TargetPC; });
+
+			if (exit_it != exit_labels.end()) {
+				target_offset = exit_it->second;
+			}
+			else {
+				target_offset = emitter.GetSize();
+				exit_labels.push_back({ fixup.TargetPC, target_offset });
+
+				emitter.EmitCall(reinterpret_cast<const void*>(&FoxJitHelpers::Exit), 1, fixup.TargetPC);
+				emitter.PatchJump(emitter.EmitJump(), epilogue_offset);
+			}
+		}
+
+		emitter.PatchJump(fixup.DisplacementOffset, target_offset);
+	}
+
+	uint8* code = CommitCode(emitter.Code);
+	if (!code) {
+		return nullptr;
+	}
+
+	mNumCompiledProcs.fetch_add(1, std::memory_order_relaxed);
+
+	LogInfo(LC_SCRIPT, "JIT: Compiled proc at {} ({} ops, {} bytes of code)", proc_offset, num_ops, emitter.GetSize());
+
+	return reinterpret_cast<CompiledProc>(code);
+}
+
+uint8* FoxJit::CommitCode(const std::vector<uint8>& code)
+{
+#ifdef FX_USE_FOX_JIT
+	const uint64 page_size = static_cast<uint64>(sysconf(_SC_PAGESIZE));
+
+	// Each proc starts on a new page. Other VMs sharing the JIT may be running code on the earlier pages of a block, so
+	// only pages that have not been committed yet are ever writable.
+	const uint64 size = (code.size() + page_size - 1) & ~(page_size - 1);
+
+	CodeBlock* block = mCodeBlocks.empty() ? nullptr : &mCodeBlocks.back();
+
+	if (!block || block->Used + size > block->Size) {
+		const uint64 block_size = std::max(size, scCodeBlockSize);
+
+		void* data = mmap(nullptr, block_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (data == MAP_FAILED) {
+			LogError(LC_SCRIPT, "JIT: Could not map {} bytes for code", block_size);
+			return nullptr;
+		}
+
+		mCodeBlocks.push_back(CodeBlock { .pData = static_cast<uint8*>(data), .Size = block_size, .Used = 0 });
+		block = &mCodeBlocks.back();
+	}
+
+	uint8* dest = block->pData + block->Used;
+	memcpy(dest, code.data(), code.size());
+
+	block->Used += size;
+
+	if (mprotect(dest, size, PROT_READ | PROT_EXEC) != 0) {
+		LogError(LC_SCRIPT, "JIT: Could not make code executable");
+		return nullptr;
+	}
+
+	return dest;
+#else
+	return nullptr;
+#endif
+}
+
+FoxJit::~FoxJit()
+{
+#ifdef FX_USE_FOX_JIT
+	for (const CodeBlock& block : mCodeBlocks) {
+		munmap(block.pData, block.Size);
+	}
+#endif
+
+	mCodeBlocks.clear();
+}
+
+} // namespace fx::script
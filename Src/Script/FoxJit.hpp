@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace fx::script {
+
+class FoxVM;
+
+/**
+ * @brief Baseline JIT for FoxScript procs.
+ *
+ * Each time a script proc is entered its call count is incremented, and once the count passes `CallThreshold` the
+ * proc is compiled to x86-64 machine code. The generated code calls into the VM for each instruction with the operands
+ * already decoded, so the dispatch loop and operand decoding are removed while the semantics stay exactly those of the
+ * interpreter. Jumps, calls and returns are compiled to native branches.
+ *
+ * All VM state lives in the VM rather than in registers, so compiled code can hand control back to the interpreter
+ * at any instruction. This is done for opcodes that the JIT does not support, jumps out of the proc, and pauses.
+ *
+ * Compiled code only depends on the bytecode, with the VM passed in on each call. A JIT is created for each bytecode
+ * image (see `FoxBytecodeImage`) and shared by every VM that runs the image, so a script attached to many objects is
+ * compiled once, and the call counts of all of its instances add up towards `CallThreshold`. VMs sharing a JIT may run
+ * on different threads: compiled procs are looked up without locking, and procs are compiled under a lock.
+ */
+class FoxJit
+{
+	using CompiledProc = void (*)(FoxVM* vm);
+
+	struct ProcEntry
+	{
+		std::atomic<CompiledProc> pCode { nullptr };
+		std::atomic<uint32> CallCount { 0 };
+
+		/// Set if the proc could not be compiled, so it is not attempted again.
+		std::atomic<bool> bFailed { false };
+	};
+
+	struct CodeBlock
+	{
+		uint8* pData = nullptr;
+		uint64 Size = 0;
+		uint64 Used = 0;
+	};
+
+public:
+	static constexpr uint32 scDefaultCallThreshold = 32;
+
+	/// Procs with more instructions than this are left to the interpreter.
+	static constexpr uint32 scMaxProcOps = 8192;
+
+public:
+	explicit FoxJit(uint32 call_threshold = scDefaultCallThreshold) : CallThreshold(call_threshold) {}
+
+	FoxJit(const FoxJit& other) = delete;
+	FoxJit& operator=(const FoxJit& other) = delete;
+
+	/**
+	 * @brief Returns true if the JIT is supported on this platform. When it is not, `Enter()` never runs any code.
+	 */
+	static bool IsSupported();
+
+	/**
+	 * @brief Counts a call to the proc starting at the VM's PC, compiling it if it is hot, and runs the compiled code.
+	 *
+	 * When this returns true the compiled code has run, and the VM's PC is where the interpreter should continue from.
+	 * This is the return address if the proc ran to completion.
+	 *
+	 * @returns False if the PC is not the start of a proc or the proc is not compiled. The VM is left untouched.
+	 */
+	bool Enter(FoxVM* vm);
+
+	/// The number of procs that have been compiled.
+	FX_FORCE_INLINE uint32 GetNumCompiledProcs() const { return mNumCompiledProcs.load(std::memory_order_relaxed); }
+
+	~FoxJit();
+
+private:
+	void FindProcs(const FoxVM* vm);
+
+	/**
+	 * @brief Compiles the proc for `entry` unless another VM has already done so or it has failed before.
+	 */
+	CompiledProc CompileEntry(FoxVM* vm, ProcEntry& entry);
+
+	CompiledProc Compile(FoxVM* vm, uint32 proc_offset);
+
+	uint8* CommitCode(const std::vector<uint8>& code);
+
+public:
+	/// Should only be changed before the JIT is shared with other VMs.
+	uint32 CallThreshold = scDefaultCallThreshold;
+
+private:
+	/// Procs in the bytecode, keyed by their start offset. The map is filled once by the first VM to enter, and only
+	/// the entries change after that.
+	std::unordered_map<uint32, ProcEntry> mProcs;
+	std::once_flag mFindProcsFlag;
+
+	/// Held while compiling a proc and committing its code.
+	std::mutex mCompileMutex;
+
+	std::vector<CodeBlock> mCodeBlocks;
+
+	std::atomic<uint32> mNumCompiledProcs { 0 };
+};
+
+} // namespace fx::script
@@ -13,18 +13,19 @@
 
 namespace fx::script {
 
-#define FX_SCRIPT_ALLOC_NODE(type_)          gScriptMemPool->Alloc<type_>(sizeof(type_))
-#define FX_SCRIPT_ALLOC_MEMORY(type_, size_) gScriptMemPool->Alloc<type_>(size_)
-#define FX_SCRIPT_FREE(type_, ptr_)          gScriptMemPool->Free<type_>(ptr_);
+// All nodes are allocated from the compile arena and are released with it, so they are never freed individually.
+#define FX_SCRIPT_ALLOC_NODE(type_, ...) mpArena->Alloc<type_>(__VA_ARGS__)
 
-void FoxParser::Init(PagedArray<Token>&& tokens)
+void FoxParser::Init(Arena* arena, const ArenaArray<Token>& tokens)
 {
-    mTokens = std::move(tokens);
+    mpArena = arena;
+    mTokens = tokens;
 
-    mScopes.Create(8);
-    mCurrentScope = mScopes.Insert();
-    mCurrentScope->Vars.Create(FX_SCRIPT_SCOPE_GLOBAL_VARS_START_SIZE);
-    mCurrentScope->Functions.Create(FX_SCRIPT_SCOPE_GLOBAL_ACTIONS_START_SIZE);
+    mpGlobalScope = mpArena->Alloc<FoxScope>(mpArena, nullptr);
+    mpGlobalScope->Vars.Reserve(FX_SCRIPT_SCOPE_GLOBAL_VARS_START_SIZE);
+    mpGlobalScope->Functions.Reserve(FX_SCRIPT_SCOPE_GLOBAL_ACTIONS_START_SIZE);
+
+    mCurrentScope = mpGlobalScope;
 }
 
 Token& FoxParser::GetToken(int offset)
@@ -49,15 +50,12 @@ Token* FoxParser::CreateTokenFromString(eTokenType type, const char* text)
 {
     const uint32 name_len = strlen(text);
 
-    Token* token = FX_SCRIPT_ALLOC_MEMORY(Token, sizeof(Token));
-    token->Start = FX_SCRIPT_ALLOC_MEMORY(char, name_len);
+    Token* token = mpArena->Alloc<Token>();
+    token->Start = mpArena->CopyString(text, name_len);
     token->End = token->Start + name_len;
     token->Length = name_len;
     token->Type = type;
 
-    // Copy the name to the buffer in the name token
-    memcpy(token->Start, text, name_len);
-
     return token;
 }
 
@@ -113,7 +111,7 @@ FoxAstNode* FoxParser::TryParseKeyword(FoxAstBlock* parent_block, bool* ignore_s
 
     case kw_global:
         EatToken(TT::Identifier);
-        return ParseVarDeclare(&mScopes[0]);
+        return ParseVarDeclare(mpGlobalScope);
 
     case kw_if:
         EatToken(TT::Identifier);
@@ -149,22 +147,19 @@ void FoxParser::PushScope()
 {
     FoxScope* current = mCurrentScope;
 
-    FoxScope* new_scope = mScopes.Insert();
-    new_scope->Parent = current;
-    new_scope->Vars.Create(FX_SCRIPT_SCOPE_LOCAL_VARS_START_SIZE);
-    new_scope->Functions.Create(FX_SCRIPT_SCOPE_LOCAL_ACTIONS_START_SIZE);
+    // Scopes are never removed from the arena, so any references to the scope in the AST remain valid after it is
+    // popped.
+    FoxScope* new_scope = mpArena->Alloc<FoxScope>(mpArena, current);
+    new_scope->Vars.Reserve(FX_SCRIPT_SCOPE_LOCAL_VARS_START_SIZE);
 
     mCurrentScope = new_scope;
 }
 
 void FoxParser::PopScope()
 {
-    FoxScope* new_scope = mCurrentScope->Parent;
-    mScopes.RemoveLast();
+    assert(mCurrentScope->Parent != nullptr);
 
-    assert(new_scope == &mScopes.GetLast());
-
-    mCurrentScope = new_scope;
+    mCurrentScope = mCurrentScope->Parent;
 }
 
 FoxAstVarDecl* FoxParser::InternalVarDeclare(Token* name_token, Token* type_token, FoxScope* scope)
@@ -180,11 +175,10 @@ FoxAstVarDecl* FoxParser::InternalVarDeclare(Token* name_token, Token* type_toke
     node->pTypeToken = type_token;
     node->Type = FoxStringToType(type_token);
 
-    node->bDefineAsGlobal = (scope == &mScopes[0]);
+    node->bDefineAsGlobal = (scope == mpGlobalScope);
 
     // Push the variable to the scope
-    FoxVar var { name_token, type_token, scope };
-    scope->Vars.Insert(var);
+    scope->Vars.Insert(mpArena->Alloc<FoxVar>(name_token, type_token, scope));
 
     return node;
 }
@@ -208,13 +202,13 @@ FoxAstVarDecl* FoxParser::ParseVarDeclare(FoxScope* scope)
     node->pTypeToken = &type;
     node->Type = FoxStringToType(node->pTypeToken);
 
-    node->bDefineAsGlobal = (scope == &mScopes[0]);
+    node->bDefineAsGlobal = (scope == mpGlobalScope);
 
-    FoxVar var { &type, &name, scope };
+    FoxVar* var = mpArena->Alloc<FoxVar>(&type, &name, scope);
 
     node->pAssignment = TryParseAssignment(node->pNameToken);
     /*if (node->Assignment) {
-        var.Value = node->Assignment->Value;
+        var->Value = node->Assignment->Value;
     }*/
     scope->Vars.Insert(var);
 
@@ -254,10 +248,10 @@ FoxFunction* FoxParser::FindFunction(Hash32 hashed_name)
     return nullptr;
 }
 
-FoxFunction* FoxParser::FindModuleFunction(const String& module_alias, Hash32 hashed_name)
+FoxFunction* FoxParser::FindModuleFunction(Hash32 module_alias, Hash32 hashed_name)
 {
     // Find the cached module
-    auto it = CachedModules.find(module_alias.Str());
+    auto it = CachedModules.find(module_alias);
     if (it == CachedModules.end()) {
         return nullptr;
     }
@@ -273,8 +267,8 @@ void FoxParser::PrintFunctionTable(const FoxScope& scope) const
     LogInfo("|| Name             | Hash             ||");
     LogInfo("||-------------------------------------||");
 
-    for (const FoxFunction& function : scope.Functions) {
-        LogInfo("|| {:16} | {:16} ||", function.Name->GetStr(), function.Name->GetHash());
+    for (const FoxFunction* function : scope.Functions) {
+        LogInfo("|| {:16} | {:16} ||", function->Name->GetStr(), function->Name->GetHash());
     }
 
     LogInfo("||-------------------------------------||");
@@ -329,7 +323,7 @@ FoxValue FoxParser::ParseValue()
     case TT::String:
         EatToken(TT::String);
         value.Type = eFoxType::STRING;
-        value.ValueString = token.GetHeapStr();
+        value.ValueString = mpArena->CopyString(token.Start, token.Length);
         break;
     default:;
     }
@@ -582,10 +576,10 @@ FoxAstModuleLoad* FoxParser::ParseModuleLoad()
     node->pAlias = alias_token;
     node->pModulePath = path_token;
 
-    std::string path_str = node->pAlias->GetStr();
+    const Hash32 alias_hash = node->pAlias->GetHash();
 
-    if (mModuleLoads.find(path_str) == mModuleLoads.end()) {
-        mModuleLoads[path_str] = node;
+    if (mModuleLoads.find(alias_hash) == mModuleLoads.end()) {
+        mModuleLoads[alias_hash] = node;
     }
 
     Path mod_header_path(node->pModulePath->GetStr());
@@ -595,15 +589,17 @@ FoxAstModuleLoad* FoxParser::ParseModuleLoad()
     File mod_header_file(mod_header_path.Str(), File::eModType::Read, File::eDataType::Binary);
 
     if (mod_header_file.IsFileOpen()) {
-        Slice<char> file_data = mod_header_file.Read<char>();
+        // The header's tokens point into the file data, so read it into the arena to keep it alive with the AST
+        const uint64 file_size = mod_header_file.GetFileSize();
+        Slice<char> file_data = mod_header_file.Read(MakeSlice(mpArena->AllocArray<char>(file_size), file_size));
 
-        Tokenizer tokenizer(file_data.pData, file_data.Size);
+        Tokenizer tokenizer(file_data.pData, file_data.Size, mpArena);
         tokenizer.SetFileExtension(".fox");
         tokenizer.Tokenize();
 
-        FoxParser* parser = new FoxParser();
+        FoxParser* parser = mpArena->Alloc<FoxParser>();
 
-        parser->Init(std::move(tokenizer.TokenBuffer));
+        parser->Init(mpArena, tokenizer.ArenaTokens);
 
         FoxAstNode* module_ast = parser->Parse();
         if (parser->bHasErrors || module_ast == nullptr) {
@@ -612,7 +608,7 @@ FoxAstModuleLoad* FoxParser::ParseModuleLoad()
         }
 
 
-        CachedModules[node->pAlias->GetStr()] = FoxCachedModule { .pParser = parser, .pAstTree = module_ast };
+        CachedModules[alias_hash] = FoxCachedModule { .pParser = parser, .pAstTree = module_ast };
     }
 
     return node;
@@ -620,7 +616,7 @@ FoxAstModuleLoad* FoxParser::ParseModuleLoad()
 
 FoxAstBlock* FoxParser::ParseBlock()
 {
-    FoxAstBlock* block = FX_SCRIPT_ALLOC_NODE(FoxAstBlock);
+    FoxAstBlock* block = FX_SCRIPT_ALLOC_NODE(FoxAstBlock, mpArena);
 
     EatToken(TT::LBrace);
 
@@ -629,7 +625,7 @@ FoxAstBlock* FoxParser::ParseBlock()
         if (command == nullptr) {
             break;
         }
-        block->Statements.push_back(command);
+        block->Statements.Insert(command);
     }
 
     EatToken(TT::RBrace);
@@ -649,7 +645,7 @@ FoxAstFunctionDecl* FoxParser::ParseFunctionDeclare()
     PushScope();
     EatToken(TT::LParen);
 
-    FoxAstBlock* params = FX_SCRIPT_ALLOC_NODE(FoxAstBlock);
+    FoxAstBlock* params = FX_SCRIPT_ALLOC_NODE(FoxAstBlock, mpArena);
 
     // Parse the parameter list
     while (GetToken().Type != TT::RParen) {
@@ -664,7 +660,7 @@ FoxAstFunctionDecl* FoxParser::ParseFunctionDeclare()
             break;
         }
 
-        params->Statements.push_back(ParseVarDeclare());
+        params->Statements.Insert(ParseVarDeclare());
 
         if (GetToken().Type == TT::Comma) {
             EatToken(TT::Comma);
@@ -696,8 +692,7 @@ FoxAstFunctionDecl* FoxParser::ParseFunctionDeclare()
 
     node->pParams = params;
 
-    FoxFunction function(&name, mCurrentScope, node->pBlock, node);
-    mCurrentScope->Functions.Insert(function);
+    mCurrentScope->Functions.Insert(mpArena->Alloc<FoxFunction>(&name, mCurrentScope, node->pBlock, node));
 
     return node;
 }
@@ -714,11 +709,11 @@ FoxAstFunctionDecl* FoxParser::ParseExtfnDeclare()
     PushScope();
     EatToken(TT::LParen);
 
-    FoxAstBlock* params = FX_SCRIPT_ALLOC_NODE(FoxAstBlock);
+    FoxAstBlock* params = FX_SCRIPT_ALLOC_NODE(FoxAstBlock, mpArena);
 
     // Parse the parameter list
     while (GetToken().Type != TT::RParen) {
-        params->Statements.push_back(ParseVarDeclare());
+        params->Statements.Insert(ParseVarDeclare());
 
         if (GetToken().Type == TT::Comma) {
             EatToken(TT::Comma);
@@ -746,8 +741,7 @@ FoxAstFunctionDecl* FoxParser::ParseExtfnDeclare()
 
     node->pParams = params;
 
-    FoxFunction function(&name, mCurrentScope, nullptr, node);
-    mCurrentScope->Functions.Insert(function);
+    mCurrentScope->Functions.Insert(mpArena->Alloc<FoxFunction>(&name, mCurrentScope, nullptr, node));
 
     node->bIsExternal = true;
 
@@ -756,7 +750,7 @@ FoxAstFunctionDecl* FoxParser::ParseExtfnDeclare()
 
 FoxAstFunctionCall* FoxParser::ParseFunctionCall()
 {
-    FoxAstFunctionCall* node = FX_SCRIPT_ALLOC_NODE(FoxAstFunctionCall);
+    FoxAstFunctionCall* node = FX_SCRIPT_ALLOC_NODE(FoxAstFunctionCall, mpArena);
 
     Token& name = EatToken(TT::Identifier);
 
@@ -776,7 +770,7 @@ FoxAstFunctionCall* FoxParser::ParseFunctionCall()
             break;
         }
 
-        node->Params.push_back(param);
+        node->Params.Insert(param);
 
         TT next_tt = GetToken().Type;
 
@@ -793,17 +787,17 @@ FoxAstFunctionCall* FoxParser::ParseFunctionCall()
     return node;
 }
 
-FoxAstFunctionCall* FoxParser::ParseModuleFunctionCall(const std::string& module_name)
+FoxAstFunctionCall* FoxParser::ParseModuleFunctionCall(Token& module_name)
 {
     // Find the cached module
-    auto it = CachedModules.find(module_name);
+    auto it = CachedModules.find(module_name.GetHash());
     if (it == CachedModules.end()) {
         return nullptr;
     }
     FoxCachedModule& cached_mod = it->second;
 
 
-    FoxAstFunctionCall* node = FX_SCRIPT_ALLOC_NODE(FoxAstFunctionCall);
+    FoxAstFunctionCall* node = FX_SCRIPT_ALLOC_NODE(FoxAstFunctionCall, mpArena);
 
     Token& name = EatToken(TT::Identifier);
 
@@ -811,7 +805,7 @@ FoxAstFunctionCall* FoxParser::ParseModuleFunctionCall(const std::string& module
     node->pFunction = cached_mod.pParser->FindFunction(node->HashedName);
 
     if (node->pFunction == nullptr) {
-        ParseError("Module '{}' function '{}' not found!", module_name, name.GetStr());
+        ParseError("Module '{}' function '{}' not found!", module_name, name);
     }
 
     EatToken(TT::LParen);
@@ -823,7 +817,7 @@ FoxAstFunctionCall* FoxParser::ParseModuleFunctionCall(const std::string& module
             break;
         }
 
-        node->Params.push_back(param);
+        node->Params.Insert(param);
 
         TT next_tt = GetToken().Type;
 
@@ -845,18 +839,17 @@ FoxAstModuleCall* FoxParser::ParseModuleCall()
     FoxAstModuleCall* node = FX_SCRIPT_ALLOC_NODE(FoxAstModuleCall);
 
     Token& mod_name = EatToken(TT::Identifier);
-    std::string mod_str = mod_name.GetStr();
 
-    auto load_it = mModuleLoads.find(mod_str);
+    auto load_it = mModuleLoads.find(mod_name.GetHash());
     if (load_it == mModuleLoads.end()) {
-        ParseError("No module load found for '{}'", mod_str);
+        ParseError("No module load found for '{}'", mod_name);
     }
     else {
         node->pModuleLoad = load_it->second;
     }
 
     EatToken(TT::Colon);
-    node->pFunctionCall = ParseModuleFunctionCall(mod_str);
+    node->pFunctionCall = ParseModuleFunctionCall(mod_name);
 
     return node;
 }
@@ -892,11 +885,11 @@ void FoxParser::FixupFunctionCalls()
 
 FoxAstBlock* FoxParser::Parse()
 {
-    FoxAstBlock* root_block = FX_SCRIPT_ALLOC_NODE(FoxAstBlock);
+    FoxAstBlock* root_block = FX_SCRIPT_ALLOC_NODE(FoxAstBlock, mpArena);
 
     FoxAstNode* keyword;
     while ((keyword = ParseStatement(root_block))) {
-        root_block->Statements.push_back(keyword);
+        root_block->Statements.Insert(keyword);
     }
 
     FixupFunctionCalls();
@@ -908,116 +901,4 @@ FoxAstBlock* FoxParser::Parse()
     return root_block;
 }
 
-void FoxAstDestroyer::Do(FoxAstNode* node)
-{
-    if (node == nullptr) {
-        return;
-    }
-
-    if (node->NodeType == FX_AST_BLOCK) {
-        FoxAstBlock* block = static_cast<FoxAstBlock*>(node);
-        for (FoxAstNode* child : block->Statements) {
-            Do(child);
-        }
-
-        FX_SCRIPT_FREE(FoxAstBlock, block);
-    }
-    else if (node->NodeType == FX_AST_PROCDECL) {
-        FoxAstFunctionDecl* functiondecl = static_cast<FoxAstFunctionDecl*>(node);
-
-        for (FoxAstNode* param : functiondecl->pParams->Statements) {
-            Do(param);
-        }
-
-        Do(functiondecl->pBlock);
-
-        FX_SCRIPT_FREE(FoxAstFunctionDecl, functiondecl);
-    }
-    else if (node->NodeType == FX_AST_VARDECL) {
-        FoxAstVarDecl* vardecl = static_cast<FoxAstVarDecl*>(node);
-
-        Do(vardecl->pAssignment);
-
-        FX_SCRIPT_FREE(FoxAstVarDecl, vardecl);
-    }
-    else if (node->NodeType == FX_AST_ASSIGN) {
-        FoxAstAssign* assign = static_cast<FoxAstAssign*>(node);
-
-        Do(assign->pRhs);
-
-        FX_SCRIPT_FREE(FoxAstAssign, assign);
-    }
-    else if (node->NodeType == FX_AST_PROCCALL) {
-        FoxAstFunctionCall* functioncall = static_cast<FoxAstFunctionCall*>(node);
-
-        FX_SCRIPT_FREE(FoxAstFunctionCall, functioncall);
-    }
-    else if (node->NodeType == FX_AST_PROCCALL) {
-        FoxAstModuleCall* module_call = static_cast<FoxAstModuleCall*>(node);
-
-        Do(module_call->pFunctionCall);
-
-        FX_SCRIPT_FREE(FoxAstModuleCall, module_call);
-    }
-    else if (node->NodeType == FX_AST_LITERAL) {
-        FoxAstLiteral* literal = static_cast<FoxAstLiteral*>(node);
-
-        FX_SCRIPT_FREE(FoxAstLiteral, literal);
-    }
-    else if (node->NodeType == FX_AST_BINOP) {
-        FoxAstBinop* binop = static_cast<FoxAstBinop*>(node);
-
-        Do(binop->pLeft);
-        Do(binop->pRight);
-
-        FX_SCRIPT_FREE(FoxAstBinop, binop);
-    }
-    else if (node->NodeType == FX_AST_RETURN) {
-        FoxAstReturn* return_node = static_cast<FoxAstReturn*>(node);
-
-        if (return_node->pRhs) {
-            Do(return_node->pRhs);
-        }
-
-        FX_SCRIPT_FREE(FoxAstReturn, return_node);
-    }
-
-    else if (node->NodeType == FX_AST_IF) {
-        FoxAstIf* if_node = static_cast<FoxAstIf*>(node);
-
-        Do(if_node->pCondition);
-        Do(if_node->pBlock);
-        Do(if_node->pElseBlock);
-
-        FX_SCRIPT_FREE(FoxAstIf, if_node);
-    }
-    else if (node->NodeType == FX_AST_MODULELOAD) {
-        FoxAstModuleLoad* mod_node = static_cast<FoxAstModuleLoad*>(node);
-        FX_SCRIPT_FREE(FoxAstModuleLoad, mod_node);
-    }
-    else if (node->NodeType == FX_AST_MODULECALL) {
-        FoxAstModuleCall* mod_call = static_cast<FoxAstModuleCall*>(node);
-
-        // Do not free pModuleLoad as that is not controlled by this node.
-        Do(mod_call->pFunctionCall);
-
-        FX_SCRIPT_FREE(FoxAstModuleCall, mod_call);
-    }
-    else {
-        LogError(LC_SCRIPT, "Cannot free unknown node!");
-    }
-}
-
-FoxParser::~FoxParser()
-{
-    FoxAstDestroyer destroyer;
-
-    for (auto it : CachedModules) {
-        destroyer.Do(it.second.pAstTree);
-        delete it.second.pParser;
-    }
-
-    CachedModules.clear();
-}
-
 } // namespace fx::script
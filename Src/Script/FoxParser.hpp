@@ -4,6 +4,7 @@
 #include "FoxVariable.hpp"
 
 #include <Util/Tokenizer.hpp>
+#include <unordered_map>
 
 
 #define FX_SCRIPT_SCOPE_GLOBAL_VARS_START_SIZE 32
@@ -32,6 +33,13 @@ struct FoxCachedModule
     FoxAstNode* pAstTree = nullptr;
 };
 
+/**
+ * @brief Parses a token stream into an AST.
+ *
+ * All of the AST nodes, symbol tables and internal strings created by the parser are allocated from the arena passed
+ * to `Init()`, as are the parsers for any module headers that are loaded. Nothing is freed individually; the arena
+ * must outlive the parser and any compilation of its AST, and is released in one go afterwards.
+ */
 class FoxParser
 {
     using TT = eTokenType;
@@ -39,7 +47,7 @@ class FoxParser
 public:
     FoxParser() = default;
 
-    void Init(PagedArray<Token>&& tokens);
+    void Init(Arena* arena, const ArenaArray<Token>& tokens);
 
     void PushScope();
     void PopScope();
@@ -47,7 +55,7 @@ public:
     FoxVar* FindVar(Hash32 hashed_name);
 
     FoxFunction* FindFunction(Hash32 hashed_name);
-    FoxFunction* FindModuleFunction(const String& module_alias, Hash32 hashed_name);
+    FoxFunction* FindModuleFunction(Hash32 module_alias, Hash32 hashed_name);
 
     FoxAstNode* TryParseKeyword(FoxAstBlock* parent_block, bool* ignore_semicolon);
     FoxAstAssign* TryParseAssignment(Token* var_name);
@@ -62,7 +70,7 @@ public:
     FoxAstNode* ParseRhs();
 
     FoxAstFunctionCall* ParseFunctionCall();
-    FoxAstFunctionCall* ParseModuleFunctionCall(const std::string& module_name);
+    FoxAstFunctionCall* ParseModuleFunctionCall(Token& module_name);
     FoxAstModuleCall* ParseModuleCall();
 
     FoxAstIf* ParseIfStatement(FoxAstBlock* parent_block);
@@ -102,15 +110,13 @@ public:
 
     void PrintFunctionTable(const FoxScope& scope) const;
 
-    ~FoxParser();
-
     // void RegisterExternalFunc(FoxHash func_name, std::vector<FoxValue::ValueType> param_types,
     // FoxExternalFunc::FuncType func, bool is_variadic);
 
 private:
     template <typename T>
         requires std::is_base_of_v<FoxLabelledData, T>
-    T* FindLabelledData(Hash32 hashed_name, PagedArray<T>& buffer)
+    T* FindLabelledData(Hash32 hashed_name, ArenaArray<T*>& buffer)
     {
         FoxScope* scope = mCurrentScope;
 
@@ -131,7 +137,7 @@ private:
     Token* CreateTokenFromString(eTokenType type, const char* text);
     void CreateInternalVariableTokens();
 
-    bool IsGlobalScope() const { return mScopes.Size() <= 1; }
+    bool IsGlobalScope() const { return mCurrentScope == mpGlobalScope; }
 
     FoxAstNode* ParseGlobalDefinitions();
 
@@ -145,18 +151,21 @@ public:
     // char* pFileData = nullptr;
     bool bHasErrors = false;
 
-    std::unordered_map<std::string, FoxCachedModule> CachedModules;
+    /// Parsed module headers, keyed by the hash of the module alias.
+    std::unordered_map<Hash32, FoxCachedModule> CachedModules;
 
 private:
-    PagedArray<FoxScope> mScopes;
+    Arena* mpArena = nullptr;
+
+    FoxScope* mpGlobalScope = nullptr;
     FoxScope* mCurrentScope = nullptr;
 
-    std::unordered_map<std::string, FoxAstModuleLoad*> mModuleLoads;
+    std::unordered_map<Hash32, FoxAstModuleLoad*> mModuleLoads;
     std::vector<FoxFunctionFixup> mFunctionFixups;
 
     FoxAstBlock* mpRootBlock = nullptr;
 
-    PagedArray<Token> mTokens = {};
+    ArenaArray<Token> mTokens;
     uint32 mTokenIndex = 0;
 
     // Name tokens for internal variables
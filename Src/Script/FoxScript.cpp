@@ -1,8 +1,10 @@
 #include "FoxScript.hpp"
 
 #include "FoxAst.hpp"
+#include "FoxBytecodeCache.hpp"
 #include "FoxBytecodeCompiler.hpp"
 #include "FoxParser.hpp"
+#include "FoxScriptScheduler.hpp"
 #include "FoxVM.hpp"
 
 #include <SDL3/SDL.h>
@@ -37,6 +39,39 @@ static void N_MipsExport(FoxVM* vm, const SizedArray<FoxValue>& args)
 }
 
 
+/**
+ * @brief Binds a pooled context to a VM for the duration of the scope. If the VM is already executing (for example, a
+ * native proc calling back into the script) the existing context is used.
+ */
+class FoxVMContextScope
+{
+public:
+	FoxVMContextScope(FoxVM& vm) : mVm(vm)
+	{
+		if (mVm.HasContext()) {
+			return;
+		}
+
+		mpContext = FoxVMContextPool::GetInstance().Acquire();
+		mVm.AttachContext(mpContext);
+	}
+
+	~FoxVMContextScope()
+	{
+		if (!mpContext) {
+			return;
+		}
+
+		mVm.DetachContext();
+		FoxVMContextPool::GetInstance().Release(mpContext);
+	}
+
+private:
+	FoxVM& mVm;
+	FoxVMContext* mpContext = nullptr;
+};
+
+
 FoxScript::FoxScript(const String& path) { Load(path); }
 
 SizedArray<uint8> FoxScript::Compile(const String& path)
@@ -48,19 +83,24 @@ SizedArray<uint8> FoxScript::Compile(const String& path)
 		return SizedArray<uint8>();
 	}
 
-	Slice<char> file_data = fp.Read<char>();
+	// The source, tokens, AST and symbol tables all live in this arena, and are released together once the bytecode
+	// has been generated.
+	Arena arena(gScriptMemPool);
+
+	const uint64 file_size = fp.GetFileSize();
+	Slice<char> file_data = fp.Read(MakeSlice(arena.AllocArray<char>(file_size), file_size));
 
-	Tokenizer tokenizer(file_data.pData, file_data.Size);
+	Tokenizer tokenizer(file_data.pData, file_data.Size, &arena);
 	tokenizer.SetFileExtension(".fox");
 	tokenizer.Tokenize();
 
-	// for (const Token& token : tokenizer.TokenBuffer) {
+	// for (const Token& token : tokenizer.ArenaTokens) {
 	//     LogInfo("{}", token);
 	// }
 
 	FoxParser parser {};
 
-	parser.Init(std::move(tokenizer.TokenBuffer));
+	parser.Init(&arena, tokenizer.ArenaTokens);
 
 	FoxAstNode* root_node = parser.Parse();
 	if (parser.bHasErrors || root_node == nullptr) {
@@ -92,11 +132,25 @@ SizedArray<uint8> FoxScript::Compile(const String& path)
 		bytecode_file.Close();
 	}
 
-	LogInfo(LC_SCRIPT, "Compiled script {}", path);
+	{
+		std::vector<FoxScriptDependency> dependencies;
+
+		for (const std::string& include_path : tokenizer.IncludedPaths) {
+			dependencies.push_back({ .Path = include_path, .Type = eFoxDependencyType::Include });
+		}
+		for (const std::string& module_path : compiler.LinkedModulePaths) {
+			dependencies.push_back({ .Path = module_path, .Type = eFoxDependencyType::Module });
+		}
 
-	// Since all we need is the bytecode now, we can destroy the AST.
-	FoxAstDestroyer destroyer;
-	destroyer.Do(root_node);
+		FoxBytecodeCache& cache = FoxBytecodeCache::GetInstance();
+		cache.Store(path, file_data, Slice<uint8>(bytecode), dependencies);
+
+		// Any script that links this module from now on should pick up the new bytecode
+		cache.ReleaseModule(bytecode_path.Str().CStr());
+		cache.ReleaseImage(path);
+	}
+
+	LogInfo(LC_SCRIPT, "Compiled script {} ({} bytes of front end memory)", path, arena.GetBytesUsed());
 
 	FoxBytecodePrinter bc_printer(bytecode);
 	bc_printer.Print();
@@ -106,14 +160,31 @@ SizedArray<uint8> FoxScript::Compile(const String& path)
 
 void FoxScript::Load(const String& path)
 {
-	SizedArray<uint8> bytecode = Compile(path);
+	FoxBytecodeCache& cache = FoxBytecodeCache::GetInstance();
 
-	if (!bytecode.IsInited()) {
-		return;
+	pBytecodeImage = cache.FindImage(path);
+
+	if (!pBytecodeImage) {
+		SizedArray<uint8> bytecode = cache.Fetch(path);
+
+		if (!bytecode.IsInited()) {
+			bytecode = Compile(path);
+		}
+
+		if (!bytecode.IsInited()) {
+			return;
+		}
+
+		pBytecodeImage = cache.StoreImage(path, std::move(bytecode));
 	}
 
+	// The VM only references the shared bytecode, the image is kept alive by this script
+	const SizedArray<uint8>& image_bytecode = pBytecodeImage->Bytecode;
+	Vm.InitVM(SizedArray<uint8>(image_bytecode.pData, image_bytecode.Size), nullptr);
 
-	Vm.InitVM(std::move(bytecode), nullptr);
+	// Hot procs are compiled to native code once for every script using the image. This does nothing on platforms
+	// without JIT support.
+	Vm.EnableJit(pBytecodeImage->pJit);
 
 	RegisterProc(HashStr32("WB_InitAmmoVars"), eFoxProcFlags::None, { eFoxType::INT, eFoxType::INT }, &WB_InitAmmoVars);
 	RegisterProc(HashStr32("WB_InitStatVars"), eFoxProcFlags::None, { eFoxType::INT }, &WB_InitStatVars);
@@ -123,7 +194,17 @@ void FoxScript::Load(const String& path)
 	CallProc(GetSymbol("init"), {});
 }
 
-void FoxScript::PushValue(const FoxValue& value) { Vm.Push32(value.Type, value.AsUInt()); }
+void FoxScript::PushValue(const FoxValue& value)
+{
+	FoxVMContextScope context_scope(Vm);
+
+	if (value.IsVector()) {
+		Vm.PushVector(value.Type, value.ValueVec);
+		return;
+	}
+
+	Vm.Push32(value.Type, value.AsUInt());
+}
 
 void FoxScript::RegisterProc(Hash32 name_hash, eFoxProcFlags flags, const SizedArray<eFoxType> arg_types,
 							 VMExternalFunction function)
@@ -141,21 +222,37 @@ FoxValue FoxScript::CallProc(const FoxSymbol* sym, const SizedArray<FoxValue>& a
 		return FoxValue::scNone;
 	}
 
-	Vm.PushReturnAddr(0);
+	FoxValue result = FoxValue::scNone;
+
+	{
+		FoxVMContextScope context_scope(Vm);
+
+		Vm.PushReturnAddr(0);
+
+		++Vm.ScopeIndex;
+		Vm.PC = sym->Offset;
 
-	++Vm.ScopeIndex;
-	Vm.PC = sym->Offset;
+		for (uint32 arg_index = 0; arg_index < args.Size; arg_index++) {
+			PushValue(args[arg_index]);
+		}
 
-	for (uint32 arg_index = 0; arg_index < args.Size; arg_index++) {
-		PushValue(args[arg_index]);
+		result = Vm.Resume();
 	}
 
-	return Resume();
+	if (Vm.bIsPaused) {
+		FoxScriptScheduler::GetInstance().Schedule(this);
+	}
+
+	return result;
 }
 
-FoxValue FoxScript::Update() { return Vm.Update(); }
+FoxValue FoxScript::Resume()
+{
+	FoxVMContextScope context_scope(Vm);
+	return Vm.Resume();
+}
 
-FoxValue FoxScript::Resume() { return Vm.Resume(); }
+FoxScript::~FoxScript() { FoxScriptScheduler::GetInstance().Cancel(this); }
 
 
 void FoxScript::SetGlobal(const Hash32 name_hash, const FoxValue& value) { Vm.Globals[name_hash] = value; }
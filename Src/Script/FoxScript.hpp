@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FoxBytecodeCache.hpp"
 #include "FoxVM.hpp"
 
 namespace fx {
@@ -14,6 +15,9 @@ public:
 	FoxScript() = default;
 	FoxScript(const String& path);
 
+	FoxScript(const FoxScript& other) = delete;
+	FoxScript& operator=(const FoxScript& other) = delete;
+
 	void Load(const String& path);
 	SizedArray<uint8> Compile(const String& path);
 
@@ -37,7 +41,6 @@ public:
 
 	FoxValue CallProc(const FoxSymbol* sym, const SizedArray<FoxValue>& args);
 
-	FoxValue Update();
 	FoxValue Resume();
 
 	void RegisterProc(Hash32 name_hash, eFoxProcFlags flags, const SizedArray<eFoxType> arg_types,
@@ -56,10 +59,16 @@ public:
 
 	FX_FORCE_INLINE uint32 GetProcAddr(Hash32 name_hash) const { return Vm.GetProcAddr(name_hash); };
 
+	~FoxScript();
+
 public:
 	FoxVM Vm;
 
-	std::chrono::system_clock::time_point ResumeTime;
+	/// Bytecode shared with all other scripts loaded from the same path.
+	Ref<FoxBytecodeImage> pBytecodeImage { nullptr };
+
+	/// Set while the script is waiting on the scheduler to be resumed.
+	bool bIsScheduled = false;
 };
 
 } // namespace script
@@ -0,0 +1,162 @@
+#include "FoxScriptScheduler.hpp"
+
+#include "FoxScript.hpp"
+
+namespace fx::script {
+
+///////////////////////////////////////////
+// Timer Wheel
+///////////////////////////////////////////
+
+void FoxTimerWheel::Add(FoxScript* script, std::chrono::milliseconds delay)
+{
+	if (!mbStarted) {
+		mLastTick = Clock::now();
+		mbStarted = true;
+	}
+
+	// Round up so that a script is never resumed early, and always wait at least one tick
+	uint64 ticks = (delay.count() + scTickDuration.count() - 1) / scTickDuration.count();
+	if (ticks == 0) {
+		ticks = 1;
+	}
+
+	const uint32 slot = static_cast<uint32>((mCurrentSlot + ticks) % scNumSlots);
+	const uint32 turns = static_cast<uint32>((ticks - 1) / scNumSlots);
+
+	mSlots[slot].push_back(Timer { .pScript = script, .TurnsRemaining = turns });
+
+	++mTimerCount;
+}
+
+void FoxTimerWheel::Remove(FoxScript* script)
+{
+	if (mTimerCount == 0) {
+		return;
+	}
+
+	for (std::vector<Timer>& slot : mSlots) {
+		for (size_t index = 0; index < slot.size(); index++) {
+			if (slot[index].pScript != script) {
+				continue;
+			}
+
+			slot[index] = slot.back();
+			slot.pop_back();
+
+			--mTimerCount;
+
+			return;
+		}
+	}
+}
+
+void FoxTimerWheel::Advance(Clock::time_point now, std::vector<FoxScript*>& out_expired)
+{
+	if (!mbStarted || now < mLastTick) {
+		return;
+	}
+
+	const uint64 elapsed_ticks = (now - mLastTick) / scTickDuration;
+	mLastTick += scTickDuration * elapsed_ticks;
+
+	for (uint64 tick = 0; tick < elapsed_ticks && mTimerCount > 0; tick++) {
+		mCurrentSlot = (mCurrentSlot + 1) % scNumSlots;
+
+		std::vector<Timer>& slot = mSlots[mCurrentSlot];
+
+		for (size_t index = 0; index < slot.size();) {
+			Timer& timer = slot[index];
+
+			if (timer.TurnsRemaining > 0) {
+				--timer.TurnsRemaining;
+				++index;
+				continue;
+			}
+
+			out_expired.push_back(timer.pScript);
+
+			slot[index] = slot.back();
+			slot.pop_back();
+
+			--mTimerCount;
+		}
+	}
+
+	// If the wheel emptied partway through, keep the current slot in step with the clock for the next timer
+	if (mTimerCount == 0) {
+		mbStarted = false;
+	}
+}
+
+
+///////////////////////////////////////////
+// Scheduler
+///////////////////////////////////////////
+
+FoxScriptScheduler& FoxScriptScheduler::GetInstance()
+{
+	static FoxScriptScheduler sScheduler;
+
+	return sScheduler;
+}
+
+void FoxScriptScheduler::Schedule(FoxScript* script)
+{
+	const std::chrono::milliseconds delay(static_cast<uint64>(script->Vm.PauseTime) * 100);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Replace the previous timer if the script was paused again before being resumed
+	if (script->bIsScheduled) {
+		mTimerWheel.Remove(script);
+	}
+
+	mTimerWheel.Add(script, delay);
+	script->bIsScheduled = true;
+}
+
+void FoxScriptScheduler::Cancel(FoxScript* script)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (!script->bIsScheduled) {
+		return;
+	}
+
+	mTimerWheel.Remove(script);
+	script->bIsScheduled = false;
+}
+
+void FoxScriptScheduler::Update()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (mTimerWheel.IsEmpty()) {
+			return;
+		}
+
+		mDueScripts.clear();
+		mTimerWheel.Advance(FoxTimerWheel::Clock::now(), mDueScripts);
+
+		for (FoxScript* script : mDueScripts) {
+			script->bIsScheduled = false;
+		}
+	}
+
+	if (mDueScripts.empty()) {
+		return;
+	}
+
+	for (FoxScript* script : mDueScripts) {
+		script->Resume();
+
+		// Scripts that paused again are put back on the wheel
+		if (script->IsPaused()) {
+			Schedule(script);
+		}
+	}
+}
+
+} // namespace fx::script
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace fx::script {
+
+class FoxScript;
+
+/**
+ * @brief A hashed timer wheel for paused scripts. Each slot covers `scTickDuration`, and timers that are longer than a
+ * full turn of the wheel count down the number of turns remaining.
+ */
+class FoxTimerWheel
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr uint32 scNumSlots = 256;
+	static constexpr std::chrono::milliseconds scTickDuration { 10 };
+
+public:
+	FoxTimerWheel() = default;
+
+	void Add(FoxScript* script, std::chrono::milliseconds delay);
+	void Remove(FoxScript* script);
+
+	/**
+	 * @brief Advances the wheel up to `now`, appending all scripts that have expired to `out_expired`.
+	 */
+	void Advance(Clock::time_point now, std::vector<FoxScript*>& out_expired);
+
+	FX_FORCE_INLINE bool IsEmpty() const { return mTimerCount == 0; }
+
+private:
+	struct Timer
+	{
+		FoxScript* pScript = nullptr;
+		uint32 TurnsRemaining = 0;
+	};
+
+	std::vector<Timer> mSlots[scNumSlots];
+
+	uint32 mCurrentSlot = 0;
+	uint32 mTimerCount = 0;
+
+	Clock::time_point mLastTick;
+	bool mbStarted = false;
+};
+
+/**
+ * @brief Resumes paused scripts once their pause has elapsed.
+ *
+ * A script is scheduled when it pauses, so idle scripts are never polled. Each frame, all scripts that are due are
+ * resumed one after another on a pooled VM context. Scripts are resumed on the thread that calls `Update()`, as the
+ * native procs they call use engine state that is not synchronized.
+ */
+class FoxScriptScheduler
+{
+public:
+	static FoxScriptScheduler& GetInstance();
+
+	/**
+	 * @brief Queues a paused script to be resumed after its pause time.
+	 */
+	void Schedule(FoxScript* script);
+
+	/**
+	 * @brief Removes a script from the schedule. This must be called before a scheduled script is destroyed.
+	 */
+	void Cancel(FoxScript* script);
+
+	/**
+	 * @brief Resumes all scripts that are due. Should be called once per frame, from the main thread.
+	 */
+	void Update();
+
+private:
+	FoxScriptScheduler() = default;
+
+private:
+	std::mutex mMutex;
+
+	FoxTimerWheel mTimerWheel;
+	std::vector<FoxScript*> mDueScripts;
+};
+
+} // namespace fx::script
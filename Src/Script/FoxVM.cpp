@@ -1,6 +1,7 @@
 #include "FoxVM.hpp"
 
 #include "FoxBytecode.hpp"
+#include "FoxBytecodeCache.hpp"
 #include "FoxBytecodeCompiler.hpp"
 
 
@@ -61,24 +62,24 @@ void FoxVM::LoadLinkTable()
 	constexpr uint32 scBufferSize = 1024;
 	char name_buffer[scBufferSize];
 
+	FoxBytecodeCache& cache = FoxBytecodeCache::GetInstance();
+
 	for (uint32 index = 0; index < num_links; index++) {
 		ReadString(name_buffer, scBufferSize);
 
 		VMModule& mod = LoadedModules[index];
 
-		File bytecode_file(name_buffer, File::eModType::Read, File::eDataType::Binary);
-		if (!bytecode_file.IsFileOpen()) {
+		VMInitState init_state { pStack, pCallStack, StackPointer, CallStackPointer };
+
+		mod.pVM = cache.AcquireModule(name_buffer, &init_state);
+		if (!mod.pVM) {
 			LogError(LC_SCRIPT, "Error loading linked module '{}'", name_buffer);
 			continue;
 		}
 
 		LogInfo(LC_SCRIPT, "Loaded link '{}'", name_buffer);
 
-		mod.Bytecode = bytecode_file.Read<uint8>();
-		mod.pVM = new FoxVM;
-
-		VMInitState init_state { pStack, pCallStack, StackPointer, CallStackPointer };
-		mod.pVM->InitVM(SizedArray<uint8>(mod.Bytecode, mod.Bytecode.Size), &init_state);
+		mod.Bytecode = Slice<uint8>(mod.pVM->mBytecode);
 	}
 }
 
@@ -117,30 +118,81 @@ void FoxVM::InitVM(SizedArray<uint8>&& bytecode, VMInitState* init_state)
 
 	Assert(scStackSize >= 1024);
 
-	if (init_state && init_state->pStack) {
-		pStack = init_state->pStack;
-		StackPointer = init_state->StackPointer;
-	}
-	else {
-		pStack = gScriptMemPool->Alloc<uint8>(scStackSize);
+	memset(ScopeVarCounts, 0, sizeof(ScopeVarCounts));
+
+	// Standalone VMs do not own any stack or variable memory, a context is attached while the VM is executing.
+	if (!init_state) {
+		return;
 	}
 
-	if (init_state && init_state->pCallStack) {
-		pCallStack = init_state->pCallStack;
-		CallStackPointer = init_state->CallStackPointer;
+	// Linked modules run on the stack of the calling VM, which is set on each call. Variables are indexed from zero in
+	// each VM, so the module needs its own.
+	pStack = init_state->pStack;
+	StackPointer = init_state->StackPointer;
+
+	pCallStack = init_state->pCallStack;
+	CallStackPointer = init_state->CallStackPointer;
+
+	pVariables = gScriptMemPool->Alloc<VMVariable>(sizeof(VMVariable) * scMaxActiveVariables);
+	mbOwnsVariables = true;
+}
+
+void FoxVM::AttachContext(FoxVMContext* context)
+{
+	AssertMsg(mpContext == nullptr, "VM already has a context attached!");
+
+	mpContext = context;
+
+	pStack = context->pStack;
+	pCallStack = pStack + (scStackSize - scCallStackSize);
+	pVariables = context->pVariables;
+
+	if (mParkedState.IsEmpty()) {
+		return;
 	}
-	else {
-		pCallStack = pStack + (scStackSize - scCallStackSize);
+
+	const uint8* read_ptr = mParkedState.pData;
+
+	memcpy(pStack, read_ptr, StackPointer);
+	read_ptr += StackPointer;
+
+	memcpy(pCallStack, read_ptr, CallStackPointer);
+	read_ptr += CallStackPointer;
+
+	memcpy(reinterpret_cast<void*>(pVariables), read_ptr, sizeof(VMVariable) * VariableIndex);
+
+	mParkedState.Free();
+}
+
+void FoxVM::DetachContext()
+{
+	if (!mpContext) {
+		return;
 	}
 
-	if (init_state && init_state->pStack && !init_state->pCallStack) {
-		pCallStack = gScriptMemPool->Alloc<uint8>(scCallStackSize);
-		CallStackPointer = 0;
+	// There is only live data here if the VM paused partway through a proc, so most of the time nothing is parked.
+	const uint32 variables_size = sizeof(VMVariable) * VariableIndex;
+	const uint32 parked_size = StackPointer + CallStackPointer + variables_size;
+
+	if (parked_size > 0) {
+		mParkedState.InitSize(parked_size);
+
+		uint8* write_ptr = mParkedState.pData;
+
+		memcpy(write_ptr, pStack, StackPointer);
+		write_ptr += StackPointer;
+
+		memcpy(write_ptr, pCallStack, CallStackPointer);
+		write_ptr += CallStackPointer;
+
+		memcpy(write_ptr, reinterpret_cast<const void*>(pVariables), variables_size);
 	}
 
-	pVariables = gScriptMemPool->Alloc<VMVariable>(sizeof(VMVariable) * scMaxActiveVariables);
+	pStack = nullptr;
+	pCallStack = nullptr;
+	pVariables = nullptr;
 
-	memset(ScopeVarCounts, 0, sizeof(ScopeVarCounts));
+	mpContext = nullptr;
 }
 
 VMVariable& FoxVM::GetVar(uint16 index)
@@ -227,6 +279,83 @@ uint32 FoxVM::Pop32()
 	return value;
 }
 
+void FoxVM::PushVector(eFoxType type, const float32* values)
+{
+	constexpr uint32 cVectorSize = sizeof(float32) * 4;
+
+	if (StackPointer + cVectorSize > scStackSize - scCallStackSize) {
+		LogError(LC_SCRIPT, "PushVector: Out of stack memory!");
+		return;
+	}
+
+	// The stack is only aligned to 4 bytes, so copy the components rather than storing the SIMD register directly
+	memcpy(pStack + StackPointer, values, cVectorSize);
+
+	if (type != eFoxType::NONETYPE) {
+		LastPushType = type;
+	}
+
+	StackPointer += cVectorSize;
+}
+
+void FoxVM::PopVector(float32* out_values)
+{
+	constexpr uint32 cVectorSize = sizeof(float32) * 4;
+
+	if (StackPointer < cVectorSize) {
+		LogError(LC_SCRIPT, "PopVector: No values on stack");
+		memset(out_values, 0, cVectorSize);
+		return;
+	}
+
+	StackPointer -= cVectorSize;
+	memcpy(out_values, pStack + StackPointer, cVectorSize);
+
+	bReturnValueOnStack = false;
+}
+
+Vec3f FoxVM::PopVec3()
+{
+	float32 values[4];
+	PopVector(values);
+
+	return Vec3f(values[0], values[1], values[2]);
+}
+
+Vec4f FoxVM::PopVec4()
+{
+	float32 values[4];
+	PopVector(values);
+
+	return Vec4f(values[0], values[1], values[2], values[3]);
+}
+
+Quat FoxVM::PopQuat()
+{
+	float32 values[4];
+	PopVector(values);
+
+	return Quat(values[0], values[1], values[2], values[3]);
+}
+
+void FoxVM::PushVec3(const Vec3f& value)
+{
+	const float32 values[4] = { value.X, value.Y, value.Z, 0.0f };
+	PushVector(eFoxType::VEC3, values);
+}
+
+void FoxVM::PushVec4(eFoxType type, const Vec4f& value)
+{
+	const float32 values[4] = { value.X, value.Y, value.Z, value.W };
+	PushVector(type, values);
+}
+
+void FoxVM::PushQuat(const Quat& value)
+{
+	const float32 values[4] = { value.X, value.Y, value.Z, value.W };
+	PushVector(eFoxType::QUAT, values);
+}
+
 VMCallFrame* FoxVM::GetCurrentCallFrame()
 {
 	if (!mIsInCallFrame || mCallFrameIndex < 1) {
@@ -273,6 +402,9 @@ void FoxVM::ExecuteOp()
 	case BcBase_Compare:
 		DoCompare(op_base, op_spec);
 		break;
+	case BcBase_Vector:
+		DoVector(op_base, op_spec);
+		break;
 	}
 }
 
@@ -295,10 +427,7 @@ void FoxVM::DoPush(uint8 op_base, uint8 op_spec)
 		Push32(eFoxType::STRING, value);
 	}
 	else if (op_spec == BcSpecPush_Var) {
-		uint16 var_index = Read16();
-
-		VMVariable& var = GetVar(var_index);
-		Push32(var.Value.Type, var.Value.Get<int32>());
+		PushVar(Read16());
 	}
 
 	else if (op_spec == BcSpecPush_VarPtr) {
@@ -319,33 +448,45 @@ void FoxVM::DoPush(uint8 op_base, uint8 op_spec)
 	}
 }
 
+void FoxVM::PushVar(uint16 var_index)
+{
+	VMVariable& var = GetVar(var_index);
+	Push32(var.Value.Type, var.Value.Get<int32>());
+}
+
 FoxValue& FoxVM::GetGlobal(const VMVariable& var) { return Globals[var.GlobalNameHash]; }
 
-void FoxVM::DoPop(uint8 op_base, uint8 op_spec)
+void FoxVM::PopVarInt32(uint16 var_index)
 {
-	if (op_spec == BcSpecPop_Variable_Int32) {
-		uint16 var_index = Read16();
+	VMVariable& var = GetVar(var_index);
 
-		VMVariable& var = GetVar(var_index);
+	if (var.bIsGlobalRef) {
+		GetGlobal(var).Set<int32>(Pop32());
+		return;
+	}
 
-		if (var.bIsGlobalRef) {
-			GetGlobal(var).Set<int32>(Pop32());
-			return;
-		}
+	var.Value.Set<int32>(Pop32());
+}
 
-		GetVar(var_index).Value.Set<int32>(Pop32());
-	}
-	else if (op_spec == BcSpecPop_Variable_Float32) {
-		uint16 var_index = Read16();
+void FoxVM::PopVarFloat32(uint16 var_index)
+{
+	VMVariable& var = GetVar(var_index);
 
-		VMVariable& var = GetVar(var_index);
+	if (var.bIsGlobalRef) {
+		GetGlobal(var).Set<float32>(Pop32());
+		return;
+	}
 
-		if (var.bIsGlobalRef) {
-			GetGlobal(var).Set<float32>(Pop32());
-			return;
-		}
+	var.Value.Set<float32>(Pop32());
+}
 
-		GetVar(var_index).Value.Set<float32>(Pop32());
+void FoxVM::DoPop(uint8 op_base, uint8 op_spec)
+{
+	if (op_spec == BcSpecPop_Variable_Int32) {
+		PopVarInt32(Read16());
+	}
+	else if (op_spec == BcSpecPop_Variable_Float32) {
+		PopVarFloat32(Read16());
 	}
 
 	else if (op_spec == BcSpecPop_Discard) {
@@ -419,6 +560,12 @@ void FoxVM::CallExternalFunction(Hash32 hashed_name)
 			// Query the string
 			args[back_offset - i] = FoxValue(GetString(Pop32()));
 		}
+		else if (FoxIsVectorType(arg_type)) {
+			float32 values[4];
+			PopVector(values);
+
+			args[back_offset - i] = FoxValue::VectorFromRaw(arg_type, values);
+		}
 		else {
 			args[back_offset - i] = (FoxValue::ValueFromRaw(arg_type, Pop32()));
 		}
@@ -589,20 +736,29 @@ void FoxVM::DoJump(uint8 op_base, uint8 op_spec)
 		uint32 name_hash = Read32();
 		uint32 call_offset = GetProcAddr(name_hash);
 
-		// ++ScopeIndex;
+		// The scope index was incremented by `PushVarBaseIndex()`, and is decremented by the callee's return op
 
 		PushReturnAddr(PC);
 		// Jump to the function address
 		PC = call_offset;
+
+		// If the proc is hot, this runs the compiled code and leaves PC at the return address
+		if (mpJit) {
+			mpJit->Enter(this);
+		}
+
 		break;
 	}
 	case BcSpecJump_CallModuleFunction: {
 		const uint16 module_index = Read16();
 		const uint32 name_hash = Read32();
 
-		FoxVM* mod_vm = LoadedModules[module_index].pVM;
+		Ref<FoxVM>& mod_vm = LoadedModules[module_index].pVM;
 		uint32 call_offset = mod_vm->GetProcAddr(name_hash);
 
+		// Modules are shared between scripts, only one caller can be using the module at a time
+		std::lock_guard<std::mutex> module_lock(mod_vm->ModuleCallMutex);
+
 		LogInfo("Loading module with SP={}, CSP={}", StackPointer, CallStackPointer);
 		mod_vm->pStack = pStack;
 		mod_vm->pCallStack = pCallStack;
@@ -668,6 +824,25 @@ void FoxVM::DoJump(uint8 op_base, uint8 op_spec)
 		PC = PopReturnAddr();
 		break;
 	}
+	case BcSpecJump_ReturnToCaller_Vec3:
+	case BcSpecJump_ReturnToCaller_Vec4:
+	case BcSpecJump_ReturnToCaller_Quat: {
+		PopVarBaseIndex();
+
+		if (op_spec == BcSpecJump_ReturnToCaller_Vec3) {
+			LastPushType = eFoxType::VEC3;
+		}
+		else if (op_spec == BcSpecJump_ReturnToCaller_Vec4) {
+			LastPushType = eFoxType::VEC4;
+		}
+		else {
+			LastPushType = eFoxType::QUAT;
+		}
+
+		bReturnValueOnStack = true;
+		PC = PopReturnAddr();
+		break;
+	}
 	case BcSpecJump_Pause: {
 		LogInfo("Pausing VM...");
 		PauseTime = Read16();
@@ -697,17 +872,13 @@ FoxValue FoxVM::Resume(bool no_return)
 
 	bIsPaused = false;
 
-	while (PC < mBytecode.Size) {
-		ExecuteOp();
-
-		if (bIsPaused) {
-			ResumeTime = std::chrono::system_clock::now() + std::chrono::milliseconds(uint64(PauseTime) * 100);
-			break;
-		}
+	// Entering a proc from C++. The compiled code may return from the proc, pause, or leave the rest to the interpreter.
+	if (mpJit) {
+		mpJit->Enter(this);
+	}
 
-		if (ScopeIndex <= 0) {
-			break;
-		}
+	while (PC < mBytecode.Size && ScopeIndex > 0 && !bIsPaused) {
+		ExecuteOp();
 	}
 
 	if (bReturnValueOnStack && !no_return) {
@@ -715,20 +886,18 @@ FoxValue FoxVM::Resume(bool no_return)
 			return FoxValue(GetString(Pop32()));
 		}
 
+		if (FoxIsVectorType(LastPushType)) {
+			float32 values[4];
+			PopVector(values);
 
-		return FoxValue::ValueFromRaw(LastPushType, Pop32());
-	}
+			return FoxValue::VectorFromRaw(LastPushType, values);
+		}
 
-	return FoxValue::scNone;
-}
 
-FoxValue FoxVM::Update()
-{
-	if (std::chrono::system_clock::now() < ResumeTime) {
-		return FoxValue::scNone;
+		return FoxValue::ValueFromRaw(LastPushType, Pop32());
 	}
 
-	return Resume();
+	return FoxValue::scNone;
 }
 
 void FoxVM::DoVariable(uint8 op_base, uint8 op_spec)
@@ -933,6 +1102,59 @@ void FoxVM::DoVariable(uint8 op_base, uint8 op_spec)
 		break;
 	}
 
+	case BcSpecVariable_Define_Vector: {
+		uint16 var_index = Read16();
+		eFoxType type = static_cast<eFoxType>(Read16());
+
+		static constexpr float32 scZero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		VMVariable& var = GetVar(var_index);
+		var.bIsGlobalRef = false;
+		var.Type = type;
+		var.Value.SetVector(type, scZero);
+
+		++VariableIndex;
+
+		break;
+	}
+
+	case BcSpecVariable_DefineGlobal_Vector: {
+		uint16 var_index = Read16();
+		Hash32 name_hash = Read32();
+		eFoxType type = static_cast<eFoxType>(Read16());
+
+		auto it = Globals.find(name_hash);
+		if (it == Globals.end()) {
+			static constexpr float32 scZero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			Globals[name_hash].SetVector(type, scZero);
+		}
+
+		VMVariable& var = GetVar(var_index);
+		var.bIsGlobalRef = true;
+		var.GlobalNameHash = name_hash;
+		var.Type = type;
+		var.Value = Globals[name_hash];
+
+		++VariableIndex;
+
+		break;
+	}
+
+	case BcSpecVariable_DefineFetchParam_Vector: {
+		uint16 var_index = Read16();
+		eFoxType type = static_cast<eFoxType>(Read16());
+
+		float32 values[4];
+		PopVector(values);
+
+		VMVariable& var = GetVar(var_index);
+		var.bIsGlobalRef = false;
+		var.Type = type;
+		var.Value.SetVector(type, values);
+
+		break;
+	}
+
 		/////////////////////////////////////
 		// Pointer instructions
 		/////////////////////////////////////
@@ -1023,15 +1245,282 @@ void FoxVM::DoCompare(uint8 op_base, uint8 op_spec)
 	}
 }
 
+void FoxVM::PushVectorVar(uint16 var_index)
+{
+	VMVariable& var = GetVar(var_index);
+
+	if (var.bIsGlobalRef) {
+		const FoxValue& global = GetGlobal(var);
+		PushVector(global.Type, global.ValueVec);
+		return;
+	}
+
+	PushVector(var.Value.Type, var.Value.ValueVec);
+}
+
+void FoxVM::PopVectorVar(uint16 var_index)
+{
+	VMVariable& var = GetVar(var_index);
+
+	float32 values[4];
+	PopVector(values);
+
+	var.Value.SetVector(var.Type, values);
+
+	if (var.bIsGlobalRef) {
+		GetGlobal(var).SetVector(var.Type, values);
+	}
+}
+
+void FoxVM::DoVector(uint8 op_base, uint8 op_spec)
+{
+	switch (op_spec) {
+	case BcSpecVector_PushVar:
+		PushVectorVar(Read16());
+		break;
+
+	case BcSpecVector_PopVar:
+		PopVectorVar(Read16());
+		break;
+
+	case BcSpecVector_Discard: {
+		float32 values[4];
+		PopVector(values);
+		break;
+	}
+
+	// Arguments are pushed in order, so the last component is on the top of the stack
+
+	case BcSpecVector_Make3: {
+		float32 z = std::bit_cast<float32>(Pop32());
+		float32 y = std::bit_cast<float32>(Pop32());
+		float32 x = std::bit_cast<float32>(Pop32());
+
+		PushVec3(Vec3f(x, y, z));
+		break;
+	}
+
+	case BcSpecVector_Make4:
+	case BcSpecVector_MakeQuat: {
+		float32 w = std::bit_cast<float32>(Pop32());
+		float32 z = std::bit_cast<float32>(Pop32());
+		float32 y = std::bit_cast<float32>(Pop32());
+		float32 x = std::bit_cast<float32>(Pop32());
+
+		const float32 values[4] = { x, y, z, w };
+		PushVector((op_spec == BcSpecVector_MakeQuat) ? eFoxType::QUAT : eFoxType::VEC4, values);
+		break;
+	}
+
+	case BcSpecVector_QuatAxisAngle: {
+		float32 angle = std::bit_cast<float32>(Pop32());
+		Vec3f axis = PopVec3();
+
+		PushQuat(Quat::FromAxisAngle(axis, angle));
+		break;
+	}
+
+	// Component-wise ops are run on all four lanes. The fourth component of a vec3 is zero, so it stays zero.
+
+	case BcSpecVector_Add: {
+		Vec4f b = PopVec4();
+		Vec4f a = PopVec4();
+
+		PushVec4(eFoxType::NONETYPE, a + b);
+		break;
+	}
+
+	case BcSpecVector_Sub: {
+		Vec4f b = PopVec4();
+		Vec4f a = PopVec4();
+
+		PushVec4(eFoxType::NONETYPE, a - b);
+		break;
+	}
+
+	case BcSpecVector_Mul: {
+		Vec4f b = PopVec4();
+		Vec4f a = PopVec4();
+
+		PushVec4(eFoxType::NONETYPE, a * b);
+		break;
+	}
+
+	case BcSpecVector_Scale: {
+		float32 scalar = std::bit_cast<float32>(Pop32());
+		Vec4f a = PopVec4();
+
+		PushVec4(eFoxType::NONETYPE, a * scalar);
+		break;
+	}
+
+	case BcSpecVector_Dot3: {
+		Vec3f b = PopVec3();
+		Vec3f a = PopVec3();
+
+		Push32(eFoxType::FLOAT, std::bit_cast<uint32>(a.Dot(b)));
+		break;
+	}
+
+	case BcSpecVector_Dot4: {
+		Vec4f b = PopVec4();
+		Vec4f a = PopVec4();
+
+		const Vec4f product = a * b;
+		const float32 result = product.X + product.Y + product.Z + product.W;
+
+		Push32(eFoxType::FLOAT, std::bit_cast<uint32>(result));
+		break;
+	}
+
+	case BcSpecVector_Cross: {
+		Vec3f b = PopVec3();
+		Vec3f a = PopVec3();
+
+		PushVec3(a.Cross(b));
+		break;
+	}
+
+	case BcSpecVector_Normalize3:
+		PushVec3(PopVec3().Normalize());
+		break;
+
+	case BcSpecVector_Normalize4:
+		PushVec4(eFoxType::NONETYPE, PopVec4().Normalize());
+		break;
+
+	case BcSpecVector_QuatMul: {
+		Quat b = PopQuat();
+		Quat a = PopQuat();
+
+		PushQuat(a * b);
+		break;
+	}
+
+	case BcSpecVector_QuatRotate: {
+		Vec3f v = PopVec3();
+		Quat q = PopQuat();
+
+		PushVec3(v.Rotate(q));
+		break;
+	}
+
+	case BcSpecVector_QuatSLerp: {
+		float32 step = std::bit_cast<float32>(Pop32());
+		Quat b = PopQuat();
+		Quat a = PopQuat();
+
+		PushQuat(a.SLerp(b, step));
+		break;
+	}
+
+	case BcSpecVector_GetX:
+	case BcSpecVector_GetY:
+	case BcSpecVector_GetZ:
+	case BcSpecVector_GetW: {
+		float32 values[4];
+		PopVector(values);
+
+		const float32 component = values[op_spec - BcSpecVector_GetX];
+		Push32(eFoxType::FLOAT, std::bit_cast<uint32>(component));
+		break;
+	}
+	}
+}
+
+void FoxVM::EnableJit(uint32 call_threshold)
+{
+	if (!FoxJit::IsSupported()) {
+		return;
+	}
+
+	if (mpJit) {
+		mpJit->CallThreshold = call_threshold;
+		return;
+	}
+
+	mpJit = Ref<FoxJit>::New(call_threshold);
+}
+
+void FoxVM::EnableJit(const Ref<FoxJit>& jit)
+{
+	if (!FoxJit::IsSupported()) {
+		return;
+	}
+
+	mpJit = jit;
+}
+
+void FoxVM::DisableJit() { mpJit = nullptr; }
+
 FoxVM::~FoxVM()
 {
-	for (VMModule& mod : LoadedModules) {
-		std::free(mod.Bytecode.pData);
-		delete mod.pVM;
+	DisableJit();
+
+	// Release our references to the shared module VMs
+	LoadedModules.Clear();
+
+	if (mbOwnsVariables) {
+		gScriptMemPool->Free(pVariables);
 	}
 
-	gScriptMemPool->Free(pVariables);
 	pVariables = nullptr;
 }
 
+
+///////////////////////////////////////////
+// Context Pool
+///////////////////////////////////////////
+
+FoxVMContextPool& FoxVMContextPool::GetInstance()
+{
+	static FoxVMContextPool sPool;
+
+	return sPool;
+}
+
+FoxVMContext* FoxVMContextPool::Acquire()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (!mFreeContexts.empty()) {
+		FoxVMContext* context = mFreeContexts.back();
+		mFreeContexts.pop_back();
+
+		return context;
+	}
+
+	FoxVMContext* context = new FoxVMContext;
+	context->pStack = gScriptMemPool->Alloc<uint8>(FoxVM::scStackSize);
+	context->pVariables = gScriptMemPool->Alloc<VMVariable>(sizeof(VMVariable) * FoxVM::scMaxActiveVariables);
+
+	mAllContexts.push_back(context);
+
+	return context;
+}
+
+void FoxVMContextPool::Release(FoxVMContext* context)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mFreeContexts.push_back(context);
+}
+
+void FoxVMContextPool::Destroy()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	AssertMsg(mFreeContexts.size() == mAllContexts.size(), "Destroying VM context pool while contexts are in use!");
+
+	for (FoxVMContext* context : mAllContexts) {
+		gScriptMemPool->Free(context->pStack);
+		gScriptMemPool->Free(context->pVariables);
+
+		delete context;
+	}
+
+	mAllContexts.clear();
+	mFreeContexts.clear();
+}
+
 } // namespace fx::script
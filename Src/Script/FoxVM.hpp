@@ -1,11 +1,15 @@
 #pragma once
 
+#include "FoxJit.hpp"
 #include "FoxValue.hpp"
 
 #include <Core/Name.hpp>
 #include <Core/PagedArray.hpp>
+#include <Core/Ref.hpp>
 #include <Core/Types.hpp>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace fx {
 
@@ -60,7 +64,9 @@ struct VMExternalProcEntry
 struct VMModule
 {
 	Slice<uint8> Bytecode { nullptr, 0 };
-	FoxVM* pVM = nullptr;
+
+	/// The module VM is owned by `FoxBytecodeCache` and shared between all scripts that link the module.
+	Ref<FoxVM> pVM { nullptr };
 };
 
 struct VMInitState
@@ -77,8 +83,47 @@ struct VMInitState
 	uint32 CallStackPointer = 0;
 };
 
+/**
+ * @brief Stack and variable memory for an executing VM. Contexts are pooled and only bound to a VM while it is
+ * running, so an idle or paused script does not hold on to a full stack.
+ */
+struct FoxVMContext
+{
+	uint8* pStack = nullptr;
+	VMVariable* pVariables = nullptr;
+};
+
+class FoxVMContextPool
+{
+public:
+	static FoxVMContextPool& GetInstance();
+
+	/**
+	 * @brief Takes a free context from the pool, allocating a new context if none are available.
+	 */
+	FoxVMContext* Acquire();
+	void Release(FoxVMContext* context);
+
+	/**
+	 * @brief Frees all contexts. No contexts may be in use.
+	 */
+	void Destroy();
+
+private:
+	FoxVMContextPool() = default;
+
+private:
+	std::mutex mMutex;
+
+	std::vector<FoxVMContext*> mFreeContexts;
+	std::vector<FoxVMContext*> mAllContexts;
+};
+
 class FoxVM
 {
+	friend class FoxVMContextPool;
+	friend struct FoxJitHelpers;
+
 	static constexpr uint32 scStackSize = 1024 * 16;
 	static constexpr uint32 scCallStackSize = 512;
 
@@ -88,8 +133,45 @@ class FoxVM
 public:
 	FoxVM() = default;
 
+	/**
+	 * @brief Initializes the VM from bytecode.
+	 * @param init_state The stack state for a linked module. If this is null, the VM is standalone and a context must be
+	 * attached before executing.
+	 */
 	void InitVM(SizedArray<uint8>&& bytecode, VMInitState* init_state);
 
+	/**
+	 * @brief Binds a context to the VM and restores any state that was parked when the VM was last detached.
+	 */
+	void AttachContext(FoxVMContext* context);
+
+	/**
+	 * @brief Unbinds the current context. Live stack and variable data (from a paused proc) is parked in a buffer
+	 * sized to fit, and restored on the next attach.
+	 */
+	void DetachContext();
+
+	FX_FORCE_INLINE bool HasContext() const { return mpContext != nullptr; }
+
+	/**
+	 * @brief Enables the JIT for this VM. Procs are compiled once they have been called `call_threshold` times. Does
+	 * nothing if the JIT is not supported on this platform.
+	 */
+	void EnableJit(uint32 call_threshold = FoxJit::scDefaultCallThreshold);
+
+	/**
+	 * @brief Runs hot procs with `jit`, which is shared with other VMs. The JIT must only be shared between VMs that
+	 * run the same bytecode (see `FoxBytecodeImage::pJit`).
+	 */
+	void EnableJit(const Ref<FoxJit>& jit);
+
+	/**
+	 * @brief Disables the JIT and frees any compiled code. Must not be called while the VM is executing.
+	 */
+	void DisableJit();
+
+	FX_FORCE_INLINE FoxJit* GetJit() const { return mpJit.IsValid() ? &(*mpJit) : nullptr; }
+
 	FX_FORCE_INLINE uint32 GetStackPointer() const { return StackPointer; }
 
 	const char* GetString(uint32 offset) const;
@@ -102,11 +184,16 @@ public:
 	void Push32(eFoxType type, uint32 value);
 	uint32 Pop32();
 
+	/**
+	 * @brief Pushes a 16 byte vector value to the stack.
+	 */
+	void PushVector(eFoxType type, const float32* values);
+	void PopVector(float32* out_values);
+
 	void PushReturnAddr(uint32 addr);
 	uint32 PopReturnAddr();
 
 	FoxValue Resume(bool no_return = false);
-	FoxValue Update();
 
 	void ExecuteOp();
 
@@ -125,6 +212,22 @@ private:
 	void DoMove(uint8 op_base, uint8 op_spec);
 	void DoVariable(uint8 op_base, uint8 op_spec);
 	void DoCompare(uint8 op_base, uint8 op_spec);
+	void DoVector(uint8 op_base, uint8 op_spec);
+
+	void PushVar(uint16 var_index);
+	void PopVarInt32(uint16 var_index);
+	void PopVarFloat32(uint16 var_index);
+
+	void PushVectorVar(uint16 var_index);
+	void PopVectorVar(uint16 var_index);
+
+	Vec3f PopVec3();
+	Vec4f PopVec4();
+	Quat PopQuat();
+
+	void PushVec3(const Vec3f& value);
+	void PushVec4(eFoxType type, const Vec4f& value);
+	void PushQuat(const Quat& value);
 
 	void PushVarBaseIndex();
 	void PopVarBaseIndex();
@@ -179,13 +282,26 @@ public:
 	bool bReturnValueOnStack = false;
 	bool bIsPaused = false;
 
+	/// Length of the last pause in tenths of a second. Paused scripts are resumed by the `FoxScriptScheduler`.
 	uint16 PauseTime = 0;
-	std::chrono::system_clock::time_point ResumeTime;
 
 	eFoxType LastPushType = eFoxType::NONETYPE;
 
 
+	/// Held while a shared module is executing on behalf of a calling VM, as the calls may come from multiple threads.
+	std::mutex ModuleCallMutex;
+
 private:
+	FoxVMContext* mpContext = nullptr;
+
+	/// Compiled procs for the VM's bytecode, null if the JIT is disabled. May be shared with other VMs.
+	Ref<FoxJit> mpJit { nullptr };
+
+	/// Stack, call stack and variables that were live when the context was detached.
+	SizedArray<uint8> mParkedState;
+
+	bool mbOwnsVariables = false;
+
 	bool mIsInCallFrame = false;
 
 	VMCallFrame mCallFrames[8];
@@ -10,6 +10,9 @@ eFoxType FoxStringToType(Token* token)
     static constexpr Hash32 scIntType = HashStr32("int");
     static constexpr Hash32 scFloatType = HashStr32("float");
     static constexpr Hash32 scStringType = HashStr32("str");
+    static constexpr Hash32 scVec3Type = HashStr32("vec3");
+    static constexpr Hash32 scVec4Type = HashStr32("vec4");
+    static constexpr Hash32 scQuatType = HashStr32("quat");
 
     switch (token->GetHash()) {
     case scIntType:
@@ -18,6 +21,12 @@ eFoxType FoxStringToType(Token* token)
         return eFoxType::FLOAT;
     case scStringType:
         return eFoxType::STRING;
+    case scVec3Type:
+        return eFoxType::VEC3;
+    case scVec4Type:
+        return eFoxType::VEC4;
+    case scQuatType:
+        return eFoxType::QUAT;
     default:;
     }
 
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <Core/Types.hpp>
+#include <Math/Quat.hpp>
+#include <Math/Vec3.hpp>
+#include <Math/Vec4.hpp>
 #include <cstdio>
+#include <cstring>
 #include <format>
 
 namespace fx {
@@ -15,10 +19,20 @@ enum class eFoxType : uint16
     FLOAT,
     STRING,
     REF,
+
+    // Vector types are 16 bytes on the stack and in variables, and are backed by the SIMD math types.
+    VEC3,
+    VEC4,
+    QUAT,
 };
 
 eFoxType FoxStringToType(Token* token);
 
+inline bool FoxIsVectorType(eFoxType type)
+{
+    return (type == eFoxType::VEC3 || type == eFoxType::VEC4 || type == eFoxType::QUAT);
+}
+
 namespace script {
 struct FoxAstVarRef;
 
@@ -34,6 +48,30 @@ public:
     explicit FoxValue(float value) : Type(eFoxType::FLOAT), ValueFloat(value) {}
     explicit FoxValue(const char* value) : Type(eFoxType::STRING), ValueString(value) {}
 
+    explicit FoxValue(const Vec3f& value) : Type(eFoxType::VEC3)
+    {
+        ValueVec[0] = value.X;
+        ValueVec[1] = value.Y;
+        ValueVec[2] = value.Z;
+        ValueVec[3] = 0.0f;
+    }
+
+    explicit FoxValue(const Vec4f& value) : Type(eFoxType::VEC4)
+    {
+        ValueVec[0] = value.X;
+        ValueVec[1] = value.Y;
+        ValueVec[2] = value.Z;
+        ValueVec[3] = value.W;
+    }
+
+    explicit FoxValue(const Quat& value) : Type(eFoxType::QUAT)
+    {
+        ValueVec[0] = value.X;
+        ValueVec[1] = value.Y;
+        ValueVec[2] = value.Z;
+        ValueVec[3] = value.W;
+    }
+
     static FoxValue ValueFromRaw(eFoxType type, uint32 raw_value)
     {
         FoxValue value = FoxValue::scNone;
@@ -60,6 +98,14 @@ public:
         return value;
     }
 
+    static FoxValue VectorFromRaw(eFoxType type, const float32* raw_values)
+    {
+        FoxValue value = FoxValue::scNone;
+        value.SetVector(type, raw_values);
+
+        return value;
+    }
+
     FoxValue(const FoxValue& other) { (*this) = other; }
 
     FoxValue& operator=(const FoxValue& other)
@@ -78,6 +124,9 @@ public:
         else if (other.Type == eFoxType::REF) {
             pValueRef = other.pValueRef;
         }
+        else if (FoxIsVectorType(other.Type)) {
+            memcpy(ValueVec, other.ValueVec, sizeof(ValueVec));
+        }
 
         return *this;
     }
@@ -101,6 +150,10 @@ public:
         else if (Type == eFoxType::REF) {
             printf("Ref, %p]\n", pValueRef);
         }
+        else if (FoxIsVectorType(Type)) {
+            printf("Vector, (%f, %f, %f, %f)]\n", static_cast<double>(ValueVec[0]), static_cast<double>(ValueVec[1]),
+                   static_cast<double>(ValueVec[2]), static_cast<double>(ValueVec[3]));
+        }
     }
 
     /////////////////////////////////////
@@ -124,6 +177,16 @@ public:
         ValueFloat = value;
     }
 
+    /**
+     * @brief Sets a vector value from four packed floats. Vec3 values keep the fourth component, which is always zero
+     * for vectors created by scripts.
+     */
+    void SetVector(eFoxType type, const float32* values)
+    {
+        Type = type;
+        memcpy(ValueVec, values, sizeof(ValueVec));
+    }
+
     /////////////////////////////////////
     // Value get functions
     /////////////////////////////////////
@@ -149,6 +212,24 @@ public:
         return ValueString;
     }
 
+    template <>
+    Vec3f Get<Vec3f>() const
+    {
+        return Vec3f(ValueVec[0], ValueVec[1], ValueVec[2]);
+    }
+
+    template <>
+    Vec4f Get<Vec4f>() const
+    {
+        return Vec4f(ValueVec[0], ValueVec[1], ValueVec[2], ValueVec[3]);
+    }
+
+    template <>
+    Quat Get<Quat>() const
+    {
+        return Quat(ValueVec[0], ValueVec[1], ValueVec[2], ValueVec[3]);
+    }
+
 
     uint32 AsUInt() const { return std::bit_cast<uint32>(ValueInt); }
 
@@ -156,6 +237,8 @@ public:
 
     inline bool IsRef() { return (Type == eFoxType::REF); }
 
+    inline bool IsVector() const { return FoxIsVectorType(Type); }
+
 
 public:
     eFoxType Type = eFoxType::NONETYPE;
@@ -165,6 +248,7 @@ public:
         int32 ValueInt = 0;
         float32 ValueFloat;
         const char* ValueString;
+        float32 ValueVec[4];
 
         FoxAstVarRef* pValueRef;
     };
@@ -199,6 +283,13 @@ struct std::formatter<fx::script::FoxValue>
         else if (obj.Type == VT::REF) {
             return std::format_to(ctx.out(), "{:p}", reinterpret_cast<void*>(obj.pValueRef));
         }
+        else if (obj.Type == VT::VEC3) {
+            return std::format_to(ctx.out(), "({}, {}, {})", obj.ValueVec[0], obj.ValueVec[1], obj.ValueVec[2]);
+        }
+        else if (obj.Type == VT::VEC4 || obj.Type == VT::QUAT) {
+            return std::format_to(ctx.out(), "({}, {}, {}, {})", obj.ValueVec[0], obj.ValueVec[1], obj.ValueVec[2],
+                                  obj.ValueVec[3]);
+        }
 
         return std::format_to(ctx.out(), "Unknown");
     }
@@ -225,6 +316,12 @@ struct std::formatter<fx::eFoxType>
             return std::format_to(ctx.out(), "ref");
         case VT::STRING:
             return std::format_to(ctx.out(), "str");
+        case VT::VEC3:
+            return std::format_to(ctx.out(), "vec3");
+        case VT::VEC4:
+            return std::format_to(ctx.out(), "vec4");
+        case VT::QUAT:
+            return std::format_to(ctx.out(), "quat");
         }
 
         return std::format_to(ctx.out(), "Unknown");
@@ -3,8 +3,8 @@
 
 #include "FoxAst.hpp"
 
+#include <Core/Arena.hpp>
 #include <Core/Hash.hpp>
-#include <Core/PagedArray.hpp>
 #include <Core/Types.hpp>
 #include <Util/Tokenizer.hpp>
 
@@ -104,10 +104,16 @@ struct FoxVar : public FoxLabelledData
 };
 
 
+/**
+ * @brief A scope in the symbol table. Scopes, and the symbols declared in them, are allocated from the compile arena
+ * so that pointers to them remain valid for the lifetime of the AST.
+ */
 struct FoxScope
 {
-    PagedArray<FoxVar> Vars;
-    PagedArray<FoxFunction> Functions;
+    FoxScope(Arena* arena, FoxScope* parent) : Vars(arena), Functions(arena), Parent(parent) {}
+
+    ArenaArray<FoxVar*> Vars;
+    ArenaArray<FoxFunction*> Functions;
 
     FoxScope* Parent = nullptr;
 
@@ -118,8 +124,8 @@ struct FoxScope
     void PrintAllVarsInScope()
     {
         puts("\n=== SCOPE ===");
-        for (FoxVar& var : Vars) {
-            var.Print();
+        for (FoxVar* var : Vars) {
+            var->Print();
         }
     }
 
@@ -129,11 +135,11 @@ struct FoxScope
 
     template <typename T>
         requires std::is_base_of_v<FoxLabelledData, T>
-    T* FindInScope(Hash32 hashed_name, const PagedArray<T>& buffer)
+    T* FindInScope(Hash32 hashed_name, const ArenaArray<T*>& buffer)
     {
-        for (T& var : buffer) {
-            if (var.HashedName == hashed_name) {
-                return &var;
+        for (T* var : buffer) {
+            if (var->HashedName == hashed_name) {
+                return var;
             }
         }
 
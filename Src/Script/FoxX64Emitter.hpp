@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Core/Types.hpp>
+#include <cstring>
+#include <vector>
+
+namespace fx::script {
+
+/**
+ * @brief Writes x86-64 machine code to a byte buffer. This only covers the handful of instructions needed by the
+ * FoxScript JIT: calling helper functions with immediate arguments, testing the result, and jumping.
+ *
+ * Generated code follows the System V calling convention. The VM pointer is kept in `rbx` (callee saved) for the
+ * lifetime of the function, and is passed as the first argument to every helper.
+ */
+class FoxX64Emitter
+{
+public:
+	/// Condition codes for `Jcc rel32`, used after `TestResult()`.
+	enum class eCondition : uint8
+	{
+		Equal = 0x84,
+		NotEqual = 0x85,
+		Less = 0x8C,
+		GreaterEqual = 0x8D,
+		LessEqual = 0x8E,
+		Greater = 0x8F,
+	};
+
+	static constexpr uint32 scMaxHelperArgs = 3;
+
+	/// The largest number of bytes that a single helper call can emit.
+	static constexpr uint32 scMaxCallSize = 3 + (5 * scMaxHelperArgs) + 10 + 2;
+
+public:
+	/**
+	 * @brief `push rbx; mov rbx, rdi`. Pushing `rbx` also realigns the stack to 16 bytes for helper calls.
+	 */
+	void EmitPrologue()
+	{
+		Write8(0x53);
+		Write8(0x48, 0x89, 0xFB);
+	}
+
+	/**
+	 * @brief `pop rbx; ret`
+	 */
+	void EmitEpilogue()
+	{
+		Write8(0x5B);
+		Write8(0xC3);
+	}
+
+	/**
+	 * @brief Calls `function(vm, args...)`. Arguments are passed as 32-bit immediates in `esi`, `edx` and `ecx`, and
+	 * any return value is left in `eax`.
+	 */
+	void EmitCall(const void* function, uint32 num_args = 0, uint32 arg0 = 0, uint32 arg1 = 0, uint32 arg2 = 0)
+	{
+		// mov rdi, rbx
+		Write8(0x48, 0x89, 0xDF);
+
+		const uint32 args[scMaxHelperArgs] = { arg0, arg1, arg2 };
+
+		// mov esi/edx/ecx, imm32
+		constexpr uint8 cArgOps[scMaxHelperArgs] = { 0xBE, 0xBA, 0xB9 };
+
+		for (uint32 index = 0; index < num_args && index < scMaxHelperArgs; index++) {
+			Write8(cArgOps[index]);
+			Write32(args[index]);
+		}
+
+		// mov rax, imm64
+		Write8(0x48, 0xB8);
+		Write64(reinterpret_cast<uint64>(function));
+
+		// call rax
+		Write8(0xFF, 0xD0);
+	}
+
+	/**
+	 * @brief `test eax, eax`
+	 */
+	void EmitTestResult() { Write8(0x85, 0xC0); }
+
+	/**
+	 * @brief `jmp rel32` with an unresolved target.
+	 * @returns The offset of the displacement, to be passed to `PatchJump()`.
+	 */
+	uint32 EmitJump()
+	{
+		Write8(0xE9);
+		return WriteDisplacement();
+	}
+
+	/**
+	 * @brief `jcc rel32` with an unresolved target.
+	 * @returns The offset of the displacement, to be passed to `PatchJump()`.
+	 */
+	uint32 EmitJumpIf(eCondition condition)
+	{
+		Write8(0x0F, static_cast<uint8>(condition));
+		return WriteDisplacement();
+	}
+
+	/**
+	 * @brief Points a jump emitted with `EmitJump()` or `EmitJumpIf()` at `target_offset` in the buffer.
+	 */
+	void PatchJump(uint32 displacement_offset, uint32 target_offset)
+	{
+		const int32 displacement = static_cast<int32>(target_offset) - static_cast<int32>(displacement_offset + 4);
+		memcpy(&Code[displacement_offset], &displacement, sizeof(int32));
+	}
+
+	FX_FORCE_INLINE uint32 GetSize() const { return static_cast<uint32>(Code.size()); }
+
+private:
+	template <typename... TBytes>
+	void Write8(TBytes... bytes)
+	{
+		(Code.push_back(static_cast<uint8>(bytes)), ...);
+	}
+
+	void Write32(uint32 value)
+	{
+		for (uint32 index = 0; index < sizeof(uint32); index++) {
+			Code.push_back(static_cast<uint8>(value >> (index * 8)));
+		}
+	}
+
+	void Write64(uint64 value)
+	{
+		for (uint32 index = 0; index < sizeof(uint64); index++) {
+			Code.push_back(static_cast<uint8>(value >> (index * 8)));
+		}
+	}
+
+	uint32 WriteDisplacement()
+	{
+		const uint32 offset = GetSize();
+		Write32(0);
+
+		return offset;
+	}
+
+public:
+	std::vector<uint8> Code;
+};
+
+} // namespace fx::script
@@ -0,0 +1,232 @@
+#include "TexturePacker.hpp"
+
+#include <Asset/AssetTicket.hpp>
+#include <Core/Log.hpp>
+#include <Engine.hpp>
+#include <Material/Material.hpp>
+#include <Renderer/Backend/Commands.hpp>
+#include <Renderer/Backend/Image.hpp>
+#include <Texture/TextureManager.hpp>
+#include <Texture/TextureStreamer.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+FX_SET_MODULE_NAME("TexturePacker")
+
+namespace fx::TexturePacker {
+
+/**
+ * @brief Textures that can be packed into the same array.
+ */
+struct PackGroup
+{
+	eImageFormat Format = eImageFormat::None;
+	Vec2u Size = Vec2u::sZero;
+	uint32 MipLevel = 0;
+	uint32 MipCount = 0;
+
+	/// Each texture is packed once, even if it is used by several materials.
+	std::vector<Image*> Images;
+
+	uint32 MaterialCount = 0;
+	uint32 LastMaterialIndex = UINT32_MAX;
+};
+
+struct PackedLayer
+{
+	uint32 ArrayIndex = 0;
+	uint32 Layer = 0;
+};
+
+static uint32 GetPackedComponents(Material& material, MaterialComponent* components[3])
+{
+	uint32 component_count = 0;
+
+	components[component_count++] = &material.Diffuse;
+
+	// The metallic roughness map is replaced by a null image in `Material::Build()` if it does not exist
+	if (material.NormalMap.Exists()) {
+		components[component_count++] = &material.NormalMap;
+		components[component_count++] = &material.MetallicRoughness;
+	}
+
+	return component_count;
+}
+
+static bool CanPackImage(const Image* image)
+{
+	if (image == nullptr || !image->IsInited()) {
+		return false;
+	}
+
+	const ImageInfo& info = image->GetInfo();
+
+	return (info.ImageType == eImageType::Flat && info.Size.X <= scMaxTextureSize && info.Size.Y <= scMaxTextureSize &&
+			image->ImageLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+bool CanPack(Material& material)
+{
+	if (material.ID.IsNull() || material.bPackedTextures || material.bSupportsSkinning) {
+		return false;
+	}
+
+	// Bindless materials are already drawn without binding their textures
+	if (material.bBindlessTextures) {
+		return false;
+	}
+
+	if (!material.bIsBuilt.load() || !material.IsReady()) {
+		return false;
+	}
+
+	MaterialComponent* components[3];
+	const uint32 component_count = GetPackedComponents(material, components);
+
+	for (uint32 i = 0; i < component_count; i++) {
+		if (!CanPackImage(components[i]->pImage)) {
+			return false;
+		}
+	}
+
+	// Streamed images are reallocated as their levels change, which would not be seen by the arrays
+	if (gTextureStreamer && gTextureStreamer->IsStreaming(&material)) {
+		return false;
+	}
+
+	return true;
+}
+
+static PackGroup& FindGroup(std::vector<PackGroup>& groups, const ImageInfo& info)
+{
+	for (PackGroup& group : groups) {
+		if (group.Format == info.Format && group.Size == info.Size && group.MipLevel == info.MipLevel &&
+			group.MipCount == info.MipCount) {
+			return group;
+		}
+	}
+
+	PackGroup& group = groups.emplace_back();
+	group.Format = info.Format;
+	group.Size = info.Size;
+	group.MipLevel = info.MipLevel;
+	group.MipCount = info.MipCount;
+
+	return group;
+}
+
+static void BuildGroups(const std::vector<Material*>& materials, std::vector<PackGroup>& groups)
+{
+	groups.clear();
+
+	for (uint32 material_index = 0; material_index < materials.size(); material_index++) {
+		MaterialComponent* components[3];
+		const uint32 component_count = GetPackedComponents(*materials[material_index], components);
+
+		for (uint32 i = 0; i < component_count; i++) {
+			Image* image = components[i]->pImage;
+			PackGroup& group = FindGroup(groups, image->GetInfo());
+
+			if (std::find(group.Images.begin(), group.Images.end(), image) == group.Images.end()) {
+				group.Images.push_back(image);
+			}
+
+			// Count each material once, even if several of its components are in the group
+			if (group.LastMaterialIndex != material_index) {
+				group.LastMaterialIndex = material_index;
+				++group.MaterialCount;
+			}
+		}
+	}
+}
+
+static bool AreComponentsShared(Material& material, std::vector<PackGroup>& groups)
+{
+	MaterialComponent* components[3];
+	const uint32 component_count = GetPackedComponents(material, components);
+
+	for (uint32 i = 0; i < component_count; i++) {
+		if (FindGroup(groups, components[i]->pImage->GetInfo()).MaterialCount < scMinMaterialCount) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint32 PackComponent(MaterialComponent& component, std::vector<AssetTicket>& arrays,
+							const std::unordered_map<const Image*, PackedLayer>& layers)
+{
+	const PackedLayer& layer = layers.at(component.pImage);
+
+	component.SetTicket(arrays[layer.ArrayIndex]);
+
+	return layer.Layer;
+}
+
+uint32 Pack(renderer::CommandBuffer& cmd, const Slice<Material*>& materials)
+{
+	std::vector<Material*> packed_materials(materials.pData, materials.pData + materials.Size);
+	std::vector<PackGroup> groups;
+
+	// Drop the materials that do not share a group with other materials until the remaining groups are all shared.
+	// Dropping a material can leave another group with too few materials, so this repeats until nothing is dropped.
+	while (true) {
+		BuildGroups(packed_materials, groups);
+
+		const size_t dropped_count = std::erase_if(packed_materials, [&groups](Material* material)
+												   { return !AreComponentsShared(*material, groups); });
+
+		if (dropped_count == 0) {
+			break;
+		}
+	}
+
+	if (packed_materials.empty()) {
+		return 0;
+	}
+
+	std::vector<AssetTicket> arrays;
+	std::unordered_map<const Image*, PackedLayer> layers;
+
+	for (PackGroup& group : groups) {
+		for (uint32 first_image = 0; first_image < group.Images.size(); first_image += scMaxLayerCount) {
+			const uint32 image_count = static_cast<uint32>(group.Images.size());
+			const uint32 layer_count = std::min(image_count - first_image, scMaxLayerCount);
+
+			Image* array_image = gTextureManager->NewTexture();
+			array_image->CreateArrayFromImages(cmd, Slice<Image*>(group.Images.data() + first_image, layer_count));
+
+			AssetTicket& array_ticket = arrays.emplace_back(array_image);
+			array_ticket.MarkAndSignalLoaded();
+
+			for (uint32 layer = 0; layer < layer_count; layer++) {
+				const uint32 array_index = static_cast<uint32>(arrays.size() - 1);
+				layers[group.Images[first_image + layer]] = PackedLayer { array_index, layer };
+			}
+		}
+	}
+
+	for (Material* material : packed_materials) {
+		// The descriptor sets reference the unpacked images, and are rebuilt with the arrays on the next bind
+		material->RebuildDescriptors();
+
+		MaterialProperties& properties = material->Properties;
+		properties.DiffuseLayer = PackComponent(material->Diffuse, arrays, layers);
+
+		if (material->NormalMap.Exists()) {
+			properties.NormalMapLayer = PackComponent(material->NormalMap, arrays, layers);
+			properties.MetallicRoughnessLayer = PackComponent(material->MetallicRoughness, arrays, layers);
+		}
+
+		material->bPackedTextures = true;
+	}
+
+	LogInfo(LC_RENDER, "Packed the textures of {} materials into {} texture arrays", packed_materials.size(),
+			arrays.size());
+
+	return static_cast<uint32>(packed_materials.size());
+}
+
+} // namespace fx::TexturePacker
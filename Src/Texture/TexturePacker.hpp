@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Core/Slice.hpp>
+#include <Core/Types.hpp>
+
+namespace fx {
+
+namespace renderer {
+class CommandBuffer;
+}
+
+class Material;
+
+} // namespace fx
+
+/**
+ * @brief Packs the small textures of materials into texture arrays that are shared between the materials.
+ *
+ * Textures with the same format, size and mip chain are copied into the layers of one `eImageType::Array` image, and
+ * the layer of each component is written to the `MaterialProperties` of the material. Materials that sample the same
+ * arrays then request identical descriptor sets, which are shared by the `DescriptorCache`, so drawing them does not
+ * switch descriptor sets. Packed materials are drawn with the packed geometry pipelines (see
+ * `PipelineNameUtil::GetPackedVariant()`).
+ */
+namespace fx::TexturePacker {
+
+/// The largest side of a texture that is packed. Larger textures are not packed, as they are few and costly to copy.
+constexpr uint32 scMaxTextureSize = 512;
+
+/// The most layers in an array, which is the lowest `maxImageArrayLayers` that Vulkan allows.
+constexpr uint32 scMaxLayerCount = 256;
+
+/// The fewest materials that must sample an array for it to be created.
+constexpr uint32 scMinMaterialCount = 2;
+
+/**
+ * @brief Returns true if the textures of `material` can be packed. The material must be built and loaded, and not
+ * skinned, streamed (see `TextureStreamer`), bindless or packed already.
+ */
+bool CanPack(Material& material);
+
+/**
+ * @brief Packs the textures of `materials` into texture arrays. Materials with a texture that no other material can
+ * share an array with are left unchanged. The arrays are copied from the textures on the GPU, so this must be called
+ * outside of a render pass.
+ *
+ * @returns The number of materials that were packed.
+ */
+uint32 Pack(renderer::CommandBuffer& cmd, const Slice<Material*>& materials);
+
+} // namespace fx::TexturePacker
@@ -0,0 +1,410 @@
+#include "TextureStreamer.hpp"
+
+#include <Asset/MipmapGen.hpp>
+#include <Core/Log.hpp>
+#include <Engine.hpp>
+#include <Material/Material.hpp>
+#include <Renderer/Backend/Commands.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace fx {
+
+static Vec2u GetLowerMipSize(const Vec2u& size, uint32 levels)
+{
+	return Vec2u(std::max(1U, size.X >> levels), std::max(1U, size.Y >> levels));
+}
+
+static uint64 GetMipChainDataSize(eImageFormat format, const Vec2u& size, uint32 mip_count)
+{
+	uint64 data_size = 0;
+
+	for (uint32 i = 0; i < mip_count; i++) {
+		data_size += ImageFormatUtil::GetDataSize(format, GetLowerMipSize(size, i));
+	}
+
+	return data_size;
+}
+
+uint32 TextureStreamer::GetTailMip(uint32 mip_count)
+{
+	return (mip_count > scTailMipCount) ? (mip_count - scTailMipCount) : 0;
+}
+
+void TextureStreamer::Register(Material* material, MaterialComponent& component, const String& texture_cache_path,
+							   uint32 mip_count, uint32 tail_mip)
+{
+	std::lock_guard lock(mMutex);
+
+	StreamedTexture& texture = mTextures[&component];
+
+	texture = StreamedTexture {
+		.pMaterial = material,
+		.pComponent = &component,
+		.TextureCachePath = texture_cache_path,
+		.MipCount = mip_count,
+		.TailMip = tail_mip,
+		.ResidentMip = tail_mip,
+		.WantedMip = tail_mip,
+		.LastUsedFrame = mFrameIndex,
+	};
+}
+
+void TextureStreamer::Unregister(Material* material)
+{
+	std::lock_guard lock(mMutex);
+
+	for (auto it = mTextures.begin(); it != mTextures.end();) {
+		StreamedTexture& texture = it->second;
+
+		if (texture.pMaterial != material) {
+			++it;
+			continue;
+		}
+
+		mResidentBytes -= texture.ResidentBytes;
+
+		// The load is still running, its result is freed when it is not found in `AddLoadedMips()`
+		if (texture.bIsLoading) {
+			mPendingBytes -= texture.PendingBytes;
+			--mPendingLoads;
+		}
+
+		it = mTextures.erase(it);
+	}
+}
+
+bool TextureStreamer::IsStreaming(const Material* material)
+{
+	std::lock_guard lock(mMutex);
+
+	for (const auto& [component, texture] : mTextures) {
+		if (texture.pMaterial == material) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void TextureStreamer::RequestForMaterial(Material* material, float32 screen_size)
+{
+	if (material == nullptr) {
+		return;
+	}
+
+	std::lock_guard lock(mMutex);
+
+	const MaterialComponent* components[] = { &material->Diffuse, &material->NormalMap, &material->MetallicRoughness };
+
+	for (const MaterialComponent* component : components) {
+		auto it = mTextures.find(component);
+		if (it == mTextures.end()) {
+			continue;
+		}
+
+		StreamedTexture& texture = it->second;
+		texture.LastUsedFrame = mFrameIndex;
+
+		if (!texture.bIsResident) {
+			continue;
+		}
+
+		// Each level halves the number of texels across the object, so the wanted level is the one where a texel
+		// covers about one pixel.
+		const float32 texels_per_pixel = static_cast<float32>(texture.BaseSize) / std::max(screen_size, 1.0f);
+
+		uint32 wanted_mip = 0;
+		if (texels_per_pixel > 1.0f) {
+			wanted_mip = static_cast<uint32>(std::floor(std::log2(texels_per_pixel)));
+		}
+
+		wanted_mip = std::min(wanted_mip, texture.TailMip);
+		texture.WantedMip = std::min(texture.WantedMip, wanted_mip);
+	}
+}
+
+void TextureStreamer::Update(renderer::CommandBuffer& cmd)
+{
+	std::lock_guard lock(mMutex);
+
+	for (auto& [component, texture] : mTextures) {
+		UpdateResidency(texture);
+	}
+
+	AddLoadedMips(cmd);
+	EvictOverBudget(cmd);
+	StartLoads(cmd);
+
+	// Requests for the next frame start from the tail
+	for (auto& [component, texture] : mTextures) {
+		texture.WantedMip = texture.TailMip;
+	}
+
+	++mFrameIndex;
+}
+
+void TextureStreamer::SetBudget(uint64 budget_bytes)
+{
+	std::lock_guard lock(mMutex);
+
+	mBudget = budget_bytes;
+}
+
+TextureStreamerStats TextureStreamer::GetStats()
+{
+	std::lock_guard lock(mMutex);
+
+	return TextureStreamerStats {
+		.BudgetBytes = mBudget,
+		.ResidentBytes = mResidentBytes,
+		.PendingBytes = mPendingBytes,
+		.TextureCount = static_cast<uint32>(mTextures.size()),
+		.MipsStreamed = mMipsStreamed,
+		.MipsEvicted = mMipsEvicted,
+	};
+}
+
+void TextureStreamer::UpdateResidency(StreamedTexture& texture)
+{
+	if (texture.bIsResident) {
+		return;
+	}
+
+	const MaterialComponent* component = texture.pComponent;
+	if (component->pImage == nullptr || !component->Ticket.IsLoaded()) {
+		return;
+	}
+
+	const ImageInfo& info = component->pImage->GetInfo();
+
+	texture.ResidentBytes = GetMipChainDataSize(info.Format, info.Size, info.MipCount);
+	texture.BaseSize = std::max(info.Size.X, info.Size.Y) << texture.ResidentMip;
+	texture.bIsResident = true;
+
+	mResidentBytes += texture.ResidentBytes;
+}
+
+void TextureStreamer::AddLoadedMips(renderer::CommandBuffer& cmd)
+{
+	std::vector<LoadedMip> loaded_mips;
+
+	{
+		std::lock_guard lock(mLoadedMutex);
+		loaded_mips.swap(mLoadedMips);
+	}
+
+	for (LoadedMip& loaded : loaded_mips) {
+		void* mip_data = const_cast<uint8*>(loaded.Mip.ImageData.pData);
+
+		auto it = mTextures.find(loaded.pComponent);
+
+		// The texture was unregistered while the level was loading
+		if (it == mTextures.end() || !it->second.bIsLoading || it->second.LoadID != loaded.LoadID) {
+			std::free(mip_data);
+			continue;
+		}
+
+		StreamedTexture& texture = it->second;
+
+		texture.bIsLoading = false;
+		mPendingBytes -= texture.PendingBytes;
+		texture.PendingBytes = 0;
+		--mPendingLoads;
+
+		Image* image = texture.pComponent->pImage;
+
+		if (mip_data == nullptr || loaded.Mip.Format != image->GetInfo().Format) {
+			LogWarning(LC_ASSET, "TextureStreamer: Could not load mip {} of {}", loaded.MipLevel,
+					   texture.TextureCachePath);
+			std::free(mip_data);
+			continue;
+		}
+
+		// Free the descriptor sets before the old image is queued for deletion
+		texture.pMaterial->RebuildDescriptors();
+
+		image->ResizeMipChain(cmd, loaded.Mip.Size, image->GetInfo().MipCount + 1);
+		image->UploadMip(cmd, 0, loaded.Mip.Size, loaded.Mip.ImageData);
+
+		std::free(mip_data);
+
+		const uint64 mip_bytes = ImageFormatUtil::GetDataSize(loaded.Mip.Format, loaded.Mip.Size);
+
+		texture.ResidentMip = loaded.MipLevel;
+		texture.ResidentBytes += mip_bytes;
+		mResidentBytes += mip_bytes;
+
+		++mMipsStreamed;
+	}
+}
+
+void TextureStreamer::EvictOverBudget(renderer::CommandBuffer& cmd)
+{
+	while (mResidentBytes + mPendingBytes > mBudget) {
+		StreamedTexture* texture = FindEvictionCandidate(false);
+		if (texture == nullptr) {
+			break;
+		}
+
+		// Textures that are still drawn only lose their top level, the rest go back to their tail
+		const bool is_unused = (texture->LastUsedFrame != mFrameIndex);
+		Evict(cmd, *texture, is_unused ? texture->TailMip : (texture->ResidentMip + 1));
+	}
+}
+
+void TextureStreamer::StartLoads(renderer::CommandBuffer& cmd)
+{
+	if (mPendingLoads >= scMaxPendingLoads) {
+		return;
+	}
+
+	std::vector<StreamedTexture*> candidates;
+
+	for (auto& [component, texture] : mTextures) {
+		if (texture.bIsResident && !texture.bIsLoading && texture.WantedMip < texture.ResidentMip) {
+			candidates.push_back(&texture);
+		}
+	}
+
+	// Load for the textures that are missing the most levels first
+	std::sort(candidates.begin(), candidates.end(),
+			  [](const StreamedTexture* a, const StreamedTexture* b)
+			  { return (a->ResidentMip - a->WantedMip) > (b->ResidentMip - b->WantedMip); });
+
+	for (StreamedTexture* texture : candidates) {
+		if (mPendingLoads >= scMaxPendingLoads) {
+			break;
+		}
+
+		const ImageInfo& info = texture->pComponent->pImage->GetInfo();
+
+		// The next level is about four times the size of the current level 0
+		const uint64 mip_bytes = ImageFormatUtil::GetDataSize(info.Format, Vec2u(info.Size.X * 2, info.Size.Y * 2));
+
+		if (!MakeRoom(cmd, mip_bytes)) {
+			break;
+		}
+
+		texture->PendingBytes = mip_bytes;
+		mPendingBytes += mip_bytes;
+
+		StartLoad(*texture);
+	}
+}
+
+bool TextureStreamer::MakeRoom(renderer::CommandBuffer& cmd, uint64 bytes)
+{
+	while (mResidentBytes + mPendingBytes + bytes > mBudget) {
+		StreamedTexture* texture = FindEvictionCandidate(true);
+		if (texture == nullptr) {
+			return false;
+		}
+
+		Evict(cmd, *texture, texture->TailMip);
+	}
+
+	return true;
+}
+
+void TextureStreamer::Evict(renderer::CommandBuffer& cmd, StreamedTexture& texture, uint32 new_resident_mip)
+{
+	Assert(new_resident_mip > texture.ResidentMip && new_resident_mip <= texture.TailMip);
+
+	Image* image = texture.pComponent->pImage;
+	const ImageInfo& info = image->GetInfo();
+
+	const uint32 dropped_count = new_resident_mip - texture.ResidentMip;
+
+	const Vec2u new_size = GetLowerMipSize(info.Size, dropped_count);
+	const uint32 new_mip_count = info.MipCount - dropped_count;
+	const uint64 new_bytes = GetMipChainDataSize(info.Format, new_size, new_mip_count);
+
+	// Free the descriptor sets before the old image is queued for deletion
+	texture.pMaterial->RebuildDescriptors();
+
+	image->ResizeMipChain(cmd, new_size, new_mip_count);
+
+	mResidentBytes -= (texture.ResidentBytes - new_bytes);
+	texture.ResidentBytes = new_bytes;
+	texture.ResidentMip = new_resident_mip;
+
+	mMipsEvicted += dropped_count;
+}
+
+void TextureStreamer::StartLoad(StreamedTexture& texture)
+{
+	texture.bIsLoading = true;
+	texture.LoadID = ++mNextLoadID;
+	++mPendingLoads;
+
+	const MaterialComponent* component = texture.pComponent;
+	const String texture_cache_path = texture.TextureCachePath;
+	const uint32 mip_level = texture.ResidentMip - 1;
+	const uint32 load_id = texture.LoadID;
+
+	auto load_mip = [this, component, texture_cache_path, mip_level, load_id]()
+	{
+		LoadedMip loaded { .pComponent = component, .LoadID = load_id, .MipLevel = mip_level };
+
+		MipmapLoader loader {};
+		loader.Open(texture_cache_path.CStr());
+
+		if (loader.Pack.IsOpen() && mip_level < loader.GetMipCount()) {
+			loaded.Mip = loader.GetMip(mip_level);
+		}
+
+		std::lock_guard lock(mLoadedMutex);
+		mLoadedMips.push_back(loaded);
+	};
+
+	if (gJobSystem) {
+		gJobSystem->Submit(load_mip, &mLoadJobs);
+	}
+	else {
+		load_mip();
+	}
+}
+
+TextureStreamer::StreamedTexture* TextureStreamer::FindEvictionCandidate(bool only_unused)
+{
+	StreamedTexture* candidate = nullptr;
+	uint32 candidate_age = 0;
+
+	for (auto& [component, texture] : mTextures) {
+		if (!texture.bIsResident || texture.bIsLoading || texture.ResidentMip >= texture.TailMip) {
+			continue;
+		}
+
+		const uint32 age = mFrameIndex - texture.LastUsedFrame;
+		if (only_unused && age == 0) {
+			continue;
+		}
+
+		// Evict from the least recently drawn texture, and from the largest of those
+		const bool is_older = (candidate == nullptr) || (age > candidate_age);
+		const bool is_larger = (candidate != nullptr) && (age == candidate_age) &&
+							   (texture.ResidentBytes > candidate->ResidentBytes);
+
+		if (is_older || is_larger) {
+			candidate = &texture;
+			candidate_age = age;
+		}
+	}
+
+	return candidate;
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	if (gJobSystem) {
+		gJobSystem->Wait(mLoadJobs);
+	}
+
+	for (LoadedMip& loaded : mLoadedMips) {
+		std::free(const_cast<uint8*>(loaded.Mip.ImageData.pData));
+	}
+}
+
+} // namespace fx
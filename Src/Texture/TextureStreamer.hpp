@@ -0,0 +1,195 @@
+#pragma once
+
+#include <Core/JobSystem.hpp>
+#include <Core/String.hpp>
+#include <Core/Types.hpp>
+#include <Renderer/Backend/Image.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace fx {
+
+namespace renderer {
+class CommandBuffer;
+}
+
+class Material;
+struct MaterialComponent;
+
+/**
+ * @brief Memory used by streamed textures, see `TextureStreamer::GetStats()`.
+ */
+struct TextureStreamerStats
+{
+	/// The most memory that streamed textures can use.
+	uint64 BudgetBytes = 0;
+
+	/// Memory used by the mip levels that are on the GPU, including the tails.
+	uint64 ResidentBytes = 0;
+
+	/// Memory for mip levels that are being read from their texture caches.
+	uint64 PendingBytes = 0;
+
+	uint32 TextureCount = 0;
+
+	/// Mip levels streamed in and evicted since the streamer was created.
+	uint32 MipsStreamed = 0;
+	uint32 MipsEvicted = 0;
+};
+
+/**
+ * @brief Streams the top mip levels of textures from their texture caches as they are needed on screen.
+ *
+ * Textures loaded from a texture cache start with only the smallest levels of their mip chain (the tail, see
+ * `GetTailMip()`). Each frame, the renderer reports the size on screen of each drawn material with
+ * `RequestForMaterial()`, and `Update()` loads the next larger level of each texture that is sampled at a finer level
+ * than it has. Textures that are missing the most levels are loaded first.
+ *
+ * The memory of all streamed textures is kept under a budget. When a level does not fit, levels are evicted from the
+ * textures that have gone the longest without being drawn. Tails are never evicted.
+ *
+ * Levels are added and evicted by reallocating the image with `Image::ResizeMipChain()`, which copies the levels that
+ * are kept on the GPU, so evicted levels free their memory.
+ */
+class TextureStreamer
+{
+public:
+	/// The number of levels at the end of each mip chain that are loaded with the texture and never evicted.
+	static constexpr uint32 scTailMipCount = 8;
+
+	/// The most mip levels that are read from texture caches at once.
+	static constexpr uint32 scMaxPendingLoads = 4;
+
+	static constexpr uint64 scDefaultBudget = 512ULL * 1024 * 1024;
+
+private:
+	struct StreamedTexture
+	{
+		Material* pMaterial = nullptr;
+		MaterialComponent* pComponent = nullptr;
+
+		String TextureCachePath;
+
+		/// The number of levels in the texture cache.
+		uint32 MipCount = 0;
+
+		/// The first level of the tail. Levels from here to the end of the chain are always resident.
+		uint32 TailMip = 0;
+
+		/// The first level on the GPU.
+		uint32 ResidentMip = 0;
+
+		/// The finest level that was sampled in the last frame.
+		uint32 WantedMip = 0;
+
+		/// The largest side of level 0, estimated from the tail.
+		uint32 BaseSize = 0;
+
+		uint32 LastUsedFrame = 0;
+
+		uint64 ResidentBytes = 0;
+		uint64 PendingBytes = 0;
+
+		/// Identifies the current load, so that a load that finishes after the texture is unregistered is not added to
+		/// a texture that was registered in its place.
+		uint32 LoadID = 0;
+
+		/// True once the image has been uploaded and is counted in the resident memory.
+		bool bIsResident = false;
+		bool bIsLoading = false;
+	};
+
+	struct LoadedMip
+	{
+		const MaterialComponent* pComponent = nullptr;
+		uint32 LoadID = 0;
+		uint32 MipLevel = 0;
+		ImageInfo Mip {};
+	};
+
+public:
+	TextureStreamer() = default;
+
+	/**
+	 * @brief Returns the first level of the tail of a chain of `mip_count` levels, which is loaded with the texture.
+	 */
+	static uint32 GetTailMip(uint32 mip_count);
+
+	/**
+	 * @brief Streams the image of `component` from the texture cache at `texture_cache_path`. The component should be
+	 * uploaded with the levels from `tail_mip` to the end of the chain (see `MipmapLoader::GetMipChain()`).
+	 */
+	void Register(Material* material, MaterialComponent& component, const String& texture_cache_path,
+				  uint32 mip_count, uint32 tail_mip);
+
+	/**
+	 * @brief Stops streaming the textures of `material`. This is called when the material is destroyed.
+	 */
+	void Unregister(Material* material);
+
+	/**
+	 * @brief Returns true if any texture of `material` is streamed. The images of streamed textures are reallocated as
+	 * levels are added and evicted.
+	 */
+	bool IsStreaming(const Material* material);
+
+	/**
+	 * @brief Marks the textures of `material` as used in this frame.
+	 * @param screen_size The size of the drawn object on screen in pixels. The textures are streamed in until one texel
+	 * covers about one pixel.
+	 */
+	void RequestForMaterial(Material* material, float32 screen_size);
+
+	/**
+	 * @brief Adds the levels that have finished loading, evicts levels to stay under the budget and starts loading the
+	 * levels that were requested in the last frame. This must be called once per frame, outside of a render pass.
+	 */
+	void Update(renderer::CommandBuffer& cmd);
+
+	void SetBudget(uint64 budget_bytes);
+
+	TextureStreamerStats GetStats();
+
+	~TextureStreamer();
+
+private:
+	void AddLoadedMips(renderer::CommandBuffer& cmd);
+	void EvictOverBudget(renderer::CommandBuffer& cmd);
+	void StartLoads(renderer::CommandBuffer& cmd);
+
+	/**
+	 * @brief Evicts levels from textures that were not drawn in the last frame until `bytes` more fit in the budget.
+	 * @returns False if there is not enough memory that can be evicted.
+	 */
+	bool MakeRoom(renderer::CommandBuffer& cmd, uint64 bytes);
+
+	void Evict(renderer::CommandBuffer& cmd, StreamedTexture& texture, uint32 new_resident_mip);
+	void StartLoad(StreamedTexture& texture);
+
+	void UpdateResidency(StreamedTexture& texture);
+
+	StreamedTexture* FindEvictionCandidate(bool only_unused);
+
+private:
+	std::mutex mMutex;
+	std::unordered_map<const MaterialComponent*, StreamedTexture> mTextures;
+
+	std::mutex mLoadedMutex;
+	std::vector<LoadedMip> mLoadedMips;
+
+	JobCounter mLoadJobs;
+
+	uint64 mBudget = scDefaultBudget;
+	uint64 mResidentBytes = 0;
+	uint64 mPendingBytes = 0;
+
+	uint32 mPendingLoads = 0;
+	uint32 mNextLoadID = 0;
+	uint32 mFrameIndex = 0;
+
+	uint32 mMipsStreamed = 0;
+	uint32 mMipsEvicted = 0;
+};
+
+} // namespace fx
@@ -179,7 +179,12 @@ void Tokenizer::SubmitTokenIfData(Token& token, char* end_ptr, char* start_ptr)
     token.End = mpData;
     token.Type = GetTokenType(token);
 
-    TokenBuffer.Insert(token);
+    if (mpArena) {
+        ArenaTokens.Insert(token);
+    }
+    else {
+        TokenBuffer.Insert(token);
+    }
     token.Clear();
 
     token.Start = mpData;
@@ -338,12 +343,21 @@ void Tokenizer::IncludeFile(const char* path)
     }
 
 
+    IncludedPaths.push_back(vpath.Str().Str());
+
     // Save the current state of the tokenizer
     SaveState();
 
-    Slice<char> include_data = file.Read<char>();
+    Slice<char> include_data = nullptr;
 
-    DataPtrs.Insert(include_data.pData);
+    if (mpArena) {
+        const uint64 file_size = file.GetFileSize();
+        include_data = file.Read(MakeSlice(mpArena->AllocArray<char>(file_size), file_size));
+    }
+    else {
+        include_data = file.Read<char>();
+        DataPtrs.Insert(include_data.pData);
+    }
 
     SetDataPtr(include_data.pData);
     mpDataEnd = include_data.pData + include_data.Size;
@@ -2,6 +2,7 @@
 
 #include <Core/PagedArray.hpp>
 //
+#include <Core/Arena.hpp>
 #include <Core/File.hpp>
 #include <Core/Hash.hpp>
 #include <Core/MemPool/MemPool.hpp>
@@ -9,6 +10,8 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 namespace fx {
 
@@ -191,10 +194,19 @@ public:
 
     Tokenizer() = delete;
 
-    Tokenizer(char* data, uint32 buffer_size)
-        : mpDataStart(data), mpData(data), mpDataEnd(data + buffer_size), mpLinePtr(data)
+    /**
+     * @param arena If provided, tokens are written to `ArenaTokens` and included files are read into the arena instead
+     * of the engine pool. Everything the tokenizer produces is then released with the arena.
+     */
+    Tokenizer(char* data, uint32 buffer_size, Arena* arena = nullptr)
+        : mpDataStart(data), mpData(data), mpDataEnd(data + buffer_size), mpLinePtr(data), mpArena(arena)
     {
-        if (!TokenBuffer.IsInited()) {
+        if (mpArena) {
+            ArenaTokens.Init(mpArena);
+            // Roughly one token for every few characters of source
+            ArenaTokens.Reserve(buffer_size / 4 + 1);
+        }
+        else if (!TokenBuffer.IsInited()) {
             TokenBuffer.Create(512);
         }
     }
@@ -272,6 +284,12 @@ public:
     PagedArray<Token> TokenBuffer;
     PagedArray<char*> DataPtrs;
 
+    /// Tokens produced when the tokenizer is given an arena. The tokens point directly into the source buffers.
+    ArenaArray<Token> ArenaTokens;
+
+    /// Paths of all files pulled in with `#include`, including nested includes.
+    std::vector<std::string> IncludedPaths;
+
 private:
     const char* mpExpectedFileExtension = "";
 
@@ -285,6 +303,8 @@ private:
 
     uint32 mLineNumber = 0;
     char* mpLinePtr = nullptr;
+
+    Arena* mpArena = nullptr;
 };
 
 } // namespace fx
@@ -0,0 +1,1366 @@
+// Microbenchmark and accuracy harness for the math library.
+//
+// Every Vec3f, Vec4f, Mat4f and Quat operation, the SinCos approximations and the MathBatch kernels are timed over
+// arrays of random inputs from a fixed seed, and each result is checked against the same operation done in double
+// precision. Errors are reported in float ULPs of max(|reference|, 1). The inputs are all around unit scale, so this
+// is the relative error for large results and the error relative to the inputs for results that cancel towards zero.
+//
+// The process exits with a nonzero status if any operation is over its error budget, so that CI can run this for each
+// backend (see BUILD_MATHBENCH in CMakeLists.txt).
+
+#include <Core/CpuFeatures.hpp>
+#include <Core/Defines.hpp>
+#include <Core/Types.hpp>
+#include <Math/Impl/Batch/MathBatchKernels.hpp>
+#include <Math/Mat4.hpp>
+#include <Math/MathConsts.hpp>
+#include <Math/MathUtil.hpp>
+#include <Math/Quat.hpp>
+#include <Math/Vec3.hpp>
+#include <Math/Vec4.hpp>
+
+#ifdef FX_USE_AVX
+#include <Math/SSEUtil.hpp>
+#elif defined FX_USE_NEON
+#include <Math/NeonUtil.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace fx {
+
+// The harness does not start the engine, so assertions exit directly
+void Terminate() { std::abort(); }
+
+} // namespace fx
+
+using namespace fx;
+
+static constexpr uint32 scInputCount = 4096;
+static constexpr uint32 scTimingPasses = 32;
+
+static constexpr double scSLerpBudget = 32.0;
+
+using Float4 = std::array<float32, 4>;
+using Float16 = std::array<float32, 16>;
+
+struct BenchInputs
+{
+    std::vector<Float4> VecA;
+    std::vector<Float4> VecB;
+    std::vector<Float4> VecC;
+
+    /// Clamp bounds, where each component of `ClampMin` is at most the same component of `ClampMax`.
+    std::vector<Float4> ClampMin;
+    std::vector<Float4> ClampMax;
+
+    /// Steps in [0, 1].
+    std::vector<float32> Steps;
+
+    /// Angles in [-Pi, Pi].
+    std::vector<float32> Angles;
+    std::vector<Float4> Angles4;
+
+    /// Euler angles away from gimbal lock, in the order (roll, pitch, yaw).
+    std::vector<Float4> EulerAngles;
+
+    /// Unit quaternions.
+    std::vector<Float4> QuatA;
+    std::vector<Float4> QuatB;
+
+    /// Matrices with random values in [-1, 1].
+    std::vector<Float16> MatA;
+    std::vector<Float16> MatB;
+
+    /// Affine transforms, well conditioned for inversion.
+    std::vector<Float16> Transforms;
+
+    /// `LookAt()` eye and target positions where the view direction is not close to the up vector.
+    std::vector<Float4> Eyes;
+    std::vector<Float4> Targets;
+
+    /// Projection parameters (fov or width, aspect ratio or height, near plane, far plane).
+    std::vector<Float4> Perspectives;
+    std::vector<Float4> Orthographics;
+};
+
+struct BenchState
+{
+    uint32 Failures = 0;
+
+    /// Written with each result so that the timed loops are not optimized out.
+    float32 Sink = 0.0f;
+};
+
+static BenchInputs sInputs;
+static BenchState sState;
+
+//////////////////////////////
+// Double precision reference
+//////////////////////////////
+
+namespace ref {
+
+static void QuatMul(const double* l, const double* r, double* out)
+{
+    // Same component order as `Quat::operator*`
+    const double result[4] = {
+        l[3] * r[0] + l[0] * r[3] + l[1] * r[2] - l[2] * r[1],
+        l[3] * r[1] - l[0] * r[2] + l[1] * r[3] + l[2] * r[0],
+        l[3] * r[2] + l[0] * r[1] - l[1] * r[0] + l[2] * r[3],
+        l[3] * r[3] - l[0] * r[0] - l[1] * r[1] - l[2] * r[2],
+    };
+
+    memcpy(out, result, sizeof(result));
+}
+
+static void QuatToMatrix(const double* q, double* out)
+{
+    const double x = q[0], y = q[1], z = q[2], w = q[3];
+
+    const double result[16] = {
+        1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + z * w), 2.0 * (x * z - y * w), 0.0, /* */
+        2.0 * (x * y - z * w), 1.0 - 2.0 * (z * z + x * x), 2.0 * (y * z + x * w), 0.0, /* */
+        2.0 * (x * z + y * w), 2.0 * (y * z - x * w), 1.0 - 2.0 * (x * x + y * y), 0.0, /* */
+        0.0, 0.0, 0.0, 1.0,
+    };
+
+    memcpy(out, result, sizeof(result));
+}
+
+static void MatMul(const double* a, const double* b, double* out)
+{
+    // Column c of the result is B's columns weighted by column c of A, as in `Mat4f::operator*`
+    for (uint32 c = 0; c < 4; c++) {
+        for (uint32 r = 0; r < 4; r++) {
+            out[c * 4 + r] = a[c * 4 + 0] * b[0 + r] + a[c * 4 + 1] * b[4 + r] + a[c * 4 + 2] * b[8 + r] +
+                             a[c * 4 + 3] * b[12 + r];
+        }
+    }
+}
+
+static void MatInverse(const double* m, double* out)
+{
+    // Gauss-Jordan elimination with partial pivoting
+    double work[4][8];
+
+    for (uint32 r = 0; r < 4; r++) {
+        for (uint32 c = 0; c < 4; c++) {
+            work[r][c] = m[c * 4 + r];
+            work[r][c + 4] = (r == c) ? 1.0 : 0.0;
+        }
+    }
+
+    for (uint32 c = 0; c < 4; c++) {
+        uint32 pivot = c;
+        for (uint32 r = c + 1; r < 4; r++) {
+            if (std::fabs(work[r][c]) > std::fabs(work[pivot][c])) {
+                pivot = r;
+            }
+        }
+
+        std::swap(work[c], work[pivot]);
+
+        const double inv_pivot = 1.0 / work[c][c];
+        for (uint32 k = 0; k < 8; k++) {
+            work[c][k] *= inv_pivot;
+        }
+
+        for (uint32 r = 0; r < 4; r++) {
+            if (r == c) {
+                continue;
+            }
+
+            const double factor = work[r][c];
+            for (uint32 k = 0; k < 8; k++) {
+                work[r][k] -= factor * work[c][k];
+            }
+        }
+    }
+
+    for (uint32 r = 0; r < 4; r++) {
+        for (uint32 c = 0; c < 4; c++) {
+            out[c * 4 + r] = work[r][c + 4];
+        }
+    }
+}
+
+static double Dot3(const double* a, const double* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+static void Cross3(const double* a, const double* b, double* out)
+{
+    const double result[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    memcpy(out, result, sizeof(result));
+}
+
+static void Normalize3(double* v)
+{
+    const double length = std::sqrt(Dot3(v, v));
+    if (length == 0.0) {
+        return;
+    }
+
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+}
+
+static void SLerp(const double* a, const double* b, double step, double* out)
+{
+    // Same branches as `Quat::SLerp()`
+    const double cos_half_theta = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+
+    double ratio_a = 0.5;
+    double ratio_b = 0.5;
+
+    if (std::fabs(cos_half_theta) >= 1.0) {
+        ratio_a = 1.0;
+        ratio_b = 0.0;
+    }
+    else {
+        const double half_theta = std::acos(cos_half_theta);
+        const double sin_half_theta = std::sqrt(1.0 - cos_half_theta * cos_half_theta);
+
+        if (sin_half_theta >= 0.001) {
+            ratio_a = std::sin((1.0 - step) * half_theta) / sin_half_theta;
+            ratio_b = std::sin(step * half_theta) / sin_half_theta;
+        }
+    }
+
+    for (uint32 c = 0; c < 4; c++) {
+        out[c] = a[c] * ratio_a + b[c] * ratio_b;
+    }
+}
+
+template <uint32 TCount>
+static std::array<double, TCount> Widen(const std::array<float32, TCount>& values)
+{
+    std::array<double, TCount> result;
+    for (uint32 i = 0; i < TCount; i++) {
+        result[i] = values[i];
+    }
+    return result;
+}
+
+} // namespace ref
+
+//////////////////////////////
+// Inputs
+//////////////////////////////
+
+static Float4 RandomUnitQuat(std::mt19937& rng)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    double q[4] = { normal(rng), normal(rng), normal(rng), normal(rng) };
+    const double length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+    return { float32(q[0] / length), float32(q[1] / length), float32(q[2] / length), float32(q[3] / length) };
+}
+
+static void GenerateInputs(BenchInputs& inputs)
+{
+    std::mt19937 rng(0xF0C5);
+    std::uniform_real_distribution<float32> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float32> step(0.0f, 1.0f);
+    std::uniform_real_distribution<float32> angle(-FX_PI, FX_PI);
+
+    auto random_vec = [&]() -> Float4 { return { unit(rng), unit(rng), unit(rng), 0.0f }; };
+
+    for (uint32 i = 0; i < scInputCount; i++) {
+        inputs.VecA.push_back(random_vec());
+        inputs.VecB.push_back(random_vec());
+
+        // Keep divisors away from zero
+        Float4 divisor = random_vec();
+        for (float32& value : divisor) {
+            value = std::copysign(0.25f + std::fabs(value), value);
+        }
+        inputs.VecC.push_back(divisor);
+
+        const Float4 bound_a = random_vec();
+        const Float4 bound_b = random_vec();
+
+        Float4 clamp_min, clamp_max;
+        for (uint32 c = 0; c < 4; c++) {
+            clamp_min[c] = std::min(bound_a[c], bound_b[c]);
+            clamp_max[c] = std::max(bound_a[c], bound_b[c]);
+        }
+        inputs.ClampMin.push_back(clamp_min);
+        inputs.ClampMax.push_back(clamp_max);
+
+        inputs.Steps.push_back(step(rng));
+        inputs.Angles.push_back(angle(rng));
+        inputs.Angles4.push_back({ angle(rng), angle(rng), angle(rng), angle(rng) });
+
+        inputs.EulerAngles.push_back({ unit(rng) * 2.5f, unit(rng) * 1.2f, unit(rng) * 2.5f, 0.0f });
+
+        inputs.QuatA.push_back(RandomUnitQuat(rng));
+        inputs.QuatB.push_back(RandomUnitQuat(rng));
+
+        Float16 mat_a, mat_b;
+        for (uint32 c = 0; c < 16; c++) {
+            mat_a[c] = unit(rng);
+            mat_b[c] = unit(rng);
+        }
+        inputs.MatA.push_back(mat_a);
+        inputs.MatB.push_back(mat_b);
+
+        // Rotation * scale in [0.5, 2], with a translation in [-1, 1]
+        const std::array<double, 4> rotation = ref::Widen<4>(RandomUnitQuat(rng));
+        double rotation_matrix[16];
+        ref::QuatToMatrix(rotation.data(), rotation_matrix);
+
+        Float16 transform;
+        for (uint32 c = 0; c < 3; c++) {
+            const double scale = 1.25 + unit(rng) * 0.75;
+            for (uint32 r = 0; r < 4; r++) {
+                transform[c * 4 + r] = float32(rotation_matrix[c * 4 + r] * scale);
+            }
+        }
+        transform[12] = unit(rng);
+        transform[13] = unit(rng);
+        transform[14] = unit(rng);
+        transform[15] = 1.0f;
+        inputs.Transforms.push_back(transform);
+
+        // Reject views that look almost straight up or down
+        Float4 eye, target;
+        double forward[3];
+        do {
+            eye = random_vec();
+            target = random_vec();
+
+            for (uint32 c = 0; c < 3; c++) {
+                forward[c] = double(target[c]) - double(eye[c]);
+            }
+        } while (std::sqrt(ref::Dot3(forward, forward)) < 0.5 ||
+                 std::fabs(forward[1]) > 0.9 * std::sqrt(ref::Dot3(forward, forward)));
+
+        inputs.Eyes.push_back(eye);
+        inputs.Targets.push_back(target);
+
+        inputs.Perspectives.push_back(
+            { 0.5f + step(rng) * 1.5f, 0.5f + step(rng) * 1.5f, 0.01f + step(rng), 10.0f + step(rng) * 990.0f });
+        inputs.Orthographics.push_back(
+            { 1.0f + step(rng) * 99.0f, 1.0f + step(rng) * 99.0f, 0.01f + step(rng), 10.0f + step(rng) * 990.0f });
+    }
+}
+
+//////////////////////////////
+// Measurement
+//////////////////////////////
+
+/**
+ * Returns the error of `value` in float ULPs of `max(|reference|, 1)`.
+ */
+static double GetUlpError(float32 value, double reference)
+{
+    if (!std::isfinite(value)) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const double scale = std::max(std::fabs(reference), 1.0);
+
+    int exponent;
+    std::frexp(scale, &exponent);
+
+    // Floats in [2^(e-1), 2^e) are 2^(e-24) apart
+    const double ulp = std::ldexp(1.0, exponent - 24);
+
+    return std::fabs(double(value) - reference) / ulp;
+}
+
+static void PrintHeader(const char* section)
+{
+    printf("\n%-36s %10s %10s %10s\n", section, "ns/op", "max ULP", "budget");
+    printf("%-36s %10s %10s %10s\n", "------------------------------------", "----------", "----------", "----------");
+}
+
+static void PrintResult(const char* name, double ns_per_op, double max_ulp, double budget_ulp)
+{
+    const bool passed = (max_ulp <= budget_ulp);
+
+    printf("%-36s %10.2f %10.2f %10.1f%s\n", name, ns_per_op, max_ulp, budget_ulp, passed ? "" : "  FAILED");
+
+    if (!passed) {
+        ++sState.Failures;
+    }
+}
+
+/**
+ * Times `op(i, out)` over every input and returns the best time per call over the timing passes.
+ */
+template <typename TOp>
+static double TimeOp(TOp&& op)
+{
+    double best_ns = std::numeric_limits<double>::max();
+
+    float32 out[16];
+    float32 sink = 0.0f;
+
+    for (uint32 pass = 0; pass < scTimingPasses; pass++) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32 i = 0; i < scInputCount; i++) {
+            op(i, out);
+            sink += out[0];
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        best_ns = std::min(best_ns, double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+
+    sState.Sink += sink;
+
+    return best_ns / scInputCount;
+}
+
+/**
+ * Runs an operation with `outputs` float results, checks each against `reference(i, out)` and times it.
+ */
+template <typename TOp, typename TRef>
+static void BenchOp(const char* name, uint32 outputs, double budget_ulp, TOp&& op, TRef&& reference)
+{
+    double max_ulp = 0.0;
+
+    for (uint32 i = 0; i < scInputCount; i++) {
+        float32 out[16];
+        double expected[16];
+
+        op(i, out);
+        reference(i, expected);
+
+        for (uint32 c = 0; c < outputs; c++) {
+            max_ulp = std::max(max_ulp, GetUlpError(out[c], expected[c]));
+        }
+    }
+
+    PrintResult(name, TimeOp(op), max_ulp, budget_ulp);
+}
+
+//////////////////////////////
+// Helpers
+//////////////////////////////
+
+static FX_FORCE_INLINE Vec3f LoadVec3(const Float4& values) { return Vec3f(values[0], values[1], values[2]); }
+static FX_FORCE_INLINE Vec4f LoadVec4(const Float4& values) { return Vec4f(values[0], values[1], values[2], values[3]); }
+static FX_FORCE_INLINE Quat LoadQuat(const Float4& values) { return Quat(values[0], values[1], values[2], values[3]); }
+static FX_FORCE_INLINE Mat4f LoadMat4(const Float16& values) { return Mat4f(values.data()); }
+
+static FX_FORCE_INLINE void Store(const Vec3f& value, float32* out)
+{
+    out[0] = value.GetX();
+    out[1] = value.GetY();
+    out[2] = value.GetZ();
+}
+
+static FX_FORCE_INLINE void Store(const Vec4f& value, float32* out)
+{
+    out[0] = value.GetX();
+    out[1] = value.GetY();
+    out[2] = value.GetZ();
+    out[3] = value.GetW();
+}
+
+static FX_FORCE_INLINE void Store(const Quat& value, float32* out)
+{
+    out[0] = value.GetX();
+    out[1] = value.GetY();
+    out[2] = value.GetZ();
+    out[3] = value.GetW();
+}
+
+static FX_FORCE_INLINE void Store(const Mat4f& value, float32* out) { memcpy(out, value.RawData, sizeof(float32) * 16); }
+
+template <uint32 TCount>
+static FX_FORCE_INLINE void StoreRef(const double* values, double* out)
+{
+    memcpy(out, values, sizeof(double) * TCount);
+}
+
+/**
+ * The portable `Quat::FromAxisAngle()`, in single precision with the C library's sine and cosine. The SIMD backends
+ * must build the same quaternion from the same axis and angle, so that `Entity::RotateX()` and friends turn an entity
+ * by the same amount on every platform.
+ */
+static void ScalarFromAxisAngle(const Float4& axis, float32 angle, float32* out)
+{
+    const float32 length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+    const float32 half_angle = angle * 0.5f;
+    const float32 s = std::sin(half_angle) / length;
+
+    out[0] = axis[0] * s;
+    out[1] = axis[1] * s;
+    out[2] = axis[2] * s;
+    out[3] = std::cos(half_angle);
+}
+
+//////////////////////////////
+// Vector
+//////////////////////////////
+
+static void BenchVec3()
+{
+    const BenchInputs& in = sInputs;
+
+    PrintHeader("Vec3f");
+
+    // Component-wise operations are correctly rounded
+    auto componentwise = [&](const char* name, const std::vector<Float4>& b_values, auto&& op, auto&& ref_op)
+    {
+        BenchOp(
+            name, 3, 0.5, [&](uint32 i, float32* out) { Store(op(LoadVec3(in.VecA[i]), LoadVec3(b_values[i])), out); },
+            [&](uint32 i, double* out)
+            {
+                for (uint32 c = 0; c < 3; c++) {
+                    out[c] = ref_op(double(in.VecA[i][c]), double(b_values[i][c]));
+                }
+            });
+    };
+
+    componentwise(
+        "operator+", in.VecB, [](const Vec3f& a, const Vec3f& b) { return a + b; },
+        [](double a, double b) { return a + b; });
+    componentwise(
+        "operator-", in.VecB, [](const Vec3f& a, const Vec3f& b) { return a - b; },
+        [](double a, double b) { return a - b; });
+    componentwise(
+        "operator*", in.VecB, [](const Vec3f& a, const Vec3f& b) { return a * b; },
+        [](double a, double b) { return a * b; });
+    componentwise(
+        "operator/", in.VecC, [](const Vec3f& a, const Vec3f& b) { return a / b; },
+        [](double a, double b) { return a / b; });
+    componentwise(
+        "Min", in.VecB, [](const Vec3f& a, const Vec3f& b) { return Vec3f::Min(a, b); },
+        [](double a, double b) { return std::min(a, b); });
+    componentwise(
+        "Max", in.VecB, [](const Vec3f& a, const Vec3f& b) { return Vec3f::Max(a, b); },
+        [](double a, double b) { return std::max(a, b); });
+
+    BenchOp(
+        "operator*(scalar)", 3, 0.5,
+        [&](uint32 i, float32* out) { Store(LoadVec3(in.VecA[i]) * in.Steps[i], out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = double(in.VecA[i][c]) * in.Steps[i];
+            }
+        });
+
+    BenchOp(
+        "operator/(scalar)", 3, 0.5,
+        [&](uint32 i, float32* out) { Store(LoadVec3(in.VecA[i]) / in.VecC[i][0], out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = double(in.VecA[i][c]) / in.VecC[i][0];
+            }
+        });
+
+    BenchOp(
+        "operator-(unary)", 3, 0.0, [&](uint32 i, float32* out) { Store(-LoadVec3(in.VecA[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = -double(in.VecA[i][c]);
+            }
+        });
+
+    BenchOp(
+        "Clamp", 3, 0.0,
+        [&](uint32 i, float32* out)
+        { Store(Vec3f::Clamp(LoadVec3(in.VecA[i]), LoadVec3(in.ClampMin[i]), LoadVec3(in.ClampMax[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = std::clamp(double(in.VecA[i][c]), double(in.ClampMin[i][c]), double(in.ClampMax[i][c]));
+            }
+        });
+
+    BenchOp(
+        "Lerp", 3, 2.0,
+        [&](uint32 i, float32* out) { Store(Vec3f::Lerp(LoadVec3(in.VecA[i]), LoadVec3(in.VecB[i]), in.Steps[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                const double a = in.VecA[i][c];
+                out[c] = a + (double(in.VecB[i][c]) - a) * in.Steps[i];
+            }
+        });
+
+    // Fused on hardware with FMA, SIMDe without it rounds twice
+    BenchOp(
+        "MulAdd", 3, 1.0,
+        [&](uint32 i, float32* out)
+        { Store(Vec3f::MulAdd(LoadVec3(in.VecA[i]), LoadVec3(in.VecB[i]), LoadVec3(in.VecC[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = double(in.VecA[i][c]) * double(in.VecB[i][c]) + double(in.VecC[i][c]);
+            }
+        });
+
+    BenchOp(
+        "Dot", 1, 2.0, [&](uint32 i, float32* out) { out[0] = LoadVec3(in.VecA[i]).Dot(LoadVec3(in.VecB[i])); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.VecA[i]);
+            const auto b = ref::Widen<4>(in.VecB[i]);
+            out[0] = ref::Dot3(a.data(), b.data());
+        });
+
+    BenchOp(
+        "Cross", 3, 2.0, [&](uint32 i, float32* out) { Store(LoadVec3(in.VecA[i]).Cross(LoadVec3(in.VecB[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.VecA[i]);
+            const auto b = ref::Widen<4>(in.VecB[i]);
+            ref::Cross3(a.data(), b.data(), out);
+        });
+
+    BenchOp(
+        "Length", 1, 2.0, [&](uint32 i, float32* out) { out[0] = LoadVec3(in.VecA[i]).Length(); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.VecA[i]);
+            out[0] = std::sqrt(ref::Dot3(a.data(), a.data()));
+        });
+
+    BenchOp(
+        "DistanceTo", 1, 2.0,
+        [&](uint32 i, float32* out) { out[0] = LoadVec3(in.VecA[i]).DistanceTo(LoadVec3(in.VecB[i])); },
+        [&](uint32 i, double* out)
+        {
+            double difference[3];
+            for (uint32 c = 0; c < 3; c++) {
+                difference[c] = double(in.VecB[i][c]) - double(in.VecA[i][c]);
+            }
+            out[0] = std::sqrt(ref::Dot3(difference, difference));
+        });
+
+    BenchOp(
+        "Normalize", 3, 2.0, [&](uint32 i, float32* out) { Store(LoadVec3(in.VecA[i]).Normalize(), out); },
+        [&](uint32 i, double* out)
+        {
+            auto a = ref::Widen<4>(in.VecA[i]);
+            ref::Normalize3(a.data());
+            StoreRef<3>(a.data(), out);
+        });
+
+    BenchOp(
+        "Rotate", 3, 8.0, [&](uint32 i, float32* out) { Store(LoadVec3(in.VecA[i]).Rotate(LoadQuat(in.QuatA[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            // conjugate(q) * v * q, as in `Vec3f::Rotate()`
+            const auto q = ref::Widen<4>(in.QuatA[i]);
+            const double conjugate[4] = { -q[0], -q[1], -q[2], q[3] };
+            const double v[4] = { in.VecA[i][0], in.VecA[i][1], in.VecA[i][2], 0.0 };
+
+            double result[4];
+            ref::QuatMul(conjugate, v, result);
+            ref::QuatMul(result, q.data(), result);
+
+            StoreRef<3>(result, out);
+        });
+}
+
+static void BenchVec4()
+{
+    const BenchInputs& in = sInputs;
+
+    PrintHeader("Vec4f");
+
+    auto componentwise = [&](const char* name, const std::vector<Float4>& b_values, auto&& op, auto&& ref_op)
+    {
+        BenchOp(
+            name, 4, 0.5, [&](uint32 i, float32* out) { Store(op(LoadVec4(in.QuatA[i]), LoadVec4(b_values[i])), out); },
+            [&](uint32 i, double* out)
+            {
+                for (uint32 c = 0; c < 4; c++) {
+                    out[c] = ref_op(double(in.QuatA[i][c]), double(b_values[i][c]));
+                }
+            });
+    };
+
+    componentwise(
+        "operator+", in.QuatB, [](const Vec4f& a, const Vec4f& b) { return a + b; },
+        [](double a, double b) { return a + b; });
+    componentwise(
+        "operator-", in.QuatB, [](const Vec4f& a, const Vec4f& b) { return a - b; },
+        [](double a, double b) { return a - b; });
+    componentwise(
+        "operator*", in.QuatB, [](const Vec4f& a, const Vec4f& b) { return a * b; },
+        [](double a, double b) { return a * b; });
+    componentwise(
+        "operator/", in.VecC, [](const Vec4f& a, const Vec4f& b) { return a / b; },
+        [](double a, double b) { return a / b; });
+
+    BenchOp(
+        "operator*(scalar)", 4, 0.5,
+        [&](uint32 i, float32* out) { Store(LoadVec4(in.QuatA[i]) * in.Steps[i], out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] = double(in.QuatA[i][c]) * in.Steps[i];
+            }
+        });
+
+    BenchOp(
+        "operator/(scalar)", 4, 0.5,
+        [&](uint32 i, float32* out) { Store(LoadVec4(in.QuatA[i]) / in.VecC[i][0], out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] = double(in.QuatA[i][c]) / in.VecC[i][0];
+            }
+        });
+
+    BenchOp(
+        "LengthSquared", 1, 2.0, [&](uint32 i, float32* out) { out[0] = LoadVec4(in.VecA[i]).LengthSquared(); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.VecA[i]);
+            out[0] = ref::Dot3(a.data(), a.data()) + a[3] * a[3];
+        });
+}
+
+//////////////////////////////
+// Matrix
+//////////////////////////////
+
+static void BenchMat4()
+{
+    const BenchInputs& in = sInputs;
+
+    PrintHeader("Mat4f");
+
+    BenchOp(
+        "operator*", 16, 4.0, [&](uint32 i, float32* out) { Store(LoadMat4(in.MatA[i]) * LoadMat4(in.MatB[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<16>(in.MatA[i]);
+            const auto b = ref::Widen<16>(in.MatB[i]);
+            ref::MatMul(a.data(), b.data(), out);
+        });
+
+    BenchOp(
+        "MultiplyVec4f", 4, 4.0,
+        [&](uint32 i, float32* out)
+        {
+            Mat4f mat = LoadMat4(in.MatA[i]);
+            Vec4f vec = LoadVec4(in.QuatA[i]);
+            Store(mat.MultiplyVec4f(vec), out);
+        },
+        [&](uint32 i, double* out)
+        {
+            const auto m = ref::Widen<16>(in.MatA[i]);
+            const auto v = ref::Widen<4>(in.QuatA[i]);
+
+            for (uint32 r = 0; r < 4; r++) {
+                out[r] = m[0 + r] * v[0] + m[4 + r] * v[1] + m[8 + r] * v[2] + m[12 + r] * v[3];
+            }
+        });
+
+    BenchOp(
+        "Transposed", 16, 0.0, [&](uint32 i, float32* out) { Store(LoadMat4(in.MatA[i]).Transposed(), out); },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 4; c++) {
+                for (uint32 r = 0; r < 4; r++) {
+                    out[c * 4 + r] = in.MatA[i][r * 4 + c];
+                }
+            }
+        });
+
+    BenchOp(
+        "Inverse", 16, 32.0, [&](uint32 i, float32* out) { Store(LoadMat4(in.Transforms[i]).Inverse(), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto m = ref::Widen<16>(in.Transforms[i]);
+            ref::MatInverse(m.data(), out);
+        });
+
+    BenchOp(
+        "AsRotation", 16, 4.0, [&](uint32 i, float32* out) { Store(Mat4f::AsRotation(LoadQuat(in.QuatA[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto q = ref::Widen<4>(in.QuatA[i]);
+            ref::QuatToMatrix(q.data(), out);
+        });
+
+    // Rotation about one axis, with (column, row) positions of cos, sin and -sin
+    auto axis_rotation = [&](const char* name, Mat4f (*op)(float), uint32 axis)
+    {
+        BenchOp(
+            name, 16, 2.0, [&](uint32 i, float32* out) { Store(op(in.Angles[i]), out); },
+            [&](uint32 i, double* out)
+            {
+                const double cr = std::cos(double(in.Angles[i]));
+                const double sr = std::sin(double(in.Angles[i]));
+
+                // The two axes that rotate, a and b, where a turns towards b
+                const uint32 a = (axis + 1) % 3;
+                const uint32 b = (axis + 2) % 3;
+
+                for (uint32 c = 0; c < 16; c++) {
+                    out[c] = (c % 5 == 0) ? 1.0 : 0.0;
+                }
+
+                out[a * 4 + a] = cr;
+                out[a * 4 + b] = sr;
+                out[b * 4 + a] = -sr;
+                out[b * 4 + b] = cr;
+            });
+    };
+
+    axis_rotation("AsRotationX", Mat4f::AsRotationX, 0);
+    axis_rotation("AsRotationY", Mat4f::AsRotationY, 1);
+    axis_rotation("AsRotationZ", Mat4f::AsRotationZ, 2);
+
+    BenchOp(
+        "LookAt", 16, 16.0,
+        [&](uint32 i, float32* out)
+        {
+            Mat4f mat;
+            mat.LookAt(LoadVec3(in.Eyes[i]), LoadVec3(in.Targets[i]), Vec3f(0.0f, 1.0f, 0.0f));
+            Store(mat, out);
+        },
+        [&](uint32 i, double* out)
+        {
+            const auto eye = ref::Widen<4>(in.Eyes[i]);
+            const auto target = ref::Widen<4>(in.Targets[i]);
+            const double up_vec[3] = { 0.0, 1.0, 0.0 };
+
+            double forward[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+            ref::Normalize3(forward);
+
+            double right[3];
+            ref::Cross3(up_vec, forward, right);
+            ref::Normalize3(right);
+
+            double up[3];
+            ref::Cross3(forward, right, up);
+
+            for (uint32 c = 0; c < 3; c++) {
+                out[c * 4 + 0] = right[c];
+                out[c * 4 + 1] = up[c];
+                out[c * 4 + 2] = forward[c];
+                out[c * 4 + 3] = 0.0;
+            }
+
+            out[12] = -ref::Dot3(eye.data(), right);
+            out[13] = -ref::Dot3(eye.data(), up);
+            out[14] = -ref::Dot3(eye.data(), forward);
+            out[15] = 1.0;
+        });
+
+    BenchOp(
+        "LoadPerspectiveMatrix", 16, 4.0,
+        [&](uint32 i, float32* out)
+        {
+            const Float4& p = in.Perspectives[i];
+
+            Mat4f mat;
+            mat.LoadPerspectiveMatrix(p[0], p[1], p[2], p[3]);
+            Store(mat, out);
+        },
+        [&](uint32 i, double* out)
+        {
+            const auto p = ref::Widen<4>(in.Perspectives[i]);
+
+            const double height = 1.0 / std::tan(p[0] * 0.5);
+            const double depth_range = p[2] / (p[3] - p[2]);
+
+            for (uint32 c = 0; c < 16; c++) {
+                out[c] = 0.0;
+            }
+
+            out[0] = height / p[1];
+            out[5] = -height;
+            out[10] = -depth_range;
+            out[11] = 1.0;
+            out[14] = p[3] * depth_range;
+        });
+
+    BenchOp(
+        "LoadOrthographicMatrix", 16, 2.0,
+        [&](uint32 i, float32* out)
+        {
+            const Float4& p = in.Orthographics[i];
+
+            Mat4f mat;
+            mat.LoadOrthographicMatrix(p[0], p[1], p[2], p[3]);
+            Store(mat, out);
+        },
+        [&](uint32 i, double* out)
+        {
+            const auto p = ref::Widen<4>(in.Orthographics[i]);
+            const double depth_range = 1.0 / (p[3] - p[2]);
+
+            for (uint32 c = 0; c < 16; c++) {
+                out[c] = 0.0;
+            }
+
+            out[0] = 2.0 / p[0];
+            out[5] = -2.0 / p[1];
+            out[10] = depth_range;
+            out[14] = -depth_range * p[2];
+            out[15] = 1.0;
+        });
+}
+
+//////////////////////////////
+// Quaternion
+//////////////////////////////
+
+static void BenchQuat()
+{
+    const BenchInputs& in = sInputs;
+
+    PrintHeader("Quat");
+
+    BenchOp(
+        "operator*", 4, 4.0, [&](uint32 i, float32* out) { Store(LoadQuat(in.QuatA[i]) * LoadQuat(in.QuatB[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.QuatA[i]);
+            const auto b = ref::Widen<4>(in.QuatB[i]);
+            ref::QuatMul(a.data(), b.data(), out);
+        });
+
+    BenchOp(
+        "Conjugate", 4, 0.0, [&](uint32 i, float32* out) { Store(LoadQuat(in.QuatA[i]).Conjugate(), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto q = ref::Widen<4>(in.QuatA[i]);
+            const double result[4] = { -q[0], -q[1], -q[2], q[3] };
+            StoreRef<4>(result, out);
+        });
+
+    // acos() is poorly conditioned close to one, so quaternions that are close together lose a few bits
+    BenchOp(
+        "SLerp", 4, scSLerpBudget,
+        [&](uint32 i, float32* out) { Store(LoadQuat(in.QuatA[i]).SLerp(LoadQuat(in.QuatB[i]), in.Steps[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.QuatA[i]);
+            const auto b = ref::Widen<4>(in.QuatB[i]);
+            ref::SLerp(a.data(), b.data(), in.Steps[i], out);
+        });
+
+    BenchOp(
+        "NLerpIP", 4, 4.0,
+        [&](uint32 i, float32* out)
+        {
+            Quat q = LoadQuat(in.QuatA[i]);
+            q.NLerpIP(LoadQuat(in.QuatB[i]), in.Steps[i]);
+            Store(q, out);
+        },
+        [&](uint32 i, double* out)
+        {
+            const auto a = ref::Widen<4>(in.QuatA[i]);
+            auto b = ref::Widen<4>(in.QuatB[i]);
+
+            // Take the shortest path
+            if (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0) {
+                for (double& value : b) {
+                    value = -value;
+                }
+            }
+
+            const double t = in.Steps[i];
+            double length_sq = 0.0;
+
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] = a[c] * (1.0 - t) + b[c] * t;
+                length_sq += out[c] * out[c];
+            }
+
+            const double length = std::sqrt(length_sq);
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] /= length;
+            }
+        });
+
+    BenchOp(
+        "FromAxisAngle", 4, 4.0,
+        [&](uint32 i, float32* out) { Store(Quat::FromAxisAngle(LoadVec3(in.VecC[i]), in.Angles[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            auto axis = ref::Widen<4>(in.VecC[i]);
+            ref::Normalize3(axis.data());
+
+            const double half_angle = double(in.Angles[i]) * 0.5;
+            const double s = std::sin(half_angle);
+
+            const double result[4] = { axis[0] * s, axis[1] * s, axis[2] * s, std::cos(half_angle) };
+            StoreRef<4>(result, out);
+        });
+
+    // Compare against the scalar version on the same axis and angle, using the entity rotation axes as well as
+    // random ones. A backend that used the full angle instead of the half angle would be off by up to a whole unit.
+    BenchOp(
+        "FromAxisAngle (vs scalar)", 4, 8.0,
+        [&](uint32 i, float32* out) { Store(Quat::FromAxisAngle(LoadVec3(in.VecC[i]), in.Angles[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            float32 scalar[4];
+            ScalarFromAxisAngle(in.VecC[i], in.Angles[i], scalar);
+
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] = scalar[c];
+            }
+        });
+
+    const Float4 entity_axes[] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f }, // Vec3f::sRight, Entity::RotateX()
+        { 0.0f, 1.0f, 0.0f, 0.0f }, // Vec3f::sUp, Entity::RotateY()
+        { 0.0f, 0.0f, 1.0f, 0.0f }, // Vec3f::sForward, Entity::RotateZ()
+    };
+
+    BenchOp(
+        "FromAxisAngle (entity axes)", 4, 8.0,
+        [&](uint32 i, float32* out) { Store(Quat::FromAxisAngle(LoadVec3(entity_axes[i % 3]), in.Angles[i]), out); },
+        [&](uint32 i, double* out)
+        {
+            float32 scalar[4];
+            ScalarFromAxisAngle(entity_axes[i % 3], in.Angles[i], scalar);
+
+            for (uint32 c = 0; c < 4; c++) {
+                out[c] = scalar[c];
+            }
+        });
+
+    BenchOp(
+        "FromEulerAngles", 4, 8.0,
+        [&](uint32 i, float32* out) { Store(Quat::FromEulerAngles(LoadVec3(in.EulerAngles[i])), out); },
+        [&](uint32 i, double* out)
+        {
+            const auto angles = ref::Widen<4>(in.EulerAngles[i]);
+
+            const double sx = std::sin(angles[0] * 0.5), cx = std::cos(angles[0] * 0.5);
+            const double sy = std::sin(angles[1] * 0.5), cy = std::cos(angles[1] * 0.5);
+            const double sz = std::sin(angles[2] * 0.5), cz = std::cos(angles[2] * 0.5);
+
+            const double result[4] = {
+                cz * sx * cy - sz * cx * sy,
+                cz * cx * sy + sz * sx * cy,
+                sz * cx * cy - cz * sx * sy,
+                cz * cx * cy + sz * sx * sy,
+            };
+            StoreRef<4>(result, out);
+        });
+
+    // Round trip through the quaternion built by the reference above, away from gimbal lock
+    BenchOp(
+        "GetEulerAngles", 3, 16.0,
+        [&](uint32 i, float32* out)
+        {
+            const auto angles = ref::Widen<4>(in.EulerAngles[i]);
+
+            const double sx = std::sin(angles[0] * 0.5), cx = std::cos(angles[0] * 0.5);
+            const double sy = std::sin(angles[1] * 0.5), cy = std::cos(angles[1] * 0.5);
+            const double sz = std::sin(angles[2] * 0.5), cz = std::cos(angles[2] * 0.5);
+
+            const Quat q(float32(cz * sx * cy - sz * cx * sy), float32(cz * cx * sy + sz * sx * cy),
+                         float32(sz * cx * cy - cz * sx * sy), float32(cz * cx * cy + sz * sx * sy));
+
+            Store(q.GetEulerAngles(), out);
+        },
+        [&](uint32 i, double* out)
+        {
+            for (uint32 c = 0; c < 3; c++) {
+                out[c] = in.EulerAngles[i][c];
+            }
+        });
+}
+
+//////////////////////////////
+// Trigonometry
+//////////////////////////////
+
+static void BenchSinCos()
+{
+    const BenchInputs& in = sInputs;
+
+    PrintHeader("SinCos");
+
+    BenchOp(
+        "MathUtil::SinCos", 2, 8.0, [&](uint32 i, float32* out) { MathUtil::SinCos(in.Angles[i], &out[0], &out[1]); },
+        [&](uint32 i, double* out)
+        {
+            out[0] = std::sin(double(in.Angles[i]));
+            out[1] = std::cos(double(in.Angles[i]));
+        });
+
+    auto reference4 = [&](uint32 i, double* out)
+    {
+        for (uint32 c = 0; c < 4; c++) {
+            out[c] = std::sin(double(in.Angles4[i][c]));
+            out[c + 4] = std::cos(double(in.Angles4[i][c]));
+        }
+    };
+
+#if defined FX_USE_AVX
+    BenchOp(
+        "SSE::SinCos4 (x4)", 8, 8.0,
+        [&](uint32 i, float32* out)
+        {
+            __m128 sv, cv;
+            SSE::SinCos4(_mm_loadu_ps(in.Angles4[i].data()), &sv, &cv);
+
+            _mm_storeu_ps(out, sv);
+            _mm_storeu_ps(out + 4, cv);
+        },
+        reference4);
+
+#elif defined FX_USE_NEON
+    BenchOp(
+        "Neon::SinCos4 (x4)", 8, 8.0,
+        [&](uint32 i, float32* out)
+        {
+            float32x4_t sv, cv;
+            Neon::SinCos4(vld1q_f32(in.Angles4[i].data()), &sv, &cv);
+
+            vst1q_f32(out, sv);
+            vst1q_f32(out + 4, cv);
+        },
+        reference4);
+
+    // Documented as about 0.06% error
+    BenchOp(
+        "Neon::SinCos4_Fast (x4)", 8, 0.001 * (1 << 24),
+        [&](uint32 i, float32* out)
+        {
+            float32x4_t sv, cv;
+            Neon::SinCos4_Fast(vld1q_f32(in.Angles4[i].data()), &sv, &cv);
+
+            vst1q_f32(out, sv);
+            vst1q_f32(out + 4, cv);
+        },
+        reference4);
+#endif
+}
+
+//////////////////////////////
+// Batch kernels
+//////////////////////////////
+
+static void BenchBatchKernels(const MathBatch::KernelTable& kernels, const char* tier_name)
+{
+    const BenchInputs& in = sInputs;
+
+    char title[64];
+    snprintf(title, sizeof(title), "MathBatch (%s)", tier_name);
+    PrintHeader(title);
+
+    const uint32 count = scInputCount;
+
+    std::vector<float32> a(count * 16), b(count * 16), out(count * 16);
+    std::vector<float32> translations(count * 4), rotations(count * 4), rotations_b(count * 4), scales(count * 4);
+
+    for (uint32 i = 0; i < count; i++) {
+        memcpy(&a[i * 16], in.MatA[i].data(), sizeof(Float16));
+        memcpy(&b[i * 16], in.MatB[i].data(), sizeof(Float16));
+
+        memcpy(&translations[i * 4], in.VecA[i].data(), sizeof(Float4));
+        memcpy(&rotations[i * 4], in.QuatA[i].data(), sizeof(Float4));
+        memcpy(&rotations_b[i * 4], in.QuatB[i].data(), sizeof(Float4));
+
+        for (uint32 c = 0; c < 4; c++) {
+            scales[i * 4 + c] = 1.25f + in.VecB[i][c] * 0.75f;
+        }
+    }
+
+    auto time_kernel = [&](auto&& kernel)
+    {
+        double best_ns = std::numeric_limits<double>::max();
+
+        for (uint32 pass = 0; pass < scTimingPasses; pass++) {
+            const auto start = std::chrono::steady_clock::now();
+            kernel();
+            const auto end = std::chrono::steady_clock::now();
+
+            best_ns = std::min(best_ns,
+                               double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            sState.Sink += out[0];
+        }
+
+        return best_ns / count;
+    };
+
+    // MulMat4Array
+    {
+        auto kernel = [&]() { kernels.MulMat4Array(out.data(), a.data(), b.data(), count); };
+        kernel();
+
+        double max_ulp = 0.0;
+        for (uint32 i = 0; i < count; i++) {
+            const auto a_ref = ref::Widen<16>(in.MatA[i]);
+            const auto b_ref = ref::Widen<16>(in.MatB[i]);
+
+            double expected[16];
+            ref::MatMul(a_ref.data(), b_ref.data(), expected);
+
+            for (uint32 c = 0; c < 16; c++) {
+                max_ulp = std::max(max_ulp, GetUlpError(out[i * 16 + c], expected[c]));
+            }
+        }
+
+        PrintResult("MulMat4Array", time_kernel(kernel), max_ulp, 4.0);
+    }
+
+    // ComposeTRSArray
+    {
+        auto kernel = [&]()
+        { kernels.ComposeTRSArray(out.data(), translations.data(), rotations.data(), scales.data(), count); };
+        kernel();
+
+        double max_ulp = 0.0;
+        for (uint32 i = 0; i < count; i++) {
+            const auto q = ref::Widen<4>(in.QuatA[i]);
+
+            double expected[16];
+            ref::QuatToMatrix(q.data(), expected);
+
+            for (uint32 c = 0; c < 3; c++) {
+                for (uint32 r = 0; r < 3; r++) {
+                    expected[c * 4 + r] *= scales[i * 4 + c];
+                }
+                expected[12 + c] = translations[i * 4 + c];
+            }
+
+            for (uint32 c = 0; c < 16; c++) {
+                max_ulp = std::max(max_ulp, GetUlpError(out[i * 16 + c], expected[c]));
+            }
+        }
+
+        PrintResult("ComposeTRSArray", time_kernel(kernel), max_ulp, 8.0);
+    }
+
+    // SLerpArray
+    {
+        auto kernel = [&]()
+        { kernels.SLerpArray(out.data(), rotations.data(), rotations_b.data(), 0.0f, in.Steps.data(), count); };
+        kernel();
+
+        double max_ulp = 0.0;
+        for (uint32 i = 0; i < count; i++) {
+            const auto qa = ref::Widen<4>(in.QuatA[i]);
+            const auto qb = ref::Widen<4>(in.QuatB[i]);
+
+            double expected[4];
+            ref::SLerp(qa.data(), qb.data(), in.Steps[i], expected);
+
+            for (uint32 c = 0; c < 4; c++) {
+                max_ulp = std::max(max_ulp, GetUlpError(out[i * 4 + c], expected[c]));
+            }
+        }
+
+        PrintResult("SLerpArray", time_kernel(kernel), max_ulp, scSLerpBudget);
+    }
+
+    // CalculateBounds, over the translations as a 16 byte stride
+    {
+        float32 bounds_min[3], bounds_max[3];
+
+        auto kernel = [&]()
+        {
+            kernels.CalculateBounds(reinterpret_cast<const uint8*>(translations.data()), sizeof(Float4), count,
+                                    bounds_min, bounds_max);
+            out[0] = bounds_min[0];
+        };
+        kernel();
+
+        double max_ulp = 0.0;
+        for (uint32 c = 0; c < 3; c++) {
+            double expected_min = translations[c];
+            double expected_max = translations[c];
+
+            for (uint32 i = 1; i < count; i++) {
+                expected_min = std::min(expected_min, double(translations[i * 4 + c]));
+                expected_max = std::max(expected_max, double(translations[i * 4 + c]));
+            }
+
+            max_ulp = std::max(max_ulp, GetUlpError(bounds_min[c], expected_min));
+            max_ulp = std::max(max_ulp, GetUlpError(bounds_max[c], expected_max));
+        }
+
+        PrintResult("CalculateBounds", time_kernel(kernel), max_ulp, 0.0);
+    }
+}
+
+static void BenchAllBatchKernels()
+{
+    const CpuFeatures& features = CpuFeatures::GetInstance();
+
+    const eCpuTier tiers[] = { eCpuTier::Scalar, eCpuTier::SSE4, eCpuTier::AVX2, eCpuTier::AVX512 };
+    std::vector<const MathBatch::KernelTable*> tables_run;
+
+    for (eCpuTier tier : tiers) {
+        if (!features.SupportsTier(tier)) {
+            continue;
+        }
+
+        // Builds without runtime dispatch return the same table for several tiers
+        const MathBatch::KernelTable* table = &MathBatch::GetKernelTable(tier);
+        if (std::find(tables_run.begin(), tables_run.end(), table) != tables_run.end()) {
+            continue;
+        }
+
+        tables_run.push_back(table);
+        BenchBatchKernels(*table, CpuFeatures::GetTierName(tier));
+    }
+}
+
+static const char* GetBackendName()
+{
+#if defined FX_USE_NEON
+    return "NEON";
+#elif defined FX_USE_AVX && defined FX_USE_SIMDE
+    return "AVX2 (SIMDe)";
+#elif defined FX_USE_AVX
+    return "AVX2";
+#else
+    return "None";
+#endif
+}
+
+int main()
+{
+#ifdef FX_NO_SIMD
+    // The scalar type layer is incomplete, so there is nothing to measure
+    printf("Math benchmark: no SIMD backend selected for this build\n");
+    return 0;
+#endif
+
+    const CpuFeatures& features = CpuFeatures::GetInstance();
+
+    printf("Math benchmark: %s backend, %s CPU tier, %u inputs, best of %u passes\n", GetBackendName(),
+           CpuFeatures::GetTierName(features.GetTier()), scInputCount, scTimingPasses);
+    printf("Errors are in float ULPs of max(|reference|, 1) against a double precision reference\n");
+
+    GenerateInputs(sInputs);
+
+    BenchVec3();
+    BenchVec4();
+    BenchMat4();
+    BenchQuat();
+    BenchSinCos();
+    BenchAllBatchKernels();
+
+    printf("\n%u operation(s) over budget (sink %g)\n", sState.Failures, double(sState.Sink));
+
+    return (sState.Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}